@@ -0,0 +1,115 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/collision/ChCCellList.h"
+#include "chrono/parallel/ChTaskScheduler.h"
+
+namespace chrono {
+namespace collision {
+
+void ChCellList::Build(const std::vector<ChVector<> >& points, double cutoff) {
+    int n = (int)points.size();
+    neighbor_start.assign(n + 1, 0);
+    neighbors.clear();
+    if (n == 0)
+        return;
+
+    // Bounding box of the points
+    ChVector<> pmin = points[0];
+    ChVector<> pmax = points[0];
+    for (int i = 1; i < n; i++) {
+        pmin = ChVector<>(std::min(pmin.x(), points[i].x()), std::min(pmin.y(), points[i].y()),
+                          std::min(pmin.z(), points[i].z()));
+        pmax = ChVector<>(std::max(pmax.x(), points[i].x()), std::max(pmax.y(), points[i].y()),
+                          std::max(pmax.z(), points[i].z()));
+    }
+
+    // Grid of cells not smaller than the cutoff distance. Sparse clouds would need many empty cells:
+    // the cells are enlarged so that their number does not exceed a few times the number of points.
+    double max_cells = 8.0 * n + 64;
+    ChVector<> extent = pmax - pmin;
+    cell_size = std::max(cutoff, 1e-12);
+    for (;;) {
+        double cx = std::floor(extent.x() / cell_size) + 1;
+        double cy = std::floor(extent.y() / cell_size) + 1;
+        double cz = std::floor(extent.z() / cell_size) + 1;
+        if (cx * cy * cz <= max_cells) {
+            nx = (int)cx;
+            ny = (int)cy;
+            nz = (int)cz;
+            break;
+        }
+        cell_size *= std::max(1.1, std::cbrt(cx * cy * cz / max_cells));
+    }
+    origin = pmin;
+
+    // Cell of each point
+    point_cell.resize(n);
+    ChParallelFor(0, n, 0, [&](int i) {
+        ChVector<> p = (points[i] - origin) / cell_size;
+        int ix = std::min((int)p.x(), nx - 1);
+        int iy = std::min((int)p.y(), ny - 1);
+        int iz = std::min((int)p.z(), nz - 1);
+        point_cell[i] = (iz * ny + iy) * nx + ix;
+    });
+
+    // Counting sort of the points by cell (stable, so the lists do not depend on the number of threads)
+    int ncells = nx * ny * nz;
+    cell_start.assign(ncells + 1, 0);
+    for (int i = 0; i < n; i++)
+        cell_start[point_cell[i] + 1]++;
+    for (int c = 0; c < ncells; c++)
+        cell_start[c + 1] += cell_start[c];
+    cell_points.resize(n);
+    {
+        std::vector<int> fill(cell_start.begin(), cell_start.end() - 1);
+        for (int i = 0; i < n; i++)
+            cell_points[fill[point_cell[i]]++] = i;
+    }
+
+    // Visit the points closer than the cutoff in the 27 cells around the cell of point i
+    double cutoff2 = cutoff * cutoff;
+    auto visit_neighbors = [&](int i, int* list) {
+        int count = 0;
+        int c = point_cell[i];
+        int ix = c % nx;
+        int iy = (c / nx) % ny;
+        int iz = c / (nx * ny);
+        for (int jz = std::max(iz - 1, 0); jz <= std::min(iz + 1, nz - 1); jz++)
+            for (int jy = std::max(iy - 1, 0); jy <= std::min(iy + 1, ny - 1); jy++)
+                for (int jx = std::max(ix - 1, 0); jx <= std::min(ix + 1, nx - 1); jx++) {
+                    int cj = (jz * ny + jy) * nx + jx;
+                    for (int k = cell_start[cj]; k < cell_start[cj + 1]; k++) {
+                        int j = cell_points[k];
+                        if (j != i && (points[j] - points[i]).Length2() < cutoff2) {
+                            if (list)
+                                list[count] = j;
+                            count++;
+                        }
+                    }
+                }
+        return count;
+    };
+
+    // Two passes: count the neighbors, then fill the lists at their offsets
+    ChParallelFor(0, n, 0, [&](int i) { neighbor_start[i + 1] = visit_neighbors(i, NULL); });
+    for (int i = 0; i < n; i++)
+        neighbor_start[i + 1] += neighbor_start[i];
+    neighbors.resize(neighbor_start[n]);
+    ChParallelFor(0, n, 0, [&](int i) { visit_neighbors(i, neighbors.data() + neighbor_start[i]); });
+}
+
+}  // end namespace collision
+}  // end namespace chrono
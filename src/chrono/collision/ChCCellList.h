@@ -0,0 +1,71 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHC_CELLLIST_H
+#define CHC_CELLLIST_H
+
+#include <vector>
+
+#include "chrono/core/ChVector.h"
+
+namespace chrono {
+namespace collision {
+
+/// Neighbor search for clouds of points (for example the particles of SPH and meshless materials),
+/// based on a uniform grid of cells (cell list).
+/// The points are binned in the cells with a counting sort, then the neighbors of each point, i.e. the
+/// points closer than a cutoff distance, are searched among the points of the 27 cells around its cell.
+/// The neighbor lists are stored in flat arrays, in compressed row (CSR) form: the neighbors of the
+/// point i are GetNeighbors()[k], for k in [GetNeighborStart()[i], GetNeighborStart()[i+1]).
+/// The lists are symmetric (if j is a neighbor of i, then i is a neighbor of j), so that sums over the
+/// neighbors of each point can be evaluated in parallel, each point accumulating only into itself.
+class ChApi ChCellList {
+  public:
+    ChCellList() : cell_size(0), nx(0), ny(0), nz(0) {}
+
+    /// Find the neighbors of all points, i.e. the pairs of points at a distance smaller than 'cutoff'.
+    /// The memory of the previous calls is reused.
+    void Build(const std::vector<ChVector<> >& points, double cutoff);
+
+    /// Number of points of the last search.
+    int GetNumPoints() const { return (int)neighbor_start.size() - 1; }
+
+    /// Number of (unique) pairs of neighbors of the last search.
+    int GetNumPairs() const { return (int)neighbors.size() / 2; }
+
+    /// Offsets of the neighbor lists of the points in GetNeighbors() (size: number of points + 1).
+    const std::vector<int>& GetNeighborStart() const { return neighbor_start; }
+
+    /// Indices of the neighbors of all points, concatenated.
+    const std::vector<int>& GetNeighbors() const { return neighbors; }
+
+    /// Size of the cells of the last search (not smaller than the cutoff distance).
+    double GetCellSize() const { return cell_size; }
+
+    /// Number of cells of the grid of the last search.
+    int GetNumCells() const { return nx * ny * nz; }
+
+  private:
+    double cell_size;
+    int nx, ny, nz;                   ///< number of cells along x, y, z
+    ChVector<> origin;                ///< min corner of the grid
+    std::vector<int> point_cell;      ///< cell of each point
+    std::vector<int> cell_start;      ///< offsets of the points of each cell in cell_points
+    std::vector<int> cell_points;     ///< indices of the points, sorted by cell
+    std::vector<int> neighbor_start;  ///< offsets of the neighbor lists
+    std::vector<int> neighbors;       ///< neighbor lists
+};
+
+}  // end namespace collision
+}  // end namespace chrono
+
+#endif
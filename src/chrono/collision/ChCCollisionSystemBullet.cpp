@@ -14,6 +14,7 @@
 
 #include "chrono/collision/ChCCollisionSystemBullet.h"
 #include "chrono/collision/ChCModelBullet.h"
+#include "chrono/collision/ChCModelBulletDeformableMesh.h"
 #include "chrono/collision/gimpact/GIMPACT/Bullet/btGImpactCollisionAlgorithm.h"
 #include "chrono/collision/ChCCollisionUtils.h"
 #include "chrono/physics/ChBody.h"
@@ -1284,6 +1285,18 @@ void ChCollisionSystemBullet::ReportContacts(ChContactContainer* mcontactcontain
         icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
         icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
 
+        // Deformable meshes report contacts with their triangle models. A manifold is generated by a single pair
+        // of children, so the child index of the first point holds for all points.
+        if (contactManifold->getNumContacts() > 0) {
+            const btManifoldPoint& pt = contactManifold->getContactPoint(0);
+            if (pt.m_index0 >= 0)
+                if (auto meshA = dynamic_cast<ChModelBulletDeformableMesh*>(icontact.modelA))
+                    icontact.modelA = meshA->GetTriangleModel(pt.m_index0);
+            if (pt.m_index1 >= 0)
+                if (auto meshB = dynamic_cast<ChModelBulletDeformableMesh*>(icontact.modelB))
+                    icontact.modelB = meshB->GetTriangleModel(pt.m_index1);
+        }
+
         double envelopeA = icontact.modelA->GetEnvelope();
         double envelopeB = icontact.modelB->GetEnvelope();
 
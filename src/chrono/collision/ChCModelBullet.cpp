@@ -799,6 +799,10 @@ void ChModelBullet::SyncPosition()
                        (btScalar)rA(1, 1), (btScalar)rA(1, 2), (btScalar)rA(2, 0), (btScalar)rA(2, 1),
                        (btScalar)rA(2, 2));
     bt_collision_object->getWorldTransform().setBasis(basisA);
+
+    // Pairs of inactive objects (e.g. sleeping or fixed bodies) are skipped by the narrow phase:
+    // their contacts would be discarded anyway by the contact container.
+    bt_collision_object->setActivationState(mcontactable->IsContactActive() ? ACTIVE_TAG : ISLAND_SLEEPING);
 }
 
 
@@ -260,7 +260,9 @@ class ChApi ChModelBullet : public ChCollisionModel {
     virtual void GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const;
 
     /// Sets the position and orientation of the collision
-    /// model as the current position of the corresponding ChContactable
+    /// model as the current position of the corresponding ChContactable.
+    /// Inactive contactables (e.g. sleeping bodies) are marked as sleeping also
+    /// in Bullet, so that no narrow phase is performed between two of them.
     virtual void SyncPosition();
 
     /// If the collision shape is a sphere, resize it and return true (if no
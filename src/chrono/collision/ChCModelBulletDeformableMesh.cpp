@@ -0,0 +1,117 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/collision/ChCModelBulletDeformableMesh.h"
+#include "chrono/collision/bullet/BulletCollision/BroadphaseCollision/btDbvt.h"
+#include "chrono/collision/bullet/BulletCollision/CollisionShapes/btCompoundShape.h"
+#include "chrono/collision/bullet/btBulletCollisionCommon.h"
+
+namespace chrono {
+namespace collision {
+
+// Compound shape whose dynamic AABB tree can be refit, keeping its topology, when the children deform.
+// Leaves of the tree store the index of the child (as in btCompoundShape).
+class ChRefittableCompoundShape : public btCompoundShape {
+  public:
+    ChRefittableCompoundShape() : btCompoundShape(true) {}
+
+    // Rebuild the tree top-down, once all children have been added (leaves are kept).
+    void OptimizeTree() {
+        getDynamicAabbTree()->optimizeTopDown();
+        Refit();
+    }
+
+    // Update the volumes of the leaves with the current AABBs of the children, then the volumes of the
+    // internal nodes bottom-up. The root volume is the AABB of the compound.
+    void Refit() {
+        btDbvtNode* root = getDynamicAabbTree()->m_root;
+        if (root)
+            RefitNode(root);
+    }
+
+    // Same as btCompoundShape::getAabb, but with the refit root volume as local AABB.
+    virtual void getAabb(const btTransform& t, btVector3& aabbMin, btVector3& aabbMax) const override {
+        btDbvtNode* root = getDynamicAabbTree()->m_root;
+        if (!root) {
+            aabbMin = aabbMax = t.getOrigin();
+            return;
+        }
+        btVector3 localHalfExtents = btScalar(0.5) * (root->volume.Maxs() - root->volume.Mins());
+        btVector3 localCenter = btScalar(0.5) * (root->volume.Maxs() + root->volume.Mins());
+        localHalfExtents += btVector3(getMargin(), getMargin(), getMargin());
+
+        btMatrix3x3 abs_b = t.getBasis().absolute();
+        btVector3 center = t(localCenter);
+        btVector3 extent = btVector3(abs_b[0].dot(localHalfExtents), abs_b[1].dot(localHalfExtents),
+                                     abs_b[2].dot(localHalfExtents));
+        aabbMin = center - extent;
+        aabbMax = center + extent;
+    }
+
+  private:
+    void RefitNode(btDbvtNode* node) {
+        if (node->isleaf()) {
+            int index = node->dataAsInt;
+            btVector3 aabbMin, aabbMax;
+            getChildShape(index)->getAabb(getChildTransform(index), aabbMin, aabbMax);
+            node->volume = btDbvtVolume::FromMM(aabbMin, aabbMax);
+        } else {
+            RefitNode(node->childs[0]);
+            RefitNode(node->childs[1]);
+            Merge(node->childs[0]->volume, node->childs[1]->volume, node->volume);
+        }
+    }
+};
+
+int ChModelBulletDeformableMesh::ClearModel() {
+    triangle_models.clear();
+    return ChModelBullet::ClearModel();
+}
+
+int ChModelBulletDeformableMesh::BuildModel() {
+    shapes.clear();
+
+    ChRefittableCompoundShape* compound = new ChRefittableCompoundShape;
+    compound->setUserPointer(this);
+
+    btTransform identity;
+    identity.setIdentity();
+    for (auto triangle_model : triangle_models) {
+        compound->addChildShape(identity, triangle_model->GetBulletModel()->getCollisionShape());
+    }
+    compound->OptimizeTree();
+
+    shapes.push_back(std::shared_ptr<btCollisionShape>(compound));
+    bt_collision_object->setCollisionShape(compound);
+
+    return ChModelBullet::BuildModel();
+}
+
+bool ChModelBulletDeformableMesh::AddTriangleModel(ChModelBullet* triangle_model) {
+    btCollisionShape* shape = triangle_model->GetBulletModel()->getCollisionShape();
+    if (!shape || shape->getShapeType() != CE_TRIANGLE_SHAPE_PROXYTYPE)
+        return false;
+
+    triangle_models.push_back(triangle_model);
+    return true;
+}
+
+void ChModelBulletDeformableMesh::SyncPosition() {
+    // Vertices are in absolute coordinates.
+    bt_collision_object->getWorldTransform().setIdentity();
+
+    if (shapes.size() > 0)
+        static_cast<ChRefittableCompoundShape*>(shapes[0].get())->Refit();
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -0,0 +1,73 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHC_MODELBULLETDEFORMABLEMESH_H
+#define CHC_MODELBULLETDEFORMABLEMESH_H
+
+#include <vector>
+
+#include "chrono/collision/ChCModelBullet.h"
+
+namespace chrono {
+namespace collision {
+
+/// @addtogroup chrono_collision
+/// @{
+
+/// Collision model for a deformable mesh of triangles, as a single object in the broadphase.
+/// The model collects the triangle proxies of many 'triangle models' (ChModelBullet objects, each with a single
+/// shape added with AddTriangleProxy) in a bounding volume hierarchy. The hierarchy is built once, in BuildModel(),
+/// and at each SyncPosition() it is only refit to the current positions of the vertices: its topology does not
+/// change. The hierarchy is used for the mid-phase culling against the other models.
+/// The triangle models must not be added to the collision system: contacts are reported as if they were generated
+/// by the triangle models, so that each contact refers to the ChContactable of its triangle.
+/// Notes:
+/// - triangles of the same model do not collide among them;
+/// - the collision family must be set before adding the model to the collision system.
+class ChApi ChModelBulletDeformableMesh : public ChModelBullet {
+
+  protected:
+    std::vector<ChModelBullet*> triangle_models;
+
+  public:
+    ChModelBulletDeformableMesh() {}
+    virtual ~ChModelBulletDeformableMesh() {}
+
+    /// Deletes all inserted triangles.
+    virtual int ClearModel() override;
+
+    /// Builds the hierarchy over the triangles added so far.
+    /// Call this while the model is not in the collision system.
+    virtual int BuildModel() override;
+
+    /// Add the triangle proxy of a triangle model (which is not copied: the model must persist as long as this).
+    /// Contacts with this triangle are reported with the triangle model. Return false if the triangle model
+    /// does not contain a single triangle proxy.
+    bool AddTriangleModel(ChModelBullet* triangle_model);
+
+    /// Get the number of triangles.
+    int GetNumTriangles() const { return (int)triangle_models.size(); }
+
+    /// Get the model of the i-th triangle.
+    ChModelBullet* GetTriangleModel(int index) const { return triangle_models[index]; }
+
+    /// Refit the bounding volume hierarchy to the current positions of the vertices.
+    /// The model has no ChContactable (it does not move as a rigid object), so this is all it needs.
+    virtual void SyncPosition() override;
+};
+
+/// @} chrono_collision
+
+}  // end namespace collision
+}  // end namespace chrono
+
+#endif
@@ -71,6 +71,9 @@ public:
     /// Enable/disable a lock on the matrix sparsity pattern (default: false).
     void SetSparsityPatternLock(bool val) { m_lock = val; }
 
+    /// Return true if the sparsity pattern of this matrix is locked.
+    bool IsSparsityPatternLocked() const { return m_lock; }
+
 	/// (Optional) Force the update of the sparsity pattern
     /// Depending on the internal data structure, this can highly speed up the insertion of elements in the matrix.
     /// Suggested for matrix with dimension >1e5
@@ -0,0 +1,79 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHUNIONFIND_H
+#define CHUNIONFIND_H
+
+#include <utility>
+#include <vector>
+
+namespace chrono {
+
+/// Disjoint-set forest (union-find) over the integers [0, n), with union by size and path halving.
+/// Used to partition items in connected components, e.g. bodies connected by links and contacts
+/// in 'islands' (see ChIslands) or solver variables coupled by constraints (see ChSolverIslands).
+/// Reset() does not reallocate memory if the number of elements does not change, so the same structure
+/// can be cheaply rebuilt at each time step.
+class ChUnionFind {
+  public:
+    ChUnionFind(int n = 0) { Reset(n); }
+
+    /// Reset to n elements, each in its own set.
+    void Reset(int n) {
+        parent.resize(n);
+        size.assign(n, 1);
+        for (int i = 0; i < n; i++)
+            parent[i] = i;
+        num_sets = n;
+    }
+
+    /// Return the number of elements.
+    int GetNumElements() const { return (int)parent.size(); }
+
+    /// Return the number of disjoint sets.
+    int GetNumSets() const { return num_sets; }
+
+    /// Return the representative of the set containing element i.
+    int Find(int i) {
+        while (parent[i] != i) {
+            parent[i] = parent[parent[i]];
+            i = parent[i];
+        }
+        return i;
+    }
+
+    /// Merge the sets containing elements i and j. Return false if they were already in the same set.
+    bool Union(int i, int j) {
+        i = Find(i);
+        j = Find(j);
+        if (i == j)
+            return false;
+        if (size[i] < size[j])
+            std::swap(i, j);
+        parent[j] = i;
+        size[i] += size[j];
+        num_sets--;
+        return true;
+    }
+
+    /// Return the number of elements in the set containing element i.
+    int GetSetSize(int i) { return size[Find(i)]; }
+
+  private:
+    std::vector<int> parent;
+    std::vector<int> size;
+    int num_sets;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,272 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/core/ChException.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/parallel/ChTaskScheduler.h"
+
+namespace chrono {
+
+// Index of the worker executing the current thread (-1 if not a worker of the pool).
+static thread_local int tls_worker_index = -1;
+
+ChTaskScheduler& ChTaskScheduler::GetInstance() {
+    static ChTaskScheduler instance;
+    return instance;
+}
+
+ChTaskScheduler::ChTaskScheduler() : m_queued(0), m_running(false), m_stop(false) {
+    m_num_threads = std::max(1, CHOMPfunctions::GetNumProcs());
+}
+
+ChTaskScheduler::~ChTaskScheduler() {
+    Stop();
+}
+
+int ChTaskScheduler::GetCurrentWorker() {
+    return tls_worker_index;
+}
+
+void ChTaskScheduler::SetNumThreads(int nthreads) {
+    if (nthreads < 1)
+        nthreads = 1;
+
+    // Changing the pool from one of its own workers would deadlock.
+    if (tls_worker_index >= 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(m_config_mutex);
+    if (nthreads == m_num_threads)
+        return;
+
+    Stop();
+    m_num_threads = nthreads;
+}
+
+void ChTaskScheduler::Start() {
+    std::lock_guard<std::mutex> lock(m_config_mutex);
+    if (m_running)
+        return;
+
+    int nworkers = m_num_threads - 1;
+    m_queues.clear();
+    for (int i = 0; i <= nworkers; i++)
+        m_queues.push_back(std::unique_ptr<Queue>(new Queue));
+
+    m_stop = false;
+    for (int i = 0; i < nworkers; i++)
+        m_workers.push_back(std::thread(&ChTaskScheduler::WorkerLoop, this, i));
+
+    m_running = true;
+}
+
+void ChTaskScheduler::Stop() {
+    if (!m_running)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(m_sleep_mutex);
+        m_stop = true;
+    }
+    m_sleep_cv.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+    m_workers.clear();
+
+    m_running = false;
+}
+
+void ChTaskScheduler::Spawn(Task&& task) {
+    if (!m_running)
+        Start();
+
+    // Workers push into their own queue, other threads into the shared queue.
+    int index = (tls_worker_index >= 0) ? tls_worker_index : (int)m_queues.size() - 1;
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+    m_queued++;
+
+    { std::lock_guard<std::mutex> lock(m_sleep_mutex); }
+    m_sleep_cv.notify_one();
+}
+
+bool ChTaskScheduler::RunOne() {
+    if (!m_running)
+        return false;
+
+    int nqueues = (int)m_queues.size();
+    int self = tls_worker_index;
+    Task task;
+    bool found = false;
+
+    // Own queue: most recent task first (LIFO).
+    if (self >= 0) {
+        Queue& queue = *m_queues[self];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+            found = true;
+        }
+    }
+
+    // Shared queue, then the other workers: oldest task first (FIFO).
+    for (int k = 0; k < nqueues && !found; k++) {
+        int index = (k == 0) ? nqueues - 1 : (self + k) % (nqueues - 1);  // shared queue, then the next workers
+        if (index == self)
+            continue;
+        Queue& queue = *m_queues[index];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            found = true;
+        }
+    }
+
+    if (!found)
+        return false;
+
+    m_queued--;
+    Execute(task);
+    return true;
+}
+
+void ChTaskScheduler::Execute(Task& task) {
+    ChTaskGroup* group = task.group;
+    try {
+        task.func();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(group->m_exception_mutex);
+        if (!group->m_exception)
+            group->m_exception = std::current_exception();
+    }
+    // Release the task resources before notifying the group, that may be destroyed right after.
+    task.func = nullptr;
+    if (group->m_pending.fetch_sub(1) == 1)
+        GetInstance().NotifyWaiting();
+}
+
+void ChTaskScheduler::NotifyWaiting() {
+    { std::lock_guard<std::mutex> lock(m_sleep_mutex); }
+    m_sleep_cv.notify_all();
+}
+
+void ChTaskScheduler::WaitUntil(const std::function<bool()>& done) {
+    while (!done()) {
+        if (RunOne())
+            continue;
+
+        // Nothing to execute: block until new tasks are queued or the condition is met
+        // (the tasks still running on other threads call NotifyWaiting when they complete).
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_sleep_cv.wait(lock, [this, &done]() { return done() || m_queued.load() > 0; });
+    }
+}
+
+void ChTaskScheduler::WorkerLoop(int index) {
+    tls_worker_index = index;
+
+    while (true) {
+        if (RunOne())
+            continue;
+
+        std::unique_lock<std::mutex> lock(m_sleep_mutex);
+        m_sleep_cv.wait(lock, [this]() { return m_stop || m_queued.load() > 0; });
+        if (m_stop)
+            break;
+    }
+
+    tls_worker_index = -1;
+}
+
+// -----------------------------------------------------------------------------
+
+ChTaskGroup::~ChTaskGroup() {
+    WaitAll();
+}
+
+void ChTaskGroup::Run(std::function<void()> task) {
+    m_pending++;
+    ChTaskScheduler::Task t;
+    t.func = std::move(task);
+    t.group = this;
+    ChTaskScheduler::GetInstance().Spawn(std::move(t));
+}
+
+void ChTaskGroup::WaitAll() {
+    ChTaskScheduler::GetInstance().WaitUntil([this]() { return m_pending.load() == 0; });
+}
+
+void ChTaskGroup::Wait() {
+    WaitAll();
+
+    std::exception_ptr exception;
+    {
+        std::lock_guard<std::mutex> lock(m_exception_mutex);
+        std::swap(exception, m_exception);
+    }
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+// -----------------------------------------------------------------------------
+
+int ChTaskGraph::AddTask(std::function<void()> task, const std::vector<int>& dependencies) {
+    int id = (int)m_nodes.size();
+
+    Node node;
+    node.func = std::move(task);
+    node.num_dependencies = (int)dependencies.size();
+    for (auto dep : dependencies) {
+        if (dep < 0 || dep >= id)
+            throw ChException("ChTaskGraph: tasks can only depend on previously added tasks.");
+    }
+    m_nodes.push_back(std::move(node));
+
+    for (auto dep : dependencies)
+        m_nodes[dep].successors.push_back(id);
+
+    return id;
+}
+
+void ChTaskGraph::RunNode(int id, ChTaskGroup& group, std::atomic<int>* counters) {
+    m_nodes[id].func();
+
+    for (auto succ : m_nodes[id].successors) {
+        if (counters[succ].fetch_sub(1) == 1)
+            group.Run([this, succ, &group, counters]() { RunNode(succ, group, counters); });
+    }
+}
+
+void ChTaskGraph::Execute() {
+    int n = (int)m_nodes.size();
+    if (n == 0)
+        return;
+
+    std::unique_ptr<std::atomic<int>[]> counters(new std::atomic<int>[n]);
+    for (int i = 0; i < n; i++)
+        counters[i] = m_nodes[i].num_dependencies;
+
+    ChTaskGroup group;
+    std::atomic<int>* c = counters.get();
+    for (int i = 0; i < n; i++) {
+        if (m_nodes[i].num_dependencies == 0)
+            group.Run([this, i, &group, c]() { RunNode(i, group, c); });
+    }
+    group.Wait();
+}
+
+}  // end namespace chrono
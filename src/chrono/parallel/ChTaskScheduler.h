@@ -0,0 +1,249 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHTASKSCHEDULER_H
+#define CHTASKSCHEDULER_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+
+namespace chrono {
+
+class ChTaskGroup;
+
+/// Chrono-wide task scheduler, based on a pool of worker threads with work stealing.\n
+/// There is a single instance of the scheduler (see GetInstance()). With N threads, the pool has N-1
+/// worker threads: the thread that waits for the completion of some tasks (see ChTaskGroup::Wait) also
+/// executes queued tasks in the meantime. Each worker has its own task queue: it executes the most recently
+/// spawned tasks first, and steals the oldest tasks from the other queues when its own queue is empty.
+/// Tasks spawned by threads that are not workers of the pool go into a shared queue.\n
+/// Since tasks spawned inside other tasks are executed by the same pool, nested parallel loops (for example
+/// a parallel loop over the elements of a mesh, called from within a parallel loop over the items of an
+/// assembly) never create more threads than configured.\n
+/// Use ChParallelFor, ChParallelForRange, ChParallelReduce and ChTaskGraph rather than this class directly.
+/// The number of threads is set by ChSystem::SetParallelThreadNumber (by default, the number of cores).
+class ChApi ChTaskScheduler {
+  public:
+    /// Return the scheduler instance.
+    static ChTaskScheduler& GetInstance();
+
+    /// Set the number of threads used for parallel execution (including the calling thread).
+    /// The worker threads are (re)started lazily, at the first spawned task.
+    /// This function must not be called while parallel tasks are running; calls from within a task are ignored.
+    void SetNumThreads(int nthreads);
+
+    /// Return the number of threads used for parallel execution (including the calling thread).
+    int GetNumThreads() const { return m_num_threads; }
+
+    /// Return the index of the worker thread executing the caller, in [0, GetNumThreads()-1),
+    /// or -1 if the caller is not a worker of the pool.
+    static int GetCurrentWorker();
+
+  private:
+    ChTaskScheduler();
+    ~ChTaskScheduler();
+    ChTaskScheduler(const ChTaskScheduler&) = delete;
+    ChTaskScheduler& operator=(const ChTaskScheduler&) = delete;
+
+    struct Task {
+        std::function<void()> func;
+        ChTaskGroup* group;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    /// Queue a task (in the queue of the calling worker, or in the shared queue).
+    void Spawn(Task&& task);
+
+    /// Try to fetch a task (own queue first, then the shared queue, then stealing from other workers)
+    /// and execute it. Return false if no task was found.
+    bool RunOne();
+
+    /// Execute the given task and notify its group.
+    static void Execute(Task& task);
+
+    /// Execute queued tasks until the given condition is met. If there are no queued tasks, the calling
+    /// thread blocks (rather than spinning) until new tasks are queued or NotifyWaiting() is called.
+    void WaitUntil(const std::function<bool()>& done);
+
+    /// Wake up the threads blocked in WaitUntil(), so that they check their condition again.
+    void NotifyWaiting();
+
+    void WorkerLoop(int index);
+    void Start();
+    void Stop();
+
+    int m_num_threads;
+    std::vector<std::unique_ptr<Queue>> m_queues;  ///< one queue per worker, plus the shared queue (last)
+    std::vector<std::thread> m_workers;
+    std::atomic<int> m_queued;    ///< number of tasks waiting in the queues
+    std::atomic<bool> m_running;  ///< true if the worker threads were started
+    bool m_stop;
+    std::mutex m_sleep_mutex;
+    std::condition_variable m_sleep_cv;
+    std::mutex m_config_mutex;
+
+    friend class ChTaskGroup;
+    friend class ChThreads;
+};
+
+/// A group of tasks executed by the Chrono task scheduler.
+/// Tasks are spawned with Run() and the caller waits for their completion with Wait(); while waiting, the
+/// caller executes queued tasks, so a task group can be safely used from within another task. When there is
+/// nothing left to execute, the caller sleeps until the tasks still running on other threads complete.
+/// If some tasks throw an exception, the first one is rethrown by Wait().
+class ChApi ChTaskGroup {
+  public:
+    ChTaskGroup() : m_pending(0) {}
+
+    /// The destructor waits for the completion of all the tasks (exceptions are discarded).
+    ~ChTaskGroup();
+
+    /// Spawn a task. The task can also spawn other tasks in this group.
+    void Run(std::function<void()> task);
+
+    /// Wait for the completion of all the tasks in this group, executing queued tasks in the meantime.
+    void Wait();
+
+  private:
+    void WaitAll();
+
+    std::atomic<int> m_pending;
+    std::exception_ptr m_exception;
+    std::mutex m_exception_mutex;
+
+    friend class ChTaskScheduler;
+};
+
+/// Graph of tasks with dependencies, executed by the Chrono task scheduler.
+/// Tasks are added with AddTask(), specifying the tasks that must be completed before they can start. Tasks
+/// can only depend on previously added tasks, so the graph is always acyclic. Execute() runs all the tasks,
+/// starting each of them as soon as its dependencies are completed. A graph can be executed multiple times.
+class ChApi ChTaskGraph {
+  public:
+    ChTaskGraph() {}
+
+    /// Add a task, depending on the specified (previously added) tasks. Return the identifier of the new task.
+    int AddTask(std::function<void()> task, const std::vector<int>& dependencies = std::vector<int>());
+
+    /// Return the number of tasks in the graph.
+    int GetNumTasks() const { return (int)m_nodes.size(); }
+
+    /// Remove all tasks.
+    void Clear() { m_nodes.clear(); }
+
+    /// Execute all tasks, respecting the dependencies, and wait for their completion.
+    void Execute();
+
+  private:
+    struct Node {
+        std::function<void()> func;
+        std::vector<int> successors;
+        int num_dependencies;
+    };
+
+    void RunNode(int id, ChTaskGroup& group, std::atomic<int>* counters);
+
+    std::vector<Node> m_nodes;
+};
+
+/// Parallel loop over the range [begin, end), processed in chunks of (at most) 'grain' consecutive indices.
+/// The function 'body(from, to)' is called for each chunk [from, to). Chunks are assigned dynamically to the
+/// threads of the Chrono task scheduler. If grain <= 0, a chunk size is selected based on the number of
+/// threads. The calling thread waits for the completion of all the chunks.
+template <class Function>
+void ChParallelForRange(int begin, int end, int grain, Function&& body) {
+    int n = end - begin;
+    if (n <= 0)
+        return;
+
+    int nthreads = ChTaskScheduler::GetInstance().GetNumThreads();
+    if (grain <= 0)
+        grain = std::max(1, n / (8 * nthreads));
+    int nchunks = (n - 1) / grain + 1;
+
+    if (nthreads == 1 || nchunks == 1) {
+        body(begin, end);
+        return;
+    }
+
+    std::atomic<int> next(0);
+    auto work = [&]() {
+        int chunk;
+        while ((chunk = next.fetch_add(1)) < nchunks) {
+            int from = begin + chunk * grain;
+            body(from, std::min(from + grain, end));
+        }
+    };
+
+    ChTaskGroup group;
+    int nhelpers = std::min(nthreads, nchunks) - 1;
+    for (int k = 0; k < nhelpers; k++)
+        group.Run(work);
+    work();
+    group.Wait();
+}
+
+/// Parallel loop over the range [begin, end): the function 'body(i)' is called for each index.
+/// See ChParallelForRange for the meaning of 'grain'.
+template <class Function>
+void ChParallelFor(int begin, int end, int grain, Function&& body) {
+    ChParallelForRange(begin, end, grain, [&](int from, int to) {
+        for (int i = from; i < to; i++)
+            body(i);
+    });
+}
+
+/// Parallel reduction over the range [begin, end).
+/// The range is split in chunks of 'grain' consecutive indices, and 'func(from, to, identity)' returns the
+/// partial result for the chunk [from, to). The partial results are combined with 'combine(a, b)' always in
+/// the order of the chunks, so the result does not depend on the number of threads nor on the scheduling.
+/// If grain <= 0, a chunk size is selected based on the number of threads (in this case, the result is
+/// reproducible only for a fixed number of threads).
+template <typename T, class Function, class Combine>
+T ChParallelReduce(int begin, int end, int grain, const T& identity, Function&& func, Combine&& combine) {
+    int n = end - begin;
+    if (n <= 0)
+        return identity;
+
+    if (grain <= 0)
+        grain = std::max(1, n / (8 * ChTaskScheduler::GetInstance().GetNumThreads()));
+    int nchunks = (n - 1) / grain + 1;
+
+    std::vector<T> partial(nchunks, identity);
+    ChParallelFor(0, nchunks, 1, [&](int chunk) {
+        int from = begin + chunk * grain;
+        partial[chunk] = func(from, std::min(from + grain, end), identity);
+    });
+
+    T result = identity;
+    for (int chunk = 0; chunk < nchunks; chunk++)
+        result = combine(result, partial[chunk]);
+    return result;
+}
+
+}  // end namespace chrono
+
+#endif
@@ -14,11 +14,67 @@
 
 namespace chrono {
 
-/*
-ChThreads::~ChThreads()
-{
+ChThreads::ChThreads(ChThreadConstructionInfo& threadConstructionInfo)
+    : m_unique_name(threadConstructionInfo.m_uniqueName),
+      m_user_func(threadConstructionInfo.m_userThreadFunc),
+      m_num_requests(0) {
+    for (int i = 0; i < threadConstructionInfo.m_numThreads; i++) {
+        void* memory = threadConstructionInfo.m_lsMemoryFunc ? threadConstructionInfo.m_lsMemoryFunc() : nullptr;
+        m_local_memory.push_back(memory);
+    }
+}
+
+ChThreads::~ChThreads() {
+    try {
+        m_group.Wait();
+    } catch (...) {
+    }
+}
+
+void ChThreads::sendRequest(unsigned int uiCommand, void* uiUserPtr, unsigned int threadId) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_num_requests++;
+    }
+    void* memory = m_local_memory[threadId];
+    m_group.Run([this, uiUserPtr, threadId, memory]() {
+        // Report the completion also if the user function throws (the exception is discarded).
+        try {
+            m_user_func(uiUserPtr, memory);
+        } catch (...) {
+        }
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_completed.push_back(threadId);
+        }
+        ChTaskScheduler::GetInstance().NotifyWaiting();
+    });
+}
+
+void ChThreads::waitForResponse(unsigned int* puiArgument0, unsigned int* puiArgument1) {
+    ChTaskScheduler::GetInstance().WaitUntil([this]() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return !m_completed.empty();
+    });
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    *puiArgument0 = m_completed.front();
+    *puiArgument1 = 0;
+    m_completed.pop_front();
+    m_num_requests--;
+}
 
+void ChThreads::flush() {
+    while (true) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_num_requests == 0)
+                break;
+        }
+        unsigned int id;
+        unsigned int status;
+        waitForResponse(&id, &status);
+    }
 }
-*/
 
 }  // end namespace chrono
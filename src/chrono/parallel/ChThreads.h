@@ -13,48 +13,58 @@
 #ifndef CHTHREADS_H
 #define CHTHREADS_H
 
-#include "chrono/core/ChApiCE.h"
-
-#if defined _WIN32
-#include "chrono/parallel/ChThreadsWIN32.h"
-#endif
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
 
-#if (defined(__linux__) || defined(__APPLE__) || defined(__FreeBSD__))
-#include "chrono/parallel/ChThreadsPOSIX.h"
-#endif
+#include "chrono/core/ChApiCE.h"
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono/parallel/ChThreadsFunct.h"
 
 namespace chrono {
 
-class ChApi ChThreads : private ChThreadsPlatformImplementation {
+/// Pool of 'threads' executing a user function on request.\n
+/// Note: DEPRECATED, use ChTaskGroup, ChParallelFor or ChParallelReduce instead.\n
+/// This class is kept for compatibility with existing user code. It does not create threads anymore:
+/// each request is executed as a task of the Chrono task scheduler (see ChTaskScheduler), and the
+/// 'thread' identifier only selects the local memory passed to the user function. While waiting for a
+/// response, the caller executes queued tasks.
+class ChApi ChThreads {
   public:
-    ChThreads(ChThreadConstructionInfo& threadConstructionInfo)
-        : ChThreadsPlatformImplementation(threadConstructionInfo){};
+    ChThreads(ChThreadConstructionInfo& threadConstructionInfo);
 
-    virtual ~ChThreads(){};
+    /// The destructor waits for the completion of all the pending requests.
+    virtual ~ChThreads();
 
     /// send messages to threads-fibers, executing the user function
-    virtual void sendRequest(unsigned int uiCommand, void* uiUserPtr, unsigned int threadId) {
-        ChThreadsPlatformImplementation::sendRequest(uiCommand, uiUserPtr, threadId);
-    };
+    virtual void sendRequest(unsigned int uiCommand, void* uiUserPtr, unsigned int threadId);
 
-    /// check for messages from threads-fibers
-    virtual void waitForResponse(unsigned int* puiArgument0, unsigned int* puiArgument1) {
-        ChThreadsPlatformImplementation::waitForResponse(puiArgument0, puiArgument1);
-    };
+    /// check for messages from threads-fibers (return the id of a thread that completed its request)
+    virtual void waitForResponse(unsigned int* puiArgument0, unsigned int* puiArgument1);
 
-    /// start the threads-fibers
-    virtual void startSPU() { ChThreadsPlatformImplementation::startSPU(); };
+    /// start the threads-fibers (nothing to do)
+    virtual void startSPU() {}
 
-    /// tell the task scheduler we are done with the threads-fibers
-    virtual void stopSPU() { ChThreadsPlatformImplementation::stopSPU(); };
+    /// tell the task scheduler we are done with the threads-fibers (nothing to do)
+    virtual void stopSPU() {}
 
     /// Wait for all the threads/fibers to finish
-    virtual void flush() { ChThreadsPlatformImplementation::flush(); };
+    virtual void flush();
 
     /// Returns the number of threads handled by this pool
-    virtual int getNumberOfThreads() { return ChThreadsPlatformImplementation::getNumberOfThreads(); };
-
-    virtual std::string getUniqueName() { return ChThreadsPlatformImplementation::getUniqueName(); }
+    virtual int getNumberOfThreads() { return (int)m_local_memory.size(); }
+
+    virtual std::string getUniqueName() { return m_unique_name; }
+
+  private:
+    std::string m_unique_name;
+    ChThreadFunc m_user_func;
+    std::vector<void*> m_local_memory;  ///< local memory of each 'thread'
+    ChTaskGroup m_group;
+    std::mutex m_mutex;
+    std::deque<unsigned int> m_completed;  ///< threads that completed their request, not yet reported
+    int m_num_requests;                    ///< requests sent and not yet reported by waitForResponse
 };
 
 }  // end namespace chrono
@@ -17,6 +17,7 @@
 
 #include "chrono/core/ChLinearAlgebra.h"
 #include "chrono/core/ChTransform.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/physics/ChAssembly.h"
 #include "chrono/physics/ChBodyAuxRef.h"
 #include "chrono/physics/ChGlobal.h"
@@ -24,6 +25,10 @@
 
 namespace chrono {
 
+// Number of consecutive bodies (or links) processed by each parallel task in the loops below.
+// Lists shorter than this are processed serially, by the calling thread.
+static const int item_grain = 128;
+
 using namespace collision;
 using namespace geometry;
 
@@ -413,6 +418,16 @@ void ChAssembly::Setup() {
         ncoords_w - ndoc_w;  // number of degrees of freedom (approximate - does not consider constr. redundancy, etc)
 }
 
+// Accept the end-of-step state of all contents of this assembly.
+void ChAssembly::AcceptStep() {
+    for (auto& body : bodylist)
+        body->AcceptStep();
+    for (auto& link : linklist)
+        link->AcceptStep();
+    for (auto& item : otherphysicslist)
+        item->AcceptStep();
+}
+
 // Update assemblies own properties first (ChTime and assets, if any).
 // Then update all contents of this assembly.
 void ChAssembly::Update(double mytime, bool update_assets) {
@@ -425,8 +440,19 @@ void ChAssembly::Update(double mytime, bool update_assets) {
 // - UPDATES ALL FORCES  (AUTOMATIC, AS CHILDREN OF BODIES)
 // - UPDATES ALL MARKERS (AUTOMATIC, AS CHILDREN OF BODIES).
 void ChAssembly::Update(bool update_assets) {
-    for (int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->Update(ChTime, update_assets);
+    // Bodies only update their own state, markers and forces, so they can be updated in parallel.
+    // Assets may have side effects on other items (e.g. emitters adding bodies), so bodies with assets
+    // are updated serially if assets must be updated.
+    // Sleeping bodies do not move, so they are updated only to refresh their assets.
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
+        if (!bodylist[ip]->GetSleeping() && (!update_assets || bodylist[ip]->GetAssets().empty()))
+            bodylist[ip]->Update(ChTime, update_assets);
+    });
+    if (update_assets) {
+        for (int ip = 0; ip < bodylist.size(); ++ip) {
+            if (!bodylist[ip]->GetAssets().empty())
+                bodylist[ip]->Update(ChTime, update_assets);
+        }
     }
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->Update(ChTime, update_assets);
@@ -456,16 +482,20 @@ void ChAssembly::IntStateGather(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+        double T_item;  // not shared among threads; the assembly time is set below
         if (Bpointer->IsActive())
-            Bpointer->IntStateGather(displ_x + Bpointer->GetOffset_x(), x, displ_v + Bpointer->GetOffset_w(), v, T);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+            Bpointer->IntStateGather(displ_x + Bpointer->GetOffset_x(), x, displ_v + Bpointer->GetOffset_w(), v,
+                                      T_item);
+    });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
+        double T_item;  // not shared among threads; the assembly time is set below
         if (Lpointer->IsActive())
-            Lpointer->IntStateGather(displ_x + Lpointer->GetOffset_x(), x, displ_v + Lpointer->GetOffset_w(), v, T);
-    }
+            Lpointer->IntStateGather(displ_x + Lpointer->GetOffset_x(), x, displ_v + Lpointer->GetOffset_w(), v,
+                                      T_item);
+    });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
         Ppointer->IntStateGather(displ_x + Ppointer->GetOffset_x(), x, displ_v + Ppointer->GetOffset_w(), v, T);
@@ -481,9 +511,15 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
+    // Scattering the state also updates bodies and their assets: see Update() for the bodies with assets.
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
+        std::shared_ptr<ChBody> Bpointer = bodylist[ip];
+        if (Bpointer->IsActive() && Bpointer->GetAssets().empty())
+            Bpointer->IntStateScatter(displ_x + Bpointer->GetOffset_x(), x, displ_v + Bpointer->GetOffset_w(), v, T);
+    });
     for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
-        if (Bpointer->IsActive())
+        if (Bpointer->IsActive() && !Bpointer->GetAssets().empty())
             Bpointer->IntStateScatter(displ_x + Bpointer->GetOffset_x(), x, displ_v + Bpointer->GetOffset_w(), v, T);
     }
     for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
@@ -507,16 +543,16 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
 void ChAssembly::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
     unsigned int displ_a = off_a - this->offset_w;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntStateGatherAcceleration(displ_a + Bpointer->GetOffset_w(), a);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+    });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
             Lpointer->IntStateGatherAcceleration(displ_a + Lpointer->GetOffset_w(), a);
-    }
+    });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
         Ppointer->IntStateGatherAcceleration(displ_a + Ppointer->GetOffset_w(), a);
@@ -527,16 +563,16 @@ void ChAssembly::IntStateGatherAcceleration(const unsigned int off_a, ChStateDel
 void ChAssembly::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
     unsigned int displ_a = off_a - this->offset_w;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntStateScatterAcceleration(displ_a + Bpointer->GetOffset_w(), a);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+    });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
             Lpointer->IntStateScatterAcceleration(displ_a + Lpointer->GetOffset_w(), a);
-    }
+    });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
         Ppointer->IntStateScatterAcceleration(displ_a + Ppointer->GetOffset_w(), a);
@@ -547,16 +583,16 @@ void ChAssembly::IntStateScatterAcceleration(const unsigned int off_a, const ChS
 void ChAssembly::IntStateGatherReactions(const unsigned int off_L, ChVectorDynamic<>& L) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntStateGatherReactions(displ_L + Bpointer->GetOffset_L(), L);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+    });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
             Lpointer->IntStateGatherReactions(displ_L + Lpointer->GetOffset_L(), L);
-    }
+    });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
         Ppointer->IntStateGatherReactions(displ_L + Ppointer->GetOffset_L(), L);
@@ -567,16 +603,16 @@ void ChAssembly::IntStateGatherReactions(const unsigned int off_L, ChVectorDynam
 void ChAssembly::IntStateScatterReactions(const unsigned int off_L, const ChVectorDynamic<>& L) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntStateScatterReactions(displ_L + Bpointer->GetOffset_L(), L);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+    });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
             Lpointer->IntStateScatterReactions(displ_L + Lpointer->GetOffset_L(), L);
-    }
+    });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
         Ppointer->IntStateScatterReactions(displ_L + Ppointer->GetOffset_L(), L);
@@ -591,19 +627,19 @@ void ChAssembly::IntStateIncrement(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntStateIncrement(displ_x + Bpointer->GetOffset_x(), x_new, x, displ_v + Bpointer->GetOffset_w(),
                                         Dv);
-    }
+    });
 
-    for (int ip = 0; ip < linklist.size(); ++ip) {
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
             Lpointer->IntStateIncrement(displ_x + Lpointer->GetOffset_x(), x_new, x, displ_v + Lpointer->GetOffset_w(),
                                         Dv);
-    }
+    });
 
     for (int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
@@ -617,11 +653,11 @@ void ChAssembly::IntLoadResidual_F(const unsigned int off,  ///< offset in R res
 {
     unsigned int displ_v = off - this->offset_w;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntLoadResidual_F(displ_v + Bpointer->GetOffset_w(), R, c);
-    }
+    });
     for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
@@ -640,22 +676,66 @@ void ChAssembly::IntLoadResidual_Mv(const unsigned int off,      ///< offset in
 ) {
     unsigned int displ_v = off - this->offset_w;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntLoadResidual_Mv(displ_v + Bpointer->GetOffset_w(), R, w, c);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+    });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
             Lpointer->IntLoadResidual_Mv(displ_v + Lpointer->GetOffset_w(), R, w, c);
-    }
+    });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
         Ppointer->IntLoadResidual_Mv(displ_v + Ppointer->GetOffset_w(), R, w, c);
     }
 }
 
+bool ChAssembly::IntLoadLumpedMass_Md(const unsigned int off,  ///< offset in Md vector
+                                      ChVectorDynamic<>& Md,   ///< result: Md += c*diag(M_lumped)
+                                      const double c,          ///< a scaling factor
+                                      bool hrz                 ///< use HRZ lumping, where it applies
+) {
+    unsigned int displ_v = off - this->offset_w;
+
+    // Items that do not provide a lumped mass get the row sums of their mass matrix, i.e. M*[1 1 .. 1].
+    ChVectorDynamic<> ones;
+    auto load_item = [&](ChPhysicsItem* item) {
+        unsigned int item_off = displ_v + item->GetOffset_w();
+        if (item->IntLoadLumpedMass_Md(item_off, Md, c, hrz))
+            return;
+        if (ones.GetRows() != Md.GetRows()) {
+            ones.Resize(Md.GetRows(), 1);
+            ones.FillElem(1);
+        }
+        item->IntLoadResidual_Mv(item_off, Md, ones, c);
+    };
+
+    for (auto& body : bodylist) {
+        if (body->IsActive())
+            load_item(body.get());
+    }
+    for (auto& link : linklist) {
+        if (link->IsActive())
+            load_item(link.get());
+    }
+    for (auto& item : otherphysicslist)
+        load_item(item.get());
+
+    return true;
+}
+
+double ChAssembly::ComputeStableTimeStep() {
+    double step = 0;
+    for (auto& item : otherphysicslist) {
+        double item_step = item->ComputeStableTimeStep();
+        if (item_step > 0 && (step == 0 || item_step < step))
+            step = item_step;
+    }
+    return step;
+}
+
 void ChAssembly::IntLoadResidual_CqL(const unsigned int off_L,    ///< offset in L multipliers
                                      ChVectorDynamic<>& R,        ///< result: the R residual, R += c*Cq'*L
                                      const ChVectorDynamic<>& L,  ///< the L vector
@@ -663,11 +743,11 @@ void ChAssembly::IntLoadResidual_CqL(const unsigned int off_L,    ///< offset in
 ) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntLoadResidual_CqL(displ_L + Bpointer->GetOffset_L(), R, L, c);
-    }
+    });
     for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
@@ -687,16 +767,16 @@ void ChAssembly::IntLoadConstraint_C(const unsigned int off_L,  ///< offset in Q
 ) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntLoadConstraint_C(displ_L + Bpointer->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+    });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
             Lpointer->IntLoadConstraint_C(displ_L + Lpointer->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
-    }
+    });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
         Ppointer->IntLoadConstraint_C(displ_L + Ppointer->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
@@ -709,16 +789,16 @@ void ChAssembly::IntLoadConstraint_Ct(const unsigned int off_L,  ///< offset in
 ) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntLoadConstraint_Ct(displ_L + Bpointer->GetOffset_L(), Qc, c);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
+    });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
             Lpointer->IntLoadConstraint_Ct(displ_L + Lpointer->GetOffset_L(), Qc, c);
-    }
+    });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
         Ppointer->IntLoadConstraint_Ct(displ_L + Ppointer->GetOffset_L(), Qc, c);
@@ -734,19 +814,19 @@ void ChAssembly::IntToDescriptor(const unsigned int off_v,
     unsigned int displ_L = off_L - this->offset_L;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntToDescriptor(displ_v + Bpointer->GetOffset_w(), v, R, displ_L + Bpointer->GetOffset_L(), L,
                                       Qc);
-    }
+    });
 
-    for (int ip = 0; ip < linklist.size(); ++ip) {
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
             Lpointer->IntToDescriptor(displ_v + Lpointer->GetOffset_w(), v, R, displ_L + Lpointer->GetOffset_L(), L,
                                       Qc);
-    }
+    });
 
     for (int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
@@ -761,17 +841,17 @@ void ChAssembly::IntFromDescriptor(const unsigned int off_v,
     unsigned int displ_L = off_L - this->offset_L;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (int ip = 0; ip < bodylist.size(); ++ip) {
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChBody> Bpointer = bodylist[ip];
         if (Bpointer->IsActive())
             Bpointer->IntFromDescriptor(displ_v + Bpointer->GetOffset_w(), v, displ_L + Bpointer->GetOffset_L(), L);
-    }
+    });
 
-    for (int ip = 0; ip < linklist.size(); ++ip) {
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) {
         std::shared_ptr<ChLink> Lpointer = linklist[ip];
         if (Lpointer->IsActive())
             Lpointer->IntFromDescriptor(displ_v + Lpointer->GetOffset_w(), v, displ_L + Lpointer->GetOffset_L(), L);
-    }
+    });
 
     for (int ip = 0; ip < otherphysicslist.size(); ++ip) {
         std::shared_ptr<ChPhysicsItem> Ppointer = otherphysicslist[ip];
@@ -794,72 +874,50 @@ void ChAssembly::InjectVariables(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChAssembly::VariablesFbReset() {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->VariablesFbReset();
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->VariablesFbReset();
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->VariablesFbReset(); });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) { linklist[ip]->VariablesFbReset(); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->VariablesFbReset();
     }
 }
 
 void ChAssembly::VariablesFbLoadForces(double factor) {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->VariablesFbLoadForces(factor);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->VariablesFbLoadForces(factor);
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->VariablesFbLoadForces(factor); });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) { linklist[ip]->VariablesFbLoadForces(factor); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->VariablesFbLoadForces(factor);
     }
 }
 
 void ChAssembly::VariablesFbIncrementMq() {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->VariablesFbIncrementMq();
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->VariablesFbIncrementMq();
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->VariablesFbIncrementMq(); });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) { linklist[ip]->VariablesFbIncrementMq(); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->VariablesFbIncrementMq();
     }
 }
 
 void ChAssembly::VariablesQbLoadSpeed() {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->VariablesQbLoadSpeed();
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->VariablesQbLoadSpeed();
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->VariablesQbLoadSpeed(); });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) { linklist[ip]->VariablesQbLoadSpeed(); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->VariablesQbLoadSpeed();
     }
 }
 
 void ChAssembly::VariablesQbSetSpeed(double step) {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->VariablesQbSetSpeed(step);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->VariablesQbSetSpeed(step);
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->VariablesQbSetSpeed(step); });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) { linklist[ip]->VariablesQbSetSpeed(step); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->VariablesQbSetSpeed(step);
     }
 }
 
 void ChAssembly::VariablesQbIncrementPosition(double dt_step) {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->VariablesQbIncrementPosition(dt_step);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->VariablesQbIncrementPosition(dt_step);
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain,
+                  [&](int ip) { bodylist[ip]->VariablesQbIncrementPosition(dt_step); });
+    ChParallelFor(0, (int)linklist.size(), item_grain,
+                  [&](int ip) { linklist[ip]->VariablesQbIncrementPosition(dt_step); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->VariablesQbIncrementPosition(dt_step);
     }
@@ -878,57 +936,41 @@ void ChAssembly::InjectConstraints(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChAssembly::ConstraintsBiReset() {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->ConstraintsBiReset();
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->ConstraintsBiReset();
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->ConstraintsBiReset(); });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) { linklist[ip]->ConstraintsBiReset(); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->ConstraintsBiReset();
     }
 }
 
 void ChAssembly::ConstraintsBiLoad_C(double factor, double recovery_clamp, bool do_clamp) {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain,
+                  [&](int ip) { bodylist[ip]->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp); });
+    ChParallelFor(0, (int)linklist.size(), item_grain,
+                  [&](int ip) { linklist[ip]->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
     }
 }
 
 void ChAssembly::ConstraintsBiLoad_Ct(double factor) {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->ConstraintsBiLoad_Ct(factor);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->ConstraintsBiLoad_Ct(factor);
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->ConstraintsBiLoad_Ct(factor); });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) { linklist[ip]->ConstraintsBiLoad_Ct(factor); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->ConstraintsBiLoad_Ct(factor);
     }
 }
 
 void ChAssembly::ConstraintsBiLoad_Qc(double factor) {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->ConstraintsBiLoad_Qc(factor);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->ConstraintsBiLoad_Qc(factor);
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->ConstraintsBiLoad_Qc(factor); });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) { linklist[ip]->ConstraintsBiLoad_Qc(factor); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->ConstraintsBiLoad_Qc(factor);
     }
 }
 
 void ChAssembly::ConstraintsFbLoadForces(double factor) {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->ConstraintsFbLoadForces(factor);
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->ConstraintsFbLoadForces(factor); });
     for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
         linklist[ip]->ConstraintsFbLoadForces(factor);
     }
@@ -938,24 +980,16 @@ void ChAssembly::ConstraintsFbLoadForces(double factor) {
 }
 
 void ChAssembly::ConstraintsLoadJacobians() {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->ConstraintsLoadJacobians();
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->ConstraintsLoadJacobians();
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->ConstraintsLoadJacobians(); });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) { linklist[ip]->ConstraintsLoadJacobians(); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->ConstraintsLoadJacobians();
     }
 }
 
 void ChAssembly::ConstraintsFetch_react(double factor) {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->ConstraintsFetch_react(factor);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->ConstraintsFetch_react(factor);
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain, [&](int ip) { bodylist[ip]->ConstraintsFetch_react(factor); });
+    ChParallelFor(0, (int)linklist.size(), item_grain, [&](int ip) { linklist[ip]->ConstraintsFetch_react(factor); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->ConstraintsFetch_react(factor);
     }
@@ -974,12 +1008,10 @@ void ChAssembly::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChAssembly::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
-    for (unsigned int ip = 0; ip < bodylist.size(); ++ip) {
-        bodylist[ip]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
-    }
-    for (unsigned int ip = 0; ip < linklist.size(); ++ip) {
-        linklist[ip]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
-    }
+    ChParallelFor(0, (int)bodylist.size(), item_grain,
+                  [&](int ip) { bodylist[ip]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor); });
+    ChParallelFor(0, (int)linklist.size(), item_grain,
+                  [&](int ip) { linklist[ip]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor); });
     for (unsigned int ip = 0; ip < otherphysicslist.size(); ++ip) {
         otherphysicslist[ip]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
     }
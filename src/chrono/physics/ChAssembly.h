@@ -24,6 +24,11 @@ namespace chrono {
 /// Class for assemblies of items, for example ChBody, ChLink, ChMesh, etc.
 /// Note that an assembly can be added to another assembly, to create a tree-like hierarchy.
 /// All positions of rigid bodies, FEA nodes, etc. are assumed respect to the absolute position.
+/// Most of the loops over bodies and links (state gather/scatter, residuals, descriptor loading, etc.) are
+/// executed in parallel by the Chrono task scheduler (see ChTaskScheduler). This requires that each body or
+/// link only writes its own state, variables and constraints in these functions. Operations that write the
+/// variables of other items (link forces and constraint reactions applied to bodies, link updates) and
+/// updates of bodies with assets are performed serially. Results do not depend on the number of threads.
 
 class ChApi ChAssembly : public ChPhysicsItem {
 
@@ -171,6 +176,9 @@ class ChApi ChAssembly : public ChPhysicsItem {
     /// bodies, forces, links, given their current state.
     virtual void Update(double mytime, bool update_assets = true) override;
 
+    /// Accept the state reached at the end of a time step, for all the contained items.
+    virtual void AcceptStep() override;
+
     /// Updates all the auxiliary data and children of
     /// bodies, forces, links, given their current state.
     virtual void Update(bool update_assets = true) override;
@@ -214,6 +222,11 @@ class ChApi ChAssembly : public ChPhysicsItem {
                                     ChVectorDynamic<>& R,
                                     const ChVectorDynamic<>& w,
                                     const double c) override;
+    virtual bool IntLoadLumpedMass_Md(const unsigned int off,
+                                      ChVectorDynamic<>& Md,
+                                      const double c,
+                                      bool hrz) override;
+    virtual double ComputeStableTimeStep() override;
     virtual void IntLoadResidual_CqL(const unsigned int off_L,
                                      ChVectorDynamic<>& R,
                                      const ChVectorDynamic<>& L,
@@ -252,6 +252,21 @@ void ChBody::IntLoadResidual_Mv(const unsigned int off,      // offset in R resi
     R.PasteSumVector(Iw, off + 3, 0);
 }
 
+bool ChBody::IntLoadLumpedMass_Md(const unsigned int off,  // offset in Md vector
+                                  ChVectorDynamic<>& Md,   // result: Md += c*diag(M_lumped)
+                                  const double c,          // a scaling factor
+                                  bool hrz                 // use HRZ lumping (not used for bodies)
+                                  ) {
+    // The rotational speeds are in the body frame, where the inertia is constant: keep only its diagonal.
+    Md(off + 0) += c * GetMass();
+    Md(off + 1) += c * GetMass();
+    Md(off + 2) += c * GetMass();
+    Md(off + 3) += c * GetInertia()(0, 0);
+    Md(off + 4) += c * GetInertia()(1, 1);
+    Md(off + 5) += c * GetInertia()(2, 2);
+    return true;
+}
+
 void ChBody::IntToDescriptor(const unsigned int off_v,
                              const ChStateDelta& v,
                              const ChVectorDynamic<>& R,
@@ -239,6 +239,10 @@ class ChApi ChBody : public ChPhysicsItem, public ChBodyFrame, public ChContacta
                                     ChVectorDynamic<>& R,
                                     const ChVectorDynamic<>& w,
                                     const double c) override;
+    virtual bool IntLoadLumpedMass_Md(const unsigned int off,
+                                      ChVectorDynamic<>& Md,
+                                      const double c,
+                                      bool hrz) override;
     virtual void IntToDescriptor(const unsigned int off_v,
                                  const ChStateDelta& v,
                                  const ChVectorDynamic<>& R,
@@ -834,6 +838,7 @@ class ChApi ChBody : public ChPhysicsItem, public ChBodyFrame, public ChContacta
 
     // Give private access
     friend class ChSystem;
+    friend class ChIslands;
 };
 
 CH_CLASS_VERSION(ChBody,0)
@@ -12,6 +12,7 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/physics/ChContactContainerSMC.h"
 #include "chrono/physics/ChSystemSMC.h"
 
@@ -371,12 +372,11 @@ void ChContactContainerSMC::IntLoadResidual_F(const unsigned int off, ChVectorDy
 }
 
 template <class Tcont>
-void _KRMmatricesLoad(std::list<Tcont*> contactlist, double Kfactor, double Rfactor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContKRMmatricesLoad(Kfactor, Rfactor);
-        ++itercontact;
-    }
+void _KRMmatricesLoad(std::list<Tcont*>& contactlist, double Kfactor, double Rfactor) {
+    // Each contact only loads its own Jacobian blocks, so contacts can be processed in parallel.
+    std::vector<Tcont*> contacts(contactlist.begin(), contactlist.end());
+    ChParallelFor(0, (int)contacts.size(), 0,
+                  [&](int ic) { contacts[ic]->ContKRMmatricesLoad(Kfactor, Rfactor); });
 }
 
 void ChContactContainerSMC::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
@@ -393,7 +393,7 @@ void ChContactContainerSMC::KRMmatricesLoad(double Kfactor, double Rfactor, doub
 }
 
 template <class Tcont>
-void _InjectKRMmatrices(std::list<Tcont*> contactlist, ChSystemDescriptor& mdescriptor) {
+void _InjectKRMmatrices(std::list<Tcont*>& contactlist, ChSystemDescriptor& mdescriptor) {
     typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
     while (itercontact != contactlist.end()) {
         (*itercontact)->ContInjectKRMmatrices(mdescriptor);
@@ -0,0 +1,237 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/physics/ChIslands.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+
+void ChIslands::UpdateBodies(ChSystem& system) {
+    auto& bodylist = system.Get_bodylist();
+
+    bool changed = (bodylist.size() != bodies.size());
+    for (size_t i = 0; i < bodylist.size() && !changed; i++)
+        changed = (bodylist[i].get() != bodies[i]);
+    if (!changed)
+        return;
+
+    // Carry the sleeping groups over to the new indices: the new representative of a group is the
+    // first of its bodies still in the system.
+    std::unordered_map<ChBody*, int> old_group;
+    for (size_t i = 0; i < bodies.size(); i++) {
+        if (sleep_group[i] >= 0)
+            old_group[bodies[i]] = sleep_group[i];
+    }
+    std::unordered_map<int, int> new_group;
+
+    int nbodies = (int)bodylist.size();
+    bodies.resize(nbodies);
+    sleep_group.assign(nbodies, -1);
+    body_index.clear();
+    for (int i = 0; i < nbodies; i++) {
+        ChBody* body = bodylist[i].get();
+        bodies[i] = body;
+        body_index[body] = i;
+
+        auto old = old_group.find(body);
+        if (old != old_group.end()) {
+            auto group = new_group.find(old->second);
+            if (group == new_group.end())
+                group = new_group.insert(std::make_pair(old->second, i)).first;
+            sleep_group[i] = group->second;
+        }
+    }
+
+    // Force the link pairs to be rebuilt, since the body indices changed.
+    link_bodies.clear();
+    link_pairs.clear();
+}
+
+void ChIslands::UpdateLinks(ChSystem& system) {
+    auto& linklist = system.Get_linklist();
+
+    bool changed = (2 * linklist.size() != link_bodies.size());
+    for (size_t i = 0; i < linklist.size() && !changed; i++)
+        changed = (linklist[i]->GetBody1() != link_bodies[2 * i] || linklist[i]->GetBody2() != link_bodies[2 * i + 1]);
+    if (!changed)
+        return;
+
+    link_bodies.resize(2 * linklist.size());
+    link_pairs.clear();
+    for (size_t i = 0; i < linklist.size(); i++) {
+        ChLink* link = linklist[i].get();
+        link_bodies[2 * i] = link->GetBody1();
+        link_bodies[2 * i + 1] = link->GetBody2();
+
+        if (!link->IsRequiringWaking())
+            continue;
+        ChBody* b1 = dynamic_cast<ChBody*>(link->GetBody1());
+        ChBody* b2 = dynamic_cast<ChBody*>(link->GetBody2());
+        if (!(b1 && b2))
+            continue;
+        auto i1 = body_index.find(b1);
+        auto i2 = body_index.find(b2);
+        if (i1 != body_index.end() && i2 != body_index.end() && i1->second != i2->second)
+            link_pairs.push_back(std::make_pair(i1->second, i2->second));
+    }
+}
+
+void ChIslands::Update(ChSystem& system) {
+    UpdateBodies(system);
+    UpdateLinks(system);
+
+    int nbodies = (int)bodies.size();
+    uf.Reset(nbodies);
+
+    // Links. A link to a fixed body does not merge islands, but its other body must be kept awake
+    // (e.g. a motor may start moving it at any time).
+    std::vector<bool> body_awake(nbodies, false);
+    for (auto& pair : link_pairs) {
+        bool fixed1 = bodies[pair.first]->GetBodyFixed();
+        bool fixed2 = bodies[pair.second]->GetBodyFixed();
+        if (!fixed1 && !fixed2)
+            uf.Union(pair.first, pair.second);
+        else if (!fixed1)
+            body_awake[pair.first] = true;
+        else if (!fixed2)
+            body_awake[pair.second] = true;
+    }
+
+    // Bodies that went to sleep together
+    for (int i = 0; i < nbodies; i++) {
+        if (sleep_group[i] >= 0 && !bodies[i]->GetBodyFixed() && !bodies[sleep_group[i]]->GetBodyFixed())
+            uf.Union(i, sleep_group[i]);
+    }
+
+    // Contacts (the contact containers report only the contacts with at least one active body)
+    class _island_reporter_class : public ChContactContainer::ReportContactCallback {
+      public:
+        virtual bool OnReportContact(const ChVector<>& pA,
+                                     const ChVector<>& pB,
+                                     const ChMatrix33<>& plane_coord,
+                                     const double& distance,
+                                     const double& eff_radius,
+                                     const ChVector<>& react_forces,
+                                     const ChVector<>& react_torques,
+                                     ChContactable* contactobjA,
+                                     ChContactable* contactobjB) override {
+            if (!(contactobjA && contactobjB))
+                return true;
+            auto iA = islands->body_index.find(contactobjA);
+            if (iA == islands->body_index.end())
+                return true;
+            auto iB = islands->body_index.find(contactobjB);
+            if (iB == islands->body_index.end())
+                return true;
+            if (!islands->bodies[iA->second]->GetBodyFixed() && !islands->bodies[iB->second]->GetBodyFixed())
+                islands->uf.Union(iA->second, iB->second);
+            return true;  // to continue scanning contacts
+        }
+
+        ChIslands* islands;
+    };
+
+    _island_reporter_class my_reporter;
+    my_reporter.islands = this;
+    system.GetContactContainer()->ReportAllContacts(&my_reporter);
+
+    // Number the islands in order of their first body, and group the bodies by island.
+    body_island.assign(nbodies, -1);
+    std::vector<int> root_island(nbodies, -1);
+    int nislands = 0;
+    for (int i = 0; i < nbodies; i++) {
+        if (bodies[i]->GetBodyFixed())
+            continue;
+        int root = uf.Find(i);
+        if (root_island[root] < 0)
+            root_island[root] = nislands++;
+        body_island[i] = root_island[root];
+    }
+
+    island_start.assign(nislands + 1, 0);
+    for (int i = 0; i < nbodies; i++) {
+        if (body_island[i] >= 0)
+            island_start[body_island[i] + 1]++;
+    }
+    for (int k = 0; k < nislands; k++)
+        island_start[k + 1] += island_start[k];
+
+    island_bodies.resize(island_start[nislands]);
+    std::vector<int> fill(island_start.begin(), island_start.end() - 1);
+    for (int i = 0; i < nbodies; i++) {
+        if (body_island[i] >= 0)
+            island_bodies[fill[body_island[i]]++] = i;
+    }
+
+    island_awake.assign(nislands, false);
+    for (int i = 0; i < nbodies; i++) {
+        if (body_awake[i] && body_island[i] >= 0)
+            island_awake[body_island[i]] = true;
+    }
+
+    island_sleeping.assign(nislands, false);
+    for (int k = 0; k < nislands; k++) {
+        bool sleeping = true;
+        for (int j = island_start[k]; j < island_start[k + 1] && sleeping; j++)
+            sleeping = bodies[island_bodies[j]]->GetSleeping();
+        island_sleeping[k] = sleeping;
+    }
+}
+
+bool ChIslands::UpdateSleeping() {
+    bool changed = false;
+
+    for (int k = 0; k < GetNumIslands(); k++) {
+        bool can_sleep = !island_awake[k];
+        for (int j = island_start[k]; j < island_start[k + 1] && can_sleep; j++) {
+            ChBody* body = bodies[island_bodies[j]];
+            can_sleep = body->GetSleeping() || body->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
+        }
+
+        // The first body of the island is the representative of its sleeping group.
+        int group = can_sleep ? island_bodies[island_start[k]] : -1;
+        for (int j = island_start[k]; j < island_start[k + 1]; j++) {
+            int i = island_bodies[j];
+            if (bodies[i]->GetSleeping() != can_sleep) {
+                bodies[i]->SetSleeping(can_sleep);
+                changed = true;
+            }
+            sleep_group[i] = group;
+        }
+        island_sleeping[k] = can_sleep;
+    }
+
+    return changed;
+}
+
+int ChIslands::GetNumSleepingIslands() const {
+    int count = 0;
+    for (auto sleeping : island_sleeping)
+        count += sleeping ? 1 : 0;
+    return count;
+}
+
+std::vector<ChBody*> ChIslands::GetIslandBodies(int island) const {
+    std::vector<ChBody*> result;
+    for (int j = island_start[island]; j < island_start[island + 1]; j++)
+        result.push_back(bodies[island_bodies[j]]);
+    return result;
+}
+
+int ChIslands::GetIsland(ChBody* body) const {
+    auto index = body_index.find(body);
+    if (index == body_index.end())
+        return -1;
+    return body_island[index->second];
+}
+
+}  // end namespace chrono
@@ -0,0 +1,98 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHISLANDS_H
+#define CHISLANDS_H
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChUnionFind.h"
+
+namespace chrono {
+
+// Forward references
+class ChSystem;
+class ChBody;
+class ChBodyFrame;
+class ChContactable;
+
+/// Partition of the bodies of a ChSystem in 'islands', i.e. groups of bodies connected by links or contacts.\n
+/// Fixed bodies do not belong to any island and do not connect islands (e.g. bodies resting on the same
+/// ground are in separate islands, unless they touch each other). However, an island with a link to a fixed
+/// body (among the links that require waking, see ChLinkBase::IsRequiringWaking) never goes to sleep, since
+/// the link may set it in motion at any time (e.g. a motor). Bodies that went to sleep together stay
+/// in the same island until they are woken up, even if their contacts are no longer reported.\n
+/// The islands are computed by Update() with a union-find over the bodies. The map from bodies to indices
+/// and the pairs of bodies connected by links are cached, and rebuilt only when the lists of bodies or
+/// links of the system change; only the contacts are processed from scratch at each call.\n
+/// If sleeping is enabled (see ChSystem::SetUseSleeping), the islands are updated at each time step and
+/// a whole island goes to sleep when all its bodies are at rest (see UpdateSleeping).
+class ChApi ChIslands {
+  public:
+    ChIslands() : island_start(1, 0) {}
+
+    /// Compute the islands of the given system, from its bodies, links and current contacts.
+    void Update(ChSystem& system);
+
+    /// Put to sleep the islands whose bodies are all sleeping or at rest (i.e. flagged as sleep candidates
+    /// by ChBody::TrySleeping) and that are not linked to fixed bodies, and wake up all the bodies of the
+    /// other islands.
+    /// Must be called after Update(). Return true if some body changed its sleeping state.
+    bool UpdateSleeping();
+
+    /// Return the number of islands found by the last call to Update().
+    int GetNumIslands() const { return (int)island_start.size() - 1; }
+
+    /// Return the number of islands that are sleeping.
+    int GetNumSleepingIslands() const;
+
+    /// Return the bodies in the specified island.
+    std::vector<ChBody*> GetIslandBodies(int island) const;
+
+    /// Return the number of bodies in the specified island.
+    int GetIslandNumBodies(int island) const { return island_start[island + 1] - island_start[island]; }
+
+    /// Return true if all the bodies in the specified island are sleeping.
+    bool IsIslandSleeping(int island) const { return island_sleeping[island]; }
+
+    /// Return the island of the specified body, or -1 if the body is fixed or was not in the system
+    /// at the last call to Update().
+    int GetIsland(ChBody* body) const;
+
+  private:
+    /// Rebuild the map from bodies to indices, if the list of bodies changed.
+    void UpdateBodies(ChSystem& system);
+
+    /// Rebuild the pairs of bodies connected by links, if the list of links (or their bodies) changed.
+    void UpdateLinks(ChSystem& system);
+
+    std::vector<ChBody*> bodies;                          ///< bodies of the system (cached)
+    std::unordered_map<ChContactable*, int> body_index;  ///< index of each body, from its contactable interface
+    std::vector<int> sleep_group;                         ///< for each body, its sleeping group (or -1)
+
+    std::vector<ChBodyFrame*> link_bodies;        ///< bodies of each link (2 per link, cached)
+    std::vector<std::pair<int, int>> link_pairs;  ///< indices of the bodies connected by links
+
+    ChUnionFind uf;
+    std::vector<int> body_island;      ///< island of each body (-1 for fixed bodies)
+    std::vector<int> island_start;     ///< offsets of the islands in 'island_bodies' (plus end marker)
+    std::vector<int> island_bodies;    ///< indices of the bodies, grouped by island
+    std::vector<bool> island_sleeping;  ///< sleeping state of each island
+    std::vector<bool> island_awake;     ///< islands kept awake by links to fixed bodies
+};
+
+}  // end namespace chrono
+
+#endif
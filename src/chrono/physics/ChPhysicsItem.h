@@ -148,6 +148,12 @@ class ChApi ChPhysicsItem : public ChObj {
     /// and update the asset tree, if any.
     virtual void Update(double mytime, bool update_assets = true);
 
+    /// Accept the state reached at the end of a time step.
+    /// This is called by the owner ChSystem once per integration step, after the timestepper completed
+    /// the step. Items with a history-dependent internal state (ex. plasticity in ChMesh elements) can
+    /// evaluate it any number of times during the step and commit it only here.
+    virtual void AcceptStep() {}
+
     /// As above, but does not require updating of time-dependent
     /// data. By default, calls Update(mytime) using item's current time.
     virtual void Update(bool update_assets = true) { Update(ChTime, update_assets); }
@@ -269,6 +275,23 @@ class ChApi ChPhysicsItem : public ChObj {
                                     const double c               ///< a scaling factor
     ) {}
 
+    /// Takes the diagonal of a lumped mass matrix, scale and adds to Md at given offset:
+    ///    Md += c*diag(M_lumped)
+    /// If hrz is true, use the HRZ (Hinton-Rock-Zienkiewicz) lumping where it applies (i.e. finite elements).
+    /// Return false if the item does not provide a lumped mass; the caller then sums the rows of its mass
+    /// matrix (see IntLoadResidual_Mv).
+    virtual bool IntLoadLumpedMass_Md(const unsigned int off,  ///< offset in Md vector
+                                      ChVectorDynamic<>& Md,   ///< result: Md += c*diag(M_lumped)
+                                      const double c,          ///< a scaling factor
+                                      bool hrz                 ///< use HRZ lumping, where it applies
+    ) {
+        return false;
+    }
+
+    /// Return an estimate of the largest stable step for the explicit integration of this item with a lumped
+    /// mass (e.g. from the size and the wave speed of finite elements), or 0 if the item does not limit it.
+    virtual double ComputeStableTimeStep() { return 0; }
+
     /// Takes the term Cq'*L, scale and adds to R at given offset:
     ///    R += c*Cq'*L
     virtual void IntLoadResidual_CqL(const unsigned int off_L,    ///< offset in L multipliers
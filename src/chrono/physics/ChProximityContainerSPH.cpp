@@ -15,6 +15,7 @@
 #include <list>
 
 #include "chrono/collision/ChCModelBullet.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChMatterSPH.h"
 #include "chrono/physics/ChProximityContainerSPH.h"
@@ -28,7 +29,7 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChProximityContainerSPH)
 
-ChProximityContainerSPH::ChProximityContainerSPH() : n_added(0) {
+ChProximityContainerSPH::ChProximityContainerSPH() : n_added(0), use_cell_list(false) {
     lastproximity = proximitylist.begin();
 }
 
@@ -37,6 +38,7 @@ ChProximityContainerSPH::ChProximityContainerSPH(const ChProximityContainerSPH&
     n_added = other.n_added;
     proximitylist = other.proximitylist;
     lastproximity = proximitylist.begin();
+    use_cell_list = other.use_cell_list;
 }
 
 ChProximityContainerSPH::~ChProximityContainerSPH() {
@@ -81,6 +83,10 @@ void ChProximityContainerSPH::EndAddProximities() {
 }
 
 void ChProximityContainerSPH::AddProximity(collision::ChCollisionModel* modA, collision::ChCollisionModel* modB) {
+    // The neighbors are found by the cell list
+    if (use_cell_list)
+        return;
+
     // Fetch the frames of that proximity and other infos
 
     ChNodeSPH* mnA = dynamic_cast<ChNodeSPH*>(modA->GetContactable());
@@ -113,6 +119,20 @@ void ChProximityContainerSPH::AddProximity(collision::ChCollisionModel* modA, co
 }
 
 void ChProximityContainerSPH::ReportAllProximities(ReportProximityCallback* mcallback) {
+    if (use_cell_list) {
+        const std::vector<int>& start = cell_list.GetNeighborStart();
+        const std::vector<int>& neighbors = cell_list.GetNeighbors();
+        for (int i = 0; i < cell_list.GetNumPoints(); i++) {
+            for (int k = start[i]; k < start[i + 1]; k++) {
+                int j = neighbors[k];
+                if (j > i && !mcallback->OnReportProximity(cell_nodes[i]->collision_model,
+                                                           cell_nodes[j]->collision_model))
+                    return;
+            }
+        }
+        return;
+    }
+
     std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
     while (iterproximity != proximitylist.end()) {
         bool proceed = mcallback->OnReportProximity((*iterproximity)->GetModelA(), (*iterproximity)->GetModelB());
@@ -126,14 +146,17 @@ void ChProximityContainerSPH::ReportAllProximities(ReportProximityCallback* mcal
 
 static double W_poly6(double r, double h) {
     if (r < h) {
-        return (315.0 / (64.0 * CH_C_PI * pow(h, 9))) * pow((h * h - r * r), 3);
+        double h3 = h * h * h;
+        double d = h * h - r * r;
+        return (315.0 / (64.0 * CH_C_PI * h3 * h3 * h3)) * d * d * d;
     } else
         return 0;
 }
 
 static double W_sq_visco(double r, double h) {
     if (r < h) {
-        return (45.0 / (CH_C_PI * pow(h, 6))) * (h - r);
+        double h3 = h * h * h;
+        return (45.0 / (CH_C_PI * h3 * h3)) * (h - r);
     } else
         return 0;
 }
@@ -141,12 +164,19 @@ static double W_sq_visco(double r, double h) {
 static void W_gr_press(ChVector<>& Wresult, const ChVector<>& r, const double r_length, const double h) {
     if (r_length < h) {
         Wresult = r;
-        Wresult *= -(45.0 / (CH_C_PI * pow(h, 6))) * pow((h - r_length), 2.0);
+        double h3 = h * h * h;
+        Wresult *= -(45.0 / (CH_C_PI * h3 * h3)) * (h - r_length) * (h - r_length);
     } else
         Wresult = VNULL;
 }
 
 void ChProximityContainerSPH::AccumulateStep1() {
+    if (use_cell_list) {
+        UpdateCellList();
+        AccumulateStep1CellList();
+        return;
+    }
+
     // Per-edge data computation
     std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
     while (iterproximity != proximitylist.end()) {
@@ -171,6 +201,11 @@ void ChProximityContainerSPH::AccumulateStep1() {
 }
 
 void ChProximityContainerSPH::AccumulateStep2() {
+    if (use_cell_list) {
+        AccumulateStep2CellList();
+        return;
+    }
+
     // Per-edge data computation (transfer stress to forces)
     std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
     while (iterproximity != proximitylist.end()) {
@@ -212,6 +247,75 @@ void ChProximityContainerSPH::AccumulateStep2() {
     }
 }
 
+void ChProximityContainerSPH::UpdateCellList() {
+    // Collect the nodes of all the SPH matter items
+    cell_nodes.clear();
+    for (auto otherphysics : GetSystem()->Get_otherphysicslist()) {
+        if (auto matter = std::dynamic_pointer_cast<ChMatterSPH>(otherphysics)) {
+            for (unsigned int j = 0; j < matter->GetNnodes(); j++)
+                cell_nodes.push_back(dynamic_cast<ChNodeSPH*>(matter->GetNode(j).get()));
+        }
+    }
+
+    std::vector<ChVector<> > positions(cell_nodes.size());
+    double cutoff = 0;
+    for (size_t i = 0; i < cell_nodes.size(); i++) {
+        positions[i] = cell_nodes[i]->GetPos();
+        cutoff = ChMax(cutoff, cell_nodes[i]->GetKernelRadius());
+    }
+
+    cell_list.Build(positions, cutoff);
+}
+
+// With the cell list, the neighbor lists are symmetric: each node sums the contributions of all its
+// neighbors into itself (so the nodes can be processed in parallel), and each pair is visited twice.
+
+void ChProximityContainerSPH::AccumulateStep1CellList() {
+    const std::vector<int>& start = cell_list.GetNeighborStart();
+    const std::vector<int>& neighbors = cell_list.GetNeighbors();
+
+    ChParallelFor(0, cell_list.GetNumPoints(), 0, [&](int i) {
+        ChNodeSPH* mnodeA = cell_nodes[i];
+        for (int k = start[i]; k < start[i + 1]; k++) {
+            ChNodeSPH* mnodeB = cell_nodes[neighbors[k]];
+            double dist_BA = (mnodeB->GetPos() - mnodeA->GetPos()).Length();
+            double h = 0.5 * (mnodeA->GetKernelRadius() + mnodeB->GetKernelRadius());
+            mnodeA->density += mnodeB->GetMass() * W_poly6(dist_BA, h);
+        }
+    });
+}
+
+void ChProximityContainerSPH::AccumulateStep2CellList() {
+    const std::vector<int>& start = cell_list.GetNeighborStart();
+    const std::vector<int>& neighbors = cell_list.GetNeighbors();
+
+    ChParallelFor(0, cell_list.GetNumPoints(), 0, [&](int i) {
+        ChNodeSPH* mnodeA = cell_nodes[i];
+        ChVector<> force = VNULL;
+        for (int k = start[i]; k < start[i + 1]; k++) {
+            ChNodeSPH* mnodeB = cell_nodes[neighbors[k]];
+
+            ChVector<> r_BA = mnodeB->GetPos() - mnodeA->GetPos();
+            double dist_BA = r_BA.Length();
+            double h = 0.5 * (mnodeA->GetKernelRadius() + mnodeB->GetKernelRadius());
+
+            // pressure forces
+            ChVector<> W_k_press;
+            W_gr_press(W_k_press, r_BA, dist_BA, h);
+            double avg_press = 0.5 * (mnodeA->pressure + mnodeB->pressure);
+            force += W_k_press * mnodeA->volume * avg_press * mnodeB->volume;
+
+            // viscous forces
+            double W_k_visc = W_sq_visco(dist_BA, h);
+            ChVector<> velBA = mnodeB->GetPos_dt() - mnodeA->GetPos_dt();
+            double avg_viscosity = 0.5 * (mnodeA->GetContainer()->GetMaterial().Get_viscosity() +
+                                          mnodeB->GetContainer()->GetMaterial().Get_viscosity());
+            force += velBA * (mnodeA->volume * avg_viscosity * mnodeB->volume * W_k_visc);
+        }
+        mnodeA->UserForce += force;
+    });
+}
+
 void ChProximityContainerSPH::ArchiveOUT(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChProximityContainerSPH>();
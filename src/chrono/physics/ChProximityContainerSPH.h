@@ -16,12 +16,16 @@
 #define CHPROXIMITYCONTAINERSPH_H
 
 #include <list>
+#include <vector>
 
+#include "chrono/collision/ChCCellList.h"
 #include "chrono/collision/ChCModelBullet.h"
 #include "chrono/physics/ChProximityContainer.h"
 
 namespace chrono {
 
+class ChNodeSPH;
+
 /// Class for a proximity pair information in a SPH cluster
 /// of particles - that is, an 'edge' topological connectivity in
 /// in a meshless FEA approach, like the Smoothed Particle Hydrodynamics.
@@ -60,6 +64,9 @@ class ChApi ChProximitySPH {
 /// Class for container of many proximity pairs for SPH (Smooth
 /// Particle Hydrodynamics and similar meshless force computations),
 /// as CPU typical linked list of ChProximitySPH objects.
+/// Optionally (see SetUseCellList), the pairs are found by a cell list
+/// neighbor search over the nodes of all the ChMatterSPH items of the
+/// system, instead of by the collision system.
 
 class ChApi ChProximityContainerSPH : public ChProximityContainer {
 
@@ -68,6 +75,10 @@ class ChApi ChProximityContainerSPH : public ChProximityContainer {
     std::list<ChProximitySPH*>::iterator lastproximity;
     int n_added;
 
+    bool use_cell_list;
+    collision::ChCellList cell_list;
+    std::vector<ChNodeSPH*> cell_nodes;
+
   public:
     ChProximityContainerSPH();
     ChProximityContainerSPH(const ChProximityContainerSPH& other);
@@ -76,8 +87,21 @@ class ChApi ChProximityContainerSPH : public ChProximityContainer {
     /// "Virtual" copy constructor (covariant return type).
     virtual ChProximityContainerSPH* Clone() const override { return new ChProximityContainerSPH(*this); }
 
+    /// Enable the neighbor search with a cell list (uniform grid), in place of the
+    /// proximity pairs from the collision system. The neighbors are searched among the nodes of
+    /// all the ChMatterSPH items in the system at each call of AccumulateStep1(), they are stored
+    /// in flat arrays, and the SPH sums are evaluated in parallel over the nodes.
+    /// The pairs reported by the collision system are then ignored: the collision models of the
+    /// nodes are needed only for contacts with other objects (otherwise, use ChMatterSPH::SetCollide(false)).
+    /// For nodes with different kernel radii, each pair uses the average of the two radii.
+    void SetUseCellList(bool mc) { use_cell_list = mc; }
+    bool GetUseCellList() const { return use_cell_list; }
+
+    /// Access the cell list, with the neighbors found at the last call of AccumulateStep1().
+    const collision::ChCellList& GetCellList() const { return cell_list; }
+
     /// Tell the number of added contacts
-    virtual int GetNproximities() const override { return n_added; }
+    virtual int GetNproximities() const override { return use_cell_list ? cell_list.GetNumPairs() : n_added; }
 
     /// Remove (delete) all contained contact data.
     virtual void RemoveAllProximities() override;
@@ -112,6 +136,13 @@ class ChApi ChProximityContainerSPH : public ChProximityContainer {
     // Will be called by the ChMatterSPH item.
     void AccumulateStep2();
 
+  private:
+    void UpdateCellList();
+    void AccumulateStep1CellList();
+    void AccumulateStep2CellList();
+
+  public:
+
     //
     // SERIALIZATION
     //
@@ -17,6 +17,7 @@
 #include "chrono/collision/ChCCollisionSystemBullet.h"
 #include "chrono/collision/ChCModelBullet.h"
 #include "chrono/parallel/ChOpenMP.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/physics/ChProximityContainer.h"
 #include "chrono/physics/ChSystem.h"
 #include "chrono/solver/ChSolverAPGD.h"
@@ -26,6 +27,7 @@
 #include "chrono/solver/ChSolverPCG.h"
 #include "chrono/solver/ChSolverPMINRES.h"
 #include "chrono/solver/ChSolverSOR.h"
+#include "chrono/solver/ChSolverSORcolored.h"
 #include "chrono/solver/ChSolverSORmultithread.h"
 #include "chrono/solver/ChSolverSymmSOR.h"
 #include "chrono/timestepper/ChStaticAnalysis.h"
@@ -164,6 +166,10 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
             solver_speed = std::make_shared<ChSolverSORmultithread>("speedSolver", parallel_thread_number);
             solver_stab = std::make_shared<ChSolverSORmultithread>("posSolver", parallel_thread_number);
             break;
+        case ChSolver::Type::SOR_COLORED:
+            solver_speed = std::make_shared<ChSolverSORcolored>(parallel_thread_number);
+            solver_stab = std::make_shared<ChSolverSORcolored>(parallel_thread_number);
+            break;
         case ChSolver::Type::PMINRES:
             solver_speed = std::make_shared<ChSolverPMINRES>();
             solver_stab = std::make_shared<ChSolverPMINRES>();
@@ -269,12 +275,19 @@ void ChSystem::SetParallelThreadNumber(int mthreads) {
 
     parallel_thread_number = mthreads;
 
+    ChTaskScheduler::GetInstance().SetNumThreads(mthreads);
+
     descriptor->SetNumThreads(mthreads);
 
     if (solver_speed->GetType() == ChSolver::Type::SOR_MULTITHREAD) {
         std::static_pointer_cast<ChSolverSORmultithread>(solver_speed)->ChangeNumberOfThreads(mthreads);
         std::static_pointer_cast<ChSolverSORmultithread>(solver_stab)->ChangeNumberOfThreads(mthreads);
     }
+
+    if (solver_speed->GetType() == ChSolver::Type::SOR_COLORED) {
+        std::static_pointer_cast<ChSolverSORcolored>(solver_speed)->SetNumThreads(mthreads);
+        std::static_pointer_cast<ChSolverSORcolored>(solver_stab)->SetNumThreads(mthreads);
+    }
 }
 
 // Plug-in components configuration
@@ -471,6 +484,15 @@ void ChSystem::SetTimestepperType(ChTimestepper::Type type) {
         case ChTimestepper::Type::NEWMARK:
             timestepper = std::make_shared<ChTimestepperNewmark>(this);
             break;
+        case ChTimestepper::Type::CENTRAL_DIFFERENCE:
+            timestepper = std::make_shared<ChTimestepperCentralDifference>(this);
+            break;
+        case ChTimestepper::Type::DORMAND_PRINCE:
+            timestepper = std::make_shared<ChTimestepperDormandPrince>(this);
+            break;
+        case ChTimestepper::Type::RUNGE_KUTTA_NYSTROM:
+            timestepper = std::make_shared<ChTimestepperRungeKuttaNystrom>(this);
+            break;
         default:
             throw ChException("SetTimestepperType: timestepper not supported");
     }
@@ -481,130 +503,19 @@ bool ChSystem::ManageSleepingBodies() {
         return 0;
 
     // STEP 1:
-    // See if some body could change from no sleep-> sleep
+    // Mark as 'could sleep' candidates the bodies that are at rest.
 
-    for (int ip = 0; ip < bodylist.size(); ++ip) {
-        // mark as 'could sleep' candidate
-        bodylist[ip]->TrySleeping();
-    }
+    ChParallelFor(0, (int)bodylist.size(), 128, [&](int ip) { bodylist[ip]->TrySleeping(); });
 
     // STEP 2:
-    // See if some sleeping or potential sleeping body is touching a non sleeping one,
-    // if so, set to no sleep.
-
-    // Make this class for iterating through contacts
-
-    class _wakeup_reporter_class : public ChContactContainer::ReportContactCallback {
-      public:
-        // Callback, used to report contact points already added to the container.
-        // If returns false, the contact scanning will be stopped.
-        virtual bool OnReportContact(
-            const ChVector<>& pA,             // get contact pA
-            const ChVector<>& pB,             // get contact pB
-            const ChMatrix33<>& plane_coord,  // get contact plane coordsystem (A column 'X' is contact normal)
-            const double& distance,           // get contact distance
-            const double& eff_radius,         // effective radius of curvature at contact
-            const ChVector<>& react_forces,   // get react.forces (if already computed). In coordsystem 'plane_coord'
-            const ChVector<>& react_torques,  // get react.torques, if rolling friction (if already computed).
-            ChContactable* contactobjA,  // get model A (note: some containers may not support it and could be zero!)
-            ChContactable* contactobjB   // get model B (note: some containers may not support it and could be zero!)
-            ) override {
-            if (!(contactobjA && contactobjB))
-                return true;
-            ChBody* b1 = dynamic_cast<ChBody*>(contactobjA);
-            ChBody* b2 = dynamic_cast<ChBody*>(contactobjB);
-            if (!(b1 && b2))
-                return true;
-            bool sleep1 = b1->GetSleeping();
-            bool sleep2 = b2->GetSleeping();
-            bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-            bool ground1 = b1->GetBodyFixed();
-            bool ground2 = b2->GetBodyFixed();
-            if (sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->SetSleeping(false);
-                need_Setup_A = true;
-            }
-            if (could_sleep1 && !(sleep2 || could_sleep2) && !ground2) {
-                b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            if (could_sleep2 && !(sleep1 || could_sleep1) && !ground1) {
-                b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-            }
-            someone_sleeps = sleep1 | sleep2 | someone_sleeps;
-
-            return true;  // to continue scanning contacts
-        }
-
-        // Data
-        bool someone_sleeps;
-        bool need_Setup_A;
-    };
-
-    _wakeup_reporter_class my_waker;
-    my_waker.need_Setup_A = false;
-
-    bool need_Setup_L = false;
-
-    for (int i = 0; i < 1; i++)  //***TO DO*** reconfigurable number of wakeup cycles
-    {
-        my_waker.someone_sleeps = false;
-
-        // scan all links and wake connected bodies
-        for (unsigned int ip = 0; ip < linklist.size(); ++ip)  // ITERATE on links
-        {
-            std::shared_ptr<ChLink> Lpointer = linklist[ip];
-
-            if (Lpointer->IsRequiringWaking()) {
-                ChBody* b1 = dynamic_cast<ChBody*>(Lpointer->GetBody1());
-                ChBody* b2 = dynamic_cast<ChBody*>(Lpointer->GetBody2());
-                if (b1 && b2) {
-                    bool sleep1 = b1->GetSleeping();
-                    bool sleep2 = b2->GetSleeping();
-                    bool could_sleep1 = b1->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                    bool could_sleep2 = b2->BFlagGet(ChBody::BodyFlag::COULDSLEEP);
-                    if (sleep1 && !(sleep2 || could_sleep2)) {
-                        b1->SetSleeping(false);
-                        need_Setup_L = true;
-                    }
-                    if (sleep2 && !(sleep1 || could_sleep1)) {
-                        b2->SetSleeping(false);
-                        need_Setup_L = true;
-                    }
-                    if (could_sleep1 && !(sleep2 || could_sleep2)) {
-                        b1->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                    }
-                    if (could_sleep2 && !(sleep1 || could_sleep1)) {
-                        b2->BFlagSet(ChBody::BodyFlag::COULDSLEEP, false);
-                    }
-                }
-            }
-        }
+    // Group the bodies in islands (connected by links and contacts). An island goes to sleep if all
+    // its bodies are sleeping or at rest, otherwise all its bodies are woken up.
 
-        // scan all contacts and wake neighboring bodies
-        contact_container->ReportAllContacts(&my_waker);
-
-        // bailout wakeup cycle prematurely, if all bodies are not sleeping
-        if (!my_waker.someone_sleeps)
-            break;
-    }
-
-    /// If some body still must change from no sleep-> sleep, do it
-    int need_Setup_B = 0;
-    for (int ip = 0; ip < bodylist.size(); ++ip) {
-        if (bodylist[ip]->BFlagGet(ChBody::BodyFlag::COULDSLEEP)) {
-            bodylist[ip]->SetSleeping(true);
-            ++need_Setup_B;
-        }
-    }
+    islands.Update(*this);
 
     // if some body has been activated/deactivated because of sleep state changes,
     // the offsets and DOF counts must be updated:
-    if (my_waker.need_Setup_A || need_Setup_B || need_Setup_L) {
+    if (islands.UpdateSleeping()) {
         Setup();
         return true;
     }
@@ -1195,6 +1106,13 @@ void ChSystem::LoadResidual_Mv(ChVectorDynamic<>& R,        ///< result: the R r
     IntLoadResidual_Mv(0, R, w, c);
 }
 
+void ChSystem::LoadLumpedMass_Md(ChVectorDynamic<>& Md,  ///< result: Md += c*diag(M_lumped)
+                                 const double c,         ///< a scaling factor
+                                 bool hrz                ///< use HRZ lumping, where it applies
+                                 ) {
+    IntLoadLumpedMass_Md(0, Md, c, hrz);
+}
+
 // Increment a vectorR with the term Cq'*L:
 //    R += c*Cq'*L
 void ChSystem::LoadResidual_CqL(ChVectorDynamic<>& R,        ///< result: the R residual, R += c*Cq'*L
@@ -1440,6 +1358,9 @@ bool ChSystem::Integrate_Y() {
         timestepper->Advance(step);
     }
 
+    // Accept the end-of-step state of all items (ex. commit history variables)
+    AcceptStep();
+
     // Executes custom processing at the end of step
     CustomEndOfStep();
 
@@ -1489,6 +1410,10 @@ bool ChSystem::DoAssembly(int action) {
     // Perform analysis
     manalysis.AssemblyAnalysis(action, new_step);
 
+    // The solver's Setup was called here: a Newton matrix kept by the timestepper is out of date.
+    if (auto mstepper = std::dynamic_pointer_cast<ChImplicitIterativeTimestepper>(timestepper))
+        mstepper->ForceJacobianUpdate();
+
     SetMaxItersSolverSpeed(old_maxsteps);
     SetStep(old_step);
     SetTolForce(old_tol);
@@ -1517,6 +1442,8 @@ bool ChSystem::DoStaticLinear() {
 
     // Perform analysis
     manalysis.StaticAnalysis();
+    if (auto mstepper = std::dynamic_pointer_cast<ChImplicitIterativeTimestepper>(timestepper))
+        mstepper->ForceJacobianUpdate();
 
     SetMaxItersSolverSpeed(old_maxsteps);
 
@@ -1566,6 +1493,8 @@ bool ChSystem::DoStaticNonlinear(int nsteps) {
 
     // Perform analysis
     manalysis.StaticAnalysis();
+    if (auto mstepper = std::dynamic_pointer_cast<ChImplicitIterativeTimestepper>(timestepper))
+        mstepper->ForceJacobianUpdate();
 
     SetMaxItersSolverSpeed(old_maxsteps);
 
@@ -1698,6 +1627,9 @@ bool ChSystem::DoFrameDynamics(double m_endtime) {
     frame_step = (m_endtime - ChTime);
     fixed_step_undo = step;
 
+    // Adaptive timesteppers take internal steps of variable size: advance in steps of step_max.
+    bool adaptive = std::dynamic_pointer_cast<ChExplicitAdaptiveTimestepper>(timestepper) != nullptr;
+
     while (ChTime < m_endtime) {
         restore_oldstep = false;
         counter++;
@@ -1707,7 +1639,9 @@ bool ChSystem::DoFrameDynamics(double m_endtime) {
         if (left_time < 1e-12)
             break;  // - no integration if backward or null frame step.
 
-        if (left_time < (1.3 * step))  // - step changed if too little frame step
+        if (adaptive) {
+            step = ChMin(step_max, left_time);
+        } else if (left_time < (1.3 * step))  // - step changed if too little frame step
         {
             old_step = step;
             step = left_time;
@@ -1726,6 +1660,8 @@ bool ChSystem::DoFrameDynamics(double m_endtime) {
     if (restore_oldstep)
         step = old_step;  // if timestep was changed to meet the end of frametime, restore pre-last (even for
                           // time-varying schemes)
+    if (adaptive)
+        step = fixed_step_undo;
 
     if (last_err)
         return false;
@@ -32,6 +32,7 @@
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/physics/ChControls.h"
 #include "chrono/physics/ChGlobal.h"
+#include "chrono/physics/ChIslands.h"
 #include "chrono/physics/ChLinksAll.h"
 #include "chrono/physics/ChProbe.h"
 #include "chrono/solver/ChSystemDescriptor.h"
@@ -39,6 +40,7 @@
 #include "chrono/solver/ChSolver.h"
 #include "chrono/timestepper/ChIntegrable.h"
 #include "chrono/timestepper/ChTimestepper.h"
+#include "chrono/timestepper/ChTimestepperDormandPrince.h"
 #include "chrono/timestepper/ChTimestepperHHT.h"
 
 namespace chrono {
@@ -113,6 +115,8 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
 
     /// Sets the upper limit for time step (only needed if using
     /// integration methods which support time step adaption).
+    /// With adaptive explicit timesteppers (DORMAND_PRINCE, RUNGE_KUTTA_NYSTROM), DoFrameDynamics()
+    /// advances in steps of this size, that the timestepper subdivides as needed.
     void SetStepMax(double m_step_max) {
         if (m_step_max > step_min)
             step_max = m_step_max;
@@ -124,6 +128,7 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     ///   - Suggested for fast dynamics with hard (NSC) contacts: EULER_IMPLICIT_LINEARIZED
     ///   - Suggested for fast dynamics with hard (NSC) contacts and low inter-penetration: EULER_IMPLICIT_PROJECTED
     ///   - Suggested for finite element smooth dynamics: HHT, EULER_IMPLICIT_LINEARIZED
+    ///   - Suggested for smooth dynamics with varying time scales, without NSC contacts: RUNGE_KUTTA_NYSTROM
     ///
     /// *Notes*:
     ///   - for more advanced customization, use SetTimestepper()
@@ -259,6 +264,8 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// Changes the number of parallel threads (by default is n.of cores).
     /// Note that not all solvers use parallel computation.
     /// If you have a N-core processor, this should be set at least =N for maximum performance.
+    /// This also sets the number of threads of the Chrono task scheduler (see ChTaskScheduler), which is
+    /// shared by all systems: the last call, from any system, takes effect.
     void SetParallelThreadNumber(int mthreads = 2);
     /// Get the number of parallel threads.
     /// Note that not all solvers use parallel computation.
@@ -515,6 +522,19 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
                                  const double c               ///< a scaling factor
                                  ) override;
 
+    /// Increment a vector Md with the diagonal of a lumped mass matrix:
+    ///    Md += c*diag(M_lumped)
+    /// Bodies use their mass and the diagonal of their inertia; items that do not provide a lumped
+    /// mass get the row sums of their mass matrix. If hrz is true, finite elements use HRZ lumping.
+    virtual void LoadLumpedMass_Md(ChVectorDynamic<>& Md,  ///< result: Md += c*diag(M_lumped)
+                                   const double c,         ///< a scaling factor
+                                   bool hrz = false        ///< use HRZ lumping, where it applies
+                                   ) override;
+
+    /// Return an estimate of the largest stable step for the explicit integration with a lumped mass,
+    /// from the items that limit it (e.g. finite element meshes), or 0 if no item limits it.
+    virtual double GetStableTimeStep() override { return ComputeStableTimeStep(); }
+
     /// Increment a vectorR with the term Cq'*L:
     ///    R += c*Cq'*L
     virtual void LoadResidual_CqL(ChVectorDynamic<>& R,        ///< result: the R residual, R += c*Cq'*L
@@ -607,8 +627,14 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     /// Tell if the system will put to sleep the bodies whose motion has almost come to a rest.
     bool GetUseSleeping() const { return use_sleeping; }
 
+    /// Access the partition of the bodies in islands (groups of bodies connected by links or contacts).
+    /// If sleeping is enabled, the islands are updated at each time step and a whole island goes to
+    /// sleep when all its bodies are at rest. Otherwise, call ChIslands::Update to compute them.
+    ChIslands& GetIslands() { return islands; }
+
   private:
     /// Put bodies to sleep if possible. Also awakens sleeping bodies, if needed.
+    /// Bodies sleep and wake up by islands (see ChIslands).
     /// Returns true if some body changed from sleep to no sleep or viceversa,
     /// returns false if nothing changed. In the former case, also performs Setup()
     /// because the sleeping policy changed the totalDOFs and offsets.
@@ -802,6 +828,7 @@ class ChApi ChSystem : public ChAssembly, public ChIntegrableIIorder {
     int maxiter;  ///< max iterations for nonlinear convergence in DoAssembly()
 
     bool use_sleeping;  ///< if true, put to sleep objects that come to rest
+    ChIslands islands;  ///< islands of bodies, used to put to sleep and wake up groups of bodies
 
     std::shared_ptr<ChSystemDescriptor> descriptor;  ///< the system descriptor
     std::shared_ptr<ChSolver> solver_speed;          ///< the solver for speed problem
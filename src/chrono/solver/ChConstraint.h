@@ -15,6 +15,8 @@
 #ifndef CHCONSTRAINT_H
 #define CHCONSTRAINT_H
 
+#include <vector>
+
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChClassFactory.h"
 #include "chrono/core/ChMatrix.h"
@@ -22,6 +24,8 @@
 
 namespace chrono {
 
+class ChVariables;
+
 /// Modes for constraint
 enum eChConstraintMode {
     CONSTRAINT_FREE = 0,        ///< the constraint does not enforce anything
@@ -274,6 +278,13 @@ class ChApi ChConstraint {
     /// indexes in result and vect;
     virtual void MultiplyTandAdd(ChMatrix<double>& result, double l) = 0;
 
+    /// Append to 'vars' the variable objects referenced by this constraint, i.e. the variables whose
+    /// 'q' is modified by Increment_q().
+    /// This is used, for example, by solvers that partition the constraints in independent sets
+    /// (see ChSolverSORcolored). Return false if the referenced variables are not known, as in this
+    /// default implementation.
+    virtual bool CollectVariables(std::vector<ChVariables*>& vars) const { return false; }
+
     /// For iterative solvers: project the value of a possible
     /// 'l_i' value of constraint reaction onto admissible orthant/set.
     /// Default behavior: if constraint is unilateral and l_i<0, reset l_i=0
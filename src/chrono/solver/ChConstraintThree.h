@@ -74,6 +74,13 @@ class ChApi ChConstraintThree : public ChConstraint {
     /// automatically creating/resizing jacobians if needed.
     virtual void SetVariables(ChVariables* mvariables_a, ChVariables* mvariables_b, ChVariables* mvariables_c) = 0;
 
+    virtual bool CollectVariables(std::vector<ChVariables*>& vars) const override {
+        vars.push_back(variables_a);
+        vars.push_back(variables_b);
+        vars.push_back(variables_c);
+        return true;
+    }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive);
 
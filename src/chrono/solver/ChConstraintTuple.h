@@ -63,6 +63,8 @@ class ChConstraintTuple_1vars {
 
     ChVariables* GetVariables() { return variables; }
 
+    void CollectVariables(std::vector<ChVariables*>& vars) const { vars.push_back(variables); }
+
     void SetVariables(T& m_tuple_carrier) {
         if (!m_tuple_carrier.GetVariables1()) {
             throw ChException("ERROR. SetVariables() getting null pointer. \n");
@@ -182,6 +184,11 @@ class ChConstraintTuple_2vars {
     ChVariables* GetVariables_1() { return variables_1; }
     ChVariables* GetVariables_2() { return variables_2; }
 
+    void CollectVariables(std::vector<ChVariables*>& vars) const {
+        vars.push_back(variables_1);
+        vars.push_back(variables_2);
+    }
+
     void SetVariables(T& m_tuple_carrier) {
         if (!m_tuple_carrier.GetVariables1() || !m_tuple_carrier.GetVariables2()) {
             throw ChException("ERROR. SetVariables() getting null pointer. \n");
@@ -347,6 +354,12 @@ class ChConstraintTuple_3vars {
     ChVariables* GetVariables_2() { return variables_2; }
     ChVariables* GetVariables_3() { return variables_3; }
 
+    void CollectVariables(std::vector<ChVariables*>& vars) const {
+        vars.push_back(variables_1);
+        vars.push_back(variables_2);
+        vars.push_back(variables_3);
+    }
+
     void SetVariables(T& m_tuple_carrier) {
         if (!m_tuple_carrier.GetVariables1() || !m_tuple_carrier.GetVariables2() || !m_tuple_carrier.GetVariables3()) {
             throw ChException("ERROR. SetVariables() getting null pointer. \n");
@@ -559,6 +572,13 @@ class ChConstraintTuple_4vars {
     ChVariables* GetVariables_3() { return variables_3; }
     ChVariables* GetVariables_4() { return variables_4; }
 
+    void CollectVariables(std::vector<ChVariables*>& vars) const {
+        vars.push_back(variables_1);
+        vars.push_back(variables_2);
+        vars.push_back(variables_3);
+        vars.push_back(variables_4);
+    }
+
     void SetVariables(T& m_tuple_carrier) {
         if (!m_tuple_carrier.GetVariables1() || !m_tuple_carrier.GetVariables2() || !m_tuple_carrier.GetVariables3() || !m_tuple_carrier.GetVariables4() ) {
             throw ChException("ERROR. SetVariables() getting null pointer. \n");
@@ -67,6 +67,12 @@ class ChApi ChConstraintTwo : public ChConstraint {
     /// automatically creating/resizing jacobians if needed.
     virtual void SetVariables(ChVariables* mvariables_a, ChVariables* mvariables_b) = 0;
 
+    virtual bool CollectVariables(std::vector<ChVariables*>& vars) const override {
+        vars.push_back(variables_a);
+        vars.push_back(variables_b);
+        return true;
+    }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive);
 
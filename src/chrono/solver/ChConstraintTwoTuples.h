@@ -60,6 +60,12 @@ class ChConstraintTwoTuples : public ChConstraint {
     /// Access tuple b
     type_constraint_tuple_b& Get_tuple_b() { return tuple_b; }
 
+    virtual bool CollectVariables(std::vector<ChVariables*>& vars) const override {
+        tuple_a.CollectVariables(vars);
+        tuple_b.CollectVariables(vars);
+        return true;
+    }
+
     virtual void Update_auxiliary() override {
         g_i = 0;
         tuple_a.Update_auxiliary(g_i);
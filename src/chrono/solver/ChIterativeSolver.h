@@ -15,6 +15,9 @@
 #ifndef CHITERATIVESOLVER_H
 #define CHITERATIVESOLVER_H
 
+#include <memory>
+
+#include "chrono/solver/ChPreconditioner.h"
 #include "chrono/solver/ChSolver.h"
 
 namespace chrono {
@@ -44,6 +47,8 @@ class ChApi ChIterativeSolver : public ChSolver {
     double omega;        ///< over-relaxation factor
     double shlambda;     ///< sharpness factor
 
+    std::shared_ptr<ChPreconditioner> preconditioner;  ///< optional preconditioner for the KKT system
+
     bool record_violation_history;
     std::vector<double> violation_history;
     std::vector<double> dlambda_history;
@@ -119,6 +124,15 @@ class ChApi ChIterativeSolver : public ChSolver {
     /// Return the current value of the solver tolerance.
     double GetTolerance() const { return tolerance; }
 
+    /// Attach a preconditioner for the full KKT system matrix (see ChPreconditioner).
+    /// ChSolverPMINRES and ChSolverPCG then operate on the KKT system and use it in place of the default
+    /// diagonal scaling. The preconditioner is set up at the beginning of each call to Solve() (see
+    /// ChPreconditioner::Setup). Pass an empty pointer to revert to the default.
+    void SetPreconditioner(std::shared_ptr<ChPreconditioner> mprec) { preconditioner = mprec; }
+
+    /// Return the preconditioner for the KKT system, if any.
+    std::shared_ptr<ChPreconditioner> GetPreconditioner() const { return preconditioner; }
+
     /// Enable/disable recording of the constraint violation history.
     /// If enabled, the maximum constraint violation at the end of each iteration is
     /// stored in a vector (see GetViolationHistory).
@@ -0,0 +1,116 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include "chrono/solver/ChKblockMatrixFree.h"
+
+namespace chrono {
+
+void ChKblockMatrixFree::Operator::DiagonalAdd(ChMatrix<double>& d) {
+    int n = d.GetRows();
+    ChMatrixDynamic<double> K(n, n);
+    ComputeMatrix(K);
+    for (int i = 0; i < n; i++)
+        d(i) += K(i, i);
+}
+
+void ChKblockMatrixFree::SetVariables(const std::vector<ChVariables*>& mvariables) {
+    variables = mvariables;
+
+    ndof = 0;
+    for (unsigned int iv = 0; iv < variables.size(); iv++)
+        ndof += variables[iv]->Get_ndof();
+}
+
+void ChKblockMatrixFree::MultiplyAndAdd(ChMatrix<double>& result, const ChMatrix<double>& vect) const {
+    assert(op);
+
+    // Gather the entries of the active variables
+    ChMatrixDynamic<double> x(ndof, 1);
+    ChMatrixDynamic<double> y(ndof, 1);
+    int kio = 0;
+    for (unsigned int iv = 0; iv < variables.size(); iv++) {
+        int in = variables[iv]->Get_ndof();
+        if (variables[iv]->IsActive()) {
+            int io = variables[iv]->GetOffset();
+            for (int r = 0; r < in; r++)
+                x(kio + r) = vect(io + r);
+        }
+        kio += in;
+    }
+
+    op->MultiplyAndAdd(y, x);
+
+    // Scatter to the active variables
+    kio = 0;
+    for (unsigned int iv = 0; iv < variables.size(); iv++) {
+        int in = variables[iv]->Get_ndof();
+        if (variables[iv]->IsActive()) {
+            int io = variables[iv]->GetOffset();
+            for (int r = 0; r < in; r++)
+                result(io + r) += y(kio + r);
+        }
+        kio += in;
+    }
+}
+
+void ChKblockMatrixFree::DiagonalAdd(ChMatrix<double>& result) {
+    assert(op);
+    assert(result.GetColumns() == 1);
+
+    ChMatrixDynamic<double> d(ndof, 1);
+    op->DiagonalAdd(d);
+
+    int kio = 0;
+    for (unsigned int iv = 0; iv < variables.size(); iv++) {
+        int in = variables[iv]->Get_ndof();
+        if (variables[iv]->IsActive()) {
+            int io = variables[iv]->GetOffset();
+            for (int r = 0; r < in; r++)
+                result(io + r) += d(kio + r);
+        }
+        kio += in;
+    }
+}
+
+void ChKblockMatrixFree::Build_K(ChSparseMatrix& storage, bool add) {
+    assert(op);
+
+    ChMatrixDynamic<double> K(ndof, ndof);
+    op->ComputeMatrix(K);
+
+    int kio = 0;
+    for (unsigned int iv = 0; iv < variables.size(); iv++) {
+        int io = variables[iv]->GetOffset();
+        int in = variables[iv]->Get_ndof();
+
+        if (variables[iv]->IsActive()) {
+            int kjo = 0;
+            for (unsigned int jv = 0; jv < variables.size(); jv++) {
+                int jo = variables[jv]->GetOffset();
+                int jn = variables[jv]->Get_ndof();
+
+                if (variables[jv]->IsActive()) {
+                    if (add)
+                        storage.PasteSumClippedMatrix(K, kio, kjo, in, jn, io, jo);
+                    else
+                        storage.PasteClippedMatrix(K, kio, kjo, in, jn, io, jo);
+                }
+
+                kjo += jn;
+            }
+        }
+
+        kio += in;
+    }
+}
+
+}  // end namespace chrono
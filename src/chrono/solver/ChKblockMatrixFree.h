@@ -0,0 +1,88 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHKBLOCKMATRIXFREE_H
+#define CHKBLOCKMATRIXFREE_H
+
+#include <vector>
+
+#include "chrono/solver/ChKblock.h"
+
+namespace chrono {
+
+/// Class that represents a K block connecting N 'variables' in matrix-free form: the block matrix is not
+/// stored, and its product by a vector is computed on demand by an Operator object (for example a finite
+/// element, from its current state).
+/// This is meant for iterative solvers, which only need the product by the system matrix: the matrix is
+/// formed (temporarily) only if a solver asks for it, with Build_K() or DiagonalAdd().
+///
+/// See ChSystemDescriptor for more information about the overall
+/// problem and data representation.
+class ChApi ChKblockMatrixFree : public ChKblock {
+
+  public:
+    /// Interface for the objects that provide the action of the block.
+    /// Vectors and matrices are in the local ordering of the coordinates of the block variables.
+    class ChApi Operator {
+      public:
+        virtual ~Operator() {}
+
+        /// Compute y += K*x.
+        virtual void MultiplyAndAdd(ChMatrix<double>& y, const ChMatrix<double>& x) = 0;
+
+        /// Compute the block matrix K (already sized).
+        virtual void ComputeMatrix(ChMatrix<double>& K) = 0;
+
+        /// Add the diagonal of K to d. The default implementation forms the matrix.
+        virtual void DiagonalAdd(ChMatrix<double>& d);
+    };
+
+  private:
+    std::vector<ChVariables*> variables;
+    Operator* op;
+    int ndof;
+
+  public:
+    ChKblockMatrixFree() : op(NULL), ndof(0) {}
+    virtual ~ChKblockMatrixFree() {}
+
+    /// Set the operator that computes the products (not owned by the block).
+    void SetOperator(Operator* mop) { op = mop; }
+
+    /// Set references to the connected objects, each of ChVariables type.
+    void SetVariables(const std::vector<ChVariables*>& mvariables);
+
+    /// Returns the number of referenced ChVariables items
+    virtual size_t GetNvars() const override { return variables.size(); }
+
+    /// Access the m-th vector variable object
+    ChVariables* GetVariableN(unsigned int m_var) const { return variables[m_var]; }
+
+    /// The matrix is not stored: always return NULL.
+    virtual ChMatrix<double>* Get_K() override { return NULL; }
+
+    /// Computes the product of the corresponding blocks in the
+    /// system matrix (ie. the K matrix blocks) by 'vect', and add to 'result'.
+    /// The entries of 'vect' of the inactive variables are taken as zero.
+    virtual void MultiplyAndAdd(ChMatrix<double>& result, const ChMatrix<double>& vect) const override;
+
+    /// Add the diagonal of the stiffness matrix block(s) as a column vector to 'result'.
+    virtual void DiagonalAdd(ChMatrix<double>& result) override;
+
+    /// Writes the K matrix associated to these variables into a global 'storage' matrix,
+    /// at the offsets of variables. The block matrix is formed temporarily.
+    virtual void Build_K(ChSparseMatrix& storage, bool add) override;
+};
+
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,990 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono/solver/ChPreconditioner.h"
+
+namespace chrono {
+
+// -----------------------------------------------------------------------------
+// Local utilities
+// -----------------------------------------------------------------------------
+
+// Inverse scaling for a diagonal entry (1 if the entry is practically zero).
+static double InverseScaling(double d) {
+    return (std::abs(d) > 1e-9) ? 1.0 / std::abs(d) : 1.0;
+}
+
+// In-place inversion of a dense n x n matrix (row-major), using Gauss-Jordan elimination with partial
+// pivoting. Return false if the matrix is (numerically) singular.
+static bool InvertDense(double* a, int n) {
+    std::vector<int> piv(n);
+    for (int k = 0; k < n; k++) {
+        int p = k;
+        double amax = std::abs(a[k * n + k]);
+        for (int i = k + 1; i < n; i++) {
+            if (std::abs(a[i * n + k]) > amax) {
+                amax = std::abs(a[i * n + k]);
+                p = i;
+            }
+        }
+        if (amax < 1e-300)
+            return false;
+        piv[k] = p;
+        if (p != k) {
+            for (int j = 0; j < n; j++)
+                std::swap(a[k * n + j], a[p * n + j]);
+        }
+        double inv = 1.0 / a[k * n + k];
+        a[k * n + k] = 1.0;
+        for (int j = 0; j < n; j++)
+            a[k * n + j] *= inv;
+        for (int i = 0; i < n; i++) {
+            if (i == k)
+                continue;
+            double f = a[i * n + k];
+            if (f == 0)
+                continue;
+            a[i * n + k] = 0;
+            for (int j = 0; j < n; j++)
+                a[i * n + j] -= f * a[k * n + j];
+        }
+    }
+    // Undo the column permutations (in reverse order).
+    for (int k = n - 1; k >= 0; k--) {
+        if (piv[k] != k) {
+            for (int i = 0; i < n; i++)
+                std::swap(a[i * n + k], a[i * n + piv[k]]);
+        }
+    }
+    return true;
+}
+
+// Dense LU factorization with partial pivoting (row-major, in place).
+static void FactorLU(std::vector<double>& a, std::vector<int>& piv, int n) {
+    piv.resize(n);
+    for (int k = 0; k < n; k++) {
+        int p = k;
+        double amax = std::abs(a[k * n + k]);
+        for (int i = k + 1; i < n; i++) {
+            if (std::abs(a[i * n + k]) > amax) {
+                amax = std::abs(a[i * n + k]);
+                p = i;
+            }
+        }
+        piv[k] = p;
+        if (p != k) {
+            for (int j = 0; j < n; j++)
+                std::swap(a[k * n + j], a[p * n + j]);
+        }
+        if (std::abs(a[k * n + k]) < 1e-300)
+            a[k * n + k] = 1e-300;
+        double inv = 1.0 / a[k * n + k];
+        for (int i = k + 1; i < n; i++) {
+            double f = (a[i * n + k] *= inv);
+            if (f == 0)
+                continue;
+            for (int j = k + 1; j < n; j++)
+                a[i * n + j] -= f * a[k * n + j];
+        }
+    }
+}
+
+// Solve with the dense LU factors computed by FactorLU (in place).
+static void SolveLU(const std::vector<double>& a, const std::vector<int>& piv, int n, double* x) {
+    for (int k = 0; k < n; k++)
+        std::swap(x[k], x[piv[k]]);
+    for (int i = 0; i < n; i++) {
+        double s = x[i];
+        for (int j = 0; j < i; j++)
+            s -= a[i * n + j] * x[j];
+        x[i] = s;
+    }
+    for (int i = n - 1; i >= 0; i--) {
+        double s = x[i];
+        for (int j = i + 1; j < n; j++)
+            s -= a[i * n + j] * x[j];
+        x[i] = s / a[i * n + i];
+    }
+}
+
+// Forward (or backward) Gauss-Seidel sweep for A*x = b.
+static void GaussSeidel(const ChPreconditioner::CSRMatrix& A,
+                        const std::vector<double>& inv_diag,
+                        const double* b,
+                        double* x,
+                        bool forward) {
+    for (int k = 0; k < A.nrows; k++) {
+        int i = forward ? k : A.nrows - 1 - k;
+        double s = b[i];
+        double aii = 0;
+        for (int p = A.rowptr[i]; p < A.rowptr[i + 1]; p++) {
+            int j = A.colidx[p];
+            if (j == i)
+                aii = A.values[p];
+            else
+                s -= A.values[p] * x[j];
+        }
+        x[i] = (aii != 0) ? s / aii : s * inv_diag[i];
+    }
+}
+
+// -----------------------------------------------------------------------------
+// CSR matrix utilities
+// -----------------------------------------------------------------------------
+
+void ChPreconditioner::CSRMatrix::Multiply(const double* x, double* y) const {
+    for (int i = 0; i < nrows; i++) {
+        double s = 0;
+        for (int p = rowptr[i]; p < rowptr[i + 1]; p++)
+            s += values[p] * x[colidx[p]];
+        y[i] = s;
+    }
+}
+
+ChPreconditioner::CSRMatrix ChPreconditioner::CSRMatrix::Transpose() const {
+    CSRMatrix T;
+    T.nrows = ncols;
+    T.ncols = nrows;
+    T.rowptr.assign(ncols + 1, 0);
+    T.colidx.resize(GetNNZ());
+    T.values.resize(GetNNZ());
+    for (int p = 0; p < GetNNZ(); p++)
+        T.rowptr[colidx[p] + 1]++;
+    for (int j = 0; j < ncols; j++)
+        T.rowptr[j + 1] += T.rowptr[j];
+    std::vector<int> next(T.rowptr.begin(), T.rowptr.end() - 1);
+    for (int i = 0; i < nrows; i++) {
+        for (int p = rowptr[i]; p < rowptr[i + 1]; p++) {
+            int q = next[colidx[p]]++;
+            T.colidx[q] = i;
+            T.values[q] = values[p];
+        }
+    }
+    return T;
+}
+
+ChPreconditioner::CSRMatrix ChPreconditioner::CSRMatrix::Product(const CSRMatrix& A, const CSRMatrix& B) {
+    CSRMatrix C;
+    C.nrows = A.nrows;
+    C.ncols = B.ncols;
+    C.rowptr.assign(A.nrows + 1, 0);
+
+    std::vector<int> marker(B.ncols, -1);
+    std::vector<double> acc(B.ncols, 0.0);
+    std::vector<int> cols;
+
+    for (int i = 0; i < A.nrows; i++) {
+        cols.clear();
+        for (int p = A.rowptr[i]; p < A.rowptr[i + 1]; p++) {
+            int k = A.colidx[p];
+            double a = A.values[p];
+            for (int q = B.rowptr[k]; q < B.rowptr[k + 1]; q++) {
+                int j = B.colidx[q];
+                if (marker[j] != i) {
+                    marker[j] = i;
+                    acc[j] = 0;
+                    cols.push_back(j);
+                }
+                acc[j] += a * B.values[q];
+            }
+        }
+        std::sort(cols.begin(), cols.end());
+        for (int j : cols) {
+            C.colidx.push_back(j);
+            C.values.push_back(acc[j]);
+        }
+        C.rowptr[i + 1] = (int)C.colidx.size();
+    }
+
+    return C;
+}
+
+// -----------------------------------------------------------------------------
+// Base preconditioner class
+// -----------------------------------------------------------------------------
+
+ChPreconditioner::ChPreconditioner()
+    : m_n(0),
+      m_nq(0),
+      m_lock(false),
+      m_analyzed(false),
+      m_interval(1),
+      m_num_calls(0),
+      m_num_symbolic(0),
+      m_num_numeric(0) {}
+
+void ChPreconditioner::SetSparsityPatternLock(bool val) {
+    m_lock = val;
+    m_Z.SetSparsityPatternLock(val);
+}
+
+void ChPreconditioner::Setup(ChSystemDescriptor& sysd) {
+    // Count the unknowns (this also updates the variable offsets).
+    int nq = sysd.CountActiveVariables();
+    int n = nq + sysd.CountActiveConstraints();
+
+    // Keep the current preconditioner, unless an update is due or the problem size changed.
+    bool resized = (n != m_n || nq != m_nq);
+    if (m_analyzed && !resized && ++m_num_calls < m_interval)
+        return;
+    m_num_calls = 0;
+
+    // Assemble the system matrix.
+    sysd.ConvertToMatrixForm(&m_Z, nullptr);
+    m_Z.Compress();
+
+    // Collect the variable (node) blocks.
+    std::vector<std::pair<int, ChVariables*>> blocks;
+    for (auto var : sysd.GetVariablesList()) {
+        if (var->IsActive() && var->Get_ndof() > 0)
+            blocks.push_back(std::make_pair(var->GetOffset(), var));
+    }
+    std::sort(blocks.begin(), blocks.end());
+
+    // The symbolic phase is needed if the problem size, the variable blocks, or the sparsity pattern changed.
+    // With the sparsity pattern lock, the pattern is assumed unchanged and not checked.
+    bool symbolic = !m_analyzed || resized || blocks.size() + 1 != m_blocks.size();
+    for (size_t ib = 0; ib < blocks.size() && !symbolic; ib++)
+        symbolic = (blocks[ib].first != m_blocks[ib] || blocks[ib].second != m_block_vars[ib]);
+    if (!symbolic && !m_lock)
+        symbolic = !SamePattern();
+
+    if (symbolic) {
+        m_n = n;
+        m_nq = nq;
+
+        m_blocks.resize(blocks.size() + 1);
+        m_block_vars.resize(blocks.size());
+        for (size_t ib = 0; ib < blocks.size(); ib++) {
+            m_blocks[ib] = blocks[ib].first;
+            m_block_vars[ib] = blocks[ib].second;
+        }
+        m_blocks[blocks.size()] = m_nq;
+
+        // Store the sparsity pattern of the assembled matrix.
+        const int* rowptr = m_Z.GetCS_LeadingIndexArray();
+        const int* colidx = m_Z.GetCS_TrailingIndexArray();
+        m_pattern_rowptr.assign(rowptr, rowptr + n + 1);
+        m_pattern_colidx.assign(colidx, colidx + rowptr[n]);
+
+        SetupSymbolic();
+        m_analyzed = true;
+        m_num_symbolic++;
+    }
+
+    SetupNumeric();
+    m_num_numeric++;
+}
+
+bool ChPreconditioner::SamePattern() const {
+    const int* rowptr = m_Z.GetCS_LeadingIndexArray();
+    const int* colidx = m_Z.GetCS_TrailingIndexArray();
+    if ((int)m_pattern_rowptr.size() != m_n + 1 || !std::equal(rowptr, rowptr + m_n + 1, m_pattern_rowptr.begin()))
+        return false;
+    return std::equal(colidx, colidx + rowptr[m_n], m_pattern_colidx.begin());
+}
+
+void ChPreconditioner::ExtractBlock(CSRMatrix& A, int n) const {
+    const int* rowptr = m_Z.GetCS_LeadingIndexArray();
+    const int* colidx = m_Z.GetCS_TrailingIndexArray();
+    const double* values = m_Z.GetCS_ValueArray();
+
+    A.nrows = n;
+    A.ncols = n;
+    A.rowptr.assign(n + 1, 0);
+    A.colidx.clear();
+    A.values.clear();
+
+    std::vector<std::pair<int, double>> row;
+    for (int i = 0; i < n; i++) {
+        row.clear();
+        for (int p = rowptr[i]; p < rowptr[i + 1]; p++) {
+            if (colidx[p] < n)
+                row.push_back(std::make_pair(colidx[p], values[p]));
+        }
+        std::sort(row.begin(), row.end());
+        for (auto& e : row) {
+            A.colidx.push_back(e.first);
+            A.values.push_back(e.second);
+        }
+        A.rowptr[i + 1] = (int)A.colidx.size();
+    }
+}
+
+void ChPreconditioner::LoadValues(CSRMatrix& A, int n) const {
+    const int* rowptr = m_Z.GetCS_LeadingIndexArray();
+    const int* colidx = m_Z.GetCS_TrailingIndexArray();
+    const double* values = m_Z.GetCS_ValueArray();
+
+    std::fill(A.values.begin(), A.values.end(), 0.0);
+    for (int i = 0; i < n; i++) {
+        auto first = A.colidx.begin() + A.rowptr[i];
+        auto last = A.colidx.begin() + A.rowptr[i + 1];
+        for (int p = rowptr[i]; p < rowptr[i + 1]; p++) {
+            auto it = std::lower_bound(first, last, colidx[p]);
+            if (it != last && *it == colidx[p])
+                A.values[it - A.colidx.begin()] = values[p];
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Block-Jacobi preconditioner
+// -----------------------------------------------------------------------------
+
+void ChPreconditionerBlockJacobi::SetupSymbolic() {
+    int nb = (int)m_blocks.size() - 1;
+    m_inv_offsets.resize(nb + 1);
+    m_inv_offsets[0] = 0;
+    for (int ib = 0; ib < nb; ib++) {
+        int d = m_blocks[ib + 1] - m_blocks[ib];
+        m_inv_offsets[ib + 1] = m_inv_offsets[ib] + d * d;
+    }
+    m_inv.resize(m_inv_offsets[nb]);
+    m_cdiag.resize(m_n - m_nq);
+}
+
+void ChPreconditionerBlockJacobi::SetupNumeric() {
+    const int* rowptr = m_Z.GetCS_LeadingIndexArray();
+    const int* colidx = m_Z.GetCS_TrailingIndexArray();
+    const double* values = m_Z.GetCS_ValueArray();
+
+    int nb = (int)m_blocks.size() - 1;
+
+    ChParallelFor(0, nb, 16, [&](int ib) {
+        int start = m_blocks[ib];
+        int d = m_blocks[ib + 1] - start;
+        double* a = &m_inv[m_inv_offsets[ib]];
+        std::fill(a, a + d * d, 0.0);
+        for (int i = 0; i < d; i++) {
+            for (int p = rowptr[start + i]; p < rowptr[start + i + 1]; p++) {
+                int j = colidx[p] - start;
+                if (j >= 0 && j < d)
+                    a[i * d + j] = values[p];
+            }
+        }
+        if (!InvertDense(a, d)) {
+            // Singular block: fall back to diagonal scaling.
+            std::vector<double> diag(d);
+            for (int i = 0; i < d; i++) {
+                for (int p = rowptr[start + i]; p < rowptr[start + i + 1]; p++) {
+                    if (colidx[p] == start + i)
+                        diag[i] = values[p];
+                }
+            }
+            std::fill(a, a + d * d, 0.0);
+            for (int i = 0; i < d; i++)
+                a[i * d + i] = InverseScaling(diag[i]);
+        }
+    });
+
+    for (int i = m_nq; i < m_n; i++) {
+        double d = 0;
+        for (int p = rowptr[i]; p < rowptr[i + 1]; p++) {
+            if (colidx[p] == i)
+                d = values[p];
+        }
+        m_cdiag[i - m_nq] = InverseScaling(d);
+    }
+}
+
+void ChPreconditionerBlockJacobi::Apply(const ChMatrix<>& r, ChMatrix<>& z) const {
+    const double* rv = r.GetAddress();
+    double* zv = z.GetAddress();
+
+    int nb = (int)m_blocks.size() - 1;
+
+    ChParallelFor(0, nb, 0, [&](int ib) {
+        int start = m_blocks[ib];
+        int d = m_blocks[ib + 1] - start;
+        const double* a = &m_inv[m_inv_offsets[ib]];
+        for (int i = 0; i < d; i++) {
+            double s = 0;
+            for (int j = 0; j < d; j++)
+                s += a[i * d + j] * rv[start + j];
+            zv[start + i] = s;
+        }
+    });
+
+    for (int i = m_nq; i < m_n; i++)
+        zv[i] = m_cdiag[i - m_nq] * rv[i];
+}
+
+// -----------------------------------------------------------------------------
+// Incomplete LDL^T preconditioner
+// -----------------------------------------------------------------------------
+
+void ChPreconditionerILDL::SetupSymbolic() {
+    // Extract the lower triangular pattern of Z, making sure each row has a diagonal entry (stored last).
+    CSRMatrix full;
+    ExtractBlock(full, m_n);
+
+    m_A.nrows = m_n;
+    m_A.ncols = m_n;
+    m_A.rowptr.assign(m_n + 1, 0);
+    m_A.colidx.clear();
+
+    m_L.nrows = m_n;
+    m_L.ncols = m_n;
+    m_L.rowptr.assign(m_n + 1, 0);
+    m_L.colidx.clear();
+
+    for (int i = 0; i < m_n; i++) {
+        for (int p = full.rowptr[i]; p < full.rowptr[i + 1] && full.colidx[p] < i; p++) {
+            m_A.colidx.push_back(full.colidx[p]);
+            m_L.colidx.push_back(full.colidx[p]);
+        }
+        m_A.colidx.push_back(i);
+        m_A.rowptr[i + 1] = (int)m_A.colidx.size();
+        m_L.rowptr[i + 1] = (int)m_L.colidx.size();
+    }
+
+    m_A.values.resize(m_A.colidx.size());
+    m_L.values.resize(m_L.colidx.size());
+    m_D.resize(m_n);
+}
+
+void ChPreconditionerILDL::SetupNumeric() {
+    LoadValues(m_A, m_n);
+
+    // Row-oriented (left-looking) incomplete factorization on the pattern of the lower part of Z:
+    //   L(i,k) = ( A(i,k) - sum_{j<k} L(i,j) D(j) L(k,j) ) / D(k)
+    //   D(i)   =   A(i,i) - sum_{k<i} L(i,k)^2 D(k)
+    std::vector<double> w(m_n, 0.0);
+    std::vector<int> marker(m_n, -1);
+
+    for (int i = 0; i < m_n; i++) {
+        int a_start = m_A.rowptr[i];
+        int l_start = m_L.rowptr[i];
+        int l_end = m_L.rowptr[i + 1];
+
+        double a_ii = m_A.values[m_A.rowptr[i + 1] - 1];
+        double row_max = std::abs(a_ii);
+        for (int p = l_start; p < l_end; p++) {
+            int k = m_L.colidx[p];
+            w[k] = m_A.values[a_start + (p - l_start)];
+            marker[k] = i;
+            row_max = std::max(row_max, std::abs(w[k]));
+        }
+
+        double d_i = a_ii;
+        for (int p = l_start; p < l_end; p++) {
+            int k = m_L.colidx[p];
+            double s = w[k];
+            for (int q = m_L.rowptr[k]; q < m_L.rowptr[k + 1]; q++) {
+                int j = m_L.colidx[q];
+                if (marker[j] == i)
+                    s -= w[j] * m_D[j] * m_L.values[q];
+            }
+            w[k] = s / m_D[k];
+            d_i -= w[k] * w[k] * m_D[k];
+        }
+
+        // Guard against (numerically) zero pivots.
+        if (std::abs(d_i) < 1e-12 * (row_max + 1e-300))
+            d_i = (a_ii != 0) ? a_ii : 1.0;
+
+        m_D[i] = d_i;
+        for (int p = l_start; p < l_end; p++)
+            m_L.values[p] = w[m_L.colidx[p]];
+    }
+}
+
+void ChPreconditionerILDL::Apply(const ChMatrix<>& r, ChMatrix<>& z) const {
+    const double* rv = r.GetAddress();
+    double* zv = z.GetAddress();
+
+    // Forward substitution: L*y = r
+    for (int i = 0; i < m_n; i++) {
+        double s = rv[i];
+        for (int p = m_L.rowptr[i]; p < m_L.rowptr[i + 1]; p++)
+            s -= m_L.values[p] * zv[m_L.colidx[p]];
+        zv[i] = s;
+    }
+
+    // Diagonal scaling: y = |D|^(-1) * y
+    for (int i = 0; i < m_n; i++)
+        zv[i] /= std::abs(m_D[i]);
+
+    // Backward substitution: L^T*z = y
+    for (int i = m_n - 1; i >= 0; i--) {
+        double zi = zv[i];
+        for (int p = m_L.rowptr[i]; p < m_L.rowptr[i + 1]; p++)
+            zv[m_L.colidx[p]] -= m_L.values[p] * zi;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Smoothed-aggregation AMG preconditioner
+// -----------------------------------------------------------------------------
+
+ChPreconditionerAMG::ChPreconditionerAMG()
+    : m_theta(0.08), m_coarse_size(500), m_max_levels(10), m_coords_callback(nullptr), m_nns(0), m_fresh(false) {}
+
+// Near null space of the finest level: rigid body translations and, if the coordinates of all the variable
+// objects are available, rigid body rotations about their centroid.
+void ChPreconditionerAMG::BuildNullSpace(Level& level) {
+    int nb = (int)m_blocks.size() - 1;
+
+    bool rotations = (m_coords_callback != nullptr);
+    std::vector<ChVector<>> pos(nb);
+    ChVector<> center(0, 0, 0);
+    int dmax = 0;
+    for (int ib = 0; ib < nb; ib++) {
+        int d = m_blocks[ib + 1] - m_blocks[ib];
+        dmax = std::max(dmax, d);
+        if (rotations) {
+            rotations = (d == 3 || d == 6) && m_coords_callback->GetCoordinates(m_block_vars[ib], pos[ib]);
+            center += pos[ib];
+        }
+    }
+
+    m_nns = rotations ? 6 : dmax;
+    level.B.assign((size_t)m_nq * m_nns, 0.0);
+
+    if (!rotations) {
+        // Each DOF component is interpolated separately.
+        for (int ib = 0; ib < nb; ib++) {
+            for (int c = 0; c < m_blocks[ib + 1] - m_blocks[ib]; c++)
+                level.B[(size_t)(m_blocks[ib] + c) * m_nns + c] = 1;
+        }
+        return;
+    }
+
+    center /= nb;
+    for (int ib = 0; ib < nb; ib++) {
+        ChVector<> r = pos[ib] - center;
+        for (int k = 0; k < 3; k++) {
+            // Rotation about axis k: u = e_k x r
+            ChVector<> e(0, 0, 0);
+            e[k] = 1;
+            ChVector<> u = Vcross(e, r);
+            for (int c = 0; c < 3; c++) {
+                double* row = &level.B[(size_t)(m_blocks[ib] + c) * m_nns];
+                row[c] = 1;
+                row[3 + k] = u[c];
+            }
+            if (m_blocks[ib + 1] - m_blocks[ib] == 6)
+                level.B[(size_t)(m_blocks[ib] + 3 + k) * m_nns + 3 + k] = 1;
+        }
+    }
+}
+
+// Node-wise aggregation (three-pass greedy algorithm).
+bool ChPreconditionerAMG::Aggregate(Level& level, std::vector<int>& coarse_blocks, std::vector<double>& coarse_B) {
+    const CSRMatrix& A = level.A;
+    const std::vector<int>& blocks = level.blocks;
+    int nb = (int)blocks.size() - 1;
+
+    // Map DOFs to nodes and compute the node diagonal measures.
+    std::vector<int> node(A.nrows);
+    std::vector<double> dmax(nb, 0.0);
+    for (int ib = 0; ib < nb; ib++) {
+        for (int i = blocks[ib]; i < blocks[ib + 1]; i++) {
+            node[i] = ib;
+            for (int p = A.rowptr[i]; p < A.rowptr[i + 1]; p++) {
+                if (A.colidx[p] == i)
+                    dmax[ib] = std::max(dmax[ib], std::abs(A.values[p]));
+            }
+        }
+    }
+
+    // Strong node connections (only between nodes with the same number of DOFs).
+    std::vector<int> sptr(nb + 1, 0);
+    std::vector<int> sadj;
+    std::vector<double> smax(nb, 0.0);
+    std::vector<int> marker(nb, -1);
+    std::vector<int> nbrs;
+    for (int ib = 0; ib < nb; ib++) {
+        nbrs.clear();
+        int d = blocks[ib + 1] - blocks[ib];
+        for (int i = blocks[ib]; i < blocks[ib + 1]; i++) {
+            for (int p = A.rowptr[i]; p < A.rowptr[i + 1]; p++) {
+                int jb = node[A.colidx[p]];
+                if (jb == ib || blocks[jb + 1] - blocks[jb] != d)
+                    continue;
+                if (marker[jb] != ib) {
+                    marker[jb] = ib;
+                    smax[jb] = 0;
+                    nbrs.push_back(jb);
+                }
+                smax[jb] = std::max(smax[jb], std::abs(A.values[p]));
+            }
+        }
+        for (int jb : nbrs) {
+            if (smax[jb] * smax[jb] > m_theta * m_theta * dmax[ib] * dmax[jb])
+                sadj.push_back(jb);
+        }
+        sptr[ib + 1] = (int)sadj.size();
+    }
+
+    // Pass 1: seed aggregates at nodes whose strong neighborhood is entirely unaggregated.
+    std::vector<int> agg(nb, -1);
+    int na = 0;
+    for (int ib = 0; ib < nb; ib++) {
+        if (agg[ib] >= 0 || sptr[ib + 1] == sptr[ib])
+            continue;
+        bool free = true;
+        for (int p = sptr[ib]; p < sptr[ib + 1] && free; p++)
+            free = (agg[sadj[p]] < 0);
+        if (!free)
+            continue;
+        agg[ib] = na;
+        for (int p = sptr[ib]; p < sptr[ib + 1]; p++)
+            agg[sadj[p]] = na;
+        na++;
+    }
+
+    // Pass 2: attach remaining nodes to a neighboring aggregate.
+    std::vector<int> agg2 = agg;
+    for (int ib = 0; ib < nb; ib++) {
+        if (agg[ib] >= 0)
+            continue;
+        for (int p = sptr[ib]; p < sptr[ib + 1]; p++) {
+            if (agg[sadj[p]] >= 0) {
+                agg2[ib] = agg[sadj[p]];
+                break;
+            }
+        }
+    }
+    agg = agg2;
+
+    // Pass 3: remaining nodes form new aggregates with their unaggregated strong neighbors.
+    for (int ib = 0; ib < nb; ib++) {
+        if (agg[ib] >= 0)
+            continue;
+        agg[ib] = na;
+        for (int p = sptr[ib]; p < sptr[ib + 1]; p++) {
+            if (agg[sadj[p]] < 0)
+                agg[sadj[p]] = na;
+        }
+        na++;
+    }
+
+    if (na >= nb)
+        return false;
+
+    // Tentative prolongator: orthonormal basis of the near null space restricted to each aggregate,
+    // obtained with a (modified Gram-Schmidt) QR factorization of the aggregate rows of B. The R factors
+    // form the near null space of the coarse level. Linearly dependent modes (e.g. rotations of an
+    // aggregate with a single node) are dropped, so coarse blocks may have less than m_nns DOFs.
+    int k = m_nns;
+    std::vector<std::vector<int>> adofs(na);
+    for (int ib = 0; ib < nb; ib++) {
+        for (int i = blocks[ib]; i < blocks[ib + 1]; i++)
+            adofs[agg[ib]].push_back(i);
+    }
+
+    std::vector<std::vector<double>> Q(na);  // orthonormal columns (column-major, m x rank)
+    std::vector<std::vector<double>> R(na);  // R factors (row-major, rank x k)
+    std::vector<int> rank(na, 0);
+    std::vector<double> v;
+    for (int a = 0; a < na; a++) {
+        int m = (int)adofs[a].size();
+        Q[a].reserve((size_t)m * k);
+        R[a].reserve((size_t)k * k);
+        v.resize(m);
+        for (int c = 0; c < k; c++) {
+            double norm0 = 0;
+            for (int t = 0; t < m; t++) {
+                v[t] = level.B[(size_t)adofs[a][t] * k + c];
+                norm0 += v[t] * v[t];
+            }
+            if (norm0 == 0)
+                continue;
+            for (int j = 0; j < rank[a]; j++) {
+                const double* qj = &Q[a][(size_t)j * m];
+                double proj = 0;
+                for (int t = 0; t < m; t++)
+                    proj += qj[t] * v[t];
+                for (int t = 0; t < m; t++)
+                    v[t] -= proj * qj[t];
+                R[a][(size_t)j * k + c] = proj;
+            }
+            double norm = 0;
+            for (int t = 0; t < m; t++)
+                norm += v[t] * v[t];
+            if (norm <= 1e-16 * norm0)
+                continue;
+            norm = std::sqrt(norm);
+            for (int t = 0; t < m; t++)
+                Q[a].push_back(v[t] / norm);
+            R[a].resize((size_t)(rank[a] + 1) * k, 0.0);
+            R[a][(size_t)rank[a] * k + c] = norm;
+            rank[a]++;
+        }
+    }
+
+    // Coarse node blocks: one per aggregate.
+    coarse_blocks.resize(na + 1);
+    coarse_blocks[0] = 0;
+    for (int a = 0; a < na; a++)
+        coarse_blocks[a + 1] = coarse_blocks[a] + rank[a];
+    int nc = coarse_blocks[na];
+    if (nc >= A.nrows)
+        return false;
+
+    coarse_B.assign((size_t)nc * k, 0.0);
+    for (int a = 0; a < na; a++)
+        std::copy(R[a].begin(), R[a].end(), coarse_B.begin() + (size_t)coarse_blocks[a] * k);
+
+    CSRMatrix& P = level.P_tent;
+    P.nrows = A.nrows;
+    P.ncols = nc;
+    P.rowptr.assign(A.nrows + 1, 0);
+    for (int a = 0; a < na; a++) {
+        for (int i : adofs[a])
+            P.rowptr[i + 1] = rank[a];
+    }
+    for (int i = 0; i < A.nrows; i++)
+        P.rowptr[i + 1] += P.rowptr[i];
+    P.colidx.resize(P.rowptr[A.nrows]);
+    P.values.resize(P.rowptr[A.nrows]);
+    for (int a = 0; a < na; a++) {
+        int m = (int)adofs[a].size();
+        for (int t = 0; t < m; t++) {
+            int p = P.rowptr[adofs[a][t]];
+            for (int j = 0; j < rank[a]; j++) {
+                P.colidx[p + j] = coarse_blocks[a] + j;
+                P.values[p + j] = Q[a][(size_t)j * m + t];
+            }
+        }
+    }
+
+    return true;
+}
+
+// Smooth the tentative prolongator and form the Galerkin coarse operator.
+void ChPreconditionerAMG::BuildCoarse(Level& fine, Level& coarse) {
+    const CSRMatrix& A = fine.A;
+    int n = A.nrows;
+
+    fine.inv_diag.resize(n);
+    for (int i = 0; i < n; i++) {
+        double d = 0;
+        for (int p = A.rowptr[i]; p < A.rowptr[i + 1]; p++) {
+            if (A.colidx[p] == i)
+                d = A.values[p];
+        }
+        fine.inv_diag[i] = (d != 0) ? 1.0 / d : 1.0;
+    }
+
+    // Estimate the spectral radius of D^(-1)*A with a few power iterations.
+    std::vector<double> v(n), w(n);
+    for (int i = 0; i < n; i++)
+        v[i] = 1.0 + (i % 7) * 0.1;
+    double rho = 1;
+    for (int it = 0; it < 10; it++) {
+        A.Multiply(v.data(), w.data());
+        double norm = 0;
+        for (int i = 0; i < n; i++) {
+            w[i] *= fine.inv_diag[i];
+            norm += w[i] * w[i];
+        }
+        norm = std::sqrt(norm);
+        if (norm == 0)
+            break;
+        double vnorm = 0;
+        for (int i = 0; i < n; i++)
+            vnorm += v[i] * v[i];
+        rho = norm / std::sqrt(vnorm);
+        for (int i = 0; i < n; i++)
+            v[i] = w[i] / norm;
+    }
+    double omega = 4.0 / (3.0 * rho);
+
+    // P = (I - omega * D^(-1) * A) * P_tent
+    CSRMatrix AP = CSRMatrix::Product(A, fine.P_tent);
+    CSRMatrix& P = fine.P;
+    P.nrows = AP.nrows;
+    P.ncols = AP.ncols;
+    P.rowptr.assign(AP.nrows + 1, 0);
+    P.colidx.clear();
+    P.values.clear();
+    for (int i = 0; i < n; i++) {
+        double s = -omega * fine.inv_diag[i];
+        int pt = fine.P_tent.rowptr[i];
+        int pt_end = fine.P_tent.rowptr[i + 1];
+        for (int p = AP.rowptr[i]; p < AP.rowptr[i + 1]; p++) {
+            int j = AP.colidx[p];
+            double val = s * AP.values[p];
+            while (pt < pt_end && fine.P_tent.colidx[pt] < j) {
+                P.colidx.push_back(fine.P_tent.colidx[pt]);
+                P.values.push_back(fine.P_tent.values[pt]);
+                pt++;
+            }
+            if (pt < pt_end && fine.P_tent.colidx[pt] == j) {
+                val += fine.P_tent.values[pt];
+                pt++;
+            }
+            P.colidx.push_back(j);
+            P.values.push_back(val);
+        }
+        while (pt < pt_end) {
+            P.colidx.push_back(fine.P_tent.colidx[pt]);
+            P.values.push_back(fine.P_tent.values[pt]);
+            pt++;
+        }
+        P.rowptr[i + 1] = (int)P.colidx.size();
+    }
+
+    fine.R = P.Transpose();
+    coarse.A = CSRMatrix::Product(fine.R, CSRMatrix::Product(A, P));
+
+    fine.x.resize(n);
+    fine.b.resize(n);
+    fine.r.resize(n);
+}
+
+void ChPreconditionerAMG::FactorCoarsest() {
+    Level& level = m_levels.back();
+    int n = level.A.nrows;
+
+    level.inv_diag.resize(n);
+    for (int i = 0; i < n; i++) {
+        double d = 0;
+        for (int p = level.A.rowptr[i]; p < level.A.rowptr[i + 1]; p++) {
+            if (level.A.colidx[p] == i)
+                d = level.A.values[p];
+        }
+        level.inv_diag[i] = (d != 0) ? 1.0 / d : 1.0;
+    }
+    level.x.resize(n);
+    level.b.resize(n);
+    level.r.resize(n);
+
+    // Use a dense direct solver only if the coarsest level is small enough.
+    m_coarse_LU.clear();
+    if (n > std::max(m_coarse_size, 2000))
+        return;
+
+    m_coarse_LU.assign((size_t)n * n, 0.0);
+    for (int i = 0; i < n; i++) {
+        for (int p = level.A.rowptr[i]; p < level.A.rowptr[i + 1]; p++)
+            m_coarse_LU[(size_t)i * n + level.A.colidx[p]] = level.A.values[p];
+    }
+    FactorLU(m_coarse_LU, m_coarse_piv, n);
+}
+
+void ChPreconditionerAMG::SetupSymbolic() {
+    m_levels.clear();
+    m_cdiag.resize(m_n - m_nq);
+    m_fresh = true;
+
+    if (m_nq == 0)
+        return;
+
+    m_levels.push_back(Level());
+    ExtractBlock(m_levels[0].A, m_nq);
+    m_levels[0].blocks = m_blocks;
+    BuildNullSpace(m_levels[0]);
+
+    // Build the hierarchy (aggregates and coarse operators).
+    while ((int)m_levels.size() < m_max_levels && m_levels.back().A.nrows > m_coarse_size) {
+        std::vector<int> coarse_blocks;
+        std::vector<double> coarse_B;
+        if (!Aggregate(m_levels.back(), coarse_blocks, coarse_B))
+            break;
+        Level coarse;
+        coarse.blocks = coarse_blocks;
+        coarse.B = coarse_B;
+        BuildCoarse(m_levels.back(), coarse);
+        m_levels.push_back(coarse);
+    }
+}
+
+void ChPreconditionerAMG::SetupNumeric() {
+    if (!m_fresh && !m_levels.empty()) {
+        // Reuse the aggregates; refresh the operators on all levels.
+        LoadValues(m_levels[0].A, m_nq);
+        for (size_t l = 0; l + 1 < m_levels.size(); l++)
+            BuildCoarse(m_levels[l], m_levels[l + 1]);
+    }
+    m_fresh = false;
+
+    if (!m_levels.empty())
+        FactorCoarsest();
+
+    const int* rowptr = m_Z.GetCS_LeadingIndexArray();
+    const int* colidx = m_Z.GetCS_TrailingIndexArray();
+    const double* values = m_Z.GetCS_ValueArray();
+    for (int i = m_nq; i < m_n; i++) {
+        double d = 0;
+        for (int p = rowptr[i]; p < rowptr[i + 1]; p++) {
+            if (colidx[p] == i)
+                d = values[p];
+        }
+        m_cdiag[i - m_nq] = InverseScaling(d);
+    }
+}
+
+void ChPreconditionerAMG::VCycle(int l) const {
+    const Level& level = m_levels[l];
+    int n = level.A.nrows;
+
+    // Coarsest level: direct solve (or a few symmetric Gauss-Seidel sweeps if too large).
+    if (l == (int)m_levels.size() - 1) {
+        if (!m_coarse_LU.empty()) {
+            level.x = level.b;
+            SolveLU(m_coarse_LU, m_coarse_piv, n, level.x.data());
+        } else {
+            std::fill(level.x.begin(), level.x.end(), 0.0);
+            for (int it = 0; it < 5; it++) {
+                GaussSeidel(level.A, level.inv_diag, level.b.data(), level.x.data(), true);
+                GaussSeidel(level.A, level.inv_diag, level.b.data(), level.x.data(), false);
+            }
+        }
+        return;
+    }
+
+    const Level& coarse = m_levels[l + 1];
+
+    // Pre-smoothing (forward Gauss-Seidel, zero initial guess).
+    std::fill(level.x.begin(), level.x.end(), 0.0);
+    GaussSeidel(level.A, level.inv_diag, level.b.data(), level.x.data(), true);
+
+    // Restrict the residual.
+    level.A.Multiply(level.x.data(), level.r.data());
+    for (int i = 0; i < n; i++)
+        level.r[i] = level.b[i] - level.r[i];
+    level.R.Multiply(level.r.data(), coarse.b.data());
+
+    // Coarse-grid correction.
+    VCycle(l + 1);
+    level.P.Multiply(coarse.x.data(), level.r.data());
+    for (int i = 0; i < n; i++)
+        level.x[i] += level.r[i];
+
+    // Post-smoothing (backward Gauss-Seidel).
+    GaussSeidel(level.A, level.inv_diag, level.b.data(), level.x.data(), false);
+}
+
+void ChPreconditionerAMG::Apply(const ChMatrix<>& r, ChMatrix<>& z) const {
+    const double* rv = r.GetAddress();
+    double* zv = z.GetAddress();
+
+    if (!m_levels.empty()) {
+        const Level& level = m_levels[0];
+        std::copy(rv, rv + m_nq, level.b.begin());
+        VCycle(0);
+        std::copy(level.x.begin(), level.x.end(), zv);
+    }
+
+    for (int i = m_nq; i < m_n; i++)
+        zv[i] = m_cdiag[i - m_nq] * rv[i];
+}
+
+}  // end namespace chrono
@@ -0,0 +1,285 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHPRECONDITIONER_H
+#define CHPRECONDITIONER_H
+
+#include <algorithm>
+#include <vector>
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Base class for preconditioners of the full (KKT) system matrix Z, as used by the iterative solvers
+/// that operate on the unknowns x = {q, -l} (see ChSolverPMINRES and ChSolverPCG).\n
+/// At each call to Setup(), the matrix Z is assembled from the system descriptor (see
+/// ChSystemDescriptor::ConvertToMatrixForm) and the preconditioner is built in two phases: a symbolic
+/// phase, which only depends on the sparsity pattern of Z, and a numeric phase. The symbolic phase is
+/// performed only when the problem size or the sparsity pattern of Z changes; otherwise, Setup() only
+/// refreshes the numerical values. The assembly and the numeric phase can also be skipped for a number
+/// of calls (see SetUpdateInterval).\n
+/// All preconditioners derived from this class are symmetric positive definite, so they can be used
+/// with both MINRES- and CG-type methods.
+class ChApi ChPreconditioner {
+  public:
+    ChPreconditioner();
+
+    virtual ~ChPreconditioner() {}
+
+    /// Enable/disable the sparsity pattern lock.
+    /// If enabled, the sparsity pattern of Z is assumed not to change between calls to Setup(), as long as
+    /// the problem size does not change: the assembly of Z is faster and the pattern is not checked for
+    /// changes. Default: false.
+    void SetSparsityPatternLock(bool val);
+
+    /// Return true if the sparsity pattern lock is enabled.
+    bool GetSparsityPatternLock() const { return m_lock; }
+
+    /// Set the number of calls to Setup() between two updates of the preconditioner (default: 1).
+    /// With an interval larger than 1, Z is assembled and the preconditioner is recomputed only every
+    /// 'val' calls; in between, the current preconditioner is reused, unless the problem size changed.
+    /// Since Z changes little from one step to the next, this trades a few more solver iterations for
+    /// the cost of the assembly and of the numeric phase.
+    void SetUpdateInterval(int val) { m_interval = std::max(val, 1); }
+
+    /// Force a full (symbolic and numeric) setup at the next call to Setup().
+    void ForceSymbolicSetup() { m_analyzed = false; }
+
+    /// Build or update the preconditioner for the problem currently stored in the given system descriptor.
+    void Setup(ChSystemDescriptor& sysd);
+
+    /// Apply the preconditioner to the vector r, i.e. compute z = P^(-1) * r.
+    virtual void Apply(const ChMatrix<>& r, ChMatrix<>& z) const = 0;
+
+    /// Return the number of symbolic setups performed so far.
+    int GetNumSymbolicSetups() const { return m_num_symbolic; }
+
+    /// Return the number of numeric setups performed so far.
+    int GetNumNumericSetups() const { return m_num_numeric; }
+
+    /// Simple compressed sparse row matrix, used internally by the preconditioners.
+    struct CSRMatrix {
+        int nrows;
+        int ncols;
+        std::vector<int> rowptr;     ///< row start offsets (size nrows+1)
+        std::vector<int> colidx;     ///< column indices, sorted within each row
+        std::vector<double> values;  ///< nonzero values
+
+        CSRMatrix() : nrows(0), ncols(0), rowptr(1, 0) {}
+
+        /// Return the number of stored nonzeros.
+        int GetNNZ() const { return rowptr[nrows]; }
+
+        /// Compute y = A * x.
+        void Multiply(const double* x, double* y) const;
+
+        /// Return the transpose of this matrix.
+        CSRMatrix Transpose() const;
+
+        /// Return the product A * B.
+        static CSRMatrix Product(const CSRMatrix& A, const CSRMatrix& B);
+    };
+
+  protected:
+    /// Symbolic phase: analyze the sparsity pattern of the assembled matrix.
+    virtual void SetupSymbolic() = 0;
+
+    /// Numeric phase: compute the preconditioner from the values of the assembled matrix.
+    virtual void SetupNumeric() = 0;
+
+    /// Load the values of the assembled matrix into the given matrix with the same (or a subset of the)
+    /// sparsity pattern, restricted to the leading block of size n. Entries of the assembled matrix that
+    /// are not in the pattern are discarded.
+    void LoadValues(CSRMatrix& A, int n) const;
+
+    /// Extract the leading block of size n of the assembled matrix (pattern and values).
+    void ExtractBlock(CSRMatrix& A, int n) const;
+
+    ChCSMatrix m_Z;  ///< assembled system matrix
+
+    int m_n;   ///< size of the system matrix
+    int m_nq;  ///< number of primal unknowns (size of the upper-left H block)
+
+    std::vector<int> m_blocks;  ///< offsets of the variable (node) blocks in the primal unknowns, plus end marker
+    std::vector<ChVariables*> m_block_vars;  ///< variable objects associated with the blocks
+
+  private:
+    /// Return true if the assembled matrix has the same sparsity pattern as at the last symbolic phase.
+    bool SamePattern() const;
+
+    std::vector<int> m_pattern_rowptr;  ///< sparsity pattern at the last symbolic phase (row offsets)
+    std::vector<int> m_pattern_colidx;  ///< sparsity pattern at the last symbolic phase (column indices)
+
+    bool m_lock;          ///< sparsity pattern lock
+    bool m_analyzed;      ///< true if the symbolic phase was performed for the current pattern
+    int m_interval;       ///< number of calls to Setup() between updates
+    int m_num_calls;      ///< number of calls to Setup() since the last update
+    int m_num_symbolic;   ///< number of symbolic setups
+    int m_num_numeric;    ///< number of numeric setups
+};
+
+// -----------------------------------------------------------------------------
+
+/// Block-Jacobi preconditioner.
+/// The diagonal blocks of Z associated with each variable object (e.g. a body or an FEA node) are inverted
+/// exactly. Rows associated with constraints are scaled by the inverse of the (absolute) compliance term,
+/// or left unscaled if there is no compliance.
+class ChApi ChPreconditionerBlockJacobi : public ChPreconditioner {
+  public:
+    ChPreconditionerBlockJacobi() {}
+    ~ChPreconditionerBlockJacobi() {}
+
+    virtual void Apply(const ChMatrix<>& r, ChMatrix<>& z) const override;
+
+  private:
+    virtual void SetupSymbolic() override;
+    virtual void SetupNumeric() override;
+
+    std::vector<int> m_inv_offsets;  ///< offsets of the inverted blocks in m_inv
+    std::vector<double> m_inv;       ///< inverted diagonal blocks (dense, row-major)
+    std::vector<double> m_cdiag;     ///< inverse diagonal scaling for constraint rows
+};
+
+// -----------------------------------------------------------------------------
+
+/// Incomplete LDL^T factorization preconditioner with zero fill-in (ILDL(0), equivalent to IC(0) for
+/// symmetric positive definite matrices).
+/// Z is approximately factored as L*D*L^T on its own sparsity pattern. Since Z is in general indefinite
+/// (saddle point structure), the preconditioner L*|D|*L^T is applied, which is always positive definite.
+class ChApi ChPreconditionerILDL : public ChPreconditioner {
+  public:
+    ChPreconditionerILDL() {}
+    ~ChPreconditionerILDL() {}
+
+    virtual void Apply(const ChMatrix<>& r, ChMatrix<>& z) const override;
+
+  private:
+    virtual void SetupSymbolic() override;
+    virtual void SetupNumeric() override;
+
+    CSRMatrix m_A;            ///< lower triangular part of Z (diagonal entry last in each row)
+    CSRMatrix m_L;            ///< strictly lower triangular factor (unit diagonal implied)
+    std::vector<double> m_D;  ///< diagonal factor
+};
+
+// -----------------------------------------------------------------------------
+
+/// Smoothed-aggregation algebraic multigrid preconditioner.
+/// The multigrid hierarchy is built for the primal (upper-left, mass + stiffness) block H of Z. Unknowns
+/// are aggregated node-wise, i.e. all DOFs of a variable object (e.g. an FEA node) always belong to the
+/// same aggregate. The tentative prolongator interpolates the near null space of H (the rigid body modes)
+/// exactly on each aggregate: if the coordinates of the variable objects are provided (see
+/// SetCoordinatesCallback), it includes the three rigid body rotations, otherwise only the translations
+/// (i.e. each DOF component is interpolated separately). The prolongator is smoothed with one damped
+/// Jacobi step. The preconditioner performs one V-cycle with
+/// symmetric Gauss-Seidel smoothing and an exact solve on the coarsest level. Constraint rows are
+/// treated as in ChPreconditionerBlockJacobi.\n
+/// With the sparsity pattern lock enabled, the aggregates are reused and only the smoothed prolongators
+/// and the Galerkin coarse operators are recomputed.
+class ChApi ChPreconditionerAMG : public ChPreconditioner {
+  public:
+    /// Callback interface for providing the coordinates of the variable objects, used to build the rotational
+    /// rigid body modes. Only objects with 3 (translational) or 6 (translational and rotational) DOFs are
+    /// supported.
+    class ChApi CoordinatesCallback {
+      public:
+        virtual ~CoordinatesCallback() {}
+
+        /// Set 'pos' to the location of the object that owns the given variables and return true,
+        /// or return false if not available.
+        virtual bool GetCoordinates(ChVariables* variables, ChVector<>& pos) = 0;
+    };
+
+    ChPreconditionerAMG();
+    ~ChPreconditionerAMG() {}
+
+    /// Set the callback used to obtain the coordinates of the variable objects (e.g. the FEA nodes).
+    /// If not set, or if the coordinates of some variable objects are not available, the rotational
+    /// rigid body modes are not included in the near null space. The coordinates are only queried in
+    /// the symbolic phase.
+    void SetCoordinatesCallback(CoordinatesCallback* callback) { m_coords_callback = callback; }
+
+    /// Return the dimension of the near null space used in the current multigrid hierarchy.
+    int GetNullSpaceSize() const { return m_nns; }
+
+    /// Set the strength of connection threshold used for aggregation (default: 0.08).
+    void SetStrengthThreshold(double val) { m_theta = val; }
+
+    /// Set the maximum size of the coarsest level, solved with a direct method (default: 500).
+    void SetCoarseSize(int val) { m_coarse_size = val; }
+
+    /// Set the maximum number of levels (default: 10).
+    void SetMaxLevels(int val) { m_max_levels = val; }
+
+    /// Return the number of levels in the current multigrid hierarchy.
+    int GetNumLevels() const { return (int)m_levels.size(); }
+
+    virtual void Apply(const ChMatrix<>& r, ChMatrix<>& z) const override;
+
+  private:
+    /// One level of the multigrid hierarchy.
+    struct Level {
+        CSRMatrix A;                     ///< operator on this level
+        CSRMatrix P;                     ///< smoothed prolongator (to this level from the next coarser one)
+        CSRMatrix R;                     ///< restriction (transpose of P)
+        CSRMatrix P_tent;                ///< tentative prolongator
+        std::vector<int> blocks;         ///< node block offsets on this level
+        std::vector<double> B;           ///< near null space (row-major, one row per DOF)
+        std::vector<double> inv_diag;    ///< inverse of the diagonal of A
+        mutable std::vector<double> x;   ///< work vector (solution)
+        mutable std::vector<double> b;   ///< work vector (right-hand side)
+        mutable std::vector<double> r;   ///< work vector (residual)
+    };
+
+    virtual void SetupSymbolic() override;
+    virtual void SetupNumeric() override;
+
+    /// Build the near null space of the finest level.
+    void BuildNullSpace(Level& level);
+
+    /// Build the node-wise aggregates and tentative prolongator for the given level, and the node blocks and
+    /// near null space of the coarse level. Return false if no coarsening is possible.
+    bool Aggregate(Level& level, std::vector<int>& coarse_blocks, std::vector<double>& coarse_B);
+
+    /// Compute the smoothed prolongator and the coarse operator for the given level.
+    void BuildCoarse(Level& fine, Level& coarse);
+
+    /// Factor the coarsest level operator.
+    void FactorCoarsest();
+
+    /// Perform one V-cycle starting at the specified level.
+    void VCycle(int l) const;
+
+    double m_theta;       ///< strength of connection threshold
+    int m_coarse_size;    ///< maximum size of the coarsest level
+    int m_max_levels;     ///< maximum number of levels
+
+    CoordinatesCallback* m_coords_callback;  ///< callback for the coordinates of the variable objects
+    int m_nns;                               ///< dimension of the near null space
+
+    std::vector<Level> m_levels;      ///< multigrid hierarchy
+    std::vector<double> m_coarse_LU;  ///< dense LU factors of the coarsest operator
+    std::vector<int> m_coarse_piv;    ///< pivots of the coarsest LU factorization
+    std::vector<double> m_cdiag;      ///< inverse diagonal scaling for constraint rows
+    bool m_fresh;                     ///< true if the hierarchy was just built by the symbolic phase
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
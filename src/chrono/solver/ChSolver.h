@@ -47,6 +47,7 @@ class ChApi ChSolver {
           APGD,
           MINRES,
           SOLVER_SMC,
+          SOR_COLORED,
           CUSTOM,
       };
 
@@ -0,0 +1,265 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChSolverAPGD.h"
+#include "chrono/solver/ChSolverBB.h"
+#include "chrono/solver/ChSolverIslands.h"
+#include "chrono/solver/ChSolverJacobi.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono/solver/ChSolverPCG.h"
+#include "chrono/solver/ChSolverPMINRES.h"
+#include "chrono/solver/ChSolverSMC.h"
+#include "chrono/solver/ChSolverSOR.h"
+#include "chrono/solver/ChSolverSORcolored.h"
+#include "chrono/solver/ChSolverSORmultithread.h"
+#include "chrono/solver/ChSolverSymmSOR.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChSolverIslands)
+
+void ChSolverIslands::SetIslandSolverType(ChSolver::Type type) {
+    if (type == ChSolver::Type::CUSTOM)
+        throw ChException("ChSolverIslands: the island solver cannot be of CUSTOM type.");
+    if (type != island_type)
+        solvers.clear();
+    island_type = type;
+}
+
+ChIterativeSolver& ChSolverIslands::GetIslandSolver(int island) {
+    while ((int)solvers.size() <= island) {
+        std::shared_ptr<ChIterativeSolver> solver;
+        switch (island_type) {
+            case ChSolver::Type::SOR:
+                solver = std::make_shared<ChSolverSOR>();
+                break;
+            case ChSolver::Type::SYMMSOR:
+                solver = std::make_shared<ChSolverSymmSOR>();
+                break;
+            case ChSolver::Type::JACOBI:
+                solver = std::make_shared<ChSolverJacobi>();
+                break;
+            case ChSolver::Type::SOR_MULTITHREAD:
+                solver = std::make_shared<ChSolverSORmultithread>();
+                break;
+            case ChSolver::Type::SOR_COLORED:
+                solver = std::make_shared<ChSolverSORcolored>();
+                break;
+            case ChSolver::Type::PMINRES:
+                solver = std::make_shared<ChSolverPMINRES>();
+                break;
+            case ChSolver::Type::BARZILAIBORWEIN:
+                solver = std::make_shared<ChSolverBB>();
+                break;
+            case ChSolver::Type::PCG:
+                solver = std::make_shared<ChSolverPCG>();
+                break;
+            case ChSolver::Type::APGD:
+                solver = std::make_shared<ChSolverAPGD>();
+                break;
+            case ChSolver::Type::MINRES:
+                solver = std::make_shared<ChSolverMINRES>();
+                break;
+            case ChSolver::Type::SOLVER_SMC:
+                solver = std::make_shared<ChSolverSMC>();
+                break;
+            default:
+                throw ChException("ChSolverIslands: island solver type not supported.");
+        }
+        solvers.push_back(solver);
+    }
+
+    ChIterativeSolver& solver = *solvers[island];
+    solver.SetMaxIterations(max_iterations);
+    solver.SetWarmStart(warm_start);
+    solver.SetTolerance(tolerance);
+    solver.SetOmega(omega);
+    solver.SetSharpnessLambda(shlambda);
+    return solver;
+}
+
+bool ChSolverIslands::BuildIslands(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+    std::vector<ChKblock*>& mstiffness = sysd.GetKblocksList();
+
+    // 1) Union-find over the active variables, identified by their offset in the global q vector.
+    sysd.UpdateCountsAndOffsets();
+    int n_q = sysd.CountActiveVariables();
+    std::vector<int> var_index(n_q, -1);
+    int nvars = 0;
+    for (auto var : mvariables) {
+        if (var->IsActive() && var->Get_ndof() > 0)
+            var_index[var->GetOffset()] = nvars++;
+    }
+    uf.Reset(nvars);
+
+    // Index of the first active variable among 'vars' (-1 if none); all others are merged with it.
+    auto merge = [&](const std::vector<ChVariables*>& vars) {
+        int first = -1;
+        for (auto var : vars) {
+            if (!(var && var->IsActive() && var->Get_ndof() > 0))
+                continue;
+            int index = var_index[var->GetOffset()];
+            if (first < 0)
+                first = index;
+            else
+                uf.Union(first, index);
+        }
+        return first;
+    };
+
+    std::vector<ChVariables*> vars;
+    std::vector<int> constraint_var(mconstraints.size(), -1);
+    for (size_t ic = 0; ic < mconstraints.size(); ic++) {
+        if (!mconstraints[ic]->IsActive())
+            continue;
+        vars.clear();
+        if (!mconstraints[ic]->CollectVariables(vars))
+            return false;
+        constraint_var[ic] = merge(vars);
+        if (constraint_var[ic] < 0)
+            return false;
+    }
+
+    std::vector<int> kblock_var(mstiffness.size(), -1);
+    for (size_t ik = 0; ik < mstiffness.size(); ik++) {
+        auto kblock = dynamic_cast<ChKblockGeneric*>(mstiffness[ik]);
+        if (!kblock)
+            return false;
+        vars.clear();
+        for (unsigned int iv = 0; iv < kblock->GetNvars(); iv++)
+            vars.push_back(kblock->GetVariableN(iv));
+        kblock_var[ik] = merge(vars);
+    }
+
+    // 2) Number the islands in order of their first variable. Variables that are not coupled to any other
+    //    variable (i.e. single-variable islands without constraints nor stiffness blocks) share one island.
+    std::vector<bool> coupled(nvars, false);
+    for (size_t ic = 0; ic < mconstraints.size(); ic++) {
+        if (constraint_var[ic] >= 0)
+            coupled[uf.Find(constraint_var[ic])] = true;
+    }
+    for (size_t ik = 0; ik < mstiffness.size(); ik++) {
+        if (kblock_var[ik] >= 0)
+            coupled[uf.Find(kblock_var[ik])] = true;
+    }
+
+    std::vector<int> root_island(nvars, -1);
+    int nislands = 0;
+    int free_island = -1;
+    for (int i = 0; i < nvars; i++) {
+        int root = uf.Find(i);
+        if (root_island[root] >= 0)
+            continue;
+        if (coupled[root]) {
+            root_island[root] = nislands++;
+        } else {
+            if (free_island < 0)
+                free_island = nislands++;
+            root_island[root] = free_island;
+        }
+    }
+
+    // 3) Fill the island descriptors, preserving the order of variables and constraints (in particular,
+    //    the three constraints of a friction contact stay consecutive).
+    while ((int)descriptors.size() < nislands)
+        descriptors.push_back(std::unique_ptr<ChSystemDescriptor>(new ChSystemDescriptor));
+    descriptors.resize(nislands);
+
+    for (auto& descriptor : descriptors) {
+        descriptor->BeginInsertion();
+        descriptor->SetMassFactor(sysd.GetMassFactor());
+    }
+    for (auto var : mvariables) {
+        if (var->IsActive() && var->Get_ndof() > 0)
+            descriptors[root_island[uf.Find(var_index[var->GetOffset()])]]->InsertVariables(var);
+    }
+    for (size_t ic = 0; ic < mconstraints.size(); ic++) {
+        if (constraint_var[ic] >= 0)
+            descriptors[root_island[uf.Find(constraint_var[ic])]]->InsertConstraint(mconstraints[ic]);
+    }
+    for (size_t ik = 0; ik < mstiffness.size(); ik++) {
+        if (kblock_var[ik] >= 0)
+            descriptors[root_island[uf.Find(kblock_var[ik])]]->InsertKblock(mstiffness[ik]);
+    }
+
+    // Note: EndInsertion() assigns island-local offsets to the variables and constraints.
+    for (auto& descriptor : descriptors)
+        descriptor->EndInsertion();
+
+    return true;
+}
+
+double ChSolverIslands::Solve(ChSystemDescriptor& sysd) {
+    tot_iterations = 0;
+
+    if (!BuildIslands(sysd)) {
+        // Cannot partition: solve the problem as a single island, with the original descriptor.
+        ChIterativeSolver& solver = GetIslandSolver(0);
+        solver.SetVerbose(verbose);
+        double maxviolation = solver.Solve(sysd);
+        tot_iterations = solver.GetTotalIterations();
+        island_iterations.assign(1, tot_iterations);
+        island_variables.assign(1, sysd.CountActiveVariables());
+        island_constraints.assign(1, sysd.CountActiveConstraints());
+        return maxviolation;
+    }
+
+    int nislands = (int)descriptors.size();
+    for (int island = 0; island < nislands; island++)
+        GetIslandSolver(island).SetVerbose(false);
+
+    island_iterations.assign(nislands, 0);
+    island_variables.resize(nislands);
+    island_constraints.resize(nislands);
+    for (int island = 0; island < nislands; island++) {
+        island_variables[island] = descriptors[island]->CountActiveVariables();
+        island_constraints[island] = descriptors[island]->CountActiveConstraints();
+    }
+
+    // Larger islands are started first, for a better load balance.
+    std::vector<int> order(nislands);
+    std::vector<double> violation(nislands, 0.0);
+    for (int island = 0; island < nislands; island++)
+        order[island] = island;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int a, int b) { return island_constraints[a] > island_constraints[b]; });
+
+    ChParallelFor(0, nislands, 1, [&](int k) {
+        int island = order[k];
+        violation[island] = solvers[island]->Solve(*descriptors[island]);
+        island_iterations[island] = solvers[island]->GetTotalIterations();
+    });
+
+    // Restore the global offsets of variables and constraints.
+    sysd.UpdateCountsAndOffsets();
+
+    double maxviolation = 0;
+    for (int island = 0; island < nislands; island++) {
+        maxviolation = std::max(maxviolation, violation[island]);
+        tot_iterations = std::max(tot_iterations, island_iterations[island]);
+    }
+
+    if (verbose)
+        GetLog() << "\n-----Islands solver, " << nislands << " islands, max iterations " << tot_iterations
+                 << ", max violation " << maxviolation << "\n";
+
+    return maxviolation;
+}
+
+}  // end namespace chrono
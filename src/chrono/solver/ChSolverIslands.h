@@ -0,0 +1,98 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSOLVERISLANDS_H
+#define CHSOLVERISLANDS_H
+
+#include <memory>
+#include <vector>
+
+#include "chrono/core/ChUnionFind.h"
+#include "chrono/solver/ChIterativeSolver.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// A solver that splits the problem in independent 'islands' and solves them concurrently.\n
+/// At each call to Solve(), the active variables are partitioned with a union-find over the constraints and
+/// the stiffness blocks that couple them. Each island gets its own system descriptor and its own instance of
+/// an iterative solver (of the type specified in the constructor), that stops according to its own
+/// convergence: small or quiet islands can converge in a few iterations, while the others keep iterating.
+/// Islands are solved in parallel with the Chrono task scheduler; the results do not depend on the number
+/// of threads (as long as the island solver is deterministic).
+/// Variables not coupled to any other variable are gathered in a single island.\n
+/// The maximum number of iterations, tolerance, warm start, overrelaxation and sharpness settings of this
+/// solver are passed to the island solvers. GetTotalIterations() returns the largest number of iterations
+/// taken by an island.\n
+/// If some constraint cannot report its variables (see ChConstraint::CollectVariables) or some stiffness
+/// block is not a ChKblockGeneric, the problem is solved as a single island.\n
+/// See ChSystemDescriptor for more information about the problem formulation and the data structures
+/// passed to the solver.
+
+class ChApi ChSolverIslands : public ChIterativeSolver {
+
+  public:
+    ChSolverIslands(ChSolver::Type island_type = ChSolver::Type::SOR,  ///< type of the island solvers
+                    int mmax_iters = 50,                               ///< max.number of iterations
+                    bool mwarm_start = false,                          ///< uses warm start?
+                    double mtolerance = 0.0,                           ///< tolerance for termination criterion
+                    double momega = 1.0                                ///< overrelaxation criterion
+                    )
+        : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega), island_type(island_type) {}
+
+    virtual ~ChSolverIslands() {}
+
+    /// Performs the solution of the problem.
+    /// \return  the maximum constraint violation after termination (over all islands).
+    virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
+                         ) override;
+
+    /// Set the type of the iterative solver used for each island.
+    /// All iterative solver types are supported; the CUSTOM type is not.
+    void SetIslandSolverType(ChSolver::Type type);
+
+    /// Return the type of the iterative solver used for each island.
+    ChSolver::Type GetIslandSolverType() const { return island_type; }
+
+    /// Return the number of islands in the last call to Solve().
+    int GetNumIslands() const { return (int)island_iterations.size(); }
+
+    /// Return the number of iterations taken by the specified island in the last call to Solve().
+    int GetIslandIterations(int island) const { return island_iterations[island]; }
+
+    /// Return the number of active variables in the specified island in the last call to Solve().
+    int GetIslandNumVariables(int island) const { return island_variables[island]; }
+
+    /// Return the number of active constraints in the specified island in the last call to Solve().
+    int GetIslandNumConstraints(int island) const { return island_constraints[island]; }
+
+  private:
+    /// Partition the problem in islands and fill the island descriptors.
+    /// Return false if the problem cannot be partitioned.
+    bool BuildIslands(ChSystemDescriptor& sysd);
+
+    /// Create (if needed) and configure the solver for the specified island.
+    ChIterativeSolver& GetIslandSolver(int island);
+
+    ChSolver::Type island_type;
+
+    ChUnionFind uf;
+    std::vector<std::unique_ptr<ChSystemDescriptor>> descriptors;  ///< one descriptor per island (reused)
+    std::vector<std::shared_ptr<ChIterativeSolver>> solvers;       ///< one solver per island (reused)
+    std::vector<int> island_iterations;                            ///< iterations taken by each island
+    std::vector<int> island_variables;                             ///< active variables in each island
+    std::vector<int> island_constraints;                           ///< active constraints in each island
+};
+
+}  // end namespace chrono
+
+#endif
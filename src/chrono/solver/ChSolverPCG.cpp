@@ -24,6 +24,11 @@ double ChSolverPCG::Solve(ChSystemDescriptor& sysd  ///< system description with
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
 
+    // If a KKT preconditioner is provided, use the Solve_SupportingStiffness method, that operates
+    // on the KKT system (the Schur complement is never assembled, so it cannot be preconditioned).
+    if (preconditioner)
+        return this->Solve_SupportingStiffness(sysd);
+
     tot_iterations = 0;
     double maxviolation = 0.;
 
@@ -188,4 +193,133 @@ double ChSolverPCG::Solve(ChSystemDescriptor& sysd  ///< system description with
     return maxviolation;
 }
 
+double ChSolverPCG::Solve_SupportingStiffness(
+    ChSystemDescriptor& sysd  ///< system description with constraints and variables
+    ) {
+    tot_iterations = 0;
+    double maxviolation = 0.;
+
+    int nv = sysd.CountActiveVariables();
+    int nc = sysd.CountActiveConstraints();
+    int nx = nv + nc;  // total scalar unknowns, in x vector for full KKT system Z*x-d=0
+
+    if (verbose)
+        GetLog() << "\n-----Preconditioned CG -supporting stiffness-, n.vars nx=" << nx
+                 << "  max.iters=" << max_iterations << "\n";
+
+    ChMatrixDynamic<> mx(nx, 1);
+    ChMatrixDynamic<> md(nx, 1);
+    ChMatrixDynamic<> mr(nx, 1);
+    ChMatrixDynamic<> mz(nx, 1);
+    ChMatrixDynamic<> mp(nx, 1);
+    ChMatrixDynamic<> mZp(nx, 1);
+    ChMatrixDynamic<> mtmp(nx, 1);
+    ChMatrixDynamic<> mDi(nx, 1);
+
+    // Set up the preconditioner, or fall back to a diagonal (scaling) preconditioner.
+    if (preconditioner) {
+        preconditioner->Setup(sysd);
+    } else {
+        sysd.BuildDiagonalVector(mDi);
+        for (int nel = 0; nel < mDi.GetRows(); nel++) {
+            if (fabs(mDi(nel)) > 1e-9)
+                mDi(nel) = 1.0 / fabs(mDi(nel));
+            else
+                mDi(nel) = 1.0;
+        }
+    }
+
+    // Initialize the x vector of unknowns x ={q; -l}
+    if (warm_start)
+        sysd.FromUnknownsToVector(mx);
+    else
+        mx.FillElem(0);
+
+    // Initialize the d vector filling it with {f, -b}
+    sysd.BuildDiVector(md);
+
+    double abs_tol = tolerance;
+
+    // r = d - Z*x;
+    sysd.SystemProduct(mr, &mx);
+    mr.MatrNeg();
+    mr.MatrInc(md);
+
+    // z = Mi*r;  p = z;
+    if (preconditioner) {
+        preconditioner->Apply(mr, mz);
+    } else {
+        mz = mr;
+        mz.MatrScale(mDi);
+    }
+    mp = mz;
+
+    double rz = mr.MatrDot(mr, mz);
+
+    for (int iter = 0; iter < max_iterations; iter++) {
+        // alpha = r'*z / p'*Z*p
+        sysd.SystemProduct(mZp, &mp);  // Zp = Z*p    #### MATR.MULTIPLICATION!!!###
+        double pZp = mp.MatrDot(mp, mZp);
+
+        if (fabs(pZp) < 10e-30) {
+            if (verbose)
+                GetLog() << "Rayleigh quotient pZp breakdown, iter=" << iter << "\n";
+            break;
+        }
+
+        double alpha = rz / pZp;
+
+        // x = x + alpha * p;
+        mtmp = mp;
+        mtmp.MatrScale(alpha);
+        mx.MatrInc(mtmp);
+
+        double maxdeltaunknowns = mtmp.NormInf();
+
+        // r = r - alpha * Z*p;
+        mtmp = mZp;
+        mtmp.MatrScale(alpha);
+        mr.MatrDec(mtmp);
+
+        tot_iterations++;
+
+        double r_resid = mr.NormTwo();
+
+        // For recording into correction/residuals/violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(r_resid, maxdeltaunknowns, iter);
+
+        if (r_resid < abs_tol) {
+            if (verbose)
+                GetLog() << "r-converged! iter=" << iter << " |r|=" << r_resid << "\n";
+            break;
+        }
+
+        // z = Mi*r;
+        if (preconditioner) {
+            preconditioner->Apply(mr, mz);
+        } else {
+            mz = mr;
+            mz.MatrScale(mDi);
+        }
+
+        // beta = r_new'*z_new / r'*z;  p = z + beta * p;
+        double rz_new = mr.MatrDot(mr, mz);
+        double beta = rz_new / rz;
+        rz = rz_new;
+
+        mp.MatrScale(beta);
+        mp.MatrInc(mz);
+    }
+
+    // After having solved for unknowns x={q;-l}, now copy those values from x vector to
+    // the q values in ChVariable items and to l values in ChConstraint items
+    sysd.FromVectorToUnknowns(mx);
+
+    if (verbose)
+        GetLog() << "residual: " << mr.NormTwo() << " ---\n";
+
+    return maxviolation;
+}
+
 }  // end namespace chrono
@@ -40,6 +40,17 @@ class ChApi ChSolverPCG : public ChIterativeSolver {
     /// \return  the maximum constraint violation after termination.
     virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
                          ) override;
+
+    /// Same as Solve(), but this also supports the presence of ChKblock blocks.
+    /// If a preconditioner was attached (see ChIterativeSolver::SetPreconditioner), Solve() automatically
+    /// falls back to this function. Otherwise, Solve() keeps operating on the Schur complement.
+    /// Rather than the Schur complement, a preconditioned CG is applied to the entire KKT system
+    /// with primals q and duals l. Note that CG converges reliably only if the KKT matrix is positive
+    /// definite (e.g. FEA problems with no constraints, or with compliant constraints); for general
+    /// saddle-point problems use ChSolverPMINRES instead.
+    virtual double Solve_SupportingStiffness(
+        ChSystemDescriptor& sysd  ///< system description with constraints and variables
+        );
 };
 
 }  // end namespace chrono
@@ -28,7 +28,8 @@ double ChSolverPMINRES::Solve(ChSystemDescriptor& sysd  ///< system description
 
     // If stiffness blocks are used, the Schur complement cannot be esily
     // used, so fall back to the Solve_SupportingStiffness method, that operates on KKT.
-    if (sysd.GetKblocksList().size() > 0)
+    // The same holds if a preconditioner for the KKT system was provided.
+    if (sysd.GetKblocksList().size() > 0 || preconditioner)
         return this->Solve_SupportingStiffness(sysd);
 
     // Allocate auxiliary vectors;
@@ -317,7 +318,7 @@ double ChSolverPMINRES::Solve_SupportingStiffness(
     ChMatrixDynamic<> mZMr(nx, 1);
     ChMatrixDynamic<> mZMr_old(nx, 1);
     ChMatrixDynamic<> mtmp(nx, 1);
-    ChMatrixDynamic<> mDi(nx, 1);
+    ChMatrixDynamic<> mDi((preconditioner || !do_preconditioning) ? 1 : nx, 1);
 
     this->tot_iterations = 0;
     double maxviolation = 0.;
@@ -326,18 +327,24 @@ double ChSolverPMINRES::Solve_SupportingStiffness(
     // --- Compute a diagonal (scaling) preconditioner for the KKT system:
     //
 
-    // Initialize the mDi vector with the diagonal of the Z matrix
-    sysd.BuildDiagonalVector(mDi);
-
-    // Pre-invert the values, to avoid wasting time with divisions in the following.
-    // From now, mDi contains the inverse of the diagonal of Z.
-    // Note, for constraints, the diagonal is 0, so set inverse of D as 1 assuming
-    // a constraint preconditioning and assuming the dot product of jacobians is already about 1.
-    for (int nel = 0; nel < mDi.GetRows(); nel++) {
-        if (fabs(mDi(nel)) > 1e-9)
-            mDi(nel) = 1.0 / mDi(nel);
-        else
-            mDi(nel) = 1.0;
+    // If a KKT preconditioner is attached, set it up for the current problem
+    // (this assembles the Z matrix), and use it instead of the diagonal scaling.
+    if (preconditioner) {
+        preconditioner->Setup(sysd);
+    } else if (do_preconditioning) {
+        // Initialize the mDi vector with the diagonal of the Z matrix
+        sysd.BuildDiagonalVector(mDi);
+
+        // Pre-invert the values, to avoid wasting time with divisions in the following.
+        // From now, mDi contains the inverse of the diagonal of Z.
+        // Note, for constraints, the diagonal is 0, so set inverse of D as 1 assuming
+        // a constraint preconditioning and assuming the dot product of jacobians is already about 1.
+        for (int nel = 0; nel < mDi.GetRows(); nel++) {
+            if (fabs(mDi(nel)) > 1e-9)
+                mDi(nel) = 1.0 / mDi(nel);
+            else
+                mDi(nel) = 1.0;
+        }
     }
 
     //
@@ -380,7 +387,9 @@ double ChSolverPMINRES::Solve_SupportingStiffness(
                      */
     // p = Mi * r;
     mp = mr;
-    if (do_preconditioning)
+    if (preconditioner)
+        preconditioner->Apply(mr, mp);
+    else if (do_preconditioning)
         mp.MatrScale(mDi);
 
     // z = Mi * r;
@@ -399,7 +408,9 @@ double ChSolverPMINRES::Solve_SupportingStiffness(
     for (int iter = 0; iter < max_iterations; iter++) {
         // MZp = Mi*Zp; % = Mi*Z*p                  %% -- Precond
         mMZp = mZp;
-        if (do_preconditioning)
+        if (preconditioner)
+            preconditioner->Apply(mZp, mMZp);
+        else if (do_preconditioning)
             mMZp.MatrScale(mDi);
 
         // alpha = (z'*(ZMr))/((MZp)'*(Zp));
@@ -465,7 +476,9 @@ double ChSolverPMINRES::Solve_SupportingStiffness(
 
         // z = Mi*r;                                 %% -- Precond
         mz = mr;
-        if (do_preconditioning)
+        if (preconditioner)
+            preconditioner->Apply(mr, mz);
+        else if (do_preconditioning)
             mz.MatrScale(mDi);
 
         // ZMr_old = ZMr;
@@ -0,0 +1,325 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <utility>
+
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono/solver/ChSolverSORcolored.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChSolverSORcolored)
+
+void ChSolverSORcolored::ColorConstraints(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    int n_q = sysd.CountActiveVariables();
+
+    // 1) Build the groups: single constraints, or the three constraints (n,u,v) of a friction contact,
+    //    and collect the offsets of the active variables of each group (-1 marks unknown variables).
+    std::vector<ChConstraint*> ordered;
+    std::vector<int> gstart;
+    int i_friction_comp = 0;
+    for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
+        if (!mconstraints[ic]->IsActive())
+            continue;
+        if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+            if (i_friction_comp == 0)
+                gstart.push_back((int)ordered.size());
+            i_friction_comp = (i_friction_comp + 1) % 3;
+        } else {
+            if (i_friction_comp != 0)
+                i_friction_comp = 0;  // incomplete friction triplet (should not happen)
+            gstart.push_back((int)ordered.size());
+        }
+        ordered.push_back(mconstraints[ic]);
+    }
+    int ngroups = (int)gstart.size();
+    gstart.push_back((int)ordered.size());
+
+    std::vector<int> pattern;
+    std::vector<int> pattern_start;
+    std::vector<ChVariables*> vars;
+    pattern.reserve(2 * ordered.size());
+    pattern_start.reserve(ngroups + 1);
+    for (int ig = 0; ig < ngroups; ig++) {
+        pattern_start.push_back((int)pattern.size());
+        vars.clear();
+        bool known = true;
+        for (int i = gstart[ig]; i < gstart[ig + 1]; i++)
+            known = ordered[i]->CollectVariables(vars) && known;
+        if (!known) {
+            pattern.push_back(-1);
+            continue;
+        }
+        for (auto var : vars) {
+            if (var && var->IsActive() && var->Get_ndof() > 0)
+                pattern.push_back(var->GetOffset());
+        }
+    }
+    pattern_start.push_back((int)pattern.size());
+
+    // If the constraints and the variables they act on did not change since the last call,
+    // the current coloring is still valid.
+    if (n_q == cached_n_q && ordered == cached_ordered && pattern == cached_pattern)
+        return;
+
+    num_colorings++;
+    cached_n_q = n_q;
+    cached_ordered.swap(ordered);
+    cached_pattern.swap(pattern);
+    const std::vector<ChConstraint*>& groups = cached_ordered;
+
+    // 2) Greedy coloring: each group gets the smallest color not yet used by any of its active variables.
+    //    Active variables are identified by their offset in the global q vector.
+    std::vector<std::vector<int>> var_colors(n_q);
+    std::vector<int> stamp;
+    std::vector<int> group_color(ngroups);
+    int ncolors = 0;
+    bool has_unknown = false;
+
+    for (int ig = 0; ig < ngroups; ig++) {
+        int p_start = pattern_start[ig];
+        int p_end = pattern_start[ig + 1];
+
+        if (p_end > p_start && cached_pattern[p_start] < 0) {
+            group_color[ig] = -1;
+            has_unknown = true;
+            continue;
+        }
+
+        for (int p = p_start; p < p_end; p++) {
+            for (auto color : var_colors[cached_pattern[p]])
+                stamp[color] = ig;
+        }
+        int color = 0;
+        while (color < ncolors && stamp[color] == ig)
+            color++;
+        if (color == ncolors) {
+            ncolors++;
+            stamp.push_back(-1);
+        }
+
+        group_color[ig] = color;
+        for (int p = p_start; p < p_end; p++) {
+            std::vector<int>& vc = var_colors[cached_pattern[p]];
+            if (std::find(vc.begin(), vc.end(), color) == vc.end())
+                vc.push_back(color);
+        }
+    }
+
+    // Groups with unknown variables go in an additional color, processed sequentially.
+    sequential_last = has_unknown;
+    int nbuckets = ncolors + (has_unknown ? 1 : 0);
+    for (int ig = 0; ig < ngroups; ig++) {
+        if (group_color[ig] < 0)
+            group_color[ig] = ncolors;
+    }
+
+    // 3) Sort the groups by color (stable, so that the order within a color follows the input order).
+    color_start.assign(nbuckets + 1, 0);
+    for (int ig = 0; ig < ngroups; ig++)
+        color_start[group_color[ig] + 1]++;
+    for (int k = 0; k < nbuckets; k++)
+        color_start[k + 1] += color_start[k];
+
+    std::vector<int> next(color_start.begin(), color_start.end() - 1);
+    std::vector<int> sorted_groups(ngroups);
+    for (int ig = 0; ig < ngroups; ig++)
+        sorted_groups[next[group_color[ig]]++] = ig;
+
+    constraints.clear();
+    group_start.clear();
+    for (int is = 0; is < ngroups; is++) {
+        int ig = sorted_groups[is];
+        group_start.push_back((int)constraints.size());
+        for (int i = gstart[ig]; i < gstart[ig + 1]; i++)
+            constraints.push_back(groups[i]);
+    }
+    group_start.push_back((int)constraints.size());
+}
+
+void ChSolverSORcolored::ProcessGroup(int ig, double& maxviolation, double& maxdeltalambda) {
+    int start = group_start[ig];
+    int size = group_start[ig + 1] - start;
+
+    if (size == 3 && constraints[start]->GetMode() == CONSTRAINT_FRIC) {
+        // Friction triplet (n,u,v): update all three, then project on the friction cone.
+        double old_lambda_friction[3];
+        for (int k = 0; k < 3; k++) {
+            ChConstraint* c = constraints[start + k];
+
+            // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+            double mresidual = c->Compute_Cq_q() + c->Get_b_i() + c->Get_cfm_i() * c->Get_l_i();
+            if (k == 0)
+                maxviolation = ChMax(maxviolation, fabs(ChMin(0.0, mresidual)));
+
+            // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+            double deltal = (omega / c->Get_g_i()) * (-mresidual);
+
+            // update:   lambda += delta_lambda;
+            old_lambda_friction[k] = c->Get_l_i();
+            c->Set_l_i(old_lambda_friction[k] + deltal);
+        }
+
+        constraints[start]->Project();  // the N normal component will take care of N,U,V
+
+        for (int k = 0; k < 3; k++) {
+            ChConstraint* c = constraints[start + k];
+            double new_lambda = c->Get_l_i();
+            // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+            if (this->shlambda != 1.0) {
+                new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda_friction[k];
+                c->Set_l_i(new_lambda);
+            }
+            double true_delta = new_lambda - old_lambda_friction[k];
+            c->Increment_q(true_delta);
+            maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta));
+        }
+        return;
+    }
+
+    for (int i = start; i < start + size; i++) {
+        ChConstraint* c = constraints[i];
+
+        // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+        double mresidual = c->Compute_Cq_q() + c->Get_b_i() + c->Get_cfm_i() * c->Get_l_i();
+
+        // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+        maxviolation = ChMax(maxviolation, fabs(c->Violation(mresidual)));
+
+        // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+        double deltal = (omega / c->Get_g_i()) * (-mresidual);
+
+        // update:   lambda += delta_lambda, and project onto the admissible set
+        double old_lambda = c->Get_l_i();
+        c->Set_l_i(old_lambda + deltal);
+        c->Project();
+        double new_lambda = c->Get_l_i();
+
+        // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+        if (this->shlambda != 1.0) {
+            new_lambda = shlambda * new_lambda + (1.0 - shlambda) * old_lambda;
+            c->Set_l_i(new_lambda);
+        }
+
+        double true_delta = new_lambda - old_lambda;
+        c->Increment_q(true_delta);
+        maxdeltalambda = ChMax(maxdeltalambda, fabs(true_delta));
+    }
+}
+
+double ChSolverSORcolored::Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
+                                 ) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+
+    tot_iterations = 0;
+    double maxviolation = 0.;
+    double maxdeltalambda = 0.;
+
+    // 1)  Update auxiliary data in all constraints before starting,
+    //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+    int nc = (int)mconstraints.size();
+    ChParallelFor(0, nc, 0, [&](int ic) { mconstraints[ic]->Update_auxiliary(); });
+
+    // Average all g_i for the triplet of contact constraints n,u,v.
+    int j_friction_comp = 0;
+    double gi_values[3];
+    for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
+        if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+            gi_values[j_friction_comp] = mconstraints[ic]->Get_g_i();
+            j_friction_comp++;
+            if (j_friction_comp == 3) {
+                double average_g_i = (gi_values[0] + gi_values[1] + gi_values[2]) / 3.0;
+                mconstraints[ic - 2]->Set_g_i(average_g_i);
+                mconstraints[ic - 1]->Set_g_i(average_g_i);
+                mconstraints[ic - 0]->Set_g_i(average_g_i);
+                j_friction_comp = 0;
+            }
+        }
+    }
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system:
+    int nv = (int)mvariables.size();
+    ChParallelFor(0, nv, 0, [&](int iv) {
+        if (mvariables[iv]->IsActive())
+            mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(), mvariables[iv]->Get_fb());  // q = [M]'*fb
+    });
+
+    // 3)  For all items with variables, add the effect of initial (guessed)
+    //     lagrangian reactions of constraints, if a warm start is desired.
+    //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
+    if (warm_start) {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            if (mconstraints[ic]->IsActive())
+                mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+    } else {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            mconstraints[ic]->Set_l_i(0.);
+    }
+
+    // 4)  Partition the constraints in independent sets (only if the constraint pattern changed)
+    ColorConstraints(sysd);
+    int ncolors = (int)color_start.size() - 1;
+
+    if (verbose)
+        GetLog() << "\n-----Colored SOR, " << (int)constraints.size() << " constraints in " << ncolors << " colors\n";
+
+    // 5)  Perform the iteration loops
+    for (int iter = 0; iter < max_iterations; iter++) {
+        maxviolation = 0;
+        maxdeltalambda = 0;
+
+        for (int k = 0; k < ncolors; k++) {
+            int g_start = color_start[k];
+            int g_end = color_start[k + 1];
+
+            // Process small colors (and the set of constraints with unknown variables) sequentially.
+            if ((sequential_last && k == ncolors - 1) || num_threads == 1 || g_end - g_start < 4 * num_threads) {
+                for (int ig = g_start; ig < g_end; ig++)
+                    ProcessGroup(ig, maxviolation, maxdeltalambda);
+                continue;
+            }
+
+            typedef std::pair<double, double> MaxPair;  // max violation, max delta lambda
+            int grain = (g_end - g_start - 1) / num_threads + 1;
+            MaxPair max_color = ChParallelReduce(
+                g_start, g_end, grain, MaxPair(0.0, 0.0),
+                [this](int from, int to, MaxPair chunk) {
+                    for (int ig = from; ig < to; ig++)
+                        ProcessGroup(ig, chunk.first, chunk.second);
+                    return chunk;
+                },
+                [](const MaxPair& a, const MaxPair& b) {
+                    return MaxPair(ChMax(a.first, b.first), ChMax(a.second, b.second));
+                });
+            maxviolation = ChMax(maxviolation, max_color.first);
+            maxdeltalambda = ChMax(maxdeltalambda, max_color.second);
+        }
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        tot_iterations++;
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < tolerance)
+            break;
+    }
+
+    return maxviolation;
+}
+
+}  // end namespace chrono
@@ -0,0 +1,96 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSOLVERSORCOLORED_H
+#define CHSOLVERSORCOLORED_H
+
+#include <vector>
+
+#include "chrono/solver/ChIterativeSolver.h"
+
+namespace chrono {
+
+/// An iterative solver based on projective fixed point method, with overrelaxation
+/// and immediate variable update as in SOR methods. Multi-threaded and deterministic.\n
+/// The constraints are partitioned in 'colors' by greedy coloring of the constraint graph, so that no two
+/// constraints of the same color act on the same (active) variables.
+/// The three constraints of a friction contact (normal, u, v) are kept together. Colors are processed
+/// in sequence, while the constraints within a color are processed in parallel. Since constraints in the
+/// same color are independent, the results do not depend on the number of threads and are the same as
+/// those of a sequential projected Gauss-Seidel that visits the constraints color by color.\n
+/// The coloring is recomputed only when the set of active constraints, or the variables they act on,
+/// changed since the previous call to Solve().\n
+/// Constraints that cannot report their variables (see ChConstraint::CollectVariables) are processed
+/// sequentially, after all colors.\n
+/// See ChSystemDescriptor for more information about the problem formulation and the data structures
+/// passed to the solver.
+
+class ChApi ChSolverSORcolored : public ChIterativeSolver {
+
+  public:
+    ChSolverSORcolored(int nthreads = 2,             ///< number of threads
+                       int mmax_iters = 50,          ///< max.number of iterations
+                       bool mwarm_start = false,     ///< uses warm start?
+                       double mtolerance = 0.0,      ///< tolerance for termination criterion
+                       double momega = 1.0           ///< overrelaxation criterion
+                       )
+        : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega),
+          num_threads(nthreads),
+          sequential_last(false),
+          cached_n_q(-1),
+          num_colorings(0) {}
+
+    virtual ~ChSolverSORcolored() {}
+
+    virtual Type GetType() const override { return Type::SOR_COLORED; }
+
+    /// Performs the solution of the problem.
+    /// \return  the maximum constraint violation after termination.
+    virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
+                         ) override;
+
+    /// Set the number of threads used to process the constraints of each color.
+    void SetNumThreads(int nthreads) { num_threads = (nthreads < 1) ? 1 : nthreads; }
+
+    /// Return the number of threads.
+    int GetNumThreads() const { return num_threads; }
+
+    /// Return the number of colors used in the last call to Solve()
+    /// (including the final sequential set, if not empty).
+    int GetNumColors() const { return (int)color_start.size() - 1; }
+
+    /// Return the number of times the constraint graph was colored so far.
+    int GetNumColorings() const { return num_colorings; }
+
+  private:
+    /// Build the constraint groups (single constraints or friction triplets) and color them.
+    void ColorConstraints(ChSystemDescriptor& sysd);
+
+    /// Perform one projected Gauss-Seidel update for the specified group.
+    void ProcessGroup(int ig, double& maxviolation, double& maxdeltalambda);
+
+    int num_threads;
+
+    std::vector<ChConstraint*> constraints;  ///< active constraints, ordered by color
+    std::vector<int> group_start;            ///< offsets of the groups in 'constraints' (plus end marker)
+    std::vector<int> color_start;            ///< offsets of the colors in the list of groups (plus end marker)
+    bool sequential_last;                    ///< true if the last color must be processed sequentially
+
+    int cached_n_q;                             ///< number of active variables at the last coloring
+    std::vector<ChConstraint*> cached_ordered;  ///< active constraints (input order) at the last coloring
+    std::vector<int> cached_pattern;            ///< variable offsets of each group at the last coloring
+    int num_colorings;                          ///< number of colorings performed
+};
+
+}  // end namespace chrono
+
+#endif
@@ -14,6 +14,7 @@
 
 #include <cstdio>
 
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/parallel/ChThreadsSync.h"
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
 #include "chrono/solver/ChConstraintTwoTuplesRollingN.h"
@@ -47,23 +48,15 @@ struct thread_data {
     std::vector<ChVariables*>* mvariables;
 };
 
-// Don't create local store memory, just return 0
-
-void* SolverMemoryFunc() {
-    return 0;
-}
-
 // The following is the function which will be executed by
-// each thread, when threads are launched at each Solve()
+// each task, at each stage of Solve()
 
-void SolverThreadFunc(void* userPtr, void* lsMemory) {
+static void SolverThreadFunc(thread_data* tdata) {
     double maxviolation = 0.;
     double maxdeltalambda = 0.;
     int i_friction_comp = 0;
     double old_lambda_friction[3];
 
-    thread_data* tdata = (thread_data*)userPtr;
-
     std::vector<ChConstraint*>* mconstraints = tdata->mconstraints;
     std::vector<ChVariables*>* mvariables = tdata->mvariables;
 
@@ -248,34 +241,18 @@ void SolverThreadFunc(void* userPtr, void* lsMemory) {
     }  // end stage  switching
 }
 
-// When the solver object is created, threads are also
-// created and initialized, in 'wait' mode.
-
 ChSolverSORmultithread::ChSolverSORmultithread(const char* uniquename,
                                                int nthreads,
                                                int mmax_iters,
                                                bool mwarm_start,
                                                double mtolerance,
                                                double momega)
-    : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega) {
-    ChThreadConstructionInfo create_args(uniquename, SolverThreadFunc, SolverMemoryFunc, nthreads);
-
-    solver_threads = new ChThreads(create_args);
-}
-
-ChSolverSORmultithread::~ChSolverSORmultithread() {
-    if (solver_threads) {
-        solver_threads->flush();
-        delete (solver_threads);
-        solver_threads = 0;
-    }
-}
+    : ChIterativeSolver(mmax_iters, mwarm_start, mtolerance, momega), num_threads(nthreads < 1 ? 1 : nthreads) {}
 
 // The SOR solver process has been modified so that some
 // parallelizable code has been moved to the SolverThreadFunc().
-// So, the N threads must be started (each executing SolverThreadFunc() )
-// and, after waiting for all them to be completed, with flush(), the
-// solution is done.
+// So, N tasks are spawned (each executing SolverThreadFunc() on its slice)
+// and, after waiting for all them to be completed, the next stage starts.
 
 double ChSolverSORmultithread::Solve(
     ChSystemDescriptor& sysd  ///< system description with constraints and variables
@@ -295,7 +272,7 @@ double ChSolverSORmultithread::Solve(
     // --0--  preparation:
     //        subdivide the workload to the threads and prepare their 'thread_data':
 
-    int numthreads = this->solver_threads->getNumberOfThreads();
+    int numthreads = this->num_threads;
     std::vector<thread_data> mdataN(numthreads);
 
     int var_slice = 0;
@@ -335,32 +312,25 @@ double ChSolverSORmultithread::Solve(
 
     // LAUNCH THE PARALLEL COMPUTATION ON THREADS !!!!
 
+    thread_data::solver_stage stages[3] = {thread_data::STAGE1_PREPARE, thread_data::STAGE2_ADDFORCES,
+                                           thread_data::STAGE3_LOOPCONSTRAINTS};
+
     // --1--  stage:
     //        precompute aux variables in constraints.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE1_PREPARE;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
-
     // --2--  stage:
     //        add external forces and mass effects, on variables.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE2_ADDFORCES;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
-    }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
-
     // --3--  stage:
     //        loop on constraints.
-    for (int nth = 0; nth < numthreads; nth++) {
-        mdataN[nth].stage = thread_data::STAGE3_LOOPCONSTRAINTS;
-        solver_threads->sendRequest(1, &mdataN[nth], nth);
+    for (int istage = 0; istage < 3; istage++) {
+        ChTaskGroup stage_tasks;
+        for (int nth = 0; nth < numthreads; nth++) {
+            mdataN[nth].stage = stages[istage];
+            thread_data* tdata = &mdataN[nth];
+            stage_tasks.Run([tdata]() { SolverThreadFunc(tdata); });
+        }
+        //... must wait that the all the tasks finished their stage!!!
+        stage_tasks.Wait();
     }
-    //... must wait that the all the threads finished their stage!!!
-    solver_threads->flush();
 
     return 0;
 }
@@ -369,16 +339,7 @@ void ChSolverSORmultithread::ChangeNumberOfThreads(int mthreads) {
     if (mthreads < 1)
         mthreads = 1;
 
-    char mname[100];
-    strncpy(mname, solver_threads->getUniqueName().c_str(), sizeof(mname)-1);
-
-    solver_threads->flush();
-    delete (solver_threads);
-    solver_threads = 0;
-
-    ChThreadConstructionInfo create_args(mname, SolverThreadFunc, SolverMemoryFunc, mthreads);
-
-    solver_threads = new ChThreads(create_args);
+    num_threads = mthreads;
 }
 
 } // end namespace chrono
@@ -10,13 +10,87 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <atomic>
+
 #include "chrono/solver/ChSystemDescriptor.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
 #include "chrono/solver/ChConstraintTwoTuplesFrictionT.h"
+#include "chrono/core/ChCSMatrix.h"
 #include "chrono/core/ChLinkedListMatrix.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 
 namespace chrono {
 
+/// Cached scatter map for the assembly of the system matrix into a ChCSMatrix (see
+/// ChSystemDescriptor::SetUseScatterMaps). The 'items' are the active variables, the stiffness blocks and
+/// the active constraints, in this order; each of them sets a fixed sequence of elements (entries).
+struct ChScatterMap {
+    std::vector<ChVariables*> variables;    ///< active variables
+    std::vector<int> variable_offsets;      ///< offset of each active variable
+    std::vector<ChConstraint*> constraints;  ///< active constraints
+
+    int dim = 0;                   ///< size of the recorded matrix
+    bool recorded = false;         ///< the entries have been recorded
+    bool mapped = false;           ///< the entries have been mapped to the CSR value array
+    std::vector<int> item_start;   ///< offsets of the entries of each item (plus end marker)
+    std::vector<int> rows;         ///< row of each entry
+    std::vector<int> cols;         ///< column of each entry
+    std::vector<char> overwrite;   ///< overwrite flag of each entry
+    std::vector<double> values;    ///< value of each entry
+
+    std::vector<int> lead_index;    ///< copy of the CSR leading index array at mapping time
+    std::vector<int> trail_index;   ///< copy of the CSR trailing index array at mapping time
+    std::vector<int> gather_start;  ///< offsets in 'gather' for each CSR value (plus end marker)
+    std::vector<int> gather;        ///< entries grouped by CSR value, in insertion order
+};
+
+namespace {
+
+// Sparse matrix used as a sink by the cached assembly. When recording, it appends the position, value and
+// overwrite flag of each element to the scatter map. When replaying an item, it stores only the values in
+// the slots recorded for that item, and flags any difference in the sequence of positions.
+class ChScatterSink final : public ChSparseMatrix {
+  public:
+    ChScatterSink(ChScatterMap& map, int dim, bool recording)
+        : ChSparseMatrix(dim, dim), map(map), recording(recording), cursor(0), end(0), mismatch(false) {}
+
+    void BeginItem(int item) {
+        cursor = map.item_start[item];
+        end = map.item_start[item + 1];
+    }
+    bool EndItem() const { return !mismatch && cursor == end; }
+
+    virtual void SetElement(int insrow, int inscol, double insval, bool overwrite = true) override {
+        if (recording) {
+            map.rows.push_back(insrow);
+            map.cols.push_back(inscol);
+            map.overwrite.push_back(overwrite);
+            map.values.push_back(insval);
+            return;
+        }
+        if (cursor >= end || map.rows[cursor] != insrow || map.cols[cursor] != inscol ||
+            (map.overwrite[cursor] != 0) != overwrite) {
+            mismatch = true;
+            return;
+        }
+        map.values[cursor++] = insval;
+    }
+
+    virtual double GetElement(int row, int col) const override { return 0; }
+    virtual void Reset(int row, int col, int nonzeros = 0) override {}
+    virtual bool Resize(int nrows, int ncols, int nonzeros = 0) override { return false; }
+
+  private:
+    ChScatterMap& map;
+    bool recording;
+    int cursor;
+    int end;
+    bool mismatch;
+};
+
+}  // end anonymous namespace
+
 // Register into the object factory, to enable run-time
 // dynamic creation and persistence
 CH_FACTORY_REGISTER(ChSystemDescriptor)
@@ -34,7 +108,10 @@ ChSystemDescriptor::ChSystemDescriptor() {
     n_c = 0;
     freeze_count = false;
 
-    this->num_threads = CHOMPfunctions::GetNumProcs();
+    use_scatter_maps = true;
+
+    this->num_threads = 1;
+    this->parallel_threshold = 10000;
 
     spinlocktable = new ChSpinlock[CH_SPINLOCK_HASHSIZE];
 }
@@ -217,7 +294,12 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Z, ChMatrix<>* rhs)
     n_q = this->CountActiveVariables();
 
    
-	if (Z)
+	ChCSMatrix* Z_cs = use_scatter_maps ? dynamic_cast<ChCSMatrix*>(Z) : nullptr;
+	if (Z_cs && Z_cs->IsSparsityPatternLocked())
+	{
+		ConvertToMatrixFormScatter(*Z_cs, mn_c);
+	}
+	else if (Z)
 	{
 		Z->Reset(n_q + mn_c, n_q + mn_c);
 
@@ -283,6 +365,148 @@ void ChSystemDescriptor::ConvertToMatrixForm(ChSparseMatrix* Z, ChMatrix<>* rhs)
 
 }
 
+void ChSystemDescriptor::ConvertToMatrixFormScatter(ChCSMatrix& Z, int mn_c) {
+    if (!scatter_map)
+        scatter_map = std::unique_ptr<ChScatterMap>(new ChScatterMap);
+    ChScatterMap& map = *scatter_map;
+
+    // Collect the items.
+    map.variables.clear();
+    map.variable_offsets.clear();
+    int s_q = 0;
+    for (auto var : vvariables) {
+        if (var->IsActive()) {
+            map.variables.push_back(var);
+            map.variable_offsets.push_back(s_q);
+            s_q += var->Get_ndof();
+        }
+    }
+    map.constraints.clear();
+    for (auto constr : vconstraints) {
+        if (constr->IsActive())
+            map.constraints.push_back(constr);
+    }
+
+    int dim = n_q + mn_c;
+    int nv = (int)map.variables.size();
+    int nk = (int)vstiffness.size();
+    int nitems = nv + nk + (int)map.constraints.size();
+
+    // Same calls as in the plain assembly, item by item.
+    auto build_item = [&](int item, ChSparseMatrix& sink) {
+        if (item < nv) {
+            map.variables[item]->Build_M(sink, map.variable_offsets[item], map.variable_offsets[item], c_a);
+        } else if (item < nv + nk) {
+            vstiffness[item - nv]->Build_K(sink, true);
+        } else {
+            int s_c = item - nv - nk;
+            ChConstraint* constr = map.constraints[s_c];
+            constr->Build_Cq(sink, n_q + s_c);
+            constr->Build_CqT(sink, n_q + s_c);
+            sink.SetElement(n_q + s_c, n_q + s_c, constr->Get_cfm_i());
+        }
+    };
+
+    bool replay = map.recorded && map.dim == dim && (int)map.item_start.size() == nitems + 1 && Z.IsCompressed() &&
+                  Z.GetNumRows() == dim && Z.GetNumColumns() == dim;
+
+    const int* lead_index = replay ? Z.GetCS_LeadingIndexArray() : nullptr;
+    const int* trail_index = replay ? Z.GetCS_TrailingIndexArray() : nullptr;
+    int nnz = replay ? Z.GetTrailingIndexLength() : 0;
+
+    // Check that the pattern of Z did not change since the entries were mapped.
+    if (replay && map.mapped) {
+        replay = (int)map.trail_index.size() == nnz &&
+                 std::equal(map.lead_index.begin(), map.lead_index.end(), lead_index) &&
+                 std::equal(map.trail_index.begin(), map.trail_index.end(), trail_index);
+    }
+
+    // Map the recorded entries to the CSR value array, at the first call after the recording.
+    if (replay && !map.mapped) {
+        int nentries = (int)map.rows.size();
+        std::vector<int> value_index(nentries);
+        for (int e = 0; e < nentries && replay; e++) {
+            int lead = Z.IsRowMajor() ? map.rows[e] : map.cols[e];
+            int trail = Z.IsRowMajor() ? map.cols[e] : map.rows[e];
+            const int* first = trail_index + lead_index[lead];
+            const int* last = trail_index + lead_index[lead + 1];
+            const int* pos = std::lower_bound(first, last, trail);
+            if (pos == last || *pos != trail)
+                replay = false;
+            else
+                value_index[e] = (int)(pos - trail_index);
+        }
+
+        if (replay) {
+            map.gather_start.assign(nnz + 1, 0);
+            for (int e = 0; e < nentries; e++)
+                map.gather_start[value_index[e] + 1]++;
+            for (int k = 0; k < nnz; k++)
+                map.gather_start[k + 1] += map.gather_start[k];
+            map.gather.resize(nentries);
+            std::vector<int> fill(map.gather_start.begin(), map.gather_start.end() - 1);
+            for (int e = 0; e < nentries; e++)
+                map.gather[fill[value_index[e]]++] = e;
+
+            map.lead_index.assign(lead_index, lead_index + dim + 1);
+            map.trail_index.assign(trail_index, trail_index + nnz);
+            map.mapped = true;
+        }
+    }
+
+    if (replay) {
+        // Compute the values of the entries, in parallel over the items.
+        std::atomic<bool> mismatch(false);
+        ChParallelForRange(0, nitems, 128, [&](int from, int to) {
+            ChScatterSink sink(map, dim, false);
+            for (int item = from; item < to; item++) {
+                sink.BeginItem(item);
+                build_item(item, sink);
+                if (!sink.EndItem()) {
+                    mismatch = true;
+                    return;
+                }
+            }
+        });
+
+        // Gather them in the CSR value array, in parallel over the values. The entries of each value are
+        // processed in insertion order, so the result is the same as with the plain assembly.
+        if (!mismatch) {
+            double* values = Z.GetCS_ValueArray();
+            ChParallelFor(0, nnz, 1024, [&](int k) {
+                double value = 0;
+                for (int j = map.gather_start[k]; j < map.gather_start[k + 1]; j++) {
+                    int e = map.gather[j];
+                    value = map.overwrite[e] ? map.values[e] : value + map.values[e];
+                }
+                values[k] = value;
+            });
+            return;
+        }
+    }
+
+    // Record the entries of all the items and assemble Z with them.
+    map.recorded = false;
+    map.mapped = false;
+    map.item_start.clear();
+    map.rows.clear();
+    map.cols.clear();
+    map.overwrite.clear();
+    map.values.clear();
+
+    ChScatterSink recorder(map, dim, true);
+    for (int item = 0; item < nitems; item++) {
+        map.item_start.push_back((int)map.rows.size());
+        build_item(item, recorder);
+    }
+    map.item_start.push_back((int)map.rows.size());
+    map.dim = dim;
+    map.recorded = true;
+
+    Z.Reset(dim, dim);
+    for (size_t e = 0; e < map.rows.size(); e++)
+        Z.SetElement(map.rows[e], map.cols[e], map.values[e], map.overwrite[e] != 0);
+}
 
 void ChSystemDescriptor::DumpLastMatrices(bool assembled, const char* path) {
     char filename[300];
@@ -547,6 +771,11 @@ void ChSystemDescriptor::ShurComplementProduct(ChMatrix<>& result, ChMatrix<>* l
     assert(lvector->GetRows() == CountActiveConstraints());
     assert(lvector->GetColumns() == 1);
 
+    if (UseParallelProducts()) {
+        ShurComplementProductParallel(result, lvector, enabled);
+        return;
+    }
+
     result.Reset(n_c, 1);  // fast! Reset() method does not realloc if size doesn't change
 
 // Performs the sparse product    result = [N]*l = [ [Cq][M^(-1)][Cq'] - [E] ] *l
@@ -636,23 +865,30 @@ void ChSystemDescriptor::SystemProduct(
 
     result.Reset(n_q + n_c, 1);  // fast! Reset() method does not realloc if size doesn't change
 
+    if (UseParallelProducts()) {
+        SystemProductParallel(result, *vect);
+        if (x_ql)
+            delete x_ql;
+        return;
+    }
+
 // 1) First row: result.q part =  [M + K]*x.q + [Cq']*x.l
 
 // 1.1)  do  M*x.q
     for (int iv = 0; iv < (int)vvariables.size(); iv++)
         if (vvariables[iv]->IsActive()) {
-            vvariables[iv]->MultiplyAndAdd(result, *x, this->c_a);
+            vvariables[iv]->MultiplyAndAdd(result, *vect, this->c_a);
         }
 
     // 1.2)  add also K*x.q  (NON straight parallelizable - risk of concurrency in writing)
     for (int ik = 0; ik < (int)vstiffness.size(); ik++) {
-        vstiffness[ik]->MultiplyAndAdd(result, *x);
+        vstiffness[ik]->MultiplyAndAdd(result, *vect);
     }
 
     // 1.3)  add also [Cq]'*x.l  (NON straight parallelizable - risk of concurrency in writing)
     for (int ic = 0; ic < (int)vconstraints.size(); ic++) {
         if (vconstraints[ic]->IsActive()) {
-            vconstraints[ic]->MultiplyTandAdd(result, (*x)(vconstraints[ic]->GetOffset() + n_q));
+            vconstraints[ic]->MultiplyTandAdd(result, (*vect)(vconstraints[ic]->GetOffset() + n_q));
         }
     }
 
@@ -660,8 +896,8 @@ void ChSystemDescriptor::SystemProduct(
     for (int ic = 0; ic < (int)vconstraints.size(); ic++) {
         if (vconstraints[ic]->IsActive()) {
             int s_c = vconstraints[ic]->GetOffset() + n_q;
-            vconstraints[ic]->MultiplyAndAdd(result(s_c), (*x));       // result.l_i += [C_q_i]*x.q
-            result(s_c) -= vconstraints[ic]->Get_cfm_i() * (*x)(s_c);  // result.l_i += [E]*x.l_i  NOTE:  cfm = -E
+            vconstraints[ic]->MultiplyAndAdd(result(s_c), (*vect));       // result.l_i += [C_q_i]*x.q
+            result(s_c) -= vconstraints[ic]->Get_cfm_i() * (*vect)(s_c);  // result.l_i += [E]*x.l_i  NOTE:  cfm = -E
         }
     }
 
@@ -670,6 +906,127 @@ void ChSystemDescriptor::SystemProduct(
         delete x_ql;
 }
 
+void ChSystemDescriptor::AccumulateParallel(ChMatrix<>& result,
+                                            const ChMatrix<>* x,
+                                            const ChMatrix<>& l,
+                                            int l_offset,
+                                            std::vector<bool>* enabled) {
+    // The scatter into q may hit the same entries from different constraints (or stiffness blocks).
+    // To avoid race conditions, and to get results that do not depend on thread scheduling nor on the
+    // number of threads, items are split into a fixed number of contiguous chunks, each accumulating into
+    // its own buffer.
+    int nchunks = num_parallel_chunks;
+    int nk = x ? (int)vstiffness.size() : 0;
+    int nc = (int)vconstraints.size();
+
+    if ((int)q_accumulators.size() != nchunks)
+        q_accumulators.resize(nchunks);
+
+    ChParallelFor(0, nchunks, 1, [&](int ichunk) {
+        ChMatrixDynamic<>& buffer = q_accumulators[ichunk];
+        buffer.Reset(n_q, 1);
+
+        int k_start = (int)(((long long)nk * ichunk) / nchunks);
+        int k_end = (int)(((long long)nk * (ichunk + 1)) / nchunks);
+        for (int ik = k_start; ik < k_end; ik++) {
+            vstiffness[ik]->MultiplyAndAdd(buffer, *x);
+        }
+
+        int c_start = (int)(((long long)nc * ichunk) / nchunks);
+        int c_end = (int)(((long long)nc * (ichunk + 1)) / nchunks);
+        for (int ic = c_start; ic < c_end; ic++) {
+            if (vconstraints[ic]->IsActive()) {
+                int s_c = vconstraints[ic]->GetOffset();
+                if (enabled && (*enabled)[s_c] == false)
+                    continue;
+                vconstraints[ic]->MultiplyTandAdd(buffer, l(l_offset + s_c));
+            }
+        }
+    });
+
+    // Reduce the buffers, always in the same order.
+    ChParallelFor(0, n_q, 0, [&](int i) {
+        double sum = 0;
+        for (int ichunk = 0; ichunk < nchunks; ichunk++)
+            sum += q_accumulators[ichunk].ElementN(i);
+        result.ElementN(i) += sum;
+    });
+}
+
+void ChSystemDescriptor::ShurComplementProductParallel(ChMatrix<>& result,
+                                                       ChMatrix<>* lvector,
+                                                       std::vector<bool>* enabled) {
+    n_q = this->CountActiveVariables();
+    n_c = this->CountActiveConstraints();
+
+    result.Reset(n_c, 1);
+
+    // Multipliers: either the provided vector, or the current l_i in the constraints.
+    ChMatrixDynamic<> l_current;
+    if (!lvector) {
+        l_current.Reset(n_c, 1);
+        this->FromConstraintsToVector(l_current, false);
+    }
+    const ChMatrix<>& l = lvector ? *lvector : l_current;
+
+    // 1 - compute  Cq'*l, without the mass matrix, by thread-local accumulation.
+    //     Instead of  qb += [M^(-1)][Cq']*l_i  for each constraint (as in the serial version, that
+    //     uses the precomputed Eq_i), here  qb = [M^(-1)]*([Cq']*l)  is computed per variable.
+    ChMatrixDynamic<> Cql(n_q, 1);
+    AccumulateParallel(Cql, nullptr, l, 0, enabled);
+
+    // 2 - performs  qb = [M^(-1)]*[Cq']*l  for each variable (no concurrent writes)
+    int nv = (int)vvariables.size();
+    ChParallelForRange(0, nv, 0, [&](int iv_from, int iv_to) {
+        ChMatrixDynamic<> vect;
+        for (int iv = iv_from; iv < iv_to; iv++) {
+            if (vvariables[iv]->IsActive()) {
+                int ndof = vvariables[iv]->Get_ndof();
+                vect.Reset(ndof, 1);
+                vect.PasteClippedMatrix(Cql, vvariables[iv]->GetOffset(), 0, ndof, 1, 0, 0);
+                vvariables[iv]->Compute_invMb_v(vvariables[iv]->Get_qb(), vect);
+            }
+        }
+    });
+
+    // 3 - performs  result = [Cq]*qb - [E]*l  for each constraint (no concurrent writes)
+    int nc = (int)vconstraints.size();
+    ChParallelFor(0, nc, 0, [&](int ic) {
+        if (vconstraints[ic]->IsActive()) {
+            int s_c = vconstraints[ic]->GetOffset();
+            if (enabled && (*enabled)[s_c] == false) {
+                result(s_c, 0) = 0;  // not enabled constraints, just set to 0 result
+                return;
+            }
+            result(s_c, 0) = vconstraints[ic]->Get_cfm_i() * l(s_c, 0) + vconstraints[ic]->Compute_Cq_q();
+        }
+    });
+}
+
+void ChSystemDescriptor::SystemProductParallel(ChMatrix<>& result, ChMatrix<>& x) {
+    // 1) First row: result.q part =  [M + K]*x.q + [Cq']*x.l
+
+    // 1.1)  do  M*x.q  (each variable writes only its own rows)
+    int nv = (int)vvariables.size();
+    ChParallelFor(0, nv, 0, [&](int iv) {
+        if (vvariables[iv]->IsActive())
+            vvariables[iv]->MultiplyAndAdd(result, x, this->c_a);
+    });
+
+    // 1.2)  add also K*x.q and [Cq]'*x.l  (thread-local accumulation)
+    AccumulateParallel(result, &x, x, n_q, nullptr);
+
+    // 2) Second row: result.l part =  [C_q]*x.q + [E]*x.l  (each constraint writes only its own row)
+    int nc = (int)vconstraints.size();
+    ChParallelFor(0, nc, 0, [&](int ic) {
+        if (vconstraints[ic]->IsActive()) {
+            int s_c = vconstraints[ic]->GetOffset() + n_q;
+            vconstraints[ic]->MultiplyAndAdd(result(s_c), x);  // result.l_i += [C_q_i]*x.q
+            result(s_c) -= vconstraints[ic]->Get_cfm_i() * x(s_c);  // result.l_i += [E]*x.l_i  NOTE:  cfm = -E
+        }
+    });
+}
+
 void ChSystemDescriptor::ConstraintsProject(
     ChMatrix<>& multipliers  ///< matrix which contains the entire vector of 'l_i' multipliers to be projected
     ) {
@@ -711,6 +1068,10 @@ void ChSystemDescriptor::UnknownsProject(
     }
 }
 
+bool ChSystemDescriptor::UseParallelProducts() const {
+    return num_threads > 1 && n_q + n_c >= parallel_threshold;
+}
+
 void ChSystemDescriptor::SetNumThreads(int nthreads) {
     if (nthreads == this->num_threads)
         return;
@@ -13,15 +13,20 @@
 #ifndef CHSYSTEMDESCRIPTOR_H
 #define CHSYSTEMDESCRIPTOR_H
 
+#include <memory>
 #include <vector>
 
-#include "chrono/parallel/ChOpenMP.h"
 #include "chrono/parallel/ChThreadsSync.h"
 #include "chrono/solver/ChConstraint.h"
 #include "chrono/solver/ChKblock.h"
 #include "chrono/solver/ChVariables.h"
 
 namespace chrono {
+
+// Forward references
+class ChCSMatrix;
+struct ChScatterMap;
+
 /// Base class for collecting objects inherited from ChConstraint,
 /// ChVariables and optionally ChKblock. These objects
 /// can be used to define a sparse representation of the system.
@@ -79,9 +84,17 @@ class ChApi ChSystemDescriptor {
     std::vector<ChKblock*> vstiffness;        ///< list of pointers to all the ChKblock in the current Chrono system
 
     int num_threads;
+    int parallel_threshold;  ///< minimum number of unknowns for running the products in parallel
+
+    /// Number of chunks in which stiffness blocks and constraints are split by the parallel products.
+    /// This is fixed (i.e. it does not depend on the number of threads), so that the results do not depend
+    /// on the number of threads either.
+    static const int num_parallel_chunks = 8;
 
     ChSpinlock* spinlocktable;
 
+    std::vector<ChMatrixDynamic<double>> q_accumulators;  ///< per-chunk buffers for parallel scatter into q
+
     double c_a;  // coefficient form M mass matrices in vvariables
 
   private:
@@ -89,6 +102,33 @@ class ChApi ChSystemDescriptor {
     int n_c;            ///< number of active constraints
     bool freeze_count;  ///< for optimization: avoid to re-count the number of active variables and constraints
 
+    bool use_scatter_maps;                     ///< use cached scatter maps when assembling into a ChCSMatrix
+    std::unique_ptr<ChScatterMap> scatter_map;  ///< cached scatter map (see SetUseScatterMaps)
+
+    /// Assemble the system matrix into a ChCSMatrix with locked sparsity pattern, using (and updating)
+    /// the cached scatter map.
+    void ConvertToMatrixFormScatter(ChCSMatrix& Z, int mn_c);
+
+    /// Return true if the parallel implementations of the products are used (more than one thread, and
+    /// a problem size above the threshold).
+    bool UseParallelProducts() const;
+
+    /// Parallel implementation of ShurComplementProduct(), used if more than one thread is set.
+    void ShurComplementProductParallel(ChMatrix<>& result, ChMatrix<>* lvector, std::vector<bool>* enabled);
+
+    /// Parallel implementation of SystemProduct(), used if more than one thread is set.
+    void SystemProductParallel(ChMatrix<>& result, ChMatrix<>& x);
+
+    /// Accumulate, in parallel, [K]*x.q + [Cq']*l into the first n_q rows of 'result' (which is not reset).
+    /// The multiplier of the constraint with offset i is l(l_offset + i). If x is null, stiffness blocks are
+    /// skipped. Stiffness blocks and constraints are split into a fixed number of chunks, each scattering
+    /// into its own buffer; the buffers are then summed in chunk order.
+    void AccumulateParallel(ChMatrix<>& result,
+                            const ChMatrix<>* x,
+                            const ChMatrix<>& l,
+                            int l_offset,
+                            std::vector<bool>* enabled);
+
   public:
     /// Constructor
     ChSystemDescriptor();
@@ -323,10 +363,20 @@ class ChApi ChSystemDescriptor {
 
     /// Set the number of threads (some operations like ShurComplementProduct
     /// are CPU intensive, so they can be run in parallel threads).
-    /// By default, the number of threads is the same of max.available OpenMP cores
+    /// By default, a descriptor uses 1 thread (note that ChSystem sets it to its own number of threads).
+    /// ShurComplementProduct() and SystemProduct() run in parallel if more than one thread is set and
+    /// the problem is large enough (see SetParallelThreshold). The results of the parallel products are
+    /// bitwise identical for any number of threads, and equal to the serial ones up to round-off errors
+    /// (the terms are summed in a different order).
     virtual void SetNumThreads(int nthreads);
     virtual int GetNumThreads() { return this->num_threads; }
 
+    /// Set the minimum number of unknowns (active variables plus constraints) for which ShurComplementProduct()
+    /// and SystemProduct() run in parallel (default: 10000). For smaller problems, the overhead of the
+    /// parallel products (one accumulation buffer per chunk) exceeds their benefit.
+    void SetParallelThreshold(int n) { parallel_threshold = n; }
+    int GetParallelThreshold() const { return parallel_threshold; }
+
     //
     // LOGGING/OUTPUT/ETC.
     //
@@ -354,10 +404,24 @@ class ChApi ChSystemDescriptor {
     );
 
     /// Create and return the assembled system matrix and RHS vector.
+    /// If Z is a ChCSMatrix with locked sparsity pattern, the assembly uses a cached scatter map
+    /// (see SetUseScatterMaps).
     virtual void ConvertToMatrixForm(ChSparseMatrix* Z,  ///< [out] assembled system matrix
                                      ChMatrix<>* rhs     ///< [out] assembled RHS vector
     );
 
+    /// Enable/disable the use of cached scatter maps in ConvertToMatrixForm(Z, rhs) (default: true).
+    /// Only used when Z is a ChCSMatrix with locked sparsity pattern, as with direct solvers.
+    /// A first call records the sequence of elements set by variables, stiffness blocks and constraints;
+    /// the next call maps each of them to its index in the CSR value array of Z. From then on, as long as
+    /// neither the structure of the problem nor the pattern of Z change, the values are computed by the
+    /// items in parallel and scattered directly into the value array, with no searching in Z.
+    /// Any change is detected, and the scatter map is recorded again.
+    void SetUseScatterMaps(bool val) { use_scatter_maps = val; }
+
+    /// Return true if cached scatter maps are used in ConvertToMatrixForm(Z, rhs).
+    bool GetUseScatterMaps() const { return use_scatter_maps; }
+
     /// Saves to disk the LAST used matrices of the problem.
     /// If assembled == true,
     ///    dump_Z.dat   has the assembled optimization matrix (Matlab sparse format)
@@ -89,6 +89,12 @@ void ChIntegrableIIorder::StateIncrementX(ChState& x_new,         // resulting x
     }
 }
 
+void ChIntegrableIIorder::LoadLumpedMass_Md(ChVectorDynamic<>& Md, const double c, bool hrz) {
+    ChVectorDynamic<> ones(GetNcoords_v());
+    ones.FillElem(1);
+    LoadResidual_Mv(Md, ones, c);
+}
+
 void ChIntegrableIIorder::StateGather(ChState& y, double& T)  {
     ChState mx(GetNcoords_x(), y.GetIntegrable());
     ChStateDelta mv(GetNcoords_v(), y.GetIntegrable());
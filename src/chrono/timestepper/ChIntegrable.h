@@ -337,6 +337,21 @@ class ChApi ChIntegrableIIorder : public ChIntegrable {
         throw ChException("LoadResidual_Mv() not implemented, implicit integrators cannot be used. ");
     };
 
+    /// Assuming   M*a = F(x,v,t) + Cq'*L
+    /// increment a vector Md with the diagonal of a lumped approximation of the mass matrix M:
+    ///    Md += c*diag(M_lumped)
+    /// If hrz is true, the items that support it (i.e. finite elements) use the HRZ (Hinton-Rock-Zienkiewicz)
+    /// lumping, otherwise the rows of their mass matrix are summed.
+    /// This default implementation sums the rows of M, using LoadResidual_Mv().
+    virtual void LoadLumpedMass_Md(ChVectorDynamic<>& Md,  ///< result: Md += c*diag(M_lumped)
+                                   const double c,         ///< a scaling factor
+                                   bool hrz = false        ///< use HRZ lumping, where supported
+                                   );
+
+    /// Return an estimate of the largest stable step for the explicit integration with a lumped mass
+    /// (see ChTimestepperCentralDifference), or 0 if no estimate is available.
+    virtual double GetStableTimeStep() { return 0; }
+
     /// Assuming   M*a = F(x,v,t) + Cq'*L
     ///         C(x,t) = 0
     /// increment a vectorR (usually the residual in a Newton Raphson iteration
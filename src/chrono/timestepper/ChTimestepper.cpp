@@ -12,6 +12,7 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 
 #include "chrono/timestepper/ChTimestepper.h"
@@ -36,6 +37,9 @@ class my_enum_mappers : public ChTimestepper {
     CH_ENUM_VAL(Type::EULER_EXPLICIT);
     CH_ENUM_VAL(Type::LEAPFROG);
     CH_ENUM_VAL(Type::NEWMARK);
+    CH_ENUM_VAL(Type::CENTRAL_DIFFERENCE);
+    CH_ENUM_VAL(Type::DORMAND_PRINCE);
+    CH_ENUM_VAL(Type::RUNGE_KUTTA_NYSTROM);
     CH_ENUM_VAL(Type::CUSTOM);
     CH_ENUM_MAPPER_END(Type);
 };
@@ -65,6 +69,115 @@ void ChTimestepper::ArchiveIN(ChArchiveIn& marchive) {
     marchive >> CHNVP(Qc_do_clamp);
     marchive >> CHNVP(Qc_clamping);
 }
+
+// -----------------------------------------------------------------------------
+
+void ChImplicitIterativeTimestepper::BeginNewtonIteration(ChIntegrableIIorder* integrable) {
+    last_norm = 0;
+
+    // Secant information does not carry over to the nonlinear problem of a new step.
+    broyden_steps.clear();
+    broyden_norms.clear();
+
+    // The Newton matrix cannot be reused if the problem size changed.
+    if (integrable->GetNcoords_v() != matrix_nv || integrable->GetNconstr() != matrix_nc)
+        matrix_valid = false;
+}
+
+bool ChImplicitIterativeTimestepper::SolveCorrection(ChIntegrableIIorder* integrable,
+                                                     ChStateDelta& Dv,
+                                                     ChVectorDynamic<>& Dl,
+                                                     const ChVectorDynamic<>& R,
+                                                     const ChVectorDynamic<>& Qc,
+                                                     const double c_a,
+                                                     const double c_v,
+                                                     const double c_x,
+                                                     const ChState& x,
+                                                     const ChStateDelta& v,
+                                                     const double T,
+                                                     bool setup) {
+    if (jacobian_reuse)
+        setup = !matrix_valid || matrix_refresh || c_a != matrix_ca || c_v != matrix_cv || c_x != matrix_cx;
+
+    bool success = integrable->StateSolveCorrection(Dv, Dl, R, Qc, c_a, c_v, c_x, x, v, T, false, setup);
+
+    numsolves++;
+    if (setup) {
+        numsetups++;
+        total_setups++;
+        matrix_valid = success;
+        matrix_refresh = false;
+        matrix_ca = c_a;
+        matrix_cv = c_v;
+        matrix_cx = c_x;
+        matrix_nv = Dv.GetRows();
+        matrix_nc = Dl.GetRows();
+        broyden_steps.clear();
+        broyden_norms.clear();
+    } else if (jacobian_reuse) {
+        numsetups_avoided++;
+        total_setups_avoided++;
+    }
+
+    if (!success || !jacobian_reuse)
+        return success;
+
+    // Broyden update, in the inverse form of Kelley ("Iterative methods for linear and nonlinear equations"):
+    // with z = H0*r the correction given by the factorized matrix and s_0..s_n the previous corrections,
+    //   z += s_(j+1) * (s_j'*z) / |s_j|^2   for j = 0..n-1
+    //   s_(n+1) = z / (1 - s_n'*z / |s_n|^2)
+    // The corrections are taken in the space of the unknowns (Dv, Dl) of the linear system.
+    if (broyden) {
+        int nv = Dv.GetRows();
+        int nc = Dl.GetRows();
+        broyden_z.Reset(nv + nc);
+        broyden_z.PasteMatrix(Dv, 0, 0);
+        broyden_z.PasteMatrix(Dl, nv, 0);
+
+        size_t n = broyden_steps.size();
+        bool valid = true;
+        if (n > 0) {
+            for (size_t j = 0; j + 1 < n; j++)
+                broyden_z.MatrInc(broyden_steps[j + 1] *
+                                  (ChMatrix<>::MatrDot(broyden_steps[j], broyden_z) / broyden_norms[j]));
+            double denom = 1 - ChMatrix<>::MatrDot(broyden_steps[n - 1], broyden_z) / broyden_norms[n - 1];
+            if (std::abs(denom) > 1e-6)
+                broyden_z.MatrScale(1 / denom);
+            else
+                valid = false;
+        }
+
+        if (!valid || (int)n >= max_broyden) {
+            // Restart from the factorized matrix, with the plain correction of this iteration.
+            broyden_steps.clear();
+            broyden_norms.clear();
+            matrix_refresh = !valid;
+        } else {
+            Dv.PasteClippedMatrix(broyden_z, 0, 0, nv, 1, 0, 0);
+            Dl.PasteClippedMatrix(broyden_z, nv, 0, nc, 1, 0, 0);
+            double norm2 = broyden_z.NormTwo();
+            norm2 *= norm2;
+            if (norm2 > 0) {
+                broyden_steps.push_back(broyden_z);
+                broyden_norms.push_back(norm2);
+            }
+        }
+    }
+
+    // Refresh the reused matrix at the next iteration if the convergence rate is not acceptable.
+    double norm = Dv.NormTwo();
+    if (!setup && last_norm > 0 && norm > max_rate * last_norm)
+        matrix_refresh = true;
+    last_norm = norm;
+
+    return true;
+}
+
+void ChImplicitIterativeTimestepper::EndNewtonIteration(bool converged) {
+    if (!converged)
+        matrix_refresh = true;
+}
+
 // -----------------------------------------------------------------------------
 
 // Register into the object factory, to enable run-time dynamic creation and persistence
@@ -298,6 +411,80 @@ void ChTimestepperLeapfrog::Advance(const double dt) {
 
 // -----------------------------------------------------------------------------
 
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChTimestepperCentralDifference)
+
+void ChTimestepperCentralDifference::ComputeAccelerations(ChIntegrableIIorder* mintegrable, ChStateDelta& Acc) {
+    F.Reset(mintegrable->GetNcoords_v());
+    mintegrable->LoadResidual_F(F, 1.0);
+    for (int i = 0; i < F.GetRows(); i++)
+        Acc(i) = F(i) / Md(i);
+}
+
+// Performs a step of the explicit central difference method, with lumped mass
+void ChTimestepperCentralDifference::Advance(const double dt) {
+    // downcast
+    ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
+
+    if (mintegrable->GetNconstr() > 0)
+        throw ChException("ChTimestepperCentralDifference: constraints are not supported.");
+
+    // setup main vectors
+    mintegrable->StateSetup(X, V, A);
+
+    // setup auxiliary vectors
+    L.Reset(0);
+    Aold.Reset(mintegrable->GetNcoords_v(), GetIntegrable());
+
+    mintegrable->StateGather(X, V, T);  // state <- system
+
+    // lumped mass, and accelerations at the beginning of the step (later taken from the previous step)
+    if (update_mass || Md.GetRows() != mintegrable->GetNcoords_v()) {
+        Md.Reset(mintegrable->GetNcoords_v());
+        mintegrable->LoadLumpedMass_Md(Md, 1.0, hrz);
+        for (int i = 0; i < Md.GetRows(); i++) {
+            if (!(Md(i) > 0))
+                throw ChException("ChTimestepperCentralDifference: the lumped mass is not positive definite.");
+        }
+        update_mass = false;
+        update_stable = true;
+        ComputeAccelerations(mintegrable, Aold);
+    } else {
+        mintegrable->StateGatherAcceleration(Aold);
+    }
+
+    // number of substeps
+    num_substeps = 1;
+    if (update_stable || ++stable_age >= stable_interval) {
+        stable_step = mintegrable->GetStableTimeStep();
+        stable_age = 0;
+        update_stable = false;
+    }
+    if (substepping && stable_step > 0)
+        num_substeps = std::max(1, (int)std::ceil(dt / (safety_factor * stable_step)));
+    double h = dt / num_substeps;
+
+    for (int i = 0; i < num_substeps; i++) {
+        // advance V by half step, then X
+        V = V + Aold * (0.5 * h);
+        X = X + V * h;
+        T += h;
+
+        // computes new A, with forces at the new X and at the half-step V
+        mintegrable->StateScatter(X, V, T);  // state -> system
+        ComputeAccelerations(mintegrable, A);
+
+        // advance V by the other half step
+        V = V + A * (0.5 * h);
+        Aold = A;
+    }
+
+    mintegrable->StateScatter(X, V, T);        // state -> system
+    mintegrable->StateScatterAcceleration(A);  // -> system auxiliary data
+}
+
+// -----------------------------------------------------------------------------
+
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChTimestepperEulerImplicit)
 
@@ -333,6 +520,8 @@ void ChTimestepperEulerImplicit::Advance(const double dt) {
     numiters = 0;
     numsetups = 0;
     numsolves = 0;
+    numsetups_avoided = 0;
+    BeginNewtonIteration(mintegrable);
 
     for (int i = 0; i < this->GetMaxiters(); ++i) {
         mintegrable->StateScatter(Xnew, Vnew, T + dt);  // state -> system
@@ -349,19 +538,15 @@ void ChTimestepperEulerImplicit::Advance(const double dt) {
         if ((R.NormInf() < abstolS) && (Qc.NormInf() < abstolL))
             break;
 
-        mintegrable->StateSolveCorrection(
-            Dv, Dl, R, Qc,
-            1.0,                 // factor for  M
-            -dt,                 // factor for  dF/dv
-            -dt * dt,            // factor for  dF/dx
-            Xnew, Vnew, T + dt,  // not used here (scatter = false)
-            false,               // do not StateScatter update to Xnew Vnew T+dt before computing correction
-            true                 // always call the solver's Setup
-            );
+        SolveCorrection(mintegrable, Dv, Dl, R, Qc,
+                        1.0,                 // factor for  M
+                        -dt,                 // factor for  dF/dv
+                        -dt * dt,            // factor for  dF/dx
+                        Xnew, Vnew, T + dt,  // not used here (no scatter)
+                        true                 // call the solver's Setup (unless reusing the Newton matrix)
+                        );
 
         numiters++;
-        numsetups++;
-        numsolves++;
 
         Dl *= (1.0 / dt);  // Note it is not -(1.0/dt) because we assume StateSolveCorrection already flips sign of Dl
         L += Dl;
@@ -371,6 +556,8 @@ void ChTimestepperEulerImplicit::Advance(const double dt) {
         Xnew = X + Vnew * dt;
     }
 
+    EndNewtonIteration(numiters < this->GetMaxiters());
+
     mintegrable->StateScatterAcceleration(
         (Vnew - V) * (1 / dt));  // -> system auxiliary data (i.e acceleration as measure, fits DVI/MDI)
 
@@ -587,6 +774,8 @@ void ChTimestepperTrapezoidal::Advance(const double dt) {
     numiters = 0;
     numsetups = 0;
     numsolves = 0;
+    numsetups_avoided = 0;
+    BeginNewtonIteration(mintegrable);
 
     for (int i = 0; i < this->GetMaxiters(); ++i) {
         mintegrable->StateScatter(Xnew, Vnew, T + dt);  // state -> system
@@ -603,19 +792,15 @@ void ChTimestepperTrapezoidal::Advance(const double dt) {
         if ((R.NormInf() < abstolS) && (Qc.NormInf() < abstolL))
             break;
 
-        mintegrable->StateSolveCorrection(
-            Dv, Dl, R, Qc,
-            1.0,                 // factor for  M
-            -dt * 0.5,           // factor for  dF/dv
-            -dt * dt * 0.25,     // factor for  dF/dx
-            Xnew, Vnew, T + dt,  // not used here (scatter = false)
-            false,               // do not StateScatter update to Xnew Vnew T+dt before computing correction
-            true                 // always force a call to the solver's Setup() function
-            );
+        SolveCorrection(mintegrable, Dv, Dl, R, Qc,
+                        1.0,                 // factor for  M
+                        -dt * 0.5,           // factor for  dF/dv
+                        -dt * dt * 0.25,     // factor for  dF/dx
+                        Xnew, Vnew, T + dt,  // not used here (no scatter)
+                        true                 // call the solver's Setup (unless reusing the Newton matrix)
+                        );
 
         numiters++;
-        numsetups++;
-        numsolves++;
 
         Dl *= (2.0 / dt);  // Note it is not -(2.0/dt) because we assume StateSolveCorrection already flips sign of Dl
         L += Dl;
@@ -625,6 +810,8 @@ void ChTimestepperTrapezoidal::Advance(const double dt) {
         Xnew = X + ((Vnew + V) * (dt * 0.5));  // Xnew = Xold + h/2(Vnew+Vold)
     }
 
+    EndNewtonIteration(numiters < this->GetMaxiters());
+
     mintegrable->StateScatterAcceleration(
         (Vnew - V) * (1 / dt));  // -> system auxiliary data (i.e acceleration as measure, fits DVI/MDI)
 
@@ -842,6 +1029,8 @@ void ChTimestepperNewmark::Advance(const double dt) {
     numiters = 0;
     numsetups = 0;
     numsolves = 0;
+    numsetups_avoided = 0;
+    BeginNewtonIteration(mintegrable);
 
     for (int i = 0; i < this->GetMaxiters(); ++i) {
         mintegrable->StateScatter(Xnew, Vnew, T + dt);  // state -> system
@@ -859,19 +1048,15 @@ void ChTimestepperNewmark::Advance(const double dt) {
         if ((R.NormInf() < abstolS) && (Qc.NormInf() < abstolL))
             break;
 
-        mintegrable->StateSolveCorrection(
-            Da, Dl, R, Qc,
-            1.0,                 // factor for  M
-            -dt * gamma,         // factor for  dF/dv
-            -dt * dt * beta,     // factor for  dF/dx
-            Xnew, Vnew, T + dt,  // not used here (scatter = false)
-            false,               // do not StateScatter update to Xnew Vnew T+dt before computing correction
-            true                 // force a call to the solver's Setup() function
-            );
+        SolveCorrection(mintegrable, Da, Dl, R, Qc,
+                        1.0,                 // factor for  M
+                        -dt * gamma,         // factor for  dF/dv
+                        -dt * dt * beta,     // factor for  dF/dx
+                        Xnew, Vnew, T + dt,  // not used here (no scatter)
+                        true                 // call the solver's Setup (unless reusing the Newton matrix)
+                        );
 
         numiters++;
-        numsetups++;
-        numsolves++;
 
         L += Dl;  // Note it is not -= Dl because we assume StateSolveCorrection flips sign of Dl
         Anew += Da;
@@ -881,6 +1066,8 @@ void ChTimestepperNewmark::Advance(const double dt) {
         Vnew = V + A * (dt * (1.0 - gamma)) + Anew * (dt * gamma);
     }
 
+    EndNewtonIteration(numiters < this->GetMaxiters());
+
     X = Xnew;
     V = Vnew;
     A = Anew;
@@ -15,7 +15,9 @@
 #ifndef CHTIMESTEPPER_H
 #define CHTIMESTEPPER_H
 
+#include <algorithm>
 #include <cstdlib>
+#include <vector>
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChMath.h"
 #include "chrono/core/ChVectorDynamic.h"
@@ -46,6 +48,9 @@ class ChApi ChTimestepper {
           EULER_EXPLICIT = 8,
           LEAPFROG = 9,
           NEWMARK = 10,
+          CENTRAL_DIFFERENCE = 11,
+          DORMAND_PRINCE = 12,
+          RUNGE_KUTTA_NYSTROM = 13,
           CUSTOM = 20
       };
 
@@ -187,7 +192,12 @@ class ChApi ChImplicitTimestepper {
 /// Base properties for implicit solvers.
 /// Such integrators require solution of a nonlinear problem, typically solved
 /// using an iterative process, up to a desired tolerance. At each iteration,
-/// a linear system must be solved.
+/// a linear system must be solved.\n
+/// Optionally, the Newton matrix (and its factorization, with direct solvers) can be reused across
+/// iterations and steps, see SetJacobianReuse(). The matrix is then refreshed only when the convergence
+/// rate degrades, when the Newton iteration fails, when the coefficients of the matrix change (e.g. a
+/// different step size) or when the number of coordinates or constraints changes. Between refreshes, the
+/// reused matrix can be improved with Broyden rank-one updates, see SetBroydenUpdates().
 class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
 
   protected:
@@ -200,9 +210,39 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
     int numsetups;  ///< number of calls to the solver's Setup function
     int numsolves;  ///< number of calls to the solver's Solve function
 
+    bool jacobian_reuse;  ///< reuse the Newton matrix across iterations and steps?
+    double max_rate;      ///< maximum convergence rate accepted with a reused matrix
+    bool broyden;         ///< refine the reused matrix with Broyden updates?
+    int max_broyden;      ///< maximum number of Broyden updates before a restart
+
+    int numsetups_avoided;      ///< number of calls to the solver's Setup function avoided in the last step
+    long total_setups;          ///< total number of calls to the solver's Setup function
+    long total_setups_avoided;  ///< total number of calls to the solver's Setup function avoided
+
   public:
     ChImplicitIterativeTimestepper()
-        : maxiters(6), reltol(1e-4), abstolS(1e-10), abstolL(1e-10), numiters(0), numsetups(0), numsolves(0) {}
+        : maxiters(6),
+          reltol(1e-4),
+          abstolS(1e-10),
+          abstolL(1e-10),
+          numiters(0),
+          numsetups(0),
+          numsolves(0),
+          jacobian_reuse(false),
+          max_rate(0.5),
+          broyden(false),
+          max_broyden(10),
+          numsetups_avoided(0),
+          total_setups(0),
+          total_setups_avoided(0),
+          matrix_valid(false),
+          matrix_refresh(false),
+          matrix_ca(0),
+          matrix_cv(0),
+          matrix_cx(0),
+          matrix_nv(0),
+          matrix_nc(0),
+          last_norm(0) {}
     virtual ~ChImplicitIterativeTimestepper() {}
 
     /// Set the max number of iterations using the Newton Raphson procedure
@@ -242,6 +282,56 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
     /// Return the number of calls to the solver's Solve function.
     int GetNumSolveCalls() const { return numsolves; }
 
+    /// Enable/disable the reuse of the Newton matrix across iterations and steps.
+    /// If enabled, the solver's Setup function (i.e. the assembly and factorization of the Newton matrix
+    /// with direct solvers) is called only when the matrix is out of date: at the first step, when the
+    /// convergence rate exceeds the value set with SetJacobianReuseMaxRate(), after a Newton iteration
+    /// that did not converge, or when the matrix coefficients or the problem size change.
+    /// Disabled by default: each integrator then follows its own strategy (usually, a Setup at each iteration).
+    /// Note that the problem structure is assumed to be fixed while the matrix is reused: contacts that
+    /// appear or disappear without changing the number of constraints are only caught by the rate test.
+    void SetJacobianReuse(bool val) {
+        jacobian_reuse = val;
+        matrix_valid = false;
+    }
+
+    /// Return true if the Newton matrix is reused across iterations and steps.
+    bool GetJacobianReuse() const { return jacobian_reuse; }
+
+    /// Set the maximum convergence rate (ratio between the norms of two successive Newton corrections)
+    /// accepted with a reused Newton matrix. If exceeded, the matrix is refreshed at the next iteration.
+    /// Default: 0.5.
+    void SetJacobianReuseMaxRate(double rate) { max_rate = rate; }
+
+    /// Return the maximum convergence rate accepted with a reused Newton matrix.
+    double GetJacobianReuseMaxRate() const { return max_rate; }
+
+    /// Enable/disable Broyden rank-one updates of the reused Newton matrix.
+    /// The updates are applied to the Newton corrections (in the inverse form), so they do not require
+    /// any additional solve; they are restarted at each step and at each refresh of the matrix.
+    /// Only meaningful with SetJacobianReuse(true) and with solvers that keep the matrix between Solve calls
+    /// (i.e. direct solvers). Disabled by default.
+    void SetBroydenUpdates(bool val) { broyden = val; }
+
+    /// Return true if Broyden updates of the reused Newton matrix are enabled.
+    bool GetBroydenUpdates() const { return broyden; }
+
+    /// Set the maximum number of Broyden updates kept before restarting from the factorized matrix.
+    /// Default: 10.
+    void SetMaxBroydenUpdates(int num) { max_broyden = num; }
+
+    /// Force a refresh of the Newton matrix at the next iteration (e.g. after the problem structure changed).
+    void ForceJacobianUpdate() { matrix_valid = false; }
+
+    /// Return the number of calls to the solver's Setup function avoided in the last step.
+    int GetNumSetupsAvoided() const { return numsetups_avoided; }
+
+    /// Return the total number of calls to the solver's Setup function.
+    long GetTotalSetupCalls() const { return total_setups; }
+
+    /// Return the total number of calls to the solver's Setup function avoided by reusing the Newton matrix.
+    long GetTotalSetupsAvoided() const { return total_setups_avoided; }
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) {
         // version number
@@ -263,6 +353,45 @@ class ChApi ChImplicitIterativeTimestepper : public ChImplicitTimestepper {
         marchive >> CHNVP(abstolS);
         marchive >> CHNVP(abstolL);
     }
+
+  protected:
+    /// Prepare the Newton iteration of a new step.
+    /// Restart the Broyden updates and invalidate the Newton matrix if the problem size changed.
+    void BeginNewtonIteration(ChIntegrableIIorder* integrable);
+
+    /// Compute a Newton correction with integrable->StateSolveCorrection(), deciding whether the solver's
+    /// Setup function must be called. If the Newton matrix is not reused, Setup is called if 'setup' is true
+    /// (the integrator's own strategy). Also updates the counters of setups and solves.
+    bool SolveCorrection(ChIntegrableIIorder* integrable,
+                         ChStateDelta& Dv,             ///< result: computed Dv
+                         ChVectorDynamic<>& Dl,        ///< result: computed lagrangian multipliers, if any
+                         const ChVectorDynamic<>& R,   ///< the R residual
+                         const ChVectorDynamic<>& Qc,  ///< the Qc residual
+                         const double c_a,             ///< the factor in c_a*M
+                         const double c_v,             ///< the factor in c_v*dF/dv
+                         const double c_x,             ///< the factor in c_x*dF/dx
+                         const ChState& x,             ///< current state, x part
+                         const ChStateDelta& v,        ///< current state, v part
+                         const double T,               ///< current time T
+                         bool setup                    ///< call Setup (if the Newton matrix is not reused)?
+                         );
+
+    /// Close the Newton iteration of a step. If it did not converge, the Newton matrix is refreshed at the next step.
+    void EndNewtonIteration(bool converged);
+
+  private:
+    bool matrix_valid;    ///< does the solver hold a Newton matrix that can be reused?
+    bool matrix_refresh;  ///< refresh the Newton matrix at the next iteration?
+    double matrix_ca;     ///< coefficients of the current Newton matrix
+    double matrix_cv;
+    double matrix_cx;
+    int matrix_nv;  ///< size of the current Newton matrix
+    int matrix_nc;
+    double last_norm;  ///< norm of the last Newton correction in this step (0 if none)
+
+    std::vector<ChVectorDynamic<>> broyden_steps;  ///< Newton corrections since the last restart
+    std::vector<double> broyden_norms;             ///< squared norms of the Newton corrections
+    ChVectorDynamic<> broyden_z;                   ///< work vector
 };
 
 /// Euler explicit timestepper.
@@ -376,6 +505,100 @@ class ChApi ChTimestepperLeapfrog : public ChTimestepperIIorder {
                          ) override;
 };
 
+/// Explicit central difference timestepper with lumped mass, for fast dynamics of finite element meshes
+/// (e.g. impacts and crash problems).\n
+/// The mass matrix is replaced by a diagonal lumped mass (see ChIntegrableIIorder::LoadLumpedMass_Md), so
+/// each step needs no linear solve, only an evaluation of the forces (the internal forces of the elements
+/// are evaluated in parallel by the meshes). The velocities are advanced in two half steps:
+///    v_half = v + a * dt/2
+///    x_new  = x + v_half * dt
+///    a_new  = M_lumped^-1 * F(x_new, v_half, t+dt)
+///    v_new  = v_half + a_new * dt/2
+/// The method is conditionally stable: by default, the step dt passed to Advance() is split in substeps
+/// not larger than the stable step estimated by the integrable (see ChIntegrableIIorder::GetStableTimeStep,
+/// e.g. from the size and the wave speed of the finite elements) times a safety factor. The estimate of the
+/// stable step is cached: it is refreshed every few steps (see SetStableStepUpdateInterval), when the lumped
+/// mass is updated, or on request (see ForceStableStepUpdate).\n
+/// Constraints are not supported (links, or NSC contacts): use SMC contacts and fixed nodes/bodies.\n
+/// Note: the lumped mass is computed at the first step and cached; call ForceMassUpdate() if masses change.
+class ChApi ChTimestepperCentralDifference : public ChTimestepperIIorder {
+
+  protected:
+    ChVectorDynamic<> Md;    ///< lumped mass (diagonal)
+    ChVectorDynamic<> F;     ///< applied forces
+    ChStateDelta Aold;       ///< accelerations at the beginning of the substep
+    bool hrz;                ///< use HRZ lumping
+    bool update_mass;        ///< recompute the lumped mass at the next step
+    bool substepping;        ///< split the step in stable substeps
+    double safety_factor;    ///< ratio between the substep and the estimated stable step
+    double stable_step;      ///< last estimate of the stable step (0 if not available)
+    int stable_interval;     ///< number of steps between updates of the stable step estimate
+    int stable_age;          ///< number of steps since the last update of the stable step estimate
+    bool update_stable;      ///< recompute the stable step at the next step
+    int num_substeps;        ///< number of substeps taken in the last step
+
+    /// Compute the accelerations from the forces and the lumped mass, with the state already scattered.
+    void ComputeAccelerations(ChIntegrableIIorder* mintegrable, ChStateDelta& Acc);
+
+  public:
+    /// Constructors (default empty)
+    ChTimestepperCentralDifference(ChIntegrableIIorder* mintegrable = nullptr)
+        : ChTimestepperIIorder(mintegrable),
+          hrz(false),
+          update_mass(true),
+          substepping(true),
+          safety_factor(0.9),
+          stable_step(0),
+          stable_interval(10),
+          stable_age(0),
+          update_stable(true),
+          num_substeps(0) {}
+
+    virtual Type GetType() const override { return Type::CENTRAL_DIFFERENCE; }
+
+    /// Use the HRZ (Hinton-Rock-Zienkiewicz) lumping for finite elements, instead of the sum of the rows
+    /// of their mass matrix (default: false). For linear tetrahedrons and hexahedrons they coincide.
+    void SetUseHRZLumping(bool val) {
+        hrz = val;
+        update_mass = true;
+    }
+    bool GetUseHRZLumping() const { return hrz; }
+
+    /// Enable/disable the splitting of the step in stable substeps (default: true).
+    void SetSubstepping(bool val) { substepping = val; }
+    bool GetSubstepping() const { return substepping; }
+
+    /// Set the ratio between the substep and the estimated stable step (default: 0.9).
+    void SetSafetyFactor(double val) { safety_factor = val; }
+    double GetSafetyFactor() const { return safety_factor; }
+
+    /// Force the computation of the lumped mass at the next step (e.g. after changing densities or adding
+    /// items; changes in the number of coordinates are detected automatically).
+    void ForceMassUpdate() { update_mass = true; }
+
+    /// Set the number of steps after which the estimate of the stable step is recomputed (default: 10).
+    /// The estimate may be expensive (e.g. it requires the stiffness matrix of each element), while it changes
+    /// slowly with the deformation. Use 1 to recompute it at each step.
+    void SetStableStepUpdateInterval(int val) { stable_interval = std::max(1, val); }
+    int GetStableStepUpdateInterval() const { return stable_interval; }
+
+    /// Force the computation of the stable step at the next step (e.g. after changing the materials).
+    void ForceStableStepUpdate() { update_stable = true; }
+
+    /// Return the current estimate of the stable step (0 if not available).
+    double GetStableTimeStep() const { return stable_step; }
+
+    /// Return the number of substeps taken in the last step.
+    int GetNumSubsteps() const { return num_substeps; }
+
+    /// Return the lumped mass (diagonal) used in the last step.
+    const ChVectorDynamic<>& GetLumpedMass() const { return Md; }
+
+    /// Performs an integration timestep
+    virtual void Advance(const double dt  ///< timestep to advance
+                         ) override;
+};
+
 /// Performs a step of Euler implicit for II order systems.
 class ChApi ChTimestepperEulerImplicit : public ChTimestepperIIorder, public ChImplicitIterativeTimestepper {
 
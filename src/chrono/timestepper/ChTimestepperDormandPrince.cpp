@@ -0,0 +1,354 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/timestepper/ChTimestepperDormandPrince.h"
+
+namespace chrono {
+
+namespace {
+
+// Butcher tableau of the Dormand-Prince 5(4) pair, with the coefficients of its Nystrom form:
+// abar = a*a (positions at the stages), bbar = b'*a and ebar = (b-bstar)'*a (positions at the end of the step).
+struct DormandPrinceTableau {
+    double a[7][7];
+    double c[7];
+    double b[7];
+    double e[7];  // b - bstar
+    double abar[7][7];
+    double bbar[7];
+    double ebar[7];
+
+    DormandPrinceTableau() {
+        for (int i = 0; i < 7; i++)
+            for (int j = 0; j < 7; j++)
+                a[i][j] = 0;
+        a[1][0] = 1.0 / 5.0;
+        a[2][0] = 3.0 / 40.0;
+        a[2][1] = 9.0 / 40.0;
+        a[3][0] = 44.0 / 45.0;
+        a[3][1] = -56.0 / 15.0;
+        a[3][2] = 32.0 / 9.0;
+        a[4][0] = 19372.0 / 6561.0;
+        a[4][1] = -25360.0 / 2187.0;
+        a[4][2] = 64448.0 / 6561.0;
+        a[4][3] = -212.0 / 729.0;
+        a[5][0] = 9017.0 / 3168.0;
+        a[5][1] = -355.0 / 33.0;
+        a[5][2] = 46732.0 / 5247.0;
+        a[5][3] = 49.0 / 176.0;
+        a[5][4] = -5103.0 / 18656.0;
+        a[6][0] = 35.0 / 384.0;
+        a[6][2] = 500.0 / 1113.0;
+        a[6][3] = 125.0 / 192.0;
+        a[6][4] = -2187.0 / 6784.0;
+        a[6][5] = 11.0 / 84.0;
+
+        double bstar[7] = {5179.0 / 57600.0,    0.0,           7571.0 / 16695.0, 393.0 / 640.0,
+                           -92097.0 / 339200.0, 187.0 / 2100.0, 1.0 / 40.0};
+        for (int i = 0; i < 7; i++) {
+            c[i] = 0;
+            for (int j = 0; j < 7; j++)
+                c[i] += a[i][j];
+            b[i] = a[6][i];
+            e[i] = b[i] - bstar[i];
+        }
+
+        for (int i = 0; i < 7; i++) {
+            bbar[i] = 0;
+            ebar[i] = 0;
+            for (int k = 0; k < 7; k++) {
+                bbar[i] += b[k] * a[k][i];
+                ebar[i] += e[k] * a[k][i];
+            }
+            for (int j = 0; j < 7; j++) {
+                abar[i][j] = 0;
+                for (int k = 0; k < 7; k++)
+                    abar[i][j] += a[i][k] * a[k][j];
+            }
+        }
+    }
+};
+
+const DormandPrinceTableau dopri;
+
+// v += c * w
+void AddScaled(ChVectorDynamic<>& v, const ChVectorDynamic<>& w, double c) {
+    if (c == 0)
+        return;
+    for (int i = 0; i < v.GetRows(); i++)
+        v(i) += c * w(i);
+}
+
+}  // end anonymous namespace
+
+// -----------------------------------------------------------------------------
+
+double ChExplicitAdaptiveTimestepper::StepFactor(double err, int order, bool after_rejection) const {
+    // Standard controller (Hairer, Norsett, Wanner), with a safety factor and bounds on the change.
+    const double safety = 0.9;
+    const double fac_min = 0.2;
+    const double fac_max = after_rejection ? 1.0 : 5.0;
+    if (err <= 0)
+        return fac_max;
+    double fac = safety * std::pow(1.0 / err, 1.0 / (order + 1));
+    return std::min(fac_max, std::max(fac_min, fac));
+}
+
+void ChExplicitAdaptiveTimestepper::AccumulateError(const ChVectorDynamic<>& e,
+                                                    const ChVectorDynamic<>& y0,
+                                                    const ChVectorDynamic<>& y1,
+                                                    const ChVectorDynamic<>& dy,
+                                                    double& sum) const {
+    bool same_size = (y0.GetRows() == e.GetRows());
+    for (int i = 0; i < e.GetRows(); i++) {
+        double y = same_size ? std::max(std::abs(y0(i)), std::abs(y1(i))) : std::abs(dy(i));
+        double r = e(i) / (abstol + reltol * y);
+        sum += r * r;
+    }
+}
+
+// -----------------------------------------------------------------------------
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChTimestepperDormandPrince)
+
+// Performs a step of the Dormand-Prince 5(4) integrator, with internal steps of adaptive size.
+void ChTimestepperDormandPrince::Advance(const double dt) {
+    ChIntegrable* mintegrable = GetIntegrable();
+
+    // setup main vectors
+    mintegrable->StateSetup(Y, dYdt);
+
+    // setup auxiliary vectors
+    int n_y = mintegrable->GetNcoords_y();
+    int n_dy = mintegrable->GetNcoords_dy();
+    int n_c = mintegrable->GetNconstr();
+    y_new.Reset(n_y, mintegrable);
+    for (int k = 0; k < 7; k++)
+        K[k].Reset(n_dy, mintegrable);
+    Dy.Reset(n_dy, mintegrable);
+    err.Reset(n_dy, mintegrable);
+    L.Reset(n_c);
+
+    mintegrable->StateGather(Y, T);  // state <- system
+
+    num_steps = 0;
+    num_rejected = 0;
+
+    double tfinal = T + dt;
+    if (h <= 0 || h > dt)
+        h = dt;
+
+    // First stage at the initial state (later, reused from the last stage of the previous step)
+    mintegrable->StateSolve(K[0], L, Y, T, h, false);
+
+    bool rejected = false;
+    while (T < tfinal) {
+        // Do not overshoot the end of the interval, and do not leave a tiny last step.
+        double hs = h;
+        bool last = (T + 1.01 * hs > tfinal);
+        if (last)
+            hs = tfinal - T;
+
+        // Stages 2..7 (the last one is evaluated at the fifth order solution)
+        for (int s = 1; s < 7; s++) {
+            Dy.Reset(n_dy, mintegrable);
+            for (int j = 0; j < s; j++)
+                AddScaled(Dy, K[j], hs * dopri.a[s][j]);
+            mintegrable->StateIncrement(y_new, Y, Dy);
+            mintegrable->StateSolve(K[s], L, y_new, T + dopri.c[s] * hs, hs);
+        }
+
+        // Error estimate
+        err.Reset(n_dy, mintegrable);
+        for (int j = 0; j < 7; j++)
+            AddScaled(err, K[j], hs * dopri.e[j]);
+        double sum = 0;
+        AccumulateError(err, Y, y_new, Dy, sum);
+        double error = std::sqrt(sum / std::max(n_dy, 1));
+
+        if (error <= 1) {
+            // Accept: y_new is the fifth order solution, K[6] its derivative (first same as last)
+            Y = y_new;
+            T = last ? tfinal : T + hs;
+            K[0] = K[6];
+            num_steps++;
+            if (verbose)
+                GetLog() << " Dormand-Prince step accepted, T = " << T << "  h = " << hs << "  err = " << error
+                         << "\n";
+            // Do not grow the step because of a last step shortened to reach the end of the interval.
+            if (hs >= h)
+                h = std::min(hs * StepFactor(error, 4, rejected), dt);
+            rejected = false;
+        } else {
+            // Reject: restore the state at the beginning of the step and retry with a smaller step
+            num_rejected++;
+            h = hs * StepFactor(error, 4, true);
+            rejected = true;
+            if (verbose)
+                GetLog() << " Dormand-Prince step rejected, T = " << T << "  err = " << error << ", retry with h = "
+                         << h << "\n";
+            if (h < h_min)
+                throw ChException("Dormand-Prince: Reached minimum allowable step size.");
+            mintegrable->StateScatter(Y, T);
+        }
+    }
+
+    dYdt = K[0];
+
+    mintegrable->StateScatter(Y, T);            // state -> system
+    mintegrable->StateScatterDerivative(dYdt);  // -> system auxiliary data
+    mintegrable->StateScatterReactions(L);      // -> system auxiliary data
+}
+
+void ChTimestepperDormandPrince::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChTimestepperDormandPrince>();
+    // serialize parent class:
+    ChTimestepperIorder::ArchiveOUT(marchive);
+    ChExplicitAdaptiveTimestepper::ArchiveOUT(marchive);
+}
+
+void ChTimestepperDormandPrince::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead<ChTimestepperDormandPrince>();
+    // deserialize parent class:
+    ChTimestepperIorder::ArchiveIN(marchive);
+    ChExplicitAdaptiveTimestepper::ArchiveIN(marchive);
+}
+
+// -----------------------------------------------------------------------------
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChTimestepperRungeKuttaNystrom)
+
+// Performs a step of the Dormand-Prince 5(4) pair in Nystrom form, with internal steps of adaptive size:
+//   x_s = x + c_s*h*v + h^2 * sum_j abar_sj*a_j,   v_s = v + h * sum_j a_sj*a_j,   a_s = a(x_s, v_s, T + c_s*h)
+//   x_new = x + h*v + h^2 * sum_j bbar_j*a_j,      v_new = v + h * sum_j b_j*a_j
+void ChTimestepperRungeKuttaNystrom::Advance(const double dt) {
+    // downcast
+    ChIntegrableIIorder* mintegrable = (ChIntegrableIIorder*)this->integrable;
+
+    // setup main vectors
+    mintegrable->StateSetup(X, V, A);
+
+    // setup auxiliary vectors
+    int n_x = mintegrable->GetNcoords_x();
+    int n_v = mintegrable->GetNcoords_v();
+    int n_c = mintegrable->GetNconstr();
+    Xs.Reset(n_x, mintegrable);
+    Vs.Reset(n_v, mintegrable);
+    for (int k = 0; k < 7; k++)
+        Acc[k].Reset(n_v, mintegrable);
+    Dx.Reset(n_v, mintegrable);
+    errX.Reset(n_v, mintegrable);
+    errV.Reset(n_v, mintegrable);
+    L.Reset(n_c);
+
+    mintegrable->StateGather(X, V, T);  // state <- system
+
+    num_steps = 0;
+    num_rejected = 0;
+
+    double tfinal = T + dt;
+    if (h <= 0 || h > dt)
+        h = dt;
+
+    // First stage at the initial state (later, reused from the last stage of the previous step)
+    mintegrable->StateSolveA(Acc[0], L, X, V, T, h, false);
+
+    bool rejected = false;
+    while (T < tfinal) {
+        // Do not overshoot the end of the interval, and do not leave a tiny last step.
+        double hs = h;
+        bool last = (T + 1.01 * hs > tfinal);
+        if (last)
+            hs = tfinal - T;
+
+        // Stages 2..7 (the last one is evaluated at the fifth order solution)
+        for (int s = 1; s < 7; s++) {
+            Dx = V * (dopri.c[s] * hs);
+            Vs = V;
+            for (int j = 0; j < s; j++) {
+                AddScaled(Dx, Acc[j], hs * hs * dopri.abar[s][j]);
+                AddScaled(Vs, Acc[j], hs * dopri.a[s][j]);
+            }
+            mintegrable->StateIncrementX(Xs, X, Dx);
+            mintegrable->StateSolveA(Acc[s], L, Xs, Vs, T + dopri.c[s] * hs, hs);
+        }
+
+        // Error estimate, on positions and velocities
+        errX.Reset(n_v, mintegrable);
+        errV.Reset(n_v, mintegrable);
+        for (int j = 0; j < 7; j++) {
+            AddScaled(errX, Acc[j], hs * hs * dopri.ebar[j]);
+            AddScaled(errV, Acc[j], hs * dopri.e[j]);
+        }
+        double sum = 0;
+        AccumulateError(errX, X, Xs, Dx, sum);
+        AccumulateError(errV, V, Vs, Dx, sum);
+        double error = std::sqrt(sum / std::max(2 * n_v, 1));
+
+        if (error <= 1) {
+            // Accept: Xs, Vs is the fifth order solution, Acc[6] its acceleration (first same as last)
+            X = Xs;
+            V = Vs;
+            T = last ? tfinal : T + hs;
+            Acc[0] = Acc[6];
+            num_steps++;
+            if (verbose)
+                GetLog() << " RKN step accepted, T = " << T << "  h = " << hs << "  err = " << error << "\n";
+            // Do not grow the step because of a last step shortened to reach the end of the interval.
+            if (hs >= h)
+                h = std::min(hs * StepFactor(error, 4, rejected), dt);
+            rejected = false;
+        } else {
+            // Reject: restore the state at the beginning of the step and retry with a smaller step
+            num_rejected++;
+            h = hs * StepFactor(error, 4, true);
+            rejected = true;
+            if (verbose)
+                GetLog() << " RKN step rejected, T = " << T << "  err = " << error << ", retry with h = " << h
+                         << "\n";
+            if (h < h_min)
+                throw ChException("Runge-Kutta-Nystrom: Reached minimum allowable step size.");
+            mintegrable->StateScatter(X, V, T);
+        }
+    }
+
+    A = Acc[0];
+
+    mintegrable->StateScatter(X, V, T);        // state -> system
+    mintegrable->StateScatterAcceleration(A);  // -> system auxiliary data
+    mintegrable->StateScatterReactions(L);     // -> system auxiliary data
+}
+
+void ChTimestepperRungeKuttaNystrom::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChTimestepperRungeKuttaNystrom>();
+    // serialize parent class:
+    ChTimestepperIIorder::ArchiveOUT(marchive);
+    ChExplicitAdaptiveTimestepper::ArchiveOUT(marchive);
+}
+
+void ChTimestepperRungeKuttaNystrom::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead<ChTimestepperRungeKuttaNystrom>();
+    // deserialize parent class:
+    ChTimestepperIIorder::ArchiveIN(marchive);
+    ChExplicitAdaptiveTimestepper::ArchiveIN(marchive);
+}
+
+}  // end namespace chrono
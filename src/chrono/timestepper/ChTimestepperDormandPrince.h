@@ -0,0 +1,177 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHTIMESTEPPER_DORMANDPRINCE_H
+#define CHTIMESTEPPER_DORMANDPRINCE_H
+
+#include "chrono/timestepper/ChTimestepper.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_timestepper
+/// @{
+
+/// Base properties for explicit integrators with error control (double inheritance).
+/// Such integrators cover the interval [T, T+dt] requested in Advance() with internal steps, whose size is
+/// adapted so that the local error, estimated with an embedded pair of formulas, satisfies the tolerances.
+/// A step with a too large error is rejected: the state is restored (StateScatter) and the step is retried
+/// with a smaller size. The internal step size is kept across calls to Advance(), and it never exceeds dt.
+class ChApi ChExplicitAdaptiveTimestepper {
+
+  protected:
+    double reltol;  ///< relative tolerance
+    double abstol;  ///< absolute tolerance
+    double h;       ///< internal step size (kept across steps, 0 if not yet set)
+    double h_min;   ///< minimum allowable internal step size
+
+    int num_steps;     ///< number of accepted internal steps in the last call to Advance
+    int num_rejected;  ///< number of rejected internal steps in the last call to Advance
+
+  public:
+    ChExplicitAdaptiveTimestepper()
+        : reltol(1e-4), abstol(1e-6), h(0), h_min(1e-10), num_steps(0), num_rejected(0) {}
+    virtual ~ChExplicitAdaptiveTimestepper() {}
+
+    /// Set the relative and absolute tolerances on the local error.
+    /// The error of each state component is scaled with (abs_tol + rel_tol * |y|), where |y| is the
+    /// magnitude of the component at the beginning and at the end of the step. For components of the
+    /// state that do not have a counterpart in the state increment (e.g. quaternions, with 4 components
+    /// for 3 rotational degrees of freedom), |y| is the magnitude of the increment over the step.
+    void SetTolerances(double rel_tol, double abs_tol) {
+        reltol = rel_tol;
+        abstol = abs_tol;
+    }
+
+    /// Return the relative tolerance.
+    double GetRelTolerance() const { return reltol; }
+
+    /// Return the absolute tolerance.
+    double GetAbsTolerance() const { return abstol; }
+
+    /// Set the minimum allowable internal step size. If the error control requires a smaller step, an
+    /// exception is thrown. Default: 1e-10.
+    void SetMinStepSize(double min_step) { h_min = min_step; }
+
+    /// Set the size of the next internal step (by default, the first step attempts the whole dt).
+    void SetStepSize(double step) { h = step; }
+
+    /// Return the size of the last accepted internal step (or the size of the next attempt).
+    double GetStepSize() const { return h; }
+
+    /// Return the number of accepted internal steps in the last call to Advance().
+    int GetNumSteps() const { return num_steps; }
+
+    /// Return the number of rejected internal steps in the last call to Advance().
+    int GetNumRejectedSteps() const { return num_rejected; }
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) {
+        // version number
+        marchive.VersionWrite(1);
+        // serialize all member data:
+        marchive << CHNVP(reltol);
+        marchive << CHNVP(abstol);
+        marchive << CHNVP(h_min);
+    }
+
+    /// Method to allow de serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) {
+        // version number
+        int version = marchive.VersionRead();
+        // stream in all member data:
+        marchive >> CHNVP(reltol);
+        marchive >> CHNVP(abstol);
+        marchive >> CHNVP(h_min);
+    }
+
+  protected:
+    /// Return the factor for the next step size, given the scaled norm of the estimated error (accepted if <= 1)
+    /// and the order of the error estimate.
+    double StepFactor(double err, int order, bool after_rejection) const;
+
+    /// Add to 'sum' the squares of the scaled components of the error 'e', using the magnitudes of the
+    /// components in 'y0' and 'y1' (if these have the same size as 'e') or in the increment 'dy'.
+    void AccumulateError(const ChVectorDynamic<>& e,
+                         const ChVectorDynamic<>& y0,
+                         const ChVectorDynamic<>& y1,
+                         const ChVectorDynamic<>& dy,
+                         double& sum) const;
+};
+
+/// Dormand-Prince 5(4) explicit Runge-Kutta integrator, with error control, for I order systems.
+/// Seven stages per step (six with the 'first same as last' property), fifth order solution and
+/// embedded fourth order error estimate. See ChExplicitAdaptiveTimestepper for the step size control.
+class ChApi ChTimestepperDormandPrince : public ChTimestepperIorder, public ChExplicitAdaptiveTimestepper {
+
+  protected:
+    ChState y_new;
+    ChStateDelta K[7];
+    ChStateDelta Dy;
+    ChStateDelta err;
+
+  public:
+    /// Constructors (default empty)
+    ChTimestepperDormandPrince(ChIntegrable* mintegrable = nullptr)
+        : ChTimestepperIorder(mintegrable), ChExplicitAdaptiveTimestepper() {}
+
+    virtual Type GetType() const override { return Type::DORMAND_PRINCE; }
+
+    /// Performs an integration timestep, with internal steps of adaptive size.
+    virtual void Advance(const double dt  ///< timestep to advance
+                         ) override;
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+
+    /// Method to allow de serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+};
+
+/// Explicit Runge-Kutta-Nystrom integrator, with error control, for II order systems.
+/// This is the Dormand-Prince 5(4) pair written in Nystrom form: positions are advanced with the
+/// coefficients of the squared Runge-Kutta matrix, so that only accelerations are evaluated (with
+/// StateSolveA) and positions are incremented with StateIncrementX (e.g. rotations stay normalized).
+/// Forces may depend on velocities. The local error is estimated on both positions and velocities.
+/// See ChExplicitAdaptiveTimestepper for the step size control.
+class ChApi ChTimestepperRungeKuttaNystrom : public ChTimestepperIIorder, public ChExplicitAdaptiveTimestepper {
+
+  protected:
+    ChState Xs;
+    ChStateDelta Vs;
+    ChStateDelta Acc[7];
+    ChStateDelta Dx;
+    ChStateDelta errX;
+    ChStateDelta errV;
+
+  public:
+    /// Constructors (default empty)
+    ChTimestepperRungeKuttaNystrom(ChIntegrableIIorder* mintegrable = nullptr)
+        : ChTimestepperIIorder(mintegrable), ChExplicitAdaptiveTimestepper() {}
+
+    virtual Type GetType() const override { return Type::RUNGE_KUTTA_NYSTROM; }
+
+    /// Performs an integration timestep, with internal steps of adaptive size.
+    virtual void Advance(const double dt  ///< timestep to advance
+                         ) override;
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+
+    /// Method to allow de serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+};
+
+/// @} chrono_timestepper
+
+}  // end namespace chrono
+
+#endif
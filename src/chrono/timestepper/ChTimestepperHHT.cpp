@@ -82,6 +82,7 @@ void ChTimestepperHHT::Advance(const double dt) {
     numiters = 0;            // total number of NR iterations for this step
     numsetups = 0;
     numsolves = 0;
+    numsetups_avoided = 0;
 
     // If we had a streak of successful steps, consider a stepsize increase.
     // Note that we never attempt a step larger than the specified dt value.
@@ -107,6 +108,7 @@ void ChTimestepperHHT::Advance(const double dt) {
     //   - on a stepsize decrease
     //   - if the Newton iteration does not converge with an out-of-date matrix
     // Otherwise, the matrix is updated at each iteration.
+    // If reusing the Newton matrix across steps (see SetJacobianReuse), these flags are ignored.
     matrix_is_current = false;
     call_setup = true;
 
@@ -114,6 +116,7 @@ void ChTimestepperHHT::Advance(const double dt) {
     while (T < tfinal) {
         double scaling_factor = scaling ? beta * h * h : 1;
         Prepare(mintegrable, scaling_factor);
+        BeginNewtonIteration(mintegrable);
 
         // Newton-Raphson for state at T+h
         bool converged;
@@ -126,12 +129,8 @@ void ChTimestepperHHT::Advance(const double dt) {
             // Solve linear system and increment state
             Increment(mintegrable, scaling_factor);
 
-            // Increment counters
+            // Increment counters (setups and solves are counted in SolveCorrection)
             numiters++;
-            numsolves++;
-            if (call_setup) {
-                numsetups++;
-            }
 
             // If using modified Newton, do not call Setup again
             call_setup = !modified_Newton;
@@ -142,6 +141,8 @@ void ChTimestepperHHT::Advance(const double dt) {
                 break;
         }
 
+        EndNewtonIteration(converged);
+
         if (converged) {
             // ------ NR converged
 
@@ -302,14 +303,13 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
             integrable->LoadConstraint_C(Qc, 1 / (beta * h * h), Qc_do_clamp, Qc_clamping);  //  1/(beta*dt^2)*C
 
             // Solve linear system
-            integrable->StateSolveCorrection(Da, Dl, R, Qc,
-                                             1 / (1 + alpha),    // factor for  M (was 1 in Negrut paper ?!)
-                                             -h * gamma,         // factor for  dF/dv
-                                             -h * h * beta,      // factor for  dF/dx
-                                             Xnew, Vnew, T + h,  // not used here (force_scatter = false)
-                                             false,              // do not scatter states
-                                             call_setup          // call Setup?
-                                             );
+            SolveCorrection(integrable, Da, Dl, R, Qc,
+                            1 / (1 + alpha),    // factor for  M (was 1 in Negrut paper ?!)
+                            -h * gamma,         // factor for  dF/dv
+                            -h * h * beta,      // factor for  dF/dx
+                            Xnew, Vnew, T + h,  // not used here (no scatter)
+                            call_setup          // call Setup? (unless reusing the Newton matrix)
+                            );
 
             // Update estimate of state at t+h
             Lnew += Dl;  // not -= Dl because we assume StateSolveCorrection flips sign of Dl
@@ -327,14 +327,13 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
             integrable->LoadConstraint_C(Qc, 1.0, Qc_do_clamp, Qc_clamping);          //  1/(beta*dt^2)*C
 
             // Solve linear system
-            integrable->StateSolveCorrection(Da, Dl, R, Qc,
-                                             scaling_factor / ((1 + alpha) * beta * h * h),  // factor for  M
-                                             -scaling_factor * gamma / (beta * h),           // factor for  dF/dv
-                                             -scaling_factor,                                // factor for  dF/dx
-                                             Xnew, Vnew, T + h,  // not used here(force_scatter = false)
-                                             false,              // do not scatter states
-                                             call_setup          // call Setup?
-                                             );
+            SolveCorrection(integrable, Da, Dl, R, Qc,
+                            scaling_factor / ((1 + alpha) * beta * h * h),  // factor for  M
+                            -scaling_factor * gamma / (beta * h),           // factor for  dF/dv
+                            -scaling_factor,                                // factor for  dF/dx
+                            Xnew, Vnew, T + h,                              // not used here (no scatter)
+                            call_setup  // call Setup? (unless reusing the Newton matrix)
+                            );
 
             // Update estimate of state at t+h
             Lnew += Dl * (1.0 / scaling_factor);  // not -= Dl because we assume StateSolveCorrection flips sign of Dl
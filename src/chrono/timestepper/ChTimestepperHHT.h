@@ -116,6 +116,7 @@ class ChApi ChTimestepperHHT : public ChTimestepperIIorder, public ChImplicitIte
     /// per step or if the Newton iteration does not converge with an out-of-date matrix.
     /// If disabled, the Newton matrix is evaluated at every iteration of the nonlinear solver.
     /// Modified Newton iteration is enabled by default.
+    /// See also SetJacobianReuse(), to keep the Newton matrix across steps.
     void SetModifiedNewton(bool val) { modified_Newton = val; }
 
     /// Perform an integration timestep.
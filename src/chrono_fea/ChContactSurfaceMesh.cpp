@@ -247,6 +247,11 @@ ChVector<> ChContactTriangleXYZROT::ComputeNormal(const double U, const double V
 //////////////////////////////////////////////////////////////////////////////
 ////  ChContactSurfaceMesh
 
+ChContactSurfaceMesh::ChContactSurfaceMesh(ChMesh* parentmesh)
+    : ChContactSurface(parentmesh),
+      use_single_model(false),
+      mesh_collision_model(new collision::ChModelBulletDeformableMesh) {}
+
 void ChContactSurfaceMesh::AddFacesFromBoundary(double sphere_swept, bool ccw) {
     std::vector<std::array<ChNodeFEAxyz*, 3>> triangles;
     std::vector<std::array<std::shared_ptr<ChNodeFEAxyz>, 3>> triangles_ptrs;
@@ -905,6 +910,10 @@ unsigned int ChContactSurfaceMesh::GetNumVertices() const {
 }
 
 void ChContactSurfaceMesh::SurfaceSyncCollisionModels() {
+    if (use_single_model) {
+        mesh_collision_model->SyncPosition();
+        return;
+    }
     for (unsigned int j = 0; j < vfaces.size(); j++) {
         this->vfaces[j]->GetCollisionModel()->SyncPosition();
     }
@@ -915,6 +924,21 @@ void ChContactSurfaceMesh::SurfaceSyncCollisionModels() {
 
 void ChContactSurfaceMesh::SurfaceAddCollisionModelsToSystem(ChSystem* msys) {
     assert(msys);
+    if (use_single_model) {
+        // The triangle models are not added to the collision system: their proxies are the leaves of the
+        // hierarchy in the collision model of the whole surface.
+        mesh_collision_model->ClearModel();
+        for (unsigned int j = 0; j < vfaces.size(); j++) {
+            mesh_collision_model->AddTriangleModel((collision::ChModelBullet*)this->vfaces[j]->GetCollisionModel());
+        }
+        for (unsigned int j = 0; j < vfaces_rot.size(); j++) {
+            mesh_collision_model->AddTriangleModel(
+                (collision::ChModelBullet*)this->vfaces_rot[j]->GetCollisionModel());
+        }
+        mesh_collision_model->BuildModel();
+        msys->GetCollisionSystem()->Add(mesh_collision_model.get());
+        return;
+    }
     SurfaceSyncCollisionModels();
     for (unsigned int j = 0; j < vfaces.size(); j++) {
         msys->GetCollisionSystem()->Add(this->vfaces[j]->GetCollisionModel());
@@ -926,6 +950,10 @@ void ChContactSurfaceMesh::SurfaceAddCollisionModelsToSystem(ChSystem* msys) {
 
 void ChContactSurfaceMesh::SurfaceRemoveCollisionModelsFromSystem(ChSystem* msys) {
     assert(msys);
+    if (use_single_model) {
+        msys->GetCollisionSystem()->Remove(mesh_collision_model.get());
+        return;
+    }
     for (unsigned int j = 0; j < vfaces.size(); j++) {
         msys->GetCollisionSystem()->Remove(this->vfaces[j]->GetCollisionModel());
     }
@@ -15,11 +15,14 @@
 #ifndef CHCONTACTSURFACEMESH_H
 #define CHCONTACTSURFACEMESH_H
 
+#include <memory>
+
 #include "chrono_fea/ChContactSurface.h"
 #include "chrono_fea/ChNodeFEAxyz.h"
 #include "chrono_fea/ChNodeFEAxyzrot.h"
 #include "chrono/collision/ChCCollisionModel.h"
 #include "chrono/collision/ChCCollisionUtils.h"
+#include "chrono/collision/ChCModelBulletDeformableMesh.h"
 #include "chrono/physics/ChLoaderUV.h"
 
 namespace chrono {
@@ -675,7 +678,7 @@ class ChApiFea ChContactTriangleXYZROT : public ChContactable_3vars<6, 6, 6>, pu
 class ChApiFea ChContactSurfaceMesh : public ChContactSurface {
 
   public:
-    ChContactSurfaceMesh(ChMesh* parentmesh = 0) : ChContactSurface(parentmesh) {}
+    ChContactSurfaceMesh(ChMesh* parentmesh = 0);
 
     virtual ~ChContactSurfaceMesh() {}
 
@@ -718,6 +721,20 @@ class ChApiFea ChContactSurfaceMesh : public ChContactSurface {
     /// Get the number of vertices.
     unsigned int GetNumVertices() const;
 
+    /// Use a single collision model for the whole surface, instead of one collision model per triangle (default:
+    /// false). The single model holds a bounding volume hierarchy over the triangles, refit at each step, so the
+    /// broadphase deals with one object instead of thousands of moving triangles. Contacts are still reported per
+    /// triangle, through ChContactTriangleXYZ and ChContactTriangleXYZROT.
+    /// Note: with a single model, triangles of this surface do not collide with each other.
+    /// This must be set before the mesh is added to the system.
+    void SetUseSingleCollisionModel(bool mval) { use_single_model = mval; }
+
+    /// Tell if a single collision model is used for the whole surface.
+    bool GetUseSingleCollisionModel() const { return use_single_model; }
+
+    /// Get the collision model of the whole surface (used only if SetUseSingleCollisionModel(true)).
+    collision::ChModelBulletDeformableMesh* GetCollisionModel() { return mesh_collision_model.get(); }
+
     // Functions to interface this with ChPhysicsItem container
     virtual void SurfaceSyncCollisionModels();
     virtual void SurfaceAddCollisionModelsToSystem(ChSystem* msys);
@@ -727,6 +744,9 @@ class ChApiFea ChContactSurfaceMesh : public ChContactSurface {
     std::vector<std::shared_ptr<ChContactTriangleXYZ> > vfaces;  //  faces that collide
     std::vector<std::shared_ptr<ChContactTriangleXYZROT> >
         vfaces_rot;  //  faces that collide (for nodes with rotation too)
+
+    bool use_single_model;  // one collision model for all faces
+    std::unique_ptr<collision::ChModelBulletDeformableMesh> mesh_collision_model;  // collision model of all faces
 };
 
 }  // end namespace fea
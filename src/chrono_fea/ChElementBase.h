@@ -75,6 +75,24 @@ class ChApiFea ChElementBase {
     /// CHLDREN CLASSES MUST IMPLEMENT THIS!!!
     virtual void ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor = 0, double Mfactor = 0) = 0;
 
+    /// Adds to y the product H*x, where H = Kfactor*[K] + Rfactor*[R] + Mfactor*[M] at the current state,
+    /// with x and y in the element coordinates (n.rows = n.of dof of element). This is used in the
+    /// matrix-free mode of ChMesh (see ChMesh::SetMatrixFree).
+    /// This default implementation forms H with ComputeKRMmatricesGlobal(); children classes may
+    /// override it with a product that does not need H.
+    virtual void ComputeKRMmatricesProduct(ChMatrix<>& y,
+                                           const ChMatrix<>& x,
+                                           double Kfactor,
+                                           double Rfactor = 0,
+                                           double Mfactor = 0) {
+        int n = GetNdofs();
+        ChMatrixDynamic<> H(n, n);
+        ComputeKRMmatricesGlobal(H, Kfactor, Rfactor, Mfactor);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                y(i) += H(i, j) * x(j);
+    }
+
     /// Computes the internal forces (ex. the actual position of
     /// nodes is not in relaxed reference position) and set values
     /// in the Fi vector, with n.rows = n.of dof of element.
@@ -99,6 +117,12 @@ class ChApiFea ChElementBase {
 	/// that requires integration.
 	virtual void EleDoIntegration() {};
 
+    /// Accept the internal state of the element, such as the plastic history at the integration
+    /// points, at the current nodal positions. This is called by ChMesh::AcceptStep() once per time
+    /// step, after the timestepper completed the step, so elements may compute a trial state at each
+    /// evaluation of the internal forces and commit it only here.
+    virtual void EleCommitState() {}
+
     /// Adds the internal forces (pasted at global nodes offsets) into
     /// a global vector R, multiplied by a scaling factor c, as
     ///   R += forces * c
@@ -109,6 +133,16 @@ class ChApiFea ChElementBase {
     ///   R += M * v * c
     virtual void EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c) {}
 
+    /// Adds the diagonal of a lumped mass matrix of the element (pasted at global nodes offsets) into
+    /// a global vector Md, multiplied by a scaling factor c, as
+    ///   Md += diag(M_lumped) * c
+    /// If hrz is true, use the HRZ (Hinton-Rock-Zienkiewicz) lumping, otherwise sum the rows of M.
+    virtual void EleIntLoadLumpedMass_Md(ChVectorDynamic<>& Md, const double c, bool hrz) {}
+
+    /// Return an estimate of the largest stable step for the explicit integration of this element with a
+    /// lumped mass, or 0 if not available.
+    virtual double ComputeStableTimeStep() { return 0; }
+
     //
     // Functions for interfacing to the solver
     //
@@ -123,6 +157,18 @@ class ChApiFea ChElementBase {
     /// values Kfactor, Rfactor, Mfactor.
     virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) = 0;
 
+    /// Same as InjectKRMmatrices(), but for the matrix-free mode of ChMesh: the ChKblock item(s) do not
+    /// store the matrices, and compute their products with ComputeKRMmatricesProduct().
+    /// By default, falls back to InjectKRMmatrices().
+    virtual void InjectKRMmatricesProduct(ChSystemDescriptor& mdescriptor) { InjectKRMmatrices(mdescriptor); }
+
+    /// Same as KRMmatricesLoad(), but for the matrix-free mode of ChMesh: only the scaling values
+    /// Kfactor, Rfactor, Mfactor are stored, for the products.
+    /// By default, falls back to KRMmatricesLoad().
+    virtual void KRMmatricesProductLoad(double Kfactor, double Rfactor, double Mfactor) {
+        KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+    }
+
     /// Adds the internal forces, expressed as nodal forces, into the
     /// encapsulated ChVariables, in the 'fb' part: qf+=forces*factor
     /// WILL BE DEPRECATED - see EleIntLoadResidual_F
@@ -287,11 +287,12 @@ void ChElementBrick_9::ComputeGravityForce(const ChVector<>& g_acc) {
 // Private class for quadrature of internal forces
 class MyForceBrick9 : public ChIntegrable3D<ChMatrixNM<double, 33, 1>> {
   public:
-    MyForceBrick9(ChElementBrick_9* element) : m_element(element) {}
+    MyForceBrick9(ChElementBrick_9* element) : m_element(element), m_point(0) {}
     ~MyForceBrick9() {}
 
   private:
     ChElementBrick_9* m_element;
+    int m_point;  ///< Integration point counter (up to 8), in the order of evaluation by the quadrature
     virtual void Evaluate(ChMatrixNM<double, 33, 1>& result, const double x, const double y, const double z) override;
 };
 
@@ -483,15 +484,15 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
 
             // Obtain inverse of F^{pT}*F^{p} for plastic formulation
             if (m_element->m_Plasticity) {
-                CCPinv(0, 0) = m_element->m_CCPinv_Plast(0, m_element->m_InteCounter);
-                CCPinv(0, 1) = m_element->m_CCPinv_Plast(1, m_element->m_InteCounter);
-                CCPinv(0, 2) = m_element->m_CCPinv_Plast(2, m_element->m_InteCounter);
-                CCPinv(1, 0) = m_element->m_CCPinv_Plast(3, m_element->m_InteCounter);
-                CCPinv(1, 1) = m_element->m_CCPinv_Plast(4, m_element->m_InteCounter);
-                CCPinv(1, 2) = m_element->m_CCPinv_Plast(5, m_element->m_InteCounter);
-                CCPinv(2, 0) = m_element->m_CCPinv_Plast(6, m_element->m_InteCounter);
-                CCPinv(2, 1) = m_element->m_CCPinv_Plast(7, m_element->m_InteCounter);
-                CCPinv(2, 2) = m_element->m_CCPinv_Plast(8, m_element->m_InteCounter);
+                CCPinv(0, 0) = m_element->m_CCPinv_Plast(0, m_point);
+                CCPinv(0, 1) = m_element->m_CCPinv_Plast(1, m_point);
+                CCPinv(0, 2) = m_element->m_CCPinv_Plast(2, m_point);
+                CCPinv(1, 0) = m_element->m_CCPinv_Plast(3, m_point);
+                CCPinv(1, 1) = m_element->m_CCPinv_Plast(4, m_point);
+                CCPinv(1, 2) = m_element->m_CCPinv_Plast(5, m_point);
+                CCPinv(2, 0) = m_element->m_CCPinv_Plast(6, m_point);
+                CCPinv(2, 1) = m_element->m_CCPinv_Plast(7, m_point);
+                CCPinv(2, 2) = m_element->m_CCPinv_Plast(8, m_point);
             } else {
                 CCPinv(0, 0) = 1.0;
                 CCPinv(1, 1) = 1.0;
@@ -585,7 +586,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                         // Evaluation of J2 yield function
                         YieldFunc = qtrial - (m_element->m_YieldStress +
                                               m_element->m_HardeningSlope *
-                                                  m_element->m_Alpha_Plast(m_element->m_InteCounter, 0));
+                                                  m_element->m_Alpha_Plast(m_point, 0));
 
                         // Set Yield flag to zero (within elastic range)
                         YieldFlag = 0;
@@ -631,21 +632,21 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                             MM3.MatrScale(1 / lambda.z());
 
                             // Keep track of plastic variable alpha for each integration point
-                            m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) =
-                                m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) + DeltaGamma;
+                            m_element->m_Alpha_Plast_trial(m_point, 0) =
+                                m_element->m_Alpha_Plast(m_point, 0) + DeltaGamma;
                             Temp33.MatrMultiply(FI, BEUP);
                             CCPinv.MatrMultiplyT(Temp33, FI);
 
                             // Store plastic deformation tensor for each iteration
-                            m_element->m_CCPinv_Plast(0, m_element->m_InteCounter) = CCPinv(0, 0);
-                            m_element->m_CCPinv_Plast(1, m_element->m_InteCounter) = CCPinv(0, 1);
-                            m_element->m_CCPinv_Plast(2, m_element->m_InteCounter) = CCPinv(0, 2);
-                            m_element->m_CCPinv_Plast(3, m_element->m_InteCounter) = CCPinv(1, 0);
-                            m_element->m_CCPinv_Plast(4, m_element->m_InteCounter) = CCPinv(1, 1);
-                            m_element->m_CCPinv_Plast(5, m_element->m_InteCounter) = CCPinv(1, 2);
-                            m_element->m_CCPinv_Plast(6, m_element->m_InteCounter) = CCPinv(2, 0);
-                            m_element->m_CCPinv_Plast(7, m_element->m_InteCounter) = CCPinv(2, 1);
-                            m_element->m_CCPinv_Plast(8, m_element->m_InteCounter) = CCPinv(2, 2);
+                            m_element->m_CCPinv_Plast_trial(0, m_point) = CCPinv(0, 0);
+                            m_element->m_CCPinv_Plast_trial(1, m_point) = CCPinv(0, 1);
+                            m_element->m_CCPinv_Plast_trial(2, m_point) = CCPinv(0, 2);
+                            m_element->m_CCPinv_Plast_trial(3, m_point) = CCPinv(1, 0);
+                            m_element->m_CCPinv_Plast_trial(4, m_point) = CCPinv(1, 1);
+                            m_element->m_CCPinv_Plast_trial(5, m_point) = CCPinv(1, 2);
+                            m_element->m_CCPinv_Plast_trial(6, m_point) = CCPinv(2, 0);
+                            m_element->m_CCPinv_Plast_trial(7, m_point) = CCPinv(2, 1);
+                            m_element->m_CCPinv_Plast_trial(8, m_point) = CCPinv(2, 2);
                         }
                     } break;
 
@@ -711,7 +712,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                         YieldFunc =
                             J2Rt + eta * hydroP -
                             gsi * (m_element->m_YieldStress +
-                                   m_element->m_HardeningSlope * m_element->m_Alpha_Plast(m_element->m_InteCounter, 0));
+                                   m_element->m_HardeningSlope * m_element->m_Alpha_Plast(m_point, 0));
                         double SQRJ2T = J2Rt;
                         double PT = hydroP;
 
@@ -729,7 +730,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                                 double DDGamma =
                                     Yfunc1 / (G + K * eta * etab + gsi * gsi * m_element->m_HardeningSlope);
                                 DGamma = DGamma + DDGamma;
-                                double EpBar = m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) + gsi * DGamma;
+                                double EpBar = m_element->m_Alpha_Plast(m_point, 0) + gsi * DGamma;
                                 SQRJ2T = SQRJ2T - G * DGamma;
                                 double P = PT - K * etab * DGamma;
                                 Yfunc1 = SQRJ2T + eta * P -
@@ -749,12 +750,12 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                                 double Rtrial = hydroP -
                                                 beta1 * (m_element->m_YieldStress +
                                                          m_element->m_HardeningSlope *
-                                                             m_element->m_Alpha_Plast(m_element->m_InteCounter, 0));
+                                                             m_element->m_Alpha_Plast(m_point, 0));
                                 DeltaGamma = Rtrial / (K + alpha1 * beta1 * m_element->m_HardeningSlope);
 
                                 // Update plastic alpha parameter
-                                m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) =
-                                    m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) + alpha1 * DeltaGamma;
+                                m_element->m_Alpha_Plast_trial(m_point, 0) =
+                                    m_element->m_Alpha_Plast(m_point, 0) + alpha1 * DeltaGamma;
 
                                 // Stress update
                                 StressK_eig(0, 0) = hydroP - K * DeltaGamma;
@@ -766,8 +767,8 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                                 LogStrain.MatrScale(1 / (3.0 * K));
                             } else {
                                 // Update plastic alpha parameter
-                                m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) =
-                                    m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) + gsi * DeltaGamma;
+                                m_element->m_Alpha_Plast_trial(m_point, 0) =
+                                    m_element->m_Alpha_Plast(m_point, 0) + gsi * DeltaGamma;
 
                                 // Deviatoric stress
                                 devStressUp = (1.0 - G * DeltaGamma / J2Rt) * devStress;
@@ -800,15 +801,15 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                             CCPinv.MatrMultiplyT(Temp33, FI);
 
                             // Store plastic deformation tensor for each iteration
-                            m_element->m_CCPinv_Plast(0, m_element->m_InteCounter) = CCPinv(0, 0);
-                            m_element->m_CCPinv_Plast(1, m_element->m_InteCounter) = CCPinv(0, 1);
-                            m_element->m_CCPinv_Plast(2, m_element->m_InteCounter) = CCPinv(0, 2);
-                            m_element->m_CCPinv_Plast(3, m_element->m_InteCounter) = CCPinv(1, 0);
-                            m_element->m_CCPinv_Plast(4, m_element->m_InteCounter) = CCPinv(1, 1);
-                            m_element->m_CCPinv_Plast(5, m_element->m_InteCounter) = CCPinv(1, 2);
-                            m_element->m_CCPinv_Plast(6, m_element->m_InteCounter) = CCPinv(2, 0);
-                            m_element->m_CCPinv_Plast(7, m_element->m_InteCounter) = CCPinv(2, 1);
-                            m_element->m_CCPinv_Plast(8, m_element->m_InteCounter) = CCPinv(2, 2);
+                            m_element->m_CCPinv_Plast_trial(0, m_point) = CCPinv(0, 0);
+                            m_element->m_CCPinv_Plast_trial(1, m_point) = CCPinv(0, 1);
+                            m_element->m_CCPinv_Plast_trial(2, m_point) = CCPinv(0, 2);
+                            m_element->m_CCPinv_Plast_trial(3, m_point) = CCPinv(1, 0);
+                            m_element->m_CCPinv_Plast_trial(4, m_point) = CCPinv(1, 1);
+                            m_element->m_CCPinv_Plast_trial(5, m_point) = CCPinv(1, 2);
+                            m_element->m_CCPinv_Plast_trial(6, m_point) = CCPinv(2, 0);
+                            m_element->m_CCPinv_Plast_trial(7, m_point) = CCPinv(2, 1);
+                            m_element->m_CCPinv_Plast_trial(8, m_point) = CCPinv(2, 2);
                         }
                     } break;
 
@@ -887,7 +888,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                         YieldFunc =
                             J2Rt + eta * hydroP -
                             gsi * (m_element->m_YieldStress +
-                                   m_element->m_HardeningSlope * m_element->m_Alpha_Plast(m_element->m_InteCounter, 0));
+                                   m_element->m_HardeningSlope * m_element->m_Alpha_Plast(m_point, 0));
 
                         // CAP yield function
                         hydroPt = beta1 * m_element->m_YieldStress;
@@ -898,7 +899,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
 
                         // obtain "hardening parameter a"=MeanEffP and "first derivative of a" =Hi
                         m_element->ComputeHardening_a(
-                            MeanEffP, Hi, m_element->m_Alpha_Plast(m_element->m_InteCounter, 0), m_element->m_DPVector1,
+                            MeanEffP, Hi, m_element->m_Alpha_Plast(m_point, 0), m_element->m_DPVector1,
                             m_element->m_DPVector2, m_element->m_DPVector_size);
 
                         YieldFunc_Cap = (1.0 / (m_element->m_DPCapBeta * m_element->m_DPCapBeta)) *
@@ -907,7 +908,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
 
                         double SQRJ2T = J2Rt;
                         double PT = hydroP;
-                        double EPBARN = m_element->m_Alpha_Plast(m_element->m_InteCounter, 0);  // alphUp;
+                        double EPBARN = m_element->m_Alpha_Plast(m_point, 0);  // alphUp;
 
                         YieldFlag = 0;
                         FlagYieldType = 0;
@@ -927,7 +928,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                                     DGamma = DGamma + DDGamma;
                                     SQRJ2T = SQRJ2T - G * DGamma;
                                     double P = PT - K * etab * DGamma;
-                                    double EpBar = m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) + gsi * DGamma;
+                                    double EpBar = m_element->m_Alpha_Plast(m_point, 0) + gsi * DGamma;
                                     Yfunc1 = SQRJ2T + eta * P -
                                              gsi * (m_element->m_YieldStress + m_element->m_HardeningSlope * EpBar);
                                     if (std::abs(Yfunc1) < m_element->GetDPYieldTol())
@@ -946,7 +947,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                                     double Rtrial = hydroP -
                                                     beta1 * (m_element->m_YieldStress +
                                                              m_element->m_HardeningSlope *
-                                                                 m_element->m_Alpha_Plast(m_element->m_InteCounter, 0));
+                                                                 m_element->m_Alpha_Plast(m_point, 0));
                                     DeltaGamma = Rtrial / (K + alpha1 * beta1 * m_element->m_HardeningSlope);
 
                                     // Stress update
@@ -962,8 +963,8 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                                         ((hydroP - K * etab * DeltaGamma) >= hydroPt - MeanEffP)) {
                                         FlagYieldType = 1;
                                         //// Update plastic alpha parameter
-                                        // m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) =
-                                        //	m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) + gsi * DeltaGamma;
+                                        // m_element->m_Alpha_Plast_trial(m_point, 0) =
+                                        //	m_element->m_Alpha_Plast(m_point, 0) + gsi * DeltaGamma;
                                         // Deviatoric stress
                                         devStressUp = (1.0 - G * DeltaGamma / J2Rt) * devStress;
                                         // Hydrostatic stress
@@ -1164,7 +1165,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
 
                                     DeltaGamma = DGamma_A + DGamma_B;
 
-                                    m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) = EPBAR;  //??????
+                                    m_element->m_Alpha_Plast_trial(m_point, 0) = EPBAR;  //??????
 
                                     // Update stress
                                     devStressUp = devS;
@@ -1181,7 +1182,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                                 } else {
                                     FlagYieldType = 3;
 
-                                    m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) = EPBAR;  //??????
+                                    m_element->m_Alpha_Plast_trial(m_point, 0) = EPBAR;  //??????
 
                                     // Update stress
                                     devStressUp = devS;
@@ -1216,15 +1217,15 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
                             MM3.MatrScale(1 / lambda.z());
 
                             // Store plastic deformation tensor for each iteration
-                            m_element->m_CCPinv_Plast(0, m_element->m_InteCounter) = CCPinv(0, 0);
-                            m_element->m_CCPinv_Plast(1, m_element->m_InteCounter) = CCPinv(0, 1);
-                            m_element->m_CCPinv_Plast(2, m_element->m_InteCounter) = CCPinv(0, 2);
-                            m_element->m_CCPinv_Plast(3, m_element->m_InteCounter) = CCPinv(1, 0);
-                            m_element->m_CCPinv_Plast(4, m_element->m_InteCounter) = CCPinv(1, 1);
-                            m_element->m_CCPinv_Plast(5, m_element->m_InteCounter) = CCPinv(1, 2);
-                            m_element->m_CCPinv_Plast(6, m_element->m_InteCounter) = CCPinv(2, 0);
-                            m_element->m_CCPinv_Plast(7, m_element->m_InteCounter) = CCPinv(2, 1);
-                            m_element->m_CCPinv_Plast(8, m_element->m_InteCounter) = CCPinv(2, 2);
+                            m_element->m_CCPinv_Plast_trial(0, m_point) = CCPinv(0, 0);
+                            m_element->m_CCPinv_Plast_trial(1, m_point) = CCPinv(0, 1);
+                            m_element->m_CCPinv_Plast_trial(2, m_point) = CCPinv(0, 2);
+                            m_element->m_CCPinv_Plast_trial(3, m_point) = CCPinv(1, 0);
+                            m_element->m_CCPinv_Plast_trial(4, m_point) = CCPinv(1, 1);
+                            m_element->m_CCPinv_Plast_trial(5, m_point) = CCPinv(1, 2);
+                            m_element->m_CCPinv_Plast_trial(6, m_point) = CCPinv(2, 0);
+                            m_element->m_CCPinv_Plast_trial(7, m_point) = CCPinv(2, 1);
+                            m_element->m_CCPinv_Plast_trial(8, m_point) = CCPinv(2, 2);
 
                         }  // end if of Yield criteria
 
@@ -1271,7 +1272,7 @@ void MyForceBrick9::Evaluate(ChMatrixNM<double, 33, 1>& result, const double x,
             // Obtain generalized elato-(plastic) forces
             result.MatrTMultiply(strainD, Stress);
             result.MatrScale(detJ * m_element->m_GaussScaling);
-            m_element->m_InteCounter++;
+            m_point++;
         } break;
     }
 }
@@ -1283,8 +1284,11 @@ void ChElementBrick_9::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
     m_ddT.MatrMultiplyT(m_d, m_d);
 
     Fi.Reset();
-    // Set plastic counter to zero. This runs for each integration point
-    m_InteCounter = 0;
+    // The return mapping starts from the committed plastic state and writes the trial state, so that the forces
+    // can be evaluated any number of times (Newton iterations, in parallel with other elements) before the step is
+    // accepted. Integration points that stay elastic keep the committed state.
+    m_Alpha_Plast_trial = m_Alpha_Plast;
+    m_CCPinv_Plast_trial = m_CCPinv_Plast;
     ChMatrixNM<double, 33, 1> result;
     MyForceBrick9 formula(this);
     ChQuadrature::Integrate3D<ChMatrixNM<double, 33, 1>>(result,   // result of integration
@@ -1304,27 +1308,66 @@ void ChElementBrick_9::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
 // Calculation of the Jacobian of internal forces
 // -----------------------------------------------------------------------------
 
-// Private class for quadrature of the Jacobian of internal forces
-class MyJacobianBrick9 : public ChIntegrable3D<ChMatrixNM<double, 33, 33>> {
+// Private class for quadrature of the Jacobian of internal forces.
+// With T = ChMatrixNM<double, 33, 33>, the integrand is the Jacobian itself; with T = ChMatrixNM<double, 33, 1>,
+// the integrand is the product of the Jacobian by the vector x given at construction, evaluated without
+// forming the 33x33 matrix at the integration points.
+template <typename T>
+class MyJacobianBrick9 : public ChIntegrable3D<T> {
   public:
-    MyJacobianBrick9(ChElementBrick_9* element,  // Associated element
-                     double Kfactor,             // Scaling coefficient for stiffness component
-                     double Rfactor              // Scaling coefficient for damping component
+    MyJacobianBrick9(ChElementBrick_9* element,      // Associated element
+                     double Kfactor,                 // Scaling coefficient for stiffness component
+                     double Rfactor,                 // Scaling coefficient for damping component
+                     const ChMatrix<>* x = nullptr   // Vector multiplied by the Jacobian (product only)
                      )
-        : m_element(element), m_Kfactor(Kfactor), m_Rfactor(Rfactor) {}
+        : m_element(element), m_Kfactor(Kfactor), m_Rfactor(Rfactor), m_x(x), m_point(0) {}
 
   private:
     ChElementBrick_9* m_element;
     double m_Kfactor;
     double m_Rfactor;
-    ChMatrixNM<double, 33, 33> m_KTE1;
-    ChMatrixNM<double, 33, 33> m_KTE2;
+    const ChMatrix<>* m_x;
+    int m_point;  ///< Integration point counter (up to 8), in the order of evaluation by the quadrature
+
+    virtual void Evaluate(T& result, const double x, const double y, const double z) override;
+
+    // Jacobian at the integration point: scale * [(Kf + Rf*alpha) * temp336 * strainD + Kf * temp339 * Gd]
+    void Finish(ChMatrixNM<double, 33, 33>& result,
+                const ChMatrixNM<double, 33, 6>& temp336,
+                const ChMatrixNM<double, 6, 33>& strainD,
+                const ChMatrixNM<double, 33, 9>& temp339,
+                const ChMatrixNM<double, 9, 33>& Gd,
+                double scale) {
+        ChMatrixNM<double, 33, 33> KTE1;
+        ChMatrixNM<double, 33, 33> KTE2;
+        KTE1.MatrMultiply(temp336, strainD);
+        KTE2.MatrMultiply(temp339, Gd);
+        result = KTE1 * (m_Kfactor + m_Rfactor * m_element->m_Alpha) + KTE2 * m_Kfactor;
+        result.MatrScale(scale);
+    }
 
-    virtual void Evaluate(ChMatrixNM<double, 33, 33>& result, const double x, const double y, const double z) override;
+    // Same as above, multiplied by x: the products are done right to left, without forming the Jacobian.
+    void Finish(ChMatrixNM<double, 33, 1>& result,
+                const ChMatrixNM<double, 33, 6>& temp336,
+                const ChMatrixNM<double, 6, 33>& strainD,
+                const ChMatrixNM<double, 33, 9>& temp339,
+                const ChMatrixNM<double, 9, 33>& Gd,
+                double scale) {
+        ChMatrixNM<double, 6, 1> strainD_x;
+        ChMatrixNM<double, 9, 1> Gd_x;
+        ChMatrixNM<double, 33, 1> KTE2_x;
+        strainD_x.MatrMultiply(strainD, *m_x);
+        Gd_x.MatrMultiply(Gd, *m_x);
+        result.MatrMultiply(temp336, strainD_x);
+        KTE2_x.MatrMultiply(temp339, Gd_x);
+        result = result * (m_Kfactor + m_Rfactor * m_element->m_Alpha) + KTE2_x * m_Kfactor;
+        result.MatrScale(scale);
+    }
 };
 
 // Evaluate integrand at the specified point
-void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double x, const double y, const double z) {
+template <typename T>
+void MyJacobianBrick9<T>::Evaluate(T& result, const double x, const double y, const double z) {
     ChMatrixNM<double, 1, 11> N;
     m_element->ShapeFunctions(N, x, y, z);
 
@@ -1557,11 +1600,7 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
             // Term from  differentiation of Jacobian of strain w.r.t. coordinates w.r.t. coordinates (that is, twice)
             temp339.MatrTMultiply(Gd, Sigm);
             // Sum contributions to the final Jacobian of internal forces
-            m_KTE1.MatrMultiply(temp336, strainD);
-            m_KTE2.MatrMultiply(temp339, Gd);
-
-            result = m_KTE1 * (m_Kfactor + m_Rfactor * m_element->m_Alpha) + m_KTE2 * m_Kfactor;
-            result.MatrScale(detJ0 * m_element->m_GaussScaling);
+            Finish(result, temp336, strainD, temp339, Gd, detJ0 * m_element->m_GaussScaling);
         } break;
         case ChElementBrick_9::Hencky: {
             ChMatrixNM<double, 3, 3> Temp33;  ///< Temporary matrix
@@ -1577,15 +1616,15 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
             ChMatrixNM<double, 3, 3> MM3;     ///< Matrix from outer product of e3
 
             if (m_element->m_Plasticity) {
-                CCPinv(0, 0) = m_element->m_CCPinv_Plast(0, m_element->m_InteCounter);
-                CCPinv(0, 1) = m_element->m_CCPinv_Plast(1, m_element->m_InteCounter);
-                CCPinv(0, 2) = m_element->m_CCPinv_Plast(2, m_element->m_InteCounter);
-                CCPinv(1, 0) = m_element->m_CCPinv_Plast(3, m_element->m_InteCounter);
-                CCPinv(1, 1) = m_element->m_CCPinv_Plast(4, m_element->m_InteCounter);
-                CCPinv(1, 2) = m_element->m_CCPinv_Plast(5, m_element->m_InteCounter);
-                CCPinv(2, 0) = m_element->m_CCPinv_Plast(6, m_element->m_InteCounter);
-                CCPinv(2, 1) = m_element->m_CCPinv_Plast(7, m_element->m_InteCounter);
-                CCPinv(2, 2) = m_element->m_CCPinv_Plast(8, m_element->m_InteCounter);
+                CCPinv(0, 0) = m_element->m_CCPinv_Plast(0, m_point);
+                CCPinv(0, 1) = m_element->m_CCPinv_Plast(1, m_point);
+                CCPinv(0, 2) = m_element->m_CCPinv_Plast(2, m_point);
+                CCPinv(1, 0) = m_element->m_CCPinv_Plast(3, m_point);
+                CCPinv(1, 1) = m_element->m_CCPinv_Plast(4, m_point);
+                CCPinv(1, 2) = m_element->m_CCPinv_Plast(5, m_point);
+                CCPinv(2, 0) = m_element->m_CCPinv_Plast(6, m_point);
+                CCPinv(2, 1) = m_element->m_CCPinv_Plast(7, m_point);
+                CCPinv(2, 2) = m_element->m_CCPinv_Plast(8, m_point);
             } else {
                 CCPinv(0, 0) = 1.0;
                 CCPinv(1, 1) = 1.0;
@@ -1683,7 +1722,7 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
                         // Evaluation of J2 yield function
                         YieldFunc = qtrial - (m_element->m_YieldStress +
                                               m_element->m_HardeningSlope *
-                                                  m_element->m_Alpha_Plast(m_element->m_InteCounter, 0));
+                                                  m_element->m_Alpha_Plast(m_point, 0));
 
                         // Set Yield flag to zero (within elastic range)
                         YieldFlag = 0;
@@ -1800,7 +1839,7 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
                         YieldFunc =
                             J2Rt + eta * hydroP -
                             gsi * (m_element->m_YieldStress +
-                                   m_element->m_HardeningSlope * m_element->m_Alpha_Plast(m_element->m_InteCounter, 0));
+                                   m_element->m_HardeningSlope * m_element->m_Alpha_Plast(m_point, 0));
                         double SQRJ2T = J2Rt;
                         double PT = hydroP;
                         // If YieldFunc > 0.0 there is need for return mapping
@@ -1817,7 +1856,7 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
                                 double DDGamma =
                                     Yfunc1 / (G + K * eta * etab + gsi * gsi * m_element->m_HardeningSlope);
                                 DGamma = DGamma + DDGamma;
-                                double EpBar = m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) + gsi * DGamma;
+                                double EpBar = m_element->m_Alpha_Plast(m_point, 0) + gsi * DGamma;
                                 SQRJ2T = SQRJ2T - G * DGamma;
                                 double P = PT - K * etab * DGamma;
                                 Yfunc1 = SQRJ2T + eta * P -
@@ -1839,7 +1878,7 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
                                 double Rtrial = hydroP -
                                                 beta1 * (m_element->m_YieldStress +
                                                          m_element->m_HardeningSlope *
-                                                             m_element->m_Alpha_Plast(m_element->m_InteCounter, 0));
+                                                             m_element->m_Alpha_Plast(m_point, 0));
                                 DeltaGamma = Rtrial / (K + alpha1 * beta1 * m_element->m_HardeningSlope);
 
                                 // Stress update
@@ -1970,7 +2009,7 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
                         YieldFunc =
                             J2Rt + eta * hydroP -
                             gsi * (m_element->m_YieldStress +
-                                   m_element->m_HardeningSlope * m_element->m_Alpha_Plast(m_element->m_InteCounter, 0));
+                                   m_element->m_HardeningSlope * m_element->m_Alpha_Plast(m_point, 0));
 
                         // CAP yield function
                         hydroPt = beta1 * m_element->m_YieldStress;
@@ -1984,12 +2023,12 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
                         // int mm_DPVector_size=m_element->m_DPVector_size;
                         // double mm_DPCapBeta=m_element->m_DPCapBeta;
 
-                        // alphUp = m_element->m_Alpha_Plast(m_element->m_InteCounter, 0);
+                        // alphUp = m_element->m_Alpha_Plast(m_point, 0);
                         // GetLog() << "m_DPVector1" << mm_DPVector1 << "m_DPVector2" << mm_DPVector2 <<"\n";
 
                         // obtain "hardening parameter a"=MeanEffP and "first derivative of a" =Hi
                         m_element->ComputeHardening_a(
-                            MeanEffP, Hi, m_element->m_Alpha_Plast(m_element->m_InteCounter, 0), m_element->m_DPVector1,
+                            MeanEffP, Hi, m_element->m_Alpha_Plast(m_point, 0), m_element->m_DPVector1,
                             m_element->m_DPVector2, m_element->m_DPVector_size);
 
                         YieldFunc_Cap = (1.0 / (m_element->m_DPCapBeta * m_element->m_DPCapBeta)) *
@@ -1998,7 +2037,7 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
 
                         double SQRJ2T = J2Rt;
                         double PT = hydroP;
-                        double EPBARN = m_element->m_Alpha_Plast(m_element->m_InteCounter, 0);
+                        double EPBARN = m_element->m_Alpha_Plast(m_point, 0);
 
                         YieldFlag = 0;
                         FlagYieldType = 0;
@@ -2018,7 +2057,7 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
                                     DGamma = DGamma + DDGamma;
                                     SQRJ2T = SQRJ2T - G * DGamma;
                                     double P = PT - K * etab * DGamma;
-                                    double EpBar = m_element->m_Alpha_Plast(m_element->m_InteCounter, 0) + gsi * DGamma;
+                                    double EpBar = m_element->m_Alpha_Plast(m_point, 0) + gsi * DGamma;
                                     Yfunc1 = SQRJ2T + eta * P -
                                              gsi * (m_element->m_YieldStress + m_element->m_HardeningSlope * EpBar);
                                     if (std::abs(Yfunc1) < m_element->GetDPYieldTol())
@@ -2037,7 +2076,7 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
                                     double Rtrial = hydroP -
                                                     beta1 * (m_element->m_YieldStress +
                                                              m_element->m_HardeningSlope *
-                                                                 m_element->m_Alpha_Plast(m_element->m_InteCounter, 0));
+                                                                 m_element->m_Alpha_Plast(m_point, 0));
                                     DeltaGamma = Rtrial / (K + alpha1 * beta1 * m_element->m_HardeningSlope);
 
                                     // Stress update
@@ -2554,23 +2593,17 @@ void MyJacobianBrick9::Evaluate(ChMatrixNM<double, 33, 33>& result, const double
 
             temp339.MatrTMultiply(Gd, Sigm);  // Stress contribution to the Jacobian of internal forces
 
-            m_KTE1.MatrMultiply(temp336, strainD);
-            m_KTE2.MatrMultiply(temp339, Gd);
-
-            result = m_KTE1 * (m_Kfactor + m_Rfactor * m_element->m_Alpha) + m_KTE2 * m_Kfactor;
-            result.MatrScale(detJ * m_element->m_GaussScaling);
+            Finish(result, temp336, strainD, temp339, Gd, detJ * m_element->m_GaussScaling);
 
-            m_element->m_InteCounter++;
+            m_point++;
         } break;
     }
 }
 
 // Compute the Jacobian of the internal forces
-void ChElementBrick_9::ComputeInternalJacobians(double Kfactor, double Rfactor) {
-    m_JacobianMatrix.Reset();
-    m_InteCounter = 0;
+void ChElementBrick_9::ComputeInternalJacobians(ChMatrix<>& J, double Kfactor, double Rfactor) {
     ChMatrixNM<double, 33, 33> result;
-    MyJacobianBrick9 formula(this, Kfactor, Rfactor);
+    MyJacobianBrick9<ChMatrixNM<double, 33, 33>> formula(this, Kfactor, Rfactor);
     ChQuadrature::Integrate3D<ChMatrixNM<double, 33, 33>>(result,   // result of integration
                                                           formula,  // integrand formula
                                                           -1, 1,    // x limits
@@ -2578,8 +2611,25 @@ void ChElementBrick_9::ComputeInternalJacobians(double Kfactor, double Rfactor)
                                                           -1, 1,    // z limits
                                                           2         // order of integration
                                                           );
-    // Accumulate Jacobian
-    m_JacobianMatrix += result;
+    J.PasteMatrix(result, 0, 0);
+}
+
+// Add the product of the Jacobian of the internal forces by x
+void ChElementBrick_9::ComputeInternalJacobiansProduct(ChMatrix<>& y,
+                                                       const ChMatrix<>& x,
+                                                       double Kfactor,
+                                                       double Rfactor) {
+    ChMatrixNM<double, 33, 1> result;
+    MyJacobianBrick9<ChMatrixNM<double, 33, 1>> formula(this, Kfactor, Rfactor, &x);
+    ChQuadrature::Integrate3D<ChMatrixNM<double, 33, 1>>(result,   // result of integration
+                                                         formula,  // integrand formula
+                                                         -1, 1,    // x limits
+                                                         -1, 1,    // y limits
+                                                         -1, 1,    // z limits
+                                                         2         // order of integration
+                                                         );
+    for (int i = 0; i < 33; i++)
+        y(i) += result(i);
 }
 
 // -----------------------------------------------------------------------------
@@ -2591,6 +2641,18 @@ void ChElementBrick_9::Update() {
     ChElementGeneric::Update();
 }
 
+// Accept the plastic state at the current nodal positions
+void ChElementBrick_9::EleCommitState() {
+    // The last evaluation of the internal forces by the timestepper may not be at the end-of-step
+    // configuration (ex. linearized implicit Euler): redo the return mapping at the current state.
+    if (m_Plasticity) {
+        ChMatrixDynamic<> Fi(33, 1);
+        ComputeInternalForces(Fi);
+    }
+    m_Alpha_Plast = m_Alpha_Plast_trial;
+    m_CCPinv_Plast = m_CCPinv_Plast_trial;
+}
+
 // Fill the D vector (column matrix) with the current states at the nodes of
 // the element, with proper ordering.
 void ChElementBrick_9::GetStateBlock(ChMatrixDynamic<>& mD) {
@@ -2612,13 +2674,31 @@ void ChElementBrick_9::ComputeMmatrixGlobal(ChMatrix<>& M) {
 void ChElementBrick_9::ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor, double Mfactor) {
     assert((H.GetRows() == 33) && (H.GetColumns() == 33));
 
-    // Calculate the linear combination Kfactor*(K) + Rfactor*(R)
-    ComputeInternalJacobians(Kfactor, Rfactor);
+    // Calculate the linear combination Kfactor*(K) + Rfactor*(R) directly in H
+    ComputeInternalJacobians(H, Kfactor, Rfactor);
 
-    // Load Jac + Mfactor*(M) into H
+    // Add Mfactor*(M)
     for (int i = 0; i < 33; i++)
         for (int j = 0; j < 33; j++)
-            H(i, j) = m_JacobianMatrix(i, j) + Mfactor * m_MassMatrix(i, j);
+            H(i, j) += Mfactor * m_MassMatrix(i, j);
+}
+
+// Add the product by H = Mfactor * (M) + Kfactor * (K) + Rfactor * (R).
+void ChElementBrick_9::ComputeKRMmatricesProduct(ChMatrix<>& y,
+                                                 const ChMatrix<>& x,
+                                                 double Kfactor,
+                                                 double Rfactor,
+                                                 double Mfactor) {
+    assert((y.GetRows() == 33) && (x.GetRows() == 33));
+
+    ComputeInternalJacobiansProduct(y, x, Kfactor, Rfactor);
+
+    for (int i = 0; i < 33; i++) {
+        double sum = 0;
+        for (int j = 0; j < 33; j++)
+            sum += m_MassMatrix(i, j) * x(j);
+        y(i) += Mfactor * sum;
+    }
 }
 
 // -----------------------------------------------------------------------------
@@ -26,6 +26,9 @@
 namespace chrono {
 namespace fea {
 
+template <typename T>
+class MyJacobianBrick9;
+
 /// @addtogroup fea_elements
 /// @{
 
@@ -149,7 +152,10 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
     /// Set Drucker-Prager hardening type.
     void SetDPType(int a) { m_DPHardening = a; }
     /// Set initial strain tensor per integration point of the 9-node element.
-    void SetCCPInitial(ChMatrixNM<double, 9, 8> mat) { m_CCPinv_Plast = mat; }
+    void SetCCPInitial(ChMatrixNM<double, 9, 8> mat) {
+        m_CCPinv_Plast = mat;
+        m_CCPinv_Plast_trial = mat;
+    }
 
     /// Calculate shape functions and their derivatives.
     ///   N = [N1, N2, N3, N4, ...]                               (1x11 row vector)
@@ -236,7 +242,6 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
     bool m_gravity_on;                            ///< enable/disable internal gravity calculation
     ChMatrixNM<double, 33, 1> m_GravForce;        ///< gravitational force
     ChMatrixNM<double, 33, 33> m_MassMatrix;      ///< mass matrix
-    ChMatrixNM<double, 33, 33> m_JacobianMatrix;  ///< Jacobian matrix (Kfactor*[K] + Rfactor*[R])
     double m_GaussScaling;
     double m_Alpha;                      ///< structural damping
     ChMatrixNM<double, 11, 3> m_d0;      ///< initial nodal coordinates (in matrix form)
@@ -257,9 +262,10 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
 
     double m_YieldStress;                     ///< plastic yield stress
     double m_HardeningSlope;                  ///< plastic hardening slope
-    ChMatrixNM<double, 8, 1> m_Alpha_Plast;   ///< hardening alpha parameter
-    ChMatrixNM<double, 9, 8> m_CCPinv_Plast;  ///< strain tensor for each integration point
-    int m_InteCounter;                        ///< Integration point counter (up to 8)
+    ChMatrixNM<double, 8, 1> m_Alpha_Plast;         ///< hardening alpha parameter (committed)
+    ChMatrixNM<double, 9, 8> m_CCPinv_Plast;        ///< strain tensor for each integration point (committed)
+    ChMatrixNM<double, 8, 1> m_Alpha_Plast_trial;   ///< hardening alpha parameter (trial)
+    ChMatrixNM<double, 9, 8> m_CCPinv_Plast_trial;  ///< strain tensor for each integration point (trial)
 
     ChVectorDynamic<double> m_DPVector1;  /// xtab of hardening parameter look-up table
     ChVectorDynamic<double> m_DPVector2;  /// ytab of hardening parameter look-up table
@@ -272,6 +278,9 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
     /// Update this element.
     virtual void Update() override;
 
+    /// Accept the plastic state at the current nodal positions (called by ChMesh at the end of each step).
+    virtual void EleCommitState() override;
+
     /// Fill the D vector (column matrix) with the current states of the element nodes.
     virtual void GetStateBlock(ChMatrixDynamic<>& mD) override;
 
@@ -286,6 +295,14 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
                                           double Rfactor = 0,
                                           double Mfactor = 0) override;
 
+    /// Add the product y += H * x, with H = Kfactor * K + Rfactor * R + Mfactor * M, without forming H.
+    /// The stiffness and damping terms are integrated as products at the Gauss points.
+    virtual void ComputeKRMmatricesProduct(ChMatrix<>& y,
+                                           const ChMatrix<>& x,
+                                           double Kfactor,
+                                           double Rfactor = 0,
+                                           double Mfactor = 0) override;
+
     /// Compute internal forces and load them in the Fi vector.
     virtual void ComputeInternalForces(ChMatrixDynamic<>& Fi) override;
 
@@ -302,9 +319,12 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
     /// This function calculates a linear combination of the stiffness (K) and damping (R) matrices,
     ///     J = Kfactor * K + Rfactor * R
     /// for given coefficients Kfactor and Rfactor.
-    /// This Jacobian will be further combined with the global mass matrix M and included in the global
-    /// stiffness matrix H in the function ComputeKRMmatricesGlobal().
-    void ComputeInternalJacobians(double Kfactor, double Rfactor);
+    /// The Jacobian is written in J (33x33), which is then combined with the global mass matrix M in the
+    /// function ComputeKRMmatricesGlobal(). No copy of the Jacobian is stored in the element.
+    void ComputeInternalJacobians(ChMatrix<>& J, double Kfactor, double Rfactor);
+
+    /// Add the product y += J * x of the Jacobian of the internal forces, without forming J.
+    void ComputeInternalJacobiansProduct(ChMatrix<>& y, const ChMatrix<>& x, double Kfactor, double Rfactor);
 
     /// Calculate the determinant of the initial configuration.
     double Calc_detJ0(double x, double y, double z);
@@ -344,6 +364,7 @@ class ChApiFea ChElementBrick_9 : public ChElementGeneric, public ChLoadableUVW
     friend class MyMassBrick9;
     friend class MyGravityBrick9;
     friend class MyForceBrick9;
+    template <typename T>
     friend class MyJacobianBrick9;
 };
 
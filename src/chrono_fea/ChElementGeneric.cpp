@@ -12,6 +12,9 @@
 // Authors: Alessandro Tasora
 // =============================================================================
 
+#include <algorithm>
+#include <cmath>
+
 #include "chrono_fea/ChElementGeneric.h"
 
 namespace chrono {
@@ -63,6 +66,96 @@ void ChElementGeneric::EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVecto
     }
 }
 
+void ChElementGeneric::ComputeLumpedMass(ChMatrixDynamic<>& Md, bool hrz) {
+    int ndofs = this->GetNdofs();
+    ChMatrixDynamic<> mMi(ndofs, ndofs);
+    this->ComputeMmatrixGlobal(mMi);
+    Md.Reset(ndofs, 1);
+
+    // HRZ matches the coordinates of the nodes by component, so all nodes must have the same size.
+    int nodedofs = GetNodeNdofs(0);
+    for (int in = 1; in < this->GetNnodes(); in++) {
+        if (GetNodeNdofs(in) != nodedofs)
+            hrz = false;
+    }
+
+    if (!hrz) {
+        for (int i = 0; i < ndofs; i++) {
+            for (int j = 0; j < ndofs; j++)
+                Md(i) += mMi(i, j);
+        }
+        return;
+    }
+
+    for (int k = 0; k < nodedofs; k++) {
+        double total = 0;
+        double diagonal = 0;
+        for (int i = k; i < ndofs; i += nodedofs) {
+            diagonal += mMi(i, i);
+            for (int j = k; j < ndofs; j += nodedofs)
+                total += mMi(i, j);
+        }
+        double scale = (diagonal > 0) ? total / diagonal : 0;
+        for (int i = k; i < ndofs; i += nodedofs)
+            Md(i) = scale * mMi(i, i);
+    }
+}
+
+void ChElementGeneric::EleIntLoadLumpedMass_Md(ChVectorDynamic<>& Md, const double c, bool hrz) {
+    ChMatrixDynamic<> mMd;
+    ComputeLumpedMass(mMd, hrz);
+    mMd.MatrScale(c);
+
+    int stride = 0;
+    for (int in = 0; in < this->GetNnodes(); in++) {
+        int nodedofs = GetNodeNdofs(in);
+        if (!GetNodeN(in)->GetFixed())
+            Md.PasteSumClippedMatrix(mMd, stride, 0, nodedofs, 1, GetNodeN(in)->NodeGetOffset_w(), 0);
+        stride += nodedofs;
+    }
+}
+
+double ChElementGeneric::ComputeStableTimeStep() {
+    int ndofs = this->GetNdofs();
+    ChMatrixDynamic<> mKi(ndofs, ndofs);
+    this->ComputeKRMmatricesGlobal(mKi, 1.0, 0, 0);
+    ChMatrixDynamic<> mMd;
+    ComputeLumpedMass(mMd, true);
+
+    // Largest eigenvalue of M^-1*K, i.e. largest squared natural frequency, bounded by the row sums.
+    double max_eig = 0;
+    for (int i = 0; i < ndofs; i++) {
+        if (!(mMd(i) > 0))
+            continue;
+        double row = 0;
+        for (int j = 0; j < ndofs; j++)
+            row += std::abs(mKi(i, j));
+        max_eig = std::max(max_eig, row / mMd(i));
+    }
+
+    return (max_eig > 0) ? 2 / std::sqrt(max_eig) : 0;
+}
+
+void ChElementGeneric::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
+    // The storage may have been released by the matrix-free mode
+    int n = this->GetNdofs();
+    if (this->Kmatr.Get_K()->GetRows() != n)
+        this->Kmatr.Get_K()->Resize(n, n);
+
+    this->ComputeKRMmatricesGlobal(*this->Kmatr.Get_K(), Kfactor, Rfactor, Mfactor);
+}
+
+void ChElementGeneric::InjectKRMmatricesProduct(ChSystemDescriptor& mdescriptor) {
+    std::vector<ChVariables*> mvars(this->Kmatr.GetNvars());
+    for (unsigned int iv = 0; iv < mvars.size(); iv++)
+        mvars[iv] = this->Kmatr.GetVariableN(iv);
+    this->Kproduct.SetVariables(mvars);
+
+    this->Kmatr.Get_K()->Resize(0, 0);
+
+    mdescriptor.InsertKblock(&Kproduct);
+}
+
 void ChElementGeneric::VariablesFbLoadInternalForces(double factor) {
     throw(ChException("ChElementGeneric::VariablesFbLoadInternalForces is deprecated"));
     /*
@@ -16,6 +16,7 @@
 #define CHELEMENTGENERIC_H
 
 #include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChKblockMatrixFree.h"
 #include "chrono/solver/ChVariablesNode.h"
 #include "chrono_fea/ChElementBase.h"
 
@@ -34,10 +35,30 @@ namespace fea {
 ///	ComputeKRMmatricesGlobal(), ComputeInternalForces()
 class ChApiFea ChElementGeneric : public ChElementBase {
   protected:
+    /// Products by the K, R, M matrices of the element, for the matrix-free mode.
+    class ChApiFea KRMproduct : public ChKblockMatrixFree::Operator {
+      public:
+        KRMproduct(ChElementGeneric* element) : m_element(element), Kfactor(0), Rfactor(0), Mfactor(0) {}
+
+        virtual void MultiplyAndAdd(ChMatrix<double>& y, const ChMatrix<double>& x) override {
+            m_element->ComputeKRMmatricesProduct(y, x, Kfactor, Rfactor, Mfactor);
+        }
+        virtual void ComputeMatrix(ChMatrix<double>& H) override {
+            m_element->ComputeKRMmatricesGlobal(H, Kfactor, Rfactor, Mfactor);
+        }
+
+        ChElementGeneric* m_element;
+        double Kfactor;
+        double Rfactor;
+        double Mfactor;
+    };
+
     ChKblockGeneric Kmatr;
+    KRMproduct Kproduct_operator;
+    ChKblockMatrixFree Kproduct;
 
   public:
-    ChElementGeneric(){};
+    ChElementGeneric() : Kproduct_operator(this) { Kproduct.SetOperator(&Kproduct_operator); }
     virtual ~ChElementGeneric(){};
 
     /// Access the proxy to stiffness, for sparse solver
@@ -55,6 +76,19 @@ class ChApiFea ChElementGeneric : public ChElementBase {
     /// implementing this EleIntLoadResidual_Mv function, unless you need faster code.)
     virtual void EleIntLoadResidual_Mv(ChVectorDynamic<>& R, const ChVectorDynamic<>& w, const double c) override;
 
+    /// (This is a default book keeping, based on ComputeMmatrixGlobal(). The HRZ lumping takes the diagonal
+    /// of M, scaled so that, for each nodal coordinate, the sum over the nodes equals the sum of the
+    /// corresponding block of M; it falls back to the row sums if the nodes have different sizes.)
+    virtual void EleIntLoadLumpedMass_Md(ChVectorDynamic<>& Md, const double c, bool hrz) override;
+
+    /// (This is a default estimate, based on ComputeKRMmatricesGlobal(): it bounds the largest eigenvalue of
+    /// M_lumped^-1*K with the Gershgorin theorem, so it is conservative. Children classes may override it
+    /// with an estimate from the element size and the wave speed.)
+    virtual double ComputeStableTimeStep() override;
+
+    /// Compute the diagonal of the lumped mass matrix of the element (see EleIntLoadLumpedMass_Md).
+    void ComputeLumpedMass(ChMatrixDynamic<>& Md, bool hrz);
+
     //
     // FEM functions
     //
@@ -75,8 +109,17 @@ class ChApiFea ChElementGeneric : public ChElementBase {
     /// Adds the current stiffness K and damping R and mass M matrices in encapsulated
     /// ChKblock item(s), if any. The K, R, M matrices are load with scaling
     /// values Kfactor, Rfactor, Mfactor.
-    virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override {
-        this->ComputeKRMmatricesGlobal(*this->Kmatr.Get_K(), Kfactor, Rfactor, Mfactor);
+    virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
+
+    /// Tell to a system descriptor that there is a matrix-free ChKblock in this object. The storage of
+    /// the matrix in the ChKblockGeneric item is released, until KRMmatricesLoad() is called again.
+    virtual void InjectKRMmatricesProduct(ChSystemDescriptor& mdescriptor) override;
+
+    /// Store the scaling values Kfactor, Rfactor, Mfactor for the products of the matrix-free ChKblock.
+    virtual void KRMmatricesProductLoad(double Kfactor, double Rfactor, double Mfactor) override {
+        Kproduct_operator.Kfactor = Kfactor;
+        Kproduct_operator.Rfactor = Rfactor;
+        Kproduct_operator.Mfactor = Mfactor;
     }
 
     /// Adds the internal forces, expressed as nodal forces, into the
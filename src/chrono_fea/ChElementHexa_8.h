@@ -15,6 +15,9 @@
 #ifndef CHELEMENTHEXA8_H
 #define CHELEMENTHEXA8_H
 
+#include <algorithm>
+#include <cmath>
+
 #include "chrono_fea/ChElementHexahedron.h"
 #include "chrono_fea/ChNodeFEAxyz.h"
 
@@ -551,6 +554,36 @@ class ChApiFea ChElementHexa_8 : public ChElementHexahedron, public ChLoadableUV
 
     /// This is needed so that it can be accessed by ChLoaderVolumeGravity
     virtual double GetDensity() override { return this->Material->Get_density(); }
+
+    /// Estimate of the stable step for explicit integration: the characteristic length of the element
+    /// (volume over largest face area, in the current configuration) over the speed of the dilatational
+    /// waves in the material.
+    virtual double ComputeStableTimeStep() override {
+        ChVector<> p[8];
+        for (int i = 0; i < 8; i++)
+            p[i] = nodes[i]->GetPos();
+
+        // volume, from 6 tetrahedrons around the diagonal 0-6
+        static const int tets[6][2] = {{1, 2}, {2, 3}, {3, 7}, {7, 4}, {4, 5}, {5, 1}};
+        double volume = 0;
+        for (int t = 0; t < 6; t++)
+            volume += Vdot(p[tets[t][0]] - p[0], Vcross(p[tets[t][1]] - p[0], p[6] - p[0])) / 6;
+        volume = std::abs(volume);
+
+        // face areas, from the diagonals
+        static const int faces[6][4] = {{0, 1, 2, 3}, {4, 5, 6, 7}, {0, 1, 5, 4},
+                                        {1, 2, 6, 5}, {2, 3, 7, 6}, {3, 0, 4, 7}};
+        double max_area = 0;
+        for (int f = 0; f < 6; f++) {
+            ChVector<> d1 = p[faces[f][2]] - p[faces[f][0]];
+            ChVector<> d2 = p[faces[f][3]] - p[faces[f][1]];
+            max_area = std::max(max_area, Vcross(d1, d2).Length() / 2);
+        }
+
+        double wave_speed =
+            std::sqrt((Material->Get_l() + 2 * Material->Get_G()) / Material->Get_density());
+        return (max_area > 0) ? volume / max_area / wave_speed : 0;
+    }
 };
 
 /// @} fea_elements
@@ -35,7 +35,7 @@ const int ChElementShellANCF::m_maxIterationsEAS = 100;
 // ------------------------------------------------------------------------------
 
 ChElementShellANCF::ChElementShellANCF()
-    : m_gravity_on(false), m_numLayers(0), m_thickness(0), m_lenX(0), m_lenY(0), m_Alpha(0) {
+    : m_gravity_on(false), m_numLayers(0), m_thickness(0), m_lenX(0), m_lenY(0), m_Alpha(0), m_vectorized(false) {
     m_nodes.resize(4);
 }
 
@@ -110,6 +110,10 @@ void ChElementShellANCF::SetupInitial(ChSystem* system) {
     // Cache the scaling factor (due to change of integration intervals)
     m_GaussScaling = (m_lenX * m_lenY * m_thickness) / 8;
 
+    // Cache the Gauss point data used by the vectorized kernels
+    if (m_vectorized)
+        CalcLayerGaussPoints();
+
     // Compute mass matrix and gravitational forces (constant)
     ComputeMassMatrix();
     ComputeGravityForce(system->Get_G_acc());
@@ -137,13 +141,36 @@ void ChElementShellANCF::GetStateBlock(ChMatrixDynamic<>& mD) {
 void ChElementShellANCF::ComputeKRMmatricesGlobal(ChMatrix<>& H, double Kfactor, double Rfactor, double Mfactor) {
     assert((H.GetRows() == 24) && (H.GetColumns() == 24));
 
-    // Calculate the linear combination Kfactor*[K] + Rfactor*[R]
-    ComputeInternalJacobians(Kfactor, Rfactor);
+    // Calculate the linear combination Kfactor*[K] + Rfactor*[R] directly in H
+    ComputeInternalJacobians(H, Kfactor, Rfactor);
 
-    // Load Jac + Mfactor*[M] into H
+    // Add Mfactor*[M]
     for (int i = 0; i < 24; i++)
         for (int j = 0; j < 24; j++)
-            H(i, j) = m_JacobianMatrix(i, j) + Mfactor * m_MassMatrix(i, j);
+            H(i, j) += Mfactor * m_MassMatrix(i, j);
+}
+
+// Add the product by H = Mfactor * [M] + Kfactor * [K] + Rfactor * [R].
+void ChElementShellANCF::ComputeKRMmatricesProduct(ChMatrix<>& y,
+                                                   const ChMatrix<>& x,
+                                                   double Kfactor,
+                                                   double Rfactor,
+                                                   double Mfactor) {
+    assert((y.GetRows() == 24) && (x.GetRows() == 24));
+
+    if (!m_vectorized) {
+        ChElementGeneric::ComputeKRMmatricesProduct(y, x, Kfactor, Rfactor, Mfactor);
+        return;
+    }
+
+    ComputeInternalJacobiansProductVectorized(y, x, Kfactor, Rfactor);
+
+    for (int i = 0; i < 24; i++) {
+        double sum = 0;
+        for (int j = 0; j < 24; j++)
+            sum += m_MassMatrix(i, j) * x(j);
+        y(i) += Mfactor * sum;
+    }
 }
 
 // Return the mass matrix.
@@ -587,6 +614,11 @@ void MyForce::Evaluate(ChMatrixNM<double, 54, 1>& result, const double x, const
 }
 
 void ChElementShellANCF::ComputeInternalForces(ChMatrixDynamic<>& Fi) {
+    if (m_vectorized) {
+        ComputeInternalForcesVectorized(Fi);
+        return;
+    }
+
     // Current nodal coordinates and velocities
     CalcCoordMatrix(m_d);
     CalcCoordDerivMatrix(m_d_dt);
@@ -1046,13 +1078,18 @@ void MyJacobian::Evaluate(ChMatrixNM<double, 696, 1>& result, const double x, co
     result.PasteClippedMatrixToVector(GDEPSP, 0, 0, 5, 24, 576);
 }
 
-void ChElementShellANCF::ComputeInternalJacobians(double Kfactor, double Rfactor) {
+void ChElementShellANCF::ComputeInternalJacobians(ChMatrix<>& J, double Kfactor, double Rfactor) {
     // Note that the matrices with current nodal coordinates and velocities are
     // already available in m_d and m_d_dt (as set in ComputeInternalForces).
     // Similarly, the ANS strain and strain derivatives are already available in
     // m_strainANS and m_strainANS_D (as calculated in ComputeInternalForces).
 
-    m_JacobianMatrix.Reset();
+    if (m_vectorized) {
+        ComputeInternalJacobiansVectorized(J, Kfactor, Rfactor);
+        return;
+    }
+
+    J.Reset();
 
     // Loop over all layers.
     for (size_t kl = 0; kl < m_numLayers; kl++) {
@@ -1079,7 +1116,523 @@ void ChElementShellANCF::ComputeInternalJacobians(double Kfactor, double Rfactor
         EAS.MatrTMultiply(GDEPSP, KalphaEAS_inv * GDEPSP);
 
         // Accumulate Jacobian
-        m_JacobianMatrix += KTE - EAS * Kfactor;
+        J += KTE - EAS * Kfactor;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Vectorized Gauss point kernels
+// -----------------------------------------------------------------------------
+
+// The functions below evaluate the same integrands as MyForce and MyJacobian, but for all the
+// Gauss points of a layer at once. The quantities that depend only on the reference configuration
+// are cached at SetupInitial, and the arrays are laid out with the Gauss point index last, so that
+// the innermost loops run over contiguous data and can be vectorized by the compiler.
+
+void ChElementShellANCF::CalcLayerGaussPoints() {
+    // Gauss points and weights of order 2 (as used by Integrate3D in the default path)
+    const std::vector<double>& lroots = ChQuadrature::GetStaticTables()->Lroots[1];
+    const std::vector<double>& weight = ChQuadrature::GetStaticTables()->Weight[1];
+
+    m_layerGP.resize(m_numLayers);
+
+    for (size_t kl = 0; kl < m_numLayers; kl++) {
+        LayerGaussPoints& gp = m_layerGP[kl];
+        gp.KalphaEAS.Reset();
+
+        const ChMatrixNM<double, 6, 6>& T0 = GetLayer(kl).Get_T0();
+        const ChMatrixNM<double, 6, 6>& E_eps = GetLayer(kl).GetMaterial()->Get_E_eps();
+        double detJ0C = GetLayer(kl).Get_detJ0C();
+        double theta = GetLayer(kl).Get_theta();
+
+        // Change of integration interval in the z direction (x and y are in [-1,1])
+        double Zc1 = (m_GaussZ[kl + 1] - m_GaussZ[kl]) / 2;
+        double Zc2 = (m_GaussZ[kl + 1] + m_GaussZ[kl]) / 2;
+
+        for (int ix = 0; ix < 2; ix++) {
+            for (int iy = 0; iy < 2; iy++) {
+                for (int iz = 0; iz < 2; iz++) {
+                    int p = 4 * ix + 2 * iy + iz;
+                    double x = lroots[ix];
+                    double y = lroots[iy];
+                    double z = Zc1 * lroots[iz] + Zc2;
+
+                    ChMatrixNM<double, 1, 8> N;
+                    ShapeFunctions(N, x, y, z);
+
+                    ChMatrixNM<double, 1, 8> Nx;
+                    ChMatrixNM<double, 1, 8> Ny;
+                    ChMatrixNM<double, 1, 8> Nz;
+                    ChMatrixNM<double, 1, 3> Nx_d0;
+                    ChMatrixNM<double, 1, 3> Ny_d0;
+                    ChMatrixNM<double, 1, 3> Nz_d0;
+                    double detJ0 = Calc_detJ0(x, y, z, Nx, Ny, Nz, Nx_d0, Ny_d0, Nz_d0);
+
+                    ChMatrixNM<double, 1, 4> S_ANS;
+                    ChMatrixNM<double, 6, 5> M;
+                    ShapeFunctionANSbilinearShell(S_ANS, x, y);
+                    Basis_M(M, x, y, z);
+
+                    // Tangent frame and direction for orthotropic material
+                    ChVector<double> rx0(Nx_d0(0, 0), Nx_d0(0, 1), Nx_d0(0, 2));
+                    ChVector<double> ry0(Ny_d0(0, 0), Ny_d0(0, 1), Ny_d0(0, 2));
+                    ChVector<double> G1xG2 = Vcross(rx0, ry0);
+                    ChVector<double> A1 = rx0.GetNormalized();
+                    ChVector<double> A3 = G1xG2.GetNormalized();
+                    ChVector<double> A2 = Vcross(A3, A1);
+                    ChVector<double> AA1 = A1 * cos(theta) + A2 * sin(theta);
+                    ChVector<double> AA2 = -A1 * sin(theta) + A2 * cos(theta);
+                    ChVector<double> AA3 = A3;
+
+                    // Inverse of the initial position vector gradient
+                    ChMatrixNM<double, 3, 3> j0;
+                    j0(0, 0) = Ny_d0(0, 1) * Nz_d0(0, 2) - Nz_d0(0, 1) * Ny_d0(0, 2);
+                    j0(0, 1) = Ny_d0(0, 2) * Nz_d0(0, 0) - Ny_d0(0, 0) * Nz_d0(0, 2);
+                    j0(0, 2) = Ny_d0(0, 0) * Nz_d0(0, 1) - Nz_d0(0, 0) * Ny_d0(0, 1);
+                    j0(1, 0) = Nz_d0(0, 1) * Nx_d0(0, 2) - Nx_d0(0, 1) * Nz_d0(0, 2);
+                    j0(1, 1) = Nz_d0(0, 2) * Nx_d0(0, 0) - Nx_d0(0, 2) * Nz_d0(0, 0);
+                    j0(1, 2) = Nz_d0(0, 0) * Nx_d0(0, 1) - Nz_d0(0, 1) * Nx_d0(0, 0);
+                    j0(2, 0) = Nx_d0(0, 1) * Ny_d0(0, 2) - Ny_d0(0, 1) * Nx_d0(0, 2);
+                    j0(2, 1) = Ny_d0(0, 0) * Nx_d0(0, 2) - Nx_d0(0, 0) * Ny_d0(0, 2);
+                    j0(2, 2) = Nx_d0(0, 0) * Ny_d0(0, 1) - Ny_d0(0, 0) * Nx_d0(0, 1);
+                    j0.MatrDivScale(detJ0);
+
+                    ChVector<double> j01(j0(0, 0), j0(0, 1), j0(0, 2));
+                    ChVector<double> j02(j0(1, 0), j0(1, 1), j0(1, 2));
+                    ChVector<double> j03(j0(2, 0), j0(2, 1), j0(2, 2));
+
+                    // Coefficients of contravariant transformation
+                    double beta[9] = {Vdot(AA1, j01), Vdot(AA2, j01), Vdot(AA3, j01),  //
+                                      Vdot(AA1, j02), Vdot(AA2, j02), Vdot(AA3, j02),  //
+                                      Vdot(AA1, j03), Vdot(AA2, j03), Vdot(AA3, j03)};
+
+                    // Strain transformation for orthotropic material (rows as in MyForce)
+                    int ij[6][2] = {{0, 0}, {1, 1}, {0, 1}, {2, 2}, {0, 2}, {1, 2}};
+                    for (int r = 0; r < 6; r++) {
+                        int a = ij[r][0];
+                        int b = ij[r][1];
+                        double f = (a == b) ? 1.0 : 2.0;
+                        double h = f / 2;
+                        gp.T[r][0][p] = f * beta[a] * beta[b];
+                        gp.T[r][1][p] = f * beta[3 + a] * beta[3 + b];
+                        gp.T[r][2][p] = h * (beta[b] * beta[3 + a] + beta[a] * beta[3 + b]);
+                        gp.T[r][3][p] = f * beta[6 + a] * beta[6 + b];
+                        gp.T[r][4][p] = h * (beta[b] * beta[6 + a] + beta[a] * beta[6 + b]);
+                        gp.T[r][5][p] = h * (beta[3 + b] * beta[6 + a] + beta[3 + a] * beta[6 + b]);
+                    }
+
+                    for (int i = 0; i < 4; i++) {
+                        gp.N[i][p] = N(0, 2 * i);
+                        gp.S_ANS[i][p] = S_ANS(0, i);
+                    }
+                    for (int i = 0; i < 8; i++) {
+                        gp.Nx[i][p] = Nx(0, i);
+                        gp.Ny[i][p] = Ny(0, i);
+                        for (int c = 0; c < 3; c++)
+                            gp.Gd[c][i][p] = j0(0, c) * Nx(0, i) + j0(1, c) * Ny(0, i) + j0(2, c) * Nz(0, i);
+                    }
+
+                    gp.strain0[0][p] = 0.5 * Vdot(rx0, rx0);
+                    gp.strain0[1][p] = 0.5 * Vdot(ry0, ry0);
+                    gp.strain0[2][p] = Vdot(rx0, ry0);
+
+                    // Enhanced Assumed Strain
+                    ChMatrixNM<double, 6, 5> G = T0 * M * (detJ0C / detJ0);
+                    double w = weight[ix] * weight[iy] * weight[iz] * Zc1 * detJ0 * m_GaussScaling;
+                    ChMatrixNM<double, 5, 6> GE;
+                    GE.MatrTMultiply(G, E_eps);
+                    GE *= w;
+                    gp.KalphaEAS += GE * G;
+
+                    for (int r = 0; r < 6; r++) {
+                        for (int a = 0; a < 5; a++) {
+                            gp.G[r][a][p] = G(r, a);
+                            gp.GE[a][r][p] = GE(a, r);
+                        }
+                    }
+                    gp.weight[p] = w;
+                }
+            }
+        }
+    }
+}
+
+void ChElementShellANCF::CalcStrainGaussPoints(size_t kl, double strain[6][m_numGP], double strainD[6][24][m_numGP]) {
+    const LayerGaussPoints& gp = m_layerGP[kl];
+
+    // Current position vector gradients r_x = Nx * d and r_y = Ny * d
+    double rx[3][m_numGP] = {};
+    double ry[3][m_numGP] = {};
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 3; j++) {
+            double dij = m_d(i, j);
+            for (int p = 0; p < m_numGP; p++) {
+                rx[j][p] += gp.Nx[i][p] * dij;
+                ry[j][p] += gp.Ny[i][p] * dij;
+            }
+        }
+    }
+
+    // Strain components, in the local frame (ANS for the transverse components)
+    double strain_til[6][m_numGP];
+    for (int p = 0; p < m_numGP; p++) {
+        strain_til[0][p] = 0.5 * (rx[0][p] * rx[0][p] + rx[1][p] * rx[1][p] + rx[2][p] * rx[2][p]) - gp.strain0[0][p];
+        strain_til[1][p] = 0.5 * (ry[0][p] * ry[0][p] + ry[1][p] * ry[1][p] + ry[2][p] * ry[2][p]) - gp.strain0[1][p];
+        strain_til[2][p] = (rx[0][p] * ry[0][p] + rx[1][p] * ry[1][p] + rx[2][p] * ry[2][p]) - gp.strain0[2][p];
+        strain_til[3][p] = gp.N[0][p] * m_strainANS(0, 0) + gp.N[1][p] * m_strainANS(1, 0) +
+                           gp.N[2][p] * m_strainANS(2, 0) + gp.N[3][p] * m_strainANS(3, 0);
+        strain_til[4][p] = gp.S_ANS[2][p] * m_strainANS(6, 0) + gp.S_ANS[3][p] * m_strainANS(7, 0);
+        strain_til[5][p] = gp.S_ANS[0][p] * m_strainANS(4, 0) + gp.S_ANS[1][p] * m_strainANS(5, 0);
+    }
+
+    // Strain derivatives, in the local frame
+    double strainD_til[6][24][m_numGP];
+    for (int i = 0; i < 8; i++) {
+        for (int j = 0; j < 3; j++) {
+            for (int p = 0; p < m_numGP; p++) {
+                strainD_til[0][3 * i + j][p] = rx[j][p] * gp.Nx[i][p];
+                strainD_til[1][3 * i + j][p] = ry[j][p] * gp.Ny[i][p];
+                strainD_til[2][3 * i + j][p] = ry[j][p] * gp.Nx[i][p] + rx[j][p] * gp.Ny[i][p];
+            }
+        }
+    }
+    for (int c = 0; c < 24; c++) {
+        for (int p = 0; p < m_numGP; p++) {
+            strainD_til[3][c][p] = gp.N[0][p] * m_strainANS_D(0, c) + gp.N[1][p] * m_strainANS_D(1, c) +
+                                   gp.N[2][p] * m_strainANS_D(2, c) + gp.N[3][p] * m_strainANS_D(3, c);
+            strainD_til[4][c][p] = gp.S_ANS[2][p] * m_strainANS_D(6, c) + gp.S_ANS[3][p] * m_strainANS_D(7, c);
+            strainD_til[5][c][p] = gp.S_ANS[0][p] * m_strainANS_D(4, c) + gp.S_ANS[1][p] * m_strainANS_D(5, c);
+        }
+    }
+
+    // Orthotropic transformation
+    for (int r = 0; r < 6; r++) {
+        for (int p = 0; p < m_numGP; p++) {
+            strain[r][p] = gp.T[r][0][p] * strain_til[0][p] + gp.T[r][1][p] * strain_til[1][p] +
+                           gp.T[r][2][p] * strain_til[2][p] + gp.T[r][3][p] * strain_til[3][p] +
+                           gp.T[r][4][p] * strain_til[4][p] + gp.T[r][5][p] * strain_til[5][p];
+        }
+    }
+    for (int r = 0; r < 6; r++) {
+        for (int c = 0; c < 24; c++) {
+            // As in MyForce and MyJacobian, the last term of the zz row uses the (0,5) entry of strainD_til.
+            const double* last = (r == 3) ? strainD_til[0][5] : strainD_til[5][c];
+            for (int p = 0; p < m_numGP; p++) {
+                strainD[r][c][p] = gp.T[r][0][p] * strainD_til[0][c][p] + gp.T[r][1][p] * strainD_til[1][c][p] +
+                                   gp.T[r][2][p] * strainD_til[2][c][p] + gp.T[r][3][p] * strainD_til[3][c][p] +
+                                   gp.T[r][4][p] * strainD_til[4][c][p] + gp.T[r][5][p] * last[p];
+            }
+        }
+    }
+
+    // Structural damping
+    for (int r = 0; r < 6; r++) {
+        double deps[m_numGP] = {};
+        for (int c = 0; c < 24; c++) {
+            double v = m_d_dt(c, 0);
+            for (int p = 0; p < m_numGP; p++)
+                deps[p] += strainD[r][c][p] * v;
+        }
+        for (int p = 0; p < m_numGP; p++)
+            strain[r][p] += m_Alpha * deps[p];
+    }
+}
+
+void ChElementShellANCF::ComputeInternalForcesVectorized(ChMatrixDynamic<>& Fi) {
+    // Current nodal coordinates and velocities
+    CalcCoordMatrix(m_d);
+    CalcCoordDerivMatrix(m_d_dt);
+    m_ddT.MatrMultiplyT(m_d, m_d);
+    // Assumed Natural Strain (ANS):  Calculate m_strainANS and m_strainANS_D
+    CalcStrainANSbilinearShell();
+
+    Fi.Reset();
+
+    for (size_t kl = 0; kl < m_numLayers; kl++) {
+        const LayerGaussPoints& gp = m_layerGP[kl];
+        const ChMatrixNM<double, 6, 6>& E_eps = GetLayer(kl).GetMaterial()->Get_E_eps();
+
+        // Strains without EAS contribution and strain derivatives: they do not depend on the EAS
+        // parameters, so only the EAS strains are updated in the Newton loop.
+        double strain0[6][m_numGP];
+        double strainD[6][24][m_numGP];
+        CalcStrainGaussPoints(kl, strain0, strainD);
+
+        // Initial guess for EAS parameters
+        ChMatrixNM<double, 5, 1> alphaEAS = m_alphaEAS[kl];
+
+        // Newton loop for EAS
+        double strain[6][m_numGP];
+        for (int count = 0; count < m_maxIterationsEAS; count++) {
+            for (int r = 0; r < 6; r++) {
+                for (int p = 0; p < m_numGP; p++) {
+                    strain[r][p] = strain0[r][p] + gp.G[r][0][p] * alphaEAS(0) + gp.G[r][1][p] * alphaEAS(1) +
+                                   gp.G[r][2][p] * alphaEAS(2) + gp.G[r][3][p] * alphaEAS(3) +
+                                   gp.G[r][4][p] * alphaEAS(4);
+                }
+            }
+
+            // EAS residual
+            ChMatrixNM<double, 5, 1> HE;
+            for (int a = 0; a < 5; a++) {
+                double sum = 0;
+                for (int r = 0; r < 6; r++)
+                    for (int p = 0; p < m_numGP; p++)
+                        sum += gp.GE[a][r][p] * strain[r][p];
+                HE(a) = sum;
+            }
+
+            // Check convergence (residual check)
+            double norm_HE = HE.NormTwo();
+            if (norm_HE < m_toleranceEAS)
+                break;
+
+            // Calculate increment (in place) and update EAS parameters
+            ChMatrixNM<int, 5, 1> INDX;
+            bool pivoting;
+            ChMatrixNM<double, 5, 5> KALPHA1 = gp.KalphaEAS;
+            if (!LU_factor(KALPHA1, INDX, pivoting))
+                throw ChException("Singular matrix in LU factorization");
+            LU_solve(KALPHA1, INDX, HE);
+            alphaEAS = alphaEAS - HE;
+
+            if (count >= 2)
+                GetLog() << "  count " << count << "  NormHE " << norm_HE << "\n";
+        }
+
+        // Weighted stresses, at the strains of the last EAS evaluation
+        double stress[6][m_numGP];
+        for (int r = 0; r < 6; r++) {
+            for (int p = 0; p < m_numGP; p++) {
+                stress[r][p] = gp.weight[p] * (E_eps(r, 0) * strain[0][p] + E_eps(r, 1) * strain[1][p] +
+                                               E_eps(r, 2) * strain[2][p] + E_eps(r, 3) * strain[3][p] +
+                                               E_eps(r, 4) * strain[4][p] + E_eps(r, 5) * strain[5][p]);
+            }
+        }
+
+        // Accumulate internal force
+        for (int c = 0; c < 24; c++) {
+            double sum = 0;
+            for (int r = 0; r < 6; r++)
+                for (int p = 0; p < m_numGP; p++)
+                    sum += strainD[r][c][p] * stress[r][p];
+            Fi(c) -= sum;
+        }
+
+        // Cache alphaEAS and KALPHA for use in Jacobian calculation
+        m_alphaEAS[kl] = alphaEAS;
+        m_KalphaEAS[kl] = gp.KalphaEAS;
+    }
+
+    if (m_gravity_on) {
+        Fi += m_GravForce;
+    }
+}
+
+void ChElementShellANCF::ComputeInternalJacobiansVectorized(ChMatrix<>& J, double Kfactor, double Rfactor) {
+    J.Reset();
+
+    for (size_t kl = 0; kl < m_numLayers; kl++) {
+        const LayerGaussPoints& gp = m_layerGP[kl];
+        const ChMatrixNM<double, 6, 6>& E_eps = GetLayer(kl).GetMaterial()->Get_E_eps();
+        const ChMatrixNM<double, 5, 1>& alphaEAS = m_alphaEAS[kl];
+
+        double strain[6][m_numGP];
+        double strainD[6][24][m_numGP];
+        CalcStrainGaussPoints(kl, strain, strainD);
+
+        // Weighted stresses (including the EAS strains)
+        for (int r = 0; r < 6; r++) {
+            for (int p = 0; p < m_numGP; p++) {
+                strain[r][p] += gp.G[r][0][p] * alphaEAS(0) + gp.G[r][1][p] * alphaEAS(1) +
+                                gp.G[r][2][p] * alphaEAS(2) + gp.G[r][3][p] * alphaEAS(3) +
+                                gp.G[r][4][p] * alphaEAS(4);
+            }
+        }
+        double stress[6][m_numGP];
+        for (int r = 0; r < 6; r++) {
+            for (int p = 0; p < m_numGP; p++) {
+                stress[r][p] = gp.weight[p] * (E_eps(r, 0) * strain[0][p] + E_eps(r, 1) * strain[1][p] +
+                                               E_eps(r, 2) * strain[2][p] + E_eps(r, 3) * strain[3][p] +
+                                               E_eps(r, 4) * strain[4][p] + E_eps(r, 5) * strain[5][p]);
+            }
+        }
+
+        // Material part: strainD' * E_eps * strainD (weighted)
+        double EstrainD[6][24][m_numGP];
+        for (int r = 0; r < 6; r++) {
+            for (int c = 0; c < 24; c++) {
+                for (int p = 0; p < m_numGP; p++) {
+                    EstrainD[r][c][p] =
+                        gp.weight[p] * (E_eps(r, 0) * strainD[0][c][p] + E_eps(r, 1) * strainD[1][c][p] +
+                                        E_eps(r, 2) * strainD[2][c][p] + E_eps(r, 3) * strainD[3][c][p] +
+                                        E_eps(r, 4) * strainD[4][c][p] + E_eps(r, 5) * strainD[5][c][p]);
+                }
+            }
+        }
+
+        ChMatrixNM<double, 24, 24> KTE;
+        double factor = Kfactor + Rfactor * m_Alpha;
+        for (int i = 0; i < 24; i++) {
+            for (int j = 0; j < 24; j++) {
+                double sum = 0;
+                for (int r = 0; r < 6; r++)
+                    for (int p = 0; p < m_numGP; p++)
+                        sum += strainD[r][i][p] * EstrainD[r][j][p];
+                KTE(i, j) = factor * sum;
+            }
+        }
+
+        // Geometric part: Gd' * Sigm * Gd. Both Gd and Sigm repeat the same entries for the three
+        // coordinates, so only the 8x8 scalar blocks are calculated (stress tensor S times Gd).
+        int sigm[3][3] = {{0, 2, 4}, {2, 1, 5}, {4, 5, 3}};
+        double SGd[3][8][m_numGP];
+        for (int a = 0; a < 3; a++) {
+            for (int j = 0; j < 8; j++) {
+                for (int p = 0; p < m_numGP; p++) {
+                    SGd[a][j][p] = stress[sigm[a][0]][p] * gp.Gd[0][j][p] + stress[sigm[a][1]][p] * gp.Gd[1][j][p] +
+                                   stress[sigm[a][2]][p] * gp.Gd[2][j][p];
+                }
+            }
+        }
+        for (int i = 0; i < 8; i++) {
+            for (int j = 0; j < 8; j++) {
+                double sum = 0;
+                for (int a = 0; a < 3; a++)
+                    for (int p = 0; p < m_numGP; p++)
+                        sum += gp.Gd[a][i][p] * SGd[a][j][p];
+                for (int k = 0; k < 3; k++)
+                    KTE(3 * i + k, 3 * j + k) += Kfactor * sum;
+            }
+        }
+
+        // EAS cross-dependency matrix
+        ChMatrixNM<double, 5, 24> GDEPSP;
+        for (int a = 0; a < 5; a++) {
+            for (int c = 0; c < 24; c++) {
+                double sum = 0;
+                for (int r = 0; r < 6; r++)
+                    for (int p = 0; p < m_numGP; p++)
+                        sum += gp.GE[a][r][p] * strainD[r][c][p];
+                GDEPSP(a, c) = sum;
+            }
+        }
+
+        // Include EAS contribution to the stiffness component (hence scaled by Kfactor)
+        ChMatrixNM<double, 5, 5> KalphaEAS_inv;
+        Inverse55_Analytical(KalphaEAS_inv, m_KalphaEAS[kl]);
+        ChMatrixNM<double, 24, 24> EAS;
+        EAS.MatrTMultiply(GDEPSP, KalphaEAS_inv * GDEPSP);
+
+        // Accumulate Jacobian
+        J += KTE - EAS * Kfactor;
+    }
+}
+
+void ChElementShellANCF::ComputeInternalJacobiansProductVectorized(ChMatrix<>& y,
+                                                                   const ChMatrix<>& x,
+                                                                   double Kfactor,
+                                                                   double Rfactor) {
+    // Same terms as in ComputeInternalJacobiansVectorized, applied to x at the Gauss points.
+    for (size_t kl = 0; kl < m_numLayers; kl++) {
+        const LayerGaussPoints& gp = m_layerGP[kl];
+        const ChMatrixNM<double, 6, 6>& E_eps = GetLayer(kl).GetMaterial()->Get_E_eps();
+        const ChMatrixNM<double, 5, 1>& alphaEAS = m_alphaEAS[kl];
+
+        double strain[6][m_numGP];
+        double strainD[6][24][m_numGP];
+        CalcStrainGaussPoints(kl, strain, strainD);
+
+        // Weighted stresses (including the EAS strains)
+        for (int r = 0; r < 6; r++) {
+            for (int p = 0; p < m_numGP; p++) {
+                strain[r][p] += gp.G[r][0][p] * alphaEAS(0) + gp.G[r][1][p] * alphaEAS(1) +
+                                gp.G[r][2][p] * alphaEAS(2) + gp.G[r][3][p] * alphaEAS(3) +
+                                gp.G[r][4][p] * alphaEAS(4);
+            }
+        }
+        double stress[6][m_numGP];
+        for (int r = 0; r < 6; r++) {
+            for (int p = 0; p < m_numGP; p++) {
+                stress[r][p] = gp.weight[p] * (E_eps(r, 0) * strain[0][p] + E_eps(r, 1) * strain[1][p] +
+                                               E_eps(r, 2) * strain[2][p] + E_eps(r, 3) * strain[3][p] +
+                                               E_eps(r, 4) * strain[4][p] + E_eps(r, 5) * strain[5][p]);
+            }
+        }
+
+        // Strain increments strainD * x
+        double dstrain[6][m_numGP];
+        for (int r = 0; r < 6; r++) {
+            for (int p = 0; p < m_numGP; p++) {
+                double sum = 0;
+                for (int c = 0; c < 24; c++)
+                    sum += strainD[r][c][p] * x(c);
+                dstrain[r][p] = sum;
+            }
+        }
+
+        // EAS part: GDEPSP' * KalphaEAS^-1 * GDEPSP * x, with GDEPSP * x = GE * (strainD * x)
+        ChMatrixNM<double, 5, 1> GEx;
+        for (int a = 0; a < 5; a++) {
+            double sum = 0;
+            for (int r = 0; r < 6; r++)
+                for (int p = 0; p < m_numGP; p++)
+                    sum += gp.GE[a][r][p] * dstrain[r][p];
+            GEx(a) = sum;
+        }
+        ChMatrixNM<double, 5, 5> KalphaEAS_inv;
+        Inverse55_Analytical(KalphaEAS_inv, m_KalphaEAS[kl]);
+        ChMatrixNM<double, 5, 1> alphaEAS_x = KalphaEAS_inv * GEx;
+
+        // Material and EAS parts share the product by strainD'
+        double factor = Kfactor + Rfactor * m_Alpha;
+        double dstress[6][m_numGP];
+        for (int r = 0; r < 6; r++) {
+            for (int p = 0; p < m_numGP; p++) {
+                double Edstrain = E_eps(r, 0) * dstrain[0][p] + E_eps(r, 1) * dstrain[1][p] +
+                                  E_eps(r, 2) * dstrain[2][p] + E_eps(r, 3) * dstrain[3][p] +
+                                  E_eps(r, 4) * dstrain[4][p] + E_eps(r, 5) * dstrain[5][p];
+                double GEalpha = gp.GE[0][r][p] * alphaEAS_x(0) + gp.GE[1][r][p] * alphaEAS_x(1) +
+                                 gp.GE[2][r][p] * alphaEAS_x(2) + gp.GE[3][r][p] * alphaEAS_x(3) +
+                                 gp.GE[4][r][p] * alphaEAS_x(4);
+                dstress[r][p] = factor * gp.weight[p] * Edstrain - Kfactor * GEalpha;
+            }
+        }
+        for (int c = 0; c < 24; c++) {
+            double sum = 0;
+            for (int r = 0; r < 6; r++)
+                for (int p = 0; p < m_numGP; p++)
+                    sum += strainD[r][c][p] * dstress[r][p];
+            y(c) += sum;
+        }
+
+        // Geometric part: Gd' * Sigm * Gd * x, on the three coordinates
+        int sigm[3][3] = {{0, 2, 4}, {2, 1, 5}, {4, 5, 3}};
+        for (int k = 0; k < 3; k++) {
+            double Gdx[3][m_numGP];
+            for (int a = 0; a < 3; a++) {
+                for (int p = 0; p < m_numGP; p++) {
+                    double sum = 0;
+                    for (int j = 0; j < 8; j++)
+                        sum += gp.Gd[a][j][p] * x(3 * j + k);
+                    Gdx[a][p] = sum;
+                }
+            }
+            double SGdx[3][m_numGP];
+            for (int a = 0; a < 3; a++) {
+                for (int p = 0; p < m_numGP; p++) {
+                    SGdx[a][p] = stress[sigm[a][0]][p] * Gdx[0][p] + stress[sigm[a][1]][p] * Gdx[1][p] +
+                                 stress[sigm[a][2]][p] * Gdx[2][p];
+                }
+            }
+            for (int i = 0; i < 8; i++) {
+                double sum = 0;
+                for (int a = 0; a < 3; a++)
+                    for (int p = 0; p < m_numGP; p++)
+                        sum += gp.Gd[a][i][p] * SGdx[a][p];
+                y(3 * i + k) += Kfactor * sum;
+            }
+        }
     }
 }
 
@@ -172,6 +172,16 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     /// Set the structural damping.
     void SetAlphaDamp(double a) { m_Alpha = a; }
 
+    /// Enable/disable the vectorized evaluation of the internal forces and of their Jacobians (default: false).
+    /// If enabled, the quantities that depend only on the reference configuration are cached at the Gauss points
+    /// of each layer during SetupInitial, and the integrands are evaluated for all the Gauss points of a layer at
+    /// once, with loops over contiguous arrays. Results match the default path up to round-off.
+    /// This must be set before the initial setup of the element.
+    void SetVectorizedKernels(bool val) { m_vectorized = val; }
+
+    /// Return true if the vectorized evaluation of internal forces and Jacobians is enabled.
+    bool GetVectorizedKernels() const { return m_vectorized; }
+
     /// Get the element length in the X direction.
     double GetLengthX() const { return m_lenX; }
     /// Get the element length in the Y direction.
@@ -207,6 +217,25 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     ChVector<> EvaluateSectionStrains();
 
   private:
+    /// Number of Gauss points per layer (2 in each direction).
+    static const int m_numGP = 8;
+
+    /// Quantities at the Gauss points of a layer that depend only on the reference configuration.
+    /// Arrays are in structure-of-arrays layout: the last index runs over the Gauss points.
+    struct LayerGaussPoints {
+        double N[4][m_numGP];         ///< shape functions of the nodal positions (for the ANS thickness strain)
+        double Nx[8][m_numGP];        ///< shape function derivatives with respect to x
+        double Ny[8][m_numGP];        ///< shape function derivatives with respect to y
+        double S_ANS[4][m_numGP];     ///< ANS shape functions
+        double strain0[3][m_numGP];   ///< in-plane strains of the initial configuration (xx, yy, xy)
+        double T[6][6][m_numGP];      ///< orthotropic strain transformation (from the beta coefficients)
+        double Gd[3][8][m_numGP];     ///< nonzero entries of Gd, per direction and node
+        double G[6][5][m_numGP];      ///< EAS matrix T0 * M * (detJ0C / detJ0)
+        double GE[5][6][m_numGP];     ///< G' * E_eps, times the integration weight
+        double weight[m_numGP];       ///< integration weight (includes detJ0 and the change of intervals)
+        ChMatrixNM<double, 5, 5> KalphaEAS;  ///< EAS Jacobian (constant)
+    };
+
     std::vector<std::shared_ptr<ChNodeFEAxyzD> > m_nodes;  ///< element nodes
     std::vector<Layer> m_layers;                           ///< element layers
     size_t m_numLayers;                                    ///< number of layers for this element
@@ -219,7 +248,6 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     bool m_gravity_on;                                     ///< enable/disable gravity calculation
     ChMatrixNM<double, 24, 1> m_GravForce;                 ///< Gravity Force
     ChMatrixNM<double, 24, 24> m_MassMatrix;               ///< mass matrix
-    ChMatrixNM<double, 24, 24> m_JacobianMatrix;           ///< Jacobian matrix (Kfactor*[K] + Rfactor*[R])
     ChMatrixNM<double, 8, 3> m_d0;                         ///< initial nodal coordinates
     ChMatrixNM<double, 8, 8> m_d0d0T;                      ///< matrix m_d0 * m_d0^T
     ChMatrixNM<double, 8, 3> m_d;                          ///< current nodal coordinates
@@ -229,6 +257,8 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     ChMatrixNM<double, 8, 24> m_strainANS_D;               ///< ANS strain derivatives
     std::vector<ChMatrixNM<double, 5, 1> > m_alphaEAS;     ///< EAS parameters (5 per layer)
     std::vector<ChMatrixNM<double, 5, 5> > m_KalphaEAS;    ///< EAS Jacobians (a 5x5 matrix per layer)
+    bool m_vectorized;                                     ///< use the vectorized Gauss point kernels
+    std::vector<LayerGaussPoints> m_layerGP;               ///< cached Gauss point data (vectorized kernels only)
 
     static const double m_toleranceEAS;   ///< tolerance for nonlinear EAS solver (on residual)
     static const int m_maxIterationsEAS;  ///< maximum number of nonlinear EAS iterations
@@ -251,6 +281,14 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
                                           double Rfactor = 0,
                                           double Mfactor = 0) override;
 
+    // Add to y the product H*x, with H as in ComputeKRMmatricesGlobal(). With the vectorized kernels,
+    // the product is evaluated at the Gauss points, without forming the Jacobian matrix.
+    virtual void ComputeKRMmatricesProduct(ChMatrix<>& y,
+                                           const ChMatrix<>& x,
+                                           double Kfactor,
+                                           double Rfactor = 0,
+                                           double Mfactor = 0) override;
+
     // Set M as the global mass matrix.
     virtual void ComputeMmatrixGlobal(ChMatrix<>& M) override;
 
@@ -294,9 +332,25 @@ class ChApiFea ChElementShellANCF : public ChElementShell, public ChLoadableUV,
     /// This function calculates a linear combination of the stiffness (K) and damping (R) matrices,
     ///     J = Kfactor * K + Rfactor * R
     /// for given coefficients Kfactor and Rfactor.
-    /// This Jacobian will be further combined with the global mass matrix M and included in the global
-    /// stiffness matrix H in the function ComputeKRMmatricesGlobal().
-    void ComputeInternalJacobians(double Kfactor, double Rfactor);
+    /// The Jacobian is written in J (24x24), which is then combined with the global mass matrix M in the
+    /// function ComputeKRMmatricesGlobal(). No copy of the Jacobian is stored in the element.
+    void ComputeInternalJacobians(ChMatrix<>& J, double Kfactor, double Rfactor);
+
+    /// Cache the Gauss point quantities that depend only on the reference configuration (vectorized kernels).
+    void CalcLayerGaussPoints();
+
+    /// Calculate the strains (without EAS contribution, with structural damping) and the strain derivatives
+    /// at all Gauss points of the specified layer, using the cached Gauss point data.
+    void CalcStrainGaussPoints(size_t kl, double strain[6][m_numGP], double strainD[6][24][m_numGP]);
+
+    /// Vectorized version of ComputeInternalForces.
+    void ComputeInternalForcesVectorized(ChMatrixDynamic<>& Fi);
+
+    /// Vectorized version of ComputeInternalJacobians.
+    void ComputeInternalJacobiansVectorized(ChMatrix<>& J, double Kfactor, double Rfactor);
+
+    /// Vectorized product y += (Kfactor * K + Rfactor * R) * x, without forming the Jacobian.
+    void ComputeInternalJacobiansProductVectorized(ChMatrix<>& y, const ChMatrix<>& x, double Kfactor, double Rfactor);
 
     /// Compute the mass matrix of the element.
     /// Note: in this 'basic' implementation, constant section and
@@ -15,6 +15,7 @@
 #ifndef CHELEMENTTETRA4_H
 #define CHELEMENTTETRA4_H
 
+#include <algorithm>
 #include <cmath>
 
 #include "chrono/physics/ChTensors.h"
@@ -335,6 +336,43 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         //***TO DO*** better per-node lumping, or 12x12 consistent mass matrix.
     }
 
+    /// Adds to y the product [H]*x, with H = Kfactor*[K] + Rfactor*[R] + Mfactor*[M], as in
+    /// ComputeKRMmatricesGlobal(), without forming the corotated matrix: y += C*[Klocal]*C'*x.
+    virtual void ComputeKRMmatricesProduct(ChMatrix<>& y,
+                                           const ChMatrix<>& x,
+                                           double Kfactor,
+                                           double Rfactor = 0,
+                                           double Mfactor = 0) override {
+        assert((y.GetRows() == 12) && (x.GetRows() == 12));
+
+        // rotate to the local frame of the element
+        ChMatrixNM<double, 12, 1> x_local;
+        for (int in = 0; in < 4; in++) {
+            ChVector<> xn(x(3 * in), x(3 * in + 1), x(3 * in + 2));
+            x_local.PasteVector(this->A.MatrT_x_Vect(xn), 3 * in, 0);
+        }
+
+        ChMatrixNM<double, 12, 1> y_local;
+        y_local.MatrMultiply(StiffnessMatrix, x_local);
+
+        // back to the absolute frame
+        double mkfactor = Kfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingK();
+        for (int in = 0; in < 4; in++) {
+            ChVector<> yn = this->A.Matr_x_Vect(y_local.ClipVector(3 * in, 0));
+            y(3 * in) += mkfactor * yn.x();
+            y(3 * in + 1) += mkfactor * yn.y();
+            y(3 * in + 2) += mkfactor * yn.z();
+        }
+
+        // lumped mass
+        if (Mfactor) {
+            double lumped_node_mass = (this->GetVolume() * this->Material->Get_density()) / 4.0;
+            double amfactor = Mfactor + Rfactor * this->GetMaterial()->Get_RayleighDampingM();
+            for (int id = 0; id < 12; id++)
+                y(id) += amfactor * lumped_node_mass * x(id);
+        }
+    }
+
     /// Computes the internal forces (ex. the actual position of
     /// nodes is not in relaxed reference position) and set values
     /// in the Fi vector.
@@ -409,6 +447,22 @@ class ChApiFea ChElementTetra_4 : public ChElementTetrahedron, public ChLoadable
         nodes[2]->m_TotalMass += this->GetVolume() * this->Material->Get_density() / 4.0;
         nodes[3]->m_TotalMass += this->GetVolume() * this->Material->Get_density() / 4.0;
     }
+
+    /// Estimate of the stable step for explicit integration: the smallest height of the tetrahedron
+    /// (in the current configuration) over the speed of the dilatational waves in the material.
+    virtual double ComputeStableTimeStep() override {
+        ChVector<> p0 = nodes[0]->GetPos();
+        ChVector<> p1 = nodes[1]->GetPos();
+        ChVector<> p2 = nodes[2]->GetPos();
+        ChVector<> p3 = nodes[3]->GetPos();
+        double volume = std::abs(Vdot(p1 - p0, Vcross(p2 - p0, p3 - p0))) / 6;
+        double max_area = std::max(std::max(Vcross(p1 - p0, p2 - p0).Length(), Vcross(p1 - p0, p3 - p0).Length()),
+                                   std::max(Vcross(p2 - p0, p3 - p0).Length(), Vcross(p2 - p1, p3 - p1).Length())) /
+                          2;
+        double wave_speed =
+            std::sqrt((Material->Get_l() + 2 * Material->Get_G()) / Material->Get_density());
+        return (max_area > 0) ? 3 * volume / max_area / wave_speed : 0;
+    }
     //
     // Functions for interfacing to the solver
     //            (***not needed, thank to bookkeeping in parent class ChElementGeneric)
@@ -20,6 +20,7 @@
 #include <string>
 
 #include "chrono/core/ChMath.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/physics/ChLoad.h"
 #include "chrono/physics/ChObject.h"
 #include "chrono/physics/ChSystem.h"
@@ -46,6 +47,8 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
     automatic_gravity_load = other.automatic_gravity_load;
     num_points_gravity = other.num_points_gravity;
 
+    matrix_free = other.matrix_free;
+
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
 }
@@ -134,6 +137,12 @@ void ChMesh::Setup() {
     }
 }
 
+// Accept the internal state of the elements (e.g. the plastic history) at the end of the time step.
+void ChMesh::AcceptStep() {
+    for (unsigned int ie = 0; ie < velements.size(); ie++)
+        velements[ie]->EleCommitState();
+}
+
 // Updates all time-dependant variables, if any...
 // Ex: maybe the elasticity can increase in time, etc.
 void ChMesh::Update(double m_time, bool update_assets) {
@@ -262,13 +271,46 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,
 
     // internal forces
     timer_internal_forces.start();
-#pragma omp parallel for schedule(dynamic, 4)
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
-    }
+    LoadElementsParallel((int)velements.size(), R, [this, c](int from, int to, ChVectorDynamic<>& Rc) {
+        for (int ie = from; ie < to; ie++)
+            velements[ie]->EleIntLoadResidual_F(Rc, c);
+    });
     timer_internal_forces.stop();
     ncalls_internal_forces++;
 
+    IntLoadResidual_Gravity(R, c);
+}
+
+void ChMesh::LoadElementsParallel(int nelements,
+                                  ChVectorDynamic<>& R,
+                                  const std::function<void(int, int, ChVectorDynamic<>&)>& load) {
+    // Elements sharing a node update the same entries of R, so they cannot write into R concurrently.
+    if (ChTaskScheduler::GetInstance().GetNumThreads() == 1 || nelements < 2 * num_parallel_chunks) {
+        load(0, nelements, R);
+        return;
+    }
+
+    int nrows = R.GetRows();
+    int grain = (nelements - 1) / num_parallel_chunks + 1;
+    R_chunks.resize(num_parallel_chunks);
+    ChParallelFor(0, num_parallel_chunks, 1, [&](int k) {
+        R_chunks[k].Reset(nrows);
+        int from = k * grain;
+        int to = std::min(from + grain, nelements);
+        if (from < to)
+            load(from, to, R_chunks[k]);
+    });
+
+    ChParallelForRange(0, nrows, 0, [&](int from, int to) {
+        for (int k = 0; k < num_parallel_chunks; k++) {
+            const ChVectorDynamic<>& Rk = R_chunks[k];
+            for (int i = from; i < to; i++)
+                R(i) += Rk(i);
+        }
+    });
+}
+
+void ChMesh::IntLoadResidual_Gravity(ChVectorDynamic<>& R, const double c) {
     // Apply gravity loads without the need of adding
     // a ChLoad object to each element: just instance here a single ChLoad and reuse
     // it for all 'volume' objects.
@@ -332,6 +374,41 @@ void ChMesh::IntLoadResidual_Mv(const unsigned int off,      ///< offset in R re
     }
 }
 
+bool ChMesh::IntLoadLumpedMass_Md(const unsigned int off,  ///< offset in Md vector
+                                  ChVectorDynamic<>& Md,   ///< result: Md += c*diag(M_lumped)
+                                  const double c,          ///< a scaling factor
+                                  bool hrz                 ///< use HRZ lumping for the elements
+                                  ) {
+    // nodal masses (row sums)
+    ChVectorDynamic<> ones(Md.GetRows());
+    ones.FillElem(1);
+    unsigned int local_off_v = 0;
+    for (unsigned int j = 0; j < vnodes.size(); j++) {
+        if (!vnodes[j]->GetFixed()) {
+            vnodes[j]->NodeIntLoadResidual_Mv(off + local_off_v, Md, ones, c);
+            local_off_v += vnodes[j]->Get_ndof_w();
+        }
+    }
+
+    // internal masses
+    for (unsigned int ie = 0; ie < velements.size(); ie++) {
+        velements[ie]->EleIntLoadLumpedMass_Md(Md, c, hrz);
+    }
+
+    return true;
+}
+
+double ChMesh::ComputeStableTimeStep() {
+    auto min_step = [](double a, double b) { return (a > 0 && (b == 0 || a < b)) ? a : b; };
+    return ChParallelReduce(0, (int)velements.size(), 64, 0.0,
+                            [&](int from, int to, double step) {
+                                for (int ie = from; ie < to; ie++)
+                                    step = min_step(velements[ie]->ComputeStableTimeStep(), step);
+                                return step;
+                            },
+                            min_step);
+}
+
 void ChMesh::IntToDescriptor(const unsigned int off_v,
                              const ChStateDelta& v,
                              const ChVectorDynamic<>& R,
@@ -363,15 +440,25 @@ void ChMesh::IntFromDescriptor(const unsigned int off_v,
 //// SOLVER FUNCTIONS
 
 void ChMesh::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
+    if (matrix_free) {
+        for (unsigned int ie = 0; ie < velements.size(); ie++)
+            velements[ie]->InjectKRMmatricesProduct(mdescriptor);
+        return;
+    }
+
     for (unsigned int ie = 0; ie < velements.size(); ie++)
         velements[ie]->InjectKRMmatrices(mdescriptor);
 }
 
 void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
     timer_KRMload.start();
-#pragma omp parallel for
-    for (int ie = 0; ie < velements.size(); ie++)
-        velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+    if (matrix_free) {
+        ChParallelFor(0, (int)velements.size(), 0,
+                      [&](int ie) { velements[ie]->KRMmatricesProductLoad(Kfactor, Rfactor, Mfactor); });
+    } else {
+        ChParallelFor(0, (int)velements.size(), 0,
+                      [&](int ie) { velements[ie]->KRMmatricesLoad(Kfactor, Rfactor, Mfactor); });
+    }
     timer_KRMload.stop();
     ncalls_KRMload++;
 }
@@ -17,6 +17,7 @@
 
 #include <cstdlib>
 #include <cmath>
+#include <functional>
 
 #include "chrono/core/ChTimer.h"
 #include "chrono/physics/ChContinuumMaterial.h"
@@ -38,7 +39,7 @@ namespace fea {
 /// between nodes of class ChNodeFEAbase.
 class ChApiFea ChMesh : public ChIndexedNodes {
 
-  private:
+  protected:
     std::vector<std::shared_ptr<ChNodeFEAbase>> vnodes;     ///<  nodes
     std::vector<std::shared_ptr<ChElementBase>> velements;  ///<  elements
 
@@ -51,17 +52,33 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     bool automatic_gravity_load;
     int num_points_gravity;
 
+    bool matrix_free;
+
     ChTimer<> timer_internal_forces;
     ChTimer<> timer_KRMload;
     int ncalls_internal_forces;
     int ncalls_KRMload;
 
+    std::vector<ChVectorDynamic<>> R_chunks;  ///< per-chunk residuals, for the parallel load of internal forces
+
+    /// Number of element chunks used for the parallel load of internal forces.
+    static const int num_parallel_chunks = 8;
+
+    /// Add to R the element contributions computed by 'load(from, to, Rc)', which must add into Rc the
+    /// contributions of the elements in [from, to). If more than one thread is used, the elements are split
+    /// in a fixed number of chunks processed in parallel, each adding into its own vector; these vectors are
+    /// then summed into R in the order of the chunks, so the result does not depend on the number of threads.
+    void LoadElementsParallel(int nelements,
+                              ChVectorDynamic<>& R,
+                              const std::function<void(int, int, ChVectorDynamic<>&)>& load);
+
   public:
     ChMesh()
         : n_dofs(0),
           n_dofs_w(0),
           automatic_gravity_load(true),
           num_points_gravity(1),
+          matrix_free(false),
           ncalls_internal_forces(0),
           ncalls_KRMload(0) {}
     ChMesh(const ChMesh& other);
@@ -72,8 +89,8 @@ class ChApiFea ChMesh : public ChIndexedNodes {
 
     void AddNode(std::shared_ptr<ChNodeFEAbase> m_node);
     void AddElement(std::shared_ptr<ChElementBase> m_elem);
-    void ClearNodes();
-    void ClearElements();
+    virtual void ClearNodes();
+    virtual void ClearElements();
 
     /// Get the array of nodes of this mesh.
     const std::vector<std::shared_ptr<ChNodeFEAbase>>& GetNodes() const { return vnodes; }
@@ -99,6 +116,19 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     /// Override default in ChPhysicsItem.
     virtual bool GetCollide() const override { return true; }
 
+    /// Enable/disable the matrix-free mode (default: false).
+    /// In matrix-free mode, the elements do not store their K, R, M matrices for the solver: the products
+    /// by the system matrix, as needed by iterative solvers (e.g. ChSolverMINRES), are computed element
+    /// by element (see ChElementBase::ComputeKRMmatricesProduct), in parallel. The matrices are formed
+    /// temporarily only if the solver asks for them (direct solvers, diagonal preconditioners).
+    /// Elements that do not support it fall back to the stored matrices.
+    /// This trades memory for computation: each product re-evaluates the element terms at the current
+    /// state, so it pays off for large meshes, when the stored matrices do not fit the memory or caches.
+    void SetMatrixFree(bool val) { matrix_free = val; }
+
+    /// Return true if the matrix-free mode is enabled.
+    bool GetMatrixFree() const { return matrix_free; }
+
     /// Reset counters for internal force and Jacobian evaluations.
     void ResetCounters() {
         ncalls_internal_forces = 0;
@@ -153,6 +183,9 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     /// as well as state offsets of contained items.
     virtual void Setup() override;
 
+    /// Accept the internal state of all elements at the end of a time step (see ChElementBase::EleCommitState).
+    virtual void AcceptStep() override;
+
     /// Update time dependent data, for all elements.
     /// Updates all [A] coord.systems for all (corotational) elements.
     virtual void Update(double m_time, bool update_assets = true) override;
@@ -205,6 +238,12 @@ class ChApiFea ChMesh : public ChIndexedNodes {
                                     ChVectorDynamic<>& R,
                                     const ChVectorDynamic<>& w,
                                     const double c) override;
+    virtual bool IntLoadLumpedMass_Md(const unsigned int off,
+                                      ChVectorDynamic<>& Md,
+                                      const double c,
+                                      bool hrz) override;
+    /// Return the smallest stable step estimated by the elements (see ChElementBase::ComputeStableTimeStep).
+    virtual double ComputeStableTimeStep() override;
     virtual void IntToDescriptor(const unsigned int off_v,
                                  const ChStateDelta& v,
                                  const ChVectorDynamic<>& R,
@@ -268,7 +307,10 @@ class ChApiFea ChMesh : public ChIndexedNodes {
     /// Basically does nothing, but maybe that inherited classes may specialize this.
     virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
 
-  private:
+  protected:
+    /// Add the gravity loads of the elements (see SetAutomaticGravity) to the residual: R += c*F_gravity.
+    void IntLoadResidual_Gravity(ChVectorDynamic<>& R, const double c);
+
     /// Initial setup (before analysis).
     /// This function is called from ChSystem::SetupInitial, marking a point where system
     /// construction is completed.
@@ -0,0 +1,431 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHMESHTYPED_H
+#define CHMESHTYPED_H
+
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono_fea/ChMesh.h"
+
+namespace chrono {
+namespace fea {
+
+/// @addtogroup fea_module
+/// @{
+
+/// Mesh of elements of a single class, between nodes of a single class, ex.
+/// ChMeshTyped<ChElementTetra_4, ChNodeFEAxyz> or ChMeshTyped<ChElementHexa_8, ChNodeFEAxyz>.
+/// The nodes and the elements are created by the mesh (see AddNodes, AddElements) in contiguous blocks, rather
+/// than one by one on the heap, and the loops over the nodes and the elements of the time integration (state
+/// gather/scatter, residuals, solver variables) call the functions of the Node and Element classes directly,
+/// without virtual dispatch. The internal forces are assembled with a connectivity table of the elements, set up
+/// in SetupInitial. Otherwise this is a ChMesh, and it is added to the system in the same way.
+/// Nodes and elements added with AddNode and AddElement are allowed, but then the mesh falls back to the loops
+/// of ChMesh. The elements must use only nodes of this mesh.
+template <class Element, class Node>
+class ChMeshTyped : public ChMesh {
+  public:
+    ChMeshTyped() : node_ndof_x(0), node_ndof_w(0), element_nnodes(0), typed_setup(false) {}
+    ChMeshTyped(const ChMeshTyped& other)
+        : ChMesh(other),
+          node_blocks(other.node_blocks),
+          element_blocks(other.element_blocks),
+          typed_nodes(other.typed_nodes),
+          typed_elements(other.typed_elements),
+          element_nodes(other.element_nodes),
+          node_ndof_x(other.node_ndof_x),
+          node_ndof_w(other.node_ndof_w),
+          element_nnodes(other.element_nnodes),
+          typed_setup(other.typed_setup) {}
+    ~ChMeshTyped() {}
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChMeshTyped* Clone() const override { return new ChMeshTyped(*this); }
+
+    /// Create a block of 'n' nodes (default constructed, ex. set their position with SetX0 and SetPos) and add
+    /// them to the mesh. Return the index of the first of them.
+    unsigned int AddNodes(unsigned int n) {
+        unsigned int first = GetNnodes();
+        typed_setup = false;
+        auto block = std::make_shared<std::vector<Node>>(n);
+        node_blocks.push_back(block);
+        for (auto& node : *block) {
+            typed_nodes.push_back(&node);
+            AddNode(std::shared_ptr<Node>(block, &node));
+        }
+        return first;
+    }
+
+    /// Create a block of 'n' elements (default constructed, ex. set their nodes with SetNodes) and add them to
+    /// the mesh. Return the index of the first of them.
+    unsigned int AddElements(unsigned int n) {
+        unsigned int first = GetNelements();
+        typed_setup = false;
+        auto block = std::make_shared<std::vector<Element>>(n);
+        element_blocks.push_back(block);
+        for (auto& element : *block) {
+            typed_elements.push_back(&element);
+            AddElement(std::shared_ptr<Element>(block, &element));
+        }
+        return first;
+    }
+
+    /// Access the N-th node, with its class.
+    std::shared_ptr<Node> GetTypedNode(unsigned int n) { return std::static_pointer_cast<Node>(vnodes[n]); }
+
+    /// Access the N-th element, with its class.
+    std::shared_ptr<Element> GetTypedElement(unsigned int n) { return std::static_pointer_cast<Element>(velements[n]); }
+
+    virtual void ClearNodes() override {
+        ChMesh::ClearNodes();
+        node_blocks.clear();
+        element_blocks.clear();
+        typed_nodes.clear();
+        typed_elements.clear();
+        typed_setup = false;
+    }
+
+    virtual void ClearElements() override {
+        ChMesh::ClearElements();
+        element_blocks.clear();
+        typed_elements.clear();
+        typed_setup = false;
+    }
+
+    /// Return true if the loops of this class are used, i.e. all nodes and elements were created by this mesh,
+    /// and the connectivity table is up to date (see SetupInitial).
+    bool IsTyped() const {
+        return typed_setup && typed_nodes.size() == vnodes.size() && typed_elements.size() == velements.size();
+    }
+
+    virtual void Update(double m_time, bool update_assets = true) override {
+        if (!IsTyped()) {
+            ChMesh::Update(m_time, update_assets);
+            return;
+        }
+        ChIndexedNodes::Update(m_time, update_assets);
+        for (auto element : typed_elements)
+            element->Element::Update();
+    }
+
+    //
+    // STATE FUNCTIONS
+    //
+
+    virtual void IntStateGather(const unsigned int off_x,
+                                ChState& x,
+                                const unsigned int off_v,
+                                ChStateDelta& v,
+                                double& T) override {
+        if (!IsTyped()) {
+            ChMesh::IntStateGather(off_x, x, off_v, v, T);
+            return;
+        }
+        unsigned int local_off_x = 0;
+        unsigned int local_off_v = 0;
+        for (auto node : typed_nodes) {
+            if (!node->Node::GetFixed()) {
+                node->Node::NodeIntStateGather(off_x + local_off_x, x, off_v + local_off_v, v, T);
+                local_off_x += node_ndof_x;
+                local_off_v += node_ndof_w;
+            }
+        }
+        T = GetChTime();
+    }
+
+    virtual void IntStateScatter(const unsigned int off_x,
+                                 const ChState& x,
+                                 const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const double T) override {
+        if (!IsTyped()) {
+            ChMesh::IntStateScatter(off_x, x, off_v, v, T);
+            return;
+        }
+        unsigned int local_off_x = 0;
+        unsigned int local_off_v = 0;
+        for (auto node : typed_nodes) {
+            if (!node->Node::GetFixed()) {
+                node->Node::NodeIntStateScatter(off_x + local_off_x, x, off_v + local_off_v, v, T);
+                local_off_x += node_ndof_x;
+                local_off_v += node_ndof_w;
+            }
+        }
+        Update(T);
+    }
+
+    virtual void IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) override {
+        if (!IsTyped()) {
+            ChMesh::IntStateGatherAcceleration(off_a, a);
+            return;
+        }
+        unsigned int local_off_a = 0;
+        for (auto node : typed_nodes) {
+            if (!node->Node::GetFixed()) {
+                node->Node::NodeIntStateGatherAcceleration(off_a + local_off_a, a);
+                local_off_a += node_ndof_w;
+            }
+        }
+    }
+
+    virtual void IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) override {
+        if (!IsTyped()) {
+            ChMesh::IntStateScatterAcceleration(off_a, a);
+            return;
+        }
+        unsigned int local_off_a = 0;
+        for (auto node : typed_nodes) {
+            if (!node->Node::GetFixed()) {
+                node->Node::NodeIntStateScatterAcceleration(off_a + local_off_a, a);
+                local_off_a += node_ndof_w;
+            }
+        }
+    }
+
+    virtual void IntStateIncrement(const unsigned int off_x,
+                                   ChState& x_new,
+                                   const ChState& x,
+                                   const unsigned int off_v,
+                                   const ChStateDelta& Dv) override {
+        if (!IsTyped()) {
+            ChMesh::IntStateIncrement(off_x, x_new, x, off_v, Dv);
+            return;
+        }
+        unsigned int local_off_x = 0;
+        unsigned int local_off_v = 0;
+        for (auto node : typed_nodes) {
+            if (!node->Node::GetFixed()) {
+                node->Node::NodeIntStateIncrement(off_x + local_off_x, x_new, x, off_v + local_off_v, Dv);
+                local_off_x += node_ndof_x;
+                local_off_v += node_ndof_w;
+            }
+        }
+        for (auto element : typed_elements)
+            element->Element::EleDoIntegration();
+    }
+
+    virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override {
+        if (!IsTyped()) {
+            ChMesh::IntLoadResidual_F(off, R, c);
+            return;
+        }
+
+        // applied nodal forces
+        unsigned int local_off_v = 0;
+        for (auto node : typed_nodes) {
+            if (!node->Node::GetFixed()) {
+                node->Node::NodeIntLoadResidual_F(off + local_off_v, R, c);
+                local_off_v += node_ndof_w;
+            }
+        }
+
+        // internal forces, scattered to the nodes with the connectivity table
+        timer_internal_forces.start();
+        auto load_forces = [&](int from, int to, ChVectorDynamic<>& Rc) {
+            ChMatrixDynamic<> Fi(element_nnodes * node_ndof_w, 1);
+            for (int ie = from; ie < to; ie++) {
+                typed_elements[ie]->Element::ComputeInternalForces(Fi);
+                Node* const* nodes = &element_nodes[ie * element_nnodes];
+                for (int in = 0; in < element_nnodes; in++) {
+                    if (nodes[in]->Node::GetFixed())
+                        continue;
+                    unsigned int offset = nodes[in]->NodeGetOffset_w();
+                    for (int k = 0; k < node_ndof_w; k++)
+                        Rc(offset + k) += c * Fi(in * node_ndof_w + k);
+                }
+            }
+        };
+        LoadElementsParallel((int)typed_elements.size(), R, load_forces);
+        timer_internal_forces.stop();
+        ncalls_internal_forces++;
+
+        IntLoadResidual_Gravity(R, c);
+    }
+
+    virtual void IntLoadResidual_Mv(const unsigned int off,
+                                    ChVectorDynamic<>& R,
+                                    const ChVectorDynamic<>& w,
+                                    const double c) override {
+        if (!IsTyped()) {
+            ChMesh::IntLoadResidual_Mv(off, R, w, c);
+            return;
+        }
+        unsigned int local_off_v = 0;
+        for (auto node : typed_nodes) {
+            if (!node->Node::GetFixed()) {
+                node->Node::NodeIntLoadResidual_Mv(off + local_off_v, R, w, c);
+                local_off_v += node_ndof_w;
+            }
+        }
+        for (auto element : typed_elements)
+            element->Element::EleIntLoadResidual_Mv(R, w, c);
+    }
+
+    virtual void IntToDescriptor(const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const ChVectorDynamic<>& R,
+                                 const unsigned int off_L,
+                                 const ChVectorDynamic<>& L,
+                                 const ChVectorDynamic<>& Qc) override {
+        if (!IsTyped()) {
+            ChMesh::IntToDescriptor(off_v, v, R, off_L, L, Qc);
+            return;
+        }
+        unsigned int local_off_v = 0;
+        for (auto node : typed_nodes) {
+            if (!node->Node::GetFixed()) {
+                node->Node::NodeIntToDescriptor(off_v + local_off_v, v, R);
+                local_off_v += node_ndof_w;
+            }
+        }
+    }
+
+    virtual void IntFromDescriptor(const unsigned int off_v,
+                                   ChStateDelta& v,
+                                   const unsigned int off_L,
+                                   ChVectorDynamic<>& L) override {
+        if (!IsTyped()) {
+            ChMesh::IntFromDescriptor(off_v, v, off_L, L);
+            return;
+        }
+        unsigned int local_off_v = 0;
+        for (auto node : typed_nodes) {
+            if (!node->Node::GetFixed()) {
+                node->Node::NodeIntFromDescriptor(off_v + local_off_v, v);
+                local_off_v += node_ndof_w;
+            }
+        }
+    }
+
+    //
+    // SYSTEM FUNCTIONS
+    //
+
+    virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override {
+        if (!IsTyped() || matrix_free) {
+            ChMesh::KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
+            return;
+        }
+        timer_KRMload.start();
+        ChParallelFor(0, (int)typed_elements.size(), 0,
+                      [&](int ie) { typed_elements[ie]->Element::KRMmatricesLoad(Kfactor, Rfactor, Mfactor); });
+        timer_KRMload.stop();
+        ncalls_KRMload++;
+    }
+
+    virtual void VariablesFbReset() override {
+        if (!IsTyped()) {
+            ChMesh::VariablesFbReset();
+            return;
+        }
+        for (auto node : typed_nodes)
+            node->Node::VariablesFbReset();
+    }
+
+    virtual void VariablesFbLoadForces(double factor = 1) override {
+        if (!IsTyped()) {
+            ChMesh::VariablesFbLoadForces(factor);
+            return;
+        }
+        for (auto node : typed_nodes)
+            node->Node::VariablesFbLoadForces(factor);
+        for (auto element : typed_elements)
+            element->Element::VariablesFbLoadInternalForces(factor);
+    }
+
+    virtual void VariablesQbLoadSpeed() override {
+        if (!IsTyped()) {
+            ChMesh::VariablesQbLoadSpeed();
+            return;
+        }
+        for (auto node : typed_nodes)
+            node->Node::VariablesQbLoadSpeed();
+    }
+
+    virtual void VariablesFbIncrementMq() override {
+        if (!IsTyped()) {
+            ChMesh::VariablesFbIncrementMq();
+            return;
+        }
+        for (auto node : typed_nodes)
+            node->Node::VariablesFbIncrementMq();
+        for (auto element : typed_elements)
+            element->Element::VariablesFbIncrementMq();
+    }
+
+    virtual void VariablesQbSetSpeed(double step = 0) override {
+        if (!IsTyped()) {
+            ChMesh::VariablesQbSetSpeed(step);
+            return;
+        }
+        for (auto node : typed_nodes)
+            node->Node::VariablesQbSetSpeed(step);
+    }
+
+    virtual void VariablesQbIncrementPosition(double step) override {
+        if (!IsTyped()) {
+            ChMesh::VariablesQbIncrementPosition(step);
+            return;
+        }
+        for (auto node : typed_nodes)
+            node->Node::VariablesQbIncrementPosition(step);
+    }
+
+  protected:
+    /// Initial setup (before analysis): as in ChMesh, then set up the connectivity table of the elements.
+    /// Throws a ChException if an element uses nodes that are not of the Node class.
+    virtual void SetupInitial() override {
+        ChMesh::SetupInitial();
+
+        typed_setup = false;
+        element_nodes.clear();
+        if (typed_nodes.size() != vnodes.size() || typed_elements.size() != velements.size())
+            return;
+
+        if (!typed_nodes.empty()) {
+            node_ndof_x = typed_nodes[0]->Get_ndof_x();
+            node_ndof_w = typed_nodes[0]->Get_ndof_w();
+        }
+        if (!typed_elements.empty())
+            element_nnodes = typed_elements[0]->GetNnodes();
+
+        element_nodes.reserve(typed_elements.size() * element_nnodes);
+        for (auto element : typed_elements) {
+            if (element->GetNdofs() != element_nnodes * node_ndof_w)
+                throw ChException("ChMeshTyped: the elements have nodes of different types.");
+            for (int in = 0; in < element_nnodes; in++) {
+                Node* node = dynamic_cast<Node*>(element->GetNodeN(in).get());
+                if (!node)
+                    throw ChException("ChMeshTyped: the elements have nodes of different types.");
+                element_nodes.push_back(node);
+            }
+        }
+        typed_setup = true;
+    }
+
+    std::vector<std::shared_ptr<std::vector<Node>>> node_blocks;        ///< storage of the nodes
+    std::vector<std::shared_ptr<std::vector<Element>>> element_blocks;  ///< storage of the elements
+    std::vector<Node*> typed_nodes;                                     ///< nodes, in the order of the mesh
+    std::vector<Element*> typed_elements;                               ///< elements, in the order of the mesh
+    std::vector<Node*> element_nodes;  ///< connectivity table: nodes of each element
+    int node_ndof_x;                   ///< number of coordinates of each node
+    int node_ndof_w;                   ///< number of speed coordinates of each node
+    int element_nnodes;                ///< number of nodes of each element
+    bool typed_setup;                  ///< the connectivity table is set up
+};
+
+/// @} fea_module
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
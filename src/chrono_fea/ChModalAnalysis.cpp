@@ -0,0 +1,361 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "chrono_fea/ChModalAnalysis.h"
+
+namespace chrono {
+namespace fea {
+
+// -----------------------------------------------------------------------------
+// ChEnvelopeMatrix
+// -----------------------------------------------------------------------------
+
+void ChEnvelopeMatrix::Reset(const std::vector<int>& first_col) {
+    first = first_col;
+    offset.resize(first.size() + 1);
+    offset[0] = 0;
+    for (size_t i = 0; i < first.size(); i++) {
+        assert(first[i] <= (int)i);
+        offset[i + 1] = offset[i] + (i - first[i] + 1);
+    }
+    values.assign(offset.back(), 0.0);
+    factorized = false;
+}
+
+void ChEnvelopeMatrix::Add(int i, int j, double val) {
+    if (j > i)
+        std::swap(i, j);
+    assert(j >= first[i]);
+    values[offset[i] + (j - first[i])] += val;
+}
+
+double ChEnvelopeMatrix::Get(int i, int j) const {
+    if (j > i)
+        std::swap(i, j);
+    if (j < first[i])
+        return 0;
+    return values[offset[i] + (j - first[i])];
+}
+
+void ChEnvelopeMatrix::MultiplyAndAdd(ChMatrix<>& Y, const ChMatrix<>& X) const {
+    assert(!factorized);
+    assert(X.GetRows() == GetRows() && Y.GetRows() == GetRows() && X.GetColumns() == Y.GetColumns());
+    int n = GetRows();
+    int nc = X.GetColumns();
+    const double* x = X.GetAddress();
+    double* y = Y.GetAddress();
+    for (int i = 0; i < n; i++) {
+        const double* row = &values[offset[i]] - first[i];
+        for (int j = first[i]; j < i; j++) {
+            for (int c = 0; c < nc; c++) {
+                y[i * nc + c] += row[j] * x[j * nc + c];
+                y[j * nc + c] += row[j] * x[i * nc + c];
+            }
+        }
+        for (int c = 0; c < nc; c++)
+            y[i * nc + c] += row[i] * x[i * nc + c];
+    }
+}
+
+bool ChEnvelopeMatrix::Factorize() {
+    int n = GetRows();
+    for (int i = 0; i < n; i++) {
+        double* Li = &values[offset[i]] - first[i];
+        for (int j = first[i]; j < i; j++) {
+            const double* Lj = &values[offset[j]] - first[j];
+            double sum = Li[j];
+            for (int k = std::max(first[i], first[j]); k < j; k++)
+                sum -= Li[k] * Lj[k];
+            Li[j] = sum / Lj[j];
+        }
+        double diag = Li[i];
+        for (int k = first[i]; k < i; k++)
+            diag -= Li[k] * Li[k];
+        if (diag <= 0)
+            return false;
+        Li[i] = std::sqrt(diag);
+    }
+    factorized = true;
+    return true;
+}
+
+void ChEnvelopeMatrix::Solve(ChMatrix<>& B) const {
+    assert(factorized);
+    assert(B.GetRows() == GetRows());
+    int n = GetRows();
+    int nc = B.GetColumns();
+    double* b = B.GetAddress();
+
+    // Forward substitution, L*Y = B
+    for (int i = 0; i < n; i++) {
+        const double* Li = &values[offset[i]] - first[i];
+        for (int c = 0; c < nc; c++) {
+            double sum = b[i * nc + c];
+            for (int k = first[i]; k < i; k++)
+                sum -= Li[k] * b[k * nc + c];
+            b[i * nc + c] = sum / Li[i];
+        }
+    }
+
+    // Backward substitution, L'*X = Y (by columns of L', i.e. by rows of L)
+    for (int i = n - 1; i >= 0; i--) {
+        const double* Li = &values[offset[i]] - first[i];
+        for (int c = 0; c < nc; c++) {
+            double xi = b[i * nc + c] / Li[i];
+            b[i * nc + c] = xi;
+            for (int k = first[i]; k < i; k++)
+                b[k * nc + c] -= Li[k] * xi;
+        }
+    }
+}
+
+void ChEnvelopeMatrix::ReverseCuthillMcKee(const std::vector<std::vector<int> >& adjacency, std::vector<int>& order) {
+    int n = (int)adjacency.size();
+    order.clear();
+    order.reserve(n);
+    std::vector<bool> visited(n, false);
+
+    auto by_degree = [&](int a, int b) { return adjacency[a].size() < adjacency[b].size(); };
+
+    // Breadth-first visit from 'start', with the neighbors in order of increasing degree.
+    // Return the position in 'order' of the first node of the last level.
+    auto visit = [&](int start) {
+        size_t head = order.size();
+        size_t last_level = head;
+        order.push_back(start);
+        visited[start] = true;
+        while (head < order.size()) {
+            size_t level_end = order.size();
+            last_level = head;
+            for (; head < level_end; head++) {
+                std::vector<int> next;
+                for (int j : adjacency[order[head]])
+                    if (!visited[j]) {
+                        visited[j] = true;
+                        next.push_back(j);
+                    }
+                std::stable_sort(next.begin(), next.end(), by_degree);
+                order.insert(order.end(), next.begin(), next.end());
+            }
+        }
+        return last_level;
+    };
+
+    for (int seed = 0; seed < n; seed++) {
+        if (visited[seed])
+            continue;
+
+        // Visit the connected component once, then restart from a node of minimum degree in the
+        // last level (an approximate peripheral node)
+        size_t begin = order.size();
+        size_t last_level = visit(seed);
+        int start = *std::min_element(order.begin() + last_level, order.end(), by_degree);
+        for (size_t k = begin; k < order.size(); k++)
+            visited[order[k]] = false;
+        order.resize(begin);
+        visit(start);
+    }
+
+    std::reverse(order.begin(), order.end());
+}
+
+// -----------------------------------------------------------------------------
+// ChModalAnalysis
+// -----------------------------------------------------------------------------
+
+bool ChModalAnalysis::ComputeModes(const ChEnvelopeMatrix& K_factorized,
+                                   const ChEnvelopeMatrix& M,
+                                   int num_modes,
+                                   ChVectorDynamic<>& eigenvalues,
+                                   ChMatrixDynamic<>& modes,
+                                   double shift,
+                                   double tolerance,
+                                   int max_iterations) {
+    int n = M.GetRows();
+    num_modes = std::min(num_modes, n);
+    eigenvalues.Reset(num_modes);
+    modes.Reset(n, num_modes);
+    if (num_modes == 0)
+        return true;
+
+    // Size of the subspace (more vectors than modes speed up the convergence)
+    int p = std::min(n, std::max(2 * num_modes, num_modes + 8));
+
+    // Starting vectors: the diagonal of M, then deterministic pseudo-random vectors
+    ChMatrixDynamic<> X(n, p);
+    unsigned int seed = 12345;
+    for (int i = 0; i < n; i++) {
+        X(i, 0) = M.Get(i, i);
+        for (int c = 1; c < p; c++) {
+            seed = seed * 1103515245u + 12345u;
+            X(i, c) = ((seed >> 8) & 0xFFFF) / 65535.0 - 0.5;
+        }
+    }
+
+    ChMatrixDynamic<> Y(n, p);
+    M.MultiplyAndAdd(Y, X);
+
+    ChMatrixDynamic<> Kp(p, p);
+    ChMatrixDynamic<> Mp(p, p);
+    ChMatrixDynamic<> Q;
+    ChVectorDynamic<> mu;
+    ChVectorDynamic<> mu_old(p);
+    ChMatrixDynamic<> Z(n, p);
+
+    bool converged = false;
+    for (int iter = 0; iter < max_iterations && !converged; iter++) {
+        // Inverse iteration: (K - shift*M) X = M X_old
+        X = Y;
+        K_factorized.Solve(X);
+
+        // Rayleigh-Ritz projection on the subspace
+        Z.FillElem(0);
+        M.MultiplyAndAdd(Z, X);
+        Kp.MatrTMultiply(X, Y);
+        Mp.MatrTMultiply(X, Z);
+        if (!SolveDenseEigenproblem(Kp, Mp, mu, Q))
+            return false;
+
+        // Update of the vectors, and of their product by M
+        ChMatrixDynamic<> Xn(n, p);
+        Xn.MatrMultiply(X, Q);
+        X = Xn;
+        Y.MatrMultiply(Z, Q);
+
+        converged = (iter > 0);
+        for (int k = 0; k < num_modes; k++) {
+            if (std::abs(mu(k) - mu_old(k)) > tolerance * std::abs(mu(k)))
+                converged = false;
+        }
+        mu_old = mu;
+    }
+
+    for (int k = 0; k < num_modes; k++) {
+        eigenvalues(k) = mu(k) + shift;
+        for (int i = 0; i < n; i++)
+            modes(i, k) = X(i, k);
+    }
+
+    return converged;
+}
+
+bool ChModalAnalysis::SolveDenseEigenproblem(const ChMatrix<>& K,
+                                             const ChMatrix<>& M,
+                                             ChVectorDynamic<>& eigenvalues,
+                                             ChMatrixDynamic<>& Q) {
+    int n = K.GetRows();
+
+    // Cholesky factorization M = L*L'
+    ChMatrixDynamic<> L(n, n);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j <= i; j++) {
+            double sum = M(i, j);
+            for (int k = 0; k < j; k++)
+                sum -= L(i, k) * L(j, k);
+            if (i == j) {
+                if (sum <= 0)
+                    return false;
+                L(i, i) = std::sqrt(sum);
+            } else {
+                L(i, j) = sum / L(j, j);
+            }
+        }
+    }
+
+    // Standard problem C*V = V*diag(eigenvalues), with C = L^-1 * K * L^-T
+    ChMatrixDynamic<> C(K);
+    for (int c = 0; c < n; c++)  // C = L^-1 * K
+        for (int i = 0; i < n; i++) {
+            for (int k = 0; k < i; k++)
+                C(i, c) -= L(i, k) * C(k, c);
+            C(i, c) /= L(i, i);
+        }
+    for (int r = 0; r < n; r++)  // C = C * L^-T
+        for (int i = 0; i < n; i++) {
+            for (int k = 0; k < i; k++)
+                C(r, i) -= L(i, k) * C(r, k);
+            C(r, i) /= L(i, i);
+        }
+    for (int i = 0; i < n; i++)  // remove the roundoff asymmetry
+        for (int j = 0; j < i; j++)
+            C(i, j) = C(j, i) = 0.5 * (C(i, j) + C(j, i));
+
+    // Cyclic Jacobi rotations
+    ChMatrixDynamic<> V(n, n);
+    V.FillDiag(1.0);
+    for (int sweep = 0; sweep < 100; sweep++) {
+        double off = 0;
+        double norm = 0;
+        for (int i = 0; i < n; i++) {
+            norm += C(i, i) * C(i, i);
+            for (int j = 0; j < i; j++)
+                off += C(i, j) * C(i, j);
+        }
+        if (off <= 1e-30 * norm)
+            break;
+
+        for (int p = 0; p < n - 1; p++) {
+            for (int q = p + 1; q < n; q++) {
+                if (C(p, q) == 0)
+                    continue;
+                double theta = (C(q, q) - C(p, p)) / (2 * C(p, q));
+                double t = (theta >= 0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1));
+                double c = 1 / std::sqrt(t * t + 1);
+                double s = t * c;
+                for (int k = 0; k < n; k++) {
+                    double ckp = C(k, p);
+                    double ckq = C(k, q);
+                    C(k, p) = c * ckp - s * ckq;
+                    C(k, q) = s * ckp + c * ckq;
+                }
+                for (int k = 0; k < n; k++) {
+                    double cpk = C(p, k);
+                    double cqk = C(q, k);
+                    C(p, k) = c * cpk - s * cqk;
+                    C(q, k) = s * cpk + c * cqk;
+                }
+                for (int k = 0; k < n; k++) {
+                    double vkp = V(k, p);
+                    double vkq = V(k, q);
+                    V(k, p) = c * vkp - s * vkq;
+                    V(k, q) = s * vkp + c * vkq;
+                }
+            }
+        }
+    }
+
+    // Sort the eigenvalues, and transform the eigenvectors back: Q = L^-T * V
+    std::vector<int> index(n);
+    std::iota(index.begin(), index.end(), 0);
+    std::sort(index.begin(), index.end(), [&](int a, int b) { return C(a, a) < C(b, b); });
+
+    eigenvalues.Reset(n);
+    Q.Reset(n, n);
+    for (int k = 0; k < n; k++) {
+        eigenvalues(k) = C(index[k], index[k]);
+        for (int i = n - 1; i >= 0; i--) {
+            double sum = V(i, index[k]);
+            for (int j = i + 1; j < n; j++)
+                sum -= L(j, i) * Q(j, k);
+            Q(i, k) = sum / L(i, i);
+        }
+    }
+
+    return true;
+}
+
+}  // end namespace fea
+}  // end namespace chrono
@@ -0,0 +1,110 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHMODALANALYSIS_H
+#define CHMODALANALYSIS_H
+
+#include <vector>
+
+#include "chrono/core/ChMatrixDynamic.h"
+#include "chrono/core/ChVectorDynamic.h"
+#include "chrono_fea/ChApiFEA.h"
+
+namespace chrono {
+namespace fea {
+
+/// @addtogroup fea_math
+/// @{
+
+/// Symmetric sparse matrix in envelope (variable band) storage: for each row, the entries of the lower
+/// triangle from the first nonzero of the row up to the diagonal are stored.
+/// The Cholesky factorization fills only the envelope, so it is efficient for the matrices of finite
+/// element meshes if the coordinates are numbered so that coupled coordinates are close to each other
+/// (see ReverseCuthillMcKee).
+class ChApiFea ChEnvelopeMatrix {
+  public:
+    ChEnvelopeMatrix() : factorized(false) {}
+
+    /// Set the envelope: 'first_col[i]' is the column of the first nonzero of row i (not larger than i).
+    /// All entries are set to zero.
+    void Reset(const std::vector<int>& first_col);
+
+    /// Number of rows (and columns).
+    int GetRows() const { return (int)first.size(); }
+
+    /// Number of stored entries.
+    size_t GetNumStoredEntries() const { return values.size(); }
+
+    /// True if the matrix contains its Cholesky factor (see Factorize).
+    bool IsFactorized() const { return factorized; }
+
+    /// Add a value to the entry (i,j), which must be in the envelope. The entry (j,i) is the same entry.
+    void Add(int i, int j, double val);
+
+    /// Return the entry (i,j) (zero outside the envelope).
+    double Get(int i, int j) const;
+
+    /// Compute Y += A*X, where X and Y have as many rows as A (and any number of columns).
+    void MultiplyAndAdd(ChMatrix<>& Y, const ChMatrix<>& X) const;
+
+    /// Replace the matrix with its Cholesky factor L, with A = L*L'.
+    /// Return false if the matrix is not positive definite.
+    bool Factorize();
+
+    /// Solve A*X = B, using the Cholesky factor. B is overwritten with the solution X.
+    void Solve(ChMatrix<>& B) const;
+
+    /// Compute an ordering of the nodes of a graph, given by the lists of adjacent nodes, that reduces the
+    /// envelope of the matrices with the sparsity of the graph (reverse Cuthill-McKee).
+    /// On return, order[k] is the node that goes in the k-th position.
+    static void ReverseCuthillMcKee(const std::vector<std::vector<int> >& adjacency, std::vector<int>& order);
+
+  private:
+    std::vector<int> first;      ///< first column of each row
+    std::vector<size_t> offset;  ///< position of the entry (i, first[i]) in values
+    std::vector<double> values;  ///< entries of the rows, up to the diagonal
+    bool factorized;
+};
+
+/// Computation of the lowest vibration modes of linear structures, i.e. the solutions of the generalized
+/// eigenvalue problem K*x = lambda*M*x with symmetric stiffness and mass matrices.
+class ChApiFea ChModalAnalysis {
+  public:
+    /// Compute the 'num_modes' lowest eigenvalues, and the eigenvectors, with the subspace iteration method.
+    /// The matrix K-shift*M must be given already factorized (see ChEnvelopeMatrix::Factorize): with a negative
+    /// shift, the modes of structures that are not constrained (with zero eigenvalues) can be computed too.
+    /// The eigenvalues are in ascending order, the eigenvectors (the columns of 'modes') are normalized so
+    /// that modes'*M*modes = I. Return false if the eigenvalues did not converge to the given relative tolerance.
+    static bool ComputeModes(const ChEnvelopeMatrix& K_factorized,
+                             const ChEnvelopeMatrix& M,
+                             int num_modes,
+                             ChVectorDynamic<>& eigenvalues,
+                             ChMatrixDynamic<>& modes,
+                             double shift = 0,
+                             double tolerance = 1e-10,
+                             int max_iterations = 200);
+
+    /// Solve the dense generalized eigenvalue problem K*Q = M*Q*diag(eigenvalues), with symmetric K and
+    /// symmetric positive definite M. The eigenvalues are in ascending order, and Q'*M*Q = I.
+    /// Return false if M is not positive definite.
+    static bool SolveDenseEigenproblem(const ChMatrix<>& K,
+                                       const ChMatrix<>& M,
+                                       ChVectorDynamic<>& eigenvalues,
+                                       ChMatrixDynamic<>& Q);
+};
+
+/// @} fea_math
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
@@ -0,0 +1,823 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+
+#include "chrono/core/ChException.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono_fea/ChModalAnalysis.h"
+#include "chrono_fea/ChModalBody.h"
+
+namespace chrono {
+namespace fea {
+
+ChModalBody::ChModalBody(ChMaterialSurface::ContactMethod contact_method)
+    : ChBodyAuxRef(contact_method), n_modes(0), modal_variables(NULL) {}
+
+ChModalBody::ChModalBody(const ChModalBody& other) : ChBodyAuxRef(other) {
+    mesh = other.mesh;
+    xyz_nodes = other.xyz_nodes;
+    xyzrot_nodes = other.xyzrot_nodes;
+    xyz_offset = other.xyz_offset;
+    xyzrot_offset = other.xyzrot_offset;
+    n_modes = other.n_modes;
+    Phi = other.Phi;
+    Ct = other.Ct;
+    Cr = other.Cr;
+    for (int k = 0; k < 3; k++) {
+        Gq[k] = other.Gq[k];
+        Gt[k] = other.Gt[k];
+        Gr[k] = other.Gr[k];
+    }
+    P = other.P;
+    eigenvalues = other.eigenvalues;
+    damping = other.damping;
+    q = other.q;
+    q_dt = other.q_dt;
+    q_dtdt = other.q_dtdt;
+
+    modal_variables = NULL;
+    if (other.modal_variables) {
+        modal_variables = new ChVariablesGenericDiagonalMass(n_modes);
+        *modal_variables = *other.modal_variables;
+    }
+    SetupKRMblock();
+}
+
+ChModalBody::~ChModalBody() {
+    delete modal_variables;
+}
+
+void ChModalBody::Reduce(std::shared_ptr<ChMesh> mmesh, int num_modes) {
+    mesh = mmesh;
+    xyz_nodes.clear();
+    xyzrot_nodes.clear();
+    xyz_offset.clear();
+    xyzrot_offset.clear();
+
+    for (unsigned int ie = 0; ie < mesh->GetNelements(); ie++) {
+        mesh->GetElement(ie)->SetupInitial(mesh->GetSystem());
+        mesh->GetElement(ie)->Update();
+    }
+
+    // Index of the nodes, and index of the free nodes (-1 for the fixed nodes)
+    int nn = (int)mesh->GetNnodes();
+    std::unordered_map<ChNodeFEAbase*, int> node_index;
+    std::vector<int> node_dofs(nn);
+    std::vector<int> free_index(nn, -1);
+    std::vector<int> free_nodes;
+    for (int j = 0; j < nn; j++) {
+        auto node = std::dynamic_pointer_cast<ChNodeFEAbase>(mesh->GetNode(j));
+        if (!node)
+            throw ChException("ChModalBody: only meshes of ChNodeFEAxyz and ChNodeFEAxyzrot nodes can be reduced.");
+        if (node->Get_ndof_w() == 6 && std::dynamic_pointer_cast<ChNodeFEAxyzrot>(node))
+            node_dofs[j] = 6;
+        else if (node->Get_ndof_w() == 3 && std::dynamic_pointer_cast<ChNodeFEAxyz>(node))
+            node_dofs[j] = 3;
+        else
+            throw ChException("ChModalBody: only meshes of ChNodeFEAxyz and ChNodeFEAxyzrot nodes can be reduced.");
+        node_index[node.get()] = j;
+        if (!node->GetFixed()) {
+            free_index[j] = (int)free_nodes.size();
+            free_nodes.push_back(j);
+        }
+    }
+    int nfn = (int)free_nodes.size();
+
+    // Nodes of the elements, and adjacency of the free nodes
+    int ne = (int)mesh->GetNelements();
+    std::vector<std::vector<int>> element_nodes(ne);
+    std::vector<std::vector<int>> adjacency(nfn);
+    for (int ie = 0; ie < ne; ie++) {
+        auto element = mesh->GetElement(ie);
+        for (int n = 0; n < element->GetNnodes(); n++) {
+            auto it = node_index.find(element->GetNodeN(n).get());
+            if (it == node_index.end())
+                throw ChException("ChModalBody: the nodes of the elements must be in the mesh.");
+            if (element->GetNodeNdofs(n) != node_dofs[it->second])
+                throw ChException("ChModalBody: only meshes of ChNodeFEAxyz and ChNodeFEAxyzrot nodes can be reduced.");
+            element_nodes[ie].push_back(it->second);
+        }
+        for (int a : element_nodes[ie])
+            for (int b : element_nodes[ie])
+                if (free_index[a] >= 0 && free_index[b] >= 0 && a != b)
+                    adjacency[free_index[a]].push_back(free_index[b]);
+    }
+    for (auto& list : adjacency) {
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+    }
+
+    // Number the free nodes so that the envelope of their matrices is small, then the fixed nodes.
+    // The coordinates of the nodes follow this numbering: the free coordinates are the first nf ones.
+    std::vector<int> order;
+    ChEnvelopeMatrix::ReverseCuthillMcKee(adjacency, order);
+    std::vector<int> numbering;
+    for (int k = 0; k < nfn; k++)
+        numbering.push_back(free_nodes[order[k]]);
+    for (int j = 0; j < nn; j++)
+        if (free_index[j] < 0)
+            numbering.push_back(j);
+    std::vector<int> position(nn);
+    std::vector<int> offset(nn);
+    int nt = 0;
+    int nf = 0;
+    for (int k = 0; k < nn; k++) {
+        int j = numbering[k];
+        position[j] = k;
+        offset[j] = nt;
+        nt += node_dofs[j];
+        if (k < nfn)
+            nf = nt;
+    }
+
+    std::vector<int> first_node(nn);
+    for (int k = 0; k < nn; k++)
+        first_node[k] = k;
+    for (auto& element : element_nodes) {
+        int min_node = nn;
+        for (int j : element)
+            min_node = std::min(min_node, position[j]);
+        for (int j : element)
+            first_node[position[j]] = std::min(first_node[position[j]], min_node);
+    }
+    std::vector<int> first_col(nf);
+    for (int k = 0; k < nfn; k++) {
+        int j = numbering[k];
+        for (int d = 0; d < node_dofs[j]; d++)
+            first_col[offset[j] + d] = offset[numbering[first_node[k]]];
+    }
+
+    // Assemble the stiffness and mass matrices of the free coordinates, and the mass and damping matrices of
+    // all coordinates (as lists of nonzero entries)
+    ChEnvelopeMatrix K_ff;
+    ChEnvelopeMatrix M_ff;
+    K_ff.Reset(first_col);
+    M_ff.Reset(first_col);
+    std::vector<int> M_row, M_col, R_row, R_col;
+    std::vector<double> M_val, R_val;
+    auto add_mass = [&](int i, int j, double val) {
+        M_row.push_back(i);
+        M_col.push_back(j);
+        M_val.push_back(val);
+        if (i < nf && j < nf && i >= j)
+            M_ff.Add(i, j, val);
+    };
+    for (int ie = 0; ie < ne; ie++) {
+        auto element = mesh->GetElement(ie);
+        std::vector<int> dofs;
+        for (int j : element_nodes[ie])
+            for (int d = 0; d < node_dofs[j]; d++)
+                dofs.push_back(offset[j] + d);
+        int nd = (int)dofs.size();
+        if (nd != element->GetNdofs())
+            throw ChException("ChModalBody: only meshes of ChNodeFEAxyz and ChNodeFEAxyzrot nodes can be reduced.");
+        ChMatrixDynamic<> H(nd, nd);
+        for (int a = 0; a < 3; a++) {
+            H.FillElem(0);
+            element->ComputeKRMmatricesGlobal(H, a == 0 ? 1.0 : 0.0, a == 1 ? 1.0 : 0.0, a == 2 ? 1.0 : 0.0);
+            for (int r = 0; r < nd; r++) {
+                for (int c = 0; c < nd; c++) {
+                    double val = H(r, c);
+                    int i = dofs[r];
+                    int j = dofs[c];
+                    if (val == 0)
+                        continue;
+                    if (a == 0) {
+                        if (i < nf && j < nf && i >= j)
+                            K_ff.Add(i, j, val);
+                    } else if (a == 1) {
+                        R_row.push_back(i);
+                        R_col.push_back(j);
+                        R_val.push_back(val);
+                    } else {
+                        add_mass(i, j, val);
+                    }
+                }
+            }
+        }
+    }
+
+    // Masses of the nodes, and reference positions and rotations of the nodes
+    std::vector<ChVector<>> x0(nn);
+    std::vector<ChMatrix33<>> R0(nn);
+    for (int j = 0; j < nn; j++) {
+        int o = offset[j];
+        if (node_dofs[j] == 6) {
+            auto node = std::dynamic_pointer_cast<ChNodeFEAxyzrot>(mesh->GetNode(j));
+            x0[j] = node->GetX0().GetPos();
+            R0[j] = node->GetX0().GetA();
+            for (int i = 0; i < 3; i++) {
+                if (node->GetMass())
+                    add_mass(o + i, o + i, node->GetMass());
+                for (int k = 0; k < 3; k++)
+                    if (node->GetInertia()(i, k))
+                        add_mass(o + 3 + i, o + 3 + k, node->GetInertia()(i, k));
+            }
+            xyzrot_nodes.push_back(node);
+            xyzrot_offset.push_back(o);
+        } else {
+            auto node = std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(j));
+            x0[j] = node->GetX0();
+            R0[j].Set33Identity();
+            for (int i = 0; i < 3; i++)
+                if (node->GetMass())
+                    add_mass(o + i, o + i, node->GetMass());
+            xyz_nodes.push_back(node);
+            xyz_offset.push_back(o);
+        }
+    }
+
+    // Y += M*X and Y += R*X, with the mass and damping matrices of all coordinates
+    auto multiply = [](const std::vector<int>& rows, const std::vector<int>& cols, const std::vector<double>& vals,
+                       ChMatrix<>& Y, const ChMatrix<>& X) {
+        for (size_t t = 0; t < vals.size(); t++)
+            for (int c = 0; c < X.GetColumns(); c++)
+                Y(rows[t], c) += vals[t] * X(cols[t], c);
+    };
+
+    // Rigid body motions: translations along x, y, z, then rotations about x, y, z (about the origin of the
+    // reference frame at first, to find the center of mass)
+    ChMatrixDynamic<> Gamma(nt, 6);
+    ChMatrixDynamic<> MGamma(nt, 6);
+    for (int j = 0; j < nn; j++)
+        for (int i = 0; i < 3; i++)
+            Gamma(offset[j] + i, i) = 1;
+    multiply(M_row, M_col, M_val, MGamma, Gamma);
+    double mass = 0;
+    ChVector<> com(0);
+    for (int j = 0; j < nn; j++) {
+        for (int i = 0; i < 3; i++) {
+            mass += MGamma(offset[j] + i, i);
+            for (int k = 0; k < 3; k++)
+                com[k] += x0[j][i] * MGamma(offset[j] + i, k);
+        }
+    }
+    mass /= 3;
+    if (!(mass > 0))
+        throw ChException("ChModalBody: the mesh has no mass.");
+    com /= mass;
+
+    for (int j = 0; j < nn; j++) {
+        ChVector<> r = x0[j] - com;
+        for (int k = 0; k < 3; k++) {
+            ChVector<> e(0);
+            e[k] = 1;
+            Gamma.PasteVector(e % r, offset[j], 3 + k);
+            if (node_dofs[j] == 6)
+                Gamma.PasteVector(R0[j].MatrT_x_Vect(e), offset[j] + 3, 3 + k);
+        }
+    }
+    MGamma.FillElem(0);
+    multiply(M_row, M_col, M_val, MGamma, Gamma);
+    ChMatrixDynamic<> GtMG(6, 6);
+    GtMG.MatrTMultiply(Gamma, MGamma);
+    ChMatrix33<> inertia;
+    for (int i = 0; i < 3; i++)
+        for (int k = 0; k < 3; k++)
+            inertia(i, k) = 0.5 * (GtMG(3 + i, 3 + k) + GtMG(3 + k, 3 + i));
+
+    SetMass(mass);
+    SetInertia(inertia);
+    SetFrame_COG_to_REF(ChFrame<>(com));
+
+    // Vibration modes: clamped at the fixed nodes, or free-free modes
+    bool free_free = (nf == nt);
+    int n_rigid = free_free ? 6 : 0;
+    if (num_modes < 0 || num_modes + n_rigid > nf)
+        throw ChException("ChModalBody: the number of modes exceeds the number of free coordinates.");
+    n_modes = num_modes;
+    Phi.Reset(nt, n_modes);
+    eigenvalues.Reset(n_modes);
+
+    if (n_modes > 0) {
+        // For free-free modes, the stiffness matrix is singular: use a negative shift, small with respect to the
+        // lowest flexible eigenvalue, as estimated with the Rayleigh quotient of quadratic (bending) displacements
+        double shift = 0;
+        if (free_free) {
+            double length = 0;
+            for (int j = 0; j < nn; j++)
+                length = std::max(length, (x0[j] - com).Length());
+            ChMatrix33<> inertia_inv;
+            inertia.FastInvert(inertia_inv);
+            double min_quotient = 0;
+            for (int a = 0; a < 3; a++) {
+                ChVector<> e(0);
+                e[a] = 1;
+                ChMatrixDynamic<> u(nt, 1);
+                for (int j = 0; j < nn; j++) {
+                    ChVector<> r = x0[j] - com;
+                    u.PasteVector(e * (r.Length2() / (2 * length)), offset[j], 0);
+                    if (node_dofs[j] == 6)
+                        u.PasteVector(R0[j].MatrT_x_Vect(r % e) / length, offset[j] + 3, 0);
+                }
+                // remove the rigid body motion
+                ChMatrixDynamic<> GtMu(6, 1);
+                GtMu.MatrTMultiply(MGamma, u);
+                ChVector<> alpha_t = GtMu.ClipVector(0, 0) / mass;
+                ChVector<> alpha_r = inertia_inv * GtMu.ClipVector(3, 0);
+                for (int i = 0; i < nt; i++)
+                    for (int k = 0; k < 3; k++)
+                        u(i) -= Gamma(i, k) * alpha_t[k] + Gamma(i, 3 + k) * alpha_r[k];
+
+                ChMatrixDynamic<> Ku(nt, 1);
+                ChMatrixDynamic<> Mu(nt, 1);
+                K_ff.MultiplyAndAdd(Ku, u);
+                multiply(M_row, M_col, M_val, Mu, u);
+                double uKu = 0;
+                double uMu = 0;
+                for (int i = 0; i < nt; i++) {
+                    uKu += u(i) * Ku(i);
+                    uMu += u(i) * Mu(i);
+                }
+                if (uMu > 0 && (a == 0 || uKu / uMu < min_quotient))
+                    min_quotient = uKu / uMu;
+            }
+            if (!(min_quotient > 0))
+                throw ChException("ChModalBody: the free-free modes of the mesh cannot be computed.");
+            shift = -0.01 * min_quotient;
+        }
+
+        ChEnvelopeMatrix K_factorized(K_ff);
+        if (shift != 0) {
+            for (int i = 0; i < nf; i++)
+                for (int j = first_col[i]; j <= i; j++)
+                    K_factorized.Add(i, j, -shift * M_ff.Get(i, j));
+        }
+        if (!K_factorized.Factorize())
+            throw ChException(
+                "ChModalBody: the stiffness matrix of the free nodes is not positive definite (there must be no "
+                "mechanisms in the mesh).");
+
+        ChVectorDynamic<> eig;
+        ChMatrixDynamic<> modes;
+        if (!ChModalAnalysis::ComputeModes(K_factorized, M_ff, n_modes + n_rigid, eig, modes, shift))
+            throw ChException("ChModalBody: the computation of the vibration modes did not converge.");
+        for (int k = 0; k < n_modes; k++) {
+            eigenvalues(k) = eig(n_rigid + k);
+            for (int i = 0; i < nf; i++)
+                Phi(i, k) = modes(i, n_rigid + k);
+        }
+    }
+
+    // Inertia invariants: coupling with the body translation and rotation (about the center of mass)
+    ChMatrixDynamic<> PhitMG(n_modes, 6);
+    PhitMG.MatrTMultiply(Phi, MGamma);
+    Ct.Reset(n_modes, 3);
+    Cr.Reset(n_modes, 3);
+    for (int i = 0; i < n_modes; i++) {
+        for (int k = 0; k < 3; k++) {
+            Ct(i, k) = PhitMG(i, k);
+            Cr(i, k) = PhitMG(i, 3 + k);
+        }
+    }
+
+    // Coriolis invariants: relative accelerations 2*w x du/dt of the translations, and w x d(theta)/dt of the
+    // rotations (in the node frames), per unit angular velocity w about x, y, z
+    ChMatrixDynamic<> MPhi(nt, n_modes);
+    multiply(M_row, M_col, M_val, MPhi, Phi);
+    for (int k = 0; k < 3; k++) {
+        ChVector<> e(0);
+        e[k] = 1;
+        ChMatrixDynamic<> XPhi(nt, n_modes);
+        for (int j = 0; j < nn; j++) {
+            int o = offset[j];
+            for (int i = 0; i < n_modes; i++) {
+                XPhi.PasteVector(e % Phi.ClipVector(o, i) * 2, o, i);
+                if (node_dofs[j] == 6)
+                    XPhi.PasteVector(R0[j].MatrT_x_Vect(e % (R0[j] * Phi.ClipVector(o + 3, i))), o + 3, i);
+            }
+        }
+        Gq[k].Reset(n_modes, n_modes);
+        Gq[k].MatrTMultiply(MPhi, XPhi);
+        ChMatrixDynamic<> GtMX(6, n_modes);
+        GtMX.MatrTMultiply(MGamma, XPhi);
+        Gt[k].Reset(3, n_modes);
+        Gr[k].Reset(3, n_modes);
+        for (int a = 0; a < 3; a++) {
+            for (int i = 0; i < n_modes; i++) {
+                Gt[k](a, i) = GtMX(a, i);
+                Gr[k](a, i) = GtMX(3 + a, i);
+            }
+        }
+    }
+
+    // Centrifugal invariants: accelerations e_a x (e_b x r) of the points of the mesh
+    ChMatrixDynamic<> Y(nt, 9);
+    for (int j = 0; j < nn; j++) {
+        ChVector<> r = x0[j] - com;
+        for (int a = 0; a < 3; a++) {
+            for (int b = 0; b < 3; b++) {
+                ChVector<> ea(0);
+                ChVector<> eb(0);
+                ea[a] = 1;
+                eb[b] = 1;
+                Y.PasteVector(ea % (eb % r), offset[j], 3 * a + b);
+            }
+        }
+    }
+    P.Reset(n_modes, 9);
+    P.MatrTMultiply(MPhi, Y);
+
+    // Modal damping of the elements (the diagonal of Phi'*R*Phi)
+    ChMatrixDynamic<> RPhi(nt, n_modes);
+    multiply(R_row, R_col, R_val, RPhi, Phi);
+    damping.Reset(n_modes);
+    for (int k = 0; k < n_modes; k++)
+        for (int i = 0; i < nt; i++)
+            damping(k) += Phi(i, k) * RPhi(i, k);
+
+    // Modal coordinates, with their variables (unit modal masses; the inertia coupling with the body is in
+    // the block of the modal stiffness and damping)
+    q.Reset(n_modes);
+    q_dt.Reset(n_modes);
+    q_dtdt.Reset(n_modes);
+    delete modal_variables;
+    modal_variables = NULL;
+    if (n_modes > 0)
+        modal_variables = new ChVariablesGenericDiagonalMass(n_modes);
+    SetupKRMblock();
+}
+
+void ChModalBody::SetupKRMblock() {
+    if (!modal_variables)
+        return;
+    std::vector<ChVariables*> vars;
+    vars.push_back(&Variables());
+    vars.push_back(modal_variables);
+    KRM_block.SetVariables(vars);
+}
+
+void ChModalBody::SetModalCoordinates(const ChVectorDynamic<>& mq, const ChVectorDynamic<>& mq_dt) {
+    if (mq.GetRows() != n_modes || mq_dt.GetRows() != n_modes)
+        throw ChException("ChModalBody: wrong number of modal coordinates.");
+    q = mq;
+    q_dt = mq_dt;
+}
+
+void ChModalBody::SetModalDamping(double zeta) {
+    for (int k = 0; k < n_modes; k++)
+        damping(k) = 2 * zeta * std::sqrt(std::max(eigenvalues(k), 0.0));
+}
+
+void ChModalBody::ComputeModalForces(ChVector<>& F, ChVector<>& T, ChVectorDynamic<>& Fq) {
+    const ChMatrix33<>& A = GetA();
+    ChVector<> w = GetWvel_loc();
+    ChVector<> F_loc(0);
+    T = VNULL;
+    Fq.Reset(n_modes);
+
+    // Coriolis forces
+    for (int k = 0; k < 3; k++) {
+        if (w[k] == 0)
+            continue;
+        for (int i = 0; i < n_modes; i++) {
+            double sum = 0;
+            for (int j = 0; j < n_modes; j++)
+                sum += Gq[k](i, j) * q_dt(j);
+            Fq(i) -= w[k] * sum;
+        }
+        for (int a = 0; a < 3; a++) {
+            for (int j = 0; j < n_modes; j++) {
+                F_loc[a] -= w[k] * Gt[k](a, j) * q_dt(j);
+                T[a] -= w[k] * Gr[k](a, j) * q_dt(j);
+            }
+        }
+    }
+
+    // Centrifugal forces
+    for (int a = 0; a < 3; a++) {
+        for (int b = 0; b < 3; b++) {
+            double ww = w[a] * w[b];
+            if (ww == 0)
+                continue;
+            for (int i = 0; i < n_modes; i++)
+                Fq(i) -= ww * P(i, 3 * a + b);
+        }
+    }
+
+    // Elastic and damping forces
+    for (int i = 0; i < n_modes; i++)
+        Fq(i) -= eigenvalues(i) * q(i) + damping(i) * q_dt(i);
+
+    // Gravity (the gravity on the body is in ChBody)
+    if (GetSystem()) {
+        ChVector<> g_loc = A.MatrT_x_Vect(GetSystem()->Get_G_acc());
+        for (int i = 0; i < n_modes; i++)
+            Fq(i) += Ct(i, 0) * g_loc.x() + Ct(i, 1) * g_loc.y() + Ct(i, 2) * g_loc.z();
+    }
+
+    F = A * F_loc;
+
+    // Forces and torques applied to the nodes of the mesh
+    ChVector<> com = GetFrame_COG_to_REF().GetPos();
+    for (size_t k = 0; k < xyz_nodes.size(); k++) {
+        ChVector<> f = xyz_nodes[k]->GetForce();
+        if (f.IsNull())
+            continue;
+        ChVector<> f_loc = A.MatrT_x_Vect(f);
+        F += f;
+        T += (xyz_nodes[k]->GetX0() - com) % f_loc;
+        for (int i = 0; i < n_modes; i++)
+            Fq(i) += Phi.ClipVector(xyz_offset[k], i) ^ f_loc;
+    }
+    for (size_t k = 0; k < xyzrot_nodes.size(); k++) {
+        ChVector<> f = xyzrot_nodes[k]->GetForce();
+        ChVector<> t = xyzrot_nodes[k]->GetTorque();
+        if (f.IsNull() && t.IsNull())
+            continue;
+        ChVector<> f_loc = A.MatrT_x_Vect(f);
+        const ChFrame<>& X0 = xyzrot_nodes[k]->GetX0();
+        F += f;
+        T += (X0.GetPos() - com) % f_loc + X0.GetA() * t;
+        for (int i = 0; i < n_modes; i++)
+            Fq(i) += (Phi.ClipVector(xyzrot_offset[k], i) ^ f_loc) + (Phi.ClipVector(xyzrot_offset[k] + 3, i) ^ t);
+    }
+}
+
+void ChModalBody::ComputeCouplingMv(const ChVector<>& w_v,
+                                    const ChVector<>& w_w,
+                                    const ChVectorDynamic<>& w_q,
+                                    ChVector<>& Mw_v,
+                                    ChVector<>& Mw_w,
+                                    ChVectorDynamic<>& Mw_q) {
+    const ChMatrix33<>& A = GetA();
+    ChVector<> Ctq(0);
+    Mw_w = VNULL;
+    for (int i = 0; i < n_modes; i++) {
+        for (int k = 0; k < 3; k++) {
+            Ctq[k] += Ct(i, k) * w_q(i);
+            Mw_w[k] += Cr(i, k) * w_q(i);
+        }
+    }
+    Mw_v = A * Ctq;
+
+    ChVector<> w_v_loc = A.MatrT_x_Vect(w_v);
+    Mw_q.Reset(n_modes);
+    for (int i = 0; i < n_modes; i++)
+        for (int k = 0; k < 3; k++)
+            Mw_q(i) += Ct(i, k) * w_v_loc[k] + Cr(i, k) * w_w[k];
+}
+
+void ChModalBody::UpdateMeshNodes() {
+    const ChMatrix33<>& A = GetA();
+    ChVector<> w = GetWvel_loc();
+    ChVector<> com = GetFrame_COG_to_REF().GetPos();
+
+    // Displacements and their time derivatives, at the given rows of the modes
+    auto displacement = [&](int row, ChVector<>& u, ChVector<>& u_dt) {
+        u = VNULL;
+        u_dt = VNULL;
+        for (int i = 0; i < n_modes; i++) {
+            ChVector<> phi = Phi.ClipVector(row, i);
+            u += phi * q(i);
+            u_dt += phi * q_dt(i);
+        }
+    };
+
+    ChVector<> u, u_dt;
+    for (size_t k = 0; k < xyz_nodes.size(); k++) {
+        displacement(xyz_offset[k], u, u_dt);
+        ChVector<> r = xyz_nodes[k]->GetX0() - com + u;
+        xyz_nodes[k]->SetPos(GetPos() + A * r);
+        xyz_nodes[k]->SetPos_dt(GetPos_dt() + A * ((w % r) + u_dt));
+    }
+    for (size_t k = 0; k < xyzrot_nodes.size(); k++) {
+        const ChFrame<>& X0 = xyzrot_nodes[k]->GetX0();
+        displacement(xyzrot_offset[k], u, u_dt);
+        ChVector<> r = X0.GetPos() - com + u;
+        ChVector<> theta, theta_dt;
+        displacement(xyzrot_offset[k] + 3, theta, theta_dt);
+        ChQuaternion<> q_theta;
+        q_theta.Q_from_Rotv(theta);
+        ChFrameMoving<>& frame = xyzrot_nodes[k]->Frame();
+        frame.SetPos(GetPos() + A * r);
+        frame.SetRot(GetRot() * X0.GetRot() * q_theta);
+        frame.SetPos_dt(GetPos_dt() + A * ((w % r) + u_dt));
+        frame.SetWvel_loc(q_theta.RotateBack(X0.GetA().MatrT_x_Vect(w)) + theta_dt);
+    }
+}
+
+//// STATE BOOKKEEPING FUNCTIONS
+
+void ChModalBody::IntStateGather(const unsigned int off_x,
+                                 ChState& x,
+                                 const unsigned int off_v,
+                                 ChStateDelta& v,
+                                 double& T) {
+    ChBodyAuxRef::IntStateGather(off_x, x, off_v, v, T);
+    for (int i = 0; i < n_modes; i++) {
+        x(off_x + 7 + i) = q(i);
+        v(off_v + 6 + i) = q_dt(i);
+    }
+}
+
+void ChModalBody::IntStateScatter(const unsigned int off_x,
+                                  const ChState& x,
+                                  const unsigned int off_v,
+                                  const ChStateDelta& v,
+                                  const double T) {
+    for (int i = 0; i < n_modes; i++) {
+        q(i) = x(off_x + 7 + i);
+        q_dt(i) = v(off_v + 6 + i);
+    }
+    ChBodyAuxRef::IntStateScatter(off_x, x, off_v, v, T);
+}
+
+void ChModalBody::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
+    ChBodyAuxRef::IntStateGatherAcceleration(off_a, a);
+    for (int i = 0; i < n_modes; i++)
+        a(off_a + 6 + i) = q_dtdt(i);
+}
+
+void ChModalBody::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
+    ChBodyAuxRef::IntStateScatterAcceleration(off_a, a);
+    for (int i = 0; i < n_modes; i++)
+        q_dtdt(i) = a(off_a + 6 + i);
+}
+
+void ChModalBody::IntStateIncrement(const unsigned int off_x,
+                                    ChState& x_new,
+                                    const ChState& x,
+                                    const unsigned int off_v,
+                                    const ChStateDelta& Dv) {
+    ChBodyAuxRef::IntStateIncrement(off_x, x_new, x, off_v, Dv);
+    for (int i = 0; i < n_modes; i++)
+        x_new(off_x + 7 + i) = x(off_x + 7 + i) + Dv(off_v + 6 + i);
+}
+
+void ChModalBody::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) {
+    // forces on the rigid body
+    ChBodyAuxRef::IntLoadResidual_F(off, R, c);
+
+    // forces of the modes
+    ChVector<> F, T;
+    ChVectorDynamic<> Fq;
+    ComputeModalForces(F, T, Fq);
+    R.PasteSumVector(F * c, off, 0);
+    R.PasteSumVector(T * c, off + 3, 0);
+    for (int i = 0; i < n_modes; i++)
+        R(off + 6 + i) += c * Fq(i);
+}
+
+void ChModalBody::IntLoadResidual_Mv(const unsigned int off,
+                                     ChVectorDynamic<>& R,
+                                     const ChVectorDynamic<>& w,
+                                     const double c) {
+    // mass and inertia of the rigid body
+    ChBodyAuxRef::IntLoadResidual_Mv(off, R, w, c);
+
+    // unit modal masses, and inertia coupling
+    ChVectorDynamic<> w_q(n_modes);
+    for (int i = 0; i < n_modes; i++)
+        w_q(i) = w(off + 6 + i);
+    ChVector<> Mw_v, Mw_w;
+    ChVectorDynamic<> Mw_q;
+    ComputeCouplingMv(w.ClipVector(off, 0), w.ClipVector(off + 3, 0), w_q, Mw_v, Mw_w, Mw_q);
+    R.PasteSumVector(Mw_v * c, off, 0);
+    R.PasteSumVector(Mw_w * c, off + 3, 0);
+    for (int i = 0; i < n_modes; i++)
+        R(off + 6 + i) += c * (w_q(i) + Mw_q(i));
+}
+
+bool ChModalBody::IntLoadLumpedMass_Md(const unsigned int off, ChVectorDynamic<>& Md, const double c, bool hrz) {
+    // The mass matrix is not diagonal because of the inertia coupling: let the caller lump it.
+    return false;
+}
+
+void ChModalBody::IntToDescriptor(const unsigned int off_v,
+                                  const ChStateDelta& v,
+                                  const ChVectorDynamic<>& R,
+                                  const unsigned int off_L,
+                                  const ChVectorDynamic<>& L,
+                                  const ChVectorDynamic<>& Qc) {
+    ChBodyAuxRef::IntToDescriptor(off_v, v, R, off_L, L, Qc);
+    if (modal_variables) {
+        modal_variables->Get_qb().PasteClippedMatrix(v, off_v + 6, 0, n_modes, 1, 0, 0);
+        modal_variables->Get_fb().PasteClippedMatrix(R, off_v + 6, 0, n_modes, 1, 0, 0);
+    }
+}
+
+void ChModalBody::IntFromDescriptor(const unsigned int off_v,
+                                    ChStateDelta& v,
+                                    const unsigned int off_L,
+                                    ChVectorDynamic<>& L) {
+    ChBodyAuxRef::IntFromDescriptor(off_v, v, off_L, L);
+    if (modal_variables)
+        v.PasteMatrix(modal_variables->Get_qb(), off_v + 6, 0);
+}
+
+//// SOLVER FUNCTIONS
+
+void ChModalBody::InjectVariables(ChSystemDescriptor& mdescriptor) {
+    ChBodyAuxRef::InjectVariables(mdescriptor);
+    if (modal_variables) {
+        modal_variables->SetDisabled(!IsActive());
+        mdescriptor.InsertVariables(modal_variables);
+    }
+}
+
+void ChModalBody::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
+    if (modal_variables)
+        mdescriptor.InsertKblock(&KRM_block);
+}
+
+void ChModalBody::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
+    if (!modal_variables)
+        return;
+
+    // Variables: body translation and rotation, then the modal coordinates (the mass of the body and the unit
+    // modal masses are in the variables)
+    ChMatrix<>& H = *KRM_block.Get_K();
+    H.FillElem(0);
+    const ChMatrix33<>& A = GetA();
+    for (int i = 0; i < n_modes; i++) {
+        ChVector<> ACt = A * ChVector<>(Ct(i, 0), Ct(i, 1), Ct(i, 2));
+        for (int k = 0; k < 3; k++) {
+            H(k, 6 + i) = H(6 + i, k) = Mfactor * ACt[k];
+            H(3 + k, 6 + i) = H(6 + i, 3 + k) = Mfactor * Cr(i, k);
+        }
+        H(6 + i, 6 + i) = Kfactor * eigenvalues(i) + Rfactor * damping(i);
+    }
+}
+
+void ChModalBody::VariablesFbReset() {
+    ChBodyAuxRef::VariablesFbReset();
+    if (modal_variables)
+        modal_variables->Get_fb().FillElem(0);
+}
+
+void ChModalBody::VariablesFbLoadForces(double factor) {
+    // forces on the rigid body
+    ChBodyAuxRef::VariablesFbLoadForces(factor);
+
+    // forces of the modes
+    ChVector<> F, T;
+    ChVectorDynamic<> Fq;
+    ComputeModalForces(F, T, Fq);
+    Variables().Get_fb().PasteSumVector(F * factor, 0, 0);
+    Variables().Get_fb().PasteSumVector(T * factor, 3, 0);
+    for (int i = 0; i < n_modes; i++)
+        modal_variables->Get_fb()(i) += factor * Fq(i);
+}
+
+void ChModalBody::VariablesQbLoadSpeed() {
+    ChBodyAuxRef::VariablesQbLoadSpeed();
+    if (modal_variables)
+        modal_variables->Get_qb().PasteMatrix(q_dt, 0, 0);
+}
+
+void ChModalBody::VariablesFbIncrementMq() {
+    // mass and inertia of the rigid body
+    ChBodyAuxRef::VariablesFbIncrementMq();
+    if (!modal_variables)
+        return;
+
+    // unit modal masses, and inertia coupling
+    modal_variables->Compute_inc_Mb_v(modal_variables->Get_fb(), modal_variables->Get_qb());
+    ChVector<> Mw_v, Mw_w;
+    ChVectorDynamic<> Mw_q;
+    ChVectorDynamic<> w_q(n_modes);
+    w_q.PasteMatrix(modal_variables->Get_qb(), 0, 0);
+    ComputeCouplingMv(Variables().Get_qb().ClipVector(0, 0), Variables().Get_qb().ClipVector(3, 0), w_q, Mw_v,
+                      Mw_w, Mw_q);
+    Variables().Get_fb().PasteSumVector(Mw_v, 0, 0);
+    Variables().Get_fb().PasteSumVector(Mw_w, 3, 0);
+    modal_variables->Get_fb().MatrInc(Mw_q);
+}
+
+void ChModalBody::VariablesQbSetSpeed(double step) {
+    ChBodyAuxRef::VariablesQbSetSpeed(step);
+    for (int i = 0; i < n_modes; i++) {
+        double old_dt = q_dt(i);
+        q_dt(i) = modal_variables->Get_qb()(i);
+        if (step)
+            q_dtdt(i) = (q_dt(i) - old_dt) / step;
+    }
+}
+
+void ChModalBody::VariablesQbIncrementPosition(double step) {
+    ChBodyAuxRef::VariablesQbIncrementPosition(step);
+    for (int i = 0; i < n_modes; i++)
+        q(i) += modal_variables->Get_qb()(i) * step;
+}
+
+void ChModalBody::SetNoSpeedNoAcceleration() {
+    ChBodyAuxRef::SetNoSpeedNoAcceleration();
+    q_dt.FillElem(0);
+    q_dtdt.FillElem(0);
+}
+
+}  // end namespace fea
+}  // end namespace chrono
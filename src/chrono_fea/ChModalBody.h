@@ -0,0 +1,204 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHMODALBODY_H
+#define CHMODALBODY_H
+
+#include "chrono/physics/ChBodyAuxRef.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChVariablesGenericDiagonalMass.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChNodeFEAxyz.h"
+#include "chrono_fea/ChNodeFEAxyzrot.h"
+
+namespace chrono {
+namespace fea {
+
+/// @addtogroup fea_module
+/// @{
+
+/// Flexible body with a floating frame of reference: a rigid body whose motion is the large motion of a
+/// linear elastic mesh, plus a few modal coordinates for its small deformations with respect to the body frame.
+/// The mesh (of ChNodeFEAxyz and ChNodeFEAxyzrot nodes, ex. a mesh of ChElementTetra_4, ChElementBeamEuler or
+/// shell elements) is given in the auxiliary reference frame of the body (see ChBodyAuxRef); its mass, center
+/// of mass and inertia become the ones of the body.
+/// - If some nodes of the mesh are fixed, they are rigidly attached to the body frame and the deformations
+///   are the vibration modes of the mesh clamped at these nodes (the usual choice when the body is attached
+///   to other parts by joints at these nodes).
+/// - Otherwise the deformations are the lowest free-free vibration modes of the mesh.
+///
+/// The inertia coupling between the rigid motion and the modal coordinates is given by invariants that are
+/// computed once, in the undeformed configuration, so the cost of the body does not depend on the size of the
+/// mesh: the elastic forces are a diagonal modal stiffness and damping. The Coriolis and centrifugal effects
+/// of the body rotation on the modes are included, while the effect of the deformation on the inertia of the
+/// body and the geometric stiffening are neglected (small deformations).
+/// The mesh must not be added to the system; the displacements of its nodes are recovered on demand (see
+/// UpdateMeshNodes), ex. for output and visualization. The forces applied to the nodes of the mesh (see
+/// ChNodeFEAxyz::SetForce and ChNodeFEAxyzrot::SetTorque) act on the body and on the modes.
+/// Links, loads and contacts act on the rigid body, as for a ChBodyAuxRef.
+class ChApiFea ChModalBody : public ChBodyAuxRef {
+  public:
+    ChModalBody(ChMaterialSurface::ContactMethod contact_method = ChMaterialSurface::NSC);
+    ChModalBody(const ChModalBody& other);
+    virtual ~ChModalBody();
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChModalBody* Clone() const override { return new ChModalBody(*this); }
+
+    /// Build the reduced model of the mesh, with the given number of vibration modes, and set the mass, the
+    /// center of mass and the inertia of the body. The nodes must be in their reference configuration (X0),
+    /// expressed in the auxiliary reference frame of the body. This must be done before adding the body to
+    /// the system. The modal damping is the one of the elements (ex. the Rayleigh damping of their material),
+    /// see also SetModalDamping.
+    /// Throws a ChException if the mesh cannot be reduced.
+    void Reduce(std::shared_ptr<ChMesh> mesh, int num_modes);
+
+    /// Get the reduced mesh.
+    std::shared_ptr<ChMesh> GetMesh() const { return mesh; }
+
+    /// Get the number of vibration modes.
+    int GetNmodes() const { return n_modes; }
+
+    /// Get the eigenvalues (squared angular frequencies) of the vibration modes.
+    const ChVectorDynamic<>& GetModeEigenvalues() const { return eigenvalues; }
+
+    /// Get the modal coordinates (amplitudes of the vibration modes, with unit modal masses).
+    const ChVectorDynamic<>& GetModalCoordinates() const { return q; }
+
+    /// Get the time derivatives of the modal coordinates.
+    const ChVectorDynamic<>& GetModalSpeeds() const { return q_dt; }
+
+    /// Set the modal coordinates and their time derivatives.
+    void SetModalCoordinates(const ChVectorDynamic<>& mq, const ChVectorDynamic<>& mq_dt);
+
+    /// Set the same damping ratio (fraction of the critical damping) for all modes.
+    void SetModalDamping(double zeta);
+
+    /// Get the modal damping coefficients, c = 2*zeta*omega for each mode.
+    const ChVectorDynamic<>& GetModalDamping() const { return damping; }
+
+    /// Set the positions and speeds of the nodes of the mesh from the current state of the body
+    /// (for output and visualization of the mesh).
+    void UpdateMeshNodes();
+
+    //
+    // STATE FUNCTIONS
+    //
+
+    /// Number of coordinates: the ones of the rigid body, plus the modal coordinates.
+    virtual int GetDOF() override { return 7 + n_modes; }
+    /// Number of speed coordinates: the ones of the rigid body, plus the modal speeds.
+    virtual int GetDOF_w() override { return 6 + n_modes; }
+
+    // (override/implement interfaces for global state vectors, see ChPhysicsItem for comments.)
+    virtual void IntStateGather(const unsigned int off_x,
+                                ChState& x,
+                                const unsigned int off_v,
+                                ChStateDelta& v,
+                                double& T) override;
+    virtual void IntStateScatter(const unsigned int off_x,
+                                 const ChState& x,
+                                 const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const double T) override;
+    virtual void IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) override;
+    virtual void IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) override;
+    virtual void IntStateIncrement(const unsigned int off_x,
+                                   ChState& x_new,
+                                   const ChState& x,
+                                   const unsigned int off_v,
+                                   const ChStateDelta& Dv) override;
+    virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
+    virtual void IntLoadResidual_Mv(const unsigned int off,
+                                    ChVectorDynamic<>& R,
+                                    const ChVectorDynamic<>& w,
+                                    const double c) override;
+    virtual bool IntLoadLumpedMass_Md(const unsigned int off,
+                                      ChVectorDynamic<>& Md,
+                                      const double c,
+                                      bool hrz) override;
+    virtual void IntToDescriptor(const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const ChVectorDynamic<>& R,
+                                 const unsigned int off_L,
+                                 const ChVectorDynamic<>& L,
+                                 const ChVectorDynamic<>& Qc) override;
+    virtual void IntFromDescriptor(const unsigned int off_v,
+                                   ChStateDelta& v,
+                                   const unsigned int off_L,
+                                   ChVectorDynamic<>& L) override;
+
+    //
+    // SOLVER FUNCTIONS
+    //
+
+    virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
+    virtual void InjectKRMmatrices(ChSystemDescriptor& mdescriptor) override;
+    virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
+
+    virtual void VariablesFbReset() override;
+    virtual void VariablesFbLoadForces(double factor = 1) override;
+    virtual void VariablesQbLoadSpeed() override;
+    virtual void VariablesFbIncrementMq() override;
+    virtual void VariablesQbSetSpeed(double step = 0) override;
+    virtual void VariablesQbIncrementPosition(double step) override;
+
+    /// Set no speed and no accelerations, also for the modal coordinates (but do not change the position).
+    virtual void SetNoSpeedNoAcceleration() override;
+
+  private:
+    /// Set the variables of the block of the inertia coupling, modal stiffness and damping.
+    void SetupKRMblock();
+
+    /// Compute the forces that are not included in ChBody: on the body translation (absolute), on the body
+    /// rotation (in the COG frame) and on the modal coordinates.
+    void ComputeModalForces(ChVector<>& F, ChVector<>& T, ChVectorDynamic<>& Fq);
+
+    /// Compute the inertia coupling terms of M*w, for the body translation (absolute), the body rotation
+    /// (in the COG frame) and the modal coordinates, given the speeds w_v, w_w and w_q.
+    void ComputeCouplingMv(const ChVector<>& w_v,
+                           const ChVector<>& w_w,
+                           const ChVectorDynamic<>& w_q,
+                           ChVector<>& Mw_v,
+                           ChVector<>& Mw_w,
+                           ChVectorDynamic<>& Mw_q);
+
+    std::shared_ptr<ChMesh> mesh;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> xyz_nodes;        ///< nodes with translations
+    std::vector<std::shared_ptr<ChNodeFEAxyzrot>> xyzrot_nodes;  ///< nodes with translations and rotations
+    std::vector<int> xyz_offset;                                 ///< rows of the nodes in Phi
+    std::vector<int> xyzrot_offset;                              ///< rows of the nodes in Phi
+    int n_modes;
+
+    ChMatrixDynamic<> Phi;    ///< modes (translations in the reference frame, rotations in the node frames)
+    ChMatrixDynamic<> Ct;     ///< inertia coupling of the modes and the body translation
+    ChMatrixDynamic<> Cr;     ///< inertia coupling of the modes and the body rotation
+    ChMatrixDynamic<> Gq[3];  ///< Coriolis coupling of the modes, per unit angular velocity about x, y, z
+    ChMatrixDynamic<> Gt[3];  ///< Coriolis forces on the body translation, per unit angular velocity
+    ChMatrixDynamic<> Gr[3];  ///< Coriolis torques on the body rotation, per unit angular velocity
+    ChMatrixDynamic<> P;      ///< centrifugal forces on the modes, per product of angular velocities w_a*w_b
+    ChVectorDynamic<> eigenvalues;
+    ChVectorDynamic<> damping;
+
+    ChVectorDynamic<> q;       ///< modal coordinates
+    ChVectorDynamic<> q_dt;    ///< modal speeds
+    ChVectorDynamic<> q_dtdt;  ///< modal accelerations
+    ChVariablesGenericDiagonalMass* modal_variables;
+    ChKblockGeneric KRM_block;
+};
+
+/// @} fea_module
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/collision/ChCModelBullet.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChSystem.h"
 #include "chrono_fea/ChMatterMeshless.h"
@@ -27,7 +28,7 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChProximityContainerMeshless)
 
-ChProximityContainerMeshless::ChProximityContainerMeshless() : n_added(0) {
+ChProximityContainerMeshless::ChProximityContainerMeshless() : n_added(0), use_cell_list(false) {
     lastproximity = proximitylist.begin();
 }
 
@@ -36,6 +37,7 @@ ChProximityContainerMeshless::ChProximityContainerMeshless(const ChProximityCont
     n_added = other.n_added;
     proximitylist = other.proximitylist;
     lastproximity = proximitylist.begin();
+    use_cell_list = other.use_cell_list;
 }
 
 ChProximityContainerMeshless::~ChProximityContainerMeshless() {
@@ -80,6 +82,10 @@ void ChProximityContainerMeshless::EndAddProximities() {
 }
 
 void ChProximityContainerMeshless::AddProximity(collision::ChCollisionModel* modA, collision::ChCollisionModel* modB) {
+    // The neighbors are found by the cell list
+    if (use_cell_list)
+        return;
+
     // Fetch the frames of that proximity and other infos
 
     ChNodeMeshless* mnA = dynamic_cast<ChNodeMeshless*>(modA->GetContactable());
@@ -112,6 +118,20 @@ void ChProximityContainerMeshless::AddProximity(collision::ChCollisionModel* mod
 }
 
 void ChProximityContainerMeshless::ReportAllProximities(ReportProximityCallback* mcallback) {
+    if (use_cell_list) {
+        const std::vector<int>& start = cell_list.GetNeighborStart();
+        const std::vector<int>& neighbors = cell_list.GetNeighbors();
+        for (int i = 0; i < cell_list.GetNumPoints(); i++) {
+            for (int k = start[i]; k < start[i + 1]; k++) {
+                int j = neighbors[k];
+                if (j > i && !mcallback->OnReportProximity(cell_nodes[i]->collision_model,
+                                                           cell_nodes[j]->collision_model))
+                    return;
+            }
+        }
+        return;
+    }
+
     std::list<ChProximityMeshless*>::iterator iterproximity = proximitylist.begin();
     while (iterproximity != proximitylist.end()) {
         bool proceed = mcallback->OnReportProximity((*iterproximity)->GetModelA(), (*iterproximity)->GetModelB());
@@ -125,19 +145,28 @@ void ChProximityContainerMeshless::ReportAllProximities(ReportProximityCallback*
 
 static double W_sph(double r, double h) {
     if (r < h) {
-        return (315.0 / (64.0 * CH_C_PI * pow(h, 9))) * pow((h * h - r * r), 3);
+        double h3 = h * h * h;
+        double d = h * h - r * r;
+        return (315.0 / (64.0 * CH_C_PI * h3 * h3 * h3)) * d * d * d;
     } else
         return 0;
 }
 
 static double W_sq_visco(double r, double h) {
     if (r < h) {
-        return (45.0 / (CH_C_PI * pow(h, 6))) * (h - r);
+        double h3 = h * h * h;
+        return (45.0 / (CH_C_PI * h3 * h3)) * (h - r);
     } else
         return 0;
 }
 
 void ChProximityContainerMeshless::AccumulateStep1() {
+    if (use_cell_list) {
+        UpdateCellList();
+        AccumulateStep1CellList();
+        return;
+    }
+
     // Per-edge data computation
     std::list<ChProximityMeshless*>::iterator iterproximity = proximitylist.begin();
     while (iterproximity != proximitylist.end()) {
@@ -200,6 +229,11 @@ void ChProximityContainerMeshless::AccumulateStep1() {
 }
 
 void ChProximityContainerMeshless::AccumulateStep2() {
+    if (use_cell_list) {
+        AccumulateStep2CellList();
+        return;
+    }
+
     // Per-edge data computation (transfer stress to forces)
     std::list<ChProximityMeshless*>::iterator iterproximity = proximitylist.begin();
     while (iterproximity != proximitylist.end()) {
@@ -248,6 +282,91 @@ void ChProximityContainerMeshless::AccumulateStep2() {
     }
 }
 
+void ChProximityContainerMeshless::UpdateCellList() {
+    // Collect the nodes of all the meshless matter items
+    cell_nodes.clear();
+    for (auto otherphysics : GetSystem()->Get_otherphysicslist()) {
+        if (auto matter = std::dynamic_pointer_cast<ChMatterMeshless>(otherphysics)) {
+            for (unsigned int j = 0; j < matter->GetNnodes(); j++)
+                cell_nodes.push_back(dynamic_cast<ChNodeMeshless*>(matter->GetNode(j).get()));
+        }
+    }
+
+    std::vector<ChVector<> > positions(cell_nodes.size());
+    double cutoff = 0;
+    for (size_t i = 0; i < cell_nodes.size(); i++) {
+        positions[i] = cell_nodes[i]->GetPos();
+        cutoff = ChMax(cutoff, cell_nodes[i]->GetKernelRadius());
+    }
+
+    cell_list.Build(positions, cutoff);
+}
+
+// With the cell list, the neighbor lists are symmetric: each node A sums the contributions of all its
+// neighbors B into itself (so the nodes can be processed in parallel), and each pair is visited twice.
+// The terms are the same as those of the A and B nodes in the per-edge loops above.
+
+void ChProximityContainerMeshless::AccumulateStep1CellList() {
+    const std::vector<int>& start = cell_list.GetNeighborStart();
+    const std::vector<int>& neighbors = cell_list.GetNeighbors();
+
+    ChParallelFor(0, cell_list.GetNumPoints(), 0, [&](int i) {
+        ChNodeMeshless* mnodeA = cell_nodes[i];
+        ChVector<> u_A = mnodeA->GetPos() - mnodeA->GetPosReference();
+        for (int k = start[i]; k < start[i + 1]; k++) {
+            ChNodeMeshless* mnodeB = cell_nodes[neighbors[k]];
+
+            ChVector<> d_BA = mnodeB->GetPosReference() - mnodeA->GetPosReference();
+            ChVector<> g_BA = (mnodeB->GetPos() - mnodeB->GetPosReference()) - u_A;
+            double W_BA = W_sph(d_BA.Length(), mnodeA->GetKernelRadius());
+
+            mnodeA->density += mnodeB->GetMass() * W_BA;
+
+            // increment the moment matrix: Aa += d_BA*d_BA'*W_BA
+            for (int r = 0; r < 3; r++)
+                for (int c = 0; c < 3; c++)
+                    mnodeA->Amoment(r, c) += d_BA[r] * d_BA[c] * W_BA;
+
+            // increment the J matrix
+            ChVector<> m_inc_BA = d_BA * W_BA;
+            mnodeA->J.PasteSumVector(m_inc_BA * g_BA.x(), 0, 0);
+            mnodeA->J.PasteSumVector(m_inc_BA * g_BA.y(), 0, 1);
+            mnodeA->J.PasteSumVector(m_inc_BA * g_BA.z(), 0, 2);
+        }
+    });
+}
+
+void ChProximityContainerMeshless::AccumulateStep2CellList() {
+    const std::vector<int>& start = cell_list.GetNeighborStart();
+    const std::vector<int>& neighbors = cell_list.GetNeighbors();
+
+    ChParallelFor(0, cell_list.GetNumPoints(), 0, [&](int i) {
+        ChNodeMeshless* mnodeA = cell_nodes[i];
+        ChVector<> force = VNULL;
+        for (int k = start[i]; k < start[i + 1]; k++) {
+            ChNodeMeshless* mnodeB = cell_nodes[neighbors[k]];
+
+            ChVector<> d_BA = mnodeB->GetPosReference() - mnodeA->GetPosReference();
+            double dist_BA = d_BA.Length();
+            double W_BA = W_sph(dist_BA, mnodeA->GetKernelRadius());
+            double W_AB = W_sph(dist_BA, mnodeB->GetKernelRadius());
+
+            // elastoplastic forces
+            force += mnodeA->FA * (d_BA * W_BA);
+            force += mnodeB->FA * (d_BA * W_AB);
+
+            // viscous forces
+            double r_length = (mnodeB->GetPos() - mnodeA->GetPos()).Length();
+            double W_visc = W_sq_visco(r_length, 0.5 * (mnodeA->GetKernelRadius() + mnodeB->GetKernelRadius()));
+            ChVector<> velBA = mnodeB->GetPos_dt() - mnodeA->GetPos_dt();
+            double avg_viscosity =
+                0.5 * (mnodeA->GetMatterContainer()->GetViscosity() + mnodeB->GetMatterContainer()->GetViscosity());
+            force += velBA * (mnodeA->volume * avg_viscosity * mnodeB->volume * W_visc);
+        }
+        mnodeA->UserForce += force;
+    });
+}
+
 void ChProximityContainerMeshless::ArchiveOUT(ChArchiveOut& marchive) {
     // version number
     marchive.VersionWrite<ChProximityContainerMeshless>();
@@ -16,12 +16,18 @@
 #define CHPROXIMITYCONTAINERMESHLESS_H
 
 #include <list>
+#include <vector>
 
+#include "chrono/collision/ChCCellList.h"
 #include "chrono/collision/ChCModelBullet.h"
 #include "chrono/physics/ChProximityContainer.h"
 
 namespace chrono {
 
+namespace fea {
+class ChNodeMeshless;
+}
+
 /// Class for a proximity pair information in a meshless deformable continumm,
 /// made with a cluster of particles - that is, an 'edge' topological connectivity in
 /// in a meshless FEA approach, similar to the Smoothed Particle Hydrodynamics.
@@ -62,6 +68,9 @@ class ChApiFea ChProximityMeshless {
 /// as CPU typical linked list of ChProximityMeshless objects.
 /// Such an item must be addd to the physical system if you added
 /// an object of class ChMatterMeshless.
+/// Optionally (see SetUseCellList), the pairs are found by a cell list
+/// neighbor search over the nodes of all the ChMatterMeshless items of the
+/// system, instead of by the collision system.
 
 class ChApiFea ChProximityContainerMeshless : public ChProximityContainer {
 
@@ -70,6 +79,10 @@ class ChApiFea ChProximityContainerMeshless : public ChProximityContainer {
     std::list<ChProximityMeshless*>::iterator lastproximity;
     int n_added;
 
+    bool use_cell_list;
+    collision::ChCellList cell_list;
+    std::vector<fea::ChNodeMeshless*> cell_nodes;
+
   public:
     ChProximityContainerMeshless();
     ChProximityContainerMeshless(const ChProximityContainerMeshless& other);
@@ -78,8 +91,22 @@ class ChApiFea ChProximityContainerMeshless : public ChProximityContainer {
     /// "Virtual" copy constructor (covariant return type).
     virtual ChProximityContainerMeshless* Clone() const override { return new ChProximityContainerMeshless(*this); }
 
+    /// Enable the neighbor search with a cell list (uniform grid), in place of the
+    /// proximity pairs from the collision system. The neighbors (nodes closer than the kernel
+    /// radius, in the current configuration) are searched among the nodes of all the ChMatterMeshless
+    /// items in the system at each call of AccumulateStep1(), they are stored in flat arrays, and the
+    /// sums over the neighbors are evaluated in parallel over the nodes.
+    /// The pairs reported by the collision system are then ignored: the collision models of the
+    /// nodes are needed only for contacts with other objects (otherwise, use ChMatterMeshless::SetCollide(false)).
+    /// For nodes with different kernel radii, the viscous forces use the average of the two radii.
+    void SetUseCellList(bool mc) { use_cell_list = mc; }
+    bool GetUseCellList() const { return use_cell_list; }
+
+    /// Access the cell list, with the neighbors found at the last call of AccumulateStep1().
+    const collision::ChCellList& GetCellList() const { return cell_list; }
+
     /// Tell the number of added contacts
-    virtual int GetNproximities() const override { return n_added; }
+    virtual int GetNproximities() const override { return use_cell_list ? cell_list.GetNumPairs() : n_added; }
 
     /// Remove (delete) all contained contact data.
     virtual void RemoveAllProximities() override;
@@ -114,6 +141,13 @@ class ChApiFea ChProximityContainerMeshless : public ChProximityContainer {
     // Will be called by the ChMatterMeshless item.
     void AccumulateStep2();
 
+  private:
+    void UpdateCellList();
+    void AccumulateStep1CellList();
+    void AccumulateStep2CellList();
+
+  public:
+
     //
     // SERIALIZATION
     //
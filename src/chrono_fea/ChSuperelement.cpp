@@ -0,0 +1,557 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "chrono/core/ChException.h"
+#include "chrono/physics/ChSystem.h"
+#include "chrono_fea/ChModalAnalysis.h"
+#include "chrono_fea/ChSuperelement.h"
+
+namespace chrono {
+namespace fea {
+
+ChSuperelement::ChSuperelement() : n_modes(0), modal_variables(NULL), automatic_gravity_load(true) {}
+
+ChSuperelement::ChSuperelement(const ChSuperelement& other) : ChPhysicsItem(other) {
+    mesh = other.mesh;
+    boundary_nodes = other.boundary_nodes;
+    internal_nodes = other.internal_nodes;
+    n_modes = other.n_modes;
+    Kr = other.Kr;
+    Rr = other.Rr;
+    Mr = other.Mr;
+    Gr = other.Gr;
+    V = other.V;
+    eigenvalues = other.eigenvalues;
+    q = other.q;
+    q_dt = other.q_dt;
+    q_dtdt = other.q_dtdt;
+    automatic_gravity_load = other.automatic_gravity_load;
+
+    modal_variables = NULL;
+    if (other.modal_variables) {
+        modal_variables = new ChVariablesGenericDiagonalMass(n_modes);
+        *modal_variables = *other.modal_variables;
+    }
+    if (Kr.GetRows())
+        SetupKRMblock();
+}
+
+ChSuperelement::~ChSuperelement() {
+    delete modal_variables;
+}
+
+void ChSuperelement::Reduce(std::shared_ptr<ChMesh> mmesh,
+                            const std::vector<std::shared_ptr<ChNodeFEAxyz>>& mboundary_nodes,
+                            int num_modes) {
+    mesh = mmesh;
+    boundary_nodes = mboundary_nodes;
+    internal_nodes.clear();
+
+    for (unsigned int ie = 0; ie < mesh->GetNelements(); ie++)
+        mesh->GetElement(ie)->SetupInitial(mesh->GetSystem());
+
+    // Index of the nodes: first the boundary nodes, then the internal nodes (the fixed nodes are not indexed)
+    int nb = (int)boundary_nodes.size();
+    std::unordered_map<ChNodeFEAbase*, int> node_index;
+    for (int k = 0; k < nb; k++) {
+        if (boundary_nodes[k]->GetFixed())
+            throw ChException("ChSuperelement: the boundary nodes cannot be fixed.");
+        node_index[boundary_nodes[k].get()] = k;
+    }
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> free_nodes;
+    for (unsigned int j = 0; j < mesh->GetNnodes(); j++) {
+        auto node = std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(j));
+        if (!node)
+            throw ChException("ChSuperelement: only meshes of ChNodeFEAxyz nodes can be reduced.");
+        if (node->GetFixed() || node_index.count(node.get()))
+            continue;
+        node_index[node.get()] = nb + (int)free_nodes.size();
+        free_nodes.push_back(node);
+    }
+    int ni = (int)free_nodes.size();
+
+    // Nodes of the elements (-1 for the fixed nodes), and adjacency of the internal nodes
+    int ne = (int)mesh->GetNelements();
+    std::vector<std::vector<int>> element_nodes(ne);
+    std::vector<std::vector<int>> adjacency(ni);
+    for (int ie = 0; ie < ne; ie++) {
+        auto element = mesh->GetElement(ie);
+        for (int n = 0; n < element->GetNnodes(); n++) {
+            auto node = std::dynamic_pointer_cast<ChNodeFEAxyz>(element->GetNodeN(n));
+            if (!node || element->GetNodeNdofs(n) != 3)
+                throw ChException("ChSuperelement: only meshes of ChNodeFEAxyz nodes can be reduced.");
+            auto it = node_index.find(node.get());
+            if (it == node_index.end() && !node->GetFixed())
+                throw ChException("ChSuperelement: the nodes of the elements must be in the mesh.");
+            element_nodes[ie].push_back(it == node_index.end() ? -1 : it->second);
+        }
+        for (int a : element_nodes[ie])
+            for (int b : element_nodes[ie])
+                if (a >= nb && b >= nb && a != b)
+                    adjacency[a - nb].push_back(b - nb);
+    }
+    for (auto& list : adjacency) {
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+    }
+
+    // Number the internal nodes so that the envelope of their matrices is small
+    std::vector<int> order;
+    ChEnvelopeMatrix::ReverseCuthillMcKee(adjacency, order);
+    std::vector<int> position(ni);
+    for (int k = 0; k < ni; k++) {
+        position[order[k]] = k;
+        internal_nodes.push_back(free_nodes[order[k]]);
+    }
+    std::vector<int> first_node(ni);
+    for (int k = 0; k < ni; k++)
+        first_node[k] = k;
+    for (auto& nodes : element_nodes) {
+        int min_node = ni;
+        for (int& a : nodes) {
+            if (a >= nb) {
+                a = nb + position[a - nb];
+                min_node = std::min(min_node, a - nb);
+            }
+        }
+        for (int a : nodes)
+            if (a >= nb)
+                first_node[a - nb] = std::min(first_node[a - nb], min_node);
+    }
+    std::vector<int> first_col(3 * ni);
+    for (int k = 0; k < 3 * ni; k++)
+        first_col[k] = 3 * first_node[k / 3];
+
+    // Assemble the stiffness, damping and mass matrices in blocks of internal (i) and boundary (b) coordinates
+    int nbc = 3 * nb;
+    int nic = 3 * ni;
+    ChEnvelopeMatrix A_ii[3];
+    ChMatrixDynamic<> A_ib[3];
+    ChMatrixDynamic<> A_bb[3];
+    for (int a = 0; a < 3; a++) {
+        A_ii[a].Reset(first_col);
+        A_ib[a].Reset(nic, nbc);
+        A_bb[a].Reset(nbc, nbc);
+    }
+    for (int ie = 0; ie < ne; ie++) {
+        auto element = mesh->GetElement(ie);
+        const std::vector<int>& nodes = element_nodes[ie];
+        int nn = (int)nodes.size();
+        ChMatrixDynamic<> H(3 * nn, 3 * nn);
+        for (int a = 0; a < 3; a++) {
+            H.FillElem(0);
+            element->ComputeKRMmatricesGlobal(H, a == 0 ? 1.0 : 0.0, a == 1 ? 1.0 : 0.0, a == 2 ? 1.0 : 0.0);
+            for (int r = 0; r < nn; r++) {
+                for (int c = 0; c < nn; c++) {
+                    int ir = nodes[r];
+                    int ic = nodes[c];
+                    if (ir < 0 || ic < 0)
+                        continue;
+                    for (int i = 0; i < 3; i++) {
+                        for (int j = 0; j < 3; j++) {
+                            double val = H(3 * r + i, 3 * c + j);
+                            if (ir >= nb && ic >= nb) {
+                                int row = 3 * (ir - nb) + i;
+                                int col = 3 * (ic - nb) + j;
+                                if (row >= col)
+                                    A_ii[a].Add(row, col, val);
+                            } else if (ir >= nb) {
+                                A_ib[a](3 * (ir - nb) + i, 3 * ic + j) += val;
+                            } else if (ic < nb) {
+                                A_bb[a](3 * ir + i, 3 * ic + j) += val;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    if (num_modes < 0 || num_modes > nic)
+        throw ChException("ChSuperelement: the number of modes exceeds the number of internal coordinates.");
+    n_modes = num_modes;
+    int nr = nbc + n_modes;
+    if (nr == 0)
+        throw ChException("ChSuperelement: no boundary nodes and no modes.");
+
+    // Displacements of the internal nodes per unit reduced coordinate: static response to the displacements of
+    // the boundary nodes, -inv(K_ii)*K_ib, then the vibration modes with fixed boundary nodes
+    V.Reset(nic, nr);
+    eigenvalues.Reset(n_modes);
+    if (ni > 0) {
+        ChEnvelopeMatrix K_ii_factorized(A_ii[0]);
+        if (!K_ii_factorized.Factorize())
+            throw ChException(
+                "ChSuperelement: the stiffness matrix of the internal nodes is not positive definite (the boundary "
+                "and fixed nodes must restrain the rigid motions of the mesh).");
+
+        ChMatrixDynamic<> Psi(A_ib[0]);
+        K_ii_factorized.Solve(Psi);
+        for (int i = 0; i < nic; i++)
+            for (int j = 0; j < nbc; j++)
+                V(i, j) = -Psi(i, j);
+
+        ChMatrixDynamic<> Phi;
+        if (!ChModalAnalysis::ComputeModes(K_ii_factorized, A_ii[2], n_modes, eigenvalues, Phi))
+            throw ChException("ChSuperelement: the computation of the vibration modes did not converge.");
+        for (int i = 0; i < nic; i++)
+            for (int j = 0; j < n_modes; j++)
+                V(i, nbc + j) = Phi(i, j);
+    }
+
+    // Reduced matrices: Ar = T'*A*T, with T = [I 0; V] the displacements of all nodes per unit reduced coordinate
+    ChMatrixDynamic<>* Ar[3] = {&Kr, &Rr, &Mr};
+    for (int a = 0; a < 3; a++) {
+        ChMatrixDynamic<>& R = *Ar[a];
+        R.Reset(nr, nr);
+        for (int i = 0; i < nbc; i++)
+            for (int j = 0; j < nbc; j++)
+                R(i, j) = A_bb[a](i, j);
+        if (ni > 0) {
+            ChMatrixDynamic<> W(nic, nr);
+            A_ii[a].MultiplyAndAdd(W, V);
+            ChMatrixDynamic<> VtW(nr, nr);
+            VtW.MatrTMultiply(V, W);
+            ChMatrixDynamic<> C(nbc, nr);
+            if (nbc > 0)
+                C.MatrTMultiply(A_ib[a], V);
+            for (int i = 0; i < nr; i++) {
+                for (int j = 0; j < nr; j++) {
+                    R(i, j) += VtW(i, j);
+                    if (i < nbc)
+                        R(i, j) += C(i, j);
+                    if (j < nbc)
+                        R(i, j) += C(j, i);
+                }
+            }
+        }
+        for (int i = 0; i < nr; i++)  // remove the roundoff asymmetry
+            for (int j = 0; j < i; j++)
+                R(i, j) = R(j, i) = 0.5 * (R(i, j) + R(j, i));
+    }
+
+    // Reduced forces of unit accelerations along x, y, z: Gr = T'*M*U, with U the rigid translations
+    ChMatrixDynamic<> U_i(nic, 3);
+    for (int i = 0; i < nic; i++)
+        U_i(i, i % 3) = 1;
+    ChMatrixDynamic<> Y_i(nic, 3);
+    A_ii[2].MultiplyAndAdd(Y_i, U_i);
+    Gr.Reset(nr, 3);
+    for (int i = 0; i < nbc; i++) {
+        for (int j = 0; j < nbc; j++)
+            Gr(i, j % 3) += A_bb[2](i, j);
+        for (int j = 0; j < nic; j++) {
+            Gr(i, j % 3) += A_ib[2](j, i);
+            Y_i(j, i % 3) += A_ib[2](j, i);
+        }
+    }
+    if (ni > 0) {
+        ChMatrixDynamic<> VtY(nr, 3);
+        VtY.MatrTMultiply(V, Y_i);
+        Gr.MatrInc(VtY);
+    }
+
+    // Modal coordinates, with their variables (their mass is in the block of the reduced matrices)
+    q.Reset(n_modes);
+    q_dt.Reset(n_modes);
+    q_dtdt.Reset(n_modes);
+    delete modal_variables;
+    modal_variables = NULL;
+    if (n_modes > 0) {
+        modal_variables = new ChVariablesGenericDiagonalMass(n_modes);
+        modal_variables->GetMassDiagonal().FillElem(0);
+    }
+    SetupKRMblock();
+}
+
+void ChSuperelement::SetupKRMblock() {
+    std::vector<ChVariables*> variables;
+    for (auto& node : boundary_nodes)
+        variables.push_back(&node->Variables());
+    if (modal_variables)
+        variables.push_back(modal_variables);
+    KRM_block.SetVariables(variables);
+}
+
+void ChSuperelement::GetReducedState(ChVectorDynamic<>& u, ChVectorDynamic<>& u_dt) {
+    int nb = (int)boundary_nodes.size();
+    u.Reset(3 * nb + n_modes);
+    u_dt.Reset(3 * nb + n_modes);
+    for (int k = 0; k < nb; k++) {
+        u.PasteVector(boundary_nodes[k]->GetPos() - boundary_nodes[k]->GetX0(), 3 * k, 0);
+        u_dt.PasteVector(boundary_nodes[k]->GetPos_dt(), 3 * k, 0);
+    }
+    for (int i = 0; i < n_modes; i++) {
+        u(3 * nb + i) = q(i);
+        u_dt(3 * nb + i) = q_dt(i);
+    }
+}
+
+void ChSuperelement::ComputeReducedForces(ChVectorDynamic<>& F) {
+    int nr = GetDOF();
+    ChVectorDynamic<> u;
+    ChVectorDynamic<> u_dt;
+    GetReducedState(u, u_dt);
+
+    // Elastic and damping forces
+    F.Reset(nr);
+    for (int i = 0; i < nr; i++)
+        for (int j = 0; j < nr; j++)
+            F(i) -= Kr(i, j) * u(j) + Rr(i, j) * u_dt(j);
+
+    // Gravity
+    if (automatic_gravity_load && GetSystem()) {
+        ChVector<> g = GetSystem()->Get_G_acc();
+        for (int i = 0; i < nr; i++)
+            F(i) += Gr(i, 0) * g.x() + Gr(i, 1) * g.y() + Gr(i, 2) * g.z();
+    }
+
+    // Forces applied to the internal nodes
+    for (size_t k = 0; k < internal_nodes.size(); k++) {
+        ChVector<> f = internal_nodes[k]->GetForce();
+        if (f.IsNull())
+            continue;
+        for (int j = 0; j < nr; j++)
+            F(j) += V(3 * k, j) * f.x() + V(3 * k + 1, j) * f.y() + V(3 * k + 2, j) * f.z();
+    }
+}
+
+void ChSuperelement::UpdateMeshNodes() {
+    int nr = GetDOF();
+    ChVectorDynamic<> u;
+    ChVectorDynamic<> u_dt;
+    GetReducedState(u, u_dt);
+    for (size_t k = 0; k < internal_nodes.size(); k++) {
+        ChVector<> disp(0);
+        ChVector<> disp_dt(0);
+        for (int j = 0; j < nr; j++) {
+            disp += ChVector<>(V(3 * k, j), V(3 * k + 1, j), V(3 * k + 2, j)) * u(j);
+            disp_dt += ChVector<>(V(3 * k, j), V(3 * k + 1, j), V(3 * k + 2, j)) * u_dt(j);
+        }
+        internal_nodes[k]->SetPos(internal_nodes[k]->GetX0() + disp);
+        internal_nodes[k]->SetPos_dt(disp_dt);
+    }
+}
+
+//// STATE BOOKKEEPING FUNCTIONS
+
+void ChSuperelement::IntStateGather(const unsigned int off_x,
+                                    ChState& x,
+                                    const unsigned int off_v,
+                                    ChStateDelta& v,
+                                    double& T) {
+    unsigned int nbc = 3 * (unsigned int)boundary_nodes.size();
+    for (unsigned int k = 0; k < boundary_nodes.size(); k++)
+        boundary_nodes[k]->NodeIntStateGather(off_x + 3 * k, x, off_v + 3 * k, v, T);
+    for (int i = 0; i < n_modes; i++) {
+        x(off_x + nbc + i) = q(i);
+        v(off_v + nbc + i) = q_dt(i);
+    }
+    T = GetChTime();
+}
+
+void ChSuperelement::IntStateScatter(const unsigned int off_x,
+                                     const ChState& x,
+                                     const unsigned int off_v,
+                                     const ChStateDelta& v,
+                                     const double T) {
+    unsigned int nbc = 3 * (unsigned int)boundary_nodes.size();
+    for (unsigned int k = 0; k < boundary_nodes.size(); k++)
+        boundary_nodes[k]->NodeIntStateScatter(off_x + 3 * k, x, off_v + 3 * k, v, T);
+    for (int i = 0; i < n_modes; i++) {
+        q(i) = x(off_x + nbc + i);
+        q_dt(i) = v(off_v + nbc + i);
+    }
+    Update(T);
+}
+
+void ChSuperelement::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
+    unsigned int nbc = 3 * (unsigned int)boundary_nodes.size();
+    for (unsigned int k = 0; k < boundary_nodes.size(); k++)
+        boundary_nodes[k]->NodeIntStateGatherAcceleration(off_a + 3 * k, a);
+    for (int i = 0; i < n_modes; i++)
+        a(off_a + nbc + i) = q_dtdt(i);
+}
+
+void ChSuperelement::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
+    unsigned int nbc = 3 * (unsigned int)boundary_nodes.size();
+    for (unsigned int k = 0; k < boundary_nodes.size(); k++)
+        boundary_nodes[k]->NodeIntStateScatterAcceleration(off_a + 3 * k, a);
+    for (int i = 0; i < n_modes; i++)
+        q_dtdt(i) = a(off_a + nbc + i);
+}
+
+void ChSuperelement::IntStateIncrement(const unsigned int off_x,
+                                       ChState& x_new,
+                                       const ChState& x,
+                                       const unsigned int off_v,
+                                       const ChStateDelta& Dv) {
+    unsigned int nbc = 3 * (unsigned int)boundary_nodes.size();
+    for (unsigned int k = 0; k < boundary_nodes.size(); k++)
+        boundary_nodes[k]->NodeIntStateIncrement(off_x + 3 * k, x_new, x, off_v + 3 * k, Dv);
+    for (int i = 0; i < n_modes; i++)
+        x_new(off_x + nbc + i) = x(off_x + nbc + i) + Dv(off_v + nbc + i);
+}
+
+void ChSuperelement::IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) {
+    // applied nodal forces
+    for (unsigned int k = 0; k < boundary_nodes.size(); k++)
+        boundary_nodes[k]->NodeIntLoadResidual_F(off + 3 * k, R, c);
+
+    // forces on the reduced coordinates
+    ChVectorDynamic<> F;
+    ComputeReducedForces(F);
+    for (int i = 0; i < F.GetRows(); i++)
+        R(off + i) += c * F(i);
+}
+
+void ChSuperelement::IntLoadResidual_Mv(const unsigned int off,
+                                        ChVectorDynamic<>& R,
+                                        const ChVectorDynamic<>& w,
+                                        const double c) {
+    // masses of the nodes
+    for (unsigned int k = 0; k < boundary_nodes.size(); k++)
+        boundary_nodes[k]->NodeIntLoadResidual_Mv(off + 3 * k, R, w, c);
+
+    // reduced mass matrix
+    int nr = GetDOF();
+    for (int i = 0; i < nr; i++) {
+        double sum = 0;
+        for (int j = 0; j < nr; j++)
+            sum += Mr(i, j) * w(off + j);
+        R(off + i) += c * sum;
+    }
+}
+
+void ChSuperelement::IntToDescriptor(const unsigned int off_v,
+                                     const ChStateDelta& v,
+                                     const ChVectorDynamic<>& R,
+                                     const unsigned int off_L,
+                                     const ChVectorDynamic<>& L,
+                                     const ChVectorDynamic<>& Qc) {
+    unsigned int nbc = 3 * (unsigned int)boundary_nodes.size();
+    for (unsigned int k = 0; k < boundary_nodes.size(); k++)
+        boundary_nodes[k]->NodeIntToDescriptor(off_v + 3 * k, v, R);
+    if (modal_variables) {
+        modal_variables->Get_qb().PasteClippedMatrix(v, off_v + nbc, 0, n_modes, 1, 0, 0);
+        modal_variables->Get_fb().PasteClippedMatrix(R, off_v + nbc, 0, n_modes, 1, 0, 0);
+    }
+}
+
+void ChSuperelement::IntFromDescriptor(const unsigned int off_v,
+                                       ChStateDelta& v,
+                                       const unsigned int off_L,
+                                       ChVectorDynamic<>& L) {
+    unsigned int nbc = 3 * (unsigned int)boundary_nodes.size();
+    for (unsigned int k = 0; k < boundary_nodes.size(); k++)
+        boundary_nodes[k]->NodeIntFromDescriptor(off_v + 3 * k, v);
+    if (modal_variables)
+        v.PasteMatrix(modal_variables->Get_qb(), off_v + nbc, 0);
+}
+
+//// SOLVER FUNCTIONS
+
+void ChSuperelement::InjectVariables(ChSystemDescriptor& mdescriptor) {
+    for (auto& node : boundary_nodes)
+        node->InjectVariables(mdescriptor);
+    if (modal_variables)
+        mdescriptor.InsertVariables(modal_variables);
+}
+
+void ChSuperelement::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
+    mdescriptor.InsertKblock(&KRM_block);
+}
+
+void ChSuperelement::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
+    ChMatrix<>& H = *KRM_block.Get_K();
+    for (int i = 0; i < H.GetRows(); i++)
+        for (int j = 0; j < H.GetColumns(); j++)
+            H(i, j) = Kfactor * Kr(i, j) + Rfactor * Rr(i, j) + Mfactor * Mr(i, j);
+}
+
+void ChSuperelement::VariablesFbReset() {
+    for (auto& node : boundary_nodes)
+        node->VariablesFbReset();
+    if (modal_variables)
+        modal_variables->Get_fb().FillElem(0);
+}
+
+void ChSuperelement::VariablesFbLoadForces(double factor) {
+    // applied nodal forces
+    for (auto& node : boundary_nodes)
+        node->VariablesFbLoadForces(factor);
+
+    // forces on the reduced coordinates
+    ChVectorDynamic<> F;
+    ComputeReducedForces(F);
+    for (unsigned int k = 0; k < boundary_nodes.size(); k++)
+        for (int i = 0; i < 3; i++)
+            boundary_nodes[k]->Variables().Get_fb()(i) += factor * F(3 * k + i);
+    for (int i = 0; i < n_modes; i++)
+        modal_variables->Get_fb()(i) += factor * F(3 * boundary_nodes.size() + i);
+}
+
+void ChSuperelement::VariablesQbLoadSpeed() {
+    for (auto& node : boundary_nodes)
+        node->VariablesQbLoadSpeed();
+    if (modal_variables)
+        modal_variables->Get_qb().PasteMatrix(q_dt, 0, 0);
+}
+
+void ChSuperelement::VariablesFbIncrementMq() {
+    // masses of the nodes
+    for (auto& node : boundary_nodes)
+        node->VariablesFbIncrementMq();
+
+    // reduced mass matrix
+    int nb = (int)boundary_nodes.size();
+    int nr = GetDOF();
+    ChVectorDynamic<> qb(nr);
+    for (int k = 0; k < nb; k++)
+        for (int i = 0; i < 3; i++)
+            qb(3 * k + i) = boundary_nodes[k]->Variables().Get_qb()(i);
+    for (int i = 0; i < n_modes; i++)
+        qb(3 * nb + i) = modal_variables->Get_qb()(i);
+    for (int i = 0; i < nr; i++) {
+        double sum = 0;
+        for (int j = 0; j < nr; j++)
+            sum += Mr(i, j) * qb(j);
+        if (i < 3 * nb)
+            boundary_nodes[i / 3]->Variables().Get_fb()(i % 3) += sum;
+        else
+            modal_variables->Get_fb()(i - 3 * nb) += sum;
+    }
+}
+
+void ChSuperelement::VariablesQbSetSpeed(double step) {
+    for (auto& node : boundary_nodes)
+        node->VariablesQbSetSpeed(step);
+    for (int i = 0; i < n_modes; i++) {
+        double old_dt = q_dt(i);
+        q_dt(i) = modal_variables->Get_qb()(i);
+        if (step)
+            q_dtdt(i) = (q_dt(i) - old_dt) / step;
+    }
+}
+
+void ChSuperelement::VariablesQbIncrementPosition(double step) {
+    for (auto& node : boundary_nodes)
+        node->VariablesQbIncrementPosition(step);
+    for (int i = 0; i < n_modes; i++)
+        q(i) += modal_variables->Get_qb()(i) * step;
+}
+
+}  // end namespace fea
+}  // end namespace chrono
@@ -0,0 +1,185 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+
+#ifndef CHSUPERELEMENT_H
+#define CHSUPERELEMENT_H
+
+#include "chrono/physics/ChPhysicsItem.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/solver/ChVariablesGenericDiagonalMass.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChNodeFEAxyz.h"
+
+namespace chrono {
+namespace fea {
+
+/// @addtogroup fea_module
+/// @{
+
+/// Linear superelement: reduced order model of a linear elastic mesh (for example a mesh of ChElementTetra_4
+/// or ChElementHexa_8 elements, as loaded with ChMeshFileLoader), condensed to a few boundary nodes.
+/// The boundary nodes are the only nodes of the mesh in the system, so links, loads and contacts can be
+/// attached to them as usual.
+/// The reduction uses the Craig-Bampton method: the displacements of the internal nodes are the static
+/// response to the displacements of the boundary nodes (Guyan reduction) plus a combination of the lowest
+/// vibration modes of the mesh with fixed boundary nodes, whose amplitudes are additional (modal) coordinates.
+/// With no modes, this is the Guyan reduction (static condensation).
+/// The forces applied to the internal nodes (see ChNodeFEAxyz::SetForce) are transformed into forces on the
+/// reduced coordinates.
+/// The reduced mass, damping and stiffness matrices are small and dense. The damping matrix is the reduction of
+/// the damping of the elements (ex. the Rayleigh damping of their material).
+/// Only meshes of nodes with translational coordinates (ChNodeFEAxyz) are supported: the nodes of the mesh that
+/// are fixed stay fixed, and the boundary nodes must restrain the rigid motions of the mesh. The mesh must not
+/// be added to the system.
+class ChApiFea ChSuperelement : public ChPhysicsItem {
+  public:
+    ChSuperelement();
+    ChSuperelement(const ChSuperelement& other);
+    virtual ~ChSuperelement();
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChSuperelement* Clone() const override { return new ChSuperelement(*this); }
+
+    /// Build the reduced model of the mesh, with the given boundary nodes and number of internal vibration
+    /// modes (zero for the Guyan reduction). The reference positions (X0) of the nodes are the undeformed
+    /// configuration. This must be done before adding the superelement to the system.
+    /// Throws a ChException if the mesh cannot be reduced.
+    void Reduce(std::shared_ptr<ChMesh> mesh,
+                const std::vector<std::shared_ptr<ChNodeFEAxyz>>& boundary_nodes,
+                int num_modes = 0);
+
+    /// Get the reduced mesh.
+    std::shared_ptr<ChMesh> GetMesh() const { return mesh; }
+
+    /// Get the boundary nodes.
+    const std::vector<std::shared_ptr<ChNodeFEAxyz>>& GetBoundaryNodes() const { return boundary_nodes; }
+
+    /// Get the number of internal vibration modes.
+    int GetNmodes() const { return n_modes; }
+
+    /// Get the eigenvalues (squared angular frequencies) of the internal vibration modes.
+    const ChVectorDynamic<>& GetModeEigenvalues() const { return eigenvalues; }
+
+    /// Get the modal coordinates (amplitudes of the internal vibration modes).
+    const ChVectorDynamic<>& GetModalCoordinates() const { return q; }
+
+    /// Get the reduced stiffness matrix (boundary coordinates first, then modal coordinates).
+    const ChMatrixDynamic<>& GetReducedStiffness() const { return Kr; }
+
+    /// Get the reduced damping matrix (boundary coordinates first, then modal coordinates).
+    const ChMatrixDynamic<>& GetReducedDamping() const { return Rr; }
+
+    /// Get the reduced mass matrix (boundary coordinates first, then modal coordinates).
+    const ChMatrixDynamic<>& GetReducedMass() const { return Mr; }
+
+    /// Set the positions and speeds of the internal nodes of the mesh from the current state of the
+    /// superelement (for output and visualization of the mesh).
+    void UpdateMeshNodes();
+
+    /// Set the gravity loading on/off (default on).
+    void SetAutomaticGravity(bool mg) { automatic_gravity_load = mg; }
+    /// Tell if there is gravity loading.
+    bool GetAutomaticGravity() const { return automatic_gravity_load; }
+
+    //
+    // STATE FUNCTIONS
+    //
+
+    virtual int GetDOF() override { return 3 * (int)boundary_nodes.size() + n_modes; }
+
+    // (override/implement interfaces for global state vectors, see ChPhysicsItem for comments.)
+    virtual void IntStateGather(const unsigned int off_x,
+                                ChState& x,
+                                const unsigned int off_v,
+                                ChStateDelta& v,
+                                double& T) override;
+    virtual void IntStateScatter(const unsigned int off_x,
+                                 const ChState& x,
+                                 const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const double T) override;
+    virtual void IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) override;
+    virtual void IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) override;
+    virtual void IntStateIncrement(const unsigned int off_x,
+                                   ChState& x_new,
+                                   const ChState& x,
+                                   const unsigned int off_v,
+                                   const ChStateDelta& Dv) override;
+    virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
+    virtual void IntLoadResidual_Mv(const unsigned int off,
+                                    ChVectorDynamic<>& R,
+                                    const ChVectorDynamic<>& w,
+                                    const double c) override;
+    virtual void IntToDescriptor(const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const ChVectorDynamic<>& R,
+                                 const unsigned int off_L,
+                                 const ChVectorDynamic<>& L,
+                                 const ChVectorDynamic<>& Qc) override;
+    virtual void IntFromDescriptor(const unsigned int off_v,
+                                   ChStateDelta& v,
+                                   const unsigned int off_L,
+                                   ChVectorDynamic<>& L) override;
+
+    //
+    // SYSTEM FUNCTIONS
+    //
+
+    virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
+    virtual void InjectKRMmatrices(ChSystemDescriptor& mdescriptor) override;
+    virtual void KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) override;
+
+    virtual void VariablesFbReset() override;
+    virtual void VariablesFbLoadForces(double factor = 1) override;
+    virtual void VariablesQbLoadSpeed() override;
+    virtual void VariablesFbIncrementMq() override;
+    virtual void VariablesQbSetSpeed(double step = 0) override;
+    virtual void VariablesQbIncrementPosition(double step) override;
+
+  private:
+    /// Set the variables of the block of the reduced stiffness, damping and mass matrices.
+    void SetupKRMblock();
+
+    /// Gather the reduced coordinates (displacements of the boundary nodes, then modal coordinates)
+    /// and their time derivatives.
+    void GetReducedState(ChVectorDynamic<>& u, ChVectorDynamic<>& u_dt);
+
+    /// Compute the reduced forces (elastic, damping and gravity forces).
+    void ComputeReducedForces(ChVectorDynamic<>& F);
+
+    std::shared_ptr<ChMesh> mesh;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> boundary_nodes;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> internal_nodes;
+    int n_modes;
+
+    ChMatrixDynamic<> Kr;  ///< reduced stiffness matrix
+    ChMatrixDynamic<> Rr;  ///< reduced damping matrix
+    ChMatrixDynamic<> Mr;  ///< reduced mass matrix
+    ChMatrixDynamic<> Gr;  ///< reduced forces of unit accelerations along x, y, z (for gravity)
+    ChMatrixDynamic<> V;   ///< displacements of the internal nodes per unit reduced coordinate
+    ChVectorDynamic<> eigenvalues;
+
+    ChVectorDynamic<> q;       ///< modal coordinates
+    ChVectorDynamic<> q_dt;    ///< modal speeds
+    ChVectorDynamic<> q_dtdt;  ///< modal accelerations
+    ChVariablesGenericDiagonalMass* modal_variables;
+    ChKblockGeneric KRM_block;
+
+    bool automatic_gravity_load;
+};
+
+/// @} fea_module
+
+}  // end namespace fea
+}  // end namespace chrono
+
+#endif
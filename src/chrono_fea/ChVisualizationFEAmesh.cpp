@@ -14,6 +14,7 @@
 
 #include "chrono/assets/ChGlyphs.h"
 #include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/parallel/ChTaskScheduler.h"
 
 #include "chrono_fea/ChContactSurfaceMesh.h"
 #include "chrono_fea/ChContactSurfaceNodeCloud.h"
@@ -63,6 +64,14 @@ ChVisualizationFEAmesh::ChVisualizationFEAmesh(ChMesh& mymesh) {
 
     undeformed_reference = false;
 
+    update_every = 1;
+    update_counter = 0;
+    update_colors = true;
+
+    topology_valid = false;
+    automatic_smoothing = false;
+    topology_nverts = 0;
+
     auto new_mesh_asset = std::make_shared<ChTriangleMeshShape>();
     this->AddAsset(new_mesh_asset);
 
@@ -198,7 +207,8 @@ void ChVisualizationFEAmesh::UpdateBuffers_Hex(std::shared_ptr<ChElementBase> el
                                                unsigned int& i_verts,
                                                unsigned int& i_vnorms,
                                                unsigned int& i_vcols,
-                                               unsigned int& i_triindex) {
+                                               unsigned int& i_triindex,
+                                               bool topology) {
     unsigned int ivert_el = i_verts;
     unsigned int inorm_el = i_vnorms;
 
@@ -230,11 +240,16 @@ void ChVisualizationFEAmesh::UpdateBuffers_Hex(std::shared_ptr<ChElementBase> el
     }
 
     // colours and colours indexes
-    for (int in = 0; in < 8; ++in) {
-        trianglemesh.getCoordsColors()[i_vcols] = ComputeFalseColor(ComputeScalarOutput(nodes[in], in, element));
-        ++i_vcols;
+    if (topology || update_colors) {
+        for (int in = 0; in < 8; ++in) {
+            trianglemesh.getCoordsColors()[i_vcols] = ComputeFalseColor(ComputeScalarOutput(nodes[in], in, element));
+            ++i_vcols;
+        }
     }
 
+    if (!topology)
+        return;
+
     // faces indexes
     ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
     trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 2, 1) + ivert_offset;
@@ -281,33 +296,450 @@ void ChVisualizationFEAmesh::UpdateBuffers_Hex(std::shared_ptr<ChElementBase> el
     }
 }
 
-void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>& coords) {
-    if (!this->FEMmesh)
-        return;
+// Helper function for updating visualization mesh buffers for an element, in colormap drawing.
+// The counters are advanced by the number of vertexes, normals, colors, faces of the element. If topology is
+// false, only the vertexes, normals and colors are updated, and the face indexes are left unchanged.
+void ChVisualizationFEAmesh::UpdateBuffers_Element(std::shared_ptr<ChElementBase> element,
+                                                   geometry::ChTriangleMeshConnected& trianglemesh,
+                                                   unsigned int& i_verts,
+                                                   unsigned int& i_vnorms,
+                                                   unsigned int& i_vcols,
+                                                   unsigned int& i_triindex,
+                                                   bool& need_automatic_smoothing,
+                                                   bool topology) {
+    bool colors = topology || update_colors;
+
+    // ------------ELEMENT IS A TETRAHEDRON 4 NODES?
+
+    if (auto mytetra = std::dynamic_pointer_cast<ChElementTetra_4>(element)) {
+        auto node0 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(0));
+        auto node1 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(1));
+        auto node2 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(2));
+        auto node3 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(3));
+
+        unsigned int ivert_el = i_verts;
+        unsigned int inorm_el = i_vnorms;
+
+        // vertexes
+        ChVector<> p0 = node0->GetPos();
+        ChVector<> p1 = node1->GetPos();
+        ChVector<> p2 = node2->GetPos();
+        ChVector<> p3 = node3->GetPos();
+        if (undeformed_reference) {
+            p0 = node0->GetX0();
+            p1 = node1->GetX0();
+            p2 = node2->GetX0();
+            p3 = node3->GetX0();
+        }
 
-    std::shared_ptr<ChTriangleMeshShape> mesh_asset;
-    std::shared_ptr<ChGlyphs> glyphs_asset;
+        if (this->shrink_elements) {
+            ChVector<> vc = (p0 + p1 + p2 + p3) * (0.25);
+            p0 = vc + this->shrink_factor * (p0 - vc);
+            p1 = vc + this->shrink_factor * (p1 - vc);
+            p2 = vc + this->shrink_factor * (p2 - vc);
+            p3 = vc + this->shrink_factor * (p3 - vc);
+        }
+        trianglemesh.getCoordsVertices()[i_verts] = p0;
+        ++i_verts;
+        trianglemesh.getCoordsVertices()[i_verts] = p1;
+        ++i_verts;
+        trianglemesh.getCoordsVertices()[i_verts] = p2;
+        ++i_verts;
+        trianglemesh.getCoordsVertices()[i_verts] = p3;
+        ++i_verts;
 
-    // try to retrieve previously added mesh asset and glyhs asset in sublevel..
-    if (this->GetAssets().size() == 2) {
-        mesh_asset = std::dynamic_pointer_cast<ChTriangleMeshShape>(GetAssets()[0]);
-        glyphs_asset = std::dynamic_pointer_cast<ChGlyphs>(GetAssets()[1]);
+        // color
+        if (colors) {
+            trianglemesh.getCoordsColors()[i_vcols] =
+                ComputeFalseColor(ComputeScalarOutput(node0, 0, element));
+            ++i_vcols;
+            trianglemesh.getCoordsColors()[i_vcols] =
+                ComputeFalseColor(ComputeScalarOutput(node1, 1, element));
+            ++i_vcols;
+            trianglemesh.getCoordsColors()[i_vcols] =
+                ComputeFalseColor(ComputeScalarOutput(node2, 2, element));
+            ++i_vcols;
+            trianglemesh.getCoordsColors()[i_vcols] =
+                ComputeFalseColor(ComputeScalarOutput(node3, 3, element));
+            ++i_vcols;
+        }
+
+        // faces indexes
+        if (topology) {
+            ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
+            trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 1, 2) + ivert_offset;
+            ++i_triindex;
+            trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(1, 3, 2) + ivert_offset;
+            ++i_triindex;
+            trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(2, 3, 0) + ivert_offset;
+            ++i_triindex;
+            trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(3, 1, 0) + ivert_offset;
+            ++i_triindex;
+
+            // normals indices (if not defaulting to flat triangles)
+            if (this->smooth_faces) {
+                ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
+                trianglemesh.getIndicesNormals()[i_triindex - 4] = ChVector<int>(0, 0, 0) + inorm_offset;
+                trianglemesh.getIndicesNormals()[i_triindex - 3] = ChVector<int>(1, 1, 1) + inorm_offset;
+                trianglemesh.getIndicesNormals()[i_triindex - 2] = ChVector<int>(2, 2, 2) + inorm_offset;
+                trianglemesh.getIndicesNormals()[i_triindex - 1] = ChVector<int>(3, 3, 3) + inorm_offset;
+                i_vnorms += 4;
+            }
+        }
     }
 
-    // if not available, create ...
-    if (!mesh_asset) {
-        this->GetAssets().resize(0);  // this to delete other sub assets that are not in mesh & glyphs, if any
+    // ------------ELEMENT IS A TETRAHEDRON 4 NODES -for SCALAR field- ?
+
+    if (auto mytetra = std::dynamic_pointer_cast<ChElementTetra_4_P>(element)) {
+        auto node0 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(0));
+        auto node1 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(1));
+        auto node2 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(2));
+        auto node3 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(3));
+
+        unsigned int ivert_el = i_verts;
+        unsigned int inorm_el = i_vnorms;
+
+        // vertexes
+        ChVector<> p0 = node0->GetPos();
+        ChVector<> p1 = node1->GetPos();
+        ChVector<> p2 = node2->GetPos();
+        ChVector<> p3 = node3->GetPos();
+
+        if (this->shrink_elements) {
+            ChVector<> vc = (p0 + p1 + p2 + p3) * (0.25);
+            p0 = vc + this->shrink_factor * (p0 - vc);
+            p1 = vc + this->shrink_factor * (p1 - vc);
+            p2 = vc + this->shrink_factor * (p2 - vc);
+            p3 = vc + this->shrink_factor * (p3 - vc);
+        }
+        trianglemesh.getCoordsVertices()[i_verts] = p0;
+        ++i_verts;
+        trianglemesh.getCoordsVertices()[i_verts] = p1;
+        ++i_verts;
+        trianglemesh.getCoordsVertices()[i_verts] = p2;
+        ++i_verts;
+        trianglemesh.getCoordsVertices()[i_verts] = p3;
+        ++i_verts;
 
-        auto new_mesh_asset = std::make_shared<ChTriangleMeshShape>();
-        this->AddAsset(new_mesh_asset);
-        mesh_asset = new_mesh_asset;
+        // color
+        if (colors) {
+            trianglemesh.getCoordsColors()[i_vcols] =
+                ComputeFalseColor(ComputeScalarOutput(node0, 0, element));
+            ++i_vcols;
+            trianglemesh.getCoordsColors()[i_vcols] =
+                ComputeFalseColor(ComputeScalarOutput(node1, 1, element));
+            ++i_vcols;
+            trianglemesh.getCoordsColors()[i_vcols] =
+                ComputeFalseColor(ComputeScalarOutput(node2, 2, element));
+            ++i_vcols;
+            trianglemesh.getCoordsColors()[i_vcols] =
+                ComputeFalseColor(ComputeScalarOutput(node3, 3, element));
+            ++i_vcols;
+        }
 
-        auto new_glyphs_asset = std::make_shared<ChGlyphs>();
-        this->AddAsset(new_glyphs_asset);
-        glyphs_asset = new_glyphs_asset;
+        // faces indexes
+        if (topology) {
+            ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
+            trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 1, 2) + ivert_offset;
+            ++i_triindex;
+            trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(1, 3, 2) + ivert_offset;
+            ++i_triindex;
+            trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(2, 3, 0) + ivert_offset;
+            ++i_triindex;
+            trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(3, 1, 0) + ivert_offset;
+            ++i_triindex;
+
+            // normals indices (if not defaulting to flat triangles)
+            if (this->smooth_faces) {
+                ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
+                trianglemesh.getIndicesNormals()[i_triindex - 4] = ChVector<int>(0, 0, 0) + inorm_offset;
+                trianglemesh.getIndicesNormals()[i_triindex - 3] = ChVector<int>(1, 1, 1) + inorm_offset;
+                trianglemesh.getIndicesNormals()[i_triindex - 2] = ChVector<int>(2, 2, 2) + inorm_offset;
+                trianglemesh.getIndicesNormals()[i_triindex - 1] = ChVector<int>(3, 3, 3) + inorm_offset;
+                i_vnorms += 4;
+            }
+        }
     }
-    geometry::ChTriangleMeshConnected& trianglemesh = mesh_asset->GetMesh();
 
+    // ------------ELEMENT IS A HEXAHEDRON 8 NODES?
+    if (std::dynamic_pointer_cast<ChElementHexa_8>(element) ||
+        std::dynamic_pointer_cast<ChElementBrick>(element) ||
+        std::dynamic_pointer_cast<ChElementBrick_9>(element)) {
+        UpdateBuffers_Hex(element, trianglemesh, i_verts, i_vnorms, i_vcols, i_triindex, topology);
+    }
+
+    // ------------ELEMENT IS A BEAM?
+    if (auto mybeam = std::dynamic_pointer_cast<ChElementBeam>(element)) {
+        double y_thick = 0.01;  // line thickness default value
+        double z_thick = 0.01;
+        bool m_circular = false;
+        double m_rad = 0;
+
+        if (auto mybeameuler = std::dynamic_pointer_cast<ChElementBeamEuler>(mybeam)) {
+            // if the beam has a section info, use section specific thickness for drawing
+            y_thick = 0.5 * mybeameuler->GetSection()->GetDrawThicknessY();
+            z_thick = 0.5 * mybeameuler->GetSection()->GetDrawThicknessZ();
+            m_circular = mybeameuler->GetSection()->IsCircular();
+            m_rad = mybeameuler->GetSection()->GetDrawCircularRadius();
+        } else if (auto mybeamancf = std::dynamic_pointer_cast<ChElementCableANCF>(mybeam)) {
+            // if the beam has a section info, use section specific thickness for drawing
+            y_thick = 0.5 * mybeamancf->GetSection()->GetDrawThicknessY();
+            z_thick = 0.5 * mybeamancf->GetSection()->GetDrawThicknessZ();
+            m_circular = mybeamancf->GetSection()->IsCircular();
+            m_rad = mybeamancf->GetSection()->GetDrawCircularRadius();
+        } else if (auto mybeamiga = std::dynamic_pointer_cast<ChElementBeamIGA>(mybeam)) {
+            // if the beam has a section info, use section specific thickness for drawing
+            y_thick = 0.5 * mybeamiga->GetSection()->GetDrawThicknessY();
+            z_thick = 0.5 * mybeamiga->GetSection()->GetDrawThicknessZ();
+            m_circular = mybeamiga->GetSection()->IsCircular();
+            m_rad = mybeamiga->GetSection()->GetDrawCircularRadius();
+        }
+
+        unsigned int ivert_el = i_verts;
+        unsigned int inorm_el = i_vnorms;
+
+
+        for (int in = 0; in < beam_resolution; ++in) {
+            double eta = -1.0 + (2.0 * in / (beam_resolution - 1));
+
+            ChVector<> P;
+            ChQuaternion<> msectionrot;
+            mybeam->EvaluateSectionFrame(eta, P,
+                                         msectionrot);  // compute abs. pos and rot of section plane
+
+            ChVector<> vresult;
+            ChVector<> vresultB;
+            double sresult = 0;
+            switch (colors ? this->fem_data_type : E_PLOT_NONE) {
+                case E_PLOT_ELEM_BEAM_MX:
+                    mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
+                    sresult = vresultB.x();
+                    break;
+                case E_PLOT_ELEM_BEAM_MY:
+                    mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
+                    sresult = vresultB.y();
+                    break;
+                case E_PLOT_ELEM_BEAM_MZ:
+                    mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
+                    sresult = vresultB.z();
+                    break;
+                case E_PLOT_ELEM_BEAM_TX:
+                    mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
+                    sresult = vresult.x();
+                    break;
+                case E_PLOT_ELEM_BEAM_TY:
+                    mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
+                    sresult = vresult.y();
+                    break;
+                case E_PLOT_ELEM_BEAM_TZ:
+                    mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
+                    sresult = vresult.z();
+                    break;
+                case E_PLOT_ANCF_BEAM_AX:
+                    mybeam->EvaluateSectionStrain(eta, vresult);
+                    sresult = vresult.x();
+                    break;
+                case E_PLOT_ANCF_BEAM_BD:
+                    mybeam->EvaluateSectionStrain(eta, vresult);
+                    sresult = vresult.y();
+                    break;
+                default:
+                    break;
+            }
+            ChVector<float> mcol = ComputeFalseColor(sresult);
+
+            if (m_circular) {
+                // prepare a circular section
+                std::vector<ChVector<>> msection_pts(beam_resolution_section);
+                for (size_t is = 0; is < msection_pts.size(); ++is) {
+                    double sangle = CH_C_2PI * ((double)is / (double)msection_pts.size());
+                    msection_pts[is] = ChVector<>(0, cos(sangle) * m_rad, sin(sangle) * m_rad);
+                }
+
+                for (int is = 0; is < msection_pts.size(); ++is) {
+                    ChVector<> Rw = msectionrot.Rotate(msection_pts[is]);
+                    trianglemesh.getCoordsVertices()[i_verts] = P + Rw;
+                    ++i_verts;
+                    if (colors)
+                        trianglemesh.getCoordsColors()[i_vcols] = mcol;
+                    ++i_vcols;
+                    trianglemesh.getCoordsNormals()[i_vnorms] = msectionrot.Rotate(Rw.GetNormalized());
+                    ++i_vnorms;
+                }
+                // no need to compute normals later with TriangleNormalsCompute
+                need_automatic_smoothing = false;
+
+                if (topology && in > 0) {
+                    ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
+                    ChVector<int> islice_offset((in - 1) * (int)msection_pts.size(), (in - 1) * (int)msection_pts.size(),
+                                                (in - 1) * (int)msection_pts.size());
+                    for (size_t is = 0; is < msection_pts.size(); ++is) {
+                        int ipa = (int)is;
+                        int ipb = int((is + 1) % msection_pts.size());
+                        int ipaa = ipa + (int)msection_pts.size();
+                        int ipbb = ipb + (int)msection_pts.size();
+
+                        trianglemesh.getIndicesVertexes()[i_triindex] =
+                            ChVector<int>(ipa, ipbb, ipaa) + islice_offset + ivert_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex] =
+                            ChVector<int>(ipa, ipbb, ipaa) + islice_offset + ivert_offset;
+                        ++i_triindex;
+
+                        trianglemesh.getIndicesVertexes()[i_triindex] =
+                            ChVector<int>(ipa, ipb, ipbb) + islice_offset + ivert_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex] =
+                            ChVector<int>(ipa, ipb, ipbb) + islice_offset + ivert_offset;
+                        ++i_triindex;
+                    }
+                }
+            }
+            // if rectangle shape...
+            else {
+                trianglemesh.getCoordsVertices()[i_verts] =
+                    P + msectionrot.Rotate(ChVector<>(0, -y_thick, -z_thick));
+                ++i_verts;
+                trianglemesh.getCoordsVertices()[i_verts] =
+                    P + msectionrot.Rotate(ChVector<>(0, y_thick, -z_thick));
+                ++i_verts;
+                trianglemesh.getCoordsVertices()[i_verts] =
+                    P + msectionrot.Rotate(ChVector<>(0, y_thick, z_thick));
+                ++i_verts;
+                trianglemesh.getCoordsVertices()[i_verts] =
+                    P + msectionrot.Rotate(ChVector<>(0, -y_thick, z_thick));
+                ++i_verts;
+
+                if (colors) {
+                    for (int ic = 0; ic < 4; ++ic)
+                        trianglemesh.getCoordsColors()[i_vcols + ic] = mcol;
+                }
+                i_vcols += 4;
+
+                if (topology && in > 0) {
+                    ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
+                    ChVector<int> islice_offset((in - 1) * 4, (in - 1) * 4, (in - 1) * 4);
+                    trianglemesh.getIndicesVertexes()[i_triindex] =
+                        ChVector<int>(4, 0, 1) + islice_offset + ivert_offset;
+                    ++i_triindex;
+                    trianglemesh.getIndicesVertexes()[i_triindex] =
+                        ChVector<int>(4, 1, 5) + islice_offset + ivert_offset;
+                    ++i_triindex;
+                    trianglemesh.getIndicesVertexes()[i_triindex] =
+                        ChVector<int>(5, 1, 2) + islice_offset + ivert_offset;
+                    ++i_triindex;
+                    trianglemesh.getIndicesVertexes()[i_triindex] =
+                        ChVector<int>(5, 2, 6) + islice_offset + ivert_offset;
+                    ++i_triindex;
+                    trianglemesh.getIndicesVertexes()[i_triindex] =
+                        ChVector<int>(6, 2, 3) + islice_offset + ivert_offset;
+                    ++i_triindex;
+                    trianglemesh.getIndicesVertexes()[i_triindex] =
+                        ChVector<int>(6, 3, 7) + islice_offset + ivert_offset;
+                    ++i_triindex;
+                    trianglemesh.getIndicesVertexes()[i_triindex] =
+                        ChVector<int>(7, 3, 0) + islice_offset + ivert_offset;
+                    ++i_triindex;
+                    trianglemesh.getIndicesVertexes()[i_triindex] =
+                        ChVector<int>(7, 0, 4) + islice_offset + ivert_offset;
+                    ++i_triindex;
+
+                    if (this->smooth_faces) {
+                        ChVector<int> islice_normoffset((in - 1) * 8, (in - 1) * 8,
+                                                        (in - 1) * 8);  //***TO DO*** fix errors in normals
+                        ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
+                        trianglemesh.getIndicesNormals()[i_triindex - 8] =
+                            ChVector<int>(8, 0, 1) + islice_normoffset + inorm_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex - 7] =
+                            ChVector<int>(8, 1, 9) + islice_normoffset + inorm_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex - 6] =
+                            ChVector<int>(9 + 4, 1 + 4, 2 + 4) + islice_normoffset + inorm_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex - 5] =
+                            ChVector<int>(9 + 4, 2 + 4, 10 + 4) + islice_normoffset + inorm_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex - 4] =
+                            ChVector<int>(10, 2, 3) + islice_normoffset + inorm_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex - 3] =
+                            ChVector<int>(10, 3, 11) + islice_normoffset + inorm_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex - 2] =
+                            ChVector<int>(11 + 4, 3 + 4, 0 + 4) + islice_normoffset + inorm_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex - 1] =
+                            ChVector<int>(11 + 4, 0 + 4, 8 + 4) + islice_normoffset + inorm_offset;
+                        i_vnorms += 8;
+                    }
+                }
+
+            }  // end if rectangle
+        }      // end sections loop
+    }
+
+    // ------------ELEMENT IS A SHELL?
+    if (auto myshell = std::dynamic_pointer_cast<ChElementShell>(element)) {
+        unsigned int ivert_el = i_verts;
+        unsigned int inorm_el = i_vnorms;
+
+        for (int iu = 0; iu < shell_resolution; ++iu)
+            for (int iv = 0; iv < shell_resolution; ++iv) {
+                double u = -1.0 + (2.0 * iu / (shell_resolution - 1));
+                double v = -1.0 + (2.0 * iv / (shell_resolution - 1));
+
+                ChVector<> P;
+                myshell->EvaluateSectionPoint(u, v, P);  // compute abs. pos and rot of section plane
+
+                ChVector<float> mcol(1, 1, 1);
+                /*
+                ChVector<> vresult;
+                ChVector<> vresultB;
+                double sresult = 0;
+                switch(this->fem_data_type)
+                {
+                    case E_PLOT_ELEM_SHELL_blabla:
+                        myshell->EvaluateSectionForceTorque(eta, vresult, vresultB);
+                        sresult = vresultB.x();
+                        break;
+
+                }
+                ChVector<float> mcol = ComputeFalseColor(sresult);
+                */
+
+                trianglemesh.getCoordsVertices()[i_verts] = P;
+                ++i_verts;
+
+                trianglemesh.getCoordsColors()[i_vcols] = mcol;
+                ++i_vcols;
+
+                ++i_vnorms;
+
+                if (topology && iu > 0 && iv > 0) {
+                    ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
+
+                    trianglemesh.getIndicesVertexes()[i_triindex] =
+                        ChVector<int>(iu * shell_resolution + iv, (iu - 1) * shell_resolution + iv,
+                                      iu * shell_resolution + iv - 1) +
+                        ivert_offset;
+                    ++i_triindex;
+                    trianglemesh.getIndicesVertexes()[i_triindex] =
+                        ChVector<int>(iu * shell_resolution + iv - 1, (iu - 1) * shell_resolution + iv,
+                                      (iu - 1) * shell_resolution + iv - 1) +
+                        ivert_offset;
+                    ++i_triindex;
+
+                    if (this->smooth_faces) {
+                        ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
+                        trianglemesh.getIndicesNormals()[i_triindex - 2] =
+                            ChVector<int>(iu * shell_resolution + iv, (iu - 1) * shell_resolution + iv,
+                                          iu * shell_resolution + iv - 1) +
+                            inorm_offset;
+                        trianglemesh.getIndicesNormals()[i_triindex - 1] =
+                            ChVector<int>(iu * shell_resolution + iv - 1, (iu - 1) * shell_resolution + iv,
+                                          (iu - 1) * shell_resolution + iv - 1) +
+                            inorm_offset;
+                    }
+                }
+            }
+    }
+}
+
+// Rebuild the triangle mesh: count the vertexes and faces, resize the buffers and fill them all.
+// In colormap drawing, the offsets of the elements in the buffers are cached for UpdateMeshAttributes().
+void ChVisualizationFEAmesh::UpdateMeshTopology(geometry::ChTriangleMeshConnected& trianglemesh) {
     size_t n_verts = 0;
     size_t n_vcols = 0;
     size_t n_vnorms = 0;
@@ -454,427 +886,15 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
     //   In case of colormap drawing:
     if (this->fem_data_type != E_PLOT_NONE && this->fem_data_type != E_PLOT_LOADSURFACES &&
         this->fem_data_type != E_PLOT_CONTACTSURFACES) {
+        element_offsets.resize(this->FEMmesh->GetNelements());
         for (unsigned int iel = 0; iel < this->FEMmesh->GetNelements(); ++iel) {
-            // ------------ELEMENT IS A TETRAHEDRON 4 NODES?
-
-            if (auto mytetra = std::dynamic_pointer_cast<ChElementTetra_4>(this->FEMmesh->GetElement(iel))) {
-                auto node0 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(0));
-                auto node1 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(1));
-                auto node2 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(2));
-                auto node3 = std::dynamic_pointer_cast<ChNodeFEAxyz>(mytetra->GetNodeN(3));
-
-                unsigned int ivert_el = i_verts;
-                unsigned int inorm_el = i_vnorms;
-
-                // vertexes
-                ChVector<> p0 = node0->GetPos();
-                ChVector<> p1 = node1->GetPos();
-                ChVector<> p2 = node2->GetPos();
-                ChVector<> p3 = node3->GetPos();
-                if (undeformed_reference) {
-                    p0 = node0->GetX0();
-                    p1 = node1->GetX0();
-                    p2 = node2->GetX0();
-                    p3 = node3->GetX0();
-                }
-
-                if (this->shrink_elements) {
-                    ChVector<> vc = (p0 + p1 + p2 + p3) * (0.25);
-                    p0 = vc + this->shrink_factor * (p0 - vc);
-                    p1 = vc + this->shrink_factor * (p1 - vc);
-                    p2 = vc + this->shrink_factor * (p2 - vc);
-                    p3 = vc + this->shrink_factor * (p3 - vc);
-                }
-                trianglemesh.getCoordsVertices()[i_verts] = p0;
-                ++i_verts;
-                trianglemesh.getCoordsVertices()[i_verts] = p1;
-                ++i_verts;
-                trianglemesh.getCoordsVertices()[i_verts] = p2;
-                ++i_verts;
-                trianglemesh.getCoordsVertices()[i_verts] = p3;
-                ++i_verts;
-
-                // color
-                trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node0, 0, this->FEMmesh->GetElement(iel)));
-                ++i_vcols;
-                trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node1, 1, this->FEMmesh->GetElement(iel)));
-                ++i_vcols;
-                trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node2, 2, this->FEMmesh->GetElement(iel)));
-                ++i_vcols;
-                trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node3, 3, this->FEMmesh->GetElement(iel)));
-                ++i_vcols;
-
-                // faces indexes
-                ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
-                trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 1, 2) + ivert_offset;
-                ++i_triindex;
-                trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(1, 3, 2) + ivert_offset;
-                ++i_triindex;
-                trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(2, 3, 0) + ivert_offset;
-                ++i_triindex;
-                trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(3, 1, 0) + ivert_offset;
-                ++i_triindex;
-
-                // normals indices (if not defaulting to flat triangles)
-                if (this->smooth_faces) {
-                    ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
-                    trianglemesh.getIndicesNormals()[i_triindex - 4] = ChVector<int>(0, 0, 0) + inorm_offset;
-                    trianglemesh.getIndicesNormals()[i_triindex - 3] = ChVector<int>(1, 1, 1) + inorm_offset;
-                    trianglemesh.getIndicesNormals()[i_triindex - 2] = ChVector<int>(2, 2, 2) + inorm_offset;
-                    trianglemesh.getIndicesNormals()[i_triindex - 1] = ChVector<int>(3, 3, 3) + inorm_offset;
-                    i_vnorms += 4;
-                }
-            }
-
-            // ------------ELEMENT IS A TETRAHEDRON 4 NODES -for SCALAR field- ?
-
-            if (auto mytetra = std::dynamic_pointer_cast<ChElementTetra_4_P>(this->FEMmesh->GetElement(iel))) {
-                auto node0 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(0));
-                auto node1 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(1));
-                auto node2 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(2));
-                auto node3 = std::dynamic_pointer_cast<ChNodeFEAxyzP>(mytetra->GetNodeN(3));
-
-                unsigned int ivert_el = i_verts;
-                unsigned int inorm_el = i_vnorms;
-
-                // vertexes
-                ChVector<> p0 = node0->GetPos();
-                ChVector<> p1 = node1->GetPos();
-                ChVector<> p2 = node2->GetPos();
-                ChVector<> p3 = node3->GetPos();
-
-                if (this->shrink_elements) {
-                    ChVector<> vc = (p0 + p1 + p2 + p3) * (0.25);
-                    p0 = vc + this->shrink_factor * (p0 - vc);
-                    p1 = vc + this->shrink_factor * (p1 - vc);
-                    p2 = vc + this->shrink_factor * (p2 - vc);
-                    p3 = vc + this->shrink_factor * (p3 - vc);
-                }
-                trianglemesh.getCoordsVertices()[i_verts] = p0;
-                ++i_verts;
-                trianglemesh.getCoordsVertices()[i_verts] = p1;
-                ++i_verts;
-                trianglemesh.getCoordsVertices()[i_verts] = p2;
-                ++i_verts;
-                trianglemesh.getCoordsVertices()[i_verts] = p3;
-                ++i_verts;
+            element_offsets[iel].verts = i_verts;
+            element_offsets[iel].vnorms = i_vnorms;
+            element_offsets[iel].vcols = i_vcols;
+            element_offsets[iel].triindex = i_triindex;
 
-                // color
-                trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node0, 0, this->FEMmesh->GetElement(iel)));
-                ++i_vcols;
-                trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node1, 1, this->FEMmesh->GetElement(iel)));
-                ++i_vcols;
-                trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node2, 2, this->FEMmesh->GetElement(iel)));
-                ++i_vcols;
-                trianglemesh.getCoordsColors()[i_vcols] =
-                    ComputeFalseColor(ComputeScalarOutput(node3, 3, this->FEMmesh->GetElement(iel)));
-                ++i_vcols;
-
-                // faces indexes
-                ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
-                trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(0, 1, 2) + ivert_offset;
-                ++i_triindex;
-                trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(1, 3, 2) + ivert_offset;
-                ++i_triindex;
-                trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(2, 3, 0) + ivert_offset;
-                ++i_triindex;
-                trianglemesh.getIndicesVertexes()[i_triindex] = ChVector<int>(3, 1, 0) + ivert_offset;
-                ++i_triindex;
-
-                // normals indices (if not defaulting to flat triangles)
-                if (this->smooth_faces) {
-                    ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
-                    trianglemesh.getIndicesNormals()[i_triindex - 4] = ChVector<int>(0, 0, 0) + inorm_offset;
-                    trianglemesh.getIndicesNormals()[i_triindex - 3] = ChVector<int>(1, 1, 1) + inorm_offset;
-                    trianglemesh.getIndicesNormals()[i_triindex - 2] = ChVector<int>(2, 2, 2) + inorm_offset;
-                    trianglemesh.getIndicesNormals()[i_triindex - 1] = ChVector<int>(3, 3, 3) + inorm_offset;
-                    i_vnorms += 4;
-                }
-            }
-
-            // ------------ELEMENT IS A HEXAHEDRON 8 NODES?
-            if (std::dynamic_pointer_cast<ChElementHexa_8>(FEMmesh->GetElement(iel)) ||
-                std::dynamic_pointer_cast<ChElementBrick>(FEMmesh->GetElement(iel)) ||
-                std::dynamic_pointer_cast<ChElementBrick_9>(FEMmesh->GetElement(iel))) {
-                UpdateBuffers_Hex(FEMmesh->GetElement(iel), trianglemesh, i_verts, i_vnorms, i_vcols, i_triindex);
-            }
-
-            // ------------ELEMENT IS A BEAM?
-            if (auto mybeam = std::dynamic_pointer_cast<ChElementBeam>(this->FEMmesh->GetElement(iel))) {
-                double y_thick = 0.01;  // line thickness default value
-                double z_thick = 0.01;
-                bool m_circular = false;
-                double m_rad = 0;
-
-                if (auto mybeameuler = std::dynamic_pointer_cast<ChElementBeamEuler>(mybeam)) {
-                    // if the beam has a section info, use section specific thickness for drawing
-                    y_thick = 0.5 * mybeameuler->GetSection()->GetDrawThicknessY();
-                    z_thick = 0.5 * mybeameuler->GetSection()->GetDrawThicknessZ();
-                    m_circular = mybeameuler->GetSection()->IsCircular();
-                    m_rad = mybeameuler->GetSection()->GetDrawCircularRadius();
-                } else if (auto mybeamancf = std::dynamic_pointer_cast<ChElementCableANCF>(mybeam)) {
-                    // if the beam has a section info, use section specific thickness for drawing
-                    y_thick = 0.5 * mybeamancf->GetSection()->GetDrawThicknessY();
-                    z_thick = 0.5 * mybeamancf->GetSection()->GetDrawThicknessZ();
-                    m_circular = mybeamancf->GetSection()->IsCircular();
-                    m_rad = mybeamancf->GetSection()->GetDrawCircularRadius();
-                } else if (auto mybeamiga = std::dynamic_pointer_cast<ChElementBeamIGA>(mybeam)) {
-                    // if the beam has a section info, use section specific thickness for drawing
-                    y_thick = 0.5 * mybeamiga->GetSection()->GetDrawThicknessY();
-                    z_thick = 0.5 * mybeamiga->GetSection()->GetDrawThicknessZ();
-                    m_circular = mybeamiga->GetSection()->IsCircular();
-                    m_rad = mybeamiga->GetSection()->GetDrawCircularRadius();
-                }
-
-                unsigned int ivert_el = i_verts;
-                unsigned int inorm_el = i_vnorms;
-
-
-                for (int in = 0; in < beam_resolution; ++in) {
-                    double eta = -1.0 + (2.0 * in / (beam_resolution - 1));
-
-                    ChVector<> P;
-                    ChQuaternion<> msectionrot;
-                    mybeam->EvaluateSectionFrame(eta, P,
-                                                 msectionrot);  // compute abs. pos and rot of section plane
-
-                    ChVector<> vresult;
-                    ChVector<> vresultB;
-                    double sresult = 0;
-                    switch (this->fem_data_type) {
-                        case E_PLOT_ELEM_BEAM_MX:
-                            mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
-                            sresult = vresultB.x();
-                            break;
-                        case E_PLOT_ELEM_BEAM_MY:
-                            mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
-                            sresult = vresultB.y();
-                            break;
-                        case E_PLOT_ELEM_BEAM_MZ:
-                            mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
-                            sresult = vresultB.z();
-                            break;
-                        case E_PLOT_ELEM_BEAM_TX:
-                            mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
-                            sresult = vresult.x();
-                            break;
-                        case E_PLOT_ELEM_BEAM_TY:
-                            mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
-                            sresult = vresult.y();
-                            break;
-                        case E_PLOT_ELEM_BEAM_TZ:
-                            mybeam->EvaluateSectionForceTorque(eta, vresult, vresultB);
-                            sresult = vresult.z();
-                            break;
-                        case E_PLOT_ANCF_BEAM_AX:
-                            mybeam->EvaluateSectionStrain(eta, vresult);
-                            sresult = vresult.x();
-                            break;
-                        case E_PLOT_ANCF_BEAM_BD:
-                            mybeam->EvaluateSectionStrain(eta, vresult);
-                            sresult = vresult.y();
-                            break;
-                        default:
-                            break;
-                    }
-                    ChVector<float> mcol = ComputeFalseColor(sresult);
-
-                    if (m_circular) {
-                        // prepare a circular section
-                        std::vector<ChVector<>> msection_pts(beam_resolution_section);
-                        for (size_t is = 0; is < msection_pts.size(); ++is) {
-                            double sangle = CH_C_2PI * ((double)is / (double)msection_pts.size());
-                            msection_pts[is] = ChVector<>(0, cos(sangle) * m_rad, sin(sangle) * m_rad);
-                        }
-
-                        for (int is = 0; is < msection_pts.size(); ++is) {
-                            ChVector<> Rw = msectionrot.Rotate(msection_pts[is]);
-                            trianglemesh.getCoordsVertices()[i_verts] = P + Rw;
-                            ++i_verts;
-                            trianglemesh.getCoordsColors()[i_vcols] = mcol;
-                            ++i_vcols;
-                            trianglemesh.getCoordsNormals()[i_vnorms] = msectionrot.Rotate(Rw.GetNormalized());
-                            ++i_vnorms;
-                        }
-                        // no need to compute normals later with TriangleNormalsCompute
-                        need_automatic_smoothing = false;
-
-                        if (in > 0) {
-                            ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
-                            ChVector<int> islice_offset((in - 1) * (int)msection_pts.size(), (in - 1) * (int)msection_pts.size(),
-                                                        (in - 1) * (int)msection_pts.size());
-                            for (size_t is = 0; is < msection_pts.size(); ++is) {
-                                int ipa = (int)is;
-                                int ipb = int((is + 1) % msection_pts.size());
-                                int ipaa = ipa + (int)msection_pts.size();
-                                int ipbb = ipb + (int)msection_pts.size();
-
-                                trianglemesh.getIndicesVertexes()[i_triindex] =
-                                    ChVector<int>(ipa, ipbb, ipaa) + islice_offset + ivert_offset;
-                                trianglemesh.getIndicesNormals()[i_triindex] =
-                                    ChVector<int>(ipa, ipbb, ipaa) + islice_offset + ivert_offset;
-                                ++i_triindex;
-
-                                trianglemesh.getIndicesVertexes()[i_triindex] =
-                                    ChVector<int>(ipa, ipb, ipbb) + islice_offset + ivert_offset;
-                                trianglemesh.getIndicesNormals()[i_triindex] =
-                                    ChVector<int>(ipa, ipb, ipbb) + islice_offset + ivert_offset;
-                                ++i_triindex;
-                            }
-                        }
-                    }
-                    // if rectangle shape...
-                    else {
-                        trianglemesh.getCoordsVertices()[i_verts] =
-                            P + msectionrot.Rotate(ChVector<>(0, -y_thick, -z_thick));
-                        ++i_verts;
-                        trianglemesh.getCoordsVertices()[i_verts] =
-                            P + msectionrot.Rotate(ChVector<>(0, y_thick, -z_thick));
-                        ++i_verts;
-                        trianglemesh.getCoordsVertices()[i_verts] =
-                            P + msectionrot.Rotate(ChVector<>(0, y_thick, z_thick));
-                        ++i_verts;
-                        trianglemesh.getCoordsVertices()[i_verts] =
-                            P + msectionrot.Rotate(ChVector<>(0, -y_thick, z_thick));
-                        ++i_verts;
-
-                        trianglemesh.getCoordsColors()[i_vcols] = mcol;
-                        ++i_vcols;
-                        trianglemesh.getCoordsColors()[i_vcols] = mcol;
-                        ++i_vcols;
-                        trianglemesh.getCoordsColors()[i_vcols] = mcol;
-                        ++i_vcols;
-                        trianglemesh.getCoordsColors()[i_vcols] = mcol;
-                        ++i_vcols;
-
-                        if (in > 0) {
-                            ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
-                            ChVector<int> islice_offset((in - 1) * 4, (in - 1) * 4, (in - 1) * 4);
-                            trianglemesh.getIndicesVertexes()[i_triindex] =
-                                ChVector<int>(4, 0, 1) + islice_offset + ivert_offset;
-                            ++i_triindex;
-                            trianglemesh.getIndicesVertexes()[i_triindex] =
-                                ChVector<int>(4, 1, 5) + islice_offset + ivert_offset;
-                            ++i_triindex;
-                            trianglemesh.getIndicesVertexes()[i_triindex] =
-                                ChVector<int>(5, 1, 2) + islice_offset + ivert_offset;
-                            ++i_triindex;
-                            trianglemesh.getIndicesVertexes()[i_triindex] =
-                                ChVector<int>(5, 2, 6) + islice_offset + ivert_offset;
-                            ++i_triindex;
-                            trianglemesh.getIndicesVertexes()[i_triindex] =
-                                ChVector<int>(6, 2, 3) + islice_offset + ivert_offset;
-                            ++i_triindex;
-                            trianglemesh.getIndicesVertexes()[i_triindex] =
-                                ChVector<int>(6, 3, 7) + islice_offset + ivert_offset;
-                            ++i_triindex;
-                            trianglemesh.getIndicesVertexes()[i_triindex] =
-                                ChVector<int>(7, 3, 0) + islice_offset + ivert_offset;
-                            ++i_triindex;
-                            trianglemesh.getIndicesVertexes()[i_triindex] =
-                                ChVector<int>(7, 0, 4) + islice_offset + ivert_offset;
-                            ++i_triindex;
-
-                            if (this->smooth_faces) {
-                                ChVector<int> islice_normoffset((in - 1) * 8, (in - 1) * 8,
-                                                                (in - 1) * 8);  //***TO DO*** fix errors in normals
-                                ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
-                                trianglemesh.getIndicesNormals()[i_triindex - 8] =
-                                    ChVector<int>(8, 0, 1) + islice_normoffset + inorm_offset;
-                                trianglemesh.getIndicesNormals()[i_triindex - 7] =
-                                    ChVector<int>(8, 1, 9) + islice_normoffset + inorm_offset;
-                                trianglemesh.getIndicesNormals()[i_triindex - 6] =
-                                    ChVector<int>(9 + 4, 1 + 4, 2 + 4) + islice_normoffset + inorm_offset;
-                                trianglemesh.getIndicesNormals()[i_triindex - 5] =
-                                    ChVector<int>(9 + 4, 2 + 4, 10 + 4) + islice_normoffset + inorm_offset;
-                                trianglemesh.getIndicesNormals()[i_triindex - 4] =
-                                    ChVector<int>(10, 2, 3) + islice_normoffset + inorm_offset;
-                                trianglemesh.getIndicesNormals()[i_triindex - 3] =
-                                    ChVector<int>(10, 3, 11) + islice_normoffset + inorm_offset;
-                                trianglemesh.getIndicesNormals()[i_triindex - 2] =
-                                    ChVector<int>(11 + 4, 3 + 4, 0 + 4) + islice_normoffset + inorm_offset;
-                                trianglemesh.getIndicesNormals()[i_triindex - 1] =
-                                    ChVector<int>(11 + 4, 0 + 4, 8 + 4) + islice_normoffset + inorm_offset;
-                                i_vnorms += 8;
-                            }
-                        }
-
-                    }  // end if rectangle
-                }      // end sections loop
-            }
-
-            // ------------ELEMENT IS A SHELL?
-            if (auto myshell = std::dynamic_pointer_cast<ChElementShell>(this->FEMmesh->GetElement(iel))) {
-                unsigned int ivert_el = i_verts;
-                unsigned int inorm_el = i_vnorms;
-
-                for (int iu = 0; iu < shell_resolution; ++iu)
-                    for (int iv = 0; iv < shell_resolution; ++iv) {
-                        double u = -1.0 + (2.0 * iu / (shell_resolution - 1));
-                        double v = -1.0 + (2.0 * iv / (shell_resolution - 1));
-
-                        ChVector<> P;
-                        myshell->EvaluateSectionPoint(u, v, P);  // compute abs. pos and rot of section plane
-
-                        ChVector<float> mcol(1, 1, 1);
-                        /*
-                        ChVector<> vresult;
-                        ChVector<> vresultB;
-                        double sresult = 0;
-                        switch(this->fem_data_type)
-                        {
-                            case E_PLOT_ELEM_SHELL_blabla:
-                                myshell->EvaluateSectionForceTorque(eta, vresult, vresultB);
-                                sresult = vresultB.x();
-                                break;
-
-                        }
-                        ChVector<float> mcol = ComputeFalseColor(sresult);
-                        */
-
-                        trianglemesh.getCoordsVertices()[i_verts] = P;
-                        ++i_verts;
-
-                        trianglemesh.getCoordsColors()[i_vcols] = mcol;
-                        ++i_vcols;
-
-                        ++i_vnorms;
-
-                        if (iu > 0 && iv > 0) {
-                            ChVector<int> ivert_offset(ivert_el, ivert_el, ivert_el);
-
-                            trianglemesh.getIndicesVertexes()[i_triindex] =
-                                ChVector<int>(iu * shell_resolution + iv, (iu - 1) * shell_resolution + iv,
-                                              iu * shell_resolution + iv - 1) +
-                                ivert_offset;
-                            ++i_triindex;
-                            trianglemesh.getIndicesVertexes()[i_triindex] =
-                                ChVector<int>(iu * shell_resolution + iv - 1, (iu - 1) * shell_resolution + iv,
-                                              (iu - 1) * shell_resolution + iv - 1) +
-                                ivert_offset;
-                            ++i_triindex;
-
-                            if (this->smooth_faces) {
-                                ChVector<int> inorm_offset = ChVector<int>(inorm_el, inorm_el, inorm_el);
-                                trianglemesh.getIndicesNormals()[i_triindex - 2] =
-                                    ChVector<int>(iu * shell_resolution + iv, (iu - 1) * shell_resolution + iv,
-                                                  iu * shell_resolution + iv - 1) +
-                                    inorm_offset;
-                                trianglemesh.getIndicesNormals()[i_triindex - 1] =
-                                    ChVector<int>(iu * shell_resolution + iv - 1, (iu - 1) * shell_resolution + iv,
-                                                  (iu - 1) * shell_resolution + iv - 1) +
-                                    inorm_offset;
-                            }
-                        }
-                    }
-            }
+            UpdateBuffers_Element(FEMmesh->GetElement(iel), trianglemesh, i_verts, i_vnorms, i_vcols, i_triindex,
+                                  need_automatic_smoothing, true);
 
             // ------------***TO DO*** other types of elements...
 
@@ -1000,6 +1020,78 @@ void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>&
         TriangleNormalsSmooth(trianglemesh.getCoordsNormals(), normal_accumulators);
     }
 
+    // the cached topology is used only for the colormap drawing
+    topology_valid = (this->fem_data_type != E_PLOT_NONE && this->fem_data_type != E_PLOT_LOADSURFACES &&
+                      this->fem_data_type != E_PLOT_CONTACTSURFACES);
+    automatic_smoothing = need_automatic_smoothing;
+    topology_nverts = n_verts;
+}
+
+// Update the vertexes, normals and colors of the triangle mesh, in parallel over the elements, at the
+// offsets cached by UpdateMeshTopology(). The faces are not changed.
+void ChVisualizationFEAmesh::UpdateMeshAttributes(geometry::ChTriangleMeshConnected& trianglemesh) {
+    ChParallelFor(0, (int)this->FEMmesh->GetNelements(), 0, [&](int iel) {
+        BufferOffsets offsets = element_offsets[iel];
+        bool need_automatic_smoothing = automatic_smoothing;
+        UpdateBuffers_Element(FEMmesh->GetElement(iel), trianglemesh, offsets.verts, offsets.vnorms, offsets.vcols,
+                              offsets.triindex, need_automatic_smoothing, false);
+    });
+
+    if (automatic_smoothing) {
+        TriangleNormalsReset(trianglemesh.getCoordsNormals(), normal_accumulators);
+
+        for (unsigned int itri = 0; itri < trianglemesh.getIndicesVertexes().size(); ++itri)
+            TriangleNormalsCompute(trianglemesh.getIndicesNormals()[itri], trianglemesh.getIndicesVertexes()[itri],
+                                   trianglemesh.getCoordsVertices(), trianglemesh.getCoordsNormals(),
+                                   normal_accumulators);
+
+        TriangleNormalsSmooth(trianglemesh.getCoordsNormals(), normal_accumulators);
+    }
+}
+
+void ChVisualizationFEAmesh::Update(ChPhysicsItem* updater, const ChCoordsys<>& coords) {
+    if (!this->FEMmesh)
+        return;
+
+    // skip the update, if only one every n frames is required
+    if (topology_valid && update_counter > 0 && update_counter < update_every) {
+        ++update_counter;
+        ChAssetLevel::Update(updater, coords);
+        return;
+    }
+    update_counter = 1;
+
+    std::shared_ptr<ChTriangleMeshShape> mesh_asset;
+    std::shared_ptr<ChGlyphs> glyphs_asset;
+
+    // try to retrieve previously added mesh asset and glyhs asset in sublevel..
+    if (this->GetAssets().size() == 2) {
+        mesh_asset = std::dynamic_pointer_cast<ChTriangleMeshShape>(GetAssets()[0]);
+        glyphs_asset = std::dynamic_pointer_cast<ChGlyphs>(GetAssets()[1]);
+    }
+
+    // if not available, create ...
+    if (!mesh_asset) {
+        this->GetAssets().resize(0);  // this to delete other sub assets that are not in mesh & glyphs, if any
+
+        auto new_mesh_asset = std::make_shared<ChTriangleMeshShape>();
+        this->AddAsset(new_mesh_asset);
+        mesh_asset = new_mesh_asset;
+
+        auto new_glyphs_asset = std::make_shared<ChGlyphs>();
+        this->AddAsset(new_glyphs_asset);
+        glyphs_asset = new_glyphs_asset;
+    }
+    geometry::ChTriangleMeshConnected& trianglemesh = mesh_asset->GetMesh();
+
+    bool colormap = (this->fem_data_type != E_PLOT_NONE && this->fem_data_type != E_PLOT_LOADSURFACES &&
+                     this->fem_data_type != E_PLOT_CONTACTSURFACES);
+    if (colormap && topology_valid && element_offsets.size() == this->FEMmesh->GetNelements() &&
+        trianglemesh.getCoordsVertices().size() == topology_nverts)
+        UpdateMeshAttributes(trianglemesh);
+    else
+        UpdateMeshTopology(trianglemesh);
+
     // other flags
     mesh_asset->SetWireframe(this->wireframe);
 
@@ -113,6 +113,22 @@ class ChApiFea ChVisualizationFEAmesh : public ChAssetLevel {
 
     std::vector<int> normal_accumulators;
 
+    int update_every;
+    int update_counter;
+    bool update_colors;
+
+    // Offsets of the buffers of each element in the triangle mesh, cached when the topology is built
+    struct BufferOffsets {
+        unsigned int verts;
+        unsigned int vnorms;
+        unsigned int vcols;
+        unsigned int triindex;
+    };
+    std::vector<BufferOffsets> element_offsets;
+    bool topology_valid;
+    bool automatic_smoothing;
+    size_t topology_nverts;
+
   public:
     //
     // CONSTRUCTORS
@@ -133,7 +149,10 @@ class ChApiFea ChVisualizationFEAmesh : public ChAssetLevel {
     eChFemDataType GetFEMdataType() { return fem_data_type; }
 
     // Set the current data type to be plotted (speeds, forces, etc.)
-    void SetFEMdataType(eChFemDataType mdata) { fem_data_type = mdata; }
+    void SetFEMdataType(eChFemDataType mdata) {
+        fem_data_type = mdata;
+        topology_valid = false;
+    }
 
     // Returns the current data type to be drawn with glyphs
     eChFemGlyphs GetFEMglyphType() { return fem_glyph; }
@@ -156,16 +175,25 @@ class ChApiFea ChVisualizationFEAmesh : public ChAssetLevel {
     double GetSymbolsThickness() { return this->symbols_thickness; }
 
     /// Set the resolution of beam triangulated drawing, along direction of beam
-    void SetBeamResolution(int mres) { this->beam_resolution = mres; }
+    void SetBeamResolution(int mres) {
+        this->beam_resolution = mres;
+        topology_valid = false;
+    }
     int GetBeamResolution() { return this->beam_resolution; }
 
     /// Set the resolution of beam triangulated drawing, along the section
     /// (i.e. for circular section= number of points along the circle)
-    void SetBeamResolutionSection(int mres) { this->beam_resolution_section = mres; }
+    void SetBeamResolutionSection(int mres) {
+        this->beam_resolution_section = mres;
+        topology_valid = false;
+    }
     int GetBeamResolutionSection() { return this->beam_resolution_section; }
 
     /// Set the resolution of shell triangulated drawing
-    void SetShellResolution(int mres) { this->shell_resolution = mres; }
+    void SetShellResolution(int mres) {
+        this->shell_resolution = mres;
+        topology_valid = false;
+    }
     int GetShellResolution() { return this->shell_resolution; }
 
     // Set shrinkage of elements during drawing
@@ -189,12 +217,30 @@ class ChApiFea ChVisualizationFEAmesh : public ChAssetLevel {
 
     // Activate Gourad or Phong smoothing for faces of non-straight elements
     // (with a small performance overhead) -NOTE: experimental
-    void SetSmoothFaces(bool msmooth) { this->smooth_faces = msmooth; }
+    void SetSmoothFaces(bool msmooth) {
+        this->smooth_faces = msmooth;
+        topology_valid = false;
+    }
 
     // If this flag is turned on, the mesh is drawn as it is
     // undeformed (the reference position).
     void SetDrawInUndeformedReference(bool mdu) { this->undeformed_reference = mdu; }
 
+    /// Update the visualization only once every n calls to Update() (default 1: at each call).
+    void SetUpdateEveryNframes(int n) { this->update_every = n; }
+    int GetUpdateEveryNframes() const { return this->update_every; }
+
+    /// Enable/disable the update of the false colors (default true). If disabled, only the positions (and
+    /// normals) of the vertexes are updated, and the colors are those of the last rebuild of the topology.
+    void SetUpdateColors(bool mupdate) { this->update_colors = mupdate; }
+
+    /// Force the rebuild of the triangle mesh topology at the next Update().
+    /// In colormap drawing, the topology (faces, and offsets of each element in the buffers) is built once,
+    /// then only the vertexes, normals and colors are updated, in parallel. The topology is rebuilt if the
+    /// number of elements changes or if the drawing settings change; call this function if the elements of
+    /// the mesh are replaced in other ways.
+    void ForceTopologyUpdate() { topology_valid = false; }
+
     // Updates the triangle visualization mesh so that it matches with the
     // FEM mesh (ex. tetrahedrons are converted in 4 surfaces, etc.
     virtual void Update(ChPhysicsItem* updater, const ChCoordsys<>& coords);
@@ -213,7 +259,18 @@ class ChApiFea ChVisualizationFEAmesh : public ChAssetLevel {
                            unsigned int& i_verts,
                            unsigned int& i_vnorms,
                            unsigned int& i_vcols,
-                           unsigned int& i_triindex);
+                           unsigned int& i_triindex,
+                           bool topology);
+    void UpdateBuffers_Element(std::shared_ptr<ChElementBase> element,
+                               geometry::ChTriangleMeshConnected& trianglemesh,
+                               unsigned int& i_verts,
+                               unsigned int& i_vnorms,
+                               unsigned int& i_vcols,
+                               unsigned int& i_triindex,
+                               bool& need_automatic_smoothing,
+                               bool topology);
+    void UpdateMeshTopology(geometry::ChTriangleMeshConnected& trianglemesh);
+    void UpdateMeshAttributes(geometry::ChTriangleMeshConnected& trianglemesh);
 };
 
 }  // end namespace fea
@@ -185,14 +185,13 @@ __global__ void calcBceAcceleration_kernel(Real3 *bceAcc, Real4 *q_fsiBodies_D,
   Real3 rigidSPH_MeshPos_LRF = rigidSPH_MeshPos_LRF_D[bceIndex];
   Real3 wVelCrossS = cross(wVel3, rigidSPH_MeshPos_LRF);
   Real3 wVelCrossWVelCrossS = cross(wVel3, wVelCrossS);
-  acc3 += dot(a1, wVelCrossWVelCrossS), dot(a2, wVelCrossWVelCrossS),
-      dot(a3,
-          wVelCrossWVelCrossS); // centrigugal acceleration
+  acc3 += mR3(dot(a1, wVelCrossWVelCrossS), dot(a2, wVelCrossWVelCrossS),
+              dot(a3, wVelCrossWVelCrossS)); // centrigugal acceleration
 
   Real3 wAcc3 = omegaAccLRF_fsiBodies_D[rigidBodyIndex];
   Real3 wAccCrossS = cross(wAcc3, rigidSPH_MeshPos_LRF);
-  acc3 += dot(a1, wAccCrossS), dot(a2, wAccCrossS),
-      dot(a3, wAccCrossS); // tangential acceleration
+  acc3 += mR3(dot(a1, wAccCrossS), dot(a2, wAccCrossS),
+              dot(a3, wAccCrossS)); // tangential acceleration
 
   //	printf("linear acc %f %f %f point acc %f %f %f \n", accRigid3.x,
   //accRigid3.y, accRigid3.z, acc3.x, acc3.y,
@@ -230,8 +229,9 @@ __global__ void UpdateRigidMarkersPositionVelocityD(
   Real4 vM_Rigid = velMassRigidD[rigidBodyIndex];
   Real3 omega3 = omegaLRF_D[rigidBodyIndex];
   Real3 omegaCrossS = cross(omega3, rigidSPH_MeshPos_LRF);
-  velMasD[rigidMarkerIndex] = mR3(vM_Rigid) + dot(a1, omegaCrossS),
-  dot(a2, omegaCrossS), dot(a3, omegaCrossS);
+  velMasD[rigidMarkerIndex] =
+      mR3(vM_Rigid) + mR3(dot(a1, omegaCrossS), dot(a2, omegaCrossS),
+                          dot(a3, omegaCrossS));
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -0,0 +1,83 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Host replacements of the CUDA function qualifiers and vector types, used when
+// Chrono::FSI is built with the multicore CPU backend (no CUDA toolkit).
+//
+// =============================================================================
+
+#ifndef CHFSI_CUDA_COMPAT_H
+#define CHFSI_CUDA_COMPAT_H
+
+// ----------------------------------------------------------------------------
+// Function and variable qualifiers
+// ----------------------------------------------------------------------------
+
+#define __host__
+#define __device__
+#define __global__
+#define __shared__
+
+// As in a CUDA build without relocatable device code, each translation unit has
+// its own copy of a __constant__ variable (e.g. paramsD), which must be set in
+// that translation unit.
+#define __constant__ static
+
+#if defined(_MSC_VER)
+#define __inline__ __inline
+#endif
+
+// ----------------------------------------------------------------------------
+// Vector types
+// ----------------------------------------------------------------------------
+
+struct int2 {
+    int x, y;
+};
+struct int3 {
+    int x, y, z;
+};
+struct int4 {
+    int x, y, z, w;
+};
+
+struct uint2 {
+    unsigned int x, y;
+};
+struct uint3 {
+    unsigned int x, y, z;
+};
+struct uint4 {
+    unsigned int x, y, z, w;
+};
+
+struct float2 {
+    float x, y;
+};
+struct float3 {
+    float x, y, z;
+};
+struct float4 {
+    float x, y, z, w;
+};
+
+struct double2 {
+    double x, y;
+};
+struct double3 {
+    double x, y, z;
+};
+struct double4 {
+    double x, y, z, w;
+};
+
+#endif
@@ -22,6 +22,9 @@
 #include "chrono_fsi/custom_math.h"
 #include <thrust/device_vector.h>
 #include <thrust/host_vector.h>
+#ifndef CHRONO_FSI_USE_CUDA
+#include <chrono>
+#endif
 
 namespace chrono {
 namespace fsi {
@@ -88,6 +91,7 @@ typedef unsigned int uint;
 //
 // Legacy CUTIL macros. Currently default to no-ops (TODO)
 // ----------------------------------------------------------------------------
+#ifdef CHRONO_FSI_USE_CUDA
 #define cudaCheckError()                                                                     \
     {                                                                                        \
         cudaError_t e = cudaGetLastError();                                                  \
@@ -96,6 +100,11 @@ typedef unsigned int uint;
             exit(0);                                                                         \
         }                                                                                    \
     }
+#else
+#define cudaCheckError()
+#endif
+
+#ifdef CHRONO_FSI_USE_CUDA
 
 // --------------------------------------------------------------------
 // GpuTimer
@@ -131,6 +140,27 @@ class GpuTimer {
     cudaEvent_t m_stop;
 };
 
+#else
+
+// --------------------------------------------------------------------
+// GpuTimer
+//
+/// @brief A time recorder with the interface of the CUDA events timer, for the CPU backend.
+// --------------------------------------------------------------------
+class GpuTimer {
+  public:
+    void Start() { m_start = std::chrono::high_resolution_clock::now(); }
+    void Stop() { m_stop = std::chrono::high_resolution_clock::now(); }
+
+    float Elapsed() { return std::chrono::duration<float, std::milli>(m_stop - m_start).count(); }
+
+  private:
+    std::chrono::high_resolution_clock::time_point m_start;
+    std::chrono::high_resolution_clock::time_point m_stop;
+};
+
+#endif
+
 // --------------------------------------------------------------------
 // ChDeviceUtils
 //
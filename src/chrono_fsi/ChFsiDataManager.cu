@@ -15,6 +15,10 @@
 // Base class for managing data in chrono_fsi, aka fluid system.//
 // =============================================================================
 
+#include <cstdio>
+#include <iostream>
+#include <stdexcept>
+
 #include "chrono_fsi/ChDeviceUtils.cuh"
 #include "chrono_fsi/ChFsiDataManager.cuh"
 #include <thrust/sort.h>
@@ -117,6 +121,7 @@ FsiBodiesDataD &FsiBodiesDataD::operator=(const FsiBodiesDataD &other) {
   thrust::copy(other.omegaAccLRF_fsiBodies_D.begin(),
                other.omegaAccLRF_fsiBodies_D.end(),
                omegaAccLRF_fsiBodies_D.begin());
+  return *this;
 }
 
 //---------------------------------------------------------------------------------------
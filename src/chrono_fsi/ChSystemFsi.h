@@ -42,6 +42,21 @@ namespace fsi {
 /// systems, boundary condition enforcing markers, and data.
 class CH_FSI_API ChSystemFsi : public ChFsiGeneral {
   public:
+    /// Backend used for the SPH computations, selected when configuring Chrono::FSI.
+    enum Backend {
+        CUDA,  ///< NVIDIA GPU, data in device memory
+        CPU    ///< multicore CPU (OpenMP), data in host memory
+    };
+
+    /// Return the backend this library was built with.
+    static Backend GetBackend() {
+#ifdef CHRONO_FSI_USE_CUDA
+        return CUDA;
+#else
+        return CPU;
+#endif
+    }
+
     /// Constructor for FSI system.
     /// This class constructor instantiates all the member objects. Wherever relevant, the
     /// instantiation is handled by sending a pointer to other objects or data.
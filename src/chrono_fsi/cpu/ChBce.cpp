@@ -0,0 +1,375 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Multicore CPU implementation of the boundary condition enforcing (bce)
+// markers forces in fsi system. The forces and torques on the rigid bodies are
+// accumulated per body over the range of its BCE markers.
+// =============================================================================
+
+#include <cstdio>
+#include <stdexcept>
+
+#include "chrono_fsi/ChBce.cuh"
+#include "chrono_fsi/ChSphGeneral.cuh"
+
+namespace chrono {
+namespace fsi {
+
+//--------------------------------------------------------------------------------------------------------------------------------
+// Share of the fluid markers in a given cell in the ADAMI velocity and pressure of a BCE marker
+inline void BCE_modification_Share(Real3& sumVW,
+                                   Real& sumWAll,
+                                   Real3& sumRhoRW,
+                                   Real& sumPW,
+                                   Real& sumWFluid,
+                                   int& isAffectedV,
+                                   int& isAffectedP,
+                                   int3 gridPos,
+                                   Real3 posRadA,
+                                   const Real3* sortedPosRad,
+                                   const Real3* sortedVelMas,
+                                   const Real4* sortedRhoPreMu,
+                                   const uint* cellStart,
+                                   const uint* cellEnd) {
+    uint gridHash = calcGridHash(gridPos);
+    uint endIndex = cellEnd[gridHash];
+    for (uint j = cellStart[gridHash]; j < endIndex; j++) {
+        Real3 dist3 = Distance(posRadA, sortedPosRad[j]);
+        Real d = length(dist3);
+        Real4 rhoPresMuB = sortedRhoPreMu[j];
+        if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML || rhoPresMuB.w > -.1)
+            continue;
+
+        Real Wd = W3(d);
+        Real WdOvRho = Wd / rhoPresMuB.x;
+        isAffectedV = 1;
+        sumVW += sortedVelMas[j] * WdOvRho;
+        sumWAll += WdOvRho;
+
+        isAffectedP = 1;
+        sumRhoRW += rhoPresMuB.x * dist3 * WdOvRho;
+        sumPW += rhoPresMuB.y * WdOvRho;
+        sumWFluid += WdOvRho;
+    }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+ChBce::ChBce(SphMarkerDataD* otherSortedSphMarkersD,
+             ProximityDataD* otherMarkersProximityD,
+             FsiGeneralData* otherFsiGeneralData,
+             SimParams* otherParamsH,
+             NumberOfObjects* otherNumObjects)
+    : fsiGeneralData(otherFsiGeneralData),
+      sortedSphMarkersD(otherSortedSphMarkersD),
+      markersProximityD(otherMarkersProximityD),
+      paramsH(otherParamsH),
+      numObjectsH(otherNumObjects) {}
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChBce::Finalize(SphMarkerDataD* sphMarkersD, FsiBodiesDataD* fsiBodiesD) {
+    paramsD = *paramsH;
+    numObjectsD = *numObjectsH;
+
+    totalSurfaceInteractionRigid4.resize(numObjectsH->numRigidBodies);
+    dummyIdentify.resize(numObjectsH->numRigidBodies);
+    torqueMarkersD.resize(numObjectsH->numRigid_SphMarkers);
+
+    // Resizing the arrays used to modify the BCE velocity and pressure according to ADAMI
+    int numRigidAndBoundaryMarkers =
+        fsiGeneralData->referenceArray[2 + numObjectsH->numRigidBodies - 1].y - fsiGeneralData->referenceArray[0].y;
+    if ((numObjectsH->numBoundaryMarkers + numObjectsH->numRigid_SphMarkers) != numRigidAndBoundaryMarkers) {
+        throw std::runtime_error("Error! number of rigid and boundary markers are saved incorrectly!\n");
+    }
+    velMas_ModifiedBCE.resize(numRigidAndBoundaryMarkers);
+    rhoPreMu_ModifiedBCE.resize(numRigidAndBoundaryMarkers);
+
+    // Populate local position of BCE markers
+    Populate_RigidSPH_MeshPos_LRF(sphMarkersD, fsiBodiesD);
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+ChBce::~ChBce() {}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChBce::MakeRigidIdentifier() {
+    if (numObjectsH->numRigidBodies > 0) {
+        for (int rigidSphereA = 0; rigidSphereA < numObjectsH->numRigidBodies; rigidSphereA++) {
+            int4 referencePart = fsiGeneralData->referenceArray[2 + rigidSphereA];
+            if (referencePart.z != 1) {
+                throw std::runtime_error(
+                    "Error! in accessing rigid bodies. Reference array indexing is "
+                    "wrong\n");
+            }
+            int2 updatePortion = mI2(referencePart);
+            thrust::fill(fsiGeneralData->rigidIdentifierD.begin() + (updatePortion.x - numObjectsH->startRigidMarkers),
+                         fsiGeneralData->rigidIdentifierD.begin() + (updatePortion.y - numObjectsH->startRigidMarkers),
+                         rigidSphereA);
+        }
+    }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+
+void ChBce::Populate_RigidSPH_MeshPos_LRF(SphMarkerDataD* sphMarkersD, FsiBodiesDataD* fsiBodiesD) {
+    if (numObjectsH->numRigidBodies == 0) {
+        return;
+    }
+
+    MakeRigidIdentifier();
+
+    Real3* rigidSPH_MeshPos_LRF = mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D);
+    const Real3* posRadD = mR3CAST(sphMarkersD->posRadD);
+    const uint* rigidIdentifierD = U1CAST(fsiGeneralData->rigidIdentifierD);
+    const Real3* posRigidD = mR3CAST(fsiBodiesD->posRigid_fsiBodies_D);
+    const Real4* qD = mR4CAST(fsiBodiesD->q_fsiBodies_D);
+    int numRigid_SphMarkers = numObjectsH->numRigid_SphMarkers;
+    int startRigidMarkers = numObjectsH->startRigidMarkers;
+
+#pragma omp parallel for
+    for (int index = 0; index < numRigid_SphMarkers; index++) {
+        int rigidIndex = rigidIdentifierD[index];
+        Real3 a1, a2, a3;
+        RotationMatirixFromQuaternion(a1, a2, a3, qD[rigidIndex]);
+        Real3 dist3 = posRadD[index + startRigidMarkers] - posRigidD[rigidIndex];
+        rigidSPH_MeshPos_LRF[index] = InverseRotate_By_RotationMatrix_DeviceHost(a1, a2, a3, dist3);
+    }
+
+    UpdateRigidMarkersPositionVelocity(sphMarkersD, fsiBodiesD);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChBce::RecalcSortedVelocityPressure_BCE(thrust::device_vector<Real3>& velMas_ModifiedBCE,
+                                             thrust::device_vector<Real4>& rhoPreMu_ModifiedBCE,
+                                             const thrust::device_vector<Real3>& sortedPosRad,
+                                             const thrust::device_vector<Real3>& sortedVelMas,
+                                             const thrust::device_vector<Real4>& sortedRhoPreMu,
+                                             const thrust::device_vector<uint>& cellStart,
+                                             const thrust::device_vector<uint>& cellEnd,
+                                             const thrust::device_vector<uint>& mapOriginalToSorted,
+                                             const thrust::device_vector<Real3>& bceAcc,
+                                             int2 updatePortion) {
+    Real3* velMasBCE = mR3CAST(velMas_ModifiedBCE);
+    Real4* rhoPreMuBCE = mR4CAST(rhoPreMu_ModifiedBCE);
+    const Real3* posRad = mR3CAST(sortedPosRad);
+    const Real3* velMas = mR3CAST(sortedVelMas);
+    const Real4* rhoPreMu = mR4CAST(sortedRhoPreMu);
+    const uint* start = U1CAST(cellStart);
+    const uint* end = U1CAST(cellEnd);
+    const uint* originalToSorted = U1CAST(mapOriginalToSorted);
+    const Real3* acc = bceAcc.size() ? mR3CAST(bceAcc) : NULL;
+    int numBce = updatePortion.y - updatePortion.x;
+
+    bool isError = false;
+#pragma omp parallel for reduction(|| : isError)
+    for (int bceIndex = 0; bceIndex < numBce; bceIndex++) {
+        int sphIndex = bceIndex + updatePortion.x;
+        uint idA = originalToSorted[sphIndex];
+        Real4 rhoPreMuA = rhoPreMu[idA];
+        Real3 posRadA = posRad[idA];
+        Real3 velMasA = velMas[idA];
+        int isAffectedV = 0;
+        int isAffectedP = 0;
+
+        Real3 sumVW = mR3(0);
+        Real sumWAll = 0;
+        Real3 sumRhoRW = mR3(0);
+        Real sumPW = 0;
+        Real sumWFluid = 0;
+
+        int3 gridPos = calcGridPos(posRadA);
+        for (int z = -1; z <= 1; z++) {
+            for (int y = -1; y <= 1; y++) {
+                for (int x = -1; x <= 1; x++) {
+                    BCE_modification_Share(sumVW, sumWAll, sumRhoRW, sumPW, sumWFluid, isAffectedV, isAffectedP,
+                                           gridPos + mI3(x, y, z), posRadA, posRad, velMas, rhoPreMu, start, end);
+                }
+            }
+        }
+
+        if (isAffectedV) {
+            velMasBCE[bceIndex] = 2 * velMasA - sumVW / sumWAll;
+        }
+        if (isAffectedP) {
+            Real3 a3 = mR3(0);
+            if (fabs(rhoPreMuA.w) > 0) {  // rigid BCE
+                int rigidBceIndex = sphIndex - numObjectsD.startRigidMarkers;
+                if (rigidBceIndex < 0 || rigidBceIndex >= numObjectsD.numRigid_SphMarkers) {
+                    printf("Error! marker index out of bound: thrown from ChBce, RecalcSortedVelocityPressure_BCE !\n");
+                    isError = true;
+                    continue;
+                }
+                a3 = acc[rigidBceIndex];
+            }
+            Real pressure = (sumPW + dot(paramsD.gravity - a3, sumRhoRW)) / sumWFluid;
+            Real density = InvEos(pressure);
+            rhoPreMuBCE[bceIndex] = mR4(density, pressure, rhoPreMuA.z, rhoPreMuA.w);
+        }
+    }
+
+    if (isError) {
+        throw std::runtime_error("Error! program crashed in  RecalcSortedVelocityPressure_BCE!\n");
+    }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+// calculate marker acceleration, required in ADAMI
+void ChBce::CalcBceAcceleration(thrust::device_vector<Real3>& bceAcc,
+                                const thrust::device_vector<Real4>& q_fsiBodies_D,
+                                const thrust::device_vector<Real3>& accRigid_fsiBodies_D,
+                                const thrust::device_vector<Real3>& omegaVelLRF_fsiBodies_D,
+                                const thrust::device_vector<Real3>& omegaAccLRF_fsiBodies_D,
+                                const thrust::device_vector<Real3>& rigidSPH_MeshPos_LRF_D,
+                                const thrust::device_vector<uint>& rigidIdentifierD,
+                                int numRigid_SphMarkers) {
+    Real3* acc = mR3CAST(bceAcc);
+    const Real4* q = mR4CAST(q_fsiBodies_D);
+    const Real3* accRigid = mR3CAST(accRigid_fsiBodies_D);
+    const Real3* omegaVelLRF = mR3CAST(omegaVelLRF_fsiBodies_D);
+    const Real3* omegaAccLRF = mR3CAST(omegaAccLRF_fsiBodies_D);
+    const Real3* meshPos_LRF = mR3CAST(rigidSPH_MeshPos_LRF_D);
+    const uint* rigidIdentifier = U1CAST(rigidIdentifierD);
+
+#pragma omp parallel for
+    for (int bceIndex = 0; bceIndex < numRigid_SphMarkers; bceIndex++) {
+        int rigidBodyIndex = rigidIdentifier[bceIndex];
+        Real3 acc3 = accRigid[rigidBodyIndex];  // linear acceleration (CM)
+
+        Real3 a1, a2, a3;
+        RotationMatirixFromQuaternion(a1, a2, a3, q[rigidBodyIndex]);
+        Real3 wVel3 = omegaVelLRF[rigidBodyIndex];
+        Real3 rigidSPH_MeshPos_LRF = meshPos_LRF[bceIndex];
+        Real3 wVelCrossS = cross(wVel3, rigidSPH_MeshPos_LRF);
+        Real3 wVelCrossWVelCrossS = cross(wVel3, wVelCrossS);
+        acc3 += mR3(dot(a1, wVelCrossWVelCrossS), dot(a2, wVelCrossWVelCrossS),
+                    dot(a3, wVelCrossWVelCrossS));  // centrigugal acceleration
+
+        Real3 wAcc3 = omegaAccLRF[rigidBodyIndex];
+        Real3 wAccCrossS = cross(wAcc3, rigidSPH_MeshPos_LRF);
+        acc3 += mR3(dot(a1, wAccCrossS), dot(a2, wAccCrossS), dot(a3, wAccCrossS));  // tangential acceleration
+
+        acc[bceIndex] = acc3;
+    }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChBce::ModifyBceVelocity(SphMarkerDataD* sphMarkersD, FsiBodiesDataD* fsiBodiesD) {
+    // modify BCE velocity and pressure
+    int numRigidAndBoundaryMarkers =
+        fsiGeneralData->referenceArray[2 + numObjectsH->numRigidBodies - 1].y - fsiGeneralData->referenceArray[0].y;
+    if ((numObjectsH->numBoundaryMarkers + numObjectsH->numRigid_SphMarkers) != numRigidAndBoundaryMarkers) {
+        throw std::runtime_error(
+            "Error! number of rigid and boundary markers are "
+            "saved incorrectly. Thrown from "
+            "ModifyBceVelocity!\n");
+    }
+    if (!(velMas_ModifiedBCE.size() == numRigidAndBoundaryMarkers &&
+          rhoPreMu_ModifiedBCE.size() == numRigidAndBoundaryMarkers)) {
+        throw std::runtime_error(
+            "Error! size error velMas_ModifiedBCE and "
+            "rhoPreMu_ModifiedBCE. Thrown from "
+            "ModifyBceVelocity!\n");
+    }
+    int2 updatePortion =
+        mI2(fsiGeneralData->referenceArray[0].y, fsiGeneralData->referenceArray[2 + numObjectsH->numRigidBodies - 1].y);
+    if (paramsH->bceType == ADAMI) {
+        thrust::device_vector<Real3> bceAcc(numObjectsH->numRigid_SphMarkers);
+        if (numObjectsH->numRigid_SphMarkers > 0) {
+            CalcBceAcceleration(bceAcc, fsiBodiesD->q_fsiBodies_D, fsiBodiesD->accRigid_fsiBodies_D,
+                                fsiBodiesD->omegaVelLRF_fsiBodies_D, fsiBodiesD->omegaAccLRF_fsiBodies_D,
+                                fsiGeneralData->rigidSPH_MeshPos_LRF_D, fsiGeneralData->rigidIdentifierD,
+                                numObjectsH->numRigid_SphMarkers);
+        }
+        RecalcSortedVelocityPressure_BCE(velMas_ModifiedBCE, rhoPreMu_ModifiedBCE, sortedSphMarkersD->posRadD,
+                                         sortedSphMarkersD->velMasD, sortedSphMarkersD->rhoPresMuD,
+                                         markersProximityD->cellStartD, markersProximityD->cellEndD,
+                                         markersProximityD->mapOriginalToSorted, bceAcc, updatePortion);
+    } else {
+        thrust::copy(sphMarkersD->velMasD.begin() + updatePortion.x, sphMarkersD->velMasD.begin() + updatePortion.y,
+                     velMas_ModifiedBCE.begin());
+        thrust::copy(sphMarkersD->rhoPresMuD.begin() + updatePortion.x,
+                     sphMarkersD->rhoPresMuD.begin() + updatePortion.y, rhoPreMu_ModifiedBCE.begin());
+    }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+// Accumulates the forces and torques of the BCE markers of each rigid body. The markers of a body are contiguous (see
+// the reference array), so each body is processed independently, without the reduce_by_key of the CUDA backend.
+void ChBce::Rigid_Forces_Torques(SphMarkerDataD* sphMarkersD, FsiBodiesDataD* fsiBodiesD) {
+    if (numObjectsH->numRigidBodies == 0) {
+        return;
+    }
+    if (totalSurfaceInteractionRigid4.size() != numObjectsH->numRigidBodies ||
+        dummyIdentify.size() != numObjectsH->numRigidBodies ||
+        torqueMarkersD.size() != numObjectsH->numRigid_SphMarkers) {
+        throw std::runtime_error(
+            "Error! wrong size: totalSurfaceInteractionRigid4 "
+            "or torqueMarkersD or dummyIdentify. Thrown from "
+            "Rigid_Forces_Torques!\n");
+    }
+
+    Real4* totalSurfaceInteraction = mR4CAST(totalSurfaceInteractionRigid4);
+    Real3* rigid_FSI_Forces = mR3CAST(fsiGeneralData->rigid_FSI_ForcesD);
+    Real3* rigid_FSI_Torques = mR3CAST(fsiGeneralData->rigid_FSI_TorquesD);
+    const Real4* derivVelRho = mR4CAST(fsiGeneralData->derivVelRhoD);
+    const Real3* posRad = mR3CAST(sphMarkersD->posRadD);
+    const Real3* posRigid = mR3CAST(fsiBodiesD->posRigid_fsiBodies_D);
+    int numRigidBodies = numObjectsH->numRigidBodies;
+
+#pragma omp parallel for
+    for (int rigidIndex = 0; rigidIndex < numRigidBodies; rigidIndex++) {
+        int4 referencePart = fsiGeneralData->referenceArray[2 + rigidIndex];
+        Real4 sumDerivVelRho = mR4(0);
+        Real3 sumTorque = mR3(0);
+        for (int marker = referencePart.x; marker < referencePart.y; marker++) {
+            sumDerivVelRho += derivVelRho[marker];
+            // paramsD.markerMass is multiplied to convert from SPH acceleration to force
+            sumTorque += paramsD.markerMass *
+                         cross(Distance(posRad[marker], posRigid[rigidIndex]), mR3(derivVelRho[marker]));
+        }
+        totalSurfaceInteraction[rigidIndex] = sumDerivVelRho;
+        rigid_FSI_Forces[rigidIndex] = paramsD.markerMass * mR3(sumDerivVelRho);
+        rigid_FSI_Torques[rigidIndex] = sumTorque;
+    }
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChBce::UpdateRigidMarkersPositionVelocity(SphMarkerDataD* sphMarkersD, FsiBodiesDataD* fsiBodiesD) {
+    if (numObjectsH->numRigidBodies == 0) {
+        return;
+    }
+
+    Real3* posRadD = mR3CAST(sphMarkersD->posRadD);
+    Real3* velMasD = mR3CAST(sphMarkersD->velMasD);
+    const Real3* rigidSPH_MeshPos_LRF_D = mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D);
+    const uint* rigidIdentifierD = U1CAST(fsiGeneralData->rigidIdentifierD);
+    const Real3* posRigidD = mR3CAST(fsiBodiesD->posRigid_fsiBodies_D);
+    const Real4* velMassRigidD = mR4CAST(fsiBodiesD->velMassRigid_fsiBodies_D);
+    const Real3* omegaLRF_D = mR3CAST(fsiBodiesD->omegaVelLRF_fsiBodies_D);
+    const Real4* qD = mR4CAST(fsiBodiesD->q_fsiBodies_D);
+    int numRigid_SphMarkers = numObjectsH->numRigid_SphMarkers;
+    int startRigidMarkers = numObjectsH->startRigidMarkers;
+
+#pragma omp parallel for
+    for (int index = 0; index < numRigid_SphMarkers; index++) {
+        uint rigidMarkerIndex = index + startRigidMarkers;
+        int rigidBodyIndex = rigidIdentifierD[index];
+
+        Real3 a1, a2, a3;
+        RotationMatirixFromQuaternion(a1, a2, a3, qD[rigidBodyIndex]);
+        Real3 rigidSPH_MeshPos_LRF = rigidSPH_MeshPos_LRF_D[index];
+
+        // position
+        posRadD[rigidMarkerIndex] =
+            posRigidD[rigidBodyIndex] +
+            mR3(dot(a1, rigidSPH_MeshPos_LRF), dot(a2, rigidSPH_MeshPos_LRF), dot(a3, rigidSPH_MeshPos_LRF));
+
+        // velocity
+        Real3 omegaCrossS = cross(omegaLRF_D[rigidBodyIndex], rigidSPH_MeshPos_LRF);
+        velMasD[rigidMarkerIndex] = mR3(velMassRigidD[rigidBodyIndex]) +
+                                    mR3(dot(a1, omegaCrossS), dot(a2, omegaCrossS), dot(a3, omegaCrossS));
+    }
+}
+
+}  // end namespace fsi
+}  // end namespace chrono
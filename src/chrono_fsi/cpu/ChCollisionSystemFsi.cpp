@@ -0,0 +1,191 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Multicore CPU implementation of the proximity computation in fsi system.
+// The markers are binned in a cell list built with a counting sort (stable, so
+// that the sorted arrays are the same as with the CUDA backend).
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+#include "chrono_fsi/ChCollisionSystemFsi.cuh"
+#include "chrono_fsi/ChDeviceUtils.cuh"
+#include "chrono_fsi/ChSphGeneral.cuh"
+
+namespace chrono {
+namespace fsi {
+
+//--------------------------------------------------------------------------------------------------------------------------------
+
+ChCollisionSystemFsi::ChCollisionSystemFsi(SphMarkerDataD* otherSortedSphMarkersD,
+                                           ProximityDataD* otherMarkersProximityD,
+                                           SimParams* otherParamsH,
+                                           NumberOfObjects* otherNumObjects)
+    : sortedSphMarkersD(otherSortedSphMarkersD),
+      markersProximityD(otherMarkersProximityD),
+      paramsH(otherParamsH),
+      numObjectsH(otherNumObjects) {
+    sphMarkersD = NULL;
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+void ChCollisionSystemFsi::Finalize() {
+    paramsD = *paramsH;
+    numObjectsD = *numObjectsH;
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+
+ChCollisionSystemFsi::~ChCollisionSystemFsi() {}
+//--------------------------------------------------------------------------------------------------------------------------------
+
+/// Compute the cell hash of each marker (in the original order) and check that the markers are inside the domain.
+void ChCollisionSystemFsi::calcHash() {
+    if (!(markersProximityD->gridMarkerHashD.size() == numObjectsH->numAllMarkers &&
+          markersProximityD->gridMarkerIndexD.size() == numObjectsH->numAllMarkers)) {
+        printf(
+            "mError! calcHash!, gridMarkerHashD.size() %d "
+            "gridMarkerIndexD.size() %d numObjectsH->numAllMarkers %d \n",
+            (int)markersProximityD->gridMarkerHashD.size(), (int)markersProximityD->gridMarkerIndexD.size(),
+            numObjectsH->numAllMarkers);
+        throw std::runtime_error("Error! size error, calcHash!");
+    }
+
+    uint* gridMarkerHash = U1CAST(markersProximityD->gridMarkerHashD);
+    const Real3* posRad = mR3CAST(sphMarkersD->posRadD);
+    const Real3 boxMin = paramsD.worldOrigin;
+    const Real3 boxMax = paramsD.worldOrigin + paramsD.boxDims;
+    int numAllMarkers = numObjectsH->numAllMarkers;
+
+    bool isError = false;
+#pragma omp parallel for reduction(|| : isError)
+    for (int index = 0; index < numAllMarkers; index++) {
+        Real3 p = posRad[index];
+        if (!(std::isfinite(p.x) && std::isfinite(p.y) && std::isfinite(p.z))) {
+            printf("Error! particle position is NAN: thrown from ChCollisionSystemFsi, calcHash !\n");
+            isError = true;
+            continue;
+        }
+        if (p.x < boxMin.x || p.y < boxMin.y || p.z < boxMin.z) {
+            printf(
+                "Out of Min Boundary, point %f %f %f, boundary min: %f %f %f. "
+                "Thrown from ChCollisionSystemFsi, calcHash !\n",
+                p.x, p.y, p.z, boxMin.x, boxMin.y, boxMin.z);
+            isError = true;
+            continue;
+        }
+        if (p.x > boxMax.x || p.y > boxMax.y || p.z > boxMax.z) {
+            printf(
+                "Out of max Boundary, point %f %f %f, boundary max: %f %f %f. "
+                "Thrown from ChCollisionSystemFsi, calcHash !\n",
+                p.x, p.y, p.z, boxMax.x, boxMax.y, boxMax.z);
+            isError = true;
+            continue;
+        }
+        gridMarkerHash[index] = calcGridHash(calcGridPos(p));
+    }
+
+    if (isError) {
+        throw std::runtime_error("Error! program crashed in  calcHash!\n");
+    }
+}
+
+void ChCollisionSystemFsi::ResetCellSize(int s) {
+    markersProximityD->cellStartD.resize(s);
+    markersProximityD->cellEndD.resize(s);
+}
+
+/// Sort the markers by cell with a counting sort, find the start and end of each cell, and copy the marker data in
+/// the sorted order. On output gridMarkerHashD and gridMarkerIndexD are sorted, as after thrust::sort_by_key.
+void ChCollisionSystemFsi::reorderDataAndFindCellStart() {
+    int3 cellsDim = paramsH->gridSize;
+    int numCells = cellsDim.x * cellsDim.y * cellsDim.z;
+    if (!(markersProximityD->cellStartD.size() == numCells && markersProximityD->cellEndD.size() == numCells)) {
+        throw std::runtime_error("Error! size error, reorderDataAndFindCellStart!\n");
+    }
+
+    uint* cellStart = U1CAST(markersProximityD->cellStartD);
+    uint* cellEnd = U1CAST(markersProximityD->cellEndD);
+    uint* gridMarkerHash = U1CAST(markersProximityD->gridMarkerHashD);
+    uint* gridMarkerIndex = U1CAST(markersProximityD->gridMarkerIndexD);
+    uint* mapOriginalToSorted = U1CAST(markersProximityD->mapOriginalToSorted);
+    int numAllMarkers = numObjectsH->numAllMarkers;
+
+    // Number of markers in each cell
+    thrust::fill(markersProximityD->cellEndD.begin(), markersProximityD->cellEndD.end(), 0);
+    for (int index = 0; index < numAllMarkers; index++)
+        cellEnd[gridMarkerHash[index]]++;
+
+    // Start of each cell. cellEnd is then used as the insertion point in each cell.
+    uint offset = 0;
+    for (int cell = 0; cell < numCells; cell++) {
+        uint count = cellEnd[cell];
+        cellStart[cell] = offset;
+        cellEnd[cell] = offset;
+        offset += count;
+    }
+
+    // Stable scatter of the marker indices; on exit cellEnd holds the end of each cell
+    for (int index = 0; index < numAllMarkers; index++)
+        gridMarkerIndex[cellEnd[gridMarkerHash[index]]++] = index;
+
+#pragma omp parallel for
+    for (int cell = 0; cell < numCells; cell++) {
+        for (uint j = cellStart[cell]; j < cellEnd[cell]; j++)
+            gridMarkerHash[j] = cell;
+    }
+
+    // Reorder the marker data
+    Real3* sortedPosRad = mR3CAST(sortedSphMarkersD->posRadD);
+    Real3* sortedVelMas = mR3CAST(sortedSphMarkersD->velMasD);
+    Real4* sortedRhoPreMu = mR4CAST(sortedSphMarkersD->rhoPresMuD);
+    const Real3* posRad = mR3CAST(sphMarkersD->posRadD);
+    const Real3* velMas = mR3CAST(sphMarkersD->velMasD);
+    const Real4* rhoPresMu = mR4CAST(sphMarkersD->rhoPresMuD);
+
+#pragma omp parallel for
+    for (int index = 0; index < numAllMarkers; index++) {
+        uint originalIndex = gridMarkerIndex[index];
+        mapOriginalToSorted[originalIndex] = index;
+
+        Real3 posRadA = posRad[originalIndex];
+        Real3 velMasA = velMas[originalIndex];
+        Real4 rhoPreMuA = rhoPresMu[originalIndex];
+
+        if (!(std::isfinite(posRadA.x) && std::isfinite(posRadA.y) && std::isfinite(posRadA.z))) {
+            printf("Error! particle position is NAN: thrown from ChCollisionSystemFsi, reorderDataAndFindCellStart !\n");
+        }
+        if (!(std::isfinite(velMasA.x) && std::isfinite(velMasA.y) && std::isfinite(velMasA.z))) {
+            printf("Error! particle velocity is NAN: thrown from ChCollisionSystemFsi, reorderDataAndFindCellStart !\n");
+        }
+        if (!(std::isfinite(rhoPreMuA.x) && std::isfinite(rhoPreMuA.y) && std::isfinite(rhoPreMuA.z) &&
+              std::isfinite(rhoPreMuA.w))) {
+            printf("Error! particle rhoPreMu is NAN: thrown from ChCollisionSystemFsi, reorderDataAndFindCellStart !\n");
+        }
+        sortedPosRad[index] = posRadA;
+        sortedVelMas[index] = velMasA;
+        sortedRhoPreMu[index] = rhoPreMuA;
+    }
+}
+
+void ChCollisionSystemFsi::ArrangeData(SphMarkerDataD* otherSphMarkersD) {
+    sphMarkersD = otherSphMarkersD;
+    int3 cellsDim = paramsH->gridSize;
+    int numCells = cellsDim.x * cellsDim.y * cellsDim.z;
+    ResetCellSize(numCells);
+    calcHash();
+    reorderDataAndFindCellStart();
+}
+
+}  // end namespace fsi
+}  // end namespace chrono
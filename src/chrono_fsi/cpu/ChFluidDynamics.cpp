@@ -0,0 +1,270 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Multicore CPU implementation of the time integration in fluid system.
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+#include "chrono_fsi/ChDeviceUtils.cuh"
+#include "chrono_fsi/ChFluidDynamics.cuh"
+#include "chrono_fsi/ChSphGeneral.cuh"
+
+namespace chrono {
+namespace fsi {
+
+// -----------------------------------------------------------------------------
+/// Share of density influence on a given marker from all other markers in a given cell
+inline void collideCellDensityReInit(Real& densityShare,
+                                     Real& denominator,
+                                     int3 gridPos,
+                                     uint index,
+                                     Real3 posRadA,
+                                     const Real3* sortedPosRad,
+                                     const Real4* sortedRhoPreMu,
+                                     const uint* cellStart,
+                                     const uint* cellEnd) {
+    uint gridHash = calcGridHash(gridPos);
+    uint endIndex = cellEnd[gridHash];
+    for (uint j = cellStart[gridHash]; j < endIndex; j++) {
+        if (j == index)
+            continue;
+        Real3 dist3 = Distance(posRadA, sortedPosRad[j]);
+        Real d = length(dist3);
+        if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML)
+            continue;
+        Real partialDensity = paramsD.markerMass * W3(d);
+        densityShare += partialDensity;
+        denominator += partialDensity / sortedRhoPreMu[j].x;
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// Apply the periodic BC along one direction to a marker.
+/// The pressure of the fluid markers is modified by the pressure jump of the periodic BC.
+inline void ApplyPeriodicBoundary(Real& pos, Real& pressure, bool isFluid, Real cMin, Real cMax, Real deltaPress) {
+    if (pos > cMax) {
+        pos -= (cMax - cMin);
+        if (isFluid)
+            pressure += deltaPress;
+    } else if (pos < cMin) {
+        pos += (cMax - cMin);
+        if (isFluid)
+            pressure -= deltaPress;
+    }
+}
+
+// -----------------------------------------------------------------------------
+// CLASS FOR FLUID DYNAMICS SYSTEM
+// -----------------------------------------------------------------------------
+
+ChFluidDynamics::ChFluidDynamics(ChBce* otherBceWorker,
+                                 ChFsiDataManager* otherFsiData,
+                                 SimParams* otherParamsH,
+                                 NumberOfObjects* otherNumObjects)
+    : fsiData(otherFsiData), paramsH(otherParamsH), numObjectsH(otherNumObjects) {
+    forceSystem = new ChFsiForceParallel(otherBceWorker, &(fsiData->sortedSphMarkersD), &(fsiData->markersProximityD),
+                                         &(fsiData->fsiGeneralData), paramsH, numObjectsH);
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamics::Finalize() {
+    paramsD = *paramsH;
+    numObjectsD = *numObjectsH;
+    forceSystem->Finalize();
+}
+
+// -----------------------------------------------------------------------------
+
+ChFluidDynamics::~ChFluidDynamics() {
+    delete forceSystem;
+}
+
+// -----------------------------------------------------------------------------
+
+void ChFluidDynamics::IntegrateSPH(SphMarkerDataD* sphMarkersD2,
+                                   SphMarkerDataD* sphMarkersD1,
+                                   FsiBodiesDataD* fsiBodiesD1,
+                                   Real dT) {
+    forceSystem->ForceSPH(sphMarkersD1, fsiBodiesD1);
+    this->UpdateFluid(sphMarkersD2, dT);
+    this->ApplyBoundarySPH_Markers(sphMarkersD2);
+}
+
+// -----------------------------------------------------------------------------
+/// Update the density, velocity and position of the markers with an explicit Euler scheme.
+/// Pressure is obtained from the density and an Equation of State.
+void ChFluidDynamics::UpdateFluid(SphMarkerDataD* sphMarkersD, Real dT) {
+    int2 updatePortion =
+        mI2(0, fsiData->fsiGeneralData.referenceArray[fsiData->fsiGeneralData.referenceArray.size() - 1].y);
+
+    Real3* posRadD = mR3CAST(sphMarkersD->posRadD);
+    Real3* velMasD = mR3CAST(sphMarkersD->velMasD);
+    Real4* rhoPresMuD = mR4CAST(sphMarkersD->rhoPresMuD);
+    const Real3* vel_XSPH_D = mR3CAST(fsiData->fsiGeneralData.vel_XSPH_D);
+    const Real4* derivVelRhoD = mR4CAST(fsiData->fsiGeneralData.derivVelRhoD);
+    const Real maxVel = paramsD.tweakMultV * paramsD.HSML / paramsD.dT;
+    const Real maxDerivRho = paramsD.tweakMultRho * paramsD.rho0 / paramsD.dT;
+
+    bool isError = false;
+#pragma omp parallel for reduction(|| : isError)
+    for (int index = updatePortion.x; index < updatePortion.y; index++) {
+        Real4 derivVelRho = derivVelRhoD[index];
+        Real4 rhoPresMu = rhoPresMuD[index];
+
+        if (rhoPresMu.w < 0) {
+            // position
+            Real3 vel_XSPH = vel_XSPH_D[index];
+            if (!(std::isfinite(vel_XSPH.x) && std::isfinite(vel_XSPH.y) && std::isfinite(vel_XSPH.z))) {
+                if (paramsD.enableAggressiveTweak) {
+                    vel_XSPH = mR3(0);
+                } else {
+                    printf("Error! particle vel_XSPH is NAN: thrown from ChFluidDynamics, UpdateFluid !\n");
+                    isError = true;
+                    continue;
+                }
+            }
+            if (length(vel_XSPH) > maxVel && paramsD.enableTweak) {
+                vel_XSPH *= maxVel / length(vel_XSPH);
+            }
+            Real3 updatedPositon = posRadD[index] + vel_XSPH * dT;
+            if (!(std::isfinite(updatedPositon.x) && std::isfinite(updatedPositon.y) &&
+                  std::isfinite(updatedPositon.z))) {
+                printf("Error! particle position is NAN: thrown from ChFluidDynamics, UpdateFluid !\n");
+                isError = true;
+                continue;
+            }
+            posRadD[index] = updatedPositon;
+
+            // velocity
+            Real3 updatedVelocity = velMasD[index] + mR3(derivVelRho) * dT;
+            if (!(std::isfinite(updatedVelocity.x) && std::isfinite(updatedVelocity.y) &&
+                  std::isfinite(updatedVelocity.z))) {
+                if (paramsD.enableAggressiveTweak) {
+                    updatedVelocity = mR3(0);
+                } else {
+                    printf("Error! particle updatedVelocity is NAN: thrown from ChFluidDynamics, UpdateFluid !\n");
+                    isError = true;
+                    continue;
+                }
+            }
+            if (length(updatedVelocity) > maxVel && paramsD.enableTweak) {
+                updatedVelocity *= maxVel / length(updatedVelocity);
+            }
+            velMasD[index] = updatedVelocity;
+        }
+
+        // density and pressure
+        if (!(std::isfinite(derivVelRho.w))) {
+            if (paramsD.enableAggressiveTweak) {
+                derivVelRho.w = 0;
+            } else {
+                printf("Error! particle derivVelRho.w is NAN: thrown from ChFluidDynamics, UpdateFluid !\n");
+                isError = true;
+                continue;
+            }
+        }
+        if (fabs(derivVelRho.w) > maxDerivRho && paramsD.enableTweak) {
+            derivVelRho.w *= maxDerivRho / fabs(derivVelRho.w);  // to take care of the sign as well
+        }
+        Real rho2 = rhoPresMu.x + derivVelRho.w * dT;
+        rhoPresMu.y = Eos(rho2, rhoPresMu.w);
+        rhoPresMu.x = rho2;
+        if (!(std::isfinite(rhoPresMu.x) && std::isfinite(rhoPresMu.y) && std::isfinite(rhoPresMu.z) &&
+              std::isfinite(rhoPresMu.w))) {
+            printf("Error! particle rho pressure is NAN: thrown from ChFluidDynamics, UpdateFluid !\n");
+            isError = true;
+            continue;
+        }
+        rhoPresMuD[index] = rhoPresMu;
+    }
+
+    if (isError) {
+        throw std::runtime_error("Error! program crashed in  UpdateFluid!\n");
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// Apply the periodic BC along x, y, and z to the fluid and rigid BCE markers.
+/// The boundary markers are not moved.
+void ChFluidDynamics::ApplyBoundarySPH_Markers(SphMarkerDataD* sphMarkersD) {
+    Real3* posRadD = mR3CAST(sphMarkersD->posRadD);
+    Real4* rhoPresMuD = mR4CAST(sphMarkersD->rhoPresMuD);
+    const Real3 cMin = paramsD.cMin;
+    const Real3 cMax = paramsD.cMax;
+    const Real3 deltaPress = paramsD.deltaPress;
+    int numAllMarkers = numObjectsH->numAllMarkers;
+
+#pragma omp parallel for
+    for (int index = 0; index < numAllMarkers; index++) {
+        Real4 rhoPresMu = rhoPresMuD[index];
+        if (fabs(rhoPresMu.w) < .1)
+            continue;  // no need to do anything if it is a boundary particle
+        bool isFluid = rhoPresMu.w < -.1;
+        Real3 posRad = posRadD[index];
+        ApplyPeriodicBoundary(posRad.x, rhoPresMu.y, isFluid, cMin.x, cMax.x, deltaPress.x);
+        ApplyPeriodicBoundary(posRad.y, rhoPresMu.y, isFluid, cMin.y, cMax.y, deltaPress.y);
+        ApplyPeriodicBoundary(posRad.z, rhoPresMu.y, isFluid, cMin.z, cMax.z, deltaPress.z);
+        posRadD[index] = posRad;
+        rhoPresMuD[index] = rhoPresMu;
+    }
+}
+
+// -----------------------------------------------------------------------------
+/// Shepard filtering of the density of the fluid markers, including the normalization close to the boundaries and
+/// free surface.
+void ChFluidDynamics::DensityReinitialization() {
+    thrust::device_vector<Real4> dummySortedRhoPreMu = fsiData->sortedSphMarkersD.rhoPresMuD;
+
+    Real4* newRhoPreMu = mR4CAST(dummySortedRhoPreMu);
+    const Real3* sortedPosRad = mR3CAST(fsiData->sortedSphMarkersD.posRadD);
+    const Real4* sortedRhoPreMu = mR4CAST(fsiData->sortedSphMarkersD.rhoPresMuD);
+    const uint* cellStart = U1CAST(fsiData->markersProximityD.cellStartD);
+    const uint* cellEnd = U1CAST(fsiData->markersProximityD.cellEndD);
+    int numAllMarkers = numObjectsH->numAllMarkers;
+
+#pragma omp parallel for
+    for (int index = 0; index < numAllMarkers; index++) {
+        Real4 rhoPreMuA = sortedRhoPreMu[index];
+        if (rhoPreMuA.w > -.1)
+            continue;
+
+        Real3 posRadA = sortedPosRad[index];
+        int3 gridPos = calcGridPos(posRadA);
+        Real densityShare = 0.0f;
+        Real denominator = 0.0f;
+        for (int z = -1; z <= 1; z++) {
+            for (int y = -1; y <= 1; y++) {
+                for (int x = -1; x <= 1; x++) {
+                    collideCellDensityReInit(densityShare, denominator, gridPos + mI3(x, y, z), index, posRadA,
+                                             sortedPosRad, sortedRhoPreMu, cellStart, cellEnd);
+                }
+            }
+        }
+
+        // include the marker in its own summation as well
+        Real newDensity = densityShare + paramsD.markerMass * W3(0);
+        Real newDenominator = denominator + paramsD.markerMass * W3(0) / rhoPreMuA.x;
+        rhoPreMuA.x = newDensity / newDenominator;
+        rhoPreMuA.y = Eos(rhoPreMuA.x, rhoPreMuA.w);
+        newRhoPreMu[index] = rhoPreMuA;
+    }
+
+    ChFsiForceParallel::CopySortedToOriginal_Invasive_R4(fsiData->sphMarkersD1.rhoPresMuD, dummySortedRhoPreMu,
+                                                         fsiData->markersProximityD.gridMarkerIndexD);
+}
+
+}  // end namespace fsi
+}  // end namespace chrono
@@ -20,8 +20,12 @@
 #ifndef CHFSI_CUSTOM_MATH_H
 #define CHFSI_CUSTOM_MATH_H
 
-#include <cuda_runtime.h>  // for __host__ __device__ flags
 #include "chrono_fsi/ChConfigFSI.h"
+#ifdef CHRONO_FSI_USE_CUDA
+#include <cuda_runtime.h>  // for __host__ __device__ flags
+#else
+#include "chrono_fsi/ChCudaCompat.h"
+#endif
 #ifndef __CUDACC__
 #include <cmath>
 #endif
@@ -14,6 +14,7 @@
 //
 // Utility class for generating fluid markers.//
 // =============================================================================
+#include <iostream> // std::cout
 #include <fstream> // std::ifstream
 #include <sstream> // std::stringstream
 
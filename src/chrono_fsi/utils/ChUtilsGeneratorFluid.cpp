@@ -15,6 +15,8 @@
 // Utility class for generating fluid markers.//
 // =============================================================================
 
+#include <cstdio>
+
 #include "chrono_fsi/utils/ChUtilsGeneratorFluid.h"
 #include "chrono_fsi/ChDeviceUtils.cuh"
 
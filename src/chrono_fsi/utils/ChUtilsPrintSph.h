@@ -16,6 +16,8 @@
 // =============================================================================
 #ifndef CHUTILSPRINTSPH_H
 #define CHUTILSPRINTSPH_H
+#include <string>
+
 #include "chrono_fsi/ChApiFsi.h"
 #include "chrono_fsi/custom_math.h"
 #include <thrust/device_vector.h>
@@ -307,6 +307,15 @@ bool ChIrrAppEventReceiver::OnEvent(const irr::SEvent& event) {
                             app->GetSystem()->SetTimestepperType(ChTimestepper::Type::NEWMARK);
                             break;
                         case 11:
+                            app->GetSystem()->SetTimestepperType(ChTimestepper::Type::CENTRAL_DIFFERENCE);
+                            break;
+                        case 12:
+                            app->GetSystem()->SetTimestepperType(ChTimestepper::Type::DORMAND_PRINCE);
+                            break;
+                        case 13:
+                            app->GetSystem()->SetTimestepperType(ChTimestepper::Type::RUNGE_KUTTA_NYSTROM);
+                            break;
+                        case 14:
                             GetLog() << "WARNING.\nYou cannot change to a custom timestepper using the GUI. Use C++ "
                                         "instead.\n";
                             break;
@@ -539,6 +548,9 @@ ChIrrAppInterface::ChIrrAppInterface(ChSystem* psystem,
     gad_stepper->addItem(L"Euler explicit");
     gad_stepper->addItem(L"Leapfrog");
     gad_stepper->addItem(L"Newmark");
+    gad_stepper->addItem(L"Central difference");
+    gad_stepper->addItem(L"Dormand-Prince adaptive");
+    gad_stepper->addItem(L"Runge-Kutta-Nystrom adaptive");
     gad_stepper->addItem(L"(custom)");
 
     gad_stepper->setSelected(0);
@@ -959,9 +971,18 @@ void ChIrrAppInterface::DrawAll() {
             case ChTimestepper::Type::NEWMARK:
                 gad_stepper->setSelected(10);
                 break;
-            default:
+            case ChTimestepper::Type::CENTRAL_DIFFERENCE:
                 gad_stepper->setSelected(11);
                 break;
+            case ChTimestepper::Type::DORMAND_PRINCE:
+                gad_stepper->setSelected(12);
+                break;
+            case ChTimestepper::Type::RUNGE_KUTTA_NYSTROM:
+                gad_stepper->setSelected(13);
+                break;
+            default:
+                gad_stepper->setSelected(14);
+                break;
         }
 
         gad_try_realtime->setChecked(GetTryRealtime());
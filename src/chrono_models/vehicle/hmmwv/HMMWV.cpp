@@ -41,6 +41,7 @@ HMMWV::HMMWV()
       m_tireType(TireModelType::RIGID),
       m_vehicle_step_size(-1),
       m_tire_step_size(-1),
+      m_tire_substeps(1),
       m_initFwdVel(0),
       m_initPos(ChCoordsys<>(ChVector<>(0, 0, 1), QUNIT)),
       m_initOmega({0, 0, 0, 0}),
@@ -59,6 +60,7 @@ HMMWV::HMMWV(ChSystem* system)
       m_tireType(TireModelType::RIGID),
       m_vehicle_step_size(-1),
       m_tire_step_size(-1),
+      m_tire_substeps(1),
       m_initFwdVel(0),
       m_initPos(ChCoordsys<>(ChVector<>(0, 0, 1), QUNIT)),
       m_initOmega({0, 0, 0, 0}),
@@ -257,6 +259,11 @@ void HMMWV::Initialize() {
         m_tires[3]->SetStepsize(m_tire_step_size);
     }
 
+    m_tires[0]->SetNumSubsteps(m_tire_substeps);
+    m_tires[1]->SetNumSubsteps(m_tire_substeps);
+    m_tires[2]->SetNumSubsteps(m_tire_substeps);
+    m_tires[3]->SetNumSubsteps(m_tire_substeps);
+
     m_tire_mass = m_tires[0]->ReportMass();
 }
 
@@ -277,25 +284,39 @@ void HMMWV::Synchronize(double time,
     TerrainForces tire_forces(4);
     WheelState wheel_states[4];
 
-    tire_forces[0] = m_tires[0]->GetTireForce();
-    tire_forces[1] = m_tires[1]->GetTireForce();
-    tire_forces[2] = m_tires[2]->GetTireForce();
-    tire_forces[3] = m_tires[3]->GetTireForce();
-
     wheel_states[0] = m_vehicle->GetWheelState(FRONT_LEFT);
     wheel_states[1] = m_vehicle->GetWheelState(FRONT_RIGHT);
     wheel_states[2] = m_vehicle->GetWheelState(REAR_LEFT);
     wheel_states[3] = m_vehicle->GetWheelState(REAR_RIGHT);
 
+    if (m_tire_substeps > 1) {
+        // Multi-rate: sub-cycle the tire models over the upcoming vehicle step and
+        // apply the averaged tire forces during that step.
+        // The wheel spin is integrated by the tires with the driveline and brake
+        // torques from the beginning of the step.
+        double step = m_vehicle->GetStepsize();
+        for (int i = 0; i < 4; i++) {
+            double axle_torque = m_vehicle->GetDriveline()->GetWheelTorque(WheelID(i));
+            double brake_torque = m_vehicle->GetBrake(WheelID(i))->GetBrakeTorque();
+            tire_forces[i] =
+                m_tires[i]->AdvanceMultirate(time, step, wheel_states[i], terrain, axle_torque, brake_torque);
+        }
+    } else {
+        tire_forces[0] = m_tires[0]->GetTireForce();
+        tire_forces[1] = m_tires[1]->GetTireForce();
+        tire_forces[2] = m_tires[2]->GetTireForce();
+        tire_forces[3] = m_tires[3]->GetTireForce();
+
+        m_tires[0]->Synchronize(time, wheel_states[0], terrain);
+        m_tires[1]->Synchronize(time, wheel_states[1], terrain);
+        m_tires[2]->Synchronize(time, wheel_states[2], terrain);
+        m_tires[3]->Synchronize(time, wheel_states[3], terrain);
+    }
+
     double powertrain_torque = m_powertrain->GetOutputTorque();
 
     double driveshaft_speed = m_vehicle->GetDriveshaftSpeed();
 
-    m_tires[0]->Synchronize(time, wheel_states[0], terrain);
-    m_tires[1]->Synchronize(time, wheel_states[1], terrain);
-    m_tires[2]->Synchronize(time, wheel_states[2], terrain);
-    m_tires[3]->Synchronize(time, wheel_states[3], terrain);
-
     m_powertrain->Synchronize(time, throttle_input, driveshaft_speed);
 
     m_vehicle->Synchronize(time, steering_input, braking_input, powertrain_torque, tire_forces);
@@ -303,10 +324,13 @@ void HMMWV::Synchronize(double time,
 
 // -----------------------------------------------------------------------------
 void HMMWV::Advance(double step) {
-    m_tires[0]->Advance(step);
-    m_tires[1]->Advance(step);
-    m_tires[2]->Advance(step);
-    m_tires[3]->Advance(step);
+    // With multi-rate tires, the tire states were already advanced in Synchronize().
+    if (m_tire_substeps == 1) {
+        m_tires[0]->Advance(step);
+        m_tires[1]->Advance(step);
+        m_tires[2]->Advance(step);
+        m_tires[3]->Advance(step);
+    }
 
     m_powertrain->Advance(step);
 
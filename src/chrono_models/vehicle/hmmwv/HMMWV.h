@@ -77,6 +77,12 @@ class CH_MODELS_API HMMWV {
     void SetVehicleStepSize(double step_size) { m_vehicle_step_size = step_size; }
     void SetTireStepSize(double step_size) { m_tire_step_size = step_size; }
 
+    /// Enable multi-rate integration of the tire models.
+    /// If 'num_substeps' is larger than 1, the tire force evaluation is sub-cycled that many times
+    /// within each vehicle step and the averaged tire forces are applied to the vehicle. In this mode,
+    /// Advance() should be called with the vehicle step size.
+    void SetTireSubsteps(int num_substeps) { m_tire_substeps = num_substeps; }
+
     ChSystem* GetSystem() const { return m_vehicle->GetSystem(); }
     ChWheeledVehicle& GetVehicle() const { return *m_vehicle; }
     std::shared_ptr<ChChassis> GetChassis() const { return m_vehicle->GetChassis(); }
@@ -120,6 +126,7 @@ class CH_MODELS_API HMMWV {
 
     double m_vehicle_step_size;
     double m_tire_step_size;
+    int m_tire_substeps;
 
     ChCoordsys<> m_initPos;
     double m_initFwdVel;
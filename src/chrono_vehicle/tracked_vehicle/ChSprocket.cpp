@@ -20,8 +20,12 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <cmath>
+
 #include "chrono/assets/ChLineShape.h"
 #include "chrono/assets/ChColor.h"
+#include "chrono/parallel/ChOpenMP.h"
 
 #include "chrono_vehicle/tracked_vehicle/ChSprocket.h"
 #include "chrono_vehicle/tracked_vehicle/ChTrackAssembly.h"
@@ -193,5 +197,73 @@ void ChSprocket::Output(ChVehicleOutput& database) const {
     database.WriteJoints(joints);
 }
 
+// -----------------------------------------------------------------------------
+// Base class for the sprocket-shoe custom collision callbacks.
+// -----------------------------------------------------------------------------
+ChSprocketContactCB::ChSprocketContactCB(ChTrackAssembly* track, int num_teeth)
+    : m_track(track), m_num_teeth(num_teeth) {
+    m_bin_start.resize(m_num_teeth + 1);
+}
+
+void ChSprocketContactCB::ProcessShoes(double broadphase_radius) {
+    auto gear = m_track->GetSprocket()->GetGearBody();
+    int num_shoes = (int)m_track->GetNumTrackShoes();
+    double radius2 = broadphase_radius * broadphase_radius;
+    double beta = CH_C_2PI / m_num_teeth;
+
+    // Broadphase: find the candidate shoes and the tooth space closest to each of them.
+    m_bins.resize(num_shoes);
+    std::fill(m_bin_start.begin(), m_bin_start.end(), 0);
+    for (int is = 0; is < num_shoes; is++) {
+        ChVector<> loc = gear->TransformPointParentToLocal(m_track->GetTrackShoe(is)->GetShoeBody()->GetPos());
+        if (loc.x() * loc.x() + loc.z() * loc.z() > radius2) {
+            m_bins[is] = -1;
+            continue;
+        }
+        double angle = std::atan2(loc.z(), loc.x());
+        angle = angle < 0 ? angle + CH_C_2PI : angle;
+        int bin = static_cast<int>(std::round(angle / beta)) % m_num_teeth;
+        m_bins[is] = bin;
+        m_bin_start[bin + 1]++;
+    }
+
+    // Sort the candidate shoes by tooth bin (counting sort, stable in the shoe index).
+    for (int ib = 0; ib < m_num_teeth; ib++)
+        m_bin_start[ib + 1] += m_bin_start[ib];
+    int num_candidates = m_bin_start[m_num_teeth];
+    m_candidates.resize(num_candidates);
+    std::vector<int> next(m_bin_start.begin(), m_bin_start.end() - 1);
+    for (int is = 0; is < num_shoes; is++) {
+        if (m_bins[is] >= 0)
+            m_candidates[next[m_bins[is]]++] = is;
+    }
+
+    if (num_candidates == 0)
+        return;
+
+    // Narrowphase: process the candidate shoes in parallel, buffering the contacts for each of them.
+    if ((int)m_contacts.size() < num_candidates)
+        m_contacts.resize(num_candidates);
+    m_current.resize(CHOMPfunctions::GetMaxThreads());
+
+#pragma omp parallel for schedule(dynamic, 2) if (num_candidates > 4)
+    for (int ic = 0; ic < num_candidates; ic++) {
+        m_current[CHOMPfunctions::GetThreadNum()] = ic;
+        m_contacts[ic].clear();
+        CheckShoe(m_candidates[ic]);
+    }
+
+    // Add the buffered contacts to the system, in tooth-bin order.
+    auto container = gear->GetSystem()->GetContactContainer();
+    for (int ic = 0; ic < num_candidates; ic++) {
+        for (auto& cinfo : m_contacts[ic])
+            container->AddContact(cinfo);
+    }
+}
+
+void ChSprocketContactCB::AddContact(const collision::ChCollisionInfo& cinfo) {
+    m_contacts[m_current[CHOMPfunctions::GetThreadNum()]].push_back(cinfo);
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
@@ -41,6 +41,7 @@
 #include "chrono/geometry/ChLinePath.h"
 #include "chrono/geometry/ChLineSegment.h"
 #include "chrono/geometry/ChLineArc.h"
+#include "chrono/collision/ChCCollisionInfo.h"
 
 #include "chrono_vehicle/ChApiVehicle.h"
 #include "chrono_vehicle/ChPart.h"
@@ -156,6 +157,44 @@ class CH_VEHICLE_API ChSprocket : public ChPart {
     friend class ChTrackAssembly;
 };
 
+/// Base class for the custom collision callbacks between a sprocket and the shoes of its track assembly.
+/// Track shoes that pass a broadphase test (distance from the gear center, in the gear plane) are binned by
+/// the angular position of their closest tooth space. The narrowphase tests for all candidate shoes are then
+/// evaluated in parallel, with the generated contacts buffered per shoe. Finally, the buffered contacts are
+/// added to the system serially, in tooth order, so that the result does not depend on the number of threads.
+class CH_VEHICLE_API ChSprocketContactCB : public ChSystem::CustomCollisionCallback {
+  public:
+    ChSprocketContactCB(ChTrackAssembly* track,  ///< [in] containing track assembly
+                        int num_teeth            ///< [in] number of teeth of the sprocket gear
+                        );
+
+    virtual ~ChSprocketContactCB() {}
+
+  protected:
+    /// Perform the collision detection for all track shoes in the associated track assembly.
+    /// A track shoe is a candidate for contact if its reference body is within the specified distance
+    /// from the gear center (measured in the gear x-z plane).
+    void ProcessShoes(double broadphase_radius);
+
+    /// Perform the narrowphase collision tests between the sprocket and the specified track shoe.
+    /// Contacts must be reported through AddContact(). This function is called concurrently for
+    /// different track shoes and therefore must not modify any shared data.
+    virtual void CheckShoe(size_t is) = 0;
+
+    /// Buffer a contact generated for the track shoe currently processed by the calling thread.
+    void AddContact(const collision::ChCollisionInfo& cinfo);
+
+    ChTrackAssembly* m_track;  ///< pointer to containing track assembly
+
+  private:
+    int m_num_teeth;                   ///< number of teeth (number of angular bins)
+    std::vector<size_t> m_candidates;  ///< candidate shoes, sorted by tooth bin
+    std::vector<int> m_bins;           ///< tooth bin of each track shoe (-1 if not a candidate)
+    std::vector<int> m_bin_start;      ///< start of each bin in the sorted candidate list
+    std::vector<std::vector<collision::ChCollisionInfo>> m_contacts;  ///< buffered contacts, per candidate
+    std::vector<int> m_current;  ///< candidate currently processed by each thread
+};
+
 /// Vector of handles to sprocket subsystems.
 typedef std::vector<std::shared_ptr<ChSprocket> > ChSprocketList;
 
@@ -63,7 +63,7 @@ static ChVector2<> CalcCircleCenter(const ChVector2<>& A, const ChVector2<>& B,
     return O;
 }
 
-class SprocketBandContactCB : public ChSystem::CustomCollisionCallback {
+class SprocketBandContactCB : public ChSprocketContactCB {
   public:
     //// TODO Add in a collision envelope to the contact algorithm for NSC
     SprocketBandContactCB(ChTrackAssembly* track,  ///< containing track assembly
@@ -71,8 +71,11 @@ class SprocketBandContactCB : public ChSystem::CustomCollisionCallback {
                           int gear_nteeth,         ///< number of teeth of the sprocket gear
                           double separation        ///< separation between sprocket gears
                           )
-        : m_track(track), m_envelope(envelope), m_gear_nteeth(gear_nteeth), m_separation(separation) {
-        m_sprocket = std::dynamic_pointer_cast<ChSprocketBand>(m_track->GetSprocket());
+        : ChSprocketContactCB(track, gear_nteeth),
+          m_envelope(envelope),
+          m_gear_nteeth(gear_nteeth),
+          m_separation(separation) {
+        m_sprocket = std::dynamic_pointer_cast<ChSprocketBand>(track->GetSprocket());
         auto shoe = std::dynamic_pointer_cast<ChTrackShoeBand>(track->GetTrackShoe(0));
 
         // The angle between the centers of two sequential teeth on the sprocket
@@ -155,6 +158,9 @@ class SprocketBandContactCB : public ChSystem::CustomCollisionCallback {
     virtual void OnCustomCollision(ChSystem* system) override;
 
   private:
+    // Test collision between the tread body of the specified track shoe and the sprocket.
+    virtual void CheckShoe(size_t is) override;
+
     // Test collision between a tread segment body and the sprocket's gear profile
     void CheckTreadSegmentSprocket(std::shared_ptr<ChBody> treadsegment,  // tread segment body
                                    const ChVector<>& locS_abs             // center of sprocket (global frame)
@@ -181,7 +187,6 @@ class SprocketBandContactCB : public ChSystem::CustomCollisionCallback {
                             const ChVector<>& p2                  // segment end point 2
     );
 
-    ChTrackAssembly* m_track;                    // pointer to containing track assembly
     std::shared_ptr<ChSprocketBand> m_sprocket;  // handle to the sprocket
 
     double m_envelope;  // collision detection envelope
@@ -247,15 +252,18 @@ void SprocketBandContactCB::OnCustomCollision(ChSystem* system) {
     if (!m_sprocket->GetGearBody()->GetCollide())
         return;
 
+    // Process all shoes in the associated track (in parallel).
+    ProcessShoes(std::sqrt(m_gear_tread_broadphase_dist_squared));
+}
+
+// Perform collision test between the specified track shoe and the sprocket.
+void SprocketBandContactCB::CheckShoe(size_t is) {
     // Sprocket gear center location (expressed in global frame)
     ChVector<> locS_abs = m_sprocket->GetGearBody()->GetPos();
 
-    // Loop over all track shoes in the associated track
-    for (size_t is = 0; is < m_track->GetNumTrackShoes(); ++is) {
-        auto shoe = std::static_pointer_cast<ChTrackShoeBand>(m_track->GetTrackShoe(is));
+    auto shoe = std::static_pointer_cast<ChTrackShoeBand>(m_track->GetTrackShoe(is));
 
-        CheckTreadSegmentSprocket(shoe->GetShoeBody(), locS_abs);
-    }
+    CheckTreadSegmentSprocket(shoe->GetShoeBody(), locS_abs);
 }
 
 void SprocketBandContactCB::CheckTreadSegmentSprocket(
@@ -549,7 +557,7 @@ void SprocketBandContactCB::CheckTreadArcSprocketArc(std::shared_ptr<ChBody> tre
     contact.distance = collision_distance;
     ////contact.eff_radius = sprocket_arc_radius;  //// TODO: take into account tooth_arc_radius?
 
-    m_sprocket->GetGearBody()->GetSystem()->GetContactContainer()->AddContact(contact);
+    AddContact(contact);
 }
 
 // Working in the (x-z) plane, perform a 2D collision test between the circle of radius 'cr'
@@ -588,7 +596,7 @@ void SprocketBandContactCB::CheckSegmentCircle(std::shared_ptr<ChBody> BeltSegme
     contact.distance = dist - cr;
     ////contact.eff_radius = cr;
 
-    m_sprocket->GetGearBody()->GetSystem()->GetContactContainer()->AddContact(contact);
+    AddContact(contact);
 }
 
 // -----------------------------------------------------------------------------
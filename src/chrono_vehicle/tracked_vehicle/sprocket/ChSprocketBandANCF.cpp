@@ -63,7 +63,7 @@ static ChVector2<> CalcCircleCenter(const ChVector2<>& A, const ChVector2<>& B,
     return O;
 }
 
-class SprocketBandANCFContactCB : public ChSystem::CustomCollisionCallback {
+class SprocketBandANCFContactCB : public ChSprocketContactCB {
   public:
     //// TODO Add in a collision envelope to the contact algorithm for NSC
     SprocketBandANCFContactCB(ChTrackAssembly* track,  ///< containing track assembly
@@ -71,8 +71,11 @@ class SprocketBandANCFContactCB : public ChSystem::CustomCollisionCallback {
                               int gear_nteeth,         ///< number of teeth of the sprocket gear
                               double separation        ///< separation between sprocket gears
                               )
-        : m_track(track), m_envelope(envelope), m_gear_nteeth(gear_nteeth), m_separation(separation) {
-        m_sprocket = std::dynamic_pointer_cast<ChSprocketBandANCF>(m_track->GetSprocket());
+        : ChSprocketContactCB(track, gear_nteeth),
+          m_envelope(envelope),
+          m_gear_nteeth(gear_nteeth),
+          m_separation(separation) {
+        m_sprocket = std::dynamic_pointer_cast<ChSprocketBandANCF>(track->GetSprocket());
         auto shoe = std::dynamic_pointer_cast<ChTrackShoeBandANCF>(track->GetTrackShoe(0));
 
         // The angle between the centers of two sequential teeth on the sprocket
@@ -155,6 +158,9 @@ class SprocketBandANCFContactCB : public ChSystem::CustomCollisionCallback {
     virtual void OnCustomCollision(ChSystem* system) override;
 
   private:
+    // Test collision between the tread body of the specified track shoe and the sprocket.
+    virtual void CheckShoe(size_t is) override;
+
     // Test collision between a tread segment body and the sprocket's gear profile
     void CheckTreadSegmentSprocket(std::shared_ptr<ChBody> treadsegment,  // tread segment body
                                    const ChVector<>& locS_abs             // center of sprocket (global frame)
@@ -188,7 +194,6 @@ class SprocketBandANCFContactCB : public ChSystem::CustomCollisionCallback {
                             const ChVector<>& p2                  // segment end point 2
     );
 
-    ChTrackAssembly* m_track;                        // pointer to containing track assembly
     std::shared_ptr<ChSprocketBandANCF> m_sprocket;  // handle to the sprocket
 
     double m_envelope;  // collision detection envelope
@@ -265,21 +270,24 @@ void SprocketBandANCFContactCB::OnCustomCollision(ChSystem* system) {
     if (!m_sprocket->GetGearBody()->GetCollide())
         return;
 
+    // Process all shoes in the associated track (in parallel).
+    ProcessShoes(std::sqrt(m_gear_tread_broadphase_dist_squared));
+}
+
+// Perform collision test between the specified track shoe and the sprocket.
+void SprocketBandANCFContactCB::CheckShoe(size_t is) {
     // Sprocket gear center location (expressed in global frame)
     ChVector<> locS_abs = m_sprocket->GetGearBody()->GetPos();
 
-    // Loop over all track shoes in the associated track
-    for (size_t is = 0; is < m_track->GetNumTrackShoes(); ++is) {
-        auto shoe = std::static_pointer_cast<ChTrackShoeBandANCF>(m_track->GetTrackShoe(is));
+    auto shoe = std::static_pointer_cast<ChTrackShoeBandANCF>(m_track->GetTrackShoe(is));
 
-        CheckTreadSegmentSprocket(shoe->GetShoeBody(), locS_abs);
+    CheckTreadSegmentSprocket(shoe->GetShoeBody(), locS_abs);
 
-        // for (size_t web = 0; web < shoe->GetNumWebSegments(); web++) {
-        //    // Perform collision test for the ith web segment
-        //    CheckWebSegmentSprocket(shoe->GetGetWebSegment(web), locS_abs, shoe->GetWebThickness(),
-        //                            shoe->GetGetWebSegmentLength());
-        //}
-    }
+    // for (size_t web = 0; web < shoe->GetNumWebSegments(); web++) {
+    //    // Perform collision test for the ith web segment
+    //    CheckWebSegmentSprocket(shoe->GetGetWebSegment(web), locS_abs, shoe->GetWebThickness(),
+    //                            shoe->GetGetWebSegmentLength());
+    //}
 }
 
 void SprocketBandANCFContactCB::CheckTreadSegmentSprocket(
@@ -572,7 +580,7 @@ void SprocketBandANCFContactCB::CheckTreadArcSprocketArc(std::shared_ptr<ChBody>
     contact.vpB = m_sprocket->GetGearBody()->TransformPointLocalToParent(pt_tooth);
     contact.distance = collision_distance;
 
-    m_sprocket->GetGearBody()->GetSystem()->GetContactContainer()->AddContact(contact);
+    AddContact(contact);
 }
 
 // Perform collision test between the specified connector body and the associated sprocket.
@@ -634,7 +642,7 @@ void SprocketBandANCFContactCB::CheckSegmentCircle(std::shared_ptr<ChBody> BeltS
     contact.vpB = m_sprocket->GetGearBody()->TransformPointLocalToParent(pt_segement);
     contact.distance = dist - cr;
 
-    m_sprocket->GetGearBody()->GetSystem()->GetContactContainer()->AddContact(contact);
+    AddContact(contact);
 }
 
 // -----------------------------------------------------------------------------
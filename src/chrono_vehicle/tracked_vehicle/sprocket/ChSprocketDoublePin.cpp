@@ -28,7 +28,7 @@ namespace vehicle {
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
-class SprocketDoublePinContactCB : public ChSystem::CustomCollisionCallback {
+class SprocketDoublePinContactCB : public ChSprocketContactCB {
   public:
     SprocketDoublePinContactCB(ChTrackAssembly* track,  ///< containing track assembly
                                double envelope,         ///< collision detection envelope
@@ -41,9 +41,9 @@ class SprocketDoublePinContactCB : public ChSystem::CustomCollisionCallback {
                                double shoe_len,         ///< length of track shoe connector
                                double shoe_R            ///< radius of track shoe connector
                                )
-        : m_track(track),
+        : ChSprocketContactCB(track, gear_nteeth),
           m_envelope(envelope),
-          m_sprocket(m_track->GetSprocket()),
+          m_sprocket(track->GetSprocket()),
           m_gear_nteeth(gear_nteeth),
           m_gear_RT(gear_RT),
           m_gear_R(gear_R),
@@ -60,11 +60,15 @@ class SprocketDoublePinContactCB : public ChSystem::CustomCollisionCallback {
         m_beta = CH_C_2PI / m_gear_nteeth;
         m_sbeta = std::sin(m_beta / 2);
         m_cbeta = std::cos(m_beta / 2);
+        m_R_shoe = m_R_sum + track->GetTrackShoe(0)->GetPitch();
     }
 
     virtual void OnCustomCollision(ChSystem* system) override;
 
   private:
+    // Test collision between the connector bodies of the specified track shoe and the sprocket.
+    virtual void CheckShoe(size_t is) override;
+
     // Test collision between a connector body and the sprocket's gear profiles.
     void CheckConnectorSprocket(std::shared_ptr<ChBody> connector,  // connector body
                                 const ChVector<>& locS_abs          // center of sprocket (global frame)
@@ -98,7 +102,6 @@ class SprocketDoublePinContactCB : public ChSystem::CustomCollisionCallback {
                             const ChVector<>& p2                // segment end point 2
                             );
 
-    ChTrackAssembly* m_track;                // pointer to containing track assembly
     std::shared_ptr<ChSprocket> m_sprocket;  // handle to the sprocket
 
     double m_envelope;  // collision detection envelope
@@ -123,7 +126,8 @@ class SprocketDoublePinContactCB : public ChSystem::CustomCollisionCallback {
     double m_gear_Rhat;  // adjusted gear arc radius
     double m_shoe_Rhat;  // adjusted shoe cylinder radius
 
-    double m_R_sum;  // test quantity for broadphase check
+    double m_R_sum;   // test quantity for broadphase check
+    double m_R_shoe;  // test quantity for broadphase check on shoe body center
 };
 
 // Add contacts between the sprocket and track shoes.
@@ -132,19 +136,22 @@ void SprocketDoublePinContactCB::OnCustomCollision(ChSystem* system) {
     if (!m_sprocket->GetGearBody()->GetCollide())
         return;
 
+    // Process all shoes in the associated track (in parallel).
+    ProcessShoes(m_R_shoe);
+}
+
+// Perform collision test between the connectors of the specified track shoe and the sprocket.
+void SprocketDoublePinContactCB::CheckShoe(size_t is) {
+    auto shoe = std::static_pointer_cast<ChTrackShoeDoublePin>(m_track->GetTrackShoe(is));
+
     // Sprocket gear center location (expressed in global frame)
     ChVector<> locS_abs = m_sprocket->GetGearBody()->GetPos();
 
-    // Loop over all track shoes in the associated track
-    for (size_t is = 0; is < m_track->GetNumTrackShoes(); ++is) {
-        auto shoe = std::static_pointer_cast<ChTrackShoeDoublePin>(m_track->GetTrackShoe(is));
-
-        // Perform collision test for the "left" connector body
-        CheckConnectorSprocket(shoe->m_connector_L, locS_abs);
+    // Perform collision test for the "left" connector body
+    CheckConnectorSprocket(shoe->m_connector_L, locS_abs);
 
-        // Perform collision test for the "right" connector body
-        CheckConnectorSprocket(shoe->m_connector_R, locS_abs);
-    }
+    // Perform collision test for the "right" connector body
+    CheckConnectorSprocket(shoe->m_connector_R, locS_abs);
 }
 
 // Perform collision test between the specified connector body and the associated sprocket.
@@ -288,7 +295,7 @@ void SprocketDoublePinContactCB::CheckCircleArc(std::shared_ptr<ChBody> connecto
     contact.distance = Rdiff - dist;
     ////contact.eff_radius = cr;  //// TODO: take into account ar?
 
-    m_sprocket->GetGearBody()->GetSystem()->GetContactContainer()->AddContact(contact);
+    AddContact(contact);
 }
 
 // Working in the (x-z) plane, perform a 2D collision test between the circle of radius 'cr'
@@ -329,7 +336,7 @@ void SprocketDoublePinContactCB::CheckCircleSegment(std::shared_ptr<ChBody> conn
     contact.distance = dist - cr;
     ////contact.eff_radius = cr;
 
-    m_sprocket->GetGearBody()->GetSystem()->GetContactContainer()->AddContact(contact);
+    AddContact(contact);
 }
 
 // -----------------------------------------------------------------------------
@@ -17,6 +17,7 @@
 //
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 
 #include "chrono_vehicle/tracked_vehicle/sprocket/ChSprocketSinglePin.h"
@@ -28,7 +29,7 @@ namespace vehicle {
 
 // -----------------------------------------------------------------------------
 // -----------------------------------------------------------------------------
-class SprocketSinglePinContactCB : public ChSystem::CustomCollisionCallback {
+class SprocketSinglePinContactCB : public ChSprocketContactCB {
   public:
     SprocketSinglePinContactCB(ChTrackAssembly* track,  ///< containing track assembly
                                double envelope,         ///< collision detection envelope
@@ -41,9 +42,9 @@ class SprocketSinglePinContactCB : public ChSystem::CustomCollisionCallback {
                                double shoe_locR,        ///< location of rear cylinder on shoe (in local frame)
                                double shoe_R            ///< radius of shoe cylinders
                                )
-        : m_track(track),
+        : ChSprocketContactCB(track, gear_nteeth),
           m_envelope(envelope),
-          m_sprocket(m_track->GetSprocket()),
+          m_sprocket(track->GetSprocket()),
           m_gear_nteeth(gear_nteeth),
           m_gear_RO(gear_RO),
           m_gear_RC(gear_RC),
@@ -58,11 +59,15 @@ class SprocketSinglePinContactCB : public ChSystem::CustomCollisionCallback {
         m_R_sum = m_gear_RO + m_shoe_R + safety_factor * m_envelope;
         m_R_diff = m_gear_R - m_shoe_R;
         m_Rhat_diff = m_gear_Rhat - m_shoe_Rhat;
+        m_R_shoe = m_R_sum + std::max(std::abs(m_shoe_locF), std::abs(m_shoe_locR));
     }
 
     virtual void OnCustomCollision(ChSystem* system) override;
 
   private:
+    // Test collision of the specified track shoe with the sprocket.
+    virtual void CheckShoe(size_t is) override;
+
     // Test collision of a shoe contact cylinder with the sprocket's gear profiles.
     // This may introduce up to two contacts (one with each gear plane).
     void CheckCylinderSprocket(std::shared_ptr<ChBody> shoe,  // shoe body
@@ -81,7 +86,6 @@ class SprocketSinglePinContactCB : public ChSystem::CustomCollisionCallback {
     // The calculation is performed in the (x-z) plane.
     ChVector<> FindClosestArc(const ChVector<>& loc);
 
-    ChTrackAssembly* m_track;                // pointer to containing track assembly
     std::shared_ptr<ChSprocket> m_sprocket;  // handle to the sprocket
 
     double m_envelope;  // collision detection envelope
@@ -101,6 +105,7 @@ class SprocketSinglePinContactCB : public ChSystem::CustomCollisionCallback {
     double m_R_sum;      // test quantity for broadphase check
     double m_R_diff;     // test quantity for narrowphase check
     double m_Rhat_diff;  // test quantity for narrowphase check
+    double m_R_shoe;     // test quantity for broadphase check on shoe body center
 };
 
 void SprocketSinglePinContactCB::OnCustomCollision(ChSystem* system) {
@@ -108,27 +113,30 @@ void SprocketSinglePinContactCB::OnCustomCollision(ChSystem* system) {
     if (!m_sprocket->GetGearBody()->GetCollide() || !m_track->GetTrackShoe(0)->GetShoeBody()->GetCollide())
         return;
 
+    // Process all shoes in the associated track (in parallel).
+    ProcessShoes(m_R_shoe);
+}
+
+// Perform collision test between the specified track shoe and the sprocket.
+void SprocketSinglePinContactCB::CheckShoe(size_t is) {
+    std::shared_ptr<ChTrackShoe> shoe = m_track->GetTrackShoe(is);
+
     // Sprocket gear center location (expressed in global frame)
     ChVector<> locS_abs = m_sprocket->GetGearBody()->GetPos();
 
-    // Loop over all shoes in the associated track.
-    for (size_t is = 0; is < m_track->GetNumTrackShoes(); ++is) {
-        std::shared_ptr<ChTrackShoe> shoe = m_track->GetTrackShoe(is);
-
-        // Calculate locations of the centers of the shoe's contact cylinders
-        // (expressed in the global frame)
-        ChVector<> locF_abs = shoe->GetShoeBody()->TransformPointLocalToParent(ChVector<>(m_shoe_locF, 0, 0));
-        ChVector<> locR_abs = shoe->GetShoeBody()->TransformPointLocalToParent(ChVector<>(m_shoe_locR, 0, 0));
+    // Calculate locations of the centers of the shoe's contact cylinders
+    // (expressed in the global frame)
+    ChVector<> locF_abs = shoe->GetShoeBody()->TransformPointLocalToParent(ChVector<>(m_shoe_locF, 0, 0));
+    ChVector<> locR_abs = shoe->GetShoeBody()->TransformPointLocalToParent(ChVector<>(m_shoe_locR, 0, 0));
 
-        // Express contact cylinder direction (common for both cylinders) in the global frame
-        ChVector<> dir_abs = shoe->GetShoeBody()->GetA().Get_A_Yaxis();
+    // Express contact cylinder direction (common for both cylinders) in the global frame
+    ChVector<> dir_abs = shoe->GetShoeBody()->GetA().Get_A_Yaxis();
 
-        // Perform collision test for the front contact cylinder.
-        CheckCylinderSprocket(shoe->GetShoeBody(), locF_abs, dir_abs, locS_abs);
+    // Perform collision test for the front contact cylinder.
+    CheckCylinderSprocket(shoe->GetShoeBody(), locF_abs, dir_abs, locS_abs);
 
-        // Perform collision test for the rear contact cylinder.
-        CheckCylinderSprocket(shoe->GetShoeBody(), locR_abs, dir_abs, locS_abs);
-    }
+    // Perform collision test for the rear contact cylinder.
+    CheckCylinderSprocket(shoe->GetShoeBody(), locR_abs, dir_abs, locS_abs);
 }
 
 // Perform collision test between one of the shoe's contact cylinders and the
@@ -210,7 +218,7 @@ void SprocketSinglePinContactCB::CheckCircleProfile(std::shared_ptr<ChBody> shoe
     contact.distance = m_R_diff - dist;
     ////contact.eff_radius = m_shoe_R;  //// TODO: take into account m_gear_R?
 
-    m_sprocket->GetGearBody()->GetSystem()->GetContactContainer()->AddContact(contact);
+    AddContact(contact);
 }
 
 // Find the center of the profile arc that is closest to the specified location.
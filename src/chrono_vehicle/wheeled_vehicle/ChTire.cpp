@@ -28,7 +28,17 @@ namespace chrono {
 namespace vehicle {
 
 ChTire::ChTire(const std::string& name)
-    : ChPart(name), m_stepsize(1e-3), m_slip_angle(0), m_longitudinal_slip(0), m_camber_angle(0) {}
+    : ChPart(name),
+      m_stepsize(1e-3),
+      m_num_substeps(1),
+      m_slip_angle(0),
+      m_longitudinal_slip(0),
+      m_camber_angle(0),
+      m_terrain_cached(false),
+      m_terrain_x(0),
+      m_terrain_y(0),
+      m_terrain_height(0),
+      m_terrain_normal(0, 0, 1) {}
 
 // -----------------------------------------------------------------------------
 // Base class implementation of the initialization function.
@@ -51,6 +61,86 @@ double ChTire::ReportMass() const {
     return GetMass();
 }
 
+// -----------------------------------------------------------------------------
+// Multi-rate advance of the tire over a coarse vehicle step.
+// The wheel center is assumed to move with constant linear velocity over the
+// coarse step (the wheel carries a share of the vehicle mass). The wheel spin,
+// which is the stiff mode excited by the tire longitudinal force, is integrated
+// at the fine rate with the tire torque, the axle (driveline) torque, and the
+// brake torque, using the spin inertia of the wheel body. Each sub-step
+// evaluates the tire at the state and time at its beginning. The tire force and
+// moment are averaged over the coarse step.
+// -----------------------------------------------------------------------------
+TerrainForce ChTire::AdvanceMultirate(double time,
+                                      double step,
+                                      const WheelState& wheel_state,
+                                      const ChTerrain& terrain,
+                                      double axle_torque,
+                                      double brake_torque) {
+    double h = step / m_num_substeps;
+
+    // Spin inertia of the wheel (this includes the tire inertia, see Initialize)
+    double spin_inertia = m_wheel ? m_wheel->GetInertiaXX().y() : GetInertia().y();
+
+    // The averaged force is applied at the wheel center (the moments are reduced to the center at each sub-step)
+    TerrainForce avg_force;
+    avg_force.force = ChVector<>(0, 0, 0);
+    avg_force.moment = ChVector<>(0, 0, 0);
+    avg_force.point = wheel_state.pos;
+
+    WheelState state = wheel_state;
+
+    for (int k = 0; k < m_num_substeps; k++) {
+        Synchronize(time + k * h, state, terrain);
+        Advance(h);
+
+        // Tire force, reduced to the wheel center
+        TerrainForce tf = GetTireForce();
+        ChVector<> moment = tf.moment + Vcross(tf.point - state.pos, tf.force);
+        avg_force.force += tf.force;
+        avg_force.moment += moment;
+
+        // Integrate the wheel spin over the sub-step. The brake torque opposes the
+        // spin and cannot reverse it.
+        ChVector<> axis = state.rot.GetYaxis();
+        double omega = state.omega + h * (axle_torque + Vdot(moment, axis)) / spin_inertia;
+        double brake_dw = h * std::abs(brake_torque) / spin_inertia;
+        if (std::abs(omega) <= brake_dw)
+            omega = 0;
+        else
+            omega -= std::copysign(brake_dw, omega);
+        state.ang_vel += (omega - state.omega) * axis;
+        state.omega = omega;
+
+        // Wheel pose at the end of the sub-step
+        state.pos += state.lin_vel * h;
+        double w = state.ang_vel.Length();
+        if (w > 1e-10) {
+            ChQuaternion<> q;
+            q.Q_from_AngAxis(w * h, state.ang_vel / w);
+            state.rot = q * state.rot;
+            state.rot.Normalize();
+        }
+    }
+
+    double scale = 1.0 / m_num_substeps;
+    avg_force.force *= scale;
+    avg_force.moment *= scale;
+
+    return avg_force;
+}
+
+// -----------------------------------------------------------------------------
+// Terrain data at the wheel center, evaluated by the caller.
+// -----------------------------------------------------------------------------
+void ChTire::SetTerrainData(double x, double y, double height, const ChVector<>& normal) {
+    m_terrain_cached = true;
+    m_terrain_x = x;
+    m_terrain_y = y;
+    m_terrain_height = height;
+    m_terrain_normal = normal;
+}
+
 // -----------------------------------------------------------------------------
 // Calculate kinematics quantities (slip angle, longitudinal slip, camber angle,
 // and toe-in angle using the current state of the associated wheel body.
@@ -60,7 +150,7 @@ void ChTire::CalculateKinematics(double time, const WheelState& state, const ChT
     ChVector<> wheel_normal = state.rot.GetYaxis();
 
     // Terrain normal at wheel location (expressed in global frame)
-    ChVector<> Z_dir = terrain.GetNormal(state.pos.x(), state.pos.y());
+    ChVector<> Z_dir = GetTerrainNormal(terrain, state.pos.x(), state.pos.y());
 
     // Longitudinal (heading) and lateral directions, in the terrain plane
     ChVector<> X_dir = Vcross(wheel_normal, Z_dir);
@@ -102,10 +192,10 @@ bool ChTire::disc_terrain_contact(const ChTerrain& terrain,
                                   const ChVector<>& disc_normal,
                                   double disc_radius,
                                   ChCoordsys<>& contact,
-                                  double& depth) {
+                                  double& depth) const {
     // Find terrain height below disc center. There is no contact if the disc
     // center is below the terrain or farther away by more than its radius.
-    double hc = terrain.GetHeight(disc_center.x(), disc_center.y());
+    double hc = GetTerrainHeight(terrain, disc_center.x(), disc_center.y());
     if (disc_center.z() <= hc || disc_center.z() >= hc + disc_radius)
         return false;
 
@@ -122,14 +212,14 @@ bool ChTire::disc_terrain_contact(const ChTerrain& terrain,
 
     // Find terrain height at lowest point. No contact if lowest point is above
     // the terrain.
-    double hp = terrain.GetHeight(ptD.x(), ptD.y());
+    double hp = GetTerrainHeight(terrain, ptD.x(), ptD.y());
 
     if (ptD.z() > hp)
         return false;
 
     // Approximate the terrain with a plane. Define the projection of the lowest
     // point onto this plane as the contact point on the terrain.
-    ChVector<> normal = terrain.GetNormal(ptD.x(), ptD.y());
+    ChVector<> normal = GetTerrainNormal(terrain, ptD.x(), ptD.y());
     ChVector<> longitudinal = Vcross(disc_normal, normal);
     longitudinal.Normalize();
     ChVector<> lateral = Vcross(normal, longitudinal);
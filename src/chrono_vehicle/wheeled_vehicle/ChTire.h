@@ -22,6 +22,8 @@
 #ifndef CH_TIRE_H
 #define CH_TIRE_H
 
+#include <algorithm>
+
 #include "chrono/core/ChVector.h"
 #include "chrono/core/ChQuaternion.h"
 #include "chrono/core/ChCoordsys.h"
@@ -74,6 +76,32 @@ class CH_VEHICLE_API ChTire : public ChPart {
     /// Advance the state of this tire by the specified time step.
     virtual void Advance(double step) {}
 
+    /// Set the number of tire sub-steps within one vehicle step for multi-rate integration.
+    /// See AdvanceMultirate(). Default value: 1 (no sub-cycling).
+    /// Note that sub-cycling must be driven by the vehicle wrapper, which calls AdvanceMultirate()
+    /// instead of Synchronize()/Advance() (currently only the HMMWV model does so).
+    void SetNumSubsteps(int val) { m_num_substeps = std::max(val, 1); }
+
+    /// Get the number of tire sub-steps within one vehicle step.
+    int GetNumSubsteps() const { return m_num_substeps; }
+
+    /// Synchronize and advance this tire over a (coarse) vehicle step using a multi-rate scheme.
+    /// The tire force evaluation is sub-cycled GetNumSubsteps() times within the given step. The wheel
+    /// center moves with the provided (constant) linear velocity, while the wheel spin is integrated at
+    /// the fine rate from the tire torque, the axle torque, and the brake torque, using the spin inertia
+    /// of the wheel body. At each sub-step, the tire kinematics and forces are re-evaluated (Synchronize)
+    /// at the sub-step start time and the tire dynamics are advanced over the sub-step (Advance).
+    /// The return value is the tire force and moment averaged over the coarse step, applied at the
+    /// current wheel center, to be applied to the wheel body while the vehicle system is advanced with
+    /// the coarse step.
+    TerrainForce AdvanceMultirate(double time,                    ///< [in] current time
+                                  double step,                    ///< [in] coarse (vehicle) step size
+                                  const WheelState& wheel_state,  ///< [in] current state of associated wheel body
+                                  const ChTerrain& terrain,       ///< [in] reference to the terrain system
+                                  double axle_torque = 0,         ///< [in] driveline torque on the wheel
+                                  double brake_torque = 0         ///< [in] brake torque magnitude
+                                  );
+
     /// Get the tire radius.
     virtual double GetRadius() const = 0;
 
@@ -136,6 +164,15 @@ class CH_VEHICLE_API ChTire : public ChPart {
 
 	/// Report the tire deflection 
 	virtual double GetDeflection() const { return 0; }
+
+    /// Provide the terrain height and normal at the wheel center location (x, y), as already evaluated
+    /// by the caller (e.g. ChWheeledVehicleBatch, which queries the terrain below all wheels in one pass).
+    /// Until ClearTerrainData() is called, the terrain queries of this tire at exactly this location use
+    /// these values; queries at any other location are still passed to the terrain object.
+    void SetTerrainData(double x, double y, double height, const ChVector<>& normal);
+
+    /// Discard the terrain data set with SetTerrainData().
+    void ClearTerrainData() { m_terrain_cached = false; }
 	
   protected:
     /// Perform disc-terrain collision detection.
@@ -147,18 +184,31 @@ class CH_VEHICLE_API ChTire : public ChPart {
     /// system with the Z axis along the contact normal and the X axis along the
     /// "rolling" direction, as well as a positive penetration depth (i.e. the
     /// height below the terrain of the lowest point on the disc).
-    static bool disc_terrain_contact(
+    bool disc_terrain_contact(
         const ChTerrain& terrain,       ///< [in] reference to terrain system
         const ChVector<>& disc_center,  ///< [in] global location of the disc center
         const ChVector<>& disc_normal,  ///< [in] disc normal, expressed in the global frame
         double disc_radius,             ///< [in] disc radius
         ChCoordsys<>& contact,          ///< [out] contact coordinate system (relative to the global frame)
         double& depth                   ///< [out] penetration depth (positive if contact occurred)
-        );
+        ) const;
+
+    /// Terrain height at the given location (cached value, if provided with SetTerrainData).
+    double GetTerrainHeight(const ChTerrain& terrain, double x, double y) const {
+        return (m_terrain_cached && x == m_terrain_x && y == m_terrain_y) ? m_terrain_height
+                                                                           : terrain.GetHeight(x, y);
+    }
+
+    /// Terrain normal at the given location (cached value, if provided with SetTerrainData).
+    ChVector<> GetTerrainNormal(const ChTerrain& terrain, double x, double y) const {
+        return (m_terrain_cached && x == m_terrain_x && y == m_terrain_y) ? m_terrain_normal
+                                                                           : terrain.GetNormal(x, y);
+    }
 
     VehicleSide m_side;               ///< tire mounted on left/right side
     std::shared_ptr<ChBody> m_wheel;  ///< associated wheel body
     double m_stepsize;                ///< tire integration step size (if applicable)
+    int m_num_substeps;               ///< number of tire sub-steps per vehicle step (multi-rate)
 
   private:
     /// Calculate kinematics quantities based on the current state of the associated
@@ -171,6 +221,12 @@ class CH_VEHICLE_API ChTire : public ChPart {
     double m_slip_angle;
     double m_longitudinal_slip;
     double m_camber_angle;
+
+    bool m_terrain_cached;         ///< terrain data provided with SetTerrainData
+    double m_terrain_x;            ///< location of the cached terrain data
+    double m_terrain_y;            ///< location of the cached terrain data
+    double m_terrain_height;       ///< cached terrain height
+    ChVector<> m_terrain_normal;   ///< cached terrain normal
 };
 
 /// Vector of handles to tire subsystems.
@@ -59,6 +59,10 @@ ChPacejkaTire::ChPacejkaTire(const std::string& name, const std::string& pacTire
       m_params_defined(false),
       m_use_transient_slip(true),
       m_use_Fz_override(false),
+      m_use_force_map(false),
+      m_force_map_tol(0.01),
+      m_force_map_res{9, 9, 3, 5},
+      m_force_map_max_nodes(50000),
       m_driven(false) {}
 
 ChPacejkaTire::ChPacejkaTire(const std::string& name,
@@ -71,6 +75,10 @@ ChPacejkaTire::ChPacejkaTire(const std::string& name,
       m_use_transient_slip(use_transient_slip),
       m_use_Fz_override(Fz_override > 0),
       m_Fz_override(Fz_override),
+      m_use_force_map(false),
+      m_force_map_tol(0.01),
+      m_force_map_res{9, 9, 3, 5},
+      m_force_map_max_nodes(50000),
       m_driven(false) {}
 
 // -----------------------------------------------------------------------------
@@ -171,6 +179,18 @@ void ChPacejkaTire::Initialize(std::shared_ptr<ChBody> wheel, VehicleSide side)
     // Initialize all other variables
     m_Num_WriteOutData = 0;
     zero_slips();  // zeros slips, and some other vars
+
+    // Tabulate the Magic Formula reactions, if requested
+    if (m_use_force_map)
+        buildForceMap();
+}
+
+void ChPacejkaTire::SetForceMapResolution(int n_kappa, int n_alpha, int n_gamma, int n_Fz, int max_nodes) {
+    m_force_map_res[0] = n_kappa;
+    m_force_map_res[1] = n_alpha;
+    m_force_map_res[2] = n_gamma;
+    m_force_map_res[3] = n_Fz;
+    m_force_map_max_nodes = max_nodes;
 }
 
 // -----------------------------------------------------------------------------
@@ -375,11 +395,13 @@ void ChPacejkaTire::Advance(double step) {
         slip_kinematic();
     }
 
-    // Calculate the force and moment reaction, pure slip case
-    pureSlipReactions();
+    if (!m_use_force_map || !forceMapReactions()) {
+        // Calculate the force and moment reaction, pure slip case
+        pureSlipReactions();
 
-    // Update m_FM_combined.forces, m_FM_combined.moment.z
-    combinedSlipReactions();
+        // Update m_FM_combined.forces, m_FM_combined.moment.z
+        combinedSlipReactions();
+    }
 
     // Update M_x, apply to both m_FM and m_FM_combined
     // gamma should already be corrected for L/R side, so need to swap Fy if on opposite side
@@ -438,7 +460,7 @@ void ChPacejkaTire::update_W_frame(const ChTerrain& terrain) {
     ChVector<> wheel_normal = m_tireState.rot.GetYaxis();
 
     // Terrain normal at wheel center location (expressed in global frame)
-    ChVector<> Z_dir = terrain.GetNormal(m_tireState.pos.x(), m_tireState.pos.y());
+    ChVector<> Z_dir = GetTerrainNormal(terrain, m_tireState.pos.x(), m_tireState.pos.y());
 
     // Longitudinal (heading) and lateral directions, in the terrain plane.
     ChVector<> X_dir = Vcross(wheel_normal, Z_dir);
@@ -999,6 +1021,117 @@ void ChPacejkaTire::combinedSlipReactions() {
     }
 }
 
+// -----------------------------------------------------------------------------
+// Tabulate the pure and combined slip reactions over the ranges of longitudinal
+// slip, slip angle, inclination angle, and vertical load given in the parameter
+// file. The analytic functions use the private coefficient structures as
+// scratch space, so these are saved and restored around the table build.
+// The map is built for a tire rolling forward (V_cx > 0). The aligning moment
+// terms scale with cos(alpha') (the residual moment of the combined slip case
+// with its square), so these are tabulated separately at cos(alpha') = 1 and
+// scaled at evaluation. The tabulated outputs are:
+//   0-1: Fx, Fy (pure slip)
+//   2-3: Mz (pure slip), pneumatic trail and residual parts
+//   4-5: Fx, Fy (combined slip)
+//   6-8: Mz (combined slip), pneumatic trail, residual, and Fx parts
+//   9-10: D_y and |alpha_r_eq| (used by the transient slip model, which only
+//         needs the magnitude of alpha_r_eq; its sign jumps at alpha_r = 0)
+// Lateral force and aligning moment are tabulated before the L/R side correction.
+// -----------------------------------------------------------------------------
+void ChPacejkaTire::buildForceMap() {
+    slips slip = *m_slip;
+    pureLongCoefs pureLong = *m_pureLong;
+    pureLatCoefs pureLat = *m_pureLat;
+    pureTorqueCoefs pureTorque = *m_pureTorque;
+    combinedLongCoefs combinedLong = *m_combinedLong;
+    combinedLatCoefs combinedLat = *m_combinedLat;
+    combinedTorqueCoefs combinedTorque = *m_combinedTorque;
+    double Fz = m_Fz;
+    double dF_z = m_dF_z;
+
+    m_slip->V_cx = 1;
+    m_slip->cosPrime_alpha = 1;
+
+    double fnomin = m_params->vertical.fnomin;
+    double Fz_max = std::min(m_params->vertical_force_range.fzmax, Fz_thresh);
+
+    m_force_map.SetNumOutputs(11);
+    m_force_map.SetRange(0, m_params->long_slip_range.kpumin, m_params->long_slip_range.kpumax, m_force_map_res[0]);
+    m_force_map.SetRange(1, m_params->slip_angle_range.alpmin, m_params->slip_angle_range.alpmax, m_force_map_res[1]);
+    m_force_map.SetRange(2, m_params->inclination_angle_range.cammin, m_params->inclination_angle_range.cammax,
+                         m_force_map_res[2]);
+    m_force_map.SetRange(3, m_params->vertical_force_range.fzmin, Fz_max, m_force_map_res[3]);
+
+    auto eval = [this, fnomin](const double* x, double* out) {
+        double kappa = x[0];
+        double alpha = x[1];
+        double gamma = x[2];
+        m_Fz = x[3];
+        m_dF_z = (m_Fz - fnomin) / fnomin;
+        m_slip->gammaP = gamma;
+
+        out[0] = Fx_pureLong(gamma, kappa);
+        out[1] = Fy_pureLat(alpha, gamma);
+        Mz_pureLat(alpha, gamma, out[1]);
+        out[2] = m_pureTorque->MP_z;
+        out[3] = m_pureTorque->M_zr;
+        out[9] = m_pureLat->D_y;
+        out[4] = Fx_combined(alpha, gamma, kappa, out[0]);
+        out[5] = Fy_combined(alpha, gamma, kappa, out[1]);
+        Mz_combined(m_pureTorque->alpha_r, m_pureTorque->alpha_t, gamma, kappa, out[4], out[5]);
+        out[6] = m_combinedTorque->M_z_y;
+        out[7] = m_combinedTorque->M_zr;
+        out[8] = m_combinedTorque->M_z_x;
+        out[10] = std::abs(m_combinedTorque->alpha_r_eq);
+    };
+
+    if (!m_force_map.Build(eval, m_force_map_tol, m_force_map_max_nodes)) {
+        GetLog() << " force map for tire " << m_name << " did not reach the requested tolerance in all cells;"
+                 << " coverage = " << m_force_map.GetCoverage() << "\n";
+    }
+
+    *m_slip = slip;
+    *m_pureLong = pureLong;
+    *m_pureLat = pureLat;
+    *m_pureTorque = pureTorque;
+    *m_combinedLong = combinedLong;
+    *m_combinedLat = combinedLat;
+    *m_combinedTorque = combinedTorque;
+    m_Fz = Fz;
+    m_dF_z = dF_z;
+}
+
+// Evaluate the pure and combined slip reactions by interpolation in the force map.
+// Fall back to the analytic model (return false) outside the tabulated domain or if
+// the tire is rolling backward.
+bool ChPacejkaTire::forceMapReactions() {
+    if (!m_in_contact)
+        return true;
+
+    if (m_slip->V_cx < 0)
+        return false;
+
+    double x[4] = {m_slip->kappaP, m_slip->alphaP, m_slip->gammaP, m_Fz};
+    if (!m_force_map.InDomain(x))
+        return false;
+
+    double out[11];
+    m_force_map.Evaluate(x, out);
+
+    double c = m_slip->cosPrime_alpha;
+    m_FM_pure.force.x() = out[0];
+    m_FM_pure.force.y() = m_sameSide * out[1];
+    m_FM_pure.moment.z() = m_sameSide * c * (out[2] + out[3]);
+    m_FM_combined.force.x() = out[4];
+    m_FM_combined.force.y() = m_sameSide * out[5];
+    m_FM_combined.moment.z() = m_sameSide * (c * out[6] + c * c * out[7] + out[8]);
+
+    m_pureLat->D_y = out[9];
+    m_combinedTorque->alpha_r_eq = out[10];
+
+    return true;
+}
+
 void ChPacejkaTire::relaxationLengths() {
     double p_Ky4 = 2;  // according to Pac2002 model
     double p_Ky5 = 0;
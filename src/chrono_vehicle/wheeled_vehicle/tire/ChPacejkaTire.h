@@ -31,6 +31,7 @@
 #include "chrono_vehicle/ChTerrain.h"
 #include "chrono_vehicle/wheeled_vehicle/ChTire.h"
 #include "chrono_vehicle/wheeled_vehicle/tire/ChPac2002_data.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChTireForceMap.h"
 
 namespace chrono {
 namespace vehicle {
@@ -78,6 +79,35 @@ class CH_VEHICLE_API ChPacejkaTire : public ChTire {
     /// By default, the wheel is assumed not driven.
     void SetDrivenWheel(bool val) { m_driven = val; }
 
+    /// Enable/disable evaluation of the Magic Formula through a precomputed force map.
+    /// If enabled, the pure and combined slip forces and aligning moments are tabulated at Initialize()
+    /// over the slip, slip angle, camber, and vertical load ranges specified in the parameter file and
+    /// are then evaluated by multilinear interpolation. The grid is refined adaptively until the
+    /// interpolation error (relative to the range of each output) is below the given tolerance, or the
+    /// maximum number of grid nodes is reached (see SetForceMapResolution). Outside the tabulated domain,
+    /// in grid cells where the tolerance could not be met, or when the tire is rolling backward, the
+    /// analytic model is used. This function must be called before Initialize(). By default, the force
+    /// map mode is disabled.
+    void SetForceMapMode(bool val, double tolerance = 0.01) {
+        m_use_force_map = val;
+        m_force_map_tol = tolerance;
+    }
+
+    /// Set the initial number of grid nodes of the force map along the longitudinal slip, slip angle,
+    /// camber angle, and vertical load directions, and the maximum total number of grid nodes.
+    /// Default: 9 x 9 x 3 x 5 initial nodes, at most 50000 nodes (about 4.4 MB per tire). With the HMMWV
+    /// Pacejka parameters, the node limit is reached (about 49000 nodes) before the default 1% tolerance
+    /// is met everywhere: it is met in about 60% of the grid cells, and the analytic model is used in the
+    /// others (mostly around the force peaks, where the curves are steepest).
+    void SetForceMapResolution(int n_kappa, int n_alpha, int n_gamma, int n_Fz, int max_nodes = 50000);
+
+    /// Get the force map (for inspection).
+    const ChTireForceMap& GetForceMap() const { return m_force_map; }
+
+    /// Get the estimated maximum relative interpolation error of the force map (in the grid cells where
+    /// the force map is used).
+    double GetForceMapError() const { return m_force_map.GetMaxError(); }
+
     /// specify the file name to read the Pactire input from
     virtual void Initialize(std::shared_ptr<ChBody> wheel,  ///< handle to the associated wheel body
                             VehicleSide side                ///< [in] left/right vehicle side
@@ -339,6 +369,13 @@ class CH_VEHICLE_API ChPacejkaTire : public ChTire {
                        double Fx_combined,
                        double Fy_combined);
 
+    /// tabulate the Magic Formula reactions over the parameter file ranges
+    void buildForceMap();
+
+    /// evaluate the pure and combined slip reactions from the force map
+    /// return false if the current slips are outside the tabulated domain
+    bool forceMapReactions();
+
     /// calculate the overturning couple moment
     /// assign m_FM.moment.x and m_FM_combined.moment.x
     double calc_Mx(double gamma, double Fy_combined);
@@ -386,6 +423,12 @@ class CH_VEHICLE_API ChPacejkaTire : public ChTire {
     double m_C_Fx;
     double m_C_Fy;
 
+    bool m_use_force_map;          // evaluate reactions from a precomputed force map?
+    double m_force_map_tol;        // force map interpolation error tolerance
+    int m_force_map_res[4];        // initial force map resolution (kappa, alpha, gamma, Fz)
+    int m_force_map_max_nodes;     // maximum number of force map grid nodes
+    ChTireForceMap m_force_map;    // tabulated pure and combined slip reactions
+
     std::string m_paramFile;    // input parameter file
     std::string m_outFilename;  // output filename
 
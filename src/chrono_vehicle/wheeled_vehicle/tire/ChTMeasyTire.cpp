@@ -447,7 +447,7 @@ bool ChTMeasyTire::disc_terrain_contact_3d(
 
     // Find terrain height below disc center. There is no contact if the disc
     // center is below the terrain or farther away by more than its radius.
-    double hc = terrain.GetHeight(disc_center.x(), disc_center.y());
+    double hc = GetTerrainHeight(terrain, disc_center.x(), disc_center.y());
     if (disc_center.z() <= hc || disc_center.z() >= hc + disc_radius)
         return false;
 
@@ -464,23 +464,23 @@ bool ChTMeasyTire::disc_terrain_contact_3d(
 
     // Approximate the terrain with a plane. Define the projection of the lowest
     // point onto this plane as the contact point on the terrain.
-    ChVector<> normal = terrain.GetNormal(ptD.x(), ptD.y());
+    ChVector<> normal = GetTerrainNormal(terrain, ptD.x(), ptD.y());
     ChVector<> longitudinal = Vcross(disc_normal, normal);
     longitudinal.Normalize();
     ChVector<> lateral = Vcross(normal, longitudinal);
 
     // Calculate four contact points in the contact patch
     ChVector<> ptQ1 = ptD + dx * longitudinal;
-    ptQ1.z() = terrain.GetHeight(ptQ1.x(), ptQ1.y());
+    ptQ1.z() = GetTerrainHeight(terrain, ptQ1.x(), ptQ1.y());
 
     ChVector<> ptQ2 = ptD - dx * longitudinal;
-    ptQ2.z() = terrain.GetHeight(ptQ2.x(), ptQ2.y());
+    ptQ2.z() = GetTerrainHeight(terrain, ptQ2.x(), ptQ2.y());
 
     ChVector<> ptQ3 = ptD + dy * lateral;
-    ptQ3.z() = terrain.GetHeight(ptQ3.x(), ptQ3.y());
+    ptQ3.z() = GetTerrainHeight(terrain, ptQ3.x(), ptQ3.y());
 
     ChVector<> ptQ4 = ptD - dy * lateral;
-    ptQ4.z() = terrain.GetHeight(ptQ4.x(), ptQ4.y());
+    ptQ4.z() = GetTerrainHeight(terrain, ptQ4.x(), ptQ4.y());
 
     // Calculate a smoothed road surface normal
     ChVector<> rQ2Q1 = ptQ1 - ptQ2;
@@ -0,0 +1,378 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tabulated tire force map over a 4D tensor-product grid of (longitudinal slip,
+// slip angle, camber angle, vertical load), evaluated with multilinear
+// interpolation. The grid is refined adaptively, per axis.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono_vehicle/wheeled_vehicle/tire/ChTireForceMap.h"
+
+namespace chrono {
+namespace vehicle {
+
+ChTireForceMap::ChTireForceMap() : m_num_outputs(0), m_max_error(0), m_max_error_all(0) {
+    for (int d = 0; d < 4; d++)
+        m_nodes[d].assign(1, 0.0);
+}
+
+void ChTireForceMap::SetRange(int dim, double min_val, double max_val, int num_nodes) {
+    int n = (max_val > min_val) ? std::max(num_nodes, 2) : 1;
+    m_nodes[dim].resize(n);
+    for (int i = 0; i < n; i++)
+        m_nodes[dim][i] = (n > 1) ? min_val + i * (max_val - min_val) / (n - 1) : min_val;
+}
+
+int ChTireForceMap::GetNumNodes() const {
+    return (int)(m_nodes[0].size() * m_nodes[1].size() * m_nodes[2].size() * m_nodes[3].size());
+}
+
+// -----------------------------------------------------------------------------
+// Sample the analytic model at all grid nodes.
+// -----------------------------------------------------------------------------
+void ChTireForceMap::Sample(Evaluator& eval) {
+    m_data.resize(GetNumNodes() * m_num_outputs);
+
+    double x[4];
+    int idx = 0;
+    for (auto x3 : m_nodes[3]) {
+        x[3] = x3;
+        for (auto x2 : m_nodes[2]) {
+            x[2] = x2;
+            for (auto x1 : m_nodes[1]) {
+                x[1] = x1;
+                for (auto x0 : m_nodes[0]) {
+                    x[0] = x0;
+                    eval(x, &m_data[idx * m_num_outputs]);
+                    idx++;
+                }
+            }
+        }
+    }
+}
+
+void ChTireForceMap::ComputeOutputRanges() {
+    std::vector<double> vmin(m_num_outputs, 1e30);
+    std::vector<double> vmax(m_num_outputs, -1e30);
+    for (size_t i = 0; i < m_data.size(); i++) {
+        int k = i % m_num_outputs;
+        vmin[k] = std::min(vmin[k], m_data[i]);
+        vmax[k] = std::max(vmax[k], m_data[i]);
+    }
+    m_range.resize(m_num_outputs);
+    for (int k = 0; k < m_num_outputs; k++)
+        m_range[k] = std::max(vmax[k] - vmin[k], 1e-12);
+}
+
+double ChTireForceMap::RelativeError(const double* exact, const double* approx) const {
+    double err = 0;
+    for (int k = 0; k < m_num_outputs; k++)
+        err = std::max(err, std::abs(exact[k] - approx[k]) / m_range[k]);
+    return err;
+}
+
+// -----------------------------------------------------------------------------
+// One refinement pass. The error of the linear interpolation along each axis is
+// evaluated at the midpoints of the axis intervals, for all node combinations of
+// the other axes. Features which do not show on the grid lines (e.g. a steep
+// variation along a curve crossing the cells) are detected at the cell centers:
+// in a cell with an error above the tolerance, the axis to split is the one with
+// the largest error of the linear interpolation along it through the cell center.
+// A node is inserted at the midpoint of every interval with an error above the
+// tolerance, in order of decreasing error, as long as the total number of grid
+// nodes stays below the limit. Return false if no node was added.
+// -----------------------------------------------------------------------------
+bool ChTireForceMap::Refine(Evaluator& eval, double tolerance, int max_nodes) {
+    struct Candidate {
+        int dim;
+        int interval;
+        double error;
+    };
+    std::vector<Candidate> candidates;
+
+    int n[4];
+    int stride[4];
+    int s = 1;
+    for (int d = 0; d < 4; d++) {
+        n[d] = (int)m_nodes[d].size();
+        stride[d] = s;
+        s *= n[d];
+    }
+
+    std::vector<double> exact(m_num_outputs);
+    std::vector<double> approx(m_num_outputs);
+    double x[4];
+
+    // Error estimate of each interval along each axis
+    std::vector<double> err[4];
+    for (int d = 0; d < 4; d++)
+        err[d].assign(std::max(n[d] - 1, 0), 0.0);
+
+    for (int d = 0; d < 4; d++) {
+        if (n[d] < 2)
+            continue;
+        int i[4];
+        for (i[3] = 0; i[3] < n[3]; i[3]++) {
+            for (i[2] = 0; i[2] < n[2]; i[2]++) {
+                for (i[1] = 0; i[1] < n[1]; i[1]++) {
+                    for (i[0] = 0; i[0] < n[0]; i[0]++) {
+                        int j = i[d];
+                        if (j == n[d] - 1)
+                            continue;
+                        int a = i[0] * stride[0] + i[1] * stride[1] + i[2] * stride[2] + i[3] * stride[3];
+                        int b = a + stride[d];
+                        for (int k = 0; k < 4; k++)
+                            x[k] = m_nodes[k][i[k]];
+                        x[d] = 0.5 * (m_nodes[d][j] + m_nodes[d][j + 1]);
+                        eval(x, exact.data());
+                        for (int k = 0; k < m_num_outputs; k++)
+                            approx[k] = 0.5 * (m_data[a * m_num_outputs + k] + m_data[b * m_num_outputs + k]);
+                        err[d][j] = std::max(err[d][j], RelativeError(exact.data(), approx.data()));
+                    }
+                }
+            }
+        }
+    }
+
+    int nc[4];
+    for (int d = 0; d < 4; d++)
+        nc[d] = std::max(n[d] - 1, 1);
+    std::vector<double> exact_lo(m_num_outputs);
+    std::vector<double> exact_hi(m_num_outputs);
+    int c[4];
+    for (c[3] = 0; c[3] < nc[3]; c[3]++) {
+        for (c[2] = 0; c[2] < nc[2]; c[2]++) {
+            for (c[1] = 0; c[1] < nc[1]; c[1]++) {
+                for (c[0] = 0; c[0] < nc[0]; c[0]++) {
+                    for (int k = 0; k < 4; k++)
+                        x[k] = (n[k] > 1) ? 0.5 * (m_nodes[k][c[k]] + m_nodes[k][c[k] + 1]) : m_nodes[k][0];
+                    eval(x, exact.data());
+                    Evaluate(x, approx.data());
+                    double e = RelativeError(exact.data(), approx.data());
+                    if (e <= tolerance)
+                        continue;
+                    int d_split = -1;
+                    double e_split = -1;
+                    for (int d = 0; d < 4; d++) {
+                        if (n[d] < 2)
+                            continue;
+                        double xd = x[d];
+                        x[d] = m_nodes[d][c[d]];
+                        eval(x, exact_lo.data());
+                        x[d] = m_nodes[d][c[d] + 1];
+                        eval(x, exact_hi.data());
+                        x[d] = xd;
+                        for (int k = 0; k < m_num_outputs; k++)
+                            approx[k] = 0.5 * (exact_lo[k] + exact_hi[k]);
+                        double e_d = RelativeError(exact.data(), approx.data());
+                        if (e_d > e_split) {
+                            e_split = e_d;
+                            d_split = d;
+                        }
+                    }
+                    if (d_split >= 0)
+                        err[d_split][c[d_split]] = std::max(err[d_split][c[d_split]], e);
+                }
+            }
+        }
+    }
+
+    for (int d = 0; d < 4; d++) {
+        for (int j = 0; j < n[d] - 1; j++) {
+            if (err[d][j] > tolerance)
+                candidates.push_back({d, j, err[d][j]});
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(),
+              [](const Candidate& c1, const Candidate& c2) { return c1.error > c2.error; });
+
+    // Select the intervals to split, within the node budget
+    int added[4] = {0, 0, 0, 0};
+    std::vector<double> new_nodes[4];
+    for (const auto& c : candidates) {
+        added[c.dim]++;
+        double total = 1;
+        for (int d = 0; d < 4; d++)
+            total *= n[d] + added[d];
+        if (total > max_nodes) {
+            added[c.dim]--;
+            continue;
+        }
+        new_nodes[c.dim].push_back(0.5 * (m_nodes[c.dim][c.interval] + m_nodes[c.dim][c.interval + 1]));
+    }
+
+    bool refined = false;
+    for (int d = 0; d < 4; d++) {
+        if (new_nodes[d].empty())
+            continue;
+        m_nodes[d].insert(m_nodes[d].end(), new_nodes[d].begin(), new_nodes[d].end());
+        std::sort(m_nodes[d].begin(), m_nodes[d].end());
+        refined = true;
+    }
+
+    return refined;
+}
+
+// -----------------------------------------------------------------------------
+// Estimate the maximum interpolation error, relative to the range of each
+// output, by comparing with the analytic model at all cell centers. Cells with
+// an error above the tolerance are excluded from the domain of the map.
+// -----------------------------------------------------------------------------
+void ChTireForceMap::EstimateError(Evaluator& eval, double tolerance) {
+    int nc[4];
+    int num_cells = 1;
+    for (int d = 0; d < 4; d++) {
+        nc[d] = std::max((int)m_nodes[d].size() - 1, 1);
+        num_cells *= nc[d];
+    }
+    m_cell_valid.assign(num_cells, true);
+
+    auto center = [this](int d, int i) {
+        return (m_nodes[d].size() > 1) ? 0.5 * (m_nodes[d][i] + m_nodes[d][i + 1]) : m_nodes[d][0];
+    };
+
+    std::vector<double> exact(m_num_outputs);
+    std::vector<double> approx(m_num_outputs);
+    m_max_error = 0;
+    m_max_error_all = 0;
+    double x[4];
+    int i[4];
+    for (i[3] = 0; i[3] < nc[3]; i[3]++) {
+        x[3] = center(3, i[3]);
+        for (i[2] = 0; i[2] < nc[2]; i[2]++) {
+            x[2] = center(2, i[2]);
+            for (i[1] = 0; i[1] < nc[1]; i[1]++) {
+                x[1] = center(1, i[1]);
+                for (i[0] = 0; i[0] < nc[0]; i[0]++) {
+                    x[0] = center(0, i[0]);
+                    eval(x, exact.data());
+                    Evaluate(x, approx.data());
+                    double err = RelativeError(exact.data(), approx.data());
+                    m_max_error_all = std::max(m_max_error_all, err);
+                    if (err > tolerance)
+                        m_cell_valid[CellIndex(i)] = false;
+                    else
+                        m_max_error = std::max(m_max_error, err);
+                }
+            }
+        }
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Build the table, refining the grid until the error tolerance is met.
+// -----------------------------------------------------------------------------
+bool ChTireForceMap::Build(Evaluator eval, double tolerance, int max_nodes) {
+    Sample(eval);
+    ComputeOutputRanges();
+
+    while (Refine(eval, tolerance, max_nodes)) {
+        Sample(eval);
+    }
+
+    EstimateError(eval, tolerance);
+
+    return m_max_error_all <= tolerance;
+}
+
+double ChTireForceMap::GetCoverage() const {
+    if (m_cell_valid.empty())
+        return 0;
+    return (double)std::count(m_cell_valid.begin(), m_cell_valid.end(), true) / m_cell_valid.size();
+}
+
+int ChTireForceMap::CellIndex(const int* i) const {
+    int index = 0;
+    for (int d = 3; d >= 0; d--)
+        index = index * std::max((int)m_nodes[d].size() - 1, 1) + i[d];
+    return index;
+}
+
+bool ChTireForceMap::InDomain(const double* x) const {
+    int i[4];
+    for (int d = 0; d < 4; d++) {
+        if (m_nodes[d].size() > 1) {
+            if (x[d] < m_nodes[d].front() || x[d] > m_nodes[d].back())
+                return false;
+            i[d] = FindInterval(d, x[d]);
+        } else {
+            i[d] = 0;
+        }
+    }
+    return m_cell_valid.empty() || m_cell_valid[CellIndex(i)];
+}
+
+// Index of the grid interval containing x (clamped to the first and last interval).
+int ChTireForceMap::FindInterval(int dim, double x) const {
+    const auto& nodes = m_nodes[dim];
+    int i = (int)(std::upper_bound(nodes.begin(), nodes.end(), x) - nodes.begin()) - 1;
+    return std::min(std::max(i, 0), (int)nodes.size() - 2);
+}
+
+// -----------------------------------------------------------------------------
+// Multilinear interpolation over the 16 corners of the grid cell containing the
+// (clamped) query point.
+// -----------------------------------------------------------------------------
+void ChTireForceMap::Evaluate(const double* x, double* out) const {
+    int i[4];
+    double t[4];
+    int stride[4];
+    int s = 1;
+    for (int d = 0; d < 4; d++) {
+        int n = (int)m_nodes[d].size();
+        if (n > 1) {
+            i[d] = FindInterval(d, x[d]);
+            double x0 = m_nodes[d][i[d]];
+            double x1 = m_nodes[d][i[d] + 1];
+            double u = (std::min(std::max(x[d], x0), x1) - x0) / (x1 - x0);
+            t[d] = u;
+            stride[d] = s;
+        } else {
+            i[d] = 0;
+            t[d] = 0;
+            stride[d] = 0;
+        }
+        s *= n;
+    }
+
+    int base = i[0] + (int)m_nodes[0].size() *
+                          (i[1] + (int)m_nodes[1].size() * (i[2] + (int)m_nodes[2].size() * i[3]));
+
+    for (int k = 0; k < m_num_outputs; k++)
+        out[k] = 0;
+
+    for (int c = 0; c < 16; c++) {
+        double w = 1;
+        int offset = base;
+        for (int d = 0; d < 4; d++) {
+            if (c & (1 << d)) {
+                w *= t[d];
+                offset += stride[d];
+            } else {
+                w *= 1 - t[d];
+            }
+        }
+        if (w == 0)
+            continue;
+        const double* node = &m_data[offset * m_num_outputs];
+        for (int k = 0; k < m_num_outputs; k++)
+            out[k] += w * node[k];
+    }
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
@@ -0,0 +1,119 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Tabulated tire force map over a 4D tensor-product grid of (longitudinal slip,
+// slip angle, camber angle, vertical load), evaluated with multilinear
+// interpolation. The grid is refined adaptively, per axis.
+//
+// =============================================================================
+
+#ifndef CH_TIRE_FORCE_MAP_H
+#define CH_TIRE_FORCE_MAP_H
+
+#include <functional>
+#include <vector>
+
+#include "chrono_vehicle/ChApiVehicle.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_wheeled_tire
+/// @{
+
+/// Precomputed tire force map.
+/// A force map tabulates a set of tire outputs (e.g. forces and moments) over a tensor-product grid in
+/// the 4-dimensional space of (longitudinal slip, slip angle, camber angle, vertical load). The table is
+/// built once from an analytic tire model and is then evaluated with multilinear interpolation.
+/// The grid nodes along each axis are not equally spaced: during the build, nodes are inserted only in
+/// the intervals where the interpolation error is above the tolerance (e.g. around the peak of the slip
+/// curves), subject to a limit on the total number of grid nodes. Grid cells in which the tolerance is
+/// still not met when the node limit is reached are excluded from the domain of the map (see InDomain),
+/// so that the caller falls back to the analytic model there.
+/// The output values at each grid node are stored contiguously, so that the interpolation loop over
+/// outputs is amenable to compiler vectorization.
+class CH_VEHICLE_API ChTireForceMap {
+  public:
+    /// Function type used to evaluate the analytic model at a given point.
+    /// The function is passed the input coordinates (kappa, alpha, gamma, Fz) and must fill in the
+    /// output array (of size equal to the number of outputs).
+    typedef std::function<void(const double* x, double* out)> Evaluator;
+
+    ChTireForceMap();
+
+    /// Set the number of tabulated outputs.
+    void SetNumOutputs(int num_outputs) { m_num_outputs = num_outputs; }
+
+    /// Set the range and initial (uniform) number of grid nodes along the specified input dimension (0 to 3).
+    void SetRange(int dim, double min_val, double max_val, int num_nodes);
+
+    /// Build the table by sampling the given analytic model at all grid nodes.
+    /// After sampling, the interpolation error along each axis is estimated at the interval midpoints and
+    /// a node is inserted in every interval where the error, relative to the range of each output, is
+    /// above the specified tolerance. Refinement stops when the tolerance is met or when inserting more
+    /// nodes would exceed 'max_nodes' in total. The final error is then estimated at all cell centers, and
+    /// the cells where it is above the tolerance are excluded from the domain of the map.
+    /// Return true if the tolerance was met in all cells.
+    bool Build(Evaluator eval, double tolerance, int max_nodes = 100000);
+
+    /// Return true if the given point is inside the tabulated domain, in a grid cell where the map
+    /// meets the tolerance.
+    bool InDomain(const double* x) const;
+
+    /// Evaluate the map at the given point, using multilinear interpolation.
+    /// The input point is clamped to the tabulated domain.
+    void Evaluate(const double* x, double* out) const;
+
+    /// Get the maximum relative interpolation error estimated during the last call to Build(), over the
+    /// grid cells in the domain of the map.
+    double GetMaxError() const { return m_max_error; }
+
+    /// Get the maximum relative interpolation error estimated during the last call to Build(), over all
+    /// grid cells (including those excluded from the domain of the map).
+    double GetMaxErrorAll() const { return m_max_error_all; }
+
+    /// Get the fraction of grid cells in the domain of the map.
+    double GetCoverage() const;
+
+    /// Get the number of grid nodes along the specified dimension.
+    int GetNumNodes(int dim) const { return (int)m_nodes[dim].size(); }
+
+    /// Get the total number of grid nodes.
+    int GetNumNodes() const;
+
+    /// Get the memory used by the tabulated outputs (in bytes).
+    size_t GetMemorySize() const { return m_data.size() * sizeof(double); }
+
+  private:
+    void Sample(Evaluator& eval);
+    void ComputeOutputRanges();
+    double RelativeError(const double* exact, const double* approx) const;
+    bool Refine(Evaluator& eval, double tolerance, int max_nodes);
+    void EstimateError(Evaluator& eval, double tolerance);
+    int FindInterval(int dim, double x) const;
+    int CellIndex(const int* i) const;
+
+    int m_num_outputs;                  ///< number of outputs per grid node
+    std::vector<double> m_nodes[4];     ///< grid node coordinates along each dimension (increasing)
+    std::vector<double> m_data;         ///< tabulated outputs (node-major, outputs contiguous)
+    std::vector<double> m_range;        ///< range of each output over the grid nodes
+    std::vector<bool> m_cell_valid;     ///< cells in which the tolerance is met
+    double m_max_error;                 ///< estimated maximum relative interpolation error (valid cells)
+    double m_max_error_all;             ///< estimated maximum relative interpolation error (all cells)
+};
+
+/// @} vehicle_wheeled_tire
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
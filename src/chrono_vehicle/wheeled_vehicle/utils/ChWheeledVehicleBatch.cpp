@@ -0,0 +1,148 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Batch of independent wheeled vehicles, advanced together.
+// Each vehicle lives in its own Chrono system. Wheel states and terrain data
+// for all tires are kept in flat (structure-of-arrays) buffers, the terrain is
+// queried once per tire in a single pass, and the tire models and vehicle
+// systems are advanced in parallel.
+//
+// =============================================================================
+
+#include "chrono/parallel/ChTaskScheduler.h"
+
+#include "chrono_vehicle/wheeled_vehicle/utils/ChWheeledVehicleBatch.h"
+
+namespace chrono {
+namespace vehicle {
+
+ChWheeledVehicleBatch::ChWheeledVehicleBatch() : m_time(0) {}
+
+void ChWheeledVehicleBatch::SetNumThreads(int num_threads) {
+    ChTaskScheduler::GetInstance().SetNumThreads(num_threads);
+}
+
+int ChWheeledVehicleBatch::AddVehicle(ChWheeledVehicle* vehicle,
+                                      ChPowertrain* powertrain,
+                                      const ChTireList& tires,
+                                      ChTerrain* terrain,
+                                      ChDriver* driver) {
+    VehicleEntry entry;
+    entry.vehicle = vehicle;
+    entry.powertrain = powertrain;
+    entry.terrain = terrain;
+    entry.driver = driver;
+    entry.first_tire = (int)m_tires.size();
+    entry.num_tires = (int)tires.size();
+
+    int index = (int)m_vehicles.size();
+    m_vehicles.push_back(entry);
+
+    for (auto tire : tires) {
+        m_tires.push_back(tire.get());
+        m_tire_vehicle.push_back(index);
+    }
+
+    size_t num_tires = m_tires.size();
+    m_wheel_states.resize(num_tires);
+    m_tire_forces.resize(num_tires);
+    m_wheel_x.resize(num_tires);
+    m_wheel_y.resize(num_tires);
+    m_wheel_z.resize(num_tires);
+    m_height.resize(num_tires);
+    m_normal_x.resize(num_tires);
+    m_normal_y.resize(num_tires);
+    m_normal_z.resize(num_tires);
+
+    m_time = vehicle->GetChTime();
+
+    return index;
+}
+
+// -----------------------------------------------------------------------------
+// Synchronize and advance all vehicles in the batch.
+// Vehicles are independent (each in its own Chrono system, with its own
+// terrain), so all per-tire and per-vehicle loops are processed in parallel.
+// -----------------------------------------------------------------------------
+void ChWheeledVehicleBatch::Advance(double step) {
+    int num_tires = (int)m_tires.size();
+    int num_vehicles = (int)m_vehicles.size();
+
+    // Gather the states of all wheels.
+    ChParallelFor(0, num_tires, 8, [&](int i) {
+        const VehicleEntry& entry = m_vehicles[m_tire_vehicle[i]];
+        m_wheel_states[i] = entry.vehicle->GetWheelState(WheelID(i - entry.first_tire));
+        m_wheel_x[i] = m_wheel_states[i].pos.x();
+        m_wheel_y[i] = m_wheel_states[i].pos.y();
+        m_wheel_z[i] = m_wheel_states[i].pos.z();
+    });
+
+    // Single terrain pass: height and normal below each wheel.
+    ChParallelFor(0, num_tires, 8, [&](int i) {
+        const ChTerrain* terrain = m_vehicles[m_tire_vehicle[i]].terrain;
+        ChVector<> normal = terrain->GetNormal(m_wheel_x[i], m_wheel_y[i]);
+        m_height[i] = terrain->GetHeight(m_wheel_x[i], m_wheel_y[i]);
+        m_normal_x[i] = normal.x();
+        m_normal_y[i] = normal.y();
+        m_normal_z[i] = normal.z();
+    });
+
+    // Tire pass: collect the tire forces from the previous step, then synchronize the tire models
+    // (with the terrain data below the wheel centers) and advance them.
+    ChParallelFor(0, num_tires, 1, [&](int i) {
+        const ChTerrain& terrain = *m_vehicles[m_tire_vehicle[i]].terrain;
+        ChTire* tire = m_tires[i];
+
+        m_tire_forces[i] = tire->GetTireForce();
+        tire->SetTerrainData(m_wheel_x[i], m_wheel_y[i], m_height[i],
+                             ChVector<>(m_normal_x[i], m_normal_y[i], m_normal_z[i]));
+        tire->Synchronize(m_time, m_wheel_states[i], terrain);
+        tire->Advance(step);
+        tire->ClearTerrainData();
+    });
+
+    // Vehicle pass: synchronize and advance each vehicle, powertrain, and driver.
+    ChParallelFor(0, num_vehicles, 1, [&](int iv) {
+        VehicleEntry& entry = m_vehicles[iv];
+
+        double throttle = 0;
+        double steering = 0;
+        double braking = 0;
+        if (entry.driver) {
+            entry.driver->Synchronize(m_time);
+            throttle = entry.driver->GetThrottle();
+            steering = entry.driver->GetSteering();
+            braking = entry.driver->GetBraking();
+        }
+
+        TerrainForces tire_forces(m_tire_forces.begin() + entry.first_tire,
+                                  m_tire_forces.begin() + entry.first_tire + entry.num_tires);
+
+        double powertrain_torque = entry.powertrain->GetOutputTorque();
+        double driveshaft_speed = entry.vehicle->GetDriveshaftSpeed();
+
+        entry.terrain->Synchronize(m_time);
+        entry.powertrain->Synchronize(m_time, throttle, driveshaft_speed);
+        entry.vehicle->Synchronize(m_time, steering, braking, powertrain_torque, tire_forces);
+
+        if (entry.driver)
+            entry.driver->Advance(step);
+        entry.terrain->Advance(step);
+        entry.powertrain->Advance(step);
+        entry.vehicle->Advance(step);
+    });
+
+    m_time += step;
+}
+
+}  // end namespace vehicle
+}  // end namespace chrono
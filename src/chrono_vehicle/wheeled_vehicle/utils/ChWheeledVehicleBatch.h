@@ -0,0 +1,126 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Batch of independent wheeled vehicles, advanced together.
+// Each vehicle lives in its own Chrono system. Wheel states and terrain data
+// for all tires are kept in flat (structure-of-arrays) buffers, the terrain is
+// queried once per tire in a single pass, and the tire models and vehicle
+// systems are advanced in parallel with the Chrono task scheduler.
+//
+// =============================================================================
+
+#ifndef CH_WHEELED_VEHICLE_BATCH_H
+#define CH_WHEELED_VEHICLE_BATCH_H
+
+#include <vector>
+
+#include "chrono_vehicle/ChApiVehicle.h"
+#include "chrono_vehicle/ChDriver.h"
+#include "chrono_vehicle/ChPowertrain.h"
+#include "chrono_vehicle/ChTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/ChTire.h"
+#include "chrono_vehicle/wheeled_vehicle/ChWheeledVehicle.h"
+
+namespace chrono {
+namespace vehicle {
+
+/// @addtogroup vehicle_wheeled_utils
+/// @{
+
+/// Batch of independent wheeled vehicles.
+/// Intended for traffic and fleet studies with many vehicles that do not interact with each other.
+/// Each vehicle must be created in its own Chrono system, together with its own terrain object.
+/// At each step, the terrain height and normal below every wheel are evaluated in a single pass and
+/// cached in flat arrays. These values are passed to the tire models (see ChTire::SetTerrainData),
+/// which use them for their queries at the wheel center and still query the terrain object at any
+/// other location, so that the results are the same as when each vehicle is simulated on its own.
+/// Tires and vehicles are processed in parallel with the Chrono task scheduler (see ChTaskScheduler),
+/// which is also used by the vehicle systems themselves, so that there is a single pool of threads.
+class CH_VEHICLE_API ChWheeledVehicleBatch {
+  public:
+    ChWheeledVehicleBatch();
+
+    ~ChWheeledVehicleBatch() {}
+
+    /// Add a vehicle to this batch and return its index.
+    /// The tires must be listed in the same order as the vehicle wheels. The terrain must be associated
+    /// with the same Chrono system as the vehicle. If no driver is provided, all driver inputs are zero.
+    int AddVehicle(ChWheeledVehicle* vehicle,  ///< [in] vehicle system (already initialized)
+                   ChPowertrain* powertrain,   ///< [in] associated powertrain (already initialized)
+                   const ChTireList& tires,    ///< [in] associated tires (already initialized)
+                   ChTerrain* terrain,         ///< [in] terrain associated with this vehicle's system
+                   ChDriver* driver = nullptr  ///< [in] optional driver system
+                   );
+
+    /// Set the number of threads used to process the batch.
+    /// This sets the number of threads of the Chrono task scheduler, shared by all Chrono systems.
+    void SetNumThreads(int num_threads);
+
+    /// Get the number of vehicles in this batch.
+    int GetNumVehicles() const { return (int)m_vehicles.size(); }
+
+    /// Get the total number of tires in this batch.
+    int GetNumTires() const { return (int)m_tires.size(); }
+
+    /// Get the current simulation time.
+    double GetChTime() const { return m_time; }
+
+    /// Synchronize and advance all vehicles in the batch by the specified step.
+    void Advance(double step);
+
+    /// Get the global x coordinates of all wheel centers, for all vehicles.
+    const std::vector<double>& GetWheelPosX() const { return m_wheel_x; }
+
+    /// Get the global y coordinates of all wheel centers, for all vehicles.
+    const std::vector<double>& GetWheelPosY() const { return m_wheel_y; }
+
+    /// Get the global z coordinates of all wheel centers, for all vehicles.
+    const std::vector<double>& GetWheelPosZ() const { return m_wheel_z; }
+
+    /// Get the terrain heights below all wheel centers, for all vehicles.
+    const std::vector<double>& GetTerrainHeight() const { return m_height; }
+
+  private:
+    /// Vehicle entry in the batch.
+    struct VehicleEntry {
+        ChWheeledVehicle* vehicle;
+        ChPowertrain* powertrain;
+        ChTerrain* terrain;
+        ChDriver* driver;
+        int first_tire;  ///< index of first tire of this vehicle in the flat tire arrays
+        int num_tires;   ///< number of tires of this vehicle
+    };
+
+    std::vector<VehicleEntry> m_vehicles;  ///< list of vehicles in the batch
+    std::vector<ChTire*> m_tires;          ///< flat list of all tires
+    std::vector<int> m_tire_vehicle;       ///< index of the owning vehicle for each tire
+
+    std::vector<WheelState> m_wheel_states;  ///< wheel states for all tires
+    std::vector<TerrainForce> m_tire_forces;  ///< tire forces for all tires
+
+    std::vector<double> m_wheel_x;  ///< wheel center x coordinates (SoA)
+    std::vector<double> m_wheel_y;  ///< wheel center y coordinates (SoA)
+    std::vector<double> m_wheel_z;  ///< wheel center z coordinates (SoA)
+    std::vector<double> m_height;   ///< terrain height below each wheel (SoA)
+    std::vector<double> m_normal_x;  ///< terrain normal x component below each wheel (SoA)
+    std::vector<double> m_normal_y;  ///< terrain normal y component below each wheel (SoA)
+    std::vector<double> m_normal_z;  ///< terrain normal z component below each wheel (SoA)
+
+    double m_time;  ///< current simulation time
+};
+
+/// @} vehicle_wheeled_utils
+
+}  // end namespace vehicle
+}  // end namespace chrono
+
+#endif
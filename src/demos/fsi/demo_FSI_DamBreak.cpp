@@ -217,6 +217,7 @@ int main(int argc, char* argv[]) {
 #else
     printf("Single Precision\n");
 #endif
+    printf("%s backend\n", fsi::ChSystemFsi::GetBackend() == fsi::ChSystemFsi::CUDA ? "CUDA" : "Multicore CPU");
     int stepEnd = int(paramsH->tFinal / paramsH->dT);
     stepEnd = 1000000;
     std::vector<std::vector<double>> vCoor;
@@ -462,6 +462,7 @@ int main(int argc, char* argv[]) {
 #else
     printf("Single Precision\n");
 #endif
+    printf("%s backend\n", fsi::ChSystemFsi::GetBackend() == fsi::ChSystemFsi::CUDA ? "CUDA" : "Multicore CPU");
     int stepEnd = int(paramsH->tFinal / paramsH->dT);
     for (int tStep = 0; tStep < stepEnd + 1; tStep++) {
         printf("step : %d \n", tStep);
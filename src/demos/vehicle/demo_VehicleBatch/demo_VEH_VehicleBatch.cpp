@@ -0,0 +1,119 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Benchmark for batched stepping of many independent wheeled vehicles.
+// Each vehicle is a reduced HMMWV model with a simple powertrain and Pac89
+// tires, running on its own flat rigid terrain. The aggregate throughput is
+// reported in vehicle-steps per second.
+//
+// Usage: demo_VEH_VehicleBatch [num_vehicles] [num_threads]
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "chrono/core/ChTimer.h"
+
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/utils/ChWheeledVehicleBatch.h"
+
+#include "chrono_models/vehicle/hmmwv/HMMWV_VehicleReduced.h"
+#include "chrono_models/vehicle/hmmwv/HMMWV_SimplePowertrain.h"
+#include "chrono_models/vehicle/hmmwv/HMMWV_Pac89Tire.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+using namespace chrono::vehicle::hmmwv;
+
+// =============================================================================
+
+// Simulation step size and duration
+double step_size = 1e-3;
+double t_end = 2;
+
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    int num_vehicles = (argc > 1) ? std::atoi(argv[1]) : 16;
+    int num_threads = (argc > 2) ? std::atoi(argv[2]) : std::max((int)std::thread::hardware_concurrency(), 1);
+
+    GetLog() << "Copyright (c) 2017 projectchrono.org\nChrono version: " << CHRONO_VERSION << "\n\n";
+
+    std::vector<std::shared_ptr<HMMWV_VehicleReduced>> vehicles;
+    std::vector<std::shared_ptr<HMMWV_SimplePowertrain>> powertrains;
+    std::vector<std::shared_ptr<RigidTerrain>> terrains;
+    std::vector<std::shared_ptr<ChDriver>> drivers;
+
+    ChWheeledVehicleBatch batch;
+    batch.SetNumThreads(num_threads);
+
+    for (int iv = 0; iv < num_vehicles; iv++) {
+        // Vehicle, in its own Chrono system
+        auto vehicle = std::make_shared<HMMWV_VehicleReduced>(false, DrivelineType::RWD, ChMaterialSurface::NSC,
+                                                              ChassisCollisionType::NONE);
+        vehicle->SetStepsize(step_size);
+        vehicle->Initialize(ChCoordsys<>(ChVector<>(0, 0, 1.6), QUNIT));
+
+        // Powertrain
+        auto powertrain = std::make_shared<HMMWV_SimplePowertrain>("Powertrain");
+        powertrain->Initialize(vehicle->GetChassisBody(), vehicle->GetDriveshaft());
+
+        // Tires
+        ChTireList tires(4);
+        tires[0] = std::make_shared<HMMWV_Pac89Tire>("FL");
+        tires[1] = std::make_shared<HMMWV_Pac89Tire>("FR");
+        tires[2] = std::make_shared<HMMWV_Pac89Tire>("RL");
+        tires[3] = std::make_shared<HMMWV_Pac89Tire>("RR");
+        for (int i = 0; i < 4; i++)
+            tires[i]->Initialize(vehicle->GetWheelBody(WheelID(i)), WheelID(i).side());
+
+        // Flat rigid terrain
+        auto terrain = std::make_shared<RigidTerrain>(vehicle->GetSystem());
+        terrain->AddPatch(ChCoordsys<>(ChVector<>(0, 0, -5), QUNIT), ChVector<>(200, 200, 10));
+        terrain->Initialize();
+
+        // Constant driver inputs, varying slightly across the fleet
+        auto driver = std::make_shared<ChDriver>(*vehicle);
+        driver->SetThrottle(0.5);
+        driver->SetSteering(0.2 * (iv % 5 - 2) / 2.0);
+
+        batch.AddVehicle(vehicle.get(), powertrain.get(), tires, terrain.get(), driver.get());
+
+        vehicles.push_back(vehicle);
+        powertrains.push_back(powertrain);
+        terrains.push_back(terrain);
+        drivers.push_back(driver);
+    }
+
+    GetLog() << "Vehicles: " << batch.GetNumVehicles() << "  tires: " << batch.GetNumTires()
+             << "  threads: " << num_threads << "\n";
+
+    // Simulation loop
+    ChTimer<double> timer;
+    int num_steps = 0;
+    timer.start();
+    while (batch.GetChTime() < t_end) {
+        batch.Advance(step_size);
+        num_steps++;
+    }
+    timer.stop();
+
+    double vehicle_steps = (double)num_steps * num_vehicles;
+    GetLog() << "Steps: " << num_steps << "  wall time: " << timer() << " s\n";
+    GetLog() << "Throughput: " << vehicle_steps / timer() << " vehicle-steps/s\n";
+
+    return 0;
+}
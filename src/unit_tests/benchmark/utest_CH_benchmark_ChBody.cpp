@@ -11,8 +11,10 @@
 // =============================================================================
 
 #include <iostream>
+#include <vector>
 
 #include "../ChTestConfig.h"
+#include "chrono/parallel/ChOpenMP.h"
 #include "chrono/physics/ChSystemNSC.h"
 
 using namespace chrono;
@@ -77,5 +79,59 @@ int main() {
     timer.stop();
     cout << "SIngle Loop " << timer() << endl;
 
+    // Scaling of the (parallel) assembly-level loops with the number of threads.
+    // The state and residual must be identical for any number of threads.
+    dynamics_system.Setup();
+    int nx = dynamics_system.GetNcoords_x();
+    int nv = dynamics_system.GetNcoords_v();
+    ChState x(nx, &dynamics_system);
+    ChStateDelta v(nv, &dynamics_system);
+    ChVectorDynamic<> R(nv);
+    double T;
+
+    ChVectorDynamic<> R_ref;
+    int max_threads = CHOMPfunctions::GetNumProcs();
+    std::vector<int> thread_counts;
+    for (int nthreads = 1; nthreads < max_threads; nthreads *= 2)
+        thread_counts.push_back(nthreads);
+    if (max_threads > 1)
+        thread_counts.push_back(max_threads);
+
+    for (auto nthreads : thread_counts) {
+        dynamics_system.SetParallelThreadNumber(nthreads);
+        cout << endl << "Assembly loops, threads: " << nthreads << endl;
+
+        full.reset();
+        full.start();
+
+#define TIMESYSTEM(X, Y)  \
+    timer.reset();        \
+    timer.start();        \
+    dynamics_system.X;    \
+    timer.stop();         \
+    cout << Y << timer() << endl;
+
+        TIMESYSTEM(Update(false), "Update ");
+        TIMESYSTEM(IntStateGather(0, x, 0, v, T), "IntStateGather ");
+        TIMESYSTEM(IntStateScatter(0, x, 0, v, current_time), "IntStateScatter ");
+        R.FillElem(0);
+        TIMESYSTEM(IntLoadResidual_F(0, R, time_step), "IntLoadResidual_F ");
+        TIMESYSTEM(IntLoadResidual_Mv(0, R, v, 1.0), "IntLoadResidual_Mv ");
+        TIMESYSTEM(VariablesFbReset(), "VariablesFbReset ");
+        TIMESYSTEM(VariablesFbLoadForces(time_step), "VariablesFbLoadForces ");
+        TIMESYSTEM(VariablesQbLoadSpeed(), "VariablesQbLoadSpeed ");
+        TIMESYSTEM(VariablesQbIncrementPosition(time_step), "VariablesQbIncrementPosition ");
+
+        full.stop();
+        cout << "Total: " << full() << endl;
+
+        if (nthreads == 1)
+            R_ref = R;
+        bool same = true;
+        for (int i = 0; i < nv; i++)
+            same = same && (R(i) == R_ref(i));
+        cout << "Residual identical to 1 thread: " << (same ? "yes" : "NO") << endl;
+    }
+
     return 0;
 }
@@ -0,0 +1,227 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the Chrono task scheduler (ChTaskScheduler).
+// For different numbers of threads, the test checks:
+// - nested parallel loops (every index visited exactly once);
+// - reductions (same result, bit for bit, for any number of threads);
+// - exceptions thrown by tasks (rethrown by the waiting thread, also when nested);
+// - task graphs (dependencies respected);
+// - the deprecated ChThreads interface;
+// - that a thread waiting for tasks running on other threads does not spin.
+//
+// =============================================================================
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <time.h>
+#endif
+
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono/parallel/ChThreads.h"
+
+using namespace chrono;
+
+bool TestNestedFor() {
+    const int n_outer = 37;
+    const int n_inner = 113;
+    std::vector<std::atomic<int>> visits(n_outer * n_inner);
+    for (auto& v : visits)
+        v = 0;
+
+    ChParallelFor(0, n_outer, 1, [&](int i) {
+        ChParallelFor(0, n_inner, 5, [&](int j) { visits[i * n_inner + j]++; });
+    });
+
+    for (auto& v : visits) {
+        if (v != 1) {
+            printf("  nested loop: index visited %d times\n", v.load());
+            return false;
+        }
+    }
+    return true;
+}
+
+double Reduce() {
+    const int n = 100000;
+    return ChParallelReduce(0, n, 1000, 0.0,
+                            [](int from, int to, double sum) {
+                                for (int i = from; i < to; i++)
+                                    sum += std::sin(0.001 * i) / (1.0 + i);
+                                return sum;
+                            },
+                            [](double a, double b) { return a + b; });
+}
+
+bool TestExceptions() {
+    // Exception thrown in a parallel loop.
+    bool caught = false;
+    try {
+        ChParallelFor(0, 100, 1, [](int i) {
+            if (i == 57)
+                throw std::runtime_error("task failure");
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    if (!caught) {
+        printf("  exception in parallel loop not rethrown\n");
+        return false;
+    }
+
+    // Exception thrown in a nested parallel loop.
+    caught = false;
+    try {
+        ChParallelFor(0, 8, 1, [](int i) {
+            ChParallelFor(0, 50, 1, [i](int j) {
+                if (i == 3 && j == 21)
+                    throw std::runtime_error("nested task failure");
+            });
+        });
+    } catch (const std::runtime_error&) {
+        caught = true;
+    }
+    if (!caught) {
+        printf("  exception in nested parallel loop not rethrown\n");
+        return false;
+    }
+
+    // The scheduler must still be usable.
+    return TestNestedFor();
+}
+
+bool TestGraph() {
+    // Diamond-shaped dependencies: 0 -> (1, 2) -> 3.
+    std::vector<int> order(4, -1);
+    std::atomic<int> counter(0);
+    ChTaskGraph graph;
+    int t0 = graph.AddTask([&]() { order[0] = counter++; });
+    int t1 = graph.AddTask([&]() { order[1] = counter++; }, {t0});
+    int t2 = graph.AddTask([&]() { order[2] = counter++; }, {t0});
+    graph.AddTask([&]() { order[3] = counter++; }, {t1, t2});
+    graph.Execute();
+
+    if (order[0] != 0 || order[3] != 3 || order[1] < 1 || order[2] < 1) {
+        printf("  task graph: dependencies not respected\n");
+        return false;
+    }
+    return true;
+}
+
+struct ThreadData {
+    std::atomic<int>* sum;
+    int value;
+};
+
+void ThreadFunction(void* userPtr, void* lsMemory) {
+    ThreadData* data = (ThreadData*)userPtr;
+    *data->sum += data->value;
+}
+
+bool TestLegacyThreads() {
+    std::atomic<int> sum(0);
+    ChThreadConstructionInfo info("legacy", ThreadFunction, nullptr, 4);
+    ChThreads threads(info);
+
+    std::vector<ThreadData> data(4);
+    for (int round = 0; round < 10; round++) {
+        for (unsigned int k = 0; k < 4; k++) {
+            data[k].sum = &sum;
+            data[k].value = k + 1;
+            threads.sendRequest(1, &data[k], k);
+        }
+        threads.flush();
+    }
+
+    if (sum != 100) {
+        printf("  ChThreads: wrong result %d\n", sum.load());
+        return false;
+    }
+    return true;
+}
+
+#if defined(__linux__)
+double ThreadCpuTime() {
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+#endif
+
+bool TestBlockingWait() {
+#if defined(__linux__)
+    // A task runs on a worker for a while; the waiting thread has nothing to execute and must sleep.
+    std::atomic<bool> started(false);
+    ChTaskGroup group;
+    group.Run([&]() {
+        started = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    });
+    while (!started)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    double cpu_start = ThreadCpuTime();
+    group.Wait();
+    double cpu_wait = ThreadCpuTime() - cpu_start;
+
+    if (cpu_wait > 0.1) {
+        printf("  waiting thread used %g s of CPU time\n", cpu_wait);
+        return false;
+    }
+#endif
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    ChTaskScheduler& scheduler = ChTaskScheduler::GetInstance();
+
+    double sum_ref = 0;
+    for (int nthreads = 1; nthreads <= 4; nthreads++) {
+        scheduler.SetNumThreads(nthreads);
+        printf("Threads: %d\n", nthreads);
+
+        bool ok_for = TestNestedFor();
+        printf("  nested loops: %s\n", ok_for ? "OK" : "FAILED");
+
+        double sum = Reduce();
+        if (nthreads == 1)
+            sum_ref = sum;
+        bool ok_reduce = (sum == sum_ref);
+        printf("  reduction:    %s (%.17g)\n", ok_reduce ? "OK" : "FAILED", sum);
+
+        bool ok_exceptions = TestExceptions();
+        printf("  exceptions:   %s\n", ok_exceptions ? "OK" : "FAILED");
+
+        bool ok_graph = TestGraph();
+        printf("  task graph:   %s\n", ok_graph ? "OK" : "FAILED");
+
+        bool ok_legacy = TestLegacyThreads();
+        printf("  ChThreads:    %s\n", ok_legacy ? "OK" : "FAILED");
+
+        bool ok_wait = (nthreads == 1) || TestBlockingWait();
+        printf("  blocking wait: %s\n", ok_wait ? "OK" : "FAILED");
+
+        passed = passed && ok_for && ok_reduce && ok_exceptions && ok_graph && ok_legacy && ok_wait;
+    }
+
+    printf("\n%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
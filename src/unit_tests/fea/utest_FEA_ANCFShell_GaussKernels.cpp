@@ -0,0 +1,146 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test and micro-benchmark for the vectorized Gauss point kernels of the
+// ANCF shell element. Each element of a deformed, moving laminated cylindrical
+// shell is created twice on the same nodes: once with the default integrands
+// (evaluated through ChQuadrature::Integrate3D) and once with the vectorized
+// kernels. Internal forces and Jacobians must match, and the time spent in
+// both paths is reported.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_fea/ChElementShellANCF.h"
+
+using namespace chrono;
+using namespace fea;
+
+const double precision = 1e-10;  // Relative tolerance on forces and Jacobians
+const int num_repetitions = 10;  // Number of evaluations for each element, for timing
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC my_system;
+
+    // Quarter of a cylindrical shell, with two layers of orthotropic material at +/- 20 degrees
+    const double cylRadius = 1.0;
+    const double plate_lenght_y = 1;
+    const double plate_lenght_z = 0.005;
+    const int numDiv_x = 12;
+    const int numDiv_y = 12;
+    const int N_x = numDiv_x + 1;
+    const int N_y = numDiv_y + 1;
+    double dx = CH_C_PI / 2 / numDiv_x * cylRadius;
+    double dy = plate_lenght_y / numDiv_y;
+
+    std::vector<std::shared_ptr<ChNodeFEAxyzD>> nodes;
+    for (int i = 0; i < N_x * N_y; i++) {
+        double phi = (i % N_x) * (CH_C_PI / 2) / numDiv_x;
+        ChVector<> loc(cylRadius * sin(phi), (i / N_x) * dy, cylRadius * (1 - cos(phi)));
+        ChVector<> dir(-sin(phi), 0, cos(phi));
+        nodes.push_back(std::make_shared<ChNodeFEAxyzD>(loc, dir));
+    }
+
+    ChVector<> E(2e8, 1e8, 1e8);
+    ChVector<> nu(0.3, 0.3, 0.3);
+    ChVector<> G(3.84615E+07, 3.84615E+07, 3.84615E+07);
+    auto mat = std::make_shared<ChMaterialShellANCF>(500, E, nu, G);
+
+    std::vector<std::shared_ptr<ChElementShellANCF>> elements_default;
+    std::vector<std::shared_ptr<ChElementShellANCF>> elements_vectorized;
+    for (int i = 0; i < numDiv_x * numDiv_y; i++) {
+        int node0 = (i / numDiv_x) * N_x + i % numDiv_x;
+        for (int k = 0; k < 2; k++) {
+            auto element = std::make_shared<ChElementShellANCF>();
+            element->SetNodes(nodes[node0], nodes[node0 + 1], nodes[node0 + 1 + N_x], nodes[node0 + N_x]);
+            element->SetDimensions(dx, dy);
+            element->AddLayer(plate_lenght_z, 20 * CH_C_DEG_TO_RAD, mat);
+            element->AddLayer(plate_lenght_z, -20 * CH_C_DEG_TO_RAD, mat);
+            element->SetAlphaDamp(0.25);
+            element->SetVectorizedKernels(k == 1);
+            element->SetupInitial(&my_system);
+            (k == 0 ? elements_default : elements_vectorized).push_back(element);
+        }
+    }
+
+    // Deform the shell and give velocities to the nodes
+    for (size_t i = 0; i < nodes.size(); i++) {
+        const ChVector<>& pos = nodes[i]->GetPos();
+        ChVector<> displ(0.01 * pos.y() * pos.y(), 0.02 * pos.x() * pos.y(), -0.03 * pos.x() * pos.x());
+        nodes[i]->SetPos(pos + displ);
+        nodes[i]->SetD((nodes[i]->GetD() + ChVector<>(0.05 * pos.y(), 0, 0.02 * pos.x())).GetNormalized());
+        nodes[i]->SetPos_dt(ChVector<>(0.1 * pos.y(), -0.2 * pos.x(), 0.3 * pos.x() * pos.y()));
+        nodes[i]->SetD_dt(ChVector<>(0, 0.1 * pos.x(), -0.1 * pos.y()));
+    }
+
+    // Compare internal forces and Jacobians (K + R + M combination, as used by the integrators)
+    double Kfactor = 1;
+    double Rfactor = 0.1;
+    double Mfactor = 0.01;
+    double max_err_F = 0;
+    double max_err_H = 0;
+    for (size_t i = 0; i < elements_default.size(); i++) {
+        ChMatrixDynamic<> F1(24, 1);
+        ChMatrixDynamic<> F2(24, 1);
+        ChMatrixDynamic<> H1(24, 24);
+        ChMatrixDynamic<> H2(24, 24);
+        elements_default[i]->ComputeInternalForces(F1);
+        elements_vectorized[i]->ComputeInternalForces(F2);
+        elements_default[i]->ComputeKRMmatricesGlobal(H1, Kfactor, Rfactor, Mfactor);
+        elements_vectorized[i]->ComputeKRMmatricesGlobal(H2, Kfactor, Rfactor, Mfactor);
+
+        max_err_F = std::max(max_err_F, (F1 - F2).NormInf() / F1.NormInf());
+        max_err_H = std::max(max_err_H, (H1 - H2).NormInf() / H1.NormInf());
+    }
+
+    // Timing
+    ChTimer<double> timer_default;
+    ChTimer<double> timer_vectorized;
+    ChMatrixDynamic<> F(24, 1);
+    ChMatrixDynamic<> H(24, 24);
+
+    timer_default.start();
+    for (int n = 0; n < num_repetitions; n++) {
+        for (auto element : elements_default) {
+            element->ComputeInternalForces(F);
+            element->ComputeKRMmatricesGlobal(H, Kfactor, Rfactor, Mfactor);
+        }
+    }
+    timer_default.stop();
+
+    timer_vectorized.start();
+    for (int n = 0; n < num_repetitions; n++) {
+        for (auto element : elements_vectorized) {
+            element->ComputeInternalForces(F);
+            element->ComputeKRMmatricesGlobal(H, Kfactor, Rfactor, Mfactor);
+        }
+    }
+    timer_vectorized.stop();
+
+    bool passed = (max_err_F < precision) && (max_err_H < precision);
+
+    GetLog() << "Elements: " << (int)elements_default.size() << "\n";
+    GetLog() << "Max relative difference: forces " << max_err_F << ", Jacobians " << max_err_H
+             << (passed ? "  OK\n" : "  FAILED\n");
+    GetLog() << "Forces + Jacobians, " << num_repetitions << " evaluations: default " << timer_default()
+             << " s, vectorized " << timer_vectorized() << " s (speed-up "
+             << timer_default() / timer_vectorized() << ")\n";
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
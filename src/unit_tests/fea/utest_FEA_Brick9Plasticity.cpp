@@ -0,0 +1,258 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the committed and trial plastic states of ChElementBrick_9.
+// A single brick with J2 plasticity is stretched beyond the yield point:
+// - evaluating the internal forces at other states must not change the forces
+//   at a given state, as long as the plastic state is not committed (this also
+//   holds after ChMesh::Setup);
+// - after the plastic state is committed (at the end of a time step of the
+//   system), unloading from a larger stretch must give other forces.
+// Then a plate of plastic bricks is simulated with different numbers of
+// threads: the results must be identical for any number of threads larger than
+// one, and close to the serial results (the element contributions are summed in a
+// different order, and the round-off differences are amplified by the iterative solver).
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+#include "chrono_fea/ChElementBrick_9.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const double side = 0.1;
+
+bool CommitTest() {
+    bool passed = true;
+
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, 0));
+    auto mesh = std::make_shared<ChMesh>();
+    mesh->SetAutomaticGravity(false);
+
+    // Corner nodes, in the order of ChElementBrick_9::SetNodes
+    const double corners[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                                  {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+    std::shared_ptr<ChNodeFEAxyz> nodes[8];
+    for (int i = 0; i < 8; i++) {
+        nodes[i] = std::make_shared<ChNodeFEAxyz>(side * ChVector<>(corners[i][0], corners[i][1], corners[i][2]));
+        mesh->AddNode(nodes[i]);
+    }
+    auto central_node = std::make_shared<ChNodeFEAcurv>(VNULL, VNULL, VNULL);
+    mesh->AddNode(central_node);
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_density(7850);
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+    material->Set_G(1e7 / 2.6);
+
+    ChMatrixNM<double, 9, 8> CCPInitial;
+    for (int k = 0; k < 8; k++) {
+        CCPInitial(0, k) = 1;
+        CCPInitial(4, k) = 1;
+        CCPInitial(8, k) = 1;
+    }
+
+    auto element = std::make_shared<ChElementBrick_9>();
+    element->SetNodes(nodes[0], nodes[1], nodes[2], nodes[3], nodes[4], nodes[5], nodes[6], nodes[7], central_node);
+    element->SetDimensions(ChVector<>(side, side, side));
+    element->SetMaterial(material);
+    element->SetAlphaDamp(0.0);
+    element->SetGravityOn(false);
+    element->SetStrainFormulation(ChElementBrick_9::Hencky);
+    element->SetPlasticity(true);
+    element->SetPlasticityFormulation(ChElementBrick_9::J2);
+    element->SetYieldStress(1e4);
+    element->SetHardeningSlope(1e5);
+    element->SetCCPInitial(CCPInitial);
+    mesh->AddElement(element);
+
+    system.Add(mesh);
+    system.SetupInitial();
+
+    // Internal forces with the nodes at x = side moved by a stretch along x
+    std::shared_ptr<ChElementBase> base = element;
+    auto Forces = [&](double stretch) {
+        for (int i = 0; i < 8; i++)
+            nodes[i]->SetPos(nodes[i]->GetX0() + ChVector<>(stretch * nodes[i]->GetX0().x(), 0, 0));
+        ChMatrixDynamic<> Fi(33, 1);
+        base->ComputeInternalForces(Fi);
+        return Fi;
+    };
+    auto Difference = [](const ChMatrixDynamic<>& a, const ChMatrixDynamic<>& b) {
+        ChMatrixDynamic<> d = a - b;
+        return d.NormTwo() / a.NormTwo();
+    };
+
+    // Forces at a plastic state, then at a larger stretch and back (as in Newton iterations)
+    ChMatrixDynamic<> F_first = Forces(0.02);
+    Forces(0.05);
+    ChMatrixDynamic<> F_again = Forces(0.02);
+    double diff = Difference(F_first, F_again);
+    bool ok = diff < 1e-12;
+    GetLog() << "Repeated evaluation without commit: relative difference " << diff << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    // A mesh setup (as done by the system at each step) must not commit the plastic state
+    Forces(0.05);
+    mesh->Setup();
+    ChMatrixDynamic<> F_setup = Forces(0.02);
+    diff = Difference(F_first, F_setup);
+    ok = diff < 1e-12;
+    GetLog() << "Evaluation after mesh setup: relative difference " << diff << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    // Commit the plastic state of the larger stretch with a time step of the system (all nodes fixed, so
+    // that the step ends at this configuration), then unload
+    Forces(0.05);
+    for (int i = 0; i < 8; i++)
+        nodes[i]->SetFixed(true);
+    central_node->SetFixed(true);
+    system.DoStepDynamics(1e-3);
+    ChMatrixDynamic<> F_unloaded = Forces(0.02);
+    diff = Difference(F_first, F_unloaded);
+    ok = diff > 1e-3;
+    GetLog() << "Unloading after commit: relative difference " << diff << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    return passed;
+}
+
+// Plate of plastic bricks, clamped at one end and pulled at the other one.
+// Return the final position of a tip node.
+ChVector<> SimulatePlate(int num_threads) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, 0));
+    system.SetParallelThreadNumber(num_threads);
+    auto mesh = std::make_shared<ChMesh>();
+
+    const int numDiv_x = 6;
+    const int numDiv_y = 4;
+    const int N_x = numDiv_x + 1;
+    const int N_y = numDiv_y + 1;
+    const int XYNumNodes = N_x * N_y;
+    const int TotalNumElements = numDiv_x * numDiv_y;
+    const double dx = 0.1;
+    const double dy = 0.1;
+    const double dz = 0.01;
+
+    for (int j = 0; j < 2; j++) {
+        for (int i = 0; i < XYNumNodes; i++) {
+            auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>((i % N_x) * dx, (i / N_x) * dy, j * dz));
+            node->SetMass(0);
+            if (i % N_x == 0)
+                node->SetFixed(true);
+            mesh->AddNode(node);
+        }
+    }
+    for (int i = 0; i < TotalNumElements; i++) {
+        auto node = std::make_shared<ChNodeFEAcurv>(VNULL, VNULL, VNULL);
+        node->SetMass(0);
+        mesh->AddNode(node);
+    }
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_density(7850);
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+    material->Set_G(1e7 / 2.6);
+
+    ChMatrixNM<double, 9, 8> CCPInitial;
+    for (int k = 0; k < 8; k++) {
+        CCPInitial(0, k) = 1;
+        CCPInitial(4, k) = 1;
+        CCPInitial(8, k) = 1;
+    }
+
+    for (int i = 0; i < TotalNumElements; i++) {
+        int node0 = (i / numDiv_x) * N_x + i % numDiv_x;
+        auto element = std::make_shared<ChElementBrick_9>();
+        element->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(node0)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(node0 + 1)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(node0 + 1 + N_x)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(node0 + N_x)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(node0 + XYNumNodes)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(node0 + 1 + XYNumNodes)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(node0 + 1 + N_x + XYNumNodes)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(node0 + N_x + XYNumNodes)),
+                          std::dynamic_pointer_cast<ChNodeFEAcurv>(mesh->GetNode(2 * XYNumNodes + i)));
+        element->SetDimensions(ChVector<>(dx, dy, dz));
+        element->SetMaterial(material);
+        element->SetAlphaDamp(0.0);
+        element->SetGravityOn(false);
+        element->SetStrainFormulation(ChElementBrick_9::Hencky);
+        element->SetPlasticity(true);
+        element->SetPlasticityFormulation(ChElementBrick_9::J2);
+        element->SetYieldStress(1.0);
+        element->SetHardeningSlope(5e5);
+        element->SetCCPInitial(CCPInitial);
+        mesh->AddElement(element);
+    }
+
+    system.Add(mesh);
+    system.SetupInitial();
+
+    system.SetSolverType(ChSolver::Type::MINRES);
+    auto solver = std::static_pointer_cast<ChSolverMINRES>(system.GetSolver());
+    solver->SetDiagonalPreconditioning(true);
+    system.SetMaxItersSolverSpeed(900);
+    system.SetTolForce(1e-13);
+
+    system.SetTimestepperType(ChTimestepper::Type::HHT);
+    auto stepper = std::static_pointer_cast<ChTimestepperHHT>(system.GetTimestepper());
+    stepper->SetAlpha(0.0);
+    stepper->SetMaxiters(20);
+    stepper->SetAbsTolerances(1e-8, 1e-1);
+    stepper->SetMode(ChTimestepperHHT::POSITION);
+    stepper->SetScaling(true);
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> tips;
+    for (int j = 0; j < 2; j++)
+        for (int i = 0; i < N_y; i++)
+            tips.push_back(std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(j * XYNumNodes + i * N_x + numDiv_x)));
+
+    for (int it = 0; it < 5; it++) {
+        double force = 75 * std::sin(system.GetChTime() * CH_C_PI);
+        for (auto tip : tips)
+            tip->SetForce(ChVector<>(force, 0, 0));
+        system.DoStepDynamics(1e-3);
+    }
+
+    return tips.back()->GetPos();
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = CommitTest();
+
+    ChVector<> pos_serial = SimulatePlate(1);
+    ChVector<> pos_2 = SimulatePlate(2);
+    double displ = (pos_serial - ChVector<>(0.6, 0.4, 0.01)).Length();
+    for (int nt = 2; nt <= 4; nt++) {
+        ChVector<> pos = (nt == 2) ? pos_2 : SimulatePlate(nt);
+        double diff = (pos - pos_serial).Length() / displ;
+        bool ok = (pos == pos_2) && diff < 1e-6;
+        GetLog() << "Plate with " << nt << " threads: relative difference with serial " << diff
+                 << (ok ? "  OK\n" : "  FAILED\n");
+        passed &= ok;
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
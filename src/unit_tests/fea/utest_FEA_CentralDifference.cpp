@@ -0,0 +1,146 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the explicit central difference timestepper with lumped mass.
+// A bar of hexahedral elements, fixed at one end, is given a uniform axial
+// speed. The test checks:
+// - the lumped mass (its total must be the mass of the bar);
+// - the stable step estimated from the element size and the wave speed;
+// - the substepping of large steps;
+// - the caching of the stable step estimate (refreshed only on request or
+//   after the specified number of steps);
+// - the period of the axial vibration, which must be 4*L/c for a fixed-free bar.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/timestepper/ChTimestepper.h"
+#include "chrono_fea/ChElementHexa_8.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+int num_elements = 20;  // number of elements along the bar
+double size = 0.1;      // size of the (cubic) elements
+double E = 1e7;         // Young modulus
+double density = 1000;  // density
+double speed = 0.1;     // initial axial speed
+
+int main(int argc, char* argv[]) {
+    ChSystemSMC system;
+    system.Set_G_acc(ChVector<>(0, 0, 0));
+
+    auto mesh = std::make_shared<ChMesh>();
+    mesh->SetAutomaticGravity(false);
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(E);
+    material->Set_v(0);  // dilatational waves travel at the bar speed
+    material->Set_density(density);
+
+    // Four nodes per section, the first section is fixed.
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= num_elements; i++) {
+        for (int j = 0; j < 4; j++) {
+            double y = (j == 1 || j == 2) ? size : 0;
+            double z = (j >= 2) ? size : 0;
+            auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i * size, y, z));
+            node->SetFixed(i == 0);
+            if (i > 0)
+                node->SetPos_dt(ChVector<>(speed, 0, 0));
+            mesh->AddNode(node);
+            nodes.push_back(node);
+        }
+    }
+    for (int i = 0; i < num_elements; i++) {
+        auto element = std::make_shared<ChElementHexa_8>();
+        int a = 4 * i;
+        int b = 4 * (i + 1);
+        element->SetNodes(nodes[a + 0], nodes[a + 1], nodes[a + 2], nodes[a + 3], nodes[b + 0], nodes[b + 1],
+                          nodes[b + 2], nodes[b + 3]);
+        element->SetMaterial(material);
+        mesh->AddElement(element);
+    }
+    system.Add(mesh);
+    system.SetupInitial();
+
+    system.SetTimestepperType(ChTimestepper::Type::CENTRAL_DIFFERENCE);
+    auto integrator = std::static_pointer_cast<ChTimestepperCentralDifference>(system.GetTimestepper());
+
+    // Estimated stable step: for cubic elements, size over the wave speed.
+    double wave_speed = std::sqrt(E / density);
+    double stable_step = system.GetStableTimeStep();
+    bool passed = std::abs(stable_step - size / wave_speed) < 1e-9 * stable_step;
+    GetLog() << "Stable step: " << stable_step << " (expected " << size / wave_speed << ")\n";
+
+    // Integrate for one period of the axial vibration, with steps larger than the stable step.
+    double length = num_elements * size;
+    double period = 4 * length / wave_speed;
+    double step = period / 100;
+    double max_displ = 0;
+    ChNodeFEAxyz* tip = nodes.back().get();
+    while (system.GetChTime() < period - step / 2) {
+        system.DoStepDynamics(step);
+        max_displ = std::max(max_displ, tip->GetPos().x() - tip->GetX0().x());
+    }
+    double end_displ = tip->GetPos().x() - tip->GetX0().x();
+
+    // Total lumped mass along x (the fixed section does not contribute)
+    double mass = 0;
+    const ChVectorDynamic<>& Md = integrator->GetLumpedMass();
+    for (int i = 0; i < Md.GetRows(); i += 3)
+        mass += Md(i);
+    double expected_mass = density * length * size * size * (1 - 0.5 / num_elements);
+    passed &= std::abs(mass - expected_mass) < 1e-9 * expected_mass;
+    GetLog() << "Lumped mass of free nodes: " << mass << " (expected " << expected_mass << ")\n";
+
+    passed &= (integrator->GetNumSubsteps() == (int)std::ceil(step / (0.9 * integrator->GetStableTimeStep())));
+    GetLog() << "Substeps: " << integrator->GetNumSubsteps() << "\n";
+
+    // After one period the tip is back to the rest position (the maximum is speed*L/c).
+    passed &= std::abs(max_displ - speed * length / wave_speed) < 0.05 * max_displ;
+    passed &= std::abs(end_displ) < 0.05 * max_displ;
+    GetLog() << "Tip displacement: max " << max_displ << " (expected " << speed * length / wave_speed
+             << "), after one period " << end_displ << (passed ? "  OK\n" : "  FAILED\n");
+
+    // The estimate of the stable step is cached: a stiffer material is seen only after an explicit
+    // request, or after the specified number of steps.
+    integrator->SetStableStepUpdateInterval(2);
+    integrator->ForceStableStepUpdate();
+    system.DoStepDynamics(step);
+    double cached_step = integrator->GetStableTimeStep();
+    material->Set_E(4 * E);
+    system.DoStepDynamics(step);
+    bool cached = (integrator->GetStableTimeStep() == cached_step);
+    system.DoStepDynamics(step);
+    double refreshed_step = integrator->GetStableTimeStep();
+    bool refreshed = std::abs(refreshed_step - cached_step / 2) < 1e-2 * cached_step;
+    integrator->SetStableStepUpdateInterval(1000);
+    material->Set_E(E);
+    system.DoStepDynamics(step);
+    cached &= (integrator->GetStableTimeStep() == refreshed_step);
+    integrator->ForceStableStepUpdate();
+    system.DoStepDynamics(step);
+    bool forced = std::abs(integrator->GetStableTimeStep() - cached_step) < 1e-2 * cached_step;
+    passed &= cached && refreshed && forced;
+    GetLog() << "Stable step cache: " << (cached ? "kept" : "NOT kept") << ", "
+             << (refreshed ? "refreshed" : "NOT refreshed") << " after the interval, "
+             << (forced ? "updated" : "NOT updated") << " on request"
+             << ((cached && refreshed && forced) ? "  OK\n" : "  FAILED\n");
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,243 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the matrix-free mode of ChMesh.
+// First, the element products y += H*x of ANCF shell, 9-node brick and
+// tetrahedron elements are compared with the products by the matrices from
+// ComputeKRMmatricesGlobal.
+// Then a cantilever ANCF shell plate, loaded at the tip, is simulated with the
+// HHT integrator and the MINRES solver, with stored matrices and in matrix-free
+// mode: the tip trajectories must match.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono/timestepper/ChTimestepperHHT.h"
+
+#include "chrono_fea/ChElementBrick_9.h"
+#include "chrono_fea/ChElementShellANCF.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace fea;
+
+const double precision_product = 1e-10;  // Relative tolerance on element products
+const double precision_motion = 1e-5;    // Relative tolerance on the tip displacement
+const int num_steps = 5;                 // Number of time steps of the simulations
+
+// Relative difference between the product by the matrix of the element and the matrix-free product.
+double CheckProduct(ChElementBase& element, double Kfactor, double Rfactor, double Mfactor) {
+    int n = element.GetNdofs();
+    ChMatrixDynamic<> H(n, n);
+    ChMatrixDynamic<> x(n, 1);
+    ChMatrixDynamic<> y1(n, 1);
+    ChMatrixDynamic<> y2(n, 1);
+    x.FillRandom(1, -1);
+
+    element.ComputeKRMmatricesGlobal(H, Kfactor, Rfactor, Mfactor);
+    y1.MatrMultiply(H, x);
+    element.ComputeKRMmatricesProduct(y2, x, Kfactor, Rfactor, Mfactor);
+
+    return (y1 - y2).NormInf() / y1.NormInf();
+}
+
+// Cantilever plate, clamped along the X=0 edge, with a force at the tip.
+// Return the tip node, after the given number of steps.
+std::shared_ptr<ChNodeFEAxyzD> SimulatePlate(bool matrix_free, double& time) {
+    ChSystemNSC my_system;
+    auto my_mesh = std::make_shared<ChMesh>();
+
+    const double plate_lenght_x = 1;
+    const double plate_lenght_y = 0.1;
+    const double plate_lenght_z = 0.01;
+    const int numDiv_x = 10;
+    const int numDiv_y = 2;
+    const int N_x = numDiv_x + 1;
+    const int N_y = numDiv_y + 1;
+    double dx = plate_lenght_x / numDiv_x;
+    double dy = plate_lenght_y / numDiv_y;
+
+    for (int i = 0; i < N_x * N_y; i++) {
+        auto node = std::make_shared<ChNodeFEAxyzD>(ChVector<>((i % N_x) * dx, (i / N_x) * dy, 0),
+                                                    ChVector<>(0, 0, 1));
+        node->SetMass(0);
+        if (i % N_x == 0)
+            node->SetFixed(true);
+        my_mesh->AddNode(node);
+    }
+    auto nodetip = std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(N_x * N_y - 1));
+
+    auto mat = std::make_shared<ChMaterialShellANCF>(500, 2.1e8, 0.3);
+    for (int i = 0; i < numDiv_x * numDiv_y; i++) {
+        int node0 = (i / numDiv_x) * N_x + i % numDiv_x;
+        auto element = std::make_shared<ChElementShellANCF>();
+        element->SetNodes(std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node0)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node0 + 1)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node0 + 1 + N_x)),
+                          std::dynamic_pointer_cast<ChNodeFEAxyzD>(my_mesh->GetNode(node0 + N_x)));
+        element->SetDimensions(dx, dy);
+        element->AddLayer(plate_lenght_z, 0, mat);
+        element->SetAlphaDamp(0.08);
+        element->SetGravityOn(false);
+        element->SetVectorizedKernels(true);
+        my_mesh->AddElement(element);
+    }
+    my_mesh->SetAutomaticGravity(false);
+    my_mesh->SetMatrixFree(matrix_free);
+    my_system.Add(my_mesh);
+    my_system.SetupInitial();
+
+    my_system.SetSolverType(ChSolver::Type::MINRES);
+    auto msolver = std::static_pointer_cast<ChSolverMINRES>(my_system.GetSolver());
+    msolver->SetDiagonalPreconditioning(true);
+    my_system.SetMaxItersSolverSpeed(200);
+    my_system.SetTolForce(1e-10);
+
+    my_system.SetTimestepperType(ChTimestepper::Type::HHT);
+    auto mystepper = std::static_pointer_cast<ChTimestepperHHT>(my_system.GetTimestepper());
+    mystepper->SetAlpha(-0.2);
+    mystepper->SetMaxiters(100);
+    mystepper->SetAbsTolerances(1e-08);
+    mystepper->SetMode(ChTimestepperHHT::POSITION);
+    mystepper->SetScaling(true);
+
+    nodetip->SetForce(ChVector<>(0, 0, -50));
+
+    ChTimer<double> timer;
+    timer.start();
+    for (int it = 0; it < num_steps; it++)
+        my_system.DoStepDynamics(1e-3);
+    timer.stop();
+    time = timer();
+
+    return nodetip;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC my_system;
+
+    // Element products, for a deformed and moving shell element
+    double max_err_product = 0;
+    for (int k = 0; k < 2; k++) {
+        auto nodeA = std::make_shared<ChNodeFEAxyzD>(ChVector<>(0, 0, 0), ChVector<>(0, 0, 1));
+        auto nodeB = std::make_shared<ChNodeFEAxyzD>(ChVector<>(0.1, 0, 0), ChVector<>(0, 0, 1));
+        auto nodeC = std::make_shared<ChNodeFEAxyzD>(ChVector<>(0.1, 0.1, 0), ChVector<>(0, 0, 1));
+        auto nodeD = std::make_shared<ChNodeFEAxyzD>(ChVector<>(0, 0.1, 0), ChVector<>(0, 0, 1));
+        auto mat = std::make_shared<ChMaterialShellANCF>(500, 2.1e8, 0.3);
+        ChElementShellANCF element;
+        element.SetNodes(nodeA, nodeB, nodeC, nodeD);
+        element.SetDimensions(0.1, 0.1);
+        element.AddLayer(0.005, 0, mat);
+        element.AddLayer(0.005, 30 * CH_C_DEG_TO_RAD, mat);
+        element.SetAlphaDamp(0.1);
+        element.SetVectorizedKernels(k == 1);
+        element.SetupInitial(&my_system);
+
+        nodeC->SetPos(ChVector<>(0.11, 0.1, 0.02));
+        nodeC->SetD(ChVector<>(0.1, 0, 1).GetNormalized());
+        nodeB->SetPos_dt(ChVector<>(0, 0.1, -0.2));
+        ChMatrixDynamic<> Fi(24, 1);
+        element.ComputeInternalForces(Fi);
+
+        max_err_product = std::max(max_err_product, CheckProduct(element, 1, 0.1, 0.01));
+    }
+
+    // Element products, for a deformed and moving 9-node brick (Green-Lagrange and Hencky strains)
+    for (int k = 0; k < 2; k++) {
+        const double corners[8][3] = {{0, 0, 0}, {1, 0, 0}, {1, 1, 0}, {0, 1, 0},
+                                      {0, 0, 1}, {1, 0, 1}, {1, 1, 1}, {0, 1, 1}};
+        std::shared_ptr<ChNodeFEAxyz> nodes[8];
+        for (int i = 0; i < 8; i++)
+            nodes[i] = std::make_shared<ChNodeFEAxyz>(0.1 * ChVector<>(corners[i][0], corners[i][1], corners[i][2]));
+        auto central_node = std::make_shared<ChNodeFEAcurv>(VNULL, VNULL, VNULL);
+        auto mat = std::make_shared<ChContinuumElastic>();
+        mat->Set_density(7850);
+        mat->Set_E(1e7);
+        mat->Set_v(0.3);
+        mat->Set_G(1e7 / 2.6);
+        ChMatrixNM<double, 9, 8> CCPInitial;
+        for (int j = 0; j < 8; j++) {
+            CCPInitial(0, j) = 1;
+            CCPInitial(4, j) = 1;
+            CCPInitial(8, j) = 1;
+        }
+        ChElementBrick_9 element;
+        element.SetNodes(nodes[0], nodes[1], nodes[2], nodes[3], nodes[4], nodes[5], nodes[6], nodes[7],
+                         central_node);
+        element.SetDimensions(ChVector<>(0.1, 0.1, 0.1));
+        element.SetMaterial(mat);
+        element.SetAlphaDamp(0.05);
+        element.SetGravityOn(false);
+        element.SetStrainFormulation(k == 0 ? ChElementBrick_9::GreenLagrange : ChElementBrick_9::Hencky);
+        element.SetPlasticity(false);
+        element.SetCCPInitial(CCPInitial);
+        ChElementBase& base = element;  // SetupInitial and ComputeInternalForces are private in ChElementBrick_9
+        base.SetupInitial(&my_system);
+
+        nodes[6]->SetPos(ChVector<>(0.11, 0.1, 0.12));
+        nodes[5]->SetPos_dt(ChVector<>(0, 0.1, -0.2));
+        central_node->SetCurvatureXX(ChVector<>(0.1, 0, 0.2));
+        ChMatrixDynamic<> Fi(33, 1);
+        base.ComputeInternalForces(Fi);
+
+        max_err_product = std::max(max_err_product, CheckProduct(element, 1, 0.1, 0.01));
+    }
+
+    // Element products, for a rotated tetrahedron
+    {
+        auto mat = std::make_shared<ChContinuumElastic>();
+        mat->Set_E(1e7);
+        mat->Set_v(0.3);
+        mat->Set_RayleighDampingK(0.01);
+        mat->Set_RayleighDampingM(0.1);
+        auto node1 = std::make_shared<ChNodeFEAxyz>(ChVector<>(0, 0, 0));
+        auto node2 = std::make_shared<ChNodeFEAxyz>(ChVector<>(0, 0, 1));
+        auto node3 = std::make_shared<ChNodeFEAxyz>(ChVector<>(0, 1, 0));
+        auto node4 = std::make_shared<ChNodeFEAxyz>(ChVector<>(1, 0, 0));
+        ChElementTetra_4 element;
+        element.SetNodes(node1, node2, node3, node4);
+        element.SetMaterial(mat);
+        element.SetupInitial(&my_system);
+
+        ChQuaternion<> rot = Q_from_AngAxis(0.3, ChVector<>(1, 2, 3).GetNormalized());
+        for (auto node : {node1, node2, node3, node4})
+            node->SetPos(rot.Rotate(node->GetPos()) + ChVector<>(0.01, 0, 0));
+        element.UpdateRotation();
+
+        max_err_product = std::max(max_err_product, CheckProduct(element, 1, 0.1, 0.01));
+    }
+
+    // Simulations with stored matrices and in matrix-free mode
+    double time_stored;
+    double time_free;
+    auto tip_stored = SimulatePlate(false, time_stored);
+    auto tip_free = SimulatePlate(true, time_free);
+
+    double displ = (tip_stored->GetPos() - ChVector<>(1, 0.1, 0)).Length();
+    double err_motion = (tip_stored->GetPos() - tip_free->GetPos()).Length() / displ;
+
+    bool passed = (max_err_product < precision_product) && (err_motion < precision_motion);
+
+    GetLog() << "Max relative difference of element products: " << max_err_product << "\n";
+    GetLog() << "Tip displacement " << displ << ", relative difference " << err_motion
+             << (passed ? "  OK\n" : "  FAILED\n");
+    GetLog() << "Simulation time: stored matrices " << time_stored << " s, matrix-free " << time_free << " s\n";
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
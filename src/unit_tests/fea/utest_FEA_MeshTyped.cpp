@@ -0,0 +1,158 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the meshes of a single class of elements and nodes (ChMeshTyped).
+// The same cantilever of tetrahedrons, clamped at one end and loaded by gravity
+// and by a tip load, is built as a ChMesh and as a ChMeshTyped: the transients
+// must be the same.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChMeshTyped.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+typedef ChMeshTyped<ChElementTetra_4, ChNodeFEAxyz> ChMeshTetra;
+
+const int nx = 10;  // Number of cells along the cantilever
+const int ny = 2;   // Number of cells across the cantilever
+const int nz = 2;
+const double length = 1.0;
+const double width = 0.1;
+
+// Create the nodes and the elements of the cantilever (each cell is split in 6 tetrahedrons), either one by one
+// in a ChMesh, or in blocks in a ChMeshTyped. The nodes at x=0 are fixed, the nodes at x=length are loaded.
+void CreateCantilever(std::shared_ptr<ChMesh> mesh, std::shared_ptr<ChNodeFEAxyz>& tip_node) {
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e8);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+    material->Set_RayleighDampingK(0.001);
+
+    auto typed_mesh = std::dynamic_pointer_cast<ChMeshTetra>(mesh);
+    int num_nodes = (nx + 1) * (ny + 1) * (nz + 1);
+    int num_elements = 6 * nx * ny * nz;
+    if (typed_mesh) {
+        typed_mesh->AddNodes(num_nodes);
+        typed_mesh->AddElements(num_elements);
+    }
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= nx; i++)
+        for (int j = 0; j <= ny; j++)
+            for (int k = 0; k <= nz; k++) {
+                ChVector<> pos(i * length / nx, j * width / ny - width / 2, k * width / nz - width / 2);
+                std::shared_ptr<ChNodeFEAxyz> node;
+                if (typed_mesh) {
+                    node = typed_mesh->GetTypedNode((unsigned int)nodes.size());
+                    node->SetX0(pos);
+                    node->SetPos(pos);
+                } else {
+                    node = std::make_shared<ChNodeFEAxyz>(pos);
+                    mesh->AddNode(node);
+                }
+                node->SetFixed(i == 0);
+                if (i == nx)
+                    node->SetForce(ChVector<>(0, -2, 1));
+                nodes.push_back(node);
+            }
+    auto node = [&](int i, int j, int k) { return nodes[(i * (ny + 1) + j) * (nz + 1) + k]; };
+    tip_node = node(nx, ny, nz);
+
+    // The 6 tetrahedrons along the paths from corner (0,0,0) to corner (1,1,1) of the cell
+    const int axes[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    unsigned int ie = 0;
+    for (int i = 0; i < nx; i++)
+        for (int j = 0; j < ny; j++)
+            for (int k = 0; k < nz; k++)
+                for (int t = 0; t < 6; t++) {
+                    int corner[3] = {0, 0, 0};
+                    std::shared_ptr<ChNodeFEAxyz> tetra_nodes[4];
+                    tetra_nodes[0] = node(i, j, k);
+                    for (int a = 0; a < 3; a++) {
+                        corner[axes[t][a]] = 1;
+                        tetra_nodes[a + 1] = node(i + corner[0], j + corner[1], k + corner[2]);
+                    }
+                    std::shared_ptr<ChElementTetra_4> element;
+                    if (typed_mesh) {
+                        element = typed_mesh->GetTypedElement(ie++);
+                    } else {
+                        element = std::make_shared<ChElementTetra_4>();
+                        mesh->AddElement(element);
+                    }
+                    element->SetNodes(tetra_nodes[0], tetra_nodes[1], tetra_nodes[2], tetra_nodes[3]);
+                    element->SetMaterial(material);
+                }
+}
+
+// Simulate a short transient, return the history of the displacement of a tip node.
+void Simulate(std::shared_ptr<ChMesh> mesh, std::vector<ChVector<>>& tip_disp) {
+    std::shared_ptr<ChNodeFEAxyz> tip_node;
+    CreateCantilever(mesh, tip_node);
+
+    ChSystemNSC system;
+    system.SetSolverType(ChSolver::Type::MINRES);
+    auto solver = std::static_pointer_cast<ChSolverMINRES>(system.GetSolver());
+    solver->SetDiagonalPreconditioning(true);
+    system.SetMaxItersSolverSpeed(500);
+    system.SetTolForce(1e-12);
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+    system.Add(mesh);
+    system.SetupInitial();
+    mesh->ResetTimers();
+
+    ChTimer<double> timer;
+    timer.reset();
+    timer.start();
+    tip_disp.clear();
+    for (int step = 0; step < 20; step++) {
+        system.DoStepDynamics(1e-3);
+        tip_disp.push_back(tip_node->GetPos() - tip_node->GetX0());
+    }
+    timer.stop();
+
+    auto typed_mesh = std::dynamic_pointer_cast<ChMeshTetra>(mesh);
+    GetLog() << (typed_mesh ? "ChMeshTyped" : "ChMesh") << ", " << mesh->GetNelements() << " elements: transient "
+             << timer() << " s, internal forces " << mesh->GetTimeInternalForces() << " s\n";
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    std::vector<ChVector<>> disp_mesh, disp_typed;
+    Simulate(std::make_shared<ChMesh>(), disp_mesh);
+    auto typed_mesh = std::make_shared<ChMeshTetra>();
+    Simulate(typed_mesh, disp_typed);
+
+    double max_disp = 0;
+    double err = 0;
+    for (size_t i = 0; i < disp_mesh.size(); i++) {
+        max_disp = std::max(max_disp, disp_mesh[i].Length());
+        err = std::max(err, (disp_typed[i] - disp_mesh[i]).Length());
+    }
+    err /= max_disp;
+    bool ok = typed_mesh->IsTyped() && max_disp > 0 && err < 1e-9;
+    GetLog() << "Tip displacement " << disp_mesh.back().y() << ", relative difference " << err
+             << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
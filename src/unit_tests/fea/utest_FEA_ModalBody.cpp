@@ -0,0 +1,150 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the flexible bodies with a floating frame of reference (ChModalBody).
+// A cantilever of Euler beams, clamped to the body frame at one end, is reduced to
+// a modal body:
+// - the mass and the center of mass of the body must be the ones of the beam;
+// - the frequencies of the clamped modes and of the free-free modes of the beam
+//   must be close to the analytical ones;
+// - the body is rotated by a motor with constant angular acceleration: the tip of
+//   the beam must lag behind the body frame by the static deflection of a
+//   cantilever under the linearly varying inertia load.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/motion_functions/ChFunction_Poly.h"
+#include "chrono/physics/ChLinkMotorRotationAngle.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono_fea/ChBuilderBeam.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChModalBody.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const double length = 1.0;
+const double side = 0.02;  // square cross section
+const double E = 2e11;
+const double density = 7800;
+const int num_elements = 40;
+
+// Create the mesh of the cantilever along x, from the origin. The node at the origin is fixed if 'clamped'.
+std::shared_ptr<ChMesh> CreateCantilever(bool clamped, std::shared_ptr<ChNodeFEAxyzrot>& tip_node) {
+    auto mesh = std::make_shared<ChMesh>();
+    auto section = std::make_shared<ChBeamSectionAdvanced>();
+    section->SetAsRectangularSection(side, side);
+    section->SetYoungModulus(E);
+    section->SetGshearModulus(E / 2.6);
+    section->SetDensity(density);
+
+    ChBuilderBeam builder;
+    builder.BuildBeam(mesh, section, num_elements, ChVector<>(0, 0, 0), ChVector<>(length, 0, 0), ChVector<>(0, 1, 0));
+    builder.GetLastBeamNodes().front()->SetFixed(clamped);
+    tip_node = builder.GetLastBeamNodes().back();
+    return mesh;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    double area = side * side;
+    double EI = E * side * side * side * side / 12;
+    double rhoA = density * area;
+    double omega_ref = std::sqrt(EI / (rhoA * length * length * length * length));
+
+    // Mass properties and frequencies of the clamped modes
+    std::shared_ptr<ChNodeFEAxyzrot> tip_node;
+    auto body = std::make_shared<ChModalBody>();
+    body->Reduce(CreateCantilever(true, tip_node), 8);
+
+    double mass = rhoA * length;
+    ChVector<> com = body->GetFrame_COG_to_REF().GetPos();
+    bool ok = std::abs(body->GetMass() - mass) < 1e-9 * mass && (com - ChVector<>(length / 2, 0, 0)).Length() < 1e-9;
+    GetLog() << "Mass " << body->GetMass() << " kg (beam: " << mass << " kg), center of mass at x = " << com.x()
+             << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    double f_clamped = 3.5160 * omega_ref / CH_C_2PI;
+    double f1 = std::sqrt(body->GetModeEigenvalues()(0)) / CH_C_2PI;
+    ok = std::abs(f1 - f_clamped) < 0.01 * f_clamped;
+    GetLog() << "First clamped frequency: " << f1 << " Hz (analytical: " << f_clamped << " Hz)"
+             << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    // Frequencies of the free-free modes (the rigid body modes are not among the modes)
+    std::shared_ptr<ChNodeFEAxyzrot> free_tip_node;
+    ChModalBody free_body;
+    free_body.Reduce(CreateCantilever(false, free_tip_node), 4);
+    double f_free = 22.373 * omega_ref / CH_C_2PI;
+    f1 = std::sqrt(free_body.GetModeEigenvalues()(0)) / CH_C_2PI;
+    ok = std::abs(f1 - f_free) < 0.01 * f_free;
+    GetLog() << "First free-free frequency: " << f1 << " Hz (analytical: " << f_free << " Hz)"
+             << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    // Rotation of the body about z with constant angular acceleration, starting from rest (the gravity is
+    // normal to the plane of the motion, so it does not change the deflection in this plane)
+    double alpha = 1;
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.SetSolverType(ChSolver::Type::MINRES);
+    auto solver = std::static_pointer_cast<ChSolverMINRES>(system.GetSolver());
+    solver->SetDiagonalPreconditioning(true);
+    system.SetMaxItersSolverSpeed(500);
+    system.SetTolForce(1e-14);
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.Add(ground);
+
+    body->SetModalDamping(1.0);
+    system.Add(body);
+
+    auto motor = std::make_shared<ChLinkMotorRotationAngle>();
+    motor->Initialize(body, ground, ChFrame<>(VNULL));
+    auto angle = std::make_shared<ChFunction_Poly>();
+    angle->Set_order(2);
+    angle->Set_coeff(0, 0);
+    angle->Set_coeff(0, 1);
+    angle->Set_coeff(alpha / 2, 2);
+    motor->SetAngleFunction(angle);
+    system.Add(motor);
+
+    ChTimer<double> timer;
+    timer.reset();
+    timer.start();
+    while (system.GetChTime() < 0.5 - 1e-9)
+        system.DoStepDynamics(1e-3);
+    timer.stop();
+
+    // Deflection of the tip, in the body reference frame
+    body->UpdateMeshNodes();
+    ChVector<> tip = body->GetFrame_REF_to_abs().TransformPointParentToLocal(tip_node->Frame().GetPos());
+    double deflection = tip.y() - tip_node->GetX0().GetPos().y();
+    double deflection_ref = -11 * rhoA * alpha * length * length * length * length * length / (120 * EI);
+    ChQuaternion<> rot = body->GetFrame_REF_to_abs().GetRot();
+    double rotation = rot.Q_to_Rotv().z();
+    ok = std::abs(deflection - deflection_ref) < 0.01 * std::abs(deflection_ref) &&
+         std::abs(rotation - alpha * 0.5 * 0.5 * 0.5) < 1e-6;
+    GetLog() << "Rotation " << rotation << " rad, tip deflection " << deflection << " m (analytical: " << deflection_ref
+             << " m), " << system.GetNcoords_w() << " coordinates, " << timer() << " s"
+             << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,214 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the parallel products of the system descriptor.
+// The KKT system product (on an FEA mesh, with stiffness blocks and constraints)
+// and the Schur complement product (on a chain of rigid bodies) are evaluated with
+// 1 to 4 threads. The parallel results must be bitwise identical for any number of
+// threads, and equal to the serial results up to round-off errors. A short FEA
+// transient must also be bitwise reproducible with 2 and 4 threads.
+//
+// =============================================================================
+
+#include <cmath>
+#include <random>
+
+#include "chrono/parallel/ChTaskScheduler.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverPMINRES.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChLinkPointFrame.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const int max_threads = 4;
+
+// Cantilever of tetrahedrons, attached to a fixed body at x=0 with point-frame constraints.
+std::shared_ptr<ChNodeFEAxyz> CreateCantilever(ChSystem& system) {
+    const int nx = 10;
+    const int ny = 2;
+    const int nz = 2;
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    auto mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e7);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= nx; i++)
+        for (int j = 0; j <= ny; j++)
+            for (int k = 0; k <= nz; k++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i * 0.1, j * 0.05, k * 0.05));
+                mesh->AddNode(node);
+                nodes.push_back(node);
+            }
+    auto node = [&](int i, int j, int k) { return nodes[(i * (ny + 1) + j) * (nz + 1) + k]; };
+
+    const int axes[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for (int i = 0; i < nx; i++)
+        for (int j = 0; j < ny; j++)
+            for (int k = 0; k < nz; k++)
+                for (int t = 0; t < 6; t++) {
+                    int corner[3] = {0, 0, 0};
+                    std::shared_ptr<ChNodeFEAxyz> tetra_nodes[4];
+                    tetra_nodes[0] = node(i, j, k);
+                    for (int a = 0; a < 3; a++) {
+                        corner[axes[t][a]] = 1;
+                        tetra_nodes[a + 1] = node(i + corner[0], j + corner[1], k + corner[2]);
+                    }
+                    auto element = std::make_shared<ChElementTetra_4>();
+                    element->SetNodes(tetra_nodes[0], tetra_nodes[1], tetra_nodes[2], tetra_nodes[3]);
+                    element->SetMaterial(material);
+                    mesh->AddElement(element);
+                }
+    system.Add(mesh);
+
+    for (int j = 0; j <= ny; j++)
+        for (int k = 0; k <= nz; k++) {
+            auto link = std::make_shared<ChLinkPointFrame>();
+            link->Initialize(node(0, j, k), ground);
+            system.Add(link);
+        }
+
+    return node(nx, ny, nz);
+}
+
+// Chain of rigid bodies connected by spherical joints, the first one attached to ground.
+void CreateChain(ChSystem& system) {
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    std::shared_ptr<ChBody> prev = ground;
+    for (int i = 0; i < 200; i++) {
+        auto body = std::make_shared<ChBody>();
+        body->SetPos(ChVector<>(i + 0.5, 0, 0));
+        system.AddBody(body);
+        auto joint = std::make_shared<ChLinkLockSpherical>();
+        joint->Initialize(prev, body, ChCoordsys<>(ChVector<>(i, 0, 0), QUNIT));
+        system.AddLink(joint);
+        prev = body;
+    }
+}
+
+// Compare the results for 1 to max_threads threads. Return false if the parallel results differ from each other,
+// or if they differ from the serial result by more than round-off errors.
+bool Compare(const std::vector<ChMatrixDynamic<>>& results) {
+    double norm = results[0].NormInf();
+    double err_serial = 0;
+    double err_parallel = 0;
+    for (int nt = 2; nt <= max_threads; nt++) {
+        for (int i = 0; i < results[0].GetRows(); i++) {
+            err_serial = std::max(err_serial, std::abs(results[nt - 1](i) - results[0](i)));
+            err_parallel = std::max(err_parallel, std::abs(results[nt - 1](i) - results[1](i)));
+        }
+    }
+    bool ok = norm > 0 && err_parallel == 0 && err_serial < 1e-12 * norm;
+    GetLog() << "  serial vs parallel: " << err_serial / norm << "   parallel, different threads: " << err_parallel
+             << (ok ? "  OK\n" : "  FAILED\n");
+    return ok;
+}
+
+bool TestSystemProduct() {
+    GetLog() << "System product (FEA)\n";
+
+    ChSystemNSC system;
+    system.SetSolverType(ChSolver::Type::PMINRES);
+    CreateCantilever(system);
+    system.SetupInitial();
+    system.DoStepDynamics(1e-3);
+
+    auto descriptor = system.GetSystemDescriptor();
+    descriptor->SetParallelThreshold(0);
+    int n = descriptor->CountActiveVariables() + descriptor->CountActiveConstraints();
+
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> u(-1, 1);
+    ChMatrixDynamic<> x(n, 1);
+    for (int i = 0; i < n; i++)
+        x(i) = u(gen);
+
+    std::vector<ChMatrixDynamic<>> results(max_threads);
+    for (int nt = 1; nt <= max_threads; nt++) {
+        ChTaskScheduler::GetInstance().SetNumThreads(nt);
+        descriptor->SetNumThreads(nt);
+        descriptor->SystemProduct(results[nt - 1], &x);
+    }
+
+    return Compare(results);
+}
+
+bool TestSchurProduct() {
+    GetLog() << "Schur complement product (rigid bodies)\n";
+
+    ChSystemNSC system;
+    CreateChain(system);
+    system.DoStepDynamics(1e-3);
+
+    auto descriptor = system.GetSystemDescriptor();
+    descriptor->SetParallelThreshold(0);
+    int n = descriptor->CountActiveConstraints();
+    descriptor->CountActiveVariables();
+
+    std::mt19937 gen(2);
+    std::uniform_real_distribution<double> u(-1, 1);
+    ChMatrixDynamic<> l(n, 1);
+    for (int i = 0; i < n; i++)
+        l(i) = u(gen);
+
+    std::vector<ChMatrixDynamic<>> results(max_threads);
+    for (int nt = 1; nt <= max_threads; nt++) {
+        ChTaskScheduler::GetInstance().SetNumThreads(nt);
+        descriptor->SetNumThreads(nt);
+        descriptor->ShurComplementProduct(results[nt - 1], &l, nullptr);
+    }
+
+    return Compare(results);
+}
+
+// Simulate a short transient of the cantilever with the given number of threads.
+ChVector<> Simulate(int num_threads) {
+    ChSystemNSC system;
+    system.SetSolverType(ChSolver::Type::PMINRES);
+    system.SetMaxItersSolverSpeed(200);
+    system.SetParallelThreadNumber(num_threads);
+    system.GetSystemDescriptor()->SetParallelThreshold(0);
+    auto tip = CreateCantilever(system);
+    system.SetupInitial();
+    for (int step = 0; step < 20; step++)
+        system.DoStepDynamics(1e-3);
+    return tip->GetPos();
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= TestSystemProduct();
+    passed &= TestSchurProduct();
+
+    GetLog() << "Transient\n";
+    ChVector<> tip2 = Simulate(2);
+    ChVector<> tip4 = Simulate(4);
+    bool ok = (tip2 == tip4);
+    GetLog() << "  tip position, 2 threads: " << tip2 << "   4 threads: " << tip4 << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
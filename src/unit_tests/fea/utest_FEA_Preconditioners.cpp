@@ -0,0 +1,234 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the KKT preconditioners (ChPreconditioner).
+// A stiff cantilever of tetrahedrons is simulated for a few steps with the PMINRES
+// solver, using the default diagonal scaling and then the block-Jacobi, ILDL(0),
+// and AMG preconditioners, and with the PCG solver and the same preconditioners
+// (the problem has no constraints, so the KKT matrix is positive definite).
+// All runs must give the same tip displacement, and the preconditioners must
+// reduce the number of solver iterations. With PCG, the iteration counts must
+// follow the quality of the preconditioners (block-Jacobi, ILDL(0), AMG with
+// translations only, AMG with rigid body rotations). The symbolic setup must not
+// be repeated once the sparsity pattern is established.
+//
+// =============================================================================
+
+#include <cmath>
+#include <map>
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChPreconditioner.h"
+#include "chrono/solver/ChSolverPCG.h"
+#include "chrono/solver/ChSolverPMINRES.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const int nx = 30;  // Number of cells along the cantilever
+const int ny = 3;   // Number of cells across the cantilever
+const int nz = 3;
+const double length = 1.0;
+const double width = 0.1;
+const int num_steps = 5;
+
+// Node coordinates for the AMG preconditioner.
+class NodeCoordinates : public ChPreconditionerAMG::CoordinatesCallback {
+  public:
+    NodeCoordinates(std::shared_ptr<ChMesh> mesh) {
+        for (unsigned int i = 0; i < mesh->GetNnodes(); i++) {
+            auto node = std::dynamic_pointer_cast<ChNodeFEAxyz>(mesh->GetNode(i));
+            m_pos[&node->Variables()] = node->GetX0();
+        }
+    }
+    virtual bool GetCoordinates(ChVariables* variables, ChVector<>& pos) override {
+        auto it = m_pos.find(variables);
+        if (it == m_pos.end())
+            return false;
+        pos = it->second;
+        return true;
+    }
+
+  private:
+    std::map<ChVariables*, ChVector<>> m_pos;
+};
+
+// Create the cantilever (each cell is split in 6 tetrahedrons), fixed at x=0 and loaded at x=length.
+std::shared_ptr<ChMesh> CreateCantilever(std::shared_ptr<ChNodeFEAxyz>& tip_node) {
+    auto mesh = std::make_shared<ChMesh>();
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(2e11);
+    material->Set_v(0.3);
+    material->Set_density(7800);
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= nx; i++)
+        for (int j = 0; j <= ny; j++)
+            for (int k = 0; k <= nz; k++) {
+                ChVector<> pos(i * length / nx, j * width / ny - width / 2, k * width / nz - width / 2);
+                auto node = std::make_shared<ChNodeFEAxyz>(pos);
+                node->SetFixed(i == 0);
+                if (i == nx)
+                    node->SetForce(ChVector<>(0, -1000, 500));
+                mesh->AddNode(node);
+                nodes.push_back(node);
+            }
+    auto node = [&](int i, int j, int k) { return nodes[(i * (ny + 1) + j) * (nz + 1) + k]; };
+    tip_node = node(nx, ny, nz);
+
+    const int axes[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for (int i = 0; i < nx; i++)
+        for (int j = 0; j < ny; j++)
+            for (int k = 0; k < nz; k++)
+                for (int t = 0; t < 6; t++) {
+                    int corner[3] = {0, 0, 0};
+                    std::shared_ptr<ChNodeFEAxyz> tetra_nodes[4];
+                    tetra_nodes[0] = node(i, j, k);
+                    for (int a = 0; a < 3; a++) {
+                        corner[axes[t][a]] = 1;
+                        tetra_nodes[a + 1] = node(i + corner[0], j + corner[1], k + corner[2]);
+                    }
+                    auto element = std::make_shared<ChElementTetra_4>();
+                    element->SetNodes(tetra_nodes[0], tetra_nodes[1], tetra_nodes[2], tetra_nodes[3]);
+                    element->SetMaterial(material);
+                    mesh->AddElement(element);
+                }
+
+    return mesh;
+}
+
+enum class Precond { DIAGONAL, BLOCK_JACOBI, ILDL, AMG, AMG_ROTATIONS };
+
+// Simulate a few steps, return the average number of solver iterations per step and the tip displacement.
+bool Simulate(bool pcg, Precond type, double& iterations, ChVector<>& tip_disp) {
+    std::shared_ptr<ChNodeFEAxyz> tip_node;
+    auto mesh = CreateCantilever(tip_node);
+    NodeCoordinates coordinates(mesh);
+
+    ChSystemNSC system;
+    std::shared_ptr<ChIterativeSolver> solver;
+    if (pcg) {
+        solver = std::make_shared<ChSolverPCG>();
+    } else {
+        auto minres = std::make_shared<ChSolverPMINRES>();
+        minres->SetDiagonalPreconditioning(true);
+        minres->SetRelTolerance(1e-10);
+        solver = minres;
+    }
+    system.SetSolver(solver);
+    system.SetMaxItersSolverSpeed(5000);
+    system.SetTolForce(1e-10);
+    system.Set_G_acc(ChVector<>(0, 0, 0));
+    system.Add(mesh);
+    system.SetupInitial();
+
+    std::shared_ptr<ChPreconditioner> precond;
+    switch (type) {
+        case Precond::DIAGONAL:
+            break;
+        case Precond::BLOCK_JACOBI:
+            precond = std::make_shared<ChPreconditionerBlockJacobi>();
+            break;
+        case Precond::ILDL:
+            precond = std::make_shared<ChPreconditionerILDL>();
+            break;
+        case Precond::AMG: {
+            auto amg = std::make_shared<ChPreconditionerAMG>();
+            amg->SetCoarseSize(100);
+            precond = amg;
+            break;
+        }
+        case Precond::AMG_ROTATIONS: {
+            auto amg = std::make_shared<ChPreconditionerAMG>();
+            amg->SetCoarseSize(100);
+            amg->SetCoordinatesCallback(&coordinates);
+            precond = amg;
+            break;
+        }
+    }
+    solver->SetPreconditioner(precond);
+
+    int total = 0;
+    for (int step = 0; step < num_steps; step++) {
+        system.DoStepDynamics(1e-3);
+        total += solver->GetTotalIterations();
+    }
+    iterations = (double)total / num_steps;
+    tip_disp = tip_node->GetPos() - tip_node->GetX0();
+
+    GetLog() << "  iterations per step: " << iterations << "   tip displacement: " << tip_disp.y() << "\n";
+
+    if (!precond)
+        return true;
+
+    // The sparsity pattern does not change after the first step (in the undeformed configuration, the zero
+    // entries of the geometric stiffness are not stored): at most two symbolic setups, and one numeric setup
+    // per step.
+    bool ok = precond->GetNumSymbolicSetups() <= 2 && precond->GetNumNumericSetups() == num_steps;
+    if (!ok)
+        GetLog() << "  unexpected number of setups: " << precond->GetNumSymbolicSetups() << " symbolic, "
+                 << precond->GetNumNumericSetups() << " numeric\n";
+
+    if (type == Precond::AMG_ROTATIONS) {
+        auto amg = std::static_pointer_cast<ChPreconditionerAMG>(precond);
+        GetLog() << "  AMG levels: " << amg->GetNumLevels() << ", near null space size: " << amg->GetNullSpaceSize()
+                 << "\n";
+        ok &= amg->GetNullSpaceSize() == 6;
+    }
+
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    const char* names[] = {"diagonal", "block-Jacobi", "ILDL(0)", "AMG (translations)", "AMG (rigid body modes)"};
+    Precond types[] = {Precond::DIAGONAL, Precond::BLOCK_JACOBI, Precond::ILDL, Precond::AMG, Precond::AMG_ROTATIONS};
+
+    // PMINRES, with the diagonal scaling (reference) and with the preconditioners.
+    double iterations[5];
+    ChVector<> tip_disp[5];
+    for (int i = 0; i < 5; i++) {
+        GetLog() << "PMINRES, " << names[i] << "\n";
+        passed &= Simulate(false, types[i], iterations[i], tip_disp[i]);
+    }
+
+    for (int i = 1; i < 5; i++) {
+        double err = (tip_disp[i] - tip_disp[0]).Length() / tip_disp[0].Length();
+        bool ok = err < 1e-5 && iterations[i] < iterations[0];
+        GetLog() << "PMINRES, " << names[i] << ": iterations " << iterations[i] << " vs " << iterations[0]
+                 << ", relative difference " << err << (ok ? "  OK\n" : "  FAILED\n");
+        passed &= ok;
+    }
+
+    // PCG with the preconditioners (PCG requires a preconditioner to operate on the KKT system).
+    double pcg_iterations[5];
+    ChVector<> pcg_tip_disp[5];
+    for (int i = 1; i < 5; i++) {
+        GetLog() << "PCG, " << names[i] << "\n";
+        passed &= Simulate(true, types[i], pcg_iterations[i], pcg_tip_disp[i]);
+    }
+
+    for (int i = 1; i < 5; i++) {
+        double err = (pcg_tip_disp[i] - tip_disp[0]).Length() / tip_disp[0].Length();
+        bool ok = err < 1e-5 && (i == 1 || pcg_iterations[i] < pcg_iterations[i - 1]);
+        GetLog() << "PCG, " << names[i] << ": iterations " << pcg_iterations[i] << ", relative difference " << err
+                 << (ok ? "  OK\n" : "  FAILED\n");
+        passed &= ok;
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,218 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the reduction of linear FEA meshes with ChSuperelement.
+// A cantilever of tetrahedrons is clamped at one end, the nodes of the other
+// end are the boundary nodes of the superelement.
+// - The static deflection under a tip load must be the same with the full mesh and
+//   with the reductions (static condensation is exact), and so the deflection under
+//   gravity with the Guyan and the Craig-Bampton reductions.
+// - The lowest eigenvalues of the Craig-Bampton reduction must be close to the
+//   eigenvalues of the full mesh, computed by a reduction with no boundary nodes.
+// - The tip displacement in a short transient must follow the one of the full mesh.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverMINRES.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChModalAnalysis.h"
+#include "chrono_fea/ChSuperelement.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+const int nx = 10;  // Number of cells along the cantilever
+const int ny = 2;   // Number of cells across the cantilever
+const int nz = 2;
+const double length = 1.0;
+const double width = 0.1;
+
+const ChVector<> tip_load(0, -20, 10);  // Force on each tip node
+
+// Create the mesh of the cantilever: each cell is split in 6 tetrahedrons. The nodes at x=0 are fixed.
+std::shared_ptr<ChMesh> CreateCantilever(std::vector<std::shared_ptr<ChNodeFEAxyz>>& tip_nodes) {
+    auto mesh = std::make_shared<ChMesh>();
+    auto material = std::make_shared<ChContinuumElastic>();
+    material->Set_E(1e9);
+    material->Set_v(0.3);
+    material->Set_density(1000);
+    material->Set_RayleighDampingK(0.001);
+
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= nx; i++)
+        for (int j = 0; j <= ny; j++)
+            for (int k = 0; k <= nz; k++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(
+                    ChVector<>(i * length / nx, j * width / ny - width / 2, k * width / nz - width / 2));
+                node->SetFixed(i == 0);
+                if (i == nx)
+                    tip_nodes.push_back(node);
+                nodes.push_back(node);
+                mesh->AddNode(node);
+            }
+    auto node = [&](int i, int j, int k) { return nodes[(i * (ny + 1) + j) * (nz + 1) + k]; };
+
+    // The 6 tetrahedrons along the paths from corner (0,0,0) to corner (1,1,1) of the cell
+    const int axes[6][3] = {{0, 1, 2}, {0, 2, 1}, {1, 0, 2}, {1, 2, 0}, {2, 0, 1}, {2, 1, 0}};
+    for (int i = 0; i < nx; i++)
+        for (int j = 0; j < ny; j++)
+            for (int k = 0; k < nz; k++)
+                for (int t = 0; t < 6; t++) {
+                    int corner[3] = {0, 0, 0};
+                    std::shared_ptr<ChNodeFEAxyz> tetra_nodes[4];
+                    tetra_nodes[0] = node(i, j, k);
+                    for (int a = 0; a < 3; a++) {
+                        corner[axes[t][a]] = 1;
+                        tetra_nodes[a + 1] = node(i + corner[0], j + corner[1], k + corner[2]);
+                    }
+                    auto element = std::make_shared<ChElementTetra_4>();
+                    element->SetNodes(tetra_nodes[0], tetra_nodes[1], tetra_nodes[2], tetra_nodes[3]);
+                    element->SetMaterial(material);
+                    mesh->AddElement(element);
+                }
+
+    return mesh;
+}
+
+void SetSolver(ChSystem& system) {
+    system.SetSolverType(ChSolver::Type::MINRES);
+    auto solver = std::static_pointer_cast<ChSolverMINRES>(system.GetSolver());
+    solver->SetDiagonalPreconditioning(true);
+    system.SetMaxItersSolverSpeed(2000);
+    system.SetTolForce(1e-12);
+}
+
+// Average displacement of the tip nodes.
+ChVector<> TipDisplacement(const std::vector<std::shared_ptr<ChNodeFEAxyz>>& tip_nodes) {
+    ChVector<> disp(0);
+    for (auto& node : tip_nodes)
+        disp += (node->GetPos() - node->GetX0()) / (double)tip_nodes.size();
+    return disp;
+}
+
+// Static deflection under the tip load, or under gravity only, or tip displacements in a transient with a suddenly
+// applied tip load. With 'num_modes' < 0, the full mesh is used, otherwise a superelement with this number of modes.
+void Simulate(int num_modes, bool dynamic, bool gravity, std::vector<ChVector<>>& tip_disp) {
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> tip_nodes;
+    auto mesh = CreateCantilever(tip_nodes);
+    for (auto& node : tip_nodes)
+        node->SetForce(gravity ? VNULL : tip_load);
+
+    ChSystemNSC system;
+    SetSolver(system);
+    system.Set_G_acc(gravity ? ChVector<>(0, -9.81, 0) : VNULL);
+
+    if (num_modes < 0) {
+        system.Add(mesh);
+    } else {
+        auto superelement = std::make_shared<ChSuperelement>();
+        superelement->Reduce(mesh, tip_nodes, num_modes);
+        system.Add(superelement);
+    }
+    system.SetupInitial();
+
+    ChTimer<double> timer;
+    timer.reset();
+    timer.start();
+    tip_disp.clear();
+    if (dynamic) {
+        for (int step = 0; step < 50; step++) {
+            system.DoStepDynamics(8e-4);
+            tip_disp.push_back(TipDisplacement(tip_nodes));
+        }
+    } else {
+        system.DoStaticLinear();
+        tip_disp.push_back(TipDisplacement(tip_nodes));
+    }
+    timer.stop();
+
+    GetLog() << (num_modes < 0 ? "Full mesh" : (num_modes == 0 ? "Guyan" : "Craig-Bampton")) << ", "
+             << system.GetNcoords_w() << " coordinates: " << (dynamic ? "transient " : "static analysis ") << timer()
+             << " s\n";
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+
+    // Static deflection, with the full mesh and with the reductions
+    std::vector<ChVector<>> static_full, static_guyan, static_cb;
+    Simulate(-1, false, false, static_full);
+    Simulate(0, false, false, static_guyan);
+    Simulate(6, false, false, static_cb);
+
+    double err_guyan = (static_guyan[0] - static_full[0]).Length() / static_full[0].Length();
+    double err_cb = (static_cb[0] - static_full[0]).Length() / static_full[0].Length();
+    bool ok = (err_guyan < 1e-6) && (err_cb < 1e-6);
+    GetLog() << "Static deflection, relative difference: Guyan " << err_guyan << ", Craig-Bampton " << err_cb
+             << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    // Static deflection under gravity: the internal loads are exactly condensed by both reductions
+    // (the full mesh is not a reference here, because its gravity loads include the fixed nodes)
+    Simulate(0, false, true, static_guyan);
+    Simulate(6, false, true, static_cb);
+    err_cb = (static_cb[0] - static_guyan[0]).Length() / static_guyan[0].Length();
+    ok = (err_cb < 1e-6);
+    GetLog() << "Deflection under gravity, relative difference: Craig-Bampton " << err_cb
+             << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    // Transient
+    std::vector<ChVector<>> dynamic_full, dynamic_cb;
+    Simulate(-1, true, false, dynamic_full);
+    Simulate(6, true, false, dynamic_cb);
+
+    double max_disp = 0;
+    double err_dyn = 0;
+    for (size_t i = 0; i < dynamic_full.size(); i++) {
+        max_disp = std::max(max_disp, dynamic_full[i].Length());
+        err_dyn = std::max(err_dyn, (dynamic_cb[i] - dynamic_full[i]).Length());
+    }
+    err_dyn /= max_disp;
+    ok = (err_dyn < 0.02);
+    GetLog() << "Transient tip displacement, relative difference: Craig-Bampton " << err_dyn
+             << (ok ? "  OK\n" : "  FAILED\n");
+    passed &= ok;
+
+    // Eigenvalues: the full mesh (a reduction with no boundary nodes), Guyan and Craig-Bampton reductions
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> tip_nodes;
+    auto mesh = CreateCantilever(tip_nodes);
+    ChSuperelement modal;
+    modal.Reduce(mesh, std::vector<std::shared_ptr<ChNodeFEAxyz>>(), 4);
+    ChSuperelement guyan;
+    guyan.Reduce(mesh, tip_nodes, 0);
+    ChSuperelement craig_bampton;
+    craig_bampton.Reduce(mesh, tip_nodes, 6);
+
+    ChVectorDynamic<> eig_guyan, eig_cb;
+    ChMatrixDynamic<> Q;
+    ChModalAnalysis::SolveDenseEigenproblem(guyan.GetReducedStiffness(), guyan.GetReducedMass(), eig_guyan, Q);
+    ChModalAnalysis::SolveDenseEigenproblem(craig_bampton.GetReducedStiffness(), craig_bampton.GetReducedMass(),
+                                            eig_cb, Q);
+    for (int k = 0; k < 4; k++) {
+        double f_full = std::sqrt(modal.GetModeEigenvalues()(k)) / CH_C_2PI;
+        double f_guyan = std::sqrt(eig_guyan(k)) / CH_C_2PI;
+        double f_cb = std::sqrt(eig_cb(k)) / CH_C_2PI;
+        ok = std::abs(f_cb - f_full) < 0.01 * f_full;
+        GetLog() << "Frequency " << k << ": full " << f_full << " Hz, Guyan " << f_guyan << " Hz, Craig-Bampton "
+                 << f_cb << " Hz" << (ok ? "  OK\n" : "  FAILED\n");
+        passed &= ok;
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,164 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the cached updates of ChVisualizationFEAmesh.
+// A block of tetrahedrons and a few beams are visualized with a false color
+// plot. After the nodes are moved, the triangle mesh updated with the cached
+// topology must match the mesh rebuilt from scratch by a new visualization
+// asset. The times of the two kinds of updates are reported.
+//
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/assets/ChTriangleMeshShape.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_fea/ChElementBeamEuler.h"
+#include "chrono_fea/ChElementTetra_4.h"
+#include "chrono_fea/ChMesh.h"
+#include "chrono_fea/ChVisualizationFEAmesh.h"
+
+using namespace chrono;
+using namespace fea;
+
+const int num_repetitions = 5;  // Number of updates, for timing
+
+geometry::ChTriangleMeshConnected& GetTriangleMesh(ChVisualizationFEAmesh& visualization) {
+    return std::static_pointer_cast<ChTriangleMeshShape>(visualization.GetAssets()[0])->GetMesh();
+}
+
+// Max difference between the buffers of the triangle meshes of two visualization assets.
+double CompareMeshes(ChVisualizationFEAmesh& vis1, ChVisualizationFEAmesh& vis2, bool& same_topology) {
+    geometry::ChTriangleMeshConnected& mesh1 = GetTriangleMesh(vis1);
+    geometry::ChTriangleMeshConnected& mesh2 = GetTriangleMesh(vis2);
+
+    same_topology = (mesh1.getCoordsVertices().size() == mesh2.getCoordsVertices().size()) &&
+                    (mesh1.getCoordsColors().size() == mesh2.getCoordsColors().size()) &&
+                    (mesh1.getCoordsNormals().size() == mesh2.getCoordsNormals().size()) &&
+                    (mesh1.getIndicesVertexes() == mesh2.getIndicesVertexes()) &&
+                    (mesh1.getIndicesNormals() == mesh2.getIndicesNormals());
+    if (!same_topology)
+        return 1e30;
+
+    double max_diff = 0;
+    for (size_t i = 0; i < mesh1.getCoordsVertices().size(); i++)
+        max_diff = std::max(max_diff, (mesh1.getCoordsVertices()[i] - mesh2.getCoordsVertices()[i]).Length());
+    for (size_t i = 0; i < mesh1.getCoordsColors().size(); i++)
+        max_diff = std::max(max_diff, (double)(mesh1.getCoordsColors()[i] - mesh2.getCoordsColors()[i]).Length());
+    for (size_t i = 0; i < mesh1.getCoordsNormals().size(); i++)
+        max_diff = std::max(max_diff, (mesh1.getCoordsNormals()[i] - mesh2.getCoordsNormals()[i]).Length());
+    return max_diff;
+}
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC my_system;
+    auto my_mesh = std::make_shared<ChMesh>();
+
+    // Block of n x n x n cubes, each split in 6 tetrahedrons
+    const int n = 12;
+    const double h = 0.1;
+    std::vector<std::shared_ptr<ChNodeFEAxyz>> nodes;
+    for (int i = 0; i <= n; i++)
+        for (int j = 0; j <= n; j++)
+            for (int k = 0; k <= n; k++) {
+                auto node = std::make_shared<ChNodeFEAxyz>(ChVector<>(i * h, j * h, k * h));
+                nodes.push_back(node);
+                my_mesh->AddNode(node);
+            }
+
+    auto material = std::make_shared<ChContinuumElastic>();
+    int tetras[6][4] = {{0, 1, 3, 7}, {0, 1, 7, 5}, {0, 4, 5, 7}, {0, 2, 7, 3}, {0, 2, 6, 7}, {0, 4, 7, 6}};
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            for (int k = 0; k < n; k++) {
+                int corners[8];
+                for (int c = 0; c < 8; c++)
+                    corners[c] = ((i + (c & 1)) * (n + 1) + (j + ((c >> 1) & 1))) * (n + 1) + (k + ((c >> 2) & 1));
+                for (int t = 0; t < 6; t++) {
+                    auto element = std::make_shared<ChElementTetra_4>();
+                    element->SetNodes(nodes[corners[tetras[t][0]]], nodes[corners[tetras[t][1]]],
+                                      nodes[corners[tetras[t][2]]], nodes[corners[tetras[t][3]]]);
+                    element->SetMaterial(material);
+                    my_mesh->AddElement(element);
+                }
+            }
+
+    // A chain of beams, on top of the block
+    auto section = std::make_shared<ChBeamSectionAdvanced>();
+    std::shared_ptr<ChNodeFEAxyzrot> beam_node;
+    for (int i = 0; i <= n; i++) {
+        auto node = std::make_shared<ChNodeFEAxyzrot>(ChFrame<>(ChVector<>(i * h, 0, n * h + 0.5)));
+        my_mesh->AddNode(node);
+        if (beam_node) {
+            auto element = std::make_shared<ChElementBeamEuler>();
+            element->SetNodes(beam_node, node);
+            element->SetSection(section);
+            element->SetupInitial(&my_system);
+            my_mesh->AddElement(element);
+        }
+        beam_node = node;
+    }
+
+    bool passed = true;
+    for (int smooth = 0; smooth < 2; smooth++) {
+        for (auto node : nodes)
+            node->SetPos(node->GetX0());
+
+        ChVisualizationFEAmesh visualization(*my_mesh);
+        visualization.SetFEMdataType(ChVisualizationFEAmesh::E_PLOT_NODE_DISP_NORM);
+        visualization.SetColorscaleMinMax(0, 0.1);
+        visualization.SetShrinkElements(true, 0.9);
+        visualization.SetSmoothFaces(smooth == 1);
+        visualization.Update(my_mesh.get(), CSYSNORM);
+
+        // Move the nodes, then update with the cached topology and rebuild from scratch
+        for (auto node : nodes) {
+            ChVector<> pos = node->GetX0();
+            node->SetPos(pos + ChVector<>(0.05 * pos.y() * pos.z(), -0.02 * pos.x(), 0.03 * pos.x() * pos.y()));
+        }
+
+        ChTimer<double> timer_cached;
+        timer_cached.start();
+        for (int i = 0; i < num_repetitions; i++)
+            visualization.Update(my_mesh.get(), CSYSNORM);
+        timer_cached.stop();
+
+        ChTimer<double> timer_rebuild;
+        ChVisualizationFEAmesh reference(*my_mesh);
+        reference.SetFEMdataType(ChVisualizationFEAmesh::E_PLOT_NODE_DISP_NORM);
+        reference.SetColorscaleMinMax(0, 0.1);
+        reference.SetShrinkElements(true, 0.9);
+        reference.SetSmoothFaces(smooth == 1);
+        timer_rebuild.start();
+        for (int i = 0; i < num_repetitions; i++) {
+            reference.ForceTopologyUpdate();
+            reference.Update(my_mesh.get(), CSYSNORM);
+        }
+        timer_rebuild.stop();
+
+        bool same_topology;
+        double max_diff = CompareMeshes(visualization, reference, same_topology);
+        bool ok = same_topology && (max_diff < 1e-12);
+        passed &= ok;
+
+        GetLog() << "Smooth faces: " << smooth << ", triangles: "
+                 << (int)GetTriangleMesh(visualization).getIndicesVertexes().size() << ", max difference "
+                 << max_diff << (ok ? "  OK\n" : "  FAILED\n");
+        GetLog() << "  " << num_repetitions << " updates: cached topology " << timer_cached() << " s, rebuild "
+                 << timer_rebuild() << " s\n";
+    }
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,197 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Regression test for the Chrono::FSI backends (CUDA or multicore CPU, selected
+// at configuration time). A layer of fluid at rest fills a tank with fixed
+// walls (BCE markers on the bottom and on the x sides, periodic in y).
+// The test checks that:
+// - the simulation runs without errors (invalid marker data throws);
+// - all the markers stay in the computational domain;
+// - the fluid stays (nearly) at rest and does not lose height.
+// The same thresholds are used for both backends.
+//
+// =============================================================================
+
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+#include "chrono/utils/ChUtilsCreators.h"
+#include "chrono/utils/ChUtilsGenerators.h"
+
+#include "chrono_fsi/ChDeviceUtils.cuh"
+#include "chrono_fsi/ChFsiTypeConvert.h"
+#include "chrono_fsi/ChSystemFsi.h"
+#include "chrono_fsi/utils/ChUtilsGeneratorFsi.h"
+
+using namespace chrono;
+using namespace chrono::fsi;
+
+// Tank dimensions (the fluid fills the tank up to fz)
+Real bx = 1.0;
+Real by = 0.4;
+Real bz = 1.0;
+Real fz = 0.5;
+
+int num_steps = 500;       // number of FSI steps
+double max_speed = 0.1;    // largest admissible marker speed
+double max_drop = 0.05;    // largest admissible drop of the mean fluid height
+
+void SetupParams(SimParams* paramsH) {
+    paramsH->sizeScale = 1;
+    paramsH->HSML = 0.1;
+    paramsH->MULT_INITSPACE = 1.0;
+    paramsH->epsMinMarkersDis = .001;
+    paramsH->NUM_BOUNDARY_LAYERS = 3;
+    paramsH->toleranceZone = paramsH->NUM_BOUNDARY_LAYERS * (paramsH->HSML * paramsH->MULT_INITSPACE);
+    paramsH->BASEPRES = 0;
+    paramsH->LARGE_PRES = 0;
+    paramsH->multViscosity_FSI = 1;
+    paramsH->gravity = mR3(0, 0, -1);
+    paramsH->bodyForce3 = mR3(0, 0, 0);
+    paramsH->rho0 = 1000;
+    paramsH->markerMass = pow(paramsH->MULT_INITSPACE * paramsH->HSML, 3) * paramsH->rho0;
+    paramsH->mu0 = .001;
+    paramsH->v_Max = 1;
+    paramsH->EPS_XSPH = .5f;
+    paramsH->dT = 2e-4;
+    paramsH->tFinal = num_steps * paramsH->dT;
+    paramsH->timePause = 0;
+    paramsH->kdT = 5;
+    paramsH->gammaBB = 0.5;
+    paramsH->densityReinit = 1;
+    paramsH->enableTweak = 0;
+    paramsH->enableAggressiveTweak = 0;
+    paramsH->tweakMultV = 0.1;
+    paramsH->tweakMultRho = .00;
+    paramsH->bceType = ADAMI;
+    paramsH->cMin = mR3(-bx, -by, -bz) - mR3(paramsH->HSML);
+    paramsH->cMax = mR3(bx, by, 1.2 * bz) + mR3(paramsH->HSML);
+
+    int3 side0 = mI3((int)floor((paramsH->cMax.x - paramsH->cMin.x) / (2 * paramsH->HSML)),
+                     (int)floor((paramsH->cMax.y - paramsH->cMin.y) / (2 * paramsH->HSML)),
+                     (int)floor((paramsH->cMax.z - paramsH->cMin.z) / (2 * paramsH->HSML)));
+    paramsH->binSize0 = (paramsH->cMax.x - paramsH->cMin.x) / side0.x;
+    paramsH->boxDims = paramsH->cMax - paramsH->cMin;
+    paramsH->straightChannelBoundaryMin = paramsH->cMin;
+    paramsH->straightChannelBoundaryMax = paramsH->cMax;
+    paramsH->deltaPress = mR3(0);
+
+    int3 SIDE = mI3(int((paramsH->cMax.x - paramsH->cMin.x) / paramsH->binSize0 + .1),
+                    int((paramsH->cMax.y - paramsH->cMin.y) / paramsH->binSize0 + .1),
+                    int((paramsH->cMax.z - paramsH->cMin.z) / paramsH->binSize0 + .1));
+    paramsH->gridSize = SIDE;
+    paramsH->worldOrigin = paramsH->cMin;
+    paramsH->cellSize = mR3(paramsH->binSize0, paramsH->binSize0, paramsH->binSize0);
+}
+
+// Mean height of the fluid markers and largest marker speed.
+void FluidState(ChSystemFsi& fsi_system, int num_fluid, double& mean_z, double& speed, bool& in_domain) {
+    SimParams* paramsH = fsi_system.GetSimParams();
+    thrust::host_vector<Real3> pos = fsi_system.GetDataManager()->sphMarkersD2.posRadD;
+    thrust::host_vector<Real3> vel = fsi_system.GetDataManager()->sphMarkersD2.velMasD;
+
+    mean_z = 0;
+    speed = 0;
+    in_domain = true;
+    for (int i = 0; i < num_fluid; i++) {
+        Real3 p = pos[i];
+        Real3 v = vel[i];
+        if (!(p.x >= paramsH->cMin.x && p.x <= paramsH->cMax.x && p.y >= paramsH->cMin.y &&
+              p.y <= paramsH->cMax.y && p.z >= paramsH->cMin.z && p.z <= paramsH->cMax.z))
+            in_domain = false;
+        mean_z += p.z;
+        double s = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+        if (!(s <= speed))
+            speed = std::isfinite(s) ? s : HUGE_VAL;
+    }
+    mean_z /= num_fluid;
+}
+
+int main(int argc, char* argv[]) {
+    printf("%s backend\n", ChSystemFsi::GetBackend() == ChSystemFsi::CUDA ? "CUDA" : "Multicore CPU");
+
+    ChSystemParallelNSC system;
+    ChSystemFsi fsi_system(&system, true);
+    SimParams* paramsH = fsi_system.GetSimParams();
+    SetupParams(paramsH);
+    system.Set_G_acc(ChVector<>(paramsH->gravity.x, paramsH->gravity.y, paramsH->gravity.z));
+
+    // Fluid markers
+    Real initSpace0 = paramsH->MULT_INITSPACE * paramsH->HSML;
+    chrono::utils::GridSampler<> sampler(initSpace0);
+    ChVector<> fluid_center(0, 0, fz / 2 + paramsH->HSML);
+    ChVector<> fluid_half(bx / 2 - paramsH->HSML, by / 2 + 3 * paramsH->HSML, fz / 2);
+    chrono::utils::Generator::PointVector points = sampler.SampleBox(fluid_center, fluid_half);
+    int num_fluid = (int)points.size();
+    for (int i = 0; i < num_fluid; i++) {
+        fsi_system.GetDataManager()->AddSphMarker(mR3(points[i].x(), points[i].y(), points[i].z()), mR3(0),
+                                                  mR4(paramsH->rho0, paramsH->BASEPRES, paramsH->mu0, -1));
+    }
+    fsi_system.GetDataManager()->fsiGeneralData.referenceArray.push_back(mI4(0, num_fluid, -1, -1));
+    fsi_system.GetDataManager()->fsiGeneralData.referenceArray.push_back(mI4(num_fluid, num_fluid, 0, 0));
+
+    // Tank walls (fixed), with BCE markers
+    auto ground = std::make_shared<ChBody>(std::make_shared<collision::ChCollisionModelParallel>());
+    ground->SetIdentifier(-1);
+    ground->SetBodyFixed(true);
+    ground->SetCollide(false);
+    system.AddBody(ground);
+
+    ChVector<> size_bottom(bx / 2 + 3 * paramsH->HSML, by / 2 + 3 * paramsH->HSML, 2 * paramsH->HSML);
+    ChVector<> pos_bottom(0, 0, -2 * paramsH->HSML);
+    ChVector<> size_YZ(2 * paramsH->HSML, by / 2 + 3 * paramsH->HSML, bz / 2);
+    ChVector<> pos_xp(bx / 2 + paramsH->HSML, 0.0, bz / 2 + paramsH->HSML);
+    ChVector<> pos_xn(-bx / 2 - 3 * paramsH->HSML, 0.0, bz / 2 + paramsH->HSML);
+    fsi::utils::AddBoxBce(fsi_system.GetDataManager(), paramsH, ground, pos_bottom, QUNIT, size_bottom);
+    fsi::utils::AddBoxBce(fsi_system.GetDataManager(), paramsH, ground, pos_xp, QUNIT, size_YZ, 23);
+    fsi::utils::AddBoxBce(fsi_system.GetDataManager(), paramsH, ground, pos_xn, QUNIT, size_YZ, 23);
+
+    fsi_system.Finalize();
+
+    double z0, speed;
+    bool in_domain;
+    FluidState(fsi_system, num_fluid, z0, speed, in_domain);
+    printf("Fluid markers: %d  initial mean height: %g\n", num_fluid, z0);
+
+    bool passed = true;
+    try {
+        for (int is = 0; is < num_steps; is++)
+            fsi_system.DoStepDynamics_FSI();
+    } catch (const std::exception& e) {
+        printf("Simulation failed: %s\n", e.what());
+        passed = false;
+    }
+
+    if (passed) {
+        double z;
+        FluidState(fsi_system, num_fluid, z, speed, in_domain);
+        printf("Final mean height: %g  max speed: %g\n", z, speed);
+        if (!in_domain) {
+            printf("Markers left the domain\n");
+            passed = false;
+        }
+        if (speed > max_speed) {
+            printf("Fluid not at rest\n");
+            passed = false;
+        }
+        if (!(z0 - z < max_drop)) {
+            printf("Fluid height dropped by %g\n", z0 - z);
+            passed = false;
+        }
+    }
+
+    printf("\n%s\n", passed ? "PASSED" : "FAILED");
+    return passed ? 0 : 1;
+}
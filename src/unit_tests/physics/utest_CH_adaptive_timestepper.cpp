@@ -0,0 +1,191 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the explicit timesteppers with error control.
+// - Dormand-Prince 5(4) on dy/dt = -2*t*y, compared with y = exp(-t^2).
+// - Runge-Kutta-Nystrom on an oscillator hit by a short force pulse: the
+//   solution is compared with one obtained with tight tolerances, and the
+//   internal steps must be small during the pulse and large elsewhere.
+// - A falling body in a ChSystem, advanced with DoFrameDynamics.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/timestepper/ChTimestepperDormandPrince.h"
+
+using namespace chrono;
+
+// dy/dt = -2*t*y
+class Gaussian : public ChIntegrable {
+  public:
+    Gaussian() : mT(0), my(1) {}
+
+    virtual int GetNcoords_y() override { return 1; }
+
+    virtual void StateGather(ChState& y, double& T) override {
+        y(0) = my;
+        T = mT;
+    }
+
+    virtual void StateScatter(const ChState& y, const double T) override {
+        my = y(0);
+        mT = T;
+    }
+
+    virtual bool StateSolve(ChStateDelta& dydt,
+                            ChVectorDynamic<>& L,
+                            const ChState& y,
+                            const double T,
+                            const double dt,
+                            bool force_state_scatter) override {
+        if (force_state_scatter)
+            StateScatter(y, T);
+        dydt(0) = -2 * mT * my;
+        return true;
+    }
+
+  private:
+    double mT;
+    double my;
+};
+
+// M*a = -K*x + F(t), with a force pulse F(t) = F0 * exp(-((t - t0) / width)^2)
+class PulsedOscillator : public ChIntegrableIIorder {
+  public:
+    PulsedOscillator() : M(1), K(1), F0(5), t0(2.25), width(0.1), mT(0), mx(1), mv(0) {}
+
+    virtual int GetNcoords_x() override { return 1; }
+
+    virtual void StateGather(ChState& x, ChStateDelta& v, double& T) override {
+        x(0) = mx;
+        v(0) = mv;
+        T = mT;
+    }
+
+    virtual void StateScatter(const ChState& x, const ChStateDelta& v, const double T) override {
+        mx = x(0);
+        mv = v(0);
+        mT = T;
+    }
+
+    virtual bool StateSolveA(ChStateDelta& dvdt,
+                             ChVectorDynamic<>& L,
+                             const ChState& x,
+                             const ChStateDelta& v,
+                             const double T,
+                             const double dt,
+                             bool force_state_scatter) override {
+        if (force_state_scatter)
+            StateScatter(x, v, T);
+        double s = (mT - t0) / width;
+        dvdt(0) = (F0 * std::exp(-s * s) - K * mx) / M;
+        return true;
+    }
+
+    double GetPos() const { return mx; }
+
+  private:
+    double M, K, F0, t0, width;
+    double mT, mx, mv;
+};
+
+bool test_dormand_prince() {
+    Gaussian integrable;
+    ChTimestepperDormandPrince stepper(&integrable);
+    stepper.SetTolerances(1e-8, 1e-10);
+
+    double max_err = 0;
+    int steps = 0;
+    while (stepper.GetTime() < 3 - 1e-9) {
+        stepper.Advance(0.5);
+        steps += stepper.GetNumSteps();
+        double t = stepper.GetTime();
+        max_err = std::max(max_err, std::abs(stepper.get_Y()(0) - std::exp(-t * t)));
+    }
+
+    bool passed = (max_err < 1e-7) && (std::abs(stepper.GetTime() - 3) < 1e-12);
+    GetLog() << "Dormand-Prince: " << steps << " steps, max error " << max_err << (passed ? "  OK\n" : "  FAILED\n");
+    return passed;
+}
+
+bool test_nystrom() {
+    PulsedOscillator integrable;
+    ChTimestepperRungeKuttaNystrom stepper(&integrable);
+    stepper.SetTolerances(1e-6, 1e-6);
+
+    // Reference solution, with much tighter tolerances.
+    PulsedOscillator integrable_ref;
+    ChTimestepperRungeKuttaNystrom stepper_ref(&integrable_ref);
+    stepper_ref.SetTolerances(1e-12, 1e-12);
+
+    // Advance in intervals of 0.5 s; the pulse is in the fifth interval.
+    double max_err = 0;
+    int steps_quiet = 0;
+    int steps_pulse = 0;
+    int rejected = 0;
+    for (int n = 0; n < 10; n++) {
+        stepper.Advance(0.5);
+        stepper_ref.Advance(0.5);
+        if (n == 4)
+            steps_pulse = stepper.GetNumSteps();
+        else
+            steps_quiet = std::max(steps_quiet, stepper.GetNumSteps());
+        rejected += stepper.GetNumRejectedSteps();
+        max_err = std::max(max_err, std::abs(integrable.GetPos() - integrable_ref.GetPos()));
+    }
+
+    bool passed = (max_err < 1e-5) && (steps_pulse > 2 * steps_quiet) && (rejected > 0);
+    GetLog() << "Runge-Kutta-Nystrom: max steps per interval " << steps_quiet << " (quiet), " << steps_pulse
+             << " (pulse), " << rejected << " rejected, max error " << max_err
+             << (passed ? "  OK\n" : "  FAILED\n");
+    return passed;
+}
+
+bool test_system() {
+    ChSystemSMC system;
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+    auto body = std::make_shared<ChBody>(ChMaterialSurface::SMC);
+    body->SetPos_dt(ChVector<>(1, 0, 0));
+    body->SetWvel_loc(ChVector<>(0, 0, 2));
+    system.AddBody(body);
+
+    system.SetTimestepperType(ChTimestepper::Type::RUNGE_KUTTA_NYSTROM);
+    auto stepper = std::static_pointer_cast<ChTimestepperRungeKuttaNystrom>(system.GetTimestepper());
+    system.SetStep(1e-3);
+    system.SetStepMax(0.25);
+
+    // Steps of step_max: the motion is integrated exactly, with a few internal steps.
+    system.DoFrameDynamics(1.0);
+
+    ChVector<> pos = body->GetPos();
+    double angle = 2 * std::atan2(body->GetRot().e3(), body->GetRot().e0());
+    bool passed = std::abs(system.GetChTime() - 1) < 1e-12;
+    passed &= (pos - ChVector<>(1, -9.81 / 2, 0)).Length() < 1e-9;
+    passed &= std::abs(angle - 2) < 1e-6;
+    passed &= (system.GetStep() == 1e-3) && (stepper->GetNumSteps() <= 2);
+
+    GetLog() << "System: position " << pos.x() << " " << pos.y() << ", rotation " << angle
+             << (passed ? "  OK\n" : "  FAILED\n");
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= test_dormand_prince();
+    passed &= test_nystrom();
+    passed &= test_system();
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,143 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the collision model of deformable meshes.
+// A grid of triangles, held by a single ChModelBulletDeformableMesh, is placed
+// above a box. Then a vertex of the grid is moved into the box: the hierarchy
+// of the model must be refit, and the contacts must be reported with the
+// contactables of the triangles that share the vertex.
+//
+// =============================================================================
+
+#include <array>
+#include <set>
+
+#include "chrono/collision/ChCCollisionSystemBullet.h"
+#include "chrono/collision/ChCModelBulletDeformableMesh.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Collect the contactables of the contacts with the ground.
+class ContactReporter : public ChContactContainer::ReportContactCallback {
+  public:
+    ContactReporter(ChContactable* ground) : m_ground(ground), m_num_contacts(0), m_other_pairs(0) {}
+
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        m_num_contacts++;
+        if (contactobjA == m_ground)
+            m_contactables.insert(contactobjB);
+        else if (contactobjB == m_ground)
+            m_contactables.insert(contactobjA);
+        else
+            m_other_pairs++;
+        return true;
+    }
+
+    ChContactable* m_ground;
+    int m_num_contacts;
+    int m_other_pairs;
+    std::set<ChContactable*> m_contactables;
+};
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC system;
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->SetPos(ChVector<>(0, -0.5, 0));
+    ground->GetCollisionModel()->ClearModel();
+    ground->GetCollisionModel()->AddBox(2, 0.5, 2);
+    ground->GetCollisionModel()->BuildModel();
+    system.AddBody(ground);
+
+    // Grid of n x n vertices, 0.1 above the ground, with two triangles per cell.
+    // Each triangle has its own contactable (a body, not added to the system) and triangle model.
+    const int n = 11;
+    std::vector<ChVector<>> vertices(n * n);
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++)
+            vertices[i * n + j] = ChVector<>(-1 + 0.2 * i, 0.1, -1 + 0.2 * j);
+
+    std::vector<std::shared_ptr<ChBody>> triangles;
+    std::vector<std::array<int, 3>> triangle_vertices;
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = 0; j < n - 1; j++) {
+            int v0 = i * n + j;
+            triangle_vertices.push_back({{v0, v0 + 1, v0 + n}});
+            triangle_vertices.push_back({{v0 + 1, v0 + n + 1, v0 + n}});
+        }
+    }
+
+    ChModelBulletDeformableMesh mesh_model;
+    for (auto& tv : triangle_vertices) {
+        auto triangle = std::make_shared<ChBody>();
+        auto model = std::static_pointer_cast<ChModelBullet>(triangle->GetCollisionModel());
+        model->ClearModel();
+        model->AddTriangleProxy(&vertices[tv[0]], &vertices[tv[1]], &vertices[tv[2]],  //
+                                &vertices[tv[2]], &vertices[tv[0]], &vertices[tv[1]],  //
+                                true, true, true, true, true, true, 0.01);
+        model->BuildModel();
+        mesh_model.AddTriangleModel(model.get());
+        triangles.push_back(triangle);
+    }
+    mesh_model.BuildModel();
+    system.GetCollisionSystem()->Add(&mesh_model);
+
+    auto bullet_system = std::static_pointer_cast<ChCollisionSystemBullet>(system.GetCollisionSystem());
+    int num_objects = bullet_system->GetBulletCollisionWorld()->getNumCollisionObjects();
+
+    // No contacts with the flat grid.
+    system.ComputeCollisions();
+    int num_contacts_flat = system.GetNcontacts();
+
+    // Move the central vertex into the ground; only the triangles sharing it can touch the ground.
+    int center = (n / 2) * n + n / 2;
+    vertices[center].y() = -0.02;
+    mesh_model.SyncPosition();
+    system.ComputeCollisions();
+
+    ContactReporter reporter(ground.get());
+    system.GetContactContainer()->ReportAllContacts(&reporter);
+
+    std::set<ChContactable*> expected;
+    for (size_t it = 0; it < triangles.size(); it++) {
+        auto& tv = triangle_vertices[it];
+        if (tv[0] == center || tv[1] == center || tv[2] == center)
+            expected.insert(triangles[it].get());
+    }
+
+    bool passed = (num_objects == 2) && (num_contacts_flat == 0);
+    passed &= (reporter.m_num_contacts > 0) && (reporter.m_other_pairs == 0);
+    for (auto contactable : reporter.m_contactables)
+        passed &= (expected.find(contactable) != expected.end());
+
+    GetLog() << "Objects in broadphase: " << num_objects << "\n";
+    GetLog() << "Contacts: " << num_contacts_flat << " (flat), " << reporter.m_num_contacts << " (deformed), with "
+             << (int)reporter.m_contactables.size() << " of the " << (int)expected.size()
+             << " triangles at the vertex" << (passed ? "  OK\n" : "  FAILED\n");
+
+    system.GetCollisionSystem()->Remove(&mesh_model);
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
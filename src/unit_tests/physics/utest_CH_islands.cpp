@@ -0,0 +1,206 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for island decomposition.
+// A number of independent stacks of boxes and a pair of welded boxes rest on a
+// fixed ground. The test checks that:
+// - the bodies are grouped in the expected islands (see ChIslands);
+// - the island solver (ChSolverIslands) gives the same results as the plain SOR
+//   solver on the whole problem;
+// - with sleeping enabled, whole islands go to sleep and a disturbed island wakes
+//   up without waking the others;
+// - a body driven by a motor attached to the fixed ground is kept awake, so that
+//   it follows the motor when it starts, long after the body came to rest.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/motion_functions/ChFunction_Const.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChLinkMotorRotationSpeed.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverIslands.h"
+
+using namespace chrono;
+
+int num_stacks = 6;       // number of independent stacks
+int stack_height = 3;     // boxes per stack
+double box_size = 0.2;    // size of the boxes
+double time_step = 1e-3;  // integration step size
+
+// Create the scene. Return the first box of each stack, and the welded pair (last).
+std::vector<std::shared_ptr<ChBody>> CreateScene(ChSystemNSC& system) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+    system.SetMaxItersSolverSpeed(50);
+    system.SetTolForce(0);
+
+    auto ground = std::make_shared<ChBodyEasyBox>(20, 0.2, 20, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    std::vector<std::shared_ptr<ChBody>> bases;
+    for (int i = 0; i < num_stacks; i++) {
+        for (int j = 0; j < stack_height; j++) {
+            auto box = std::make_shared<ChBodyEasyBox>(box_size, box_size, box_size, 1000, true, false);
+            box->SetPos(ChVector<>(i * 1.0, (j + 0.5) * box_size, 0));
+            system.AddBody(box);
+            if (j == 0)
+                bases.push_back(box);
+        }
+    }
+
+    auto box1 = std::make_shared<ChBodyEasyBox>(box_size, box_size, box_size, 1000, true, false);
+    box1->SetPos(ChVector<>(0, 0.5 * box_size, 2));
+    system.AddBody(box1);
+    auto box2 = std::make_shared<ChBodyEasyBox>(box_size, box_size, box_size, 1000, true, false);
+    box2->SetPos(ChVector<>(2 * box_size, 0.5 * box_size, 2));
+    system.AddBody(box2);
+    auto weld = std::make_shared<ChLinkLockLock>();
+    weld->Initialize(box1, box2, ChCoordsys<>(ChVector<>(box_size, 0.5 * box_size, 2)));
+    system.AddLink(weld);
+    bases.push_back(box1);
+
+    return bases;
+}
+
+bool test_islands() {
+    ChSystemNSC system;
+    CreateScene(system);
+    system.DoStepDynamics(time_step);
+
+    ChIslands& islands = system.GetIslands();
+    islands.Update(system);
+
+    bool passed = (islands.GetNumIslands() == num_stacks + 1);
+    for (int k = 0; k < islands.GetNumIslands(); k++) {
+        int expected = (k < num_stacks) ? stack_height : 2;
+        passed &= (islands.GetIslandNumBodies(k) == expected);
+    }
+    passed &= (islands.GetIsland(system.Get_bodylist()[0].get()) == -1);  // ground
+
+    GetLog() << "Islands: " << islands.GetNumIslands() << (passed ? "  OK\n" : "  FAILED\n");
+    return passed;
+}
+
+bool test_solver() {
+    ChSystemNSC system_ref;
+    CreateScene(system_ref);
+    system_ref.SetSolverType(ChSolver::Type::SOR);
+
+    ChSystemNSC system;
+    CreateScene(system);
+    auto solver = std::make_shared<ChSolverIslands>(ChSolver::Type::SOR);
+    system.SetSolver(solver);
+
+    double max_diff = 0;
+    for (int n = 0; n < 300; n++) {
+        system_ref.DoStepDynamics(time_step);
+        system.DoStepDynamics(time_step);
+        for (size_t i = 0; i < system.Get_bodylist().size(); i++) {
+            ChVector<> diff = system.Get_bodylist()[i]->GetPos() - system_ref.Get_bodylist()[i]->GetPos();
+            max_diff = std::max(max_diff, diff.LengthInf());
+        }
+    }
+
+    // Each stack and the welded pair make an island (contacts with the fixed ground do not connect islands).
+    bool passed = (solver->GetNumIslands() == num_stacks + 1) && (max_diff == 0);
+
+    GetLog() << "Island solver: " << solver->GetNumIslands() << " islands, max difference from SOR: " << max_diff
+             << (passed ? "  OK\n" : "  FAILED\n");
+    return passed;
+}
+
+bool test_sleeping() {
+    ChSystemNSC system;
+    auto bases = CreateScene(system);
+    system.SetUseSleeping(true);
+
+    ChIslands& islands = system.GetIslands();
+
+    // Let everything come to rest and fall asleep.
+    while (system.GetChTime() < 2.0)
+        system.DoStepDynamics(time_step);
+
+    bool passed = (islands.GetNumIslands() == num_stacks + 1) &&
+                  (islands.GetNumSleepingIslands() == islands.GetNumIslands());
+    GetLog() << "Sleeping islands: " << islands.GetNumSleepingIslands() << " of " << islands.GetNumIslands()
+             << (passed ? "  OK\n" : "  FAILED\n");
+
+    // Kick the base of the first stack: its whole island must wake up, the others must keep sleeping.
+    bases[0]->SetSleeping(false);
+    bases[0]->SetPos_dt(ChVector<>(1, 0, 0));
+    system.DoStepDynamics(time_step);
+
+    bool awake = true;
+    for (auto body : islands.GetIslandBodies(islands.GetIsland(bases[0].get())))
+        awake &= !body->GetSleeping();
+    bool others = (islands.GetNumSleepingIslands() == islands.GetNumIslands() - 1);
+    for (size_t k = 1; k < bases.size(); k++)
+        others &= bases[k]->GetSleeping();
+
+    GetLog() << "Wake up: island " << (awake ? "awake" : "NOT awake") << ", others "
+             << (others ? "sleeping" : "NOT sleeping") << ((awake && others) ? "  OK\n" : "  FAILED\n");
+
+    return passed && awake && others;
+}
+
+bool test_motor_to_ground() {
+    ChSystemNSC system;
+    auto bases = CreateScene(system);
+    system.SetUseSleeping(true);
+    auto ground = system.Get_bodylist()[0];
+
+    // A box driven by a rotational motor attached to the ground. The motor is at rest until t = 2.
+    auto box = std::make_shared<ChBodyEasyBox>(box_size, box_size, box_size, 1000, false, false);
+    box->SetPos(ChVector<>(0, 1, -2));
+    system.AddBody(box);
+
+    auto speed = std::make_shared<ChFunction_Const>(0);
+    auto motor = std::make_shared<ChLinkMotorRotationSpeed>();
+    motor->Initialize(box, ground, ChFrame<>(ChVector<>(0, 1, -2)));
+    motor->SetSpeedFunction(speed);
+    system.AddLink(motor);
+
+    while (system.GetChTime() < 2.0)
+        system.DoStepDynamics(time_step);
+
+    // The stacks fall asleep, but not the box on the motor.
+    ChIslands& islands = system.GetIslands();
+    bool asleep = (islands.GetNumSleepingIslands() == islands.GetNumIslands() - 1) && !box->GetSleeping();
+
+    // Start the motor: the box must follow.
+    speed->Set_yconst(1.0);
+    while (system.GetChTime() < 2.5)
+        system.DoStepDynamics(time_step);
+
+    double omega = box->GetWvel_par().z();
+    bool follows = std::abs(std::abs(omega) - 1.0) < 1e-3;
+
+    GetLog() << "Motor to ground: box " << (box->GetSleeping() ? "sleeping" : "awake") << ", angular speed "
+             << omega << ((asleep && follows) ? "  OK\n" : "  FAILED\n");
+
+    return asleep && follows;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= test_islands();
+    passed &= test_solver();
+    passed &= test_sleeping();
+    passed &= test_motor_to_ground();
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
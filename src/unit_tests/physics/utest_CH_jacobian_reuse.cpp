@@ -0,0 +1,151 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the reuse of the Newton matrix in implicit timesteppers.
+// A damped oscillator with a hardening spring (M*a = -K*x - K3*x^3 - R*v) is
+// integrated with and without reuse of the Newton matrix, and with Broyden
+// updates. The "solver" of the test keeps the matrix evaluated at the last
+// Setup, as a direct solver keeps its factorization. The test checks that:
+// - the solutions match the ones with a Setup at each iteration;
+// - Setup calls are avoided;
+// - Broyden updates do not need more iterations than the plain reused matrix.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/timestepper/ChTimestepper.h"
+
+using namespace chrono;
+
+class Oscillator : public ChIntegrableIIorder {
+  public:
+    Oscillator() : M(1), K(30), K3(3000), R(0.5), mT(0), mx(0.2), mv(0), J(1) {}
+
+    virtual int GetNcoords_x() override { return 1; }
+
+    virtual void StateGather(ChState& x, ChStateDelta& v, double& T) override {
+        x(0) = mx;
+        v(0) = mv;
+        T = mT;
+    }
+
+    virtual void StateScatter(const ChState& x, const ChStateDelta& v, const double T) override {
+        mx = x(0);
+        mv = v(0);
+        mT = T;
+    }
+
+    virtual void StateGatherAcceleration(ChStateDelta& a) override { a(0) = ma; }
+
+    virtual void StateScatterAcceleration(const ChStateDelta& a) override { ma = a(0); }
+
+    virtual bool StateSolveCorrection(ChStateDelta& Dv,
+                                      ChVectorDynamic<>& L,
+                                      const ChVectorDynamic<>& Res,
+                                      const ChVectorDynamic<>& Qc,
+                                      const double c_a,
+                                      const double c_v,
+                                      const double c_x,
+                                      const ChState& x,
+                                      const ChStateDelta& v,
+                                      const double T,
+                                      bool force_state_scatter,
+                                      bool force_setup) override {
+        if (force_state_scatter)
+            StateScatter(x, v, T);
+        // Keep the Newton matrix of the last Setup, as a direct solver keeps its factorization.
+        if (force_setup)
+            J = c_a * M - c_v * R - c_x * (K + 3 * K3 * mx * mx);
+        Dv(0) = Res(0) / J;
+        return true;
+    }
+
+    virtual void LoadResidual_F(ChVectorDynamic<>& Res, const double c) override {
+        Res(0) += c * (-K * mx - K3 * mx * mx * mx - R * mv);
+    }
+
+    virtual void LoadResidual_Mv(ChVectorDynamic<>& Res, const ChVectorDynamic<>& w, const double c) override {
+        Res(0) += c * M * w(0);
+    }
+
+    virtual void LoadResidual_CqL(ChVectorDynamic<>& Res, const ChVectorDynamic<>& L, const double c) override {}
+
+    virtual void LoadConstraint_C(ChVectorDynamic<>& Qc,
+                                  const double c,
+                                  const bool do_clamp,
+                                  const double mclam) override {}
+
+    virtual void LoadConstraint_Ct(ChVectorDynamic<>& Qc, const double c) override {}
+
+    double GetPos() const { return mx; }
+
+  private:
+    double M, K, K3, R;
+    double mT, mx, mv;
+    double ma = 0;
+    double J;  // Newton matrix of the last Setup
+};
+
+struct Result {
+    double pos;
+    int iterations;
+    int setups;
+    int avoided;
+};
+
+// Integrate with the given timestepper for 1 s and return the final position and statistics.
+template <class Stepper>
+Result Integrate(bool reuse, bool broyden) {
+    Oscillator integrable;
+    Stepper stepper(&integrable);
+    stepper.SetMaxiters(30);
+    stepper.SetAbsTolerances(1e-12);
+    stepper.SetJacobianReuse(reuse);
+    stepper.SetBroydenUpdates(broyden);
+
+    Result result = {0, 0, 0, 0};
+    for (int n = 0; n < 200; n++) {
+        stepper.Advance(5e-3);
+        result.iterations += stepper.GetNumIterations();
+    }
+    result.pos = integrable.GetPos();
+    result.setups = (int)stepper.GetTotalSetupCalls();
+    result.avoided = (int)stepper.GetTotalSetupsAvoided();
+    return result;
+}
+
+template <class Stepper>
+bool Test(const char* name) {
+    Result ref = Integrate<Stepper>(false, false);
+    Result reuse = Integrate<Stepper>(true, false);
+    Result broyden = Integrate<Stepper>(true, true);
+
+    bool passed = std::abs(reuse.pos - ref.pos) < 1e-8 && std::abs(broyden.pos - ref.pos) < 1e-8;
+    passed &= (reuse.avoided > 0) && (reuse.setups < ref.setups) && (ref.avoided == 0);
+    passed &= (broyden.iterations <= reuse.iterations);
+
+    GetLog() << name << ": setups " << ref.setups << " / " << reuse.setups << " (" << reuse.avoided
+             << " avoided) / " << broyden.setups << " (Broyden), iterations " << ref.iterations << " / "
+             << reuse.iterations << " / " << broyden.iterations << (passed ? "  OK\n" : "  FAILED\n");
+    return passed;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= Test<ChTimestepperEulerImplicit>("Euler implicit");
+    passed &= Test<ChTimestepperTrapezoidal>("Trapezoidal");
+    passed &= Test<ChTimestepperNewmark>("Newmark");
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
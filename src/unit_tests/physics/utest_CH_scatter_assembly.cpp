@@ -0,0 +1,109 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the assembly of the system matrix with cached scatter maps.
+// A pendulum chain and a few boxes falling on the ground are simulated; at each
+// step the system matrix is assembled in a ChCSMatrix with locked sparsity
+// pattern (as done by the direct solvers) and compared with the plain assembly.
+// Contacts appear while the boxes fall, so the scatter map must be recorded
+// again whenever the structure of the problem changes.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/core/ChCSMatrix.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+
+void CreateScene(ChSystemNSC& system) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto ground = std::make_shared<ChBodyEasyBox>(20, 0.2, 20, 1000, true, false);
+    ground->SetPos(ChVector<>(0, -0.1, 0));
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    // Pendulum chain
+    std::shared_ptr<ChBody> previous = ground;
+    for (int i = 0; i < 5; i++) {
+        auto link = std::make_shared<ChBodyEasyBox>(0.5, 0.05, 0.05, 1000, false, false);
+        link->SetPos(ChVector<>(0.25 + 0.5 * i, 3, 0));
+        system.AddBody(link);
+        auto joint = std::make_shared<ChLinkLockRevolute>();
+        joint->Initialize(previous, link, ChCoordsys<>(ChVector<>(0.5 * i, 3, 0)));
+        system.AddLink(joint);
+        previous = link;
+    }
+
+    // Falling boxes
+    for (int i = 0; i < 4; i++) {
+        auto box = std::make_shared<ChBodyEasyBox>(0.2, 0.2, 0.2, 1000, true, false);
+        box->SetPos(ChVector<>(i * 0.5, 0.15 + 0.05 * i, 2));
+        system.AddBody(box);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    ChSystemNSC system;
+    CreateScene(system);
+
+    ChCSMatrix Z_cached;
+    Z_cached.SetSparsityPatternLock(true);
+
+    bool passed = true;
+    double max_diff = 0;
+    for (int n = 0; n < 200; n++) {
+        system.DoStepDynamics(1e-3);
+        ChSystemDescriptor& sysd = *system.GetSystemDescriptor();
+
+        // Same sequence of calls as the direct solvers.
+        sysd.ConvertToMatrixForm(&Z_cached, nullptr);
+        Z_cached.Compress();
+
+        ChCSMatrix Z_plain;
+        sysd.SetUseScatterMaps(false);
+        sysd.ConvertToMatrixForm(&Z_plain, nullptr);
+        sysd.SetUseScatterMaps(true);
+
+        int dim = Z_plain.GetNumRows();
+        if (Z_cached.GetNumRows() != dim || Z_cached.GetNumColumns() != dim) {
+            passed = false;
+            break;
+        }
+
+        // All the elements of the plain assembly must be in the pattern of the cached one, with the same value.
+        int* rowindex = Z_cached.GetCS_LeadingIndexArray();
+        int* colindex = Z_cached.GetCS_TrailingIndexArray();
+        double* values = Z_cached.GetCS_ValueArray();
+        int nnz = 0;
+        for (int row = 0; row < dim; row++) {
+            for (int k = rowindex[row]; k < rowindex[row + 1]; k++) {
+                max_diff = std::max(max_diff, std::abs(values[k] - Z_plain.GetElement(row, colindex[k])));
+                nnz += (values[k] != 0) ? 1 : 0;
+            }
+        }
+        double* values_plain = Z_plain.GetCS_ValueArray();
+        int nnz_plain = 0;
+        for (int k = 0; k < Z_plain.GetNNZ(); k++)
+            nnz_plain += (values_plain[k] != 0) ? 1 : 0;
+        passed &= (nnz == nnz_plain);
+    }
+
+    passed &= (max_diff == 0);
+    GetLog() << "Max difference between cached and plain assembly: " << max_diff << (passed ? "  OK\n" : "  FAILED\n");
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,153 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the cell list neighbor search.
+// First, the neighbor lists of ChCellList are compared with a brute force search
+// for a cloud of random points (with a far away cluster, so that the cells are
+// enlarged). Then the densities and forces of a block of SPH particles, computed
+// with the proximity pairs from the collision system and with the cell list
+// (see ChProximityContainerSPH::SetUseCellList), must match. The times of the two
+// kinds of force evaluations are reported.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "chrono/collision/ChCCellList.h"
+#include "chrono/core/ChMathematics.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/physics/ChMatterSPH.h"
+#include "chrono/physics/ChProximityContainerSPH.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+const int num_repetitions = 5;  // Number of force evaluations, for timing
+
+// Check the neighbor lists against a brute force search.
+bool CheckCellList() {
+    std::vector<ChVector<> > points;
+    for (int i = 0; i < 2000; i++)
+        points.push_back(ChVector<>(ChRandom(), ChRandom(), ChRandom()));
+    for (int i = 0; i < 50; i++)
+        points.push_back(ChVector<>(100 + 0.1 * ChRandom(), 0.1 * ChRandom(), 0.1 * ChRandom()));
+
+    double cutoff = 0.07;
+    ChCellList cell_list;
+    cell_list.Build(points, cutoff);
+
+    bool ok = true;
+    int n = (int)points.size();
+    int num_pairs = 0;
+    for (int i = 0; i < n; i++) {
+        std::vector<int> expected;
+        for (int j = 0; j < n; j++)
+            if (j != i && (points[j] - points[i]).Length() < cutoff)
+                expected.push_back(j);
+        num_pairs += (int)expected.size();
+
+        std::vector<int> found(cell_list.GetNeighbors().begin() + cell_list.GetNeighborStart()[i],
+                               cell_list.GetNeighbors().begin() + cell_list.GetNeighborStart()[i + 1]);
+        std::sort(found.begin(), found.end());
+        ok &= (found == expected);
+    }
+    ok &= (cell_list.GetNumPairs() * 2 == num_pairs);
+
+    GetLog() << "Cell list: " << n << " points, " << cell_list.GetNumPairs() << " pairs, " << cell_list.GetNumCells()
+             << " cells of size " << cell_list.GetCellSize() << (ok ? "  OK\n" : "  FAILED\n");
+    return ok;
+}
+
+// Densities and forces of the SPH particles, with or without the cell list.
+void ComputeForces(bool use_cell_list, std::vector<double>& density, std::vector<ChVector<> >& force, double& time) {
+    ChSystemNSC my_system;
+
+    auto fluid = std::make_shared<ChMatterSPH>();
+    fluid->FillBox(ChVector<>(1, 1, 1), 1.0 / 14, 1000, CSYSNORM, true, 1.5);
+    fluid->GetMaterial().Set_viscosity(0.5);
+    fluid->GetMaterial().Set_pressure_stiffness(300);
+    fluid->SetCollide(!use_cell_list);
+    my_system.Add(fluid);
+
+    auto proximity = std::make_shared<ChProximityContainerSPH>();
+    proximity->SetUseCellList(use_cell_list);
+    my_system.Add(proximity);
+
+    // Perturb the lattice (the same way in both runs)
+    for (unsigned int j = 0; j < fluid->GetNnodes(); j++) {
+        auto node = std::dynamic_pointer_cast<ChNodeSPH>(fluid->GetNode(j));
+        node->SetPos(node->GetPos() + ChVector<>(std::sin(j), std::cos(2.0 * j), std::sin(3.0 * j)) * 0.01);
+        node->SetPos_dt(ChVector<>(std::sin(7.0 * j), std::cos(3.0 * j), std::sin(5.0 * j)));
+    }
+
+    my_system.Setup();
+    ChVectorDynamic<> R(my_system.GetNcoords_w());
+
+    ChTimer<double> timer;
+    timer.start();
+    for (int i = 0; i < num_repetitions; i++) {
+        if (!use_cell_list)
+            my_system.ComputeCollisions();
+        fluid->IntLoadResidual_F(0, R, 1.0);
+    }
+    timer.stop();
+    time = timer();
+
+    density.clear();
+    force.clear();
+    for (unsigned int j = 0; j < fluid->GetNnodes(); j++) {
+        auto node = std::dynamic_pointer_cast<ChNodeSPH>(fluid->GetNode(j));
+        density.push_back(node->density);
+        force.push_back(node->UserForce);
+    }
+
+    GetLog() << (use_cell_list ? "Cell list: " : "Collision system: ") << (int)fluid->GetNnodes() << " particles, "
+             << proximity->GetNproximities() << " pairs\n";
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = CheckCellList();
+
+    double time_collision;
+    double time_cell_list;
+    std::vector<double> density1, density2;
+    std::vector<ChVector<> > force1, force2;
+    ComputeForces(false, density1, force1, time_collision);
+    ComputeForces(true, density2, force2, time_cell_list);
+
+    double max_density = 0;
+    double max_force = 0;
+    double err_density = 0;
+    double err_force = 0;
+    for (size_t j = 0; j < density1.size(); j++) {
+        max_density = std::max(max_density, std::abs(density1[j]));
+        max_force = std::max(max_force, force1[j].Length());
+        err_density = std::max(err_density, std::abs(density1[j] - density2[j]));
+        err_force = std::max(err_force, (force1[j] - force2[j]).Length());
+    }
+    err_density /= max_density;
+    err_force /= max_force;
+
+    bool ok = (density1.size() == density2.size()) && (err_density < 1e-10) && (err_force < 1e-10);
+    passed &= ok;
+
+    GetLog() << "Relative difference of densities " << err_density << ", of forces " << err_force
+             << (ok ? "  OK\n" : "  FAILED\n");
+    GetLog() << num_repetitions << " force evaluations: collision system " << time_collision << " s, cell list "
+             << time_cell_list << " s\n";
+
+    // Return 0 if all tests passed.
+    return !passed;
+}
@@ -0,0 +1,192 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the tabulated tire force map (ChTireForceMap).
+// 1. A map of Magic Formula-like curves is built with the default tolerance; the
+//    interpolation error at random points must be bounded by the tolerance and the
+//    grid must stay within the node budget.
+// 2. The HMMWV Pacejka tire is evaluated with and without the force map, over the
+//    full range of slip angles: the tire forces must agree within the tolerance.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/FlatTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChPacejkaTire.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChTireForceMap.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Pacejka tire with the HMMWV parameters, using the steady-state (kinematic) slips.
+class PacejkaTire : public ChPacejkaTire {
+  public:
+    PacejkaTire(const std::string& name)
+        : ChPacejkaTire(name, vehicle::GetDataFile("hmmwv/tire/HMMWV_pacejka.tir"), 0, false) {}
+    virtual double GetMass() const override { return 37.6; }
+    virtual ChVector<> GetInertia() const override { return ChVector<>(3.84, 6.69, 3.84); }
+};
+
+const double tolerance = 0.01;
+const int max_nodes = 50000;
+const double min_coverage = 0.55;  // smallest fraction of the Pacejka map cells meeting the tolerance
+
+// Magic Formula-like curves of the longitudinal and lateral forces.
+void MagicFormula(const double* x, double* out) {
+    double kappa = x[0];
+    double alpha = x[1];
+    double gamma = x[2];
+    double Fz = x[3];
+    double D = 0.9 * Fz * (1 - 0.1 * (Fz - 5000) / 5000);
+    double Bx = 12.0;
+    double By = 10.0 * (1 + 0.5 * gamma);
+    out[0] = D * std::sin(1.6 * std::atan(Bx * kappa - 0.5 * (Bx * kappa - std::atan(Bx * kappa))));
+    out[1] = -D * std::sin(1.3 * std::atan(By * alpha - 0.8 * (By * alpha - std::atan(By * alpha)))) + 200 * gamma;
+    out[2] = out[0] * std::cos(std::atan(4 * alpha));
+}
+
+bool TestAnalyticMap() {
+    ChTireForceMap map;
+    map.SetNumOutputs(3);
+    map.SetRange(0, -1.0, 1.0, 9);
+    map.SetRange(1, -1.5, 1.5, 9);
+    map.SetRange(2, -0.25, 0.25, 3);
+    map.SetRange(3, 200, 10000, 5);
+    bool converged = map.Build(MagicFormula, tolerance, max_nodes);
+
+    std::cout << "Analytic map: " << map.GetNumNodes(0) << " x " << map.GetNumNodes(1) << " x "
+              << map.GetNumNodes(2) << " x " << map.GetNumNodes(3) << " = " << map.GetNumNodes() << " nodes, "
+              << map.GetMemorySize() / 1024 << " kB, estimated error " << map.GetMaxError() << std::endl;
+
+    if (!converged || map.GetMaxError() > tolerance) {
+        std::cout << "  tolerance not met" << std::endl;
+        return false;
+    }
+    if (map.GetNumNodes() > max_nodes || map.GetMemorySize() != (size_t)map.GetNumNodes() * 3 * sizeof(double)) {
+        std::cout << "  node budget exceeded" << std::endl;
+        return false;
+    }
+
+    // Output ranges, used to scale the errors.
+    double range[3] = {2 * 0.9 * 10000, 2 * 0.9 * 10000 + 100, 2 * 0.9 * 10000};
+
+    // Check the interpolation error at random points.
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> u(0, 1);
+    double max_err = 0;
+    for (int i = 0; i < 100000; i++) {
+        double x[4] = {-1 + 2 * u(gen), -1.5 + 3 * u(gen), -0.25 + 0.5 * u(gen), 200 + 9800 * u(gen)};
+        double exact[3];
+        double approx[3];
+        MagicFormula(x, exact);
+        map.Evaluate(x, approx);
+        for (int j = 0; j < 3; j++)
+            max_err = std::max(max_err, std::abs(exact[j] - approx[j]) / range[j]);
+    }
+    std::cout << "  max error at random points: " << max_err << std::endl;
+
+    // The error estimate is taken at the cell centers; allow for a safety factor of 2 elsewhere.
+    return max_err <= 2 * tolerance;
+}
+
+bool TestPacejkaMap() {
+    ChSystemNSC system;
+    auto wheel_analytic = std::make_shared<ChBody>();
+    auto wheel_map = std::make_shared<ChBody>();
+    system.AddBody(wheel_analytic);
+    system.AddBody(wheel_map);
+
+    PacejkaTire tire_analytic("analytic");
+    PacejkaTire tire_map("map");
+    tire_map.SetForceMapMode(true, tolerance);
+    tire_analytic.Initialize(wheel_analytic, LEFT);
+    tire_map.Initialize(wheel_map, LEFT);
+
+    const ChTireForceMap& map = tire_map.GetForceMap();
+    std::cout << "Pacejka map: " << map.GetNumNodes(0) << " x " << map.GetNumNodes(1) << " x "
+              << map.GetNumNodes(2) << " x " << map.GetNumNodes(3) << " = " << map.GetNumNodes() << " nodes, "
+              << map.GetMemorySize() / 1024 << " kB, estimated error " << tire_map.GetForceMapError()
+              << ", coverage " << map.GetCoverage() << std::endl;
+
+    if (tire_map.GetForceMapError() > tolerance || map.GetNumNodes() > max_nodes) {
+        std::cout << "  tolerance not met in the used cells or node budget exceeded" << std::endl;
+        return false;
+    }
+
+    // The analytic fallback must be limited to a small part of the domain.
+    if (map.GetCoverage() < min_coverage) {
+        std::cout << "  coverage below " << min_coverage << std::endl;
+        return false;
+    }
+
+    FlatTerrain terrain(0);
+    double R = tire_map.GetRadius();
+    double V = 10;
+
+    // Sweep the slip angle over the range of the parameter file, for a few slip ratios and loads
+    // (vertical loads of about 5.8 kN and 10 kN, within the tabulated range).
+    double max_err[3] = {0, 0, 0};
+    double max_val[3] = {0, 0, 0};
+    for (double defl : {0.001, 0.003}) {
+        for (double kappa : {-0.2, 0.0, 0.05, 0.3}) {
+            for (double alpha = -1.2; alpha <= 1.2; alpha += 0.05) {
+                WheelState state;
+                state.pos = ChVector<>(0, 0, R - defl);
+                state.rot = QUNIT;
+                state.lin_vel = ChVector<>(V * std::cos(alpha), -V * std::sin(alpha), 0);
+                state.omega = (1 + kappa) * V * std::cos(alpha) / R;
+                state.ang_vel = ChVector<>(0, state.omega, 0);
+
+                tire_analytic.Synchronize(0, state, terrain);
+                tire_map.Synchronize(0, state, terrain);
+                tire_analytic.Advance(1e-3);
+                tire_map.Advance(1e-3);
+
+                TerrainForce f_analytic = tire_analytic.GetTireForce_combinedSlip(true);
+                TerrainForce f_map = tire_map.GetTireForce_combinedSlip(true);
+                double a[3] = {f_analytic.force.x(), f_analytic.force.y(), f_analytic.moment.z()};
+                double m[3] = {f_map.force.x(), f_map.force.y(), f_map.moment.z()};
+                for (int j = 0; j < 3; j++) {
+                    max_err[j] = std::max(max_err[j], std::abs(a[j] - m[j]));
+                    max_val[j] = std::max(max_val[j], std::abs(a[j]));
+                }
+            }
+        }
+    }
+
+    std::cout << "  max error Fx: " << max_err[0] << " / " << max_val[0] << std::endl;
+    std::cout << "  max error Fy: " << max_err[1] << " / " << max_val[1] << std::endl;
+    std::cout << "  max error Mz: " << max_err[2] << " / " << max_val[2] << std::endl;
+
+    // The output range over the map is about twice the peak value (forces change sign).
+    for (int j = 0; j < 3; j++) {
+        if (max_err[j] > 2 * tolerance * 2 * max_val[j])
+            return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    bool passed = true;
+    passed &= TestAnalyticMap();
+    passed &= TestPacejkaMap();
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+//
+// Unit test for the multi-rate tire advance (ChTire::AdvanceMultirate).
+// A driven wheel, attached to a carrier which translates along the X axis, rolls
+// on flat terrain. The wheel spin is stiff (the tire longitudinal force reacts
+// to the spin through the slip ratio), so that integrating the vehicle with the
+// tire force evaluated once per step is unstable for large steps. With the tire
+// sub-cycled within the vehicle step, the same large step must reproduce the
+// results obtained with a small step.
+//
+// =============================================================================
+
+#include <cmath>
+#include <iostream>
+
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/FlatTerrain.h"
+#include "chrono_vehicle/wheeled_vehicle/tire/ChPacejkaTire.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Pacejka tire with the HMMWV parameters, using the steady-state (kinematic) slips.
+class PacejkaTire : public ChPacejkaTire {
+  public:
+    PacejkaTire(const std::string& name)
+        : ChPacejkaTire(name, vehicle::GetDataFile("hmmwv/tire/HMMWV_pacejka.tir"), 0, false) {}
+    virtual double GetMass() const override { return 37.6; }
+    virtual ChVector<> GetInertia() const override { return ChVector<>(3.84, 6.69, 3.84); }
+};
+
+const double speed = 10;         // initial forward speed
+const double axle_torque = 800;  // driving torque
+const double deflection = 0.0025;  // tire deflection (vertical load close to the nominal load)
+const double t_end = 1;
+
+// Simulate the wheel rig with the given vehicle step and number of tire sub-steps.
+// Return the wheel angular speed and the maximum slip ratio magnitude during the second half of the simulation.
+void Simulate(double step, int num_substeps, double& omega, double& max_slip) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, 0));
+
+    auto tire = std::make_shared<PacejkaTire>("tire");
+    tire->SetNumSubsteps(num_substeps);
+    double R0 = 0.461;  // unloaded radius in the parameter file
+
+    auto ground = std::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    auto carrier = std::make_shared<ChBody>();
+    carrier->SetMass(500);
+    carrier->SetPos(ChVector<>(0, 0, R0 - deflection));
+    carrier->SetPos_dt(ChVector<>(speed, 0, 0));
+    system.AddBody(carrier);
+
+    auto wheel = std::make_shared<ChBody>();
+    wheel->SetMass(18.8);
+    wheel->SetInertiaXX(ChVector<>(0.113, 0.113, 0.113));
+    wheel->SetPos(ChVector<>(0, 0, R0 - deflection));
+    wheel->SetPos_dt(ChVector<>(speed, 0, 0));
+    system.AddBody(wheel);
+
+    auto prismatic = std::make_shared<ChLinkLockPrismatic>();
+    prismatic->Initialize(carrier, ground, ChCoordsys<>(carrier->GetPos(), Q_from_AngY(CH_C_PI_2)));
+    system.AddLink(prismatic);
+
+    auto revolute = std::make_shared<ChLinkLockRevolute>();
+    revolute->Initialize(wheel, carrier, ChCoordsys<>(wheel->GetPos(), Q_from_AngX(CH_C_PI_2)));
+    system.AddLink(revolute);
+
+    tire->Initialize(wheel, LEFT);
+    wheel->SetWvel_par(ChVector<>(0, speed / tire->GetRadius(), 0));
+
+    FlatTerrain terrain(0);
+
+    omega = 0;
+    max_slip = 0;
+    while (system.GetChTime() < t_end - step / 2) {
+        double time = system.GetChTime();
+
+        WheelState state;
+        state.pos = wheel->GetPos();
+        state.rot = wheel->GetRot();
+        state.lin_vel = wheel->GetPos_dt();
+        state.ang_vel = wheel->GetWvel_par();
+        state.omega = Vdot(state.ang_vel, state.rot.GetYaxis());
+
+        TerrainForce tire_force;
+        if (num_substeps > 1) {
+            tire_force = tire->AdvanceMultirate(time, step, state, terrain, axle_torque);
+        } else {
+            tire->Synchronize(time, state, terrain);
+            tire->Advance(step);
+            tire_force = tire->GetTireForce();
+        }
+
+        wheel->Empty_forces_accumulators();
+        wheel->Accumulate_force(tire_force.force, tire_force.point, false);
+        wheel->Accumulate_torque(tire_force.moment + axle_torque * state.rot.GetYaxis(), false);
+
+        system.DoStepDynamics(step);
+
+        omega = Vdot(wheel->GetWvel_par(), wheel->GetRot().GetYaxis());
+        if (time > t_end / 2) {
+            double slip = (omega * tire->GetRadius() - wheel->GetPos_dt().x()) / wheel->GetPos_dt().x();
+            if (std::isnan(slip))
+                slip = 1e10;
+            max_slip = std::max(max_slip, std::abs(slip));
+        }
+    }
+}
+
+int main(int argc, char* argv[]) {
+    const double large_step = 1e-2;
+    const int num_substeps = 10;
+
+    // Reference solution, with a small vehicle step
+    double omega_ref;
+    double slip_ref;
+    Simulate(large_step / num_substeps, 1, omega_ref, slip_ref);
+
+    // Large vehicle step, tire evaluated once per step
+    double omega_single;
+    double slip_single;
+    Simulate(large_step, 1, omega_single, slip_single);
+
+    // Large vehicle step, tire sub-cycled
+    double omega_multi;
+    double slip_multi;
+    Simulate(large_step, num_substeps, omega_multi, slip_multi);
+
+    std::cout << "Reference   (step " << large_step / num_substeps << "): omega = " << omega_ref
+              << "  max slip = " << slip_ref << std::endl;
+    std::cout << "Single-rate (step " << large_step << "): omega = " << omega_single << "  max slip = " << slip_single
+              << std::endl;
+    std::cout << "Multi-rate  (step " << large_step << ", " << num_substeps << " sub-steps): omega = " << omega_multi
+              << "  max slip = " << slip_multi << std::endl;
+
+    bool passed = true;
+
+    // The large step without sub-cycling must show the spin instability...
+    if (slip_single < 2 * slip_ref) {
+        std::cout << "Single-rate run unexpectedly stable" << std::endl;
+        passed = false;
+    }
+
+    // ...which the multi-rate advance must remove.
+    if (std::abs(omega_multi - omega_ref) > 0.01 * std::abs(omega_ref) || slip_multi > 1.5 * slip_ref) {
+        std::cout << "Multi-rate run does not match the reference" << std::endl;
+        passed = false;
+    }
+
+    std::cout << (passed ? "PASSED" : "FAILED") << std::endl;
+    return passed ? 0 : 1;
+}